@@ -168,6 +168,20 @@ extern "C"
 #define RL2_COMPRESSION_LOSSY_JP2	0x33
 /** RasterLite2 constant: Compression JPEG2000 (lossless mode) */
 #define RL2_COMPRESSION_LOSSLESS_JP2	0x34
+/** RasterLite2 constant: Compression Zstandard Delta */
+#define RL2_COMPRESSION_ZSTD		0x35
+/** RasterLite2 constant: Compression Zstandard noDelta */
+#define RL2_COMPRESSION_ZSTD_NO		0xd5
+/** RasterLite2 constant: Compression LZ4 ByteShuffle */
+#define RL2_COMPRESSION_LZ4		0x36
+/** RasterLite2 constant: Compression LZ4 noShuffle */
+#define RL2_COMPRESSION_LZ4_NO		0xd6
+/** RasterLite2 constant: Compression Deflate FloatPredictor (zip) */
+#define RL2_COMPRESSION_DEFLATE_FP	0xe2
+/** RasterLite2 constant: Compression LZMA FloatPredictor */
+#define RL2_COMPRESSION_LZMA_FP		0xe3
+/** RasterLite2 constant: Compression Zstandard FloatPredictor */
+#define RL2_COMPRESSION_ZSTD_FP		0xe5
 
 /** RasterLite2 constant: UNKNOWN number of Bands */
 #define RL2_BANDS_UNKNOWN		0x00
@@ -222,6 +236,19 @@ extern "C"
 /** RasterLite2 constant: contrast enhancement GAMMA-VALUE */
 #define RL2_CONTRAST_ENHANCEMENT_GAMMA		0x93
 
+/** RasterLite2 constant: Pyramid resampling - DEFAULT (Average / Cairo) */
+#define RL2_RESAMPLING_DEFAULT		0xc0
+/** RasterLite2 constant: Pyramid resampling - AVERAGE */
+#define RL2_RESAMPLING_AVERAGE		0xc1
+/** RasterLite2 constant: Pyramid resampling - NEAREST NEIGHBOUR */
+#define RL2_RESAMPLING_NEAREST		0xc2
+/** RasterLite2 constant: Pyramid resampling - MODE (majority) */
+#define RL2_RESAMPLING_MODE		0xc3
+/** RasterLite2 constant: Pyramid resampling - BILINEAR */
+#define RL2_RESAMPLING_BILINEAR		0xc4
+/** RasterLite2 constant: Pyramid resampling - CUBIC (Catmull-Rom) */
+#define RL2_RESAMPLING_CUBIC		0xc5
+
 /** RasterLite2 constant: GroupRenderer - RasterLayer */
 #define RL2_GROUP_RENDERER_RASTER_LAYER	0xba
 /** ResterLite2 constant: GroupRenderer - VectorLayer */
@@ -684,6 +711,38 @@ extern "C"
  */
     RL2_DECLARE const char *rl2_target_cpu (void);
 
+/**
+ Return the SIMD kernels used for pixel reassembly, byte swapping and
+ Pyramid downsampling.
+
+ \return "AVX2", "SSE2", "NEON" or "none".
+
+ \note the returned value reflects both the CPU features detected at
+ runtime and the current rl2_enable_simd() setting.
+
+ \sa rl2_enable_simd
+ */
+    RL2_DECLARE const char *rl2_simd_kernels (void);
+
+/**
+ Enables or disables the SIMD kernels for pixel reassembly, byte swapping
+ and Pyramid downsampling.
+
+ \param enabled TRUE to enable the SIMD kernels (default), FALSE
+ to force the plain scalar code paths.
+
+ \return the previous setting.
+
+ \note this is a testing and benchmarking aid, not a tuning knob: the
+ setting is global to the whole process and is not synchronized, so it
+ must only be changed before any other work is started, or whenever no
+ other thread is using the library. Both code paths always produce
+ exactly the same results.
+
+ \sa rl2_simd_kernels
+ */
+    RL2_DECLARE int rl2_enable_simd (int enabled);
+
 /**
  Return the current library version.
 
@@ -719,6 +778,20 @@ extern "C"
  */
     RL2_DECLARE const char *rl2_lzma_version (void);
 
+/**
+ Return the current Zstandard version.
+
+ \return the version string.
+ */
+    RL2_DECLARE const char *rl2_zstd_version (void);
+
+/**
+ Return the current LZ4 version.
+
+ \return the version string.
+ */
+    RL2_DECLARE const char *rl2_lz4_version (void);
+
 /**
  Return the current PNG version.
 
@@ -1544,6 +1617,43 @@ extern "C"
 				   int mixed_resolutions, int section_paths,
 				   int section_md5, int section_summary);
 
+/**
+ Gets the Pyramid Resampling policy from a Coverage Object
+
+ \param cvg pointer to the Coverage Object.
+ \param resampling on completion the variable referenced by this
+  pointer will contain one of RL2_RESAMPLING_DEFAULT, RL2_RESAMPLING_AVERAGE,
+  RL2_RESAMPLING_NEAREST, RL2_RESAMPLING_MODE, RL2_RESAMPLING_BILINEAR
+  or RL2_RESAMPLING_CUBIC.
+ 
+ \return RL2_OK on success: RL2_ERROR on failure.
+
+ \sa rl2_create_coverage, rl2_set_coverage_resampling
+ */
+    RL2_DECLARE int
+	rl2_get_coverage_resampling (rl2CoveragePtr cvg,
+				     unsigned char *resampling);
+
+/**
+ Sets the Pyramid Resampling policy for a Coverage Object
+
+ \param cvg pointer to the Coverage Object.
+ \param resampling one of RL2_RESAMPLING_DEFAULT, RL2_RESAMPLING_AVERAGE,
+  RL2_RESAMPLING_NEAREST, RL2_RESAMPLING_MODE, RL2_RESAMPLING_BILINEAR
+  or RL2_RESAMPLING_CUBIC.
+ 
+ \return RL2_OK on success: RL2_ERROR on failure.
+
+ \note the policy only affects DataGrid, MultiBand, RGB and Grayscale
+  Pyramids; RL2_RESAMPLING_DEFAULT (the initial value) averages DataGrid
+  and MultiBand tiles and rescales RGB and Grayscale tiles by Cairo.
+
+ \sa rl2_create_coverage, rl2_get_coverage_resampling
+ */
+    RL2_DECLARE int
+	rl2_set_coverage_resampling (rl2CoveragePtr cvg,
+				     unsigned char resampling);
+
 /**
  Retrieving the DbPrefix from a Coverage Object
 
@@ -4059,6 +4169,27 @@ extern "C"
 						const char *db_prefix,
 						const char *coverage);
 
+    RL2_DECLARE int
+	rl2_set_dbms_coverage_resampling (sqlite3 * handle,
+					  const char *coverage,
+					  unsigned char resampling);
+
+    RL2_DECLARE int
+	rl2_get_dbms_coverage_resampling (sqlite3 * handle,
+					  const char *db_prefix,
+					  const char *coverage,
+					  unsigned char *resampling);
+
+    RL2_DECLARE int
+	rl2_enable_dbms_coverage_split_tiles (sqlite3 * handle,
+					      const char *coverage,
+					      int on_off);
+
+    RL2_DECLARE int
+	rl2_is_dbms_coverage_split_tiles_enabled (sqlite3 * handle,
+						  const char *db_prefix,
+						  const char *coverage);
+
     RL2_DECLARE int
 	rl2_delete_dbms_section (sqlite3 * handle, const char *coverage,
 				 sqlite3_int64 section_id);
@@ -4691,6 +4822,15 @@ extern "C"
 	rl2_build_monolithic_pyramid (sqlite3 * handle, const char *coverage,
 				      int virtual_levels, int verbose);
 
+    RL2_DECLARE int
+	rl2_build_monolithic_pyramid_ex (sqlite3 * handle, int max_threads,
+					 const char *coverage,
+					 int virtual_levels, int verbose);
+
+    RL2_DECLARE int
+	rl2_build_incremental_pyramid (sqlite3 * handle, int max_threads,
+				       const char *coverage, int verbose);
+
     RL2_DECLARE int
 	rl2_build_all_section_pyramids (sqlite3 * handle, int max_threads,
 					const char *coverage,
@@ -6054,6 +6194,17 @@ extern "C"
 						    int blob_sz,
 						    rl2PixelPtr * pixel);
 
+    RL2_DECLARE int rl2_pixels_from_raster_by_points (sqlite3 * sqlite,
+						      const void *data,
+						      const char *db_prefix,
+						      const char *cvg_name,
+						      int pyramid_level,
+						      int srid,
+						      int num_points,
+						      const double *x,
+						      const double *y,
+						      rl2PixelPtr * pixels);
+
     RL2_DECLARE int rl2_map_image_blob_from_raster (sqlite3 * sqlite,
 						    const void *data,
 						    const char *db_prefix,
@@ -112,6 +112,8 @@ extern "C"
 #define RL2_ODD_BLOCK_END			0xf0
 #define RL2_EVEN_BLOCK_START			0xdb
 #define RL2_EVEN_BLOCK_END			0xd0
+#define RL2_ODD_BLOCK_V2_START			0xfb
+#define RL2_EVEN_BLOCK_V2_START			0xdc
 #define RL2_LITTLE_ENDIAN			0x01
 #define RL2_BIG_ENDIAN				0x00
 #define RL2_PALETTE_START			0xa4
@@ -342,13 +344,205 @@ extern "C"
     } rl2PrivRaster;
     typedef rl2PrivRaster *rl2PrivRasterPtr;
 
-    struct rl2_cached_raster
+    typedef struct rl2_decode_view
+    {
+	/* a Tile-sized window into some output mosaic buffer */
+	unsigned char *outbuf;
+	unsigned int width;
+	unsigned int height;
+	unsigned char sample_type;
+	unsigned char num_bands;
+	int col;
+	int row;
+	/* when set: an RGBA View, packed pixels expanded by this LUT */
+	const unsigned char *rgba_lut;
+    } rl2DecodeView;
+    typedef rl2DecodeView *rl2DecodeViewPtr;
+
+#define RL2_RASTER_CACHE_BUCKETS	1024
+
+    struct rl2_cached_raster_grid
     {
 	char *db_prefix;
 	char *coverage;
 	int pyramid_level;
-	time_t last_used;
+	double tile_ext_x;
+	double tile_ext_y;
+	struct rl2_cached_raster_grid *next;
+    };
+
+    struct rl2_cached_raster
+    {
+	struct rl2_cached_raster_grid *grid;
+	int tile_col;
+	int tile_row;
 	rl2PrivRasterPtr raster;
+	struct rl2_cached_raster *hash_next;
+	struct rl2_cached_raster *prev;
+	struct rl2_cached_raster *next;
+    };
+
+    struct rl2_cached_coverage_style
+    {
+	char *style_name;
+	rl2CoverageStylePtr style;
+	struct rl2_cached_coverage_style *next;
+    };
+
+    struct rl2_level_resolution
+    {
+	int level;
+	int scale;
+	int real_scale;
+	double x_resolution;
+	double y_resolution;
+    };
+
+    struct rl2_resolutions_table
+    {
+	/* sorted from the lowest to the highest resolution */
+	sqlite3_int64 section_id;
+	int count;
+	int monotonic;
+	struct rl2_level_resolution *items;
+    };
+
+    struct rl2_tile_grid_cell
+    {
+	sqlite3_int64 tile_id;	/* -1 when no Tile exists */
+	double minx;
+	double maxy;
+    };
+
+    struct rl2_tile_grid_section
+    {
+	sqlite3_int64 section_id;
+	double origin_x;	/* upper left corner */
+	double origin_y;
+	double ext_x;		/* full Tile extent */
+	double ext_y;
+	double minx;		/* Section extent */
+	double miny;
+	double maxx;
+	double maxy;
+	int cols;
+	int rows;
+	struct rl2_tile_grid_cell *cells;
+    };
+
+    struct rl2_tile_grid
+    {
+	/* all Tiles of some Pyramid Level, sorted by Section */
+	int level;
+	int usable;
+	int count;
+	struct rl2_tile_grid_section *sections;
+	struct rl2_tile_grid *next;
+    };
+
+    typedef struct rl2_grid_tile_ref
+    {
+	sqlite3_int64 tile_id;
+	double minx;
+	double maxy;
+    } rl2GridTileRef;
+    typedef rl2GridTileRef *rl2GridTileRefPtr;
+
+    typedef struct rl2_grid_tile_refs
+    {
+	int count;
+	int max;
+	int next;
+	rl2GridTileRefPtr items;
+    } rl2GridTileRefs;
+    typedef rl2GridTileRefs *rl2GridTileRefsPtr;
+
+    struct rl2_tile_reader
+    {
+	/* a private read-only connection */
+	sqlite3 *handle;
+	char *coverage;
+	int even;
+	int split;
+	sqlite3_stmt *stmt;
+	sqlite3_blob *blob_odd;
+	sqlite3_blob *blob_even;
+	unsigned char *buf_odd;
+	int buf_odd_max;
+	unsigned char *buf_even;
+	int buf_even_max;
+    };
+
+    struct rl2_tile_readers
+    {
+	/* all read-only connections to the same DB file */
+	char *db_path;
+	int count;
+	struct rl2_tile_reader *items;
+	struct rl2_tile_readers *next;
+    };
+
+    struct rl2_slot_buffer
+    {
+	/* the reusable BLOB buffers of some AuxDecoder slot */
+	unsigned char *buf_odd;
+	int buf_odd_max;
+	unsigned char *buf_even;
+	int buf_even_max;
+    };
+
+    struct rl2_slot_buffers
+    {
+	/* the reusable BLOB buffers of all AuxDecoder slots */
+	int count;
+	int busy;
+	int owned;		/* kept by the connection across requests */
+	struct rl2_slot_buffer *items;
+    };
+
+#define RL2_STMT_TILE_IMAGE		1
+#define RL2_STMT_RASTER_BY_POINT	2
+#define RL2_STMT_RAW_TILES		3
+#define RL2_STMT_RAW_SECTION_TILES	4
+#define RL2_STMT_RAW_TILE_DATA		5
+#define RL2_STMT_RAW_TILE_DATA_ODD	6
+
+    struct rl2_cached_stmt
+    {
+	int kind;
+	int busy;
+	sqlite3_stmt *stmt;
+	struct rl2_cached_stmt *next;
+    };
+
+    struct rl2_cached_coverage_meta
+    {
+	char *db_prefix;
+	char *coverage_name;
+	unsigned int data_version;
+	int coverage_loaded;
+	rl2CoveragePtr coverage;
+	int palette_loaded;
+	rl2PalettePtr palette;
+	int stats_loaded;
+	rl2RasterStatisticsPtr stats;
+	struct rl2_cached_coverage_style *first_style;
+	struct rl2_cached_stmt *first_stmt;
+	struct rl2_resolutions_table *levels;
+	struct rl2_resolutions_table **section_levels;
+	int section_levels_count;
+	int section_levels_max;
+	struct rl2_tile_grid *first_grid;
+	struct rl2_cached_coverage_meta *next;
+    };
+
+    struct rl2_tile_cache_stamp
+    {
+	char *db_prefix;
+	char *db_path;
+	unsigned int data_version;
+	int total_changes;
+	struct rl2_tile_cache_stamp *next;
     };
 
     struct rl2_private_data
@@ -358,8 +552,22 @@ extern "C"
 	void *FTlibrary;
 	struct rl2_private_tt_font *first_font;
 	struct rl2_private_tt_font *last_font;
-	struct rl2_cached_raster *raster_cache;
+	struct rl2_cached_raster **raster_cache;
 	int raster_cache_items;
+	int raster_cache_count;
+	struct rl2_cached_raster *raster_cache_first;
+	struct rl2_cached_raster *raster_cache_last;
+	struct rl2_cached_raster_grid *raster_cache_grids;
+	struct rl2_cached_coverage_meta *first_meta;
+	int meta_total_changes;
+	int stmt_cache_enabled;
+	struct rl2_cached_stmt *detached_stmts;
+	int tile_grid_enabled;
+	int tile_readers_enabled;
+	struct rl2_tile_readers *first_tile_readers;
+	int verify_tile_checksums;
+	struct rl2_tile_cache_stamp *first_cache_stamp;
+	struct rl2_slot_buffers *slot_buffers;
     };
 
     typedef struct rl2_priv_tile
@@ -401,6 +609,7 @@ extern "C"
 	int sectionPaths;
 	int sectionMD5;
 	int sectionSummary;
+	unsigned char pyramidResampling;
     } rl2PrivCoverage;
     typedef rl2PrivCoverage *rl2PrivCoveragePtr;
 
@@ -565,6 +774,38 @@ extern "C"
     } rl2PrivBandStatistics;
     typedef rl2PrivBandStatistics *rl2PrivBandStatisticsPtr;
 
+    typedef struct rl2_sample_accumulator
+    {
+	/* a block of samples being accumulated (Tile statistics) */
+	double count;
+	double shift;
+	double min;
+	double max;
+	double sum;
+	double sum_sq;
+    } rl2SampleAccumulator;
+    typedef rl2SampleAccumulator *rl2SampleAccumulatorPtr;
+
+    typedef struct rl2_box_filter
+    {
+	/* reducing a tile by some factor (any Pyramid resampling kernel) */
+	const void *in;
+	const unsigned char *mask_in;
+	unsigned int in_width;
+	unsigned int in_height;
+	unsigned char sample_type;
+	int num_bands;
+	unsigned int factor;
+	const rl2PrivSample *no_data;
+	int pixel_nodata;
+	void *out;
+	unsigned char *mask_out;
+	unsigned int out_width;
+	unsigned int out_height;
+	unsigned int out_stride;
+    } rl2BoxFilter;
+    typedef rl2BoxFilter *rl2BoxFilterPtr;
+
     typedef struct rl2_priv_raster_statistics
     {
 	double no_data;
@@ -1044,6 +1285,7 @@ extern "C"
 	unsigned char pixel_type;
 	unsigned char num_samples;
 	unsigned char compression;
+	unsigned char resampling;
 	int quality;
 	int srid;
 	unsigned int full_width;
@@ -1065,6 +1307,98 @@ extern "C"
     } SectionPyramid;
     typedef SectionPyramid *SectionPyramidPtr;
 
+    typedef struct rl2_aux_pyramid_base
+    {
+	/* a base Tile required by some Pyramid tile */
+	sqlite3_int64 tile_id;
+	double x;		/* Section: center - Monolithic: upper left corner */
+	double y;
+	unsigned char *blob_odd;
+	unsigned char *blob_even;
+	int blob_odd_sz;
+	int blob_even_sz;
+	int blob_odd_max;
+	int blob_even_max;
+    } rl2AuxPyramidBase;
+    typedef rl2AuxPyramidBase *rl2AuxPyramidBasePtr;
+
+    typedef struct rl2_aux_pyramid_tile
+    {
+	/* a Pyramid tile to be rescaled and encoded by some worker thread */
+	SectionPyramidPtr pyr;
+	SectionPyramidTileOutPtr tile_out;
+	unsigned int tile_width;
+	unsigned int tile_height;
+	rl2PalettePtr palette;
+	rl2PixelPtr no_data;
+	int num_bases;
+	int max_bases;
+	rl2AuxPyramidBasePtr bases;
+	unsigned char *blob_odd;
+	unsigned char *blob_even;
+	int blob_odd_sz;
+	int blob_even_sz;
+	int done;
+	int retcode;
+    } rl2AuxPyramidTile;
+    typedef rl2AuxPyramidTile *rl2AuxPyramidTilePtr;
+
+    typedef struct rl2_aux_monolithic_level
+    {
+	/* a Monolithic Pyramid level being built */
+	int id_level;
+	int factor;
+	double res_x;
+	double res_y;
+	unsigned int rows;
+	unsigned int columns;
+	unsigned int row;	/* the next tile to be submitted */
+	unsigned int col;
+	double tile_minx;
+	double tile_maxy;
+	unsigned int retired;	/* tiles already INSERTed (row-major order) */
+    } rl2AuxMonolithicLevel;
+    typedef rl2AuxMonolithicLevel *rl2AuxMonolithicLevelPtr;
+
+    typedef struct rl2_aux_monolithic_tile
+    {
+	/* a Monolithic Pyramid tile to be rescaled and encoded by some worker thread */
+	rl2AuxMonolithicLevelPtr level;
+	unsigned int tile_width;
+	unsigned int tile_height;
+	unsigned char sample_type;
+	unsigned char pixel_type;
+	unsigned char num_bands;
+	unsigned char out_sample_type;
+	unsigned char out_pixel_type;
+	unsigned char out_num_bands;
+	unsigned char out_compression;
+	int out_quality;
+	int factor;
+	unsigned char resampling;
+	double res_x;
+	double res_y;
+	rl2PalettePtr palette;
+	rl2PixelPtr no_data;
+	double minx;
+	double miny;
+	double maxx;
+	double maxy;
+	double end_x;
+	double end_y;
+	int num_bases;
+	int max_bases;
+	rl2AuxPyramidBasePtr bases;
+	unsigned char *blob_odd;
+	unsigned char *blob_even;
+	int blob_odd_sz;
+	int blob_even_sz;
+	int void_tile;
+	int done;
+	int retcode;
+    } rl2AuxMonolithicTile;
+    typedef rl2AuxMonolithicTile *rl2AuxMonolithicTilePtr;
+
     typedef struct resolution_level
     {
 	int level;
@@ -1272,10 +1606,11 @@ extern "C"
     } rl2Geometry;
     typedef rl2Geometry *rl2GeometryPtr;
 
+    typedef struct rl2_worker_batch *rl2WorkerBatchPtr;
+
     typedef struct rl2_aux_importer_tile
     {
 	struct rl2_aux_importer *mother;
-	void *opaque_thread_id;
 	rl2RasterPtr raster;
 	unsigned int row;
 	unsigned int col;
@@ -1288,6 +1623,7 @@ extern "C"
 	unsigned char *blob_even;
 	int blob_odd_sz;
 	int blob_even_sz;
+	rl2RasterStatisticsPtr stats;
 	struct rl2_aux_importer_tile *next;
     } rl2AuxImporterTile;
     typedef rl2AuxImporterTile *rl2AuxImporterTilePtr;
@@ -1313,14 +1649,23 @@ extern "C"
     } rl2AuxImporter;
     typedef rl2AuxImporter *rl2AuxImporterPtr;
 
+    typedef struct rl2_tile_cache_key
+    {
+	char *db_path;
+	char *coverage;
+	unsigned int generation;
+	int can_store;
+    } rl2TileCacheKey;
+    typedef rl2TileCacheKey *rl2TileCacheKeyPtr;
+
     typedef struct rl2_aux_decoder
     {
-	void *opaque_thread_id;
 	sqlite3_int64 tile_id;
 	unsigned char *blob_odd;
 	unsigned char *blob_even;
 	int blob_odd_sz;
 	int blob_even_sz;
+	struct rl2_slot_buffer *pool;
 	unsigned char *outbuf;
 	unsigned int width;
 	unsigned int height;
@@ -1341,16 +1686,22 @@ extern "C"
 	rl2PrivRasterStatisticsPtr stats;
 	rl2PrivRasterPtr raster;
 	rl2PrivPalettePtr palette;
+	rl2TileCacheKeyPtr cache_key;
+	const char *cache_coverage;
+	int cache_level;
+	void *cached_tile;
+	struct rl2_tile_reader *reader;
+	int verify_checksum;
 	int retcode;
     } rl2AuxDecoder;
     typedef rl2AuxDecoder *rl2AuxDecoderPtr;
 
     typedef struct rl2_aux_mask_decoder
     {
-	void *opaque_thread_id;
 	sqlite3_int64 tile_id;
 	unsigned char *blob_odd;
 	int blob_odd_sz;
+	struct rl2_slot_buffer *pool;
 	unsigned char *maskbuf;
 	unsigned int width;
 	unsigned int height;
@@ -1368,7 +1719,6 @@ extern "C"
 
     typedef struct rl2_aux_shadower
     {
-	void *opaque_thread_id;
 	unsigned int width;
 	unsigned int height;
 	double relief_factor;
@@ -1390,7 +1740,6 @@ extern "C"
 	void *at_data;
 	void *in;
 	void *out;
-	void *opaque_thread_id;
 	int base_row;
 	int row_incr;
     } rl2TransformParams;
@@ -1531,7 +1880,10 @@ extern "C"
 				      unsigned char num_bands,
 				      rl2PixelPtr no_data);
 
-    RL2_PRIVATE int rl2_load_dbms_tiles (sqlite3 * handle, int max_threads,
+    RL2_PRIVATE int rl2_load_dbms_tiles (sqlite3 * handle, const void *data,
+					 int max_threads,
+					 const char *db_prefix,
+					 const char *coverage,
 					 sqlite3_stmt * stmt_tiles,
 					 sqlite3_stmt * stmt_data,
 					 unsigned char *outbuf,
@@ -1551,7 +1903,10 @@ extern "C"
 					 rl2RasterStatisticsPtr stats);
 
     RL2_PRIVATE int rl2_load_dbms_tiles_section (sqlite3 * handle,
+						 const void *data,
 						 int max_threads,
+						 const char *db_prefix,
+						 const char *coverage,
 						 sqlite3_int64 section_id,
 						 sqlite3_stmt * stmt_tiles,
 						 sqlite3_stmt * stmt_data,
@@ -1649,7 +2004,17 @@ extern "C"
 					  int scale, double x_res,
 					  double y_res);
 
+    RL2_PRIVATE struct rl2_resolutions_table
+	*rl2_load_resolutions_table (sqlite3 * handle, const char *db_prefix,
+				     const char *coverage, int by_section,
+				     sqlite3_int64 section_id);
+
+    RL2_PRIVATE void rl2_destroy_resolutions_table (struct
+						    rl2_resolutions_table
+						    *table);
+
     RL2_PRIVATE int rl2_find_best_resolution_level (sqlite3 * handle,
+						    const void *data,
 						    const char *db_prefix,
 						    const char *coverage,
 						    int by_section,
@@ -2193,6 +2558,7 @@ extern "C"
     RL2_PRIVATE int rl2_has_styled_rgb_colors (rl2RasterSymbolizerPtr style);
 
     RL2_PRIVATE int rl2_get_raw_raster_data_common (sqlite3 * handle,
+						    const void *data,
 						    int max_threads,
 						    rl2CoveragePtr cvg,
 						    int by_section,
@@ -2213,7 +2579,72 @@ extern "C"
 						    rl2RasterStatisticsPtr
 						    stats);
 
+    RL2_PRIVATE int rl2_get_raw_raster_data_bgcolor_common (sqlite3 *
+							    handle,
+							    const void *data,
+							    int max_threads,
+							    rl2CoveragePtr
+							    cvg,
+							    unsigned int
+							    width,
+							    unsigned int
+							    height,
+							    double minx,
+							    double miny,
+							    double maxx,
+							    double maxy,
+							    double x_res,
+							    double y_res,
+							    unsigned char
+							    **buffer,
+							    int *buf_size,
+							    rl2PalettePtr *
+							    palette,
+							    unsigned char
+							    *out_pixel,
+							    unsigned char
+							    bg_red,
+							    unsigned char
+							    bg_green,
+							    unsigned char
+							    bg_blue,
+							    rl2RasterSymbolizerPtr
+							    style,
+							    rl2RasterStatisticsPtr
+							    stats);
+
+    RL2_PRIVATE int rl2_get_raw_raster_data_mixed_common (sqlite3 * handle,
+							  const void *data,
+							  int max_threads,
+							  rl2CoveragePtr cvg,
+							  unsigned int width,
+							  unsigned int height,
+							  double minx,
+							  double miny,
+							  double maxx,
+							  double maxy,
+							  double x_res,
+							  double y_res,
+							  unsigned char
+							  **buffer,
+							  int *buf_size,
+							  rl2PalettePtr *
+							  palette,
+							  unsigned char
+							  *out_pixel,
+							  unsigned char
+							  bg_red,
+							  unsigned char
+							  bg_green,
+							  unsigned char
+							  bg_blue,
+							  rl2RasterSymbolizerPtr
+							  style,
+							  rl2RasterStatisticsPtr
+							  stats);
+
     RL2_PRIVATE int rl2_get_raw_raster_mask_common (sqlite3 * handle,
+						    const void *data,
 						    int max_threads,
 						    rl2CoveragePtr cvg,
 						    int by_section,
@@ -2226,6 +2657,34 @@ extern "C"
 						    unsigned char **mask,
 						    int *mask_size);
 
+    RL2_PRIVATE rl2RasterPtr
+	rl2_raster_decode_ex (int scale, const unsigned char *blob_odd,
+			      int blob_odd_sz, const unsigned char *blob_even,
+			      int blob_even_sz, rl2PalettePtr palette,
+			      int verify_checksum);
+
+    RL2_PRIVATE int rl2_is_view_decodable (const unsigned char *blob_odd,
+					   int blob_odd_sz,
+					   rl2DecodeViewPtr view);
+
+    RL2_PRIVATE int rl2_raster_decode_view (int scale,
+					    const unsigned char *blob_odd,
+					    int blob_odd_sz,
+					    const unsigned char *blob_even,
+					    int blob_even_sz,
+					    int verify_checksum,
+					    rl2DecodeViewPtr view);
+
+    RL2_PRIVATE int rl2_raster_decode_rgba (int scale,
+					    const unsigned char *blob_odd,
+					    int blob_odd_sz,
+					    const unsigned char *blob_even,
+					    int blob_even_sz,
+					    rl2PalettePtr palette,
+					    rl2PixelPtr no_data,
+					    unsigned char **rgba,
+					    int *rgba_sz);
+
     RL2_PRIVATE rl2RasterPtr
 	rl2_raster_decode_mask (int scale, const unsigned char *blob_odd,
 				int blob_odd_sz, int *status);
@@ -2261,6 +2720,70 @@ extern "C"
     RL2_PRIVATE int rl2_delta_decode (unsigned char *buffer, int size,
 				      int distance);
 
+    RL2_PRIVATE void rl2_byte_shuffle (const unsigned char *in,
+				       unsigned char *out, int size,
+				       int stride);
+
+    RL2_PRIVATE void rl2_byte_unshuffle (const unsigned char *in,
+					 unsigned char *out, int size,
+					 int stride);
+
+    RL2_PRIVATE unsigned int rl2_crc32c (const unsigned char *buf, int size);
+
+    RL2_PRIVATE void rl2_simd_swap (unsigned char *out,
+				    const unsigned char *in, int count,
+				    int sample_size);
+
+    RL2_PRIVATE void rl2_simd_gather (unsigned char *out,
+				      const unsigned char *in, int count,
+				      int pixel_bytes, int step);
+
+    RL2_PRIVATE void rl2_copy_pixel_row (unsigned char *out,
+					 const unsigned char *in,
+					 unsigned int count, int sample_size,
+					 int num_bands, int step, int swap);
+
+    RL2_PRIVATE void rl2_simd_accumulate (const void *in, int count,
+					  int sample_size, int stride,
+					  rl2SampleAccumulatorPtr acc);
+
+    RL2_PRIVATE int rl2_box_reduce (rl2BoxFilterPtr filter);
+
+    RL2_PRIVATE double rl2_box_sample_value (const rl2PrivSample * sample,
+					     unsigned char sample_type);
+
+    RL2_PRIVATE void rl2_box_widen_row (const void *in, size_t offset,
+					unsigned int count,
+					unsigned char sample_type,
+					double *vals);
+
+    RL2_PRIVATE void rl2_box_check_row (rl2BoxFilterPtr filter,
+					unsigned int y, const double *vals,
+					const double *nd, unsigned char *ok);
+
+    RL2_PRIVATE void rl2_unpack_bits (unsigned char *out,
+				      const unsigned char *in, int count,
+				      int bits);
+
+    RL2_PRIVATE void rl2_pack_bits (unsigned char *out,
+				    const unsigned char *in, int count,
+				    int bits);
+
+    RL2_PRIVATE void rl2_unpack_bits_rgba (unsigned char *out,
+					   const unsigned char *in, int count,
+					   int bits,
+					   const unsigned char *rgba_lut);
+
+    RL2_PRIVATE void rl2_float_predictor_encode (const unsigned char *in,
+						 unsigned char *out,
+						 int size, int sample_size,
+						 int little_endian);
+
+    RL2_PRIVATE void rl2_float_predictor_decode (unsigned char *in,
+						 unsigned char *out,
+						 int size, int sample_size,
+						 int little_endian);
+
     RL2_PRIVATE rl2PrivVariantValuePtr rl2_create_variant_int (const char
 							       *name,
 							       sqlite3_int64
@@ -2299,6 +2822,17 @@ extern "C"
     RL2_PRIVATE int rl2_geometry_to_blob (rl2GeometryPtr geom,
 					  unsigned char **blob, int *blob_sz);
 
+    RL2_PRIVATE int rl2_point_from_blob (const unsigned char *blob,
+					 int blob_sz, double *x, double *y,
+					 int *srid);
+
+    RL2_PRIVATE int rl2_multipoint_xyz_to_blob (int srid, int count,
+						const double *x,
+						const double *y,
+						const double *z,
+						unsigned char **blob,
+						int *blob_sz);
+
     RL2_PRIVATE rl2GeometryPtr
 	rl2_curve_from_XY (int points, double *x, double *y);
 
@@ -2373,12 +2907,123 @@ extern "C"
 				int pyramid_level, double x, double y,
 				rl2PalettePtr palette, rl2RasterPtr * raster);
 
+    RL2_PRIVATE int rl2_set_raster_cache_items (const void *data, int items);
+
+    RL2_PRIVATE rl2CoveragePtr rl2_get_cached_coverage (sqlite3 * handle,
+							const void *data,
+							const char *db_prefix,
+							const char *coverage);
+
+    RL2_PRIVATE rl2PalettePtr rl2_get_cached_palette (sqlite3 * handle,
+						      const void *data,
+						      const char *db_prefix,
+						      const char *coverage);
+
+    RL2_PRIVATE rl2RasterStatisticsPtr
+	rl2_get_cached_raster_statistics (sqlite3 * handle, const void *data,
+					  const char *db_prefix,
+					  const char *coverage);
+
+    RL2_PRIVATE rl2CoverageStylePtr
+	rl2_get_cached_coverage_style (sqlite3 * handle, const void *data,
+				       const char *db_prefix,
+				       const char *coverage,
+				       const char *style);
+
+    RL2_PRIVATE void rl2_flush_metadata_cache (const void *data);
+
+    RL2_PRIVATE sqlite3_stmt *rl2_acquire_cached_stmt (sqlite3 * handle,
+						       const void *data,
+						       const char *db_prefix,
+						       const char *coverage,
+						       int kind,
+						       const char *sql);
+
+    RL2_PRIVATE void rl2_release_cached_stmt (const void *data,
+					      sqlite3_stmt * stmt);
+
+    RL2_PRIVATE void rl2_enable_stmt_cache (const void *data, int enabled);
+
+    RL2_PRIVATE rl2GridTileRefsPtr rl2_get_grid_tile_refs (sqlite3 * handle,
+							   const void *data,
+							   const char
+							   *db_prefix,
+							   const char
+							   *coverage,
+							   int by_section,
+							   sqlite3_int64
+							   section_id,
+							   int level,
+							   double minx,
+							   double miny,
+							   double maxx,
+							   double maxy);
+
+    RL2_PRIVATE void rl2_destroy_grid_tile_refs (rl2GridTileRefsPtr refs);
+
+    RL2_PRIVATE void rl2_enable_tile_grid (const void *data, int enabled);
+
+    RL2_PRIVATE struct rl2_tile_readers *rl2_get_tile_readers (sqlite3 *
+							       handle,
+							       const void
+							       *data,
+							       const char
+							       *db_prefix,
+							       int count);
+
+    RL2_PRIVATE int rl2_read_tile_blobs (struct rl2_tile_reader *reader,
+					 const char *coverage,
+					 sqlite3_int64 tile_id, int even,
+					 unsigned char **blob_odd,
+					 int *blob_odd_sz,
+					 unsigned char **blob_even,
+					 int *blob_even_sz);
+
+    RL2_PRIVATE void rl2_release_tile_reader (struct rl2_tile_reader
+					      *reader);
+
+    RL2_PRIVATE void rl2_enable_tile_readers (const void *data, int enabled);
+
+    RL2_PRIVATE int rl2_grow_blob_buffer (unsigned char **buffer, int *max,
+					  int size);
+
+    RL2_PRIVATE int rl2_read_incremental_blob (sqlite3 * handle,
+					       const char *db_prefix,
+					       const char *coverage,
+					       const char *table,
+					       const char *column,
+					       sqlite3_int64 tile_id,
+					       sqlite3_blob ** blob,
+					       unsigned char **buffer,
+					       int *max, int *blob_sz);
+
+    RL2_PRIVATE struct rl2_slot_buffers *rl2_get_slot_buffers (const void
+							       *data,
+							       int count);
+
+    RL2_PRIVATE void rl2_release_slot_buffers (struct rl2_slot_buffers
+					       *buffers);
+
+    RL2_PRIVATE struct rl2_resolutions_table
+	*rl2_get_cached_resolutions (sqlite3 * handle, const void *data,
+				     const char *db_prefix,
+				     const char *coverage, int by_section,
+				     sqlite3_int64 section_id);
+
     RL2_PRIVATE void
 	rl2_destroy_private_tt_font (struct rl2_private_tt_font *font);
 
     RL2_PRIVATE rl2PrivPointSymbolizerPtr
 	rl2_clone_point_symbolizer (rl2PrivPointSymbolizerPtr in);
 
+    RL2_PRIVATE rl2CoverageStylePtr
+	rl2_clone_coverage_style (rl2CoverageStylePtr style);
+
+    RL2_PRIVATE rl2CoveragePtr rl2_clone_coverage (rl2CoveragePtr cvg);
+
+    RL2_PRIVATE rl2RasterStatisticsPtr
+	rl2_clone_raster_statistics (rl2RasterStatisticsPtr stats);
+
     RL2_PRIVATE rl2PrivLineSymbolizerPtr
 	rl2_clone_line_symbolizer (rl2PrivLineSymbolizerPtr in);
 
@@ -2455,6 +3100,66 @@ extern "C"
 
     RL2_PRIVATE char *rl2_init_tmp_atm_table (void *data);
 
+    RL2_PRIVATE int rl2_set_worker_threads (int count);
+
+    RL2_PRIVATE void rl2_retain_worker_threads (void);
+
+    RL2_PRIVATE void rl2_release_worker_threads (void);
+
+    RL2_PRIVATE rl2WorkerBatchPtr rl2_create_worker_batch (int max_threads);
+
+    RL2_PRIVATE void rl2_submit_worker_job (rl2WorkerBatchPtr batch,
+					    void (*run) (void *arg),
+					    void *arg);
+
+    RL2_PRIVATE void rl2_wait_worker_batch (rl2WorkerBatchPtr batch);
+
+    RL2_PRIVATE void *rl2_next_completed_worker_job (rl2WorkerBatchPtr
+						     batch);
+
+    RL2_PRIVATE void rl2_destroy_worker_batch (rl2WorkerBatchPtr batch);
+
+    RL2_PRIVATE rl2TileCacheKeyPtr rl2_get_tile_cache_key (sqlite3 * handle,
+							    const void *data,
+							    const char
+							    *db_prefix,
+							    const char
+							    *coverage);
+
+    RL2_PRIVATE void rl2_destroy_tile_cache_key (rl2TileCacheKeyPtr key);
+
+    RL2_PRIVATE void *rl2_lookup_cached_tile (rl2TileCacheKeyPtr key,
+					      int level, sqlite3_int64 tile_id,
+					      int scale, rl2RasterPtr * raster);
+
+    RL2_PRIVATE void *rl2_store_cached_tile (rl2TileCacheKeyPtr key,
+					     int level, sqlite3_int64 tile_id,
+					     int scale, rl2RasterPtr raster);
+
+    RL2_PRIVATE void rl2_release_cached_tile (void *tile);
+
+    RL2_PRIVATE void rl2_invalidate_tile_cache (sqlite3 * handle,
+						const char *db_prefix,
+						const char *coverage);
+
+    RL2_PRIVATE void rl2_flush_tile_cache (void);
+
+    RL2_PRIVATE int rl2_enable_dirty_regions (sqlite3 * handle,
+					      const char *coverage);
+
+    RL2_PRIVATE int rl2_parse_resampling_name (const char *name,
+					       unsigned char *resampling);
+
+    RL2_PRIVATE const char *rl2_resampling_name (unsigned char resampling);
+
+    RL2_PRIVATE sqlite3_int64 rl2_set_tile_cache_size (sqlite3_int64
+						       max_size);
+
+    RL2_PRIVATE void rl2_get_tile_cache_stats (sqlite3_int64 * max_size,
+					       sqlite3_int64 * curr_size,
+					       sqlite3_int64 * hits,
+					       sqlite3_int64 * misses);
+
 #ifdef __cplusplus
 }
 #endif
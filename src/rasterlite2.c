@@ -105,6 +105,13 @@ is_valid_compression (unsigned char compression)
       case RL2_COMPRESSION_DEFLATE_NO:
       case RL2_COMPRESSION_LZMA:
       case RL2_COMPRESSION_LZMA_NO:
+      case RL2_COMPRESSION_ZSTD:
+      case RL2_COMPRESSION_ZSTD_NO:
+      case RL2_COMPRESSION_LZ4:
+      case RL2_COMPRESSION_LZ4_NO:
+      case RL2_COMPRESSION_DEFLATE_FP:
+      case RL2_COMPRESSION_LZMA_FP:
+      case RL2_COMPRESSION_ZSTD_FP:
       case RL2_COMPRESSION_PNG:
       case RL2_COMPRESSION_JPEG:
       case RL2_COMPRESSION_LOSSY_WEBP:
@@ -137,6 +144,10 @@ check_coverage_self_consistency (unsigned char sample_type,
 	    case RL2_COMPRESSION_DEFLATE_NO:
 	    case RL2_COMPRESSION_LZMA:
 	    case RL2_COMPRESSION_LZMA_NO:
+	    case RL2_COMPRESSION_ZSTD:
+	    case RL2_COMPRESSION_ZSTD_NO:
+	    case RL2_COMPRESSION_LZ4:
+	    case RL2_COMPRESSION_LZ4_NO:
 	    case RL2_COMPRESSION_PNG:
 	    case RL2_COMPRESSION_CCITTFAX4:
 		break;
@@ -165,6 +176,10 @@ check_coverage_self_consistency (unsigned char sample_type,
 	    case RL2_COMPRESSION_DEFLATE_NO:
 	    case RL2_COMPRESSION_LZMA:
 	    case RL2_COMPRESSION_LZMA_NO:
+	    case RL2_COMPRESSION_ZSTD:
+	    case RL2_COMPRESSION_ZSTD_NO:
+	    case RL2_COMPRESSION_LZ4:
+	    case RL2_COMPRESSION_LZ4_NO:
 	    case RL2_COMPRESSION_PNG:
 		break;
 	    default:
@@ -190,6 +205,10 @@ check_coverage_self_consistency (unsigned char sample_type,
 	    case RL2_COMPRESSION_DEFLATE_NO:
 	    case RL2_COMPRESSION_LZMA:
 	    case RL2_COMPRESSION_LZMA_NO:
+	    case RL2_COMPRESSION_ZSTD:
+	    case RL2_COMPRESSION_ZSTD_NO:
+	    case RL2_COMPRESSION_LZ4:
+	    case RL2_COMPRESSION_LZ4_NO:
 	    case RL2_COMPRESSION_PNG:
 	    case RL2_COMPRESSION_JPEG:
 	    case RL2_COMPRESSION_LOSSY_WEBP:
@@ -222,6 +241,10 @@ check_coverage_self_consistency (unsigned char sample_type,
 		  case RL2_COMPRESSION_DEFLATE_NO:
 		  case RL2_COMPRESSION_LZMA:
 		  case RL2_COMPRESSION_LZMA_NO:
+		  case RL2_COMPRESSION_ZSTD:
+		  case RL2_COMPRESSION_ZSTD_NO:
+		  case RL2_COMPRESSION_LZ4:
+		  case RL2_COMPRESSION_LZ4_NO:
 		  case RL2_COMPRESSION_PNG:
 		  case RL2_COMPRESSION_CHARLS:
 		  case RL2_COMPRESSION_LOSSY_JP2:
@@ -240,6 +263,10 @@ check_coverage_self_consistency (unsigned char sample_type,
 		  case RL2_COMPRESSION_DEFLATE_NO:
 		  case RL2_COMPRESSION_LZMA:
 		  case RL2_COMPRESSION_LZMA_NO:
+		  case RL2_COMPRESSION_ZSTD:
+		  case RL2_COMPRESSION_ZSTD_NO:
+		  case RL2_COMPRESSION_LZ4:
+		  case RL2_COMPRESSION_LZ4_NO:
 		  case RL2_COMPRESSION_PNG:
 		  case RL2_COMPRESSION_JPEG:
 		  case RL2_COMPRESSION_LOSSY_WEBP:
@@ -275,6 +302,10 @@ check_coverage_self_consistency (unsigned char sample_type,
 			case RL2_COMPRESSION_DEFLATE_NO:
 			case RL2_COMPRESSION_LZMA:
 			case RL2_COMPRESSION_LZMA_NO:
+			case RL2_COMPRESSION_ZSTD:
+			case RL2_COMPRESSION_ZSTD_NO:
+			case RL2_COMPRESSION_LZ4:
+			case RL2_COMPRESSION_LZ4_NO:
 			case RL2_COMPRESSION_PNG:
 			case RL2_COMPRESSION_CHARLS:
 			case RL2_COMPRESSION_LOSSY_JP2:
@@ -293,6 +324,10 @@ check_coverage_self_consistency (unsigned char sample_type,
 			case RL2_COMPRESSION_DEFLATE_NO:
 			case RL2_COMPRESSION_LZMA:
 			case RL2_COMPRESSION_LZMA_NO:
+			case RL2_COMPRESSION_ZSTD:
+			case RL2_COMPRESSION_ZSTD_NO:
+			case RL2_COMPRESSION_LZ4:
+			case RL2_COMPRESSION_LZ4_NO:
 			case RL2_COMPRESSION_PNG:
 			case RL2_COMPRESSION_LOSSY_WEBP:
 			case RL2_COMPRESSION_LOSSLESS_WEBP:
@@ -314,6 +349,10 @@ check_coverage_self_consistency (unsigned char sample_type,
 		  case RL2_COMPRESSION_DEFLATE_NO:
 		  case RL2_COMPRESSION_LZMA:
 		  case RL2_COMPRESSION_LZMA_NO:
+		  case RL2_COMPRESSION_ZSTD:
+		  case RL2_COMPRESSION_ZSTD_NO:
+		  case RL2_COMPRESSION_LZ4:
+		  case RL2_COMPRESSION_LZ4_NO:
 		      break;
 		  default:
 		      return 0;
@@ -347,6 +386,10 @@ check_coverage_self_consistency (unsigned char sample_type,
 		  case RL2_COMPRESSION_DEFLATE_NO:
 		  case RL2_COMPRESSION_LZMA:
 		  case RL2_COMPRESSION_LZMA_NO:
+		  case RL2_COMPRESSION_ZSTD:
+		  case RL2_COMPRESSION_ZSTD_NO:
+		  case RL2_COMPRESSION_LZ4:
+		  case RL2_COMPRESSION_LZ4_NO:
 		  case RL2_COMPRESSION_PNG:
 		  case RL2_COMPRESSION_CHARLS:
 		  case RL2_COMPRESSION_LOSSY_JP2:
@@ -365,6 +408,18 @@ check_coverage_self_consistency (unsigned char sample_type,
 		  case RL2_COMPRESSION_DEFLATE_NO:
 		  case RL2_COMPRESSION_LZMA:
 		  case RL2_COMPRESSION_LZMA_NO:
+		  case RL2_COMPRESSION_ZSTD:
+		  case RL2_COMPRESSION_ZSTD_NO:
+		  case RL2_COMPRESSION_LZ4:
+		  case RL2_COMPRESSION_LZ4_NO:
+		      break;
+		  case RL2_COMPRESSION_DEFLATE_FP:
+		  case RL2_COMPRESSION_LZMA_FP:
+		  case RL2_COMPRESSION_ZSTD_FP:
+		      /* the FloatPredictor only applies to FLOAT and DOUBLE */
+		      if (sample_type != RL2_SAMPLE_FLOAT
+			  && sample_type != RL2_SAMPLE_DOUBLE)
+			  return 0;
 		      break;
 		  default:
 		      return 0;
@@ -478,16 +533,33 @@ rl2_is_supported_codec (unsigned char compression)
       case RL2_COMPRESSION_NONE:
       case RL2_COMPRESSION_DEFLATE:
       case RL2_COMPRESSION_DEFLATE_NO:
+      case RL2_COMPRESSION_DEFLATE_FP:
       case RL2_COMPRESSION_PNG:
       case RL2_COMPRESSION_JPEG:
       case RL2_COMPRESSION_CCITTFAX4:
 	  return RL2_TRUE;
       case RL2_COMPRESSION_LZMA:
       case RL2_COMPRESSION_LZMA_NO:
+      case RL2_COMPRESSION_LZMA_FP:
 #ifndef OMIT_LZMA
 	  return RL2_TRUE;
 #else
 	  return RL2_FALSE;
+#endif
+      case RL2_COMPRESSION_ZSTD:
+      case RL2_COMPRESSION_ZSTD_NO:
+      case RL2_COMPRESSION_ZSTD_FP:
+#ifndef OMIT_ZSTD
+	  return RL2_TRUE;
+#else
+	  return RL2_FALSE;
+#endif
+      case RL2_COMPRESSION_LZ4:
+      case RL2_COMPRESSION_LZ4_NO:
+#ifndef OMIT_LZ4
+	  return RL2_TRUE;
+#else
+	  return RL2_FALSE;
 #endif
       case RL2_COMPRESSION_LOSSY_WEBP:
       case RL2_COMPRESSION_LOSSLESS_WEBP:
@@ -602,6 +674,7 @@ rl2_create_coverage (const char *db_prefix, const char *name,
     cvg->sectionPaths = 0;
     cvg->sectionMD5 = 0;
     cvg->sectionSummary = 0;
+    cvg->pyramidResampling = RL2_RESAMPLING_DEFAULT;
     return (rl2CoveragePtr) cvg;
 }
 
@@ -621,6 +694,45 @@ rl2_destroy_coverage (rl2CoveragePtr ptr)
     free (cvg);
 }
 
+RL2_PRIVATE rl2CoveragePtr
+rl2_clone_coverage (rl2CoveragePtr ptr)
+{
+/* cloning a Coverage object */
+    int len;
+    rl2PrivCoveragePtr in = (rl2PrivCoveragePtr) ptr;
+    rl2PrivCoveragePtr out;
+    if (in == NULL)
+	return NULL;
+
+    out = malloc (sizeof (rl2PrivCoverage));
+    if (out == NULL)
+	return NULL;
+    memcpy (out, in, sizeof (rl2PrivCoverage));
+    out->dbPrefix = NULL;
+    out->coverageName = NULL;
+    out->noData = NULL;
+    if (in->dbPrefix != NULL)
+      {
+	  len = strlen (in->dbPrefix);
+	  out->dbPrefix = malloc (len + 1);
+	  strcpy (out->dbPrefix, in->dbPrefix);
+      }
+    len = strlen (in->coverageName);
+    out->coverageName = malloc (len + 1);
+    strcpy (out->coverageName, in->coverageName);
+    if (in->noData != NULL)
+      {
+	  out->noData =
+	      (rl2PrivPixelPtr) rl2_clone_pixel ((rl2PixelPtr) (in->noData));
+	  if (out->noData == NULL)
+	    {
+		rl2_destroy_coverage ((rl2CoveragePtr) out);
+		return NULL;
+	    }
+      }
+    return (rl2CoveragePtr) out;
+}
+
 RL2_DECLARE int
 rl2_set_coverage_policies (rl2CoveragePtr ptr, int strict_resolution,
 			   int mixed_resolutions, int section_paths,
@@ -665,6 +777,40 @@ rl2_get_coverage_policies (rl2CoveragePtr ptr, int *strict_resolution,
     return RL2_OK;
 }
 
+RL2_DECLARE int
+rl2_set_coverage_resampling (rl2CoveragePtr ptr, unsigned char resampling)
+{
+/* setting the Coverage's Pyramid Resampling policy */
+    rl2PrivCoveragePtr cvg = (rl2PrivCoveragePtr) ptr;
+    if (cvg == NULL)
+	return RL2_ERROR;
+    switch (resampling)
+      {
+      case RL2_RESAMPLING_DEFAULT:
+      case RL2_RESAMPLING_AVERAGE:
+      case RL2_RESAMPLING_NEAREST:
+      case RL2_RESAMPLING_MODE:
+      case RL2_RESAMPLING_BILINEAR:
+      case RL2_RESAMPLING_CUBIC:
+	  break;
+      default:
+	  return RL2_ERROR;
+      };
+    cvg->pyramidResampling = resampling;
+    return RL2_OK;
+}
+
+RL2_DECLARE int
+rl2_get_coverage_resampling (rl2CoveragePtr ptr, unsigned char *resampling)
+{
+/* retrieving the Coverage's Pyramid Resampling policy */
+    rl2PrivCoveragePtr cvg = (rl2PrivCoveragePtr) ptr;
+    if (cvg == NULL)
+	return RL2_ERROR;
+    *resampling = cvg->pyramidResampling;
+    return RL2_OK;
+}
+
 RL2_DECLARE int
 rl2_coverage_georeference (rl2CoveragePtr ptr, int srid, double horz_res,
 			   double vert_res)
@@ -753,6 +899,13 @@ rl2_is_coverage_compression_lossless (rl2CoveragePtr ptr, int *is_lossless)
       case RL2_COMPRESSION_DEFLATE_NO:
       case RL2_COMPRESSION_LZMA:
       case RL2_COMPRESSION_LZMA_NO:
+      case RL2_COMPRESSION_ZSTD:
+      case RL2_COMPRESSION_ZSTD_NO:
+      case RL2_COMPRESSION_LZ4:
+      case RL2_COMPRESSION_LZ4_NO:
+      case RL2_COMPRESSION_DEFLATE_FP:
+      case RL2_COMPRESSION_LZMA_FP:
+      case RL2_COMPRESSION_ZSTD_FP:
       case RL2_COMPRESSION_PNG:
       case RL2_COMPRESSION_LOSSLESS_WEBP:
       case RL2_COMPRESSION_CHARLS:
@@ -1259,6 +1412,13 @@ rl2_is_section_compression_lossless (rl2SectionPtr ptr, int *is_lossless)
       case RL2_COMPRESSION_DEFLATE_NO:
       case RL2_COMPRESSION_LZMA:
       case RL2_COMPRESSION_LZMA_NO:
+      case RL2_COMPRESSION_ZSTD:
+      case RL2_COMPRESSION_ZSTD_NO:
+      case RL2_COMPRESSION_LZ4:
+      case RL2_COMPRESSION_LZ4_NO:
+      case RL2_COMPRESSION_DEFLATE_FP:
+      case RL2_COMPRESSION_LZMA_FP:
+      case RL2_COMPRESSION_ZSTD_FP:
       case RL2_COMPRESSION_PNG:
       case RL2_COMPRESSION_LOSSLESS_WEBP:
 	  *is_lossless = RL2_TRUE;
@@ -3386,6 +3546,59 @@ rl2_destroy_raster_statistics (rl2RasterStatisticsPtr stats)
     free (st);
 }
 
+RL2_PRIVATE rl2RasterStatisticsPtr
+rl2_clone_raster_statistics (rl2RasterStatisticsPtr stats)
+{
+/* cloning a Raster Statistics object */
+    int nb;
+    int j;
+    rl2PrivRasterStatisticsPtr in = (rl2PrivRasterStatisticsPtr) stats;
+    rl2PrivRasterStatisticsPtr out;
+    if (in == NULL)
+	return NULL;
+
+    out = (rl2PrivRasterStatisticsPtr)
+	rl2_create_raster_statistics (in->sampleType, in->nBands);
+    if (out == NULL)
+	return NULL;
+    out->no_data = in->no_data;
+    out->count = in->count;
+    for (nb = 0; nb < in->nBands; nb++)
+      {
+	  rl2PoolVariancePtr pV;
+	  rl2PrivBandStatisticsPtr band_in = in->band_stats + nb;
+	  rl2PrivBandStatisticsPtr band_out = out->band_stats + nb;
+	  band_out->min = band_in->min;
+	  band_out->max = band_in->max;
+	  band_out->mean = band_in->mean;
+	  band_out->sum_sq_diff = band_in->sum_sq_diff;
+	  if (band_out->nHistogram != band_in->nHistogram)
+	    {
+		free (band_out->histogram);
+		band_out->nHistogram = band_in->nHistogram;
+		band_out->histogram =
+		    malloc (sizeof (double) * band_in->nHistogram);
+	    }
+	  for (j = 0; j < band_in->nHistogram; j++)
+	      *(band_out->histogram + j) = *(band_in->histogram + j);
+	  pV = band_in->first;
+	  while (pV != NULL)
+	    {
+		rl2PoolVariancePtr pV2 = malloc (sizeof (rl2PoolVariance));
+		pV2->variance = pV->variance;
+		pV2->count = pV->count;
+		pV2->next = NULL;
+		if (band_out->first == NULL)
+		    band_out->first = pV2;
+		if (band_out->last != NULL)
+		    band_out->last->next = pV2;
+		band_out->last = pV2;
+		pV = pV->next;
+	    }
+      }
+    return (rl2RasterStatisticsPtr) out;
+}
+
 RL2_DECLARE int
 rl2_get_raster_statistics_summary (rl2RasterStatisticsPtr stats,
 				   double *no_data, double *count,
@@ -43,7 +43,7 @@ the terms of any one of the MPL, the GPL or the LGPL.
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
-#include <time.h>
+#include <math.h>
 
 #ifdef LOADABLE_EXTENSION
 #include "rasterlite2/sqlite.h"
@@ -81,16 +81,33 @@ rl2_alloc_private (void)
     priv_data->first_font = NULL;
     priv_data->last_font = NULL;
     priv_data->raster_cache_items = 4;
+    priv_data->raster_cache_count = 0;
+    priv_data->raster_cache_first = NULL;
+    priv_data->raster_cache_last = NULL;
+    priv_data->raster_cache_grids = NULL;
+    priv_data->first_meta = NULL;
+    priv_data->meta_total_changes = -1;
+    priv_data->stmt_cache_enabled = 0;
+    priv_data->detached_stmts = NULL;
+    priv_data->tile_grid_enabled = 0;
+    priv_data->tile_readers_enabled = 0;
+    priv_data->first_tile_readers = NULL;
+    priv_data->verify_tile_checksums = 1;
+    priv_data->first_cache_stamp = NULL;
+    priv_data->slot_buffers = NULL;
     priv_data->raster_cache =
-	malloc (sizeof (struct rl2_cached_raster) *
-		priv_data->raster_cache_items);
-    for (i = 0; i < priv_data->raster_cache_items; i++)
+	malloc (sizeof (struct rl2_cached_raster *) *
+		RL2_RASTER_CACHE_BUCKETS);
+    if (priv_data->raster_cache == NULL)
       {
-	  struct rl2_cached_raster *ptr = priv_data->raster_cache + i;
-	  ptr->db_prefix = NULL;
-	  ptr->coverage = NULL;
-	  ptr->raster = NULL;
+	  if (priv_data->FTlibrary != NULL)
+	      FT_Done_FreeType ((FT_Library) (priv_data->FTlibrary));
+	  free (priv_data);
+	  return NULL;
       }
+    for (i = 0; i < RL2_RASTER_CACHE_BUCKETS; i++)
+	*(priv_data->raster_cache + i) = NULL;
+    rl2_retain_worker_threads ();
     return priv_data;
 }
 
@@ -127,7 +144,14 @@ rl2_cleanup_private (const void *ptr)
 /* destroying private connection data */
     struct rl2_private_tt_font *pF;
     struct rl2_private_tt_font *pFn;
-    int i;
+    struct rl2_cached_raster *pR;
+    struct rl2_cached_raster *pRn;
+    struct rl2_cached_raster_grid *pG;
+    struct rl2_cached_raster_grid *pGn;
+    struct rl2_cached_stmt *pT;
+    struct rl2_cached_stmt *pTn;
+    struct rl2_tile_cache_stamp *pS;
+    struct rl2_tile_cache_stamp *pSn;
     struct rl2_private_data *priv_data = (struct rl2_private_data *) ptr;
     if (priv_data == NULL)
 	return;
@@ -146,18 +170,58 @@ rl2_cleanup_private (const void *ptr)
 	FT_Done_FreeType ((FT_Library) (priv_data->FTlibrary));
 
 /* cleaning the internal Raster Cache */
-    for (i = 0; i < priv_data->raster_cache_items; i++)
+    pR = priv_data->raster_cache_first;
+    while (pR != NULL)
       {
-	  struct rl2_cached_raster *ptr = priv_data->raster_cache + i;
-	  if (ptr->db_prefix != NULL)
-	      free (ptr->db_prefix);
-	  if (ptr->coverage != NULL)
-	      free (ptr->coverage);
-	  if (ptr->raster != NULL)
-	      rl2_destroy_raster ((rl2RasterPtr) (ptr->raster));
+	  pRn = pR->next;
+	  if (pR->raster != NULL)
+	      rl2_destroy_raster ((rl2RasterPtr) (pR->raster));
+	  free (pR);
+	  pR = pRn;
       }
     free (priv_data->raster_cache);
+    pG = priv_data->raster_cache_grids;
+    while (pG != NULL)
+      {
+	  pGn = pG->next;
+	  if (pG->db_prefix != NULL)
+	      free (pG->db_prefix);
+	  if (pG->coverage != NULL)
+	      free (pG->coverage);
+	  free (pG);
+	  pG = pGn;
+      }
+/* closing all read-only connections */
+    rl2_enable_tile_readers (priv_data, 0);
+/* cleaning the internal Metadata Cache */
+    rl2_flush_metadata_cache (priv_data);
+    pT = priv_data->detached_stmts;
+    while (pT != NULL)
+      {
+	  pTn = pT->next;
+	  sqlite3_finalize (pT->stmt);
+	  free (pT);
+	  pT = pTn;
+      }
+/* cleaning the Tile Cache stamps */
+    pS = priv_data->first_cache_stamp;
+    while (pS != NULL)
+      {
+	  pSn = pS->next;
+	  if (pS->db_prefix != NULL)
+	      free (pS->db_prefix);
+	  free (pS->db_path);
+	  free (pS);
+	  pS = pSn;
+      }
+/* releasing the AuxDecoder slot buffers */
+    if (priv_data->slot_buffers != NULL)
+      {
+	  priv_data->slot_buffers->owned = 0;
+	  rl2_release_slot_buffers (priv_data->slot_buffers);
+      }
     free (priv_data);
+    rl2_release_worker_threads ();
 }
 
 static int
@@ -175,124 +239,305 @@ do_match_raster_bbox (rl2PrivRasterPtr raster, double x, double y)
     return 1;
 }
 
+static int
+do_own_raster_point (rl2PrivRasterPtr raster, double x, double y)
+{
+/* 
+/ testing if the Point strictly belongs to the Tile (half-open BBOX)
+/ a Point lying on the edge shared by two adjacent Tiles belongs to
+/ the Tile on its right or below, the same as for pixels; a Point on
+/ the right or bottom edge of the Coverage is never owned by any
+/ cached Tile, so it will always be loaded again
+*/
+    if (!do_match_raster_bbox (raster, x, y))
+	return 0;
+    if (x == raster->maxX || y == raster->minY)
+	return 0;
+    return 1;
+}
+
+static int
+do_match_raster_grid (struct rl2_cached_raster_grid *grid,
+		      const char *db_prefix, const char *coverage,
+		      int pyramid_level)
+{
+/* testing if a Tile Grid belongs to the given Coverage and Level */
+    if (grid->pyramid_level != pyramid_level)
+	return 0;
+    if (grid->db_prefix == NULL && db_prefix == NULL)
+	;
+    else if (grid->db_prefix != NULL && db_prefix != NULL)
+      {
+	  if (strcasecmp (grid->db_prefix, db_prefix) != 0)
+	      return 0;
+      }
+    else
+	return 0;
+    if (strcasecmp (grid->coverage, coverage) != 0)
+	return 0;
+    return 1;
+}
+
+static unsigned int
+do_hash_cached_raster (struct rl2_cached_raster_grid *grid, int tile_col,
+		       int tile_row)
+{
+/* computing the Hash Bucket of some Tile address */
+    unsigned int hash = (unsigned int) (((size_t) grid) >> 4);
+    hash = (hash * 31) + (unsigned int) tile_col;
+    hash = (hash * 31) + (unsigned int) tile_row;
+    hash ^= hash >> 16;
+    return hash % RL2_RASTER_CACHE_BUCKETS;
+}
+
+static struct rl2_cached_raster *
+do_find_cached_tile (struct rl2_private_data *priv_data,
+		     struct rl2_cached_raster_grid *grid, int tile_col,
+		     int tile_row)
+{
+/* searching a Tile within the Hash Table */
+    struct rl2_cached_raster *ptr =
+	*(priv_data->raster_cache +
+	  do_hash_cached_raster (grid, tile_col, tile_row));
+    while (ptr != NULL)
+      {
+	  if (ptr->grid == grid && ptr->tile_col == tile_col
+	      && ptr->tile_row == tile_row)
+	      return ptr;
+	  ptr = ptr->hash_next;
+      }
+    return NULL;
+}
+
+static void
+do_unlink_cached_raster (struct rl2_private_data *priv_data,
+			 struct rl2_cached_raster *ptr)
+{
+/* removing a Tile from the LRU list */
+    if (ptr->prev != NULL)
+	ptr->prev->next = ptr->next;
+    else
+	priv_data->raster_cache_first = ptr->next;
+    if (ptr->next != NULL)
+	ptr->next->prev = ptr->prev;
+    else
+	priv_data->raster_cache_last = ptr->prev;
+    ptr->prev = NULL;
+    ptr->next = NULL;
+}
+
+static void
+do_touch_cached_raster (struct rl2_private_data *priv_data,
+			struct rl2_cached_raster *ptr)
+{
+/* moving a Tile in front of the LRU list (most recently used) */
+    if (priv_data->raster_cache_first == ptr)
+	return;
+    do_unlink_cached_raster (priv_data, ptr);
+    ptr->next = priv_data->raster_cache_first;
+    if (priv_data->raster_cache_first != NULL)
+	priv_data->raster_cache_first->prev = ptr;
+    priv_data->raster_cache_first = ptr;
+    if (priv_data->raster_cache_last == NULL)
+	priv_data->raster_cache_last = ptr;
+}
+
+static void
+do_evict_cached_raster (struct rl2_private_data *priv_data,
+			struct rl2_cached_raster *ptr)
+{
+/* removing a Tile from the Cache and destroying it */
+    struct rl2_cached_raster **pp =
+	priv_data->raster_cache + do_hash_cached_raster (ptr->grid,
+							 ptr->tile_col,
+							 ptr->tile_row);
+    while (*pp != NULL)
+      {
+	  if (*pp == ptr)
+	    {
+		*pp = ptr->hash_next;
+		break;
+	    }
+	  pp = &((*pp)->hash_next);
+      }
+    do_unlink_cached_raster (priv_data, ptr);
+    if (ptr->raster != NULL)
+	rl2_destroy_raster ((rl2RasterPtr) (ptr->raster));
+    free (ptr);
+    priv_data->raster_cache_count -= 1;
+}
+
+static void
+do_shrink_raster_cache (struct rl2_private_data *priv_data)
+{
+/* evicting the least recently used Tiles exceeding the Cache capacity */
+    while (priv_data->raster_cache_count > priv_data->raster_cache_items
+	   && priv_data->raster_cache_last != NULL)
+	do_evict_cached_raster (priv_data, priv_data->raster_cache_last);
+}
+
 RL2_PRIVATE int
 rl2_find_cached_raster (const void *data, const char *db_prefix,
 			const char *coverage, int pyramid_level, double x,
 			double y, rl2RasterPtr * raster)
 {
 /* will return the pointer to a Raster object stored within the internal Cache */
-    int i;
+    struct rl2_cached_raster_grid *grid;
     struct rl2_private_data *priv_data = (struct rl2_private_data *) data;
 
     *raster = NULL;
     if (priv_data == NULL)
 	return RL2_ERROR;
 
-    for (i = 0; i < priv_data->raster_cache_items; i++)
+    grid = priv_data->raster_cache_grids;
+    while (grid != NULL)
       {
-	  int ok = 1;
-	  struct rl2_cached_raster *ptr = priv_data->raster_cache + i;
-	  if (ptr->raster == NULL)
-	      continue;
-	  if (ptr->db_prefix == NULL && db_prefix == NULL)
-	      ;
-	  else if (ptr->db_prefix != NULL && db_prefix != NULL)
+	  if (do_match_raster_grid (grid, db_prefix, coverage, pyramid_level))
 	    {
-		if (strcasecmp (ptr->db_prefix, db_prefix) != 0)
-		    ok = 0;
+		/* 
+		 * a Tile covering the Point can only be keyed on the
+		 * column just before or exactly matching X, and on the
+		 * row exactly matching or just after Y
+		 */
+		int c;
+		int r;
+		int col = (int) floor (x / grid->tile_ext_x);
+		int row = (int) floor (y / grid->tile_ext_y);
+		for (r = row; r <= row + 1; r++)
+		  {
+		      for (c = col - 1; c <= col; c++)
+			{
+			    struct rl2_cached_raster *ptr =
+				do_find_cached_tile (priv_data, grid, c, r);
+			    if (ptr == NULL)
+				continue;
+			    if (!do_own_raster_point (ptr->raster, x, y))
+				continue;
+			    do_touch_cached_raster (priv_data, ptr);
+			    *raster = (rl2RasterPtr) (ptr->raster);
+			    return RL2_OK;
+			}
+		  }
 	    }
-	  else
-	      ok = 0;
-	  if (strcasecmp (ptr->coverage, coverage) != 0)
-	      ok = 0;
-	  if (ptr->pyramid_level != pyramid_level)
-	      ok = 0;
-	  if (!do_match_raster_bbox (ptr->raster, x, y))
-	      ok = 0;
-	  if (ok)
+	  grid = grid->next;
+      }
+    return RL2_ERROR;
+}
+
+static struct rl2_cached_raster_grid *
+do_get_raster_grid (struct rl2_private_data *priv_data, const char *db_prefix,
+		    const char *coverage, int pyramid_level, double ext_x,
+		    double ext_y)
+{
+/* returning the Tile Grid matching the given Tile extent (creating if needed) */
+    int len;
+    struct rl2_cached_raster_grid *grid = priv_data->raster_cache_grids;
+    while (grid != NULL)
+      {
+	  if (do_match_raster_grid (grid, db_prefix, coverage, pyramid_level))
 	    {
-		*raster = (rl2RasterPtr) (ptr->raster);
-		ptr->last_used = time (NULL);
-		return RL2_OK;
+		if (fabs (grid->tile_ext_x - ext_x) <= ext_x / 1000000.0
+		    && fabs (grid->tile_ext_y - ext_y) <= ext_y / 1000000.0)
+		    return grid;
 	    }
+	  grid = grid->next;
       }
-    return RL2_ERROR;
+
+    grid = malloc (sizeof (struct rl2_cached_raster_grid));
+    if (grid == NULL)
+	return NULL;
+    if (db_prefix == NULL)
+	grid->db_prefix = NULL;
+    else
+      {
+	  len = strlen (db_prefix);
+	  grid->db_prefix = malloc (len + 1);
+	  strcpy (grid->db_prefix, db_prefix);
+      }
+    len = strlen (coverage);
+    grid->coverage = malloc (len + 1);
+    strcpy (grid->coverage, coverage);
+    grid->pyramid_level = pyramid_level;
+    grid->tile_ext_x = ext_x;
+    grid->tile_ext_y = ext_y;
+    grid->next = priv_data->raster_cache_grids;
+    priv_data->raster_cache_grids = grid;
+    return grid;
 }
 
-static void
+static int
 add_raster2cache (const void *data, const char *db_prefix, const char *coverage,
 		  int pyramid_level, rl2RasterPtr raster)
 {
 // inserting a Raster into the Cache
-    int i;
-    int index = -1;
-    int old_index = -1;
-    time_t old_time;
-    int len;
+    unsigned int bucket;
+    int tile_col;
+    int tile_row;
+    double ext_x;
+    double ext_y;
     struct rl2_cached_raster *ptr;
+    struct rl2_cached_raster_grid *grid;
+    rl2PrivRasterPtr rst = (rl2PrivRasterPtr) raster;
     struct rl2_private_data *priv_data = (struct rl2_private_data *) data;
 
     if (priv_data == NULL)
-	return;
+	return 0;
 
-    for (i = 0; i < priv_data->raster_cache_items; i++)
-      {
-	  ptr = priv_data->raster_cache + i;
-	  if (ptr->raster == NULL)
-	    {
-		/* found a free Cache slot */
-		index = i;
-		break;
-	    }
-	  if (old_index < 0)
-	    {
-		old_index = i;
-		old_time = ptr->last_used;
-	    }
-	  else
-	    {
-		if (ptr->last_used < old_time)
-		  {
-		      old_time = ptr->last_used;
-		      old_index = i;
-		  }
-	    }
-      }
+    ext_x = rst->maxX - rst->minX;
+    ext_y = rst->maxY - rst->minY;
+    if (ext_x <= 0.0 || ext_y <= 0.0)
+	return 0;
+    grid =
+	do_get_raster_grid (priv_data, db_prefix, coverage, pyramid_level,
+			    ext_x, ext_y);
+    if (grid == NULL)
+	return 0;
+    tile_col = (int) floor (rst->minX / grid->tile_ext_x);
+    tile_row = (int) floor (rst->maxY / grid->tile_ext_y);
 
-    if (index >= 0)
-      {
-	  /* using a free Cache slot */
-      }
-    else
+    ptr = do_find_cached_tile (priv_data, grid, tile_col, tile_row);
+    if (ptr != NULL)
       {
-	  /* freeing and reusing the oldest Cache slot */
-	  index = old_index;
-	  ptr = priv_data->raster_cache + index;
-	  if (ptr->db_prefix != NULL)
-	      free (ptr->db_prefix);
-	  ptr->db_prefix = NULL;
-	  if (ptr->coverage != NULL)
-	      free (ptr->coverage);
+	  /* replacing an already cached Tile */
 	  if (ptr->raster != NULL)
 	      rl2_destroy_raster ((rl2RasterPtr) (ptr->raster));
-	  ptr->raster = NULL;
+	  ptr->raster = rst;
+	  do_touch_cached_raster (priv_data, ptr);
+	  return 1;
       }
 
-    ptr = priv_data->raster_cache + index;
-    if (db_prefix == NULL)
-	ptr->db_prefix = NULL;
-    else
-      {
-	  len = strlen (db_prefix);
-	  ptr->db_prefix = malloc (len + 1);
-	  strcpy (ptr->db_prefix, db_prefix);
-      }
-    len = strlen (coverage);
-    ptr->coverage = malloc (len + 1);
-    strcpy (ptr->coverage, coverage);
-    ptr->pyramid_level = pyramid_level;
-    ptr->raster = (rl2PrivRasterPtr) raster;
-    ptr->last_used = time (NULL);
+    ptr = malloc (sizeof (struct rl2_cached_raster));
+    if (ptr == NULL)
+	return 0;
+    ptr->grid = grid;
+    ptr->tile_col = tile_col;
+    ptr->tile_row = tile_row;
+    ptr->raster = rst;
+    bucket = do_hash_cached_raster (grid, tile_col, tile_row);
+    ptr->hash_next = *(priv_data->raster_cache + bucket);
+    *(priv_data->raster_cache + bucket) = ptr;
+    ptr->prev = NULL;
+    ptr->next = NULL;
+    priv_data->raster_cache_count += 1;
+    do_touch_cached_raster (priv_data, ptr);
+    do_shrink_raster_cache (priv_data);
+    return 1;
+}
+
+RL2_PRIVATE int
+rl2_set_raster_cache_items (const void *data, int items)
+{
+/* changing the capacity of the internal Raster Cache */
+    struct rl2_private_data *priv_data = (struct rl2_private_data *) data;
+    if (priv_data == NULL)
+	return RL2_ERROR;
+    if (items < 1)
+	items = 1;
+    if (items > 65536)
+	items = 65536;
+    priv_data->raster_cache_items = items;
+    do_shrink_raster_cache (priv_data);
+    return RL2_OK;
 }
 
 RL2_PRIVATE int
@@ -311,9 +556,15 @@ rl2_load_cached_raster (sqlite3 * handle, const void *data,
     char *idx_tiles;
     int ret;
     sqlite3_stmt *stmt = NULL;
-    rl2RasterPtr xraster;
+    rl2RasterPtr xraster = NULL;
+    rl2RasterPtr owner = NULL;
+    const char *cache_prefix = db_prefix;
+    int verify = 1;
+    struct rl2_private_data *priv_data = (struct rl2_private_data *) data;
 
     *raster = NULL;
+    if (priv_data != NULL)
+	verify = priv_data->verify_tile_checksums;
 
 /* quarying Coverage Tiles */
     if (db_prefix == NULL)
@@ -340,16 +591,12 @@ rl2_load_cached_raster (sqlite3 * handle, const void *data,
     free (xtiles);
     free (xtile_data);
     sqlite3_free (idx_tiles);
-    ret = sqlite3_prepare_v2 (handle, sql, strlen (sql), &stmt, NULL);
+    stmt =
+	rl2_acquire_cached_stmt (handle, data, cache_prefix, coverage,
+				 RL2_STMT_RASTER_BY_POINT, sql);
     sqlite3_free (sql);
-    if (ret != SQLITE_OK)
-      {
-	  printf ("SELECT raw tile raster SQL error: %s\n",
-		  sqlite3_errmsg (handle));
-	  goto error;
-      }
-    sqlite3_reset (stmt);
-    sqlite3_clear_bindings (stmt);
+    if (stmt == NULL)
+	goto error;
     sqlite3_bind_int (stmt, 1, pyramid_level);
     sqlite3_bind_double (stmt, 2, x);
     sqlite3_bind_double (stmt, 3, y);
@@ -370,6 +617,7 @@ rl2_load_cached_raster (sqlite3 * handle, const void *data,
 		int blob_odd_sz = 0;
 		const unsigned char *blob_even = NULL;
 		int blob_even_sz = 0;
+		rl2PalettePtr plt = NULL;
 		minx = sqlite3_column_double (stmt, 0);
 		miny = sqlite3_column_double (stmt, 1);
 		maxx = sqlite3_column_double (stmt, 2);
@@ -385,31 +633,1613 @@ rl2_load_cached_raster (sqlite3 * handle, const void *data,
 		      blob_even = sqlite3_column_blob (stmt, 6);
 		      blob_even_sz = sqlite3_column_bytes (stmt, 6);
 		  }
-		xraster = rl2_raster_decode (RL2_SCALE_1,
-					     blob_odd,
-					     blob_odd_sz,
-					     blob_even, blob_even_sz, palette);
+		if (palette != NULL)
+		    plt = rl2_clone_palette (palette);
+		xraster = rl2_raster_decode_ex (RL2_SCALE_1,
+						blob_odd,
+						blob_odd_sz,
+						blob_even, blob_even_sz, plt,
+						verify);
 		if (xraster == NULL)
 		    goto error;
 
 		rl2_raster_georeference_frame (xraster, srid, minx, miny, maxx,
 					       maxy);
-		add_raster2cache (data, db_prefix, coverage, pyramid_level,
-				  xraster);
+		if (!add_raster2cache
+		    (data, db_prefix, coverage, pyramid_level, xraster))
+		  {
+		      rl2_destroy_raster (xraster);
+		      goto error;
+		  }
 	    }
 	  else
 	    {
-		fprintf (stderr, "SQL error: %s\n%s\n", sql,
+		fprintf (stderr, "SELECT raw tile raster SQL error: %s\n",
 			 sqlite3_errmsg (handle));
 		goto error;
 	    }
       }
-    sqlite3_finalize (stmt);
+    rl2_release_cached_stmt (data, stmt);
+    /* 
+    / a Point on the edge shared by two Tiles matches both of them:
+    / the one really owning the Point is returned (if still cached)
+    */
+    if (xraster != NULL
+	&& !do_own_raster_point ((rl2PrivRasterPtr) xraster, x, y))
+      {
+	  if (rl2_find_cached_raster
+	      (data, db_prefix, coverage, pyramid_level, x, y,
+	       &owner) == RL2_OK)
+	      xraster = owner;
+      }
     *raster = xraster;
     return RL2_OK;
 
   error:
     if (stmt != NULL)
-	sqlite3_finalize (stmt);
+	rl2_release_cached_stmt (data, stmt);
     return RL2_ERROR;
 }
+
+static void
+do_reset_cached_stmts (struct rl2_private_data *priv_data,
+		       struct rl2_cached_coverage_meta *meta)
+{
+/* discarding all cached Statements of some Coverage */
+    struct rl2_cached_stmt *pT;
+    struct rl2_cached_stmt *pTn;
+    pT = meta->first_stmt;
+    while (pT != NULL)
+      {
+	  pTn = pT->next;
+	  if (pT->busy)
+	    {
+		/* still in use: will be finalized when released */
+		pT->next = priv_data->detached_stmts;
+		priv_data->detached_stmts = pT;
+	    }
+	  else
+	    {
+		sqlite3_finalize (pT->stmt);
+		free (pT);
+	    }
+	  pT = pTn;
+      }
+    meta->first_stmt = NULL;
+}
+
+static void
+do_destroy_tile_grid (struct rl2_tile_grid *grid)
+{
+/* memory cleanup - destroying a Grid Index */
+    int i;
+    if (grid->sections != NULL)
+      {
+	  for (i = 0; i < grid->count; i++)
+	    {
+		struct rl2_tile_grid_section *sect = grid->sections + i;
+		if (sect->cells != NULL)
+		    free (sect->cells);
+	    }
+	  free (grid->sections);
+      }
+    free (grid);
+}
+
+static void
+do_reset_coverage_meta (struct rl2_private_data *priv_data,
+			struct rl2_cached_coverage_meta *meta)
+{
+/* discarding all cached objects of some Coverage */
+    struct rl2_cached_coverage_style *pS;
+    struct rl2_cached_coverage_style *pSn;
+    struct rl2_tile_grid *pG;
+    struct rl2_tile_grid *pGn;
+    int i;
+    do_reset_cached_stmts (priv_data, meta);
+    pG = meta->first_grid;
+    while (pG != NULL)
+      {
+	  pGn = pG->next;
+	  do_destroy_tile_grid (pG);
+	  pG = pGn;
+      }
+    meta->first_grid = NULL;
+    if (meta->levels != NULL)
+	rl2_destroy_resolutions_table (meta->levels);
+    meta->levels = NULL;
+    for (i = 0; i < meta->section_levels_count; i++)
+	rl2_destroy_resolutions_table (meta->section_levels[i]);
+    if (meta->section_levels != NULL)
+	free (meta->section_levels);
+    meta->section_levels = NULL;
+    meta->section_levels_count = 0;
+    meta->section_levels_max = 0;
+    if (meta->coverage != NULL)
+	rl2_destroy_coverage (meta->coverage);
+    meta->coverage = NULL;
+    meta->coverage_loaded = 0;
+    if (meta->palette != NULL)
+	rl2_destroy_palette (meta->palette);
+    meta->palette = NULL;
+    meta->palette_loaded = 0;
+    if (meta->stats != NULL)
+	rl2_destroy_raster_statistics (meta->stats);
+    meta->stats = NULL;
+    meta->stats_loaded = 0;
+    pS = meta->first_style;
+    while (pS != NULL)
+      {
+	  pSn = pS->next;
+	  free (pS->style_name);
+	  if (pS->style != NULL)
+	      rl2_destroy_coverage_style (pS->style);
+	  free (pS);
+	  pS = pSn;
+      }
+    meta->first_style = NULL;
+}
+
+RL2_PRIVATE void
+rl2_flush_metadata_cache (const void *data)
+{
+/* removing all entries from the internal Metadata Cache */
+    struct rl2_cached_coverage_meta *meta;
+    struct rl2_cached_coverage_meta *meta_n;
+    struct rl2_private_data *priv_data = (struct rl2_private_data *) data;
+    if (priv_data == NULL)
+	return;
+    meta = priv_data->first_meta;
+    while (meta != NULL)
+      {
+	  meta_n = meta->next;
+	  do_reset_coverage_meta (priv_data, meta);
+	  if (meta->db_prefix != NULL)
+	      free (meta->db_prefix);
+	  free (meta->coverage_name);
+	  free (meta);
+	  meta = meta_n;
+      }
+    priv_data->first_meta = NULL;
+}
+
+static int
+do_get_data_version (sqlite3 * handle, const char *db_prefix,
+		     unsigned int *version)
+{
+/* retrieving the current DATA_VERSION of some attached DB */
+    int ret;
+    char *sql;
+    char *xdb_prefix;
+    int ok = 0;
+    sqlite3_stmt *stmt = NULL;
+
+    if (db_prefix == NULL)
+	db_prefix = "main";
+#ifdef SQLITE_FCNTL_DATA_VERSION
+    if (sqlite3_file_control
+	(handle, db_prefix, SQLITE_FCNTL_DATA_VERSION, version) == SQLITE_OK)
+	return 1;
+#endif
+    xdb_prefix = rl2_double_quoted_sql (db_prefix);
+    sql = sqlite3_mprintf ("PRAGMA \"%s\".data_version", xdb_prefix);
+    free (xdb_prefix);
+    ret = sqlite3_prepare_v2 (handle, sql, strlen (sql), &stmt, NULL);
+    sqlite3_free (sql);
+    if (ret != SQLITE_OK)
+	return 0;
+    while (1)
+      {
+	  ret = sqlite3_step (stmt);
+	  if (ret == SQLITE_DONE)
+	      break;
+	  if (ret == SQLITE_ROW)
+	    {
+		*version = (unsigned int) sqlite3_column_int64 (stmt, 0);
+		ok = 1;
+	    }
+	  else
+	      break;
+      }
+    sqlite3_finalize (stmt);
+    return ok;
+}
+
+static struct rl2_cached_coverage_meta *
+do_find_coverage_meta (sqlite3 * handle, const void *data,
+		       const char *db_prefix, const char *coverage)
+{
+/* 
+/ retrieving the Metadata Cache entry of some Coverage (creating if needed)
+/ 
+/ any change committed by this connection (TOTAL_CHANGES) or by any 
+/ other connection (DATA_VERSION) invalidates the cached objects
+*/
+    int len;
+    int changes;
+    unsigned int version;
+    struct rl2_cached_coverage_meta *meta;
+    struct rl2_private_data *priv_data = (struct rl2_private_data *) data;
+
+    if (priv_data == NULL || coverage == NULL)
+	return NULL;
+    changes = sqlite3_total_changes (handle);
+    if (changes != priv_data->meta_total_changes)
+      {
+	  rl2_flush_metadata_cache (priv_data);
+	  priv_data->meta_total_changes = changes;
+      }
+    if (!do_get_data_version (handle, db_prefix, &version))
+	return NULL;
+
+    meta = priv_data->first_meta;
+    while (meta != NULL)
+      {
+	  int ok = 0;
+	  if (meta->db_prefix == NULL && db_prefix == NULL)
+	      ok = 1;
+	  else if (meta->db_prefix != NULL && db_prefix != NULL)
+	    {
+		if (strcasecmp (meta->db_prefix, db_prefix) == 0)
+		    ok = 1;
+	    }
+	  if (ok && strcasecmp (meta->coverage_name, coverage) == 0)
+	    {
+		if (meta->data_version != version)
+		  {
+		      /* changed by some other connection */
+		      do_reset_coverage_meta (priv_data, meta);
+		      meta->data_version = version;
+		  }
+		return meta;
+	    }
+	  meta = meta->next;
+      }
+
+    meta = malloc (sizeof (struct rl2_cached_coverage_meta));
+    if (meta == NULL)
+	return NULL;
+    if (db_prefix == NULL)
+	meta->db_prefix = NULL;
+    else
+      {
+	  len = strlen (db_prefix);
+	  meta->db_prefix = malloc (len + 1);
+	  strcpy (meta->db_prefix, db_prefix);
+      }
+    len = strlen (coverage);
+    meta->coverage_name = malloc (len + 1);
+    strcpy (meta->coverage_name, coverage);
+    meta->data_version = version;
+    meta->coverage_loaded = 0;
+    meta->coverage = NULL;
+    meta->palette_loaded = 0;
+    meta->palette = NULL;
+    meta->stats_loaded = 0;
+    meta->stats = NULL;
+    meta->first_style = NULL;
+    meta->first_stmt = NULL;
+    meta->levels = NULL;
+    meta->section_levels = NULL;
+    meta->section_levels_count = 0;
+    meta->section_levels_max = 0;
+    meta->first_grid = NULL;
+    meta->next = priv_data->first_meta;
+    priv_data->first_meta = meta;
+    return meta;
+}
+
+RL2_PRIVATE rl2CoveragePtr
+rl2_get_cached_coverage (sqlite3 * handle, const void *data,
+			 const char *db_prefix, const char *coverage)
+{
+/* returning a copy of the (cached) Coverage definitions */
+    struct rl2_cached_coverage_meta *meta =
+	do_find_coverage_meta (handle, data, db_prefix, coverage);
+    if (meta == NULL)
+	return rl2_create_coverage_from_dbms (handle, db_prefix, coverage);
+    if (!meta->coverage_loaded)
+      {
+	  meta->coverage =
+	      rl2_create_coverage_from_dbms (handle, db_prefix, coverage);
+	  meta->coverage_loaded = 1;
+      }
+    return rl2_clone_coverage (meta->coverage);
+}
+
+RL2_PRIVATE rl2PalettePtr
+rl2_get_cached_palette (sqlite3 * handle, const void *data,
+			const char *db_prefix, const char *coverage)
+{
+/* returning a copy of the (cached) Coverage's Palette */
+    struct rl2_cached_coverage_meta *meta =
+	do_find_coverage_meta (handle, data, db_prefix, coverage);
+    if (meta == NULL)
+	return rl2_get_dbms_palette (handle, db_prefix, coverage);
+    if (!meta->palette_loaded)
+      {
+	  meta->palette = rl2_get_dbms_palette (handle, db_prefix, coverage);
+	  meta->palette_loaded = 1;
+      }
+    return rl2_clone_palette (meta->palette);
+}
+
+RL2_PRIVATE rl2RasterStatisticsPtr
+rl2_get_cached_raster_statistics (sqlite3 * handle, const void *data,
+				  const char *db_prefix, const char *coverage)
+{
+/* returning a copy of the (cached) Coverage's Raster Statistics */
+    struct rl2_cached_coverage_meta *meta =
+	do_find_coverage_meta (handle, data, db_prefix, coverage);
+    if (meta == NULL)
+	return rl2_create_raster_statistics_from_dbms (handle, db_prefix,
+						       coverage);
+    if (!meta->stats_loaded)
+      {
+	  meta->stats =
+	      rl2_create_raster_statistics_from_dbms (handle, db_prefix,
+						      coverage);
+	  meta->stats_loaded = 1;
+      }
+    return rl2_clone_raster_statistics (meta->stats);
+}
+
+static rl2CoverageStylePtr
+do_clone_cached_style (sqlite3 * handle, const char *db_prefix,
+		       const char *coverage,
+		       struct rl2_cached_coverage_style *stl)
+{
+/* returning a copy of a cached Coverage Style */
+    rl2CoverageStylePtr style;
+    if (stl->style == NULL)
+	return NULL;
+    style = rl2_clone_coverage_style (stl->style);
+    if (style == NULL)
+      {
+	  /* not clonable: parsing the XML yet again */
+	  style =
+	      rl2_create_coverage_style_from_dbms (handle, db_prefix,
+						   coverage, stl->style_name);
+      }
+    return style;
+}
+
+RL2_PRIVATE rl2CoverageStylePtr
+rl2_get_cached_coverage_style (sqlite3 * handle, const void *data,
+			       const char *db_prefix, const char *coverage,
+			       const char *style)
+{
+/* returning a copy of the (cached and already parsed) Coverage Style */
+    int len;
+    struct rl2_cached_coverage_style *stl;
+    struct rl2_cached_coverage_meta *meta =
+	do_find_coverage_meta (handle, data, db_prefix, coverage);
+    if (meta == NULL || style == NULL)
+	return rl2_create_coverage_style_from_dbms (handle, db_prefix,
+						    coverage, style);
+    stl = meta->first_style;
+    while (stl != NULL)
+      {
+	  if (strcasecmp (stl->style_name, style) == 0)
+	      return do_clone_cached_style (handle, db_prefix, coverage,
+					    stl);
+	  stl = stl->next;
+      }
+
+    stl = malloc (sizeof (struct rl2_cached_coverage_style));
+    if (stl == NULL)
+	return rl2_create_coverage_style_from_dbms (handle, db_prefix,
+						    coverage, style);
+    len = strlen (style);
+    stl->style_name = malloc (len + 1);
+    strcpy (stl->style_name, style);
+    stl->style =
+	rl2_create_coverage_style_from_dbms (handle, db_prefix, coverage,
+					     style);
+    stl->next = meta->first_style;
+    meta->first_style = stl;
+    return do_clone_cached_style (handle, db_prefix, coverage, stl);
+}
+
+RL2_PRIVATE sqlite3_stmt *
+rl2_acquire_cached_stmt (sqlite3 * handle, const void *data,
+			 const char *db_prefix, const char *coverage,
+			 int kind, const char *sql)
+{
+/* 
+/ returning a ready-to-use prepared Statement (reset and without bindings)
+/ to be given back by calling rl2_release_cached_stmt()
+*/
+    int ret;
+    sqlite3_stmt *stmt = NULL;
+    struct rl2_cached_stmt *pT;
+    struct rl2_cached_coverage_meta *meta = NULL;
+    struct rl2_private_data *priv_data = (struct rl2_private_data *) data;
+
+    if (priv_data != NULL && priv_data->stmt_cache_enabled)
+	meta = do_find_coverage_meta (handle, data, db_prefix, coverage);
+    if (meta != NULL)
+      {
+	  pT = meta->first_stmt;
+	  while (pT != NULL)
+	    {
+		if (pT->kind == kind && !(pT->busy))
+		  {
+		      /* reusing an already prepared Statement */
+		      pT->busy = 1;
+		      return pT->stmt;
+		  }
+		if (pT->kind == kind)
+		    meta = NULL;	/* busy: using a transient Statement */
+		pT = pT->next;
+	    }
+      }
+
+    ret = sqlite3_prepare_v2 (handle, sql, strlen (sql), &stmt, NULL);
+    if (ret != SQLITE_OK)
+      {
+	  fprintf (stderr, "SQL error: %s\n%s\n", sql, sqlite3_errmsg (handle));
+	  return NULL;
+      }
+    if (meta != NULL)
+      {
+	  pT = malloc (sizeof (struct rl2_cached_stmt));
+	  if (pT != NULL)
+	    {
+		pT->kind = kind;
+		pT->busy = 1;
+		pT->stmt = stmt;
+		pT->next = meta->first_stmt;
+		meta->first_stmt = pT;
+	    }
+      }
+    return stmt;
+}
+
+RL2_PRIVATE void
+rl2_release_cached_stmt (const void *data, sqlite3_stmt * stmt)
+{
+/* giving back a Statement obtained by rl2_acquire_cached_stmt() */
+    struct rl2_cached_stmt *pT;
+    struct rl2_cached_stmt *prev;
+    struct rl2_cached_coverage_meta *meta;
+    struct rl2_private_data *priv_data = (struct rl2_private_data *) data;
+
+    if (stmt == NULL)
+	return;
+    if (priv_data != NULL)
+      {
+	  meta = priv_data->first_meta;
+	  while (meta != NULL)
+	    {
+		pT = meta->first_stmt;
+		while (pT != NULL)
+		  {
+		      if (pT->stmt == stmt)
+			{
+			    /* keeping the Statement for later reuse */
+			    sqlite3_reset (stmt);
+			    sqlite3_clear_bindings (stmt);
+			    pT->busy = 0;
+			    return;
+			}
+		      pT = pT->next;
+		  }
+		meta = meta->next;
+	    }
+	  prev = NULL;
+	  pT = priv_data->detached_stmts;
+	  while (pT != NULL)
+	    {
+		if (pT->stmt == stmt)
+		  {
+		      /* a stale Statement invalidated while in use */
+		      if (prev == NULL)
+			  priv_data->detached_stmts = pT->next;
+		      else
+			  prev->next = pT->next;
+		      free (pT);
+		      break;
+		  }
+		prev = pT;
+		pT = pT->next;
+	    }
+      }
+    sqlite3_finalize (stmt);
+}
+
+RL2_PRIVATE void
+rl2_enable_stmt_cache (const void *data, int enabled)
+{
+/* enabling or disabling the prepared Statements Cache */
+    struct rl2_cached_coverage_meta *meta;
+    struct rl2_private_data *priv_data = (struct rl2_private_data *) data;
+    if (priv_data == NULL)
+	return;
+    priv_data->stmt_cache_enabled = enabled ? 1 : 0;
+    if (!enabled)
+      {
+	  /* finalizing all cached Statements */
+	  meta = priv_data->first_meta;
+	  while (meta != NULL)
+	    {
+		do_reset_cached_stmts (priv_data, meta);
+		meta = meta->next;
+	    }
+      }
+}
+
+static int
+do_search_section_levels (struct rl2_cached_coverage_meta *meta,
+			  sqlite3_int64 section_id, int *pos)
+{
+/* binary search of some Section into the sorted array */
+    int lo = 0;
+    int hi = meta->section_levels_count;
+    int mid;
+    sqlite3_int64 id;
+    while (lo < hi)
+      {
+	  mid = lo + ((hi - lo) / 2);
+	  id = meta->section_levels[mid]->section_id;
+	  if (id == section_id)
+	    {
+		*pos = mid;
+		return 1;
+	    }
+	  if (id < section_id)
+	      lo = mid + 1;
+	  else
+	      hi = mid;
+      }
+    *pos = lo;
+    return 0;
+}
+
+RL2_PRIVATE struct rl2_resolutions_table *
+rl2_get_cached_resolutions (sqlite3 * handle, const void *data,
+			    const char *db_prefix, const char *coverage,
+			    int by_section, sqlite3_int64 section_id)
+{
+/* 
+/ retrieving the Resolutions Table of some Coverage (or Section)
+/ 
+/ the returned Table is still owned by the Metadata Cache, and will be
+/ destroyed by Pyramidize, DePyramidize and LoadRaster (as any other
+/ change to the DB); it must not be used after any further SQL statement
+*/
+    int pos;
+    struct rl2_resolutions_table *table;
+    struct rl2_resolutions_table **new_levels;
+    struct rl2_cached_coverage_meta *meta =
+	do_find_coverage_meta (handle, data, db_prefix, coverage);
+    if (meta == NULL)
+	return NULL;
+
+    if (!by_section)
+      {
+	  if (meta->levels == NULL)
+	      meta->levels =
+		  rl2_load_resolutions_table (handle, db_prefix, coverage, 0,
+					      0);
+	  return meta->levels;
+      }
+
+    if (do_search_section_levels (meta, section_id, &pos))
+	return meta->section_levels[pos];
+    table =
+	rl2_load_resolutions_table (handle, db_prefix, coverage, 1,
+				    section_id);
+    if (table == NULL)
+	return NULL;
+    if (meta->section_levels_count == meta->section_levels_max)
+      {
+	  /* expanding the sorted array */
+	  int max =
+	      (meta->section_levels_max ==
+	       0) ? 64 : meta->section_levels_max * 2;
+	  new_levels =
+	      realloc (meta->section_levels,
+		       sizeof (struct rl2_resolutions_table *) * max);
+	  if (new_levels == NULL)
+	    {
+		rl2_destroy_resolutions_table (table);
+		return NULL;
+	    }
+	  meta->section_levels = new_levels;
+	  meta->section_levels_max = max;
+      }
+    if (pos < meta->section_levels_count)
+	memmove (meta->section_levels + pos + 1, meta->section_levels + pos,
+		 sizeof (struct rl2_resolutions_table *) *
+		 (meta->section_levels_count - pos));
+    meta->section_levels[pos] = table;
+    meta->section_levels_count += 1;
+    return table;
+}
+
+struct grid_tile_row
+{
+/* helper struct for building a Grid Index */
+    sqlite3_int64 tile_id;
+    sqlite3_int64 section_id;
+    double minx;
+    double miny;
+    double maxx;
+    double maxy;
+};
+
+static int
+do_grid_position (double offset, double ext, int *pos)
+{
+/* checking if some Tile corner is aligned on the Grid */
+    double fpos = offset / ext;
+    double rpos = floor (fpos + 0.5);
+    if (rpos < 0.0 || rpos > 1000000000.0)
+	return 0;
+    if (fabs (fpos - rpos) > 0.000001)
+	return 0;
+    *pos = (int) rpos;
+    return 1;
+}
+
+static int
+do_build_grid_section (struct rl2_tile_grid_section *sect,
+		       struct grid_tile_row *rows, int count)
+{
+/* building the Grid Index of a single Section */
+    int i;
+    int col;
+    int row;
+    int max_col = 0;
+    int max_row = 0;
+    struct grid_tile_row *tile;
+    struct rl2_tile_grid_cell *cell;
+
+    sect->section_id = rows->section_id;
+    sect->origin_x = rows->minx;
+    sect->origin_y = rows->maxy;
+    sect->ext_x = 0.0;
+    sect->ext_y = 0.0;
+    sect->minx = rows->minx;
+    sect->miny = rows->miny;
+    sect->maxx = rows->maxx;
+    sect->maxy = rows->maxy;
+    sect->cols = 0;
+    sect->rows = 0;
+    sect->cells = NULL;
+    for (i = 0; i < count; i++)
+      {
+	  /* edge Tiles are clipped, so the largest extent is the true one */
+	  tile = rows + i;
+	  if (tile->minx < sect->minx)
+	      sect->minx = tile->minx;
+	  if (tile->miny < sect->miny)
+	      sect->miny = tile->miny;
+	  if (tile->maxx > sect->maxx)
+	      sect->maxx = tile->maxx;
+	  if (tile->maxy > sect->maxy)
+	      sect->maxy = tile->maxy;
+	  if (tile->maxx - tile->minx > sect->ext_x)
+	      sect->ext_x = tile->maxx - tile->minx;
+	  if (tile->maxy - tile->miny > sect->ext_y)
+	      sect->ext_y = tile->maxy - tile->miny;
+      }
+    sect->origin_x = sect->minx;
+    sect->origin_y = sect->maxy;
+    if (sect->ext_x <= 0.0 || sect->ext_y <= 0.0)
+	return 0;
+
+    for (i = 0; i < count; i++)
+      {
+	  tile = rows + i;
+	  if (!do_grid_position (tile->minx - sect->origin_x, sect->ext_x, &col))
+	      return 0;
+	  if (!do_grid_position (sect->origin_y - tile->maxy, sect->ext_y, &row))
+	      return 0;
+	  if (col > max_col)
+	      max_col = col;
+	  if (row > max_row)
+	      max_row = row;
+      }
+    sect->cols = max_col + 1;
+    sect->rows = max_row + 1;
+    if ((double) (sect->cols) * (double) (sect->rows) >
+	(4.0 * (double) count) + 64.0)
+	return 0;		/* too sparse */
+
+    sect->cells =
+	malloc (sizeof (struct rl2_tile_grid_cell) * sect->cols * sect->rows);
+    if (sect->cells == NULL)
+	return 0;
+    for (i = 0; i < sect->cols * sect->rows; i++)
+	(sect->cells + i)->tile_id = -1;
+    for (i = 0; i < count; i++)
+      {
+	  tile = rows + i;
+	  do_grid_position (tile->minx - sect->origin_x, sect->ext_x, &col);
+	  do_grid_position (sect->origin_y - tile->maxy, sect->ext_y, &row);
+	  cell = sect->cells + (row * sect->cols) + col;
+	  if (cell->tile_id >= 0)
+	      return 0;		/* overlapping Tiles */
+	  cell->tile_id = tile->tile_id;
+	  cell->minx = tile->minx;
+	  cell->maxy = tile->maxy;
+      }
+    return 1;
+}
+
+static struct rl2_tile_grid *
+do_build_tile_grid (sqlite3 * handle, const char *db_prefix,
+		    const char *coverage, int level)
+{
+/* 
+/ building the Grid Index of some Pyramid Level
+/ 
+/ the returned Grid is marked as unusable if the Tiles aren't laid out
+/ on a regular grid (one for each Section)
+*/
+    int ret;
+    char *sql;
+    char *xdb_prefix;
+    char *table;
+    char *xtable;
+    sqlite3_stmt *stmt = NULL;
+    struct grid_tile_row *rows = NULL;
+    struct grid_tile_row *new_rows;
+    int count = 0;
+    int max = 0;
+    int i;
+    int base;
+    int num_sections;
+    struct rl2_tile_grid *grid;
+
+    grid = malloc (sizeof (struct rl2_tile_grid));
+    if (grid == NULL)
+	return NULL;
+    grid->level = level;
+    grid->usable = 0;
+    grid->count = 0;
+    grid->sections = NULL;
+    grid->next = NULL;
+
+    if (db_prefix == NULL)
+	db_prefix = "main";
+    xdb_prefix = rl2_double_quoted_sql (db_prefix);
+    table = sqlite3_mprintf ("%s_tiles", coverage);
+    xtable = rl2_double_quoted_sql (table);
+    sqlite3_free (table);
+    sql =
+	sqlite3_mprintf
+	("SELECT tile_id, section_id, MbrMinX(geometry), MbrMinY(geometry), "
+	 "MbrMaxX(geometry), MbrMaxY(geometry) FROM \"%s\".\"%s\" "
+	 "WHERE pyramid_level = ? ORDER BY section_id", xdb_prefix, xtable);
+    free (xdb_prefix);
+    free (xtable);
+    ret = sqlite3_prepare_v2 (handle, sql, strlen (sql), &stmt, NULL);
+    sqlite3_free (sql);
+    if (ret != SQLITE_OK)
+	goto done;
+    sqlite3_bind_int (stmt, 1, level);
+    while (1)
+      {
+	  /* scrolling the result set rows */
+	  ret = sqlite3_step (stmt);
+	  if (ret == SQLITE_DONE)
+	      break;		/* end of result set */
+	  if (ret != SQLITE_ROW)
+	      goto done;
+	  if (count == max)
+	    {
+		max = (max == 0) ? 1024 : max * 2;
+		new_rows = realloc (rows, sizeof (struct grid_tile_row) * max);
+		if (new_rows == NULL)
+		    goto done;
+		rows = new_rows;
+	    }
+	  (rows + count)->tile_id = sqlite3_column_int64 (stmt, 0);
+	  (rows + count)->section_id = sqlite3_column_int64 (stmt, 1);
+	  (rows + count)->minx = sqlite3_column_double (stmt, 2);
+	  (rows + count)->miny = sqlite3_column_double (stmt, 3);
+	  (rows + count)->maxx = sqlite3_column_double (stmt, 4);
+	  (rows + count)->maxy = sqlite3_column_double (stmt, 5);
+	  count++;
+      }
+    sqlite3_finalize (stmt);
+    stmt = NULL;
+
+/* counting how many Sections are there */
+    num_sections = 0;
+    for (i = 0; i < count; i++)
+      {
+	  if (i == 0 || (rows + i)->section_id != (rows + i - 1)->section_id)
+	      num_sections++;
+      }
+    if (num_sections > 0)
+      {
+	  grid->sections =
+	      malloc (sizeof (struct rl2_tile_grid_section) * num_sections);
+	  if (grid->sections == NULL)
+	      goto done;
+      }
+
+/* building a Grid for each Section */
+    base = 0;
+    for (i = 1; i <= count; i++)
+      {
+	  if (i == count || (rows + i)->section_id != (rows + base)->section_id)
+	    {
+		struct rl2_tile_grid_section *sect =
+		    grid->sections + grid->count;
+		grid->count += 1;
+		if (!do_build_grid_section (sect, rows + base, i - base))
+		    goto done;
+		base = i;
+	    }
+      }
+    grid->usable = 1;
+
+  done:
+    if (stmt != NULL)
+	sqlite3_finalize (stmt);
+    if (rows != NULL)
+	free (rows);
+    if (!grid->usable && grid->sections != NULL)
+      {
+	  /* discarding an unusable Grid */
+	  for (i = 0; i < grid->count; i++)
+	    {
+		struct rl2_tile_grid_section *sect = grid->sections + i;
+		if (sect->cells != NULL)
+		    free (sect->cells);
+	    }
+	  free (grid->sections);
+	  grid->sections = NULL;
+	  grid->count = 0;
+      }
+    return grid;
+}
+
+static int
+do_add_grid_tile_ref (rl2GridTileRefsPtr refs, struct rl2_tile_grid_cell *cell)
+{
+/* appending a Tile to the list of the Tiles to be loaded */
+    rl2GridTileRefPtr new_items;
+    rl2GridTileRefPtr ref;
+    if (refs->count == refs->max)
+      {
+	  int max = (refs->max == 0) ? 64 : refs->max * 2;
+	  new_items = realloc (refs->items, sizeof (rl2GridTileRef) * max);
+	  if (new_items == NULL)
+	      return 0;
+	  refs->items = new_items;
+	  refs->max = max;
+      }
+    ref = refs->items + refs->count;
+    ref->tile_id = cell->tile_id;
+    ref->minx = cell->minx;
+    ref->maxy = cell->maxy;
+    refs->count += 1;
+    return 1;
+}
+
+static int
+do_clamp_grid_range (double lo, double hi, int limit, int *first, int *last)
+{
+/* clamping a range of Tile rows or columns */
+    double flo = floor (lo - 0.000000001);
+    double fhi = floor (hi + 0.000000001);
+    if (fhi < 0.0 || flo > (double) (limit - 1))
+	return 0;
+    *first = (flo < 0.0) ? 0 : (int) flo;
+    *last = (fhi > (double) (limit - 1)) ? limit - 1 : (int) fhi;
+    return 1;
+}
+
+static int
+do_search_grid_section (sqlite3_int64 section_id, struct rl2_tile_grid *grid)
+{
+/* binary search of some Section into the Grid (sorted by section_id) */
+    int lo = 0;
+    int hi = grid->count;
+    int mid;
+    sqlite3_int64 id;
+    while (lo < hi)
+      {
+	  mid = lo + ((hi - lo) / 2);
+	  id = (grid->sections + mid)->section_id;
+	  if (id == section_id)
+	      return mid;
+	  if (id < section_id)
+	      lo = mid + 1;
+	  else
+	      hi = mid;
+      }
+    return -1;
+}
+
+static int
+do_collect_grid_tiles (struct rl2_tile_grid_section *sect, double minx,
+		       double miny, double maxx, double maxy,
+		       rl2GridTileRefsPtr refs)
+{
+/* collecting all Tiles of some Section intersecting the given BBOX */
+    int col;
+    int row;
+    int col0;
+    int col1;
+    int row0;
+    int row1;
+    struct rl2_tile_grid_cell *cell;
+
+/* clipping the BBOX to the Section extent (edge Tiles are clipped too) */
+    if (minx < sect->minx)
+	minx = sect->minx;
+    if (maxx > sect->maxx)
+	maxx = sect->maxx;
+    if (miny < sect->miny)
+	miny = sect->miny;
+    if (maxy > sect->maxy)
+	maxy = sect->maxy;
+    if (minx > maxx || miny > maxy)
+	return 1;
+
+    if (!do_clamp_grid_range
+	((minx - sect->origin_x) / sect->ext_x,
+	 (maxx - sect->origin_x) / sect->ext_x, sect->cols, &col0, &col1))
+	return 1;
+    if (!do_clamp_grid_range
+	((sect->origin_y - maxy) / sect->ext_y,
+	 (sect->origin_y - miny) / sect->ext_y, sect->rows, &row0, &row1))
+	return 1;
+    for (row = row0; row <= row1; row++)
+      {
+	  for (col = col0; col <= col1; col++)
+	    {
+		cell = sect->cells + (row * sect->cols) + col;
+		if (cell->tile_id < 0)
+		    continue;
+		if (!do_add_grid_tile_ref (refs, cell))
+		    return 0;
+	    }
+      }
+    return 1;
+}
+
+RL2_PRIVATE void
+rl2_destroy_grid_tile_refs (rl2GridTileRefsPtr refs)
+{
+/* memory cleanup - destroying a list of Tiles to be loaded */
+    if (refs == NULL)
+	return;
+    if (refs->items != NULL)
+	free (refs->items);
+    free (refs);
+}
+
+RL2_PRIVATE rl2GridTileRefsPtr
+rl2_get_grid_tile_refs (sqlite3 * handle, const void *data,
+			const char *db_prefix, const char *coverage,
+			int by_section, sqlite3_int64 section_id, int level,
+			double minx, double miny, double maxx, double maxy)
+{
+/* 
+/ resolving all Tiles intersecting the given BBOX by using the Grid Index
+/ 
+/ returns NULL if the Grid Index is disabled or can't be used; in this
+/ case the SpatialIndex must be queried as usual
+*/
+    int i;
+    struct rl2_tile_grid *grid;
+    struct rl2_cached_coverage_meta *meta;
+    rl2GridTileRefsPtr refs;
+    struct rl2_private_data *priv_data = (struct rl2_private_data *) data;
+
+    if (priv_data == NULL || coverage == NULL)
+	return NULL;
+    if (!(priv_data->tile_grid_enabled))
+	return NULL;
+    meta = do_find_coverage_meta (handle, data, db_prefix, coverage);
+    if (meta == NULL)
+	return NULL;
+    if (!meta->coverage_loaded)
+      {
+	  meta->coverage =
+	      rl2_create_coverage_from_dbms (handle, db_prefix, coverage);
+	  meta->coverage_loaded = 1;
+      }
+    if (meta->coverage == NULL)
+	return NULL;
+    if (((rl2PrivCoveragePtr) (meta->coverage))->mixedResolutions)
+      {
+	  /* Mixed Resolutions: always querying the SpatialIndex */
+	  return NULL;
+      }
+
+    grid = meta->first_grid;
+    while (grid != NULL)
+      {
+	  if (grid->level == level)
+	      break;
+	  grid = grid->next;
+      }
+    if (grid == NULL)
+      {
+	  /* building the Grid Index of this Pyramid Level */
+	  grid = do_build_tile_grid (handle, db_prefix, coverage, level);
+	  if (grid == NULL)
+	      return NULL;
+	  grid->next = meta->first_grid;
+	  meta->first_grid = grid;
+      }
+    if (!(grid->usable))
+	return NULL;
+
+    refs = malloc (sizeof (rl2GridTileRefs));
+    if (refs == NULL)
+	return NULL;
+    refs->count = 0;
+    refs->max = 0;
+    refs->next = 0;
+    refs->items = NULL;
+    if (by_section)
+      {
+	  /* only from a single Section */
+	  i = do_search_grid_section (section_id, grid);
+	  if (i >= 0)
+	    {
+		if (!do_collect_grid_tiles
+		    (grid->sections + i, minx, miny, maxx, maxy, refs))
+		    goto error;
+	    }
+      }
+    else
+      {
+	  /* whole Coverage */
+	  for (i = 0; i < grid->count; i++)
+	    {
+		if (!do_collect_grid_tiles
+		    (grid->sections + i, minx, miny, maxx, maxy, refs))
+		    goto error;
+	    }
+      }
+    return refs;
+
+  error:
+    rl2_destroy_grid_tile_refs (refs);
+    return NULL;
+}
+
+RL2_PRIVATE void
+rl2_enable_tile_grid (const void *data, int enabled)
+{
+/* enabling or disabling the Grid Index */
+    struct rl2_cached_coverage_meta *meta;
+    struct rl2_tile_grid *pG;
+    struct rl2_tile_grid *pGn;
+    struct rl2_private_data *priv_data = (struct rl2_private_data *) data;
+    if (priv_data == NULL)
+	return;
+    priv_data->tile_grid_enabled = enabled ? 1 : 0;
+    if (!enabled)
+      {
+	  /* releasing all Grid Indices */
+	  meta = priv_data->first_meta;
+	  while (meta != NULL)
+	    {
+		pG = meta->first_grid;
+		while (pG != NULL)
+		  {
+		      pGn = pG->next;
+		      do_destroy_tile_grid (pG);
+		      pG = pGn;
+		  }
+		meta->first_grid = NULL;
+		meta = meta->next;
+	    }
+      }
+}
+
+static void
+do_destroy_tile_readers (struct rl2_tile_readers *readers)
+{
+/* memory cleanup - closing all read-only connections to some DB file */
+    int i;
+    struct rl2_tile_reader *reader;
+    if (readers->items != NULL)
+      {
+	  for (i = 0; i < readers->count; i++)
+	    {
+		reader = readers->items + i;
+		rl2_release_tile_reader (reader);
+		if (reader->stmt != NULL)
+		    sqlite3_finalize (reader->stmt);
+		if (reader->buf_odd != NULL)
+		    free (reader->buf_odd);
+		if (reader->buf_even != NULL)
+		    free (reader->buf_even);
+		if (reader->coverage != NULL)
+		    free (reader->coverage);
+		if (reader->handle != NULL)
+		    sqlite3_close (reader->handle);
+	    }
+	  free (readers->items);
+      }
+    if (readers->db_path != NULL)
+	free (readers->db_path);
+    free (readers);
+}
+
+static int
+do_grow_tile_readers (struct rl2_tile_readers *readers, int count)
+{
+/* opening further read-only connections */
+    int i;
+    int ret;
+    struct rl2_tile_reader *items;
+    struct rl2_tile_reader *reader;
+    if (count <= readers->count)
+	return 1;
+    items = realloc (readers->items, sizeof (struct rl2_tile_reader) * count);
+    if (items == NULL)
+	return 0;
+    readers->items = items;
+    for (i = readers->count; i < count; i++)
+      {
+	  reader = readers->items + i;
+	  reader->handle = NULL;
+	  reader->coverage = NULL;
+	  reader->even = 0;
+	  reader->split = 0;
+	  reader->stmt = NULL;
+	  reader->blob_odd = NULL;
+	  reader->blob_even = NULL;
+	  reader->buf_odd = NULL;
+	  reader->buf_odd_max = 0;
+	  reader->buf_even = NULL;
+	  reader->buf_even_max = 0;
+	  ret =
+	      sqlite3_open_v2 (readers->db_path, &(reader->handle),
+			       SQLITE_OPEN_READONLY | SQLITE_OPEN_NOMUTEX,
+			       NULL);
+	  if (ret != SQLITE_OK)
+	    {
+		fprintf (stderr, "cannot open a read-only connection: %s\n",
+			 sqlite3_errmsg (reader->handle));
+		sqlite3_close (reader->handle);
+		return 0;
+	    }
+	  sqlite3_busy_timeout (reader->handle, 5000);
+	  readers->count += 1;
+      }
+    return 1;
+}
+
+RL2_PRIVATE struct rl2_tile_readers *
+rl2_get_tile_readers (sqlite3 * handle, const void *data,
+		      const char *db_prefix, int count)
+{
+/* 
+/ returning (at least) "count" read-only connections to the DB file
+/ the Tiles will be read from
+/ 
+/ returns NULL if the Tile Readers are disabled, if the DB isn't file
+/ based or if the connection has uncommitted changes (that would be
+/ invisible to any other connection)
+*/
+    const char *path;
+    int len;
+    struct rl2_tile_readers *readers;
+    struct rl2_private_data *priv_data = (struct rl2_private_data *) data;
+
+    if (priv_data == NULL)
+	return NULL;
+    if (!(priv_data->tile_readers_enabled))
+	return NULL;
+    if (!sqlite3_get_autocommit (handle))
+	return NULL;
+    if (db_prefix == NULL)
+	db_prefix = "main";
+    path = sqlite3_db_filename (handle, db_prefix);
+    if (path == NULL)
+	return NULL;
+    if (*path == '\0')
+	return NULL;
+
+    readers = priv_data->first_tile_readers;
+    while (readers != NULL)
+      {
+	  if (strcmp (readers->db_path, path) == 0)
+	      break;
+	  readers = readers->next;
+      }
+    if (readers == NULL)
+      {
+	  readers = malloc (sizeof (struct rl2_tile_readers));
+	  if (readers == NULL)
+	      return NULL;
+	  len = strlen (path);
+	  readers->db_path = malloc (len + 1);
+	  if (readers->db_path == NULL)
+	    {
+		free (readers);
+		return NULL;
+	    }
+	  strcpy (readers->db_path, path);
+	  readers->count = 0;
+	  readers->items = NULL;
+	  readers->next = priv_data->first_tile_readers;
+	  priv_data->first_tile_readers = readers;
+      }
+    if (!do_grow_tile_readers (readers, count))
+	return NULL;
+    return readers;
+}
+
+RL2_PRIVATE int
+rl2_grow_blob_buffer (unsigned char **buffer, int *max, int size)
+{
+/* 
+/ ensuring that a reusable BLOB buffer can hold at least "size" bytes
+/ (some spare room is allocated, so to rarely grow it again)
+*/
+    unsigned char *buf;
+    int new_max;
+    if (*buffer != NULL && *max >= size)
+	return 1;
+    new_max = size + (size / 4);
+    if (new_max < 4096)
+	new_max = 4096;
+    buf = realloc (*buffer, new_max);
+    if (buf == NULL)
+	return 0;
+    *buffer = buf;
+    *max = new_max;
+    return 1;
+}
+
+RL2_PRIVATE int
+rl2_read_incremental_blob (sqlite3 * handle, const char *db_prefix,
+			   const char *coverage, const char *table,
+			   const char *column, sqlite3_int64 tile_id,
+			   sqlite3_blob ** blob, unsigned char **buffer,
+			   int *max, int *blob_sz)
+{
+/* 
+/ reading a Tile BLOB by using the incremental BLOB I/O API
+/ the BLOB handle is kept open and simply moved from a row to the
+/ next one, so to avoid compiling a new statement for each Tile
+/ 
+/ returns 0 if the row doesn't exists or the value isn't a BLOB
+*/
+    int ret;
+    int sz;
+    char *name;
+    *blob_sz = 0;
+    if (*blob != NULL)
+      {
+	  ret = sqlite3_blob_reopen (*blob, tile_id);
+	  if (ret != SQLITE_OK)
+	    {
+		/* an aborted handle can't be moved any longer */
+		sqlite3_blob_close (*blob);
+		*blob = NULL;
+	    }
+      }
+    else
+      {
+	  if (db_prefix == NULL)
+	      db_prefix = "main";
+	  name = sqlite3_mprintf ("%s_%s", coverage, table);
+	  ret =
+	      sqlite3_blob_open (handle, db_prefix, name, column, tile_id, 0,
+				 blob);
+	  sqlite3_free (name);
+	  if (ret != SQLITE_OK)
+	    {
+		if (*blob != NULL)
+		    sqlite3_blob_close (*blob);
+		*blob = NULL;
+	    }
+      }
+    if (ret != SQLITE_OK)
+	return 0;
+    sz = sqlite3_blob_bytes (*blob);
+    if (!rl2_grow_blob_buffer (buffer, max, sz))
+	return 0;
+    if (sqlite3_blob_read (*blob, *buffer, sz, 0) != SQLITE_OK)
+	return 0;
+    *blob_sz = sz;
+    return 1;
+}
+
+static int
+do_read_tile_stmt (struct rl2_tile_reader *reader, sqlite3_int64 tile_id,
+		   int even, unsigned char **blob_odd, int *blob_odd_sz,
+		   unsigned char **blob_even, int *blob_even_sz)
+{
+/* reading the BLOBs of some Tile by using the SELECT statement */
+    int ret;
+    const void *blob;
+    int blob_sz;
+    sqlite3_reset (reader->stmt);
+    sqlite3_clear_bindings (reader->stmt);
+    sqlite3_bind_int64 (reader->stmt, 1, tile_id);
+    ret = sqlite3_step (reader->stmt);
+    if (ret == SQLITE_DONE)
+      {
+	  sqlite3_reset (reader->stmt);
+	  return RL2_OK;
+      }
+    if (ret != SQLITE_ROW)
+      {
+	  sqlite3_reset (reader->stmt);
+	  return RL2_ERROR;
+      }
+    if (sqlite3_column_type (reader->stmt, 0) == SQLITE_BLOB)
+      {
+	  blob = sqlite3_column_blob (reader->stmt, 0);
+	  blob_sz = sqlite3_column_bytes (reader->stmt, 0);
+	  if (!rl2_grow_blob_buffer
+	      (&(reader->buf_odd), &(reader->buf_odd_max), blob_sz))
+	      goto error;
+	  memcpy (reader->buf_odd, blob, blob_sz);
+	  *blob_odd = reader->buf_odd;
+	  *blob_odd_sz = blob_sz;
+	  if (even && sqlite3_column_type (reader->stmt, 1) == SQLITE_BLOB)
+	    {
+		blob = sqlite3_column_blob (reader->stmt, 1);
+		blob_sz = sqlite3_column_bytes (reader->stmt, 1);
+		if (!rl2_grow_blob_buffer
+		    (&(reader->buf_even), &(reader->buf_even_max), blob_sz))
+		    goto error;
+		memcpy (reader->buf_even, blob, blob_sz);
+		*blob_even = reader->buf_even;
+		*blob_even_sz = blob_sz;
+	    }
+      }
+    /* releasing the read transaction */
+    sqlite3_reset (reader->stmt);
+    return RL2_OK;
+
+  error:
+    sqlite3_reset (reader->stmt);
+    *blob_odd = NULL;
+    *blob_odd_sz = 0;
+    *blob_even = NULL;
+    *blob_even_sz = 0;
+    return RL2_ERROR;
+}
+
+RL2_PRIVATE int
+rl2_read_tile_blobs (struct rl2_tile_reader *reader, const char *coverage,
+		     sqlite3_int64 tile_id, int even,
+		     unsigned char **blob_odd, int *blob_odd_sz,
+		     unsigned char **blob_even, int *blob_even_sz)
+{
+/* 
+/ reading the BLOBs of some Tile by using a private read-only connection
+/ (may be called by any worker thread)
+/ 
+/ the returned BLOBs are stored into buffers owned by the Reader itself,
+/ so they must never be freed by the caller and will be overwritten by
+/ the next call; *blob_odd will be NULL if the Tile has no data
+*/
+    int ret;
+    int len;
+    char *sql;
+    char *table;
+    char *xtable;
+    const char *tbl_odd;
+    const char *tbl_even;
+
+    *blob_odd = NULL;
+    *blob_odd_sz = 0;
+    *blob_even = NULL;
+    *blob_even_sz = 0;
+    even = even ? 1 : 0;
+    if (reader->stmt == NULL || reader->coverage == NULL
+	|| strcasecmp (reader->coverage, coverage) != 0
+	|| reader->even != even)
+      {
+	  /* preparing the Statement for this Coverage - EVEN only if required */
+	  rl2_release_tile_reader (reader);
+	  if (reader->stmt != NULL)
+	      sqlite3_finalize (reader->stmt);
+	  if (reader->coverage != NULL)
+	      free (reader->coverage);
+	  reader->stmt = NULL;
+	  reader->coverage = NULL;
+	  table = sqlite3_mprintf ("%s_tile_data", coverage);
+	  xtable = rl2_double_quoted_sql (table);
+	  sqlite3_free (table);
+	  if (even)
+	      sql =
+		  sqlite3_mprintf
+		  ("SELECT tile_data_odd, tile_data_even FROM main.\"%s\" "
+		   "WHERE tile_id = ?", xtable);
+	  else
+	      sql =
+		  sqlite3_mprintf
+		  ("SELECT tile_data_odd FROM main.\"%s\" WHERE tile_id = ?",
+		   xtable);
+	  free (xtable);
+	  ret =
+	      sqlite3_prepare_v2 (reader->handle, sql, strlen (sql),
+				  &(reader->stmt), NULL);
+	  sqlite3_free (sql);
+	  if (ret != SQLITE_OK)
+	    {
+		reader->stmt = NULL;
+		return RL2_ERROR;
+	    }
+	  len = strlen (coverage);
+	  reader->coverage = malloc (len + 1);
+	  if (reader->coverage == NULL)
+	      return RL2_ERROR;
+	  strcpy (reader->coverage, coverage);
+	  reader->even = even;
+	  reader->split =
+	      (rl2_is_dbms_coverage_split_tiles_enabled
+	       (reader->handle, NULL, coverage) == RL2_TRUE) ? 1 : 0;
+      }
+
+/* 
+/ attempting to directly read the BLOBs into the Reader's own buffers
+/ the Statement is only used as a fallback for unusual cases
+*/
+    tbl_odd = reader->split ? "tile_data_odd" : "tile_data";
+    tbl_even = reader->split ? "tile_data_even" : "tile_data";
+    if (!rl2_read_incremental_blob
+	(reader->handle, "main", reader->coverage, tbl_odd, "tile_data_odd",
+	 tile_id, &(reader->blob_odd), &(reader->buf_odd),
+	 &(reader->buf_odd_max), blob_odd_sz))
+	return do_read_tile_stmt (reader, tile_id, even, blob_odd,
+				  blob_odd_sz, blob_even, blob_even_sz);
+    *blob_odd = reader->buf_odd;
+    if (even)
+      {
+	  /* the EVEN BLOB could legitimately be NULL or missing */
+	  if (rl2_read_incremental_blob
+	      (reader->handle, "main", reader->coverage, tbl_even,
+	       "tile_data_even", tile_id, &(reader->blob_even),
+	       &(reader->buf_even), &(reader->buf_even_max), blob_even_sz))
+	      *blob_even = reader->buf_even;
+      }
+    return RL2_OK;
+}
+
+RL2_PRIVATE struct rl2_slot_buffers *
+rl2_get_slot_buffers (const void *data, int count)
+{
+/* 
+/ returning (at least) "count" reusable BLOB buffers for the AuxDecoder
+/ slots; the buffers owned by the connection are kept across requests,
+/ so they will rarely need to grow again
+/ 
+/ a private set (freed on release) is returned when there is no
+/ connection data or when the connection's own set is already in use
+*/
+    int i;
+    struct rl2_slot_buffer *items;
+    struct rl2_slot_buffer *slot;
+    struct rl2_slot_buffers *buffers = NULL;
+    struct rl2_private_data *priv_data = (struct rl2_private_data *) data;
+
+    if (priv_data != NULL)
+      {
+	  buffers = priv_data->slot_buffers;
+	  if (buffers == NULL)
+	    {
+		buffers = malloc (sizeof (struct rl2_slot_buffers));
+		if (buffers == NULL)
+		    return NULL;
+		buffers->count = 0;
+		buffers->busy = 0;
+		buffers->owned = 1;
+		buffers->items = NULL;
+		priv_data->slot_buffers = buffers;
+	    }
+	  else if (buffers->busy)
+	      buffers = NULL;
+      }
+    if (buffers == NULL)
+      {
+	  /* allocating a private set */
+	  buffers = malloc (sizeof (struct rl2_slot_buffers));
+	  if (buffers == NULL)
+	      return NULL;
+	  buffers->count = 0;
+	  buffers->busy = 0;
+	  buffers->owned = 0;
+	  buffers->items = NULL;
+      }
+    if (count > buffers->count)
+      {
+	  items =
+	      realloc (buffers->items, sizeof (struct rl2_slot_buffer) * count);
+	  if (items == NULL)
+	    {
+		rl2_release_slot_buffers (buffers);
+		return NULL;
+	    }
+	  buffers->items = items;
+	  for (i = buffers->count; i < count; i++)
+	    {
+		slot = buffers->items + i;
+		slot->buf_odd = NULL;
+		slot->buf_odd_max = 0;
+		slot->buf_even = NULL;
+		slot->buf_even_max = 0;
+	    }
+	  buffers->count = count;
+      }
+    buffers->busy = 1;
+    return buffers;
+}
+
+RL2_PRIVATE void
+rl2_release_slot_buffers (struct rl2_slot_buffers *buffers)
+{
+/* 
+/ releasing the AuxDecoder slot buffers at the end of some request
+/ (a private set is immediately freed)
+*/
+    int i;
+    struct rl2_slot_buffer *slot;
+    if (buffers == NULL)
+	return;
+    buffers->busy = 0;
+    if (buffers->owned)
+	return;
+    for (i = 0; i < buffers->count; i++)
+      {
+	  slot = buffers->items + i;
+	  if (slot->buf_odd != NULL)
+	      free (slot->buf_odd);
+	  if (slot->buf_even != NULL)
+	      free (slot->buf_even);
+      }
+    if (buffers->items != NULL)
+	free (buffers->items);
+    free (buffers);
+}
+
+RL2_PRIVATE void
+rl2_release_tile_reader (struct rl2_tile_reader *reader)
+{
+/* 
+/ closing the BLOB handles of some Reader, thus releasing its read
+/ transaction (the BLOB buffers will be reused by the next request)
+*/
+    if (reader->blob_odd != NULL)
+	sqlite3_blob_close (reader->blob_odd);
+    if (reader->blob_even != NULL)
+	sqlite3_blob_close (reader->blob_even);
+    reader->blob_odd = NULL;
+    reader->blob_even = NULL;
+}
+
+RL2_PRIVATE void
+rl2_enable_tile_readers (const void *data, int enabled)
+{
+/* enabling or disabling the read-only connections */
+    struct rl2_tile_readers *readers;
+    struct rl2_tile_readers *readers_n;
+    struct rl2_private_data *priv_data = (struct rl2_private_data *) data;
+    if (priv_data == NULL)
+	return;
+    priv_data->tile_readers_enabled = enabled ? 1 : 0;
+    if (!enabled)
+      {
+	  /* closing all read-only connections */
+	  readers = priv_data->first_tile_readers;
+	  while (readers != NULL)
+	    {
+		readers_n = readers->next;
+		do_destroy_tile_readers (readers);
+		readers = readers_n;
+	    }
+	  priv_data->first_tile_readers = NULL;
+      }
+}
@@ -2503,6 +2503,92 @@ rl2_clone_polygons (rl2GeometryPtr in)
     return out;
 }
 
+RL2_PRIVATE int
+rl2_point_from_blob (const unsigned char *blob, int size, double *x,
+		     double *y, int *srid)
+{
+/* natively decoding a SpatiaLite BLOB POINT (no SQL round-trip) */
+    int little_endian;
+    int endian_arch = rl2GeomEndianArch ();
+    rl2GeometryPtr geom = rl2_geometry_from_blob (blob, size);
+    if (geom == NULL)
+	return RL2_ERROR;
+    if (geom->first_point == NULL || geom->first_point != geom->last_point
+	|| geom->first_linestring != NULL || geom->first_polygon != NULL)
+      {
+	  rl2_destroy_geometry (geom);
+	  return RL2_ERROR;
+      }
+    *x = geom->first_point->x;
+    *y = geom->first_point->y;
+    rl2_destroy_geometry (geom);
+    little_endian = (*(blob + 1) == GAIA_LITTLE_ENDIAN) ? 1 : 0;
+    *srid = rl2GeomImport32 (blob + 2, little_endian, endian_arch);
+    return RL2_OK;
+}
+
+RL2_PRIVATE int
+rl2_multipoint_xyz_to_blob (int srid, int count, const double *x,
+			    const double *y, const double *z,
+			    unsigned char **result, int *size)
+{
+/* builds the SpatiaLite BLOB representation of a MULTIPOINT Z */
+    int i;
+    double minx = DBL_MAX;
+    double miny = DBL_MAX;
+    double maxx = -DBL_MAX;
+    double maxy = -DBL_MAX;
+    unsigned char *ptr;
+    int endian_arch = rl2GeomEndianArch ();
+
+    *result = NULL;
+    *size = 0;
+    if (count <= 0)
+	return 0;
+    for (i = 0; i < count; i++)
+      {
+	  if (x[i] < minx)
+	      minx = x[i];
+	  if (x[i] > maxx)
+	      maxx = x[i];
+	  if (y[i] < miny)
+	      miny = y[i];
+	  if (y[i] > maxy)
+	      maxy = y[i];
+      }
+
+    *size = 48 + (count * 29);	/* header + # entities + [x,y,z] entities + END */
+    *result = malloc (*size);
+    if (*result == NULL)
+      {
+	  *size = 0;
+	  return 0;
+      }
+    ptr = *result;
+    *ptr = GAIA_MARK_START;	/* START signature */
+    *(ptr + 1) = GAIA_LITTLE_ENDIAN;	/* byte ordering */
+    rl2GeomExport32 (ptr + 2, srid, 1, endian_arch);	/* the SRID */
+    rl2GeomExport64 (ptr + 6, minx, 1, endian_arch);	/* MBR - minimum x */
+    rl2GeomExport64 (ptr + 14, miny, 1, endian_arch);	/* MBR - minimum y */
+    rl2GeomExport64 (ptr + 22, maxx, 1, endian_arch);	/* MBR - maximum x */
+    rl2GeomExport64 (ptr + 30, maxy, 1, endian_arch);	/* MBR - maximum y */
+    *(ptr + 38) = GAIA_MARK_MBR;	/* MBR signature */
+    rl2GeomExport32 (ptr + 39, GAIA_MULTIPOINTZ, 1, endian_arch);	/* class MULTIPOINT Z */
+    rl2GeomExport32 (ptr + 43, count, 1, endian_arch);	/* # entities */
+    ptr += 47;
+    for (i = 0; i < count; i++)
+      {
+	  *ptr = GAIA_MARK_ENTITY;	/* ENTITY signature */
+	  rl2GeomExport32 (ptr + 1, GAIA_POINTZ, 1, endian_arch);	/* class POINT Z */
+	  rl2GeomExport64 (ptr + 5, x[i], 1, endian_arch);	/* x */
+	  rl2GeomExport64 (ptr + 13, y[i], 1, endian_arch);	/* y */
+	  rl2GeomExport64 (ptr + 21, z[i], 1, endian_arch);	/* z */
+	  ptr += 29;
+      }
+    *ptr = GAIA_MARK_END;	/* END signature */
+    return 1;
+}
+
 RL2_PRIVATE rl2GeometryPtr
 rl2_build_circle (double cx, double cy, double radius)
 {
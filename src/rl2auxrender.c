@@ -1656,8 +1656,9 @@ rl2_aux_group_renderer (struct aux_group_renderer *auxgrp, unsigned char **blob,
 		by_section = 0;
 		/* retrieving the optimal resolution level */
 		if (!rl2_find_best_resolution_level
-		    (sqlite, cvg->dbPrefix, cvg->coverageName, 0, 0, x_res,
-		     y_res, &level_id, &scale, &xscale, &xx_res, &yy_res))
+		    (sqlite, data, cvg->dbPrefix, cvg->coverageName, 0, 0,
+		     x_res, y_res, &level_id, &scale, &xscale, &xx_res,
+		     &yy_res))
 		    goto error;
 	    }
 	  base_width = (int) (ext_x / xx_res);
@@ -1685,8 +1686,8 @@ rl2_aux_group_renderer (struct aux_group_renderer *auxgrp, unsigned char **blob,
 		  }
 		if (rl2_get_coverage_srid (lyr->coverage, &srid) != RL2_OK)
 		    srid = -1;
-		if (rl2_get_raw_raster_data_bgcolor
-		    (sqlite, max_threads, lyr->coverage, base_width,
+		if (rl2_get_raw_raster_data_bgcolor_common
+		    (sqlite, data, max_threads, lyr->coverage, base_width,
 		     base_height, auxgrp->minx, auxgrp->miny, auxgrp->maxx,
 		     auxgrp->maxy, xx_res, yy_res, &outbuf, &outbuf_size,
 		     &palette, &out_pixel, auxgrp->bg_red, auxgrp->bg_green,
@@ -1701,6 +1702,7 @@ rl2_aux_group_renderer (struct aux_group_renderer *auxgrp, unsigned char **blob,
 
 /* preparing the aux struct for passing rendering arguments */
 	  aux.sqlite = sqlite;
+	  aux.data = data;
 	  aux.max_threads = max_threads;
 	  aux.width = auxgrp->width;
 	  aux.height = auxgrp->height;
@@ -1947,23 +1949,20 @@ do_copy_gray (unsigned char *out, const unsigned char *in, unsigned int width,
       }
 }
 
-RL2_DECLARE int
-rl2_get_raw_raster_data_mixed_resolutions (sqlite3 * handle, int max_threads,
-					   rl2CoveragePtr cvg,
-					   unsigned int width,
-					   unsigned int height, double minx,
-					   double miny, double maxx,
-					   double maxy, double x_res,
-					   double y_res,
-					   unsigned char **buffer,
-					   int *buf_size,
-					   rl2PalettePtr * palette,
-					   unsigned char *out_pixel,
-					   unsigned char bg_red,
-					   unsigned char bg_green,
-					   unsigned char bg_blue,
-					   rl2RasterSymbolizerPtr style,
-					   rl2RasterStatisticsPtr stats)
+RL2_PRIVATE int
+rl2_get_raw_raster_data_mixed_common (sqlite3 * handle, const void *data,
+				      int max_threads, rl2CoveragePtr cvg,
+				      unsigned int width, unsigned int height,
+				      double minx, double miny, double maxx,
+				      double maxy, double x_res, double y_res,
+				      unsigned char **buffer, int *buf_size,
+				      rl2PalettePtr * palette,
+				      unsigned char *out_pixel,
+				      unsigned char bg_red,
+				      unsigned char bg_green,
+				      unsigned char bg_blue,
+				      rl2RasterSymbolizerPtr style,
+				      rl2RasterStatisticsPtr stats)
 {
 /* attempting to return raw pixels from the DBMS Coverage - Mixed Resolutions */
     int ret;
@@ -2126,8 +2125,8 @@ rl2_get_raw_raster_data_mixed_resolutions (sqlite3 * handle, int max_threads,
 		    mxy = section_maxy;
 		/* retrieving the optimal resolution level */
 		if (!rl2_find_best_resolution_level
-		    (handle, db_prefix, coverage, 1, section_id, x_res, y_res,
-		     &level_id, &scale, &xscale, &xx_res, &yy_res))
+		    (handle, data, db_prefix, coverage, 1, section_id, x_res,
+		     y_res, &level_id, &scale, &xscale, &xx_res, &yy_res))
 		    goto error;
 		w = (unsigned int) ((mxx - mnx) / xx_res);
 		if (((double) w * xx_res) < (mxx - mnx))
@@ -2139,8 +2138,8 @@ rl2_get_raw_raster_data_mixed_resolutions (sqlite3 * handle, int max_threads,
 		base_y = (int) ((maxy - mxy) / img_res_y);
 
 		if (rl2_get_raw_raster_data_common
-		    (handle, max_threads, cvg, 1, section_id, w, h, mnx, mny,
-		     mxx, mxy, xx_res, yy_res, &bufpix, &bufpix_size, palette,
+		    (handle, data, max_threads, cvg, 1, section_id, w, h, mnx,
+		     mny, mxx, mxy, xx_res, yy_res, &bufpix, &bufpix_size, palette,
 		     *out_pixel, no_data, xstyle, stats) != RL2_OK)
 		    goto error;
 
@@ -2209,6 +2208,34 @@ rl2_get_raw_raster_data_mixed_resolutions (sqlite3 * handle, int max_threads,
     return RL2_ERROR;
 }
 
+RL2_DECLARE int
+rl2_get_raw_raster_data_mixed_resolutions (sqlite3 * handle, int max_threads,
+					   rl2CoveragePtr cvg,
+					   unsigned int width,
+					   unsigned int height, double minx,
+					   double miny, double maxx,
+					   double maxy, double x_res,
+					   double y_res,
+					   unsigned char **buffer,
+					   int *buf_size,
+					   rl2PalettePtr * palette,
+					   unsigned char *out_pixel,
+					   unsigned char bg_red,
+					   unsigned char bg_green,
+					   unsigned char bg_blue,
+					   rl2RasterSymbolizerPtr style,
+					   rl2RasterStatisticsPtr stats)
+{
+/* attempting to return raw pixels from the DBMS Coverage - Mixed Resolutions */
+    return rl2_get_raw_raster_data_mixed_common (handle, NULL, max_threads,
+						 cvg, width, height, minx,
+						 miny, maxx, maxy, x_res,
+						 y_res, buffer, buf_size,
+						 palette, out_pixel, bg_red,
+						 bg_green, bg_blue, style,
+						 stats);
+}
+
 static int
 point_bbox_matches (rl2PointPtr point, double minx, double miny, double maxx,
 		    double maxy)
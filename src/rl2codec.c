@@ -52,7 +52,13 @@ the terms of any one of the MPL, the GPL or the LGPL.
 #ifndef OMIT_LZMA
 #include <lzma.h>
 #endif
-
+#ifndef OMIT_ZSTD
+#include <zstd.h>
+#include <zstd_errors.h>
+#endif
+#ifndef OMIT_LZ4
+#include <lz4.h>
+#endif
 #ifdef LOADABLE_EXTENSION
 #include "rasterlite2/sqlite.h"
 #endif
@@ -706,114 +712,6 @@ importDouble (const unsigned char *p, int little_endian, int little_endian_arch)
     return convert.dbl_value;
 }
 
-static short
-swapINT16 (short value)
-{
-/* swaps a INT16 respecting declared endiannes */
-    union cvt
-    {
-	unsigned char byte[4];
-	short value;
-    } convert1;
-    union cvt convert2;
-    convert1.value = value;
-    convert2.byte[0] = convert1.byte[1];
-    convert2.byte[1] = convert1.byte[0];
-    return convert2.value;
-}
-
-static unsigned short
-swapUINT16 (unsigned short value)
-{
-/* swaps a UINT16 respecting declared endiannes */
-    union cvt
-    {
-	unsigned char byte[4];
-	unsigned short value;
-    } convert1;
-    union cvt convert2;
-    convert1.value = value;
-    convert2.byte[0] = convert1.byte[1];
-    convert2.byte[1] = convert1.byte[0];
-    return convert2.value;
-}
-
-static int
-swapINT32 (int value)
-{
-/* swaps an INT32 respecting declared endiannes */
-    union cvt
-    {
-	unsigned char byte[4];
-	int value;
-    } convert1;
-    union cvt convert2;
-    convert1.value = value;
-    convert2.byte[0] = convert1.byte[3];
-    convert2.byte[1] = convert1.byte[2];
-    convert2.byte[2] = convert1.byte[1];
-    convert2.byte[3] = convert1.byte[0];
-    return convert2.value;
-}
-
-static unsigned int
-swapUINT32 (unsigned int value)
-{
-/* swaps a UINT32 respecting declared endiannes */
-    union cvt
-    {
-	unsigned char byte[4];
-	unsigned int value;
-    } convert1;
-    union cvt convert2;
-    convert1.value = value;
-    convert2.byte[0] = convert1.byte[3];
-    convert2.byte[1] = convert1.byte[2];
-    convert2.byte[2] = convert1.byte[1];
-    convert2.byte[3] = convert1.byte[0];
-    return convert2.value;
-}
-
-static float
-swapFloat (float value)
-{
-/* swaps a Float respecting declared endiannes */
-    union cvt
-    {
-	unsigned char byte[4];
-	float value;
-    } convert1;
-    union cvt convert2;
-    convert1.value = value;
-    convert2.byte[0] = convert1.byte[3];
-    convert2.byte[1] = convert1.byte[2];
-    convert2.byte[2] = convert1.byte[1];
-    convert2.byte[3] = convert1.byte[0];
-    return convert2.value;
-}
-
-static double
-swapDouble (double value)
-{
-/* swaps a Double respecting declared endiannes */
-    union cvt
-    {
-	unsigned char byte[8];
-	double value;
-    } convert1;
-    union cvt convert2;
-    convert1.value = value;
-    convert2.byte[0] = convert1.byte[7];
-    convert2.byte[1] = convert1.byte[6];
-    convert2.byte[2] = convert1.byte[5];
-    convert2.byte[3] = convert1.byte[4];
-    convert2.byte[4] = convert1.byte[3];
-    convert2.byte[5] = convert1.byte[2];
-    convert2.byte[6] = convert1.byte[1];
-    convert2.byte[7] = convert1.byte[0];
-    return convert2.value;
-}
-
 static int
 check_encode_self_consistency (unsigned char sample_type,
 			       unsigned char pixel_type,
@@ -833,6 +731,10 @@ check_encode_self_consistency (unsigned char sample_type,
 	    case RL2_COMPRESSION_DEFLATE_NO:
 	    case RL2_COMPRESSION_LZMA:
 	    case RL2_COMPRESSION_LZMA_NO:
+	    case RL2_COMPRESSION_ZSTD:
+	    case RL2_COMPRESSION_ZSTD_NO:
+	    case RL2_COMPRESSION_LZ4:
+	    case RL2_COMPRESSION_LZ4_NO:
 	    case RL2_COMPRESSION_PNG:
 	    case RL2_COMPRESSION_CCITTFAX4:
 		break;
@@ -860,6 +762,10 @@ check_encode_self_consistency (unsigned char sample_type,
 	    case RL2_COMPRESSION_DEFLATE_NO:
 	    case RL2_COMPRESSION_LZMA:
 	    case RL2_COMPRESSION_LZMA_NO:
+	    case RL2_COMPRESSION_ZSTD:
+	    case RL2_COMPRESSION_ZSTD_NO:
+	    case RL2_COMPRESSION_LZ4:
+	    case RL2_COMPRESSION_LZ4_NO:
 	    case RL2_COMPRESSION_PNG:
 		break;
 	    default:
@@ -885,6 +791,10 @@ check_encode_self_consistency (unsigned char sample_type,
 	    case RL2_COMPRESSION_DEFLATE_NO:
 	    case RL2_COMPRESSION_LZMA:
 	    case RL2_COMPRESSION_LZMA_NO:
+	    case RL2_COMPRESSION_ZSTD:
+	    case RL2_COMPRESSION_ZSTD_NO:
+	    case RL2_COMPRESSION_LZ4:
+	    case RL2_COMPRESSION_LZ4_NO:
 	    case RL2_COMPRESSION_PNG:
 	    case RL2_COMPRESSION_JPEG:
 	    case RL2_COMPRESSION_LOSSY_WEBP:
@@ -917,6 +827,10 @@ check_encode_self_consistency (unsigned char sample_type,
 		  case RL2_COMPRESSION_DEFLATE_NO:
 		  case RL2_COMPRESSION_LZMA:
 		  case RL2_COMPRESSION_LZMA_NO:
+		  case RL2_COMPRESSION_ZSTD:
+		  case RL2_COMPRESSION_ZSTD_NO:
+		  case RL2_COMPRESSION_LZ4:
+		  case RL2_COMPRESSION_LZ4_NO:
 		  case RL2_COMPRESSION_PNG:
 		  case RL2_COMPRESSION_CHARLS:
 		  case RL2_COMPRESSION_LOSSY_JP2:
@@ -935,6 +849,10 @@ check_encode_self_consistency (unsigned char sample_type,
 		  case RL2_COMPRESSION_DEFLATE_NO:
 		  case RL2_COMPRESSION_LZMA:
 		  case RL2_COMPRESSION_LZMA_NO:
+		  case RL2_COMPRESSION_ZSTD:
+		  case RL2_COMPRESSION_ZSTD_NO:
+		  case RL2_COMPRESSION_LZ4:
+		  case RL2_COMPRESSION_LZ4_NO:
 		  case RL2_COMPRESSION_PNG:
 		  case RL2_COMPRESSION_JPEG:
 		  case RL2_COMPRESSION_LOSSY_WEBP:
@@ -970,6 +888,10 @@ check_encode_self_consistency (unsigned char sample_type,
 			case RL2_COMPRESSION_DEFLATE_NO:
 			case RL2_COMPRESSION_LZMA:
 			case RL2_COMPRESSION_LZMA_NO:
+			case RL2_COMPRESSION_ZSTD:
+			case RL2_COMPRESSION_ZSTD_NO:
+			case RL2_COMPRESSION_LZ4:
+			case RL2_COMPRESSION_LZ4_NO:
 			case RL2_COMPRESSION_PNG:
 			case RL2_COMPRESSION_CHARLS:
 			case RL2_COMPRESSION_LOSSY_JP2:
@@ -988,6 +910,10 @@ check_encode_self_consistency (unsigned char sample_type,
 			case RL2_COMPRESSION_DEFLATE_NO:
 			case RL2_COMPRESSION_LZMA:
 			case RL2_COMPRESSION_LZMA_NO:
+			case RL2_COMPRESSION_ZSTD:
+			case RL2_COMPRESSION_ZSTD_NO:
+			case RL2_COMPRESSION_LZ4:
+			case RL2_COMPRESSION_LZ4_NO:
 			case RL2_COMPRESSION_PNG:
 			case RL2_COMPRESSION_LOSSY_WEBP:
 			case RL2_COMPRESSION_LOSSLESS_WEBP:
@@ -1009,6 +935,10 @@ check_encode_self_consistency (unsigned char sample_type,
 		  case RL2_COMPRESSION_DEFLATE_NO:
 		  case RL2_COMPRESSION_LZMA:
 		  case RL2_COMPRESSION_LZMA_NO:
+		  case RL2_COMPRESSION_ZSTD:
+		  case RL2_COMPRESSION_ZSTD_NO:
+		  case RL2_COMPRESSION_LZ4:
+		  case RL2_COMPRESSION_LZ4_NO:
 		      break;
 		  default:
 		      return 0;
@@ -1042,6 +972,10 @@ check_encode_self_consistency (unsigned char sample_type,
 		  case RL2_COMPRESSION_DEFLATE_NO:
 		  case RL2_COMPRESSION_LZMA:
 		  case RL2_COMPRESSION_LZMA_NO:
+		  case RL2_COMPRESSION_ZSTD:
+		  case RL2_COMPRESSION_ZSTD_NO:
+		  case RL2_COMPRESSION_LZ4:
+		  case RL2_COMPRESSION_LZ4_NO:
 		  case RL2_COMPRESSION_PNG:
 		  case RL2_COMPRESSION_CHARLS:
 		  case RL2_COMPRESSION_LOSSY_JP2:
@@ -1060,6 +994,18 @@ check_encode_self_consistency (unsigned char sample_type,
 		  case RL2_COMPRESSION_DEFLATE_NO:
 		  case RL2_COMPRESSION_LZMA:
 		  case RL2_COMPRESSION_LZMA_NO:
+		  case RL2_COMPRESSION_ZSTD:
+		  case RL2_COMPRESSION_ZSTD_NO:
+		  case RL2_COMPRESSION_LZ4:
+		  case RL2_COMPRESSION_LZ4_NO:
+		      break;
+		  case RL2_COMPRESSION_DEFLATE_FP:
+		  case RL2_COMPRESSION_LZMA_FP:
+		  case RL2_COMPRESSION_ZSTD_FP:
+		      /* the FloatPredictor only applies to FLOAT and DOUBLE */
+		      if (sample_type != RL2_SAMPLE_FLOAT
+			  && sample_type != RL2_SAMPLE_DOUBLE)
+			  return 0;
 		      break;
 		  default:
 		      return 0;
@@ -1173,6 +1119,22 @@ pack_rle_rows (rl2PrivRasterPtr raster, unsigned char *in,
     return 1;
 }
 
+static int
+packed_bits (unsigned char sample_type)
+{
+/* returning the bits per pixel of packed sample types (0 if not packed) */
+    switch (sample_type)
+      {
+      case RL2_SAMPLE_1_BIT:
+	  return 1;
+      case RL2_SAMPLE_2_BIT:
+	  return 2;
+      case RL2_SAMPLE_4_BIT:
+	  return 4;
+      };
+    return 0;
+}
+
 static int
 unpack_rle (unsigned short width, unsigned short height,
 	    const unsigned char *pixels_in, int pixels_in_sz,
@@ -1183,7 +1145,6 @@ unpack_rle (unsigned short width, unsigned short height,
     int buf_size;
     int col;
     int byte;
-    int i;
     unsigned char px;
     int row_stride;
     int row_no;
@@ -1234,8 +1195,8 @@ unpack_rle (unsigned short width, unsigned short height,
 		px = 1;
 		cnt = byte + 1;
 	    }
-	  for (i = 0; i < cnt; i++)
-	      *p_out++ = px;
+	  memset (p_out, px, cnt);
+	  p_out += cnt;
       }
 
     *pixels = buf;
@@ -1246,28 +1207,18 @@ unpack_rle (unsigned short width, unsigned short height,
 }
 
 static int
-pack_1bit_rows (rl2PrivRasterPtr raster, unsigned char *in, int *xrow_stride,
-		unsigned char **pixels, int *size)
+pack_bit_rows (rl2PrivRasterPtr raster, int bits, int *xrow_stride,
+	       unsigned char **pixels, int *size)
 {
-/* creating a packed 1-BIT pixel buffer */
-    int row_stride = 0;
+/* creating a packed 1, 2 or 4-BIT pixel buffer */
+    int row_stride;
     unsigned char *pix_buf = NULL;
     int pix_size;
     unsigned int row;
-    unsigned int col;
-    int cnt = 0;
-    unsigned char *p_in = in;
+    unsigned char *p_in = raster->rasterBuffer;
 
 /* computing the required sizes */
-    for (col = 0; col < raster->width; col++)
-      {
-	  if (cnt == 0)
-	      row_stride++;
-	  if (cnt == 7)
-	      cnt = 0;
-	  else
-	      cnt++;
-      }
+    row_stride = ((raster->width * bits) + 7) / 8;
     pix_size = raster->height * row_stride;
 
 /* allocating the pixel buffers */
@@ -1278,59 +1229,9 @@ pack_1bit_rows (rl2PrivRasterPtr raster, unsigned char *in, int *xrow_stride,
 /* pixels packing */
     for (row = 0; row < raster->height; row++)
       {
-	  unsigned char *p_out = pix_buf + (row_stride * row);
-	  unsigned char packed = 0x00;
-	  unsigned char pixel;
-	  cnt = 0;
-	  for (col = 0; col < raster->width; col++)
-	    {
-		pixel = *p_in++;
-		switch (cnt)
-		  {
-		  case 0:
-		      if (pixel != 0)
-			  packed |= 0x80;
-		      break;
-		  case 1:
-		      if (pixel != 0)
-			  packed |= 0x40;
-		      break;
-		  case 2:
-		      if (pixel != 0)
-			  packed |= 0x20;
-		      break;
-		  case 3:
-		      if (pixel != 0)
-			  packed |= 0x10;
-		      break;
-		  case 4:
-		      if (pixel != 0)
-			  packed |= 0x08;
-		      break;
-		  case 5:
-		      if (pixel != 0)
-			  packed |= 0x04;
-		      break;
-		  case 6:
-		      if (pixel != 0)
-			  packed |= 0x02;
-		      break;
-		  case 7:
-		      if (pixel != 0)
-			  packed |= 0x01;
-		      break;
-		  };
-		if (cnt == 7)
-		  {
-		      *p_out++ = packed;
-		      packed = 0x00;
-		      cnt = 0;
-		  }
-		else
-		    cnt++;
-	    }
-	  if (cnt != 0)
-	      *p_out++ = packed;
+	  rl2_pack_bits (pix_buf + (row_stride * row), p_in, raster->width,
+			 bits);
+	  p_in += raster->width;
       }
 
     *xrow_stride = row_stride;
@@ -1340,739 +1241,500 @@ pack_1bit_rows (rl2PrivRasterPtr raster, unsigned char *in, int *xrow_stride,
 }
 
 static int
-pack_2bit_rows (rl2PrivRasterPtr raster, int *xrow_stride,
-		unsigned char **pixels, int *size)
+odd_even_rows (rl2PrivRasterPtr raster, int *odd_rows, int *row_stride_odd,
+	       unsigned char **pixels_odd, int *size_odd, int *even_rows,
+	       int *row_stride_even, unsigned char **pixels_even,
+	       int *size_even, int little_endian)
 {
-/* creating a packed 2-BIT pixel buffer */
-    int row_stride = 0;
-    unsigned char *pix_buf = NULL;
-    int pix_size;
+/* creating both Odd and Even rows buffers */
+    int o_rows = 0;
+    int e_rows = 0;
+    int o_stride = 0;
+    int e_stride = 0;
+    unsigned char *pix_odd = NULL;
+    unsigned char *pix_even = NULL;
+    const unsigned char *p_in;
+    unsigned char *p_odd;
+    unsigned char *p_even;
+    int o_size;
+    int e_size;
     unsigned int row;
-    unsigned int col;
-    int cnt = 0;
-    unsigned char *p_in = raster->rasterBuffer;
+    int pix_size = 1;
+    int swap = 0;
+    if (little_endian != endianArch ())
+	swap = 1;
+    else
+	swap = 0;
 
 /* computing the required sizes */
-    for (col = 0; col < raster->width; col++)
+    for (row = 0; row < raster->height; row += 2)
+	o_rows++;
+    for (row = 1; row < raster->height; row += 2)
+	e_rows++;
+    switch (raster->sampleType)
       {
-	  if (cnt == 0)
-	      row_stride++;
-	  if (cnt == 3)
-	      cnt = 0;
-	  else
-	      cnt++;
-      }
-    pix_size = raster->height * row_stride;
+      case RL2_SAMPLE_INT8:
+      case RL2_SAMPLE_UINT8:
+	  pix_size = 1;
+	  break;
+      case RL2_SAMPLE_INT16:
+      case RL2_SAMPLE_UINT16:
+	  pix_size = 2;
+	  break;
+      case RL2_SAMPLE_INT32:
+      case RL2_SAMPLE_UINT32:
+      case RL2_SAMPLE_FLOAT:
+	  pix_size = 4;
+	  break;
+      case RL2_SAMPLE_DOUBLE:
+	  pix_size = 8;
+	  break;
+      };
+    o_size = raster->width * o_rows * pix_size * raster->nBands;
+    e_size = raster->width * e_rows * pix_size * raster->nBands;
+    o_stride = raster->width * pix_size * raster->nBands;
+    e_stride = o_stride;
 
 /* allocating the pixel buffers */
-    pix_buf = malloc (pix_size);
-    if (pix_buf == NULL)
+    pix_odd = malloc (o_size);
+    if (pix_odd == NULL)
 	return 0;
-
-/* pixels packing */
+    pix_even = malloc (e_size);
+    if (pix_even == NULL)
+      {
+	  free (pix_odd);
+	  return 0;
+      }
+/* feeding the pixel buffers - every scanline is fully overwritten */
+    p_in = raster->rasterBuffer;
+    p_odd = pix_odd;
+    p_even = pix_even;
     for (row = 0; row < raster->height; row++)
       {
-	  unsigned char *p_out = pix_buf + (row_stride * row);
-	  unsigned char packed = 0x00;
-	  unsigned char pixel;
-	  cnt = 0;
-	  for (col = 0; col < raster->width; col++)
+	  if ((row % 2) == 0)
 	    {
-		pixel = *p_in++;
-		switch (cnt)
-		  {
-		  case 0:
-		      switch (pixel)
-			{
-			case 1:
-			    packed |= 0x40;
-			    break;
-			case 2:
-			    packed |= 0x80;
-			    break;
-			case 3:
-			    packed |= 0xc0;
-			    break;
-			};
-		      break;
-		  case 1:
-		      switch (pixel)
-			{
-			case 1:
-			    packed |= 0x10;
-			    break;
-			case 2:
-			    packed |= 0x20;
-			    break;
-			case 3:
-			    packed |= 0x30;
-			    break;
-			};
-		      break;
-		  case 2:
-		      switch (pixel)
-			{
-			case 1:
-			    packed |= 0x04;
-			    break;
-			case 2:
-			    packed |= 0x08;
-			    break;
-			case 3:
-			    packed |= 0x0c;
-			    break;
-			};
-		      break;
-		  case 3:
-		      switch (pixel)
-			{
-			case 1:
-			    packed |= 0x01;
-			    break;
-			case 2:
-			    packed |= 0x02;
-			    break;
-			case 3:
-			    packed |= 0x03;
-			    break;
-			};
-		      break;
-		  };
-		if (cnt == 3)
-		  {
-		      *p_out++ = packed;
-		      packed = 0x00;
-		      cnt = 0;
-		  }
-		else
-		    cnt++;
+		rl2_copy_pixel_row (p_odd, p_in, raster->width, pix_size,
+				    raster->nBands, 1, swap);
+		p_odd += o_stride;
+	    }
+	  else
+	    {
+		rl2_copy_pixel_row (p_even, p_in, raster->width, pix_size,
+				    raster->nBands, 1, swap);
+		p_even += e_stride;
 	    }
-	  if (cnt != 0)
-	      *p_out++ = packed;
+	  p_in += o_stride;
       }
-
-    *xrow_stride = row_stride;
-    *pixels = pix_buf;
-    *size = pix_size;
+    *odd_rows = o_rows;
+    *even_rows = e_rows;
+    *row_stride_odd = o_stride;
+    *row_stride_even = e_stride;
+    *pixels_odd = pix_odd;
+    *pixels_even = pix_even;
+    *size_odd = o_size;
+    *size_even = e_size;
     return 1;
 }
 
+#ifndef OMIT_ZSTD		/* only if ZSTD is enabled */
 static int
-pack_4bit_rows (rl2PrivRasterPtr raster, int *xrow_stride,
-		unsigned char **pixels, int *size)
+zstd_compression_level (int quality)
 {
-/* creating a packed 4-BIT pixel buffer */
-    int row_stride = 0;
-    unsigned char *pix_buf = NULL;
-    int pix_size;
-    unsigned int row;
-    unsigned int col;
-    int cnt = 0;
-    unsigned char *p_in = raster->rasterBuffer;
+/* mapping the 0-100 Coverage quality into a Zstandard compression level */
+    if (quality <= 0)
+	return 3;		/* the Zstandard default */
+    if (quality > 100)
+	quality = 100;
+    return 1 + (((quality - 1) * 19) / 100);
+}
 
-/* computing the required sizes */
-    for (col = 0; col < raster->width; col++)
+static int
+compress_zstd (unsigned char *pixels, int size, int delta_dist, int quality,
+	       unsigned char **zstd_buf, int *zstd_sz)
+{
+/* 
+/ compressing a pixels buffer as Zstandard
+/ - delta_dist = 0 means noDelta
+/ - *zstd_buf = NULL means that the pixels buffer should be stored 
+/   uncompressed, because compression would actually cause inflation
+*/
+    size_t ret;
+    size_t zLen = size - 1;
+    unsigned char *buf;
+
+    *zstd_buf = NULL;
+    *zstd_sz = 0;
+    if (size < 2)
+	return RL2_OK;
+    buf = malloc (zLen);
+    if (buf == NULL)
+	return RL2_ERROR;
+    if (delta_dist > 0)
       {
-	  if (cnt == 0)
-	      row_stride++;
-	  if (cnt == 1)
-	      cnt = 0;
-	  else
-	      cnt++;
+	  if (rl2_delta_encode (pixels, size, delta_dist) != RL2_OK)
+	    {
+		free (buf);
+		return RL2_ERROR;
+	    }
       }
-    pix_size = raster->height * row_stride;
+    ret =
+	ZSTD_compress (buf, zLen, pixels, size,
+		       zstd_compression_level (quality));
+    if (!ZSTD_isError (ret))
+      {
+	  /* ok, Zstandard compression was successful */
+	  *zstd_buf = buf;
+	  *zstd_sz = (int) ret;
+	  return RL2_OK;
+      }
+    free (buf);
+    if (ZSTD_getErrorCode (ret) != ZSTD_error_dstSize_tooSmall)
+	return RL2_ERROR;
+    if (delta_dist > 0)
+      {
+	  /* restoring the original pixels */
+	  if (rl2_delta_decode (pixels, size, delta_dist) != RL2_OK)
+	      return RL2_ERROR;
+      }
+    return RL2_OK;
+}
 
-/* allocating the pixel buffers */
-    pix_buf = malloc (pix_size);
-    if (pix_buf == NULL)
-	return 0;
+static int
+decompress_zstd (const unsigned char *in, int compressed, int uncompressed,
+		 int delta_dist, unsigned char **out)
+{
+/* decompressing a Zstandard block (delta_dist = 0 means noDelta) */
+    size_t ret;
+    unsigned char *buf = malloc (uncompressed);
+    *out = NULL;
+    if (buf == NULL)
+	return RL2_ERROR;
+    ret = ZSTD_decompress (buf, uncompressed, in, compressed);
+    if (ZSTD_isError (ret) || ret != (size_t) uncompressed)
+	goto error;
+    if (delta_dist > 0)
+      {
+	  if (rl2_delta_decode (buf, uncompressed, delta_dist) != RL2_OK)
+	      goto error;
+      }
+    *out = buf;
+    return RL2_OK;
 
-/* pixels packing */
-    for (row = 0; row < raster->height; row++)
+  error:
+    free (buf);
+    return RL2_ERROR;
+}
+#endif /* end ZSTD conditional */
+
+#ifndef OMIT_LZ4		/* only if LZ4 is enabled */
+static int
+compress_lz4 (const unsigned char *pixels, int size, int shuffle,
+	      unsigned char **lz4_buf, int *lz4_sz)
+{
+/* 
+/ compressing a pixels buffer as LZ4
+/ - shuffle = 0 means noShuffle, otherwise it's the ByteShuffle stride
+/ - *lz4_buf = NULL means that the pixels buffer should be stored 
+/   uncompressed, because compression would actually cause inflation
+/ - the pixels buffer is never modified
+*/
+    int ret;
+    int zLen = size - 1;
+    unsigned char *buf;
+    unsigned char *shuffled = NULL;
+    const unsigned char *in = pixels;
+
+    *lz4_buf = NULL;
+    *lz4_sz = 0;
+    if (size < 2)
+	return RL2_OK;
+    buf = malloc (zLen);
+    if (buf == NULL)
+	return RL2_ERROR;
+    if (shuffle > 1)
       {
-	  unsigned char *p_out = pix_buf + (row_stride * row);
-	  unsigned char packed = 0x00;
-	  unsigned char pixel;
-	  cnt = 0;
-	  for (col = 0; col < raster->width; col++)
+	  shuffled = malloc (size);
+	  if (shuffled == NULL)
 	    {
-		pixel = *p_in++;
-		switch (cnt)
-		  {
-		  case 0:
-		      switch (pixel)
-			{
-			case 1:
-			    packed |= 0x10;
-			    break;
-			case 2:
-			    packed |= 0x20;
-			    break;
-			case 3:
-			    packed |= 0x30;
-			    break;
-			case 4:
-			    packed |= 0x40;
-			    break;
-			case 5:
-			    packed |= 0x50;
-			    break;
-			case 6:
-			    packed |= 0x60;
-			    break;
-			case 7:
-			    packed |= 0x70;
-			    break;
-			case 8:
-			    packed |= 0x80;
-			    break;
-			case 9:
-			    packed |= 0x90;
-			    break;
-			case 10:
-			    packed |= 0xa0;
-			    break;
-			case 11:
-			    packed |= 0xb0;
-			    break;
-			case 12:
-			    packed |= 0xc0;
-			    break;
-			case 13:
-			    packed |= 0xd0;
-			    break;
-			case 14:
-			    packed |= 0xe0;
-			    break;
-			case 15:
-			    packed |= 0xf0;
-			    break;
-			};
-		      break;
-		  case 1:
-		      switch (pixel)
-			{
-			case 1:
-			    packed |= 0x01;
-			    break;
-			case 2:
-			    packed |= 0x02;
-			    break;
-			case 3:
-			    packed |= 0x03;
-			    break;
-			case 4:
-			    packed |= 0x04;
-			    break;
-			case 5:
-			    packed |= 0x05;
-			    break;
-			case 6:
-			    packed |= 0x06;
-			    break;
-			case 7:
-			    packed |= 0x07;
-			    break;
-			case 8:
-			    packed |= 0x08;
-			    break;
-			case 9:
-			    packed |= 0x09;
-			    break;
-			case 10:
-			    packed |= 0x0a;
-			    break;
-			case 11:
-			    packed |= 0x0b;
-			    break;
-			case 12:
-			    packed |= 0x0c;
-			    break;
-			case 13:
-			    packed |= 0x0d;
-			    break;
-			case 14:
-			    packed |= 0x0e;
-			    break;
-			case 15:
-			    packed |= 0x0f;
-			    break;
-			};
-		      break;
-		  };
-		if (cnt == 1)
-		  {
-		      *p_out++ = packed;
-		      packed = 0x00;
-		      cnt = 0;
-		  }
-		else
-		    cnt++;
+		free (buf);
+		return RL2_ERROR;
 	    }
-	  if (cnt != 0)
-	      *p_out++ = packed;
-      }
-
-    *xrow_stride = row_stride;
-    *pixels = pix_buf;
-    *size = pix_size;
-    return 1;
-}
-
-static void
-feed_odd_even_int8 (void *in, unsigned int width, unsigned int height,
-		    int bands, void *pix_odd, void *pix_even)
-{
-/* feeding Odd/Even pixel buffers - INT8 */
-    char *p_in;
-    char *p_odd = pix_odd;
-    char *p_even = pix_even;
-    unsigned int row;
-    unsigned int col;
-
-    p_in = in;
-    for (row = 0; row < height; row += 2)
-      {
-	  for (col = 0; col < width * bands; col++)
-	      *p_odd++ = *p_in++;
-	  p_in += width * bands;
-      }
-
-    p_in = in;
-    for (row = 1; row < height; row += 2)
-      {
-	  p_in += width * bands;
-	  for (col = 0; col < width * bands; col++)
-	      *p_even++ = *p_in++;
-      }
-}
-
-static void
-feed_odd_even_uint8 (void *in, unsigned int width, unsigned int height,
-		     int bands, void *pix_odd, void *pix_even)
-{
-/* feeding Odd/Even pixel buffers - UINT8 */
-    unsigned char *p_in;
-    unsigned char *p_odd = pix_odd;
-    unsigned char *p_even = pix_even;
-    unsigned int row;
-    unsigned int col;
-
-    p_in = in;
-    for (row = 0; row < height; row += 2)
-      {
-	  for (col = 0; col < width * bands; col++)
-	      *p_odd++ = *p_in++;
-	  p_in += width * bands;
+	  rl2_byte_shuffle (pixels, shuffled, size, shuffle);
+	  in = shuffled;
       }
-
-    p_in = in;
-    for (row = 1; row < height; row += 2)
+    ret = LZ4_compress_default ((const char *) in, (char *) buf, size, zLen);
+    if (shuffled != NULL)
+	free (shuffled);
+    if (ret <= 0)
       {
-	  p_in += width * bands;
-	  for (col = 0; col < width * bands; col++)
-	      *p_even++ = *p_in++;
+	  /* LZ4 compression actually causes inflation */
+	  free (buf);
+	  return RL2_OK;
       }
+    *lz4_buf = buf;
+    *lz4_sz = ret;
+    return RL2_OK;
 }
 
-static void
-feed_odd_even_int16 (void *in, unsigned int width, unsigned int height,
-		     int bands, void *pix_odd, void *pix_even, int swap)
-{
-/* feeding Odd/Even pixel buffers - INT16 */
-    short *p_in;
-    short *p_odd = pix_odd;
-    short *p_even = pix_even;
-    unsigned int row;
-    unsigned int col;
-
-    p_in = in;
-    for (row = 0; row < height; row += 2)
+static int
+decompress_lz4 (const unsigned char *in, int compressed, int uncompressed,
+		int shuffle, unsigned char **out)
+{
+/* decompressing an LZ4 block (shuffle = 0 means noShuffle) */
+    int ret;
+    unsigned char *buf = malloc (uncompressed);
+    unsigned char *unshuffled;
+    *out = NULL;
+    if (buf == NULL)
+	return RL2_ERROR;
+    ret =
+	LZ4_decompress_safe ((const char *) in, (char *) buf, compressed,
+			     uncompressed);
+    if (ret != uncompressed)
       {
-	  for (col = 0; col < width * bands; col++)
-	    {
-		if (swap)
-		    *p_odd++ = swapINT16 (*p_in++);
-		else
-		    *p_odd++ = *p_in++;
-	    }
-	  p_in += width * bands;
+	  free (buf);
+	  return RL2_ERROR;
       }
-
-    p_in = in;
-    for (row = 1; row < height; row += 2)
+    if (shuffle > 1)
       {
-	  p_in += width * bands;
-	  for (col = 0; col < width * bands; col++)
+	  unshuffled = malloc (uncompressed);
+	  if (unshuffled == NULL)
 	    {
-		if (swap)
-		    *p_even++ = swapINT16 (*p_in++);
-		else
-		    *p_even++ = *p_in++;
+		free (buf);
+		return RL2_ERROR;
 	    }
+	  rl2_byte_unshuffle (buf, unshuffled, uncompressed, shuffle);
+	  free (buf);
+	  buf = unshuffled;
       }
+    *out = buf;
+    return RL2_OK;
 }
+#endif /* end LZ4 conditional */
 
-static void
-feed_odd_even_uint16 (void *in, unsigned int width, unsigned int height,
-		      int bands, void *pix_odd, void *pix_even, int swap)
+static int
+compress_float_predictor (int compression, const unsigned char *pixels,
+			  int size, int sample_size, int little_endian,
+			  int quality, unsigned char **out, int *out_sz)
 {
-/* feeding Odd/Even pixel buffers - UINT16 */
-    unsigned short *p_in;
-    unsigned short *p_odd = pix_odd;
-    unsigned short *p_even = pix_even;
-    unsigned int row;
-    unsigned int col;
+/* 
+/ compressing a FLOAT/DOUBLE pixels buffer after applying the FloatPredictor
+/ - *out = NULL means that the pixels buffer should be stored uncompressed,
+/   because compression would actually cause inflation
+*/
+    unsigned char *filtered;
+    unsigned char *buf = NULL;
+    int ret = RL2_ERROR;
 
-    p_in = in;
-    for (row = 0; row < height; row += 2)
-      {
-	  for (col = 0; col < width * bands; col++)
-	    {
-		if (swap)
-		    *p_odd++ = swapUINT16 (*p_in++);
-		else
-		    *p_odd++ = *p_in++;
-	    }
-	  p_in += width * bands;
-      }
+    *out = NULL;
+    *out_sz = 0;
+    if (size < 2)
+	return RL2_OK;
+    filtered = malloc (size);
+    if (filtered == NULL)
+	return RL2_ERROR;
+    rl2_float_predictor_encode (pixels, filtered, size, sample_size,
+				little_endian);
 
-    p_in = in;
-    for (row = 1; row < height; row += 2)
+    if (compression == RL2_COMPRESSION_DEFLATE_FP)
       {
-	  p_in += width * bands;
-	  for (col = 0; col < width * bands; col++)
+	  /* compressing as ZIP FloatPredictor [Deflate] */
+	  int zret;
+	  uLong zLen = size - 1;
+	  buf = malloc (zLen);
+	  if (buf == NULL)
+	      goto end;
+	  zret = compress (buf, &zLen, filtered, (uLong) size);
+	  if (zret == Z_OK)
 	    {
-		if (swap)
-		    *p_even++ = swapUINT16 (*p_in++);
-		else
-		    *p_even++ = *p_in++;
+		*out = buf;
+		*out_sz = (int) zLen;
+		buf = NULL;
 	    }
+	  else if (zret != Z_BUF_ERROR)
+	      goto end;
+	  ret = RL2_OK;
       }
-}
-
-static void
-feed_odd_even_int32 (void *in, unsigned int width, unsigned int height,
-		     int bands, void *pix_odd, void *pix_even, int swap)
-{
-/* feeding Odd/Even pixel buffers - INT32 */
-    int *p_in;
-    int *p_odd = pix_odd;
-    int *p_even = pix_even;
-    unsigned int row;
-    unsigned int col;
-
-    p_in = in;
-    for (row = 0; row < height; row += 2)
+    else if (compression == RL2_COMPRESSION_LZMA_FP)
       {
-	  for (col = 0; col < width * bands; col++)
-	    {
-		if (swap)
-		    *p_odd++ = swapINT32 (*p_in++);
-		else
-		    *p_odd++ = *p_in++;
-	    }
-	  p_in += width * bands;
+#ifndef OMIT_LZMA		/* only if LZMA is enabled */
+	  /* compressing as LZMA FloatPredictor */
+	  lzma_options_lzma opt_lzma2;
+	  lzma_ret lret;
+	  lzma_filter filters[2];
+	  size_t out_pos = 0;
+	  size_t lzmaLen = size - 1;
+	  buf = malloc (lzmaLen);
+	  if (buf == NULL)
+	      goto end;
+	  lzma_lzma_preset (&opt_lzma2, LZMA_PRESET_DEFAULT);
+	  filters[0].id = LZMA_FILTER_LZMA2;
+	  filters[0].options = &opt_lzma2;
+	  filters[1].id = LZMA_VLI_UNKNOWN;
+	  filters[1].options = NULL;
+	  lret =
+	      lzma_raw_buffer_encode (filters, NULL, filtered, size, buf,
+				      &out_pos, lzmaLen);
+	  if (lret == LZMA_OK)
+	    {
+		*out = buf;
+		*out_sz = (int) out_pos;
+		buf = NULL;
+	    }
+	  else if (lret != LZMA_BUF_ERROR)
+	      goto end;
+	  ret = RL2_OK;
+#else /* LZMA is disabled */
+	  fprintf (stderr,
+		   "librasterlite2 was built by disabling LZMA support\n");
+#endif /* end LZMA conditional */
       }
-
-    p_in = in;
-    for (row = 1; row < height; row += 2)
+    else if (compression == RL2_COMPRESSION_ZSTD_FP)
       {
-	  p_in += width * bands;
-	  for (col = 0; col < width * bands; col++)
-	    {
-		if (swap)
-		    *p_even++ = swapINT32 (*p_in++);
-		else
-		    *p_even++ = *p_in++;
-	    }
+#ifndef OMIT_ZSTD		/* only if ZSTD is enabled */
+	  /* compressing as Zstandard FloatPredictor */
+	  ret = compress_zstd (filtered, size, 0, quality, out, out_sz);
+#else /* ZSTD is disabled */
+	  fprintf (stderr,
+		   "librasterlite2 was built by disabling Zstandard support\n");
+#endif /* end ZSTD conditional */
       }
+
+  end:
+    if (buf != NULL)
+	free (buf);
+    free (filtered);
+    return ret;
 }
 
-static void
-feed_odd_even_uint32 (void *in, unsigned int width, unsigned int height,
-		      int bands, void *pix_odd, void *pix_even, int swap)
+static int
+decompress_float_predictor (int compression, const unsigned char *in,
+			    int compressed, int uncompressed,
+			    int sample_size, int little_endian,
+			    unsigned char **out)
 {
-/* feeding Odd/Even pixel buffers - UINT32 */
-    unsigned int *p_in;
-    unsigned int *p_odd = pix_odd;
-    unsigned int *p_even = pix_even;
-    unsigned int row;
-    unsigned int col;
+/* decompressing a FLOAT/DOUBLE block encoded by the FloatPredictor */
+    unsigned char *filtered = NULL;
+    unsigned char *buf;
+    *out = NULL;
 
-    p_in = in;
-    for (row = 0; row < height; row += 2)
+    if (compression == RL2_COMPRESSION_DEFLATE_FP)
       {
-	  for (col = 0; col < width * bands; col++)
-	    {
-		if (swap)
-		    *p_odd++ = swapUINT32 (*p_in++);
-		else
-		    *p_odd++ = *p_in++;
-	    }
-	  p_in += width * bands;
+	  /* decompressing from ZIP FloatPredictor [Deflate] */
+	  uLong refLen = uncompressed;
+	  filtered = malloc (uncompressed);
+	  if (filtered == NULL)
+	      return RL2_ERROR;
+	  if (uncompress (filtered, &refLen, in, compressed) != Z_OK)
+	      goto error;
       }
-
-    p_in = in;
-    for (row = 1; row < height; row += 2)
+    else if (compression == RL2_COMPRESSION_LZMA_FP)
       {
-	  p_in += width * bands;
-	  for (col = 0; col < width * bands; col++)
-	    {
-		if (swap)
-		    *p_even++ = swapUINT32 (*p_in++);
-		else
-		    *p_even++ = *p_in++;
-	    }
+#ifndef OMIT_LZMA		/* only if LZMA is enabled */
+	  /* decompressing from LZMA FloatPredictor */
+	  lzma_options_lzma opt_lzma2;
+	  lzma_filter filters[2];
+	  size_t in_pos = 0;
+	  size_t out_pos = 0;
+	  filtered = malloc (uncompressed);
+	  if (filtered == NULL)
+	      return RL2_ERROR;
+	  lzma_lzma_preset (&opt_lzma2, LZMA_PRESET_DEFAULT);
+	  filters[0].id = LZMA_FILTER_LZMA2;
+	  filters[0].options = &opt_lzma2;
+	  filters[1].id = LZMA_VLI_UNKNOWN;
+	  filters[1].options = NULL;
+	  if (lzma_raw_buffer_decode
+	      (filters, NULL, in, &in_pos, compressed, filtered, &out_pos,
+	       uncompressed) != LZMA_OK)
+	      goto error;
+#else /* LZMA is disabled */
+	  fprintf (stderr,
+		   "librasterlite2 was built by disabling LZMA support\n");
+	  return RL2_ERROR;
+#endif /* end LZMA conditional */
       }
-}
-
-static void
-feed_odd_even_float (void *in, unsigned int width, unsigned int height,
-		     int bands, void *pix_odd, void *pix_even, int swap)
-{
-/* feeding Odd/Even pixel buffers - FLOAT */
-    float *p_in;
-    float *p_odd = pix_odd;
-    float *p_even = pix_even;
-    unsigned int row;
-    unsigned int col;
-
-    p_in = in;
-    for (row = 0; row < height; row += 2)
+    else if (compression == RL2_COMPRESSION_ZSTD_FP)
       {
-	  for (col = 0; col < width * bands; col++)
-	    {
-		if (swap)
-		    *p_odd++ = swapFloat (*p_in++);
-		else
-		    *p_odd++ = *p_in++;
-	    }
-	  p_in += width * bands;
+#ifndef OMIT_ZSTD		/* only if ZSTD is enabled */
+	  /* decompressing from Zstandard FloatPredictor */
+	  if (decompress_zstd (in, compressed, uncompressed, 0, &filtered) !=
+	      RL2_OK)
+	      return RL2_ERROR;
+#else /* ZSTD is disabled */
+	  fprintf (stderr,
+		   "librasterlite2 was built by disabling Zstandard support\n");
+	  return RL2_ERROR;
+#endif /* end ZSTD conditional */
       }
+    else
+	return RL2_ERROR;
 
-    p_in = in;
-    for (row = 1; row < height; row += 2)
-      {
-	  p_in += width * bands;
-	  for (col = 0; col < width * bands; col++)
-	    {
-		if (swap)
-		    *p_even++ = swapFloat (*p_in++);
-		else
-		    *p_even++ = *p_in++;
-	    }
-      }
+    buf = malloc (uncompressed);
+    if (buf == NULL)
+	goto error;
+    rl2_float_predictor_decode (filtered, buf, uncompressed, sample_size,
+				little_endian);
+    free (filtered);
+    *out = buf;
+    return RL2_OK;
+
+  error:
+    if (filtered != NULL)
+	free (filtered);
+    return RL2_ERROR;
 }
 
-static void
-feed_odd_even_double (void *in, unsigned int width, unsigned int height,
-		      int bands, void *pix_odd, void *pix_even, int swap)
+RL2_DECLARE int
+rl2_raster_encode (rl2RasterPtr rst, int compression,
+		   unsigned char **blob_odd, int *blob_odd_sz,
+		   unsigned char **blob_even, int *blob_even_sz, int quality,
+		   int little_endian)
 {
-/* feeding Odd/Even pixel buffers - DOUBLE */
-    double *p_in;
-    double *p_odd = pix_odd;
-    double *p_even = pix_even;
-    unsigned int row;
-    unsigned int col;
+/* encoding a Raster into the internal RL2 binary format */
+    rl2PrivRasterPtr raster = (rl2PrivRasterPtr) rst;
+    int odd_rows;
+    unsigned char *pixels_odd = NULL;
+    int size_odd;
+    int even_rows = 0;
+    unsigned char *pixels_even = NULL;
+    int size_even = 0;
+    int row_stride_odd = 0;
+    unsigned char *mask_pix = NULL;
+    int mask_pix_size = 0;
+    unsigned char *block_odd = NULL;
+    int block_odd_size = 0;
+    int row_stride_even = 0;
+    unsigned char *block_even = NULL;
+    int block_even_size = 0;
+    unsigned char *ptr;
+    int uncompressed = 0;
+    int compressed;
+    int uncompressed_mask = 0;
+    int compressed_mask = 0;
+    unsigned char *compr_data = NULL;
+    unsigned char *compr_mask = NULL;
+    unsigned char *to_clean1 = NULL;
+    unsigned char *to_clean2 = NULL;
+    unsigned char *save_mask = NULL;
+    uLong crc;
+    int endian_arch = endianArch ();
+    int delta_dist;
+    *blob_odd = NULL;
+    *blob_odd_sz = 0;
+    *blob_even = NULL;
+    *blob_even_sz = 0;
 
-    p_in = in;
-    for (row = 0; row < height; row += 2)
-      {
-	  for (col = 0; col < width * bands; col++)
-	    {
-		if (swap)
-		    *p_odd++ = swapDouble (*p_in++);
-		else
-		    *p_odd++ = *p_in++;
-	    }
-	  p_in += width * bands;
-      }
+    if (raster == NULL)
+	return RL2_ERROR;
+    if (!check_encode_self_consistency
+	(raster->sampleType, raster->pixelType, raster->nBands, compression))
+	return RL2_ERROR;
 
-    p_in = in;
-    for (row = 1; row < height; row += 2)
+    switch (raster->pixelType)
       {
-	  p_in += width * bands;
-	  for (col = 0; col < width * bands; col++)
-	    {
-		if (swap)
-		    *p_even++ = swapDouble (*p_in++);
-		else
-		    *p_even++ = *p_in++;
-	    }
-      }
-}
-
-static int
-odd_even_rows (rl2PrivRasterPtr raster, int *odd_rows, int *row_stride_odd,
-	       unsigned char **pixels_odd, int *size_odd, int *even_rows,
-	       int *row_stride_even, unsigned char **pixels_even,
-	       int *size_even, int little_endian)
-{
-/* creating both Odd and Even rows buffers */
-    int o_rows = 0;
-    int e_rows = 0;
-    int o_stride = 0;
-    int e_stride = 0;
-    unsigned char *pix_odd = NULL;
-    unsigned char *pix_even = NULL;
-    int o_size;
-    int e_size;
-    unsigned int row;
-    int pix_size = 1;
-    int swap = 0;
-    if (little_endian != endianArch ())
-	swap = 1;
-    else
-	swap = 0;
-
-/* computing the required sizes */
-    for (row = 0; row < raster->height; row += 2)
-	o_rows++;
-    for (row = 1; row < raster->height; row += 2)
-	e_rows++;
-    switch (raster->sampleType)
-      {
-      case RL2_SAMPLE_INT8:
-      case RL2_SAMPLE_UINT8:
-	  pix_size = 1;
-	  break;
-      case RL2_SAMPLE_INT16:
-      case RL2_SAMPLE_UINT16:
-	  pix_size = 2;
-	  break;
-      case RL2_SAMPLE_INT32:
-      case RL2_SAMPLE_UINT32:
-      case RL2_SAMPLE_FLOAT:
-	  pix_size = 4;
-	  break;
-      case RL2_SAMPLE_DOUBLE:
-	  pix_size = 8;
-	  break;
-      };
-    o_size = raster->width * o_rows * pix_size * raster->nBands;
-    e_size = raster->width * e_rows * pix_size * raster->nBands;
-    o_stride = raster->width * pix_size * raster->nBands;
-    e_stride = o_stride;
-
-/* allocating the pixel buffers */
-    pix_odd = malloc (o_size);
-    if (pix_odd == NULL)
-	return 0;
-    pix_even = malloc (e_size);
-    if (pix_even == NULL)
-      {
-	  free (pix_odd);
-	  return 0;
-      }
-    memset (pix_odd, 0, o_size);
-    memset (pix_even, 0, e_size);
-
-/* feeding the pixel buffers */
-    switch (raster->sampleType)
-      {
-      case RL2_SAMPLE_INT8:
-	  feed_odd_even_int8 (raster->rasterBuffer, raster->width,
-			      raster->height, raster->nBands, pix_odd,
-			      pix_even);
-	  break;
-      case RL2_SAMPLE_UINT8:
-	  feed_odd_even_uint8 (raster->rasterBuffer, raster->width,
-			       raster->height, raster->nBands, pix_odd,
-			       pix_even);
-	  break;
-      case RL2_SAMPLE_INT16:
-	  feed_odd_even_int16 (raster->rasterBuffer, raster->width,
-			       raster->height, raster->nBands, pix_odd,
-			       pix_even, swap);
-	  break;
-      case RL2_SAMPLE_UINT16:
-	  feed_odd_even_uint16 (raster->rasterBuffer, raster->width,
-				raster->height, raster->nBands, pix_odd,
-				pix_even, swap);
-	  break;
-      case RL2_SAMPLE_INT32:
-	  feed_odd_even_int32 (raster->rasterBuffer, raster->width,
-			       raster->height, raster->nBands, pix_odd,
-			       pix_even, swap);
-	  break;
-      case RL2_SAMPLE_UINT32:
-	  feed_odd_even_uint32 (raster->rasterBuffer, raster->width,
-				raster->height, raster->nBands, pix_odd,
-				pix_even, swap);
-	  break;
-      case RL2_SAMPLE_FLOAT:
-	  feed_odd_even_float (raster->rasterBuffer, raster->width,
-			       raster->height, raster->nBands, pix_odd,
-			       pix_even, swap);
-	  break;
-      case RL2_SAMPLE_DOUBLE:
-	  feed_odd_even_double (raster->rasterBuffer, raster->width,
-				raster->height, raster->nBands, pix_odd,
-				pix_even, swap);
-	  break;
-      };
-    *odd_rows = o_rows;
-    *even_rows = e_rows;
-    *row_stride_odd = o_stride;
-    *row_stride_even = e_stride;
-    *pixels_odd = pix_odd;
-    *pixels_even = pix_even;
-    *size_odd = o_size;
-    *size_even = e_size;
-    return 1;
-}
-
-RL2_DECLARE int
-rl2_raster_encode (rl2RasterPtr rst, int compression,
-		   unsigned char **blob_odd, int *blob_odd_sz,
-		   unsigned char **blob_even, int *blob_even_sz, int quality,
-		   int little_endian)
-{
-/* encoding a Raster into the internal RL2 binary format */
-    rl2PrivRasterPtr raster = (rl2PrivRasterPtr) rst;
-    int odd_rows;
-    unsigned char *pixels_odd = NULL;
-    int size_odd;
-    int even_rows = 0;
-    unsigned char *pixels_even = NULL;
-    int size_even = 0;
-    int row_stride_odd = 0;
-    unsigned char *mask_pix = NULL;
-    int mask_pix_size = 0;
-    unsigned char *block_odd = NULL;
-    int block_odd_size = 0;
-    int row_stride_even = 0;
-    unsigned char *block_even = NULL;
-    int block_even_size = 0;
-    unsigned char *ptr;
-    int uncompressed = 0;
-    int compressed;
-    int uncompressed_mask = 0;
-    int compressed_mask = 0;
-    unsigned char *compr_data = NULL;
-    unsigned char *compr_mask = NULL;
-    unsigned char *to_clean1 = NULL;
-    unsigned char *to_clean2 = NULL;
-    unsigned char *save_mask = NULL;
-    uLong crc;
-    int endian_arch = endianArch ();
-    int delta_dist;
-    *blob_odd = NULL;
-    *blob_odd_sz = 0;
-    *blob_even = NULL;
-    *blob_even_sz = 0;
-
-    if (raster == NULL)
-	return RL2_ERROR;
-    if (!check_encode_self_consistency
-	(raster->sampleType, raster->pixelType, raster->nBands, compression))
-	return RL2_ERROR;
-
-    switch (raster->pixelType)
-      {
-      case RL2_PIXEL_RGB:
-	  switch (raster->sampleType)
+      case RL2_PIXEL_RGB:
+	  switch (raster->sampleType)
 	    {
 	    case RL2_SAMPLE_UINT16:
 		delta_dist = 6;
@@ -2122,31 +1784,22 @@ rl2_raster_encode (rl2RasterPtr rst, int compression,
 	|| compression == RL2_COMPRESSION_DEFLATE
 	|| compression == RL2_COMPRESSION_DEFLATE_NO
 	|| compression == RL2_COMPRESSION_LZMA
-	|| compression == RL2_COMPRESSION_LZMA_NO)
+	|| compression == RL2_COMPRESSION_LZMA_NO
+	|| compression == RL2_COMPRESSION_ZSTD
+	|| compression == RL2_COMPRESSION_ZSTD_NO
+	|| compression == RL2_COMPRESSION_LZ4
+	|| compression == RL2_COMPRESSION_LZ4_NO
+	|| compression == RL2_COMPRESSION_DEFLATE_FP
+	|| compression == RL2_COMPRESSION_LZMA_FP
+	|| compression == RL2_COMPRESSION_ZSTD_FP)
       {
 	  /* preparing the pixels buffers */
-	  if (raster->sampleType == RL2_SAMPLE_1_BIT)
-	    {
-		/* packing 1-BIT data */
-		if (!pack_1bit_rows
-		    (raster, raster->rasterBuffer, &row_stride_odd,
-		     &pixels_odd, &size_odd))
-		    return RL2_ERROR;
-		odd_rows = raster->height;
-	    }
-	  else if (raster->sampleType == RL2_SAMPLE_2_BIT)
-	    {
-		/* packing 2-BIT data */
-		if (!pack_2bit_rows
-		    (raster, &row_stride_odd, &pixels_odd, &size_odd))
-		    return RL2_ERROR;
-		odd_rows = raster->height;
-	    }
-	  else if (raster->sampleType == RL2_SAMPLE_4_BIT)
+	  if (packed_bits (raster->sampleType) > 0)
 	    {
-		/* packing 4-BIT data */
-		if (!pack_4bit_rows
-		    (raster, &row_stride_odd, &pixels_odd, &size_odd))
+		/* packing 1, 2 or 4-BIT data */
+		if (!pack_bit_rows
+		    (raster, packed_bits (raster->sampleType),
+		     &row_stride_odd, &pixels_odd, &size_odd))
 		    return RL2_ERROR;
 		odd_rows = raster->height;
 	    }
@@ -2424,6 +2077,117 @@ rl2_raster_encode (rl2RasterPtr rst, int compression,
 	  goto error;
 #endif /* end LZMA conditional */
       }
+    else if (compression == RL2_COMPRESSION_ZSTD
+	     || compression == RL2_COMPRESSION_ZSTD_NO)
+      {
+#ifndef OMIT_ZSTD		/* only if ZSTD is enabled */
+	  /* compressing as Zstandard (DeltaFilter or noDelta) */
+	  unsigned char *zstd_buf;
+	  int zstd_sz;
+	  if (compress_zstd
+	      (pixels_odd, size_odd,
+	       (compression == RL2_COMPRESSION_ZSTD) ? delta_dist : 0, quality,
+	       &zstd_buf, &zstd_sz) != RL2_OK)
+	      goto error;
+	  if (zstd_buf != NULL)
+	    {
+		/* ok, Zstandard compression was successful */
+		uncompressed = size_odd;
+		compressed = zstd_sz;
+		compr_data = zstd_buf;
+		to_clean1 = zstd_buf;
+	    }
+	  else
+	    {
+		/* Zstandard compression actually causes inflation: saving uncompressed data */
+		uncompressed = size_odd;
+		compressed = size_odd;
+		compr_data = pixels_odd;
+	    }
+	  if (mask_pix == NULL)
+	      uncompressed_mask = 0;
+	  else
+	      uncompressed_mask = raster->width * raster->height;
+	  compressed_mask = mask_pix_size;
+	  compr_mask = mask_pix;
+#else /* ZSTD is disabled */
+	  fprintf (stderr,
+		   "librasterlite2 was built by disabling Zstandard support\n");
+	  goto error;
+#endif /* end ZSTD conditional */
+      }
+    else if (compression == RL2_COMPRESSION_LZ4
+	     || compression == RL2_COMPRESSION_LZ4_NO)
+      {
+#ifndef OMIT_LZ4		/* only if LZ4 is enabled */
+	  /* compressing as LZ4 (ByteShuffle or noShuffle) */
+	  unsigned char *lz4_buf;
+	  int lz4_sz;
+	  if (compress_lz4
+	      (pixels_odd, size_odd,
+	       (compression == RL2_COMPRESSION_LZ4) ? delta_dist : 0,
+	       &lz4_buf, &lz4_sz) != RL2_OK)
+	      goto error;
+	  if (lz4_buf != NULL)
+	    {
+		/* ok, LZ4 compression was successful */
+		uncompressed = size_odd;
+		compressed = lz4_sz;
+		compr_data = lz4_buf;
+		to_clean1 = lz4_buf;
+	    }
+	  else
+	    {
+		/* LZ4 compression actually causes inflation: saving uncompressed data */
+		uncompressed = size_odd;
+		compressed = size_odd;
+		compr_data = pixels_odd;
+	    }
+	  if (mask_pix == NULL)
+	      uncompressed_mask = 0;
+	  else
+	      uncompressed_mask = raster->width * raster->height;
+	  compressed_mask = mask_pix_size;
+	  compr_mask = mask_pix;
+#else /* LZ4 is disabled */
+	  fprintf (stderr,
+		   "librasterlite2 was built by disabling LZ4 support\n");
+	  goto error;
+#endif /* end LZ4 conditional */
+      }
+    else if (compression == RL2_COMPRESSION_DEFLATE_FP
+	     || compression == RL2_COMPRESSION_LZMA_FP
+	     || compression == RL2_COMPRESSION_ZSTD_FP)
+      {
+	  /* compressing as FloatPredictor (Deflate, LZMA or Zstandard) */
+	  unsigned char *fp_buf;
+	  int fp_sz;
+	  if (compress_float_predictor
+	      (compression, pixels_odd, size_odd, delta_dist, little_endian,
+	       quality, &fp_buf, &fp_sz) != RL2_OK)
+	      goto error;
+	  if (fp_buf != NULL)
+	    {
+		/* ok, FloatPredictor compression was successful */
+		uncompressed = size_odd;
+		compressed = fp_sz;
+		compr_data = fp_buf;
+		to_clean1 = fp_buf;
+	    }
+	  else
+	    {
+		/* compression actually causes inflation: saving uncompressed data */
+		uncompressed = size_odd;
+		compressed = size_odd;
+		compr_data = pixels_odd;
+	    }
+	  if (mask_pix == NULL)
+	      uncompressed_mask = 0;
+	  else
+	      uncompressed_mask = raster->width * raster->height;
+	  compressed_mask = mask_pix_size;
+	  compr_mask = mask_pix;
+      }
     else if (compression == RL2_COMPRESSION_JPEG)
       {
 	  /* compressing as JPEG */
@@ -2650,7 +2414,7 @@ rl2_raster_encode (rl2RasterPtr rst, int compression,
 	goto error;
     ptr = block_odd;
     *ptr++ = 0x00;		/* start marker */
-    *ptr++ = RL2_ODD_BLOCK_START;	/* OddBlock marker */
+    *ptr++ = RL2_ODD_BLOCK_V2_START;	/* OddBlock marker - CRC32C */
     if (little_endian)		/* endian marker */
 	*ptr++ = RL2_LITTLE_ENDIAN;
     else
@@ -2686,8 +2450,8 @@ rl2_raster_encode (rl2RasterPtr rst, int compression,
 	  ptr += compressed_mask;
       }
     *ptr++ = RL2_MASK_END;
-/* computing the CRC32 */
-    crc = crc32 (0L, block_odd, ptr - block_odd);
+/* computing the CRC32C */
+    crc = rl2_crc32c (block_odd, ptr - block_odd);
     exportU32 (ptr, crc, little_endian, endian_arch);	/* the OddBlock own CRC */
     ptr += 4;
     *ptr = RL2_ODD_BLOCK_END;
@@ -2886,6 +2650,99 @@ rl2_raster_encode (rl2RasterPtr rst, int compression,
 		goto error;
 #endif /* end LZMA conditional */
 	    }
+	  else if (compression == RL2_COMPRESSION_ZSTD
+		   || compression == RL2_COMPRESSION_ZSTD_NO)
+	    {
+#ifndef OMIT_ZSTD		/* only if ZSTD is enabled */
+		/* compressing as Zstandard (DeltaFilter or noDelta) */
+		unsigned char *zstd_buf;
+		int zstd_sz;
+		if (compress_zstd
+		    (pixels_even, size_even,
+		     (compression == RL2_COMPRESSION_ZSTD) ? delta_dist : 0,
+		     quality, &zstd_buf, &zstd_sz) != RL2_OK)
+		    goto error;
+		if (zstd_buf != NULL)
+		  {
+		      /* ok, Zstandard compression was successful */
+		      uncompressed = size_even;
+		      compressed = zstd_sz;
+		      compr_data = zstd_buf;
+		      to_clean2 = zstd_buf;
+		  }
+		else
+		  {
+		      /* Zstandard compression actually causes inflation: saving uncompressed data */
+		      uncompressed = size_even;
+		      compressed = size_even;
+		      compr_data = pixels_even;
+		  }
+#else /* ZSTD is disabled */
+		fprintf (stderr,
+			 "librasterlite2 was built by disabling Zstandard support\n");
+		goto error;
+#endif /* end ZSTD conditional */
+	    }
+	  else if (compression == RL2_COMPRESSION_LZ4
+		   || compression == RL2_COMPRESSION_LZ4_NO)
+	    {
+#ifndef OMIT_LZ4		/* only if LZ4 is enabled */
+		/* compressing as LZ4 (ByteShuffle or noShuffle) */
+		unsigned char *lz4_buf;
+		int lz4_sz;
+		if (compress_lz4
+		    (pixels_even, size_even,
+		     (compression == RL2_COMPRESSION_LZ4) ? delta_dist : 0,
+		     &lz4_buf, &lz4_sz) != RL2_OK)
+		    goto error;
+		if (lz4_buf != NULL)
+		  {
+		      /* ok, LZ4 compression was successful */
+		      uncompressed = size_even;
+		      compressed = lz4_sz;
+		      compr_data = lz4_buf;
+		      to_clean2 = lz4_buf;
+		  }
+		else
+		  {
+		      /* LZ4 compression actually causes inflation: saving uncompressed data */
+		      uncompressed = size_even;
+		      compressed = size_even;
+		      compr_data = pixels_even;
+		  }
+#else /* LZ4 is disabled */
+		fprintf (stderr,
+			 "librasterlite2 was built by disabling LZ4 support\n");
+		goto error;
+#endif /* end LZ4 conditional */
+	    }
+	  else if (compression == RL2_COMPRESSION_DEFLATE_FP
+		   || compression == RL2_COMPRESSION_LZMA_FP
+		   || compression == RL2_COMPRESSION_ZSTD_FP)
+	    {
+		/* compressing as FloatPredictor (Deflate, LZMA or Zstandard) */
+		unsigned char *fp_buf;
+		int fp_sz;
+		if (compress_float_predictor
+		    (compression, pixels_even, size_even, delta_dist,
+		     little_endian, quality, &fp_buf, &fp_sz) != RL2_OK)
+		    goto error;
+		if (fp_buf != NULL)
+		  {
+		      /* ok, FloatPredictor compression was successful */
+		      uncompressed = size_even;
+		      compressed = fp_sz;
+		      compr_data = fp_buf;
+		      to_clean2 = fp_buf;
+		  }
+		else
+		  {
+		      /* compression actually causes inflation: saving uncompressed data */
+		      uncompressed = size_even;
+		      compressed = size_even;
+		      compr_data = pixels_even;
+		  }
+	    }
 	  else if (compression == RL2_COMPRESSION_PNG)
 	    {
 		/* compressing as PNG */
@@ -2937,7 +2794,7 @@ rl2_raster_encode (rl2RasterPtr rst, int compression,
 	      goto error;
 	  ptr = block_even;
 	  *ptr++ = 0x00;	/* start marker */
-	  *ptr++ = RL2_EVEN_BLOCK_START;	/* EvenBlock marker */
+	  *ptr++ = RL2_EVEN_BLOCK_V2_START;	/* EvenBlock marker - CRC32C */
 	  if (little_endian)	/* endian marker */
 	      *ptr++ = RL2_LITTLE_ENDIAN;
 	  else
@@ -2962,8 +2819,8 @@ rl2_raster_encode (rl2RasterPtr rst, int compression,
 	  memcpy (ptr, compr_data, compressed);	/* the payload */
 	  ptr += compressed;
 	  *ptr++ = RL2_DATA_END;
-	  /* computing the CRC32 */
-	  crc = crc32 (0L, block_even, ptr - block_even);
+	  /* computing the CRC32C */
+	  crc = rl2_crc32c (block_even, ptr - block_even);
 	  exportU32 (ptr, crc, little_endian, endian_arch);	/* the EvenBlock own CRC */
 	  ptr += 4;
 	  *ptr = RL2_EVEN_BLOCK_END;
@@ -3006,6 +2863,15 @@ rl2_raster_encode (rl2RasterPtr rst, int compression,
     return RL2_ERROR;
 }
 
+static uLong
+tile_checksum (const unsigned char *blob, int size, int crc32c)
+{
+/* computing the checksum of an Odd/Even block */
+    if (crc32c)
+	return rl2_crc32c (blob, size);	/* current format */
+    return crc32 (0L, blob, size);	/* legacy format */
+}
+
 RL2_DECLARE int
 rl2_query_dbms_raster_tile (const unsigned char *blob, int blob_sz,
 			    unsigned int *tile_width,
@@ -3025,6 +2891,7 @@ rl2_query_dbms_raster_tile (const unsigned char *blob, int blob_sz,
     unsigned char bands;
     unsigned char cpr;
     int odd_tile;
+    int crc32c = 0;
     int mask_flag;
     int compressed;
     int compressed_mask;
@@ -3049,12 +2916,14 @@ rl2_query_dbms_raster_tile (const unsigned char *blob, int blob_sz,
     ptr = blob;
     if (*ptr++ != 0x00)
 	return RL2_ERROR;	/* invalid start signature */
-    if (*ptr == RL2_ODD_BLOCK_START)
+    if (*ptr == RL2_ODD_BLOCK_START || *ptr == RL2_ODD_BLOCK_V2_START)
 	odd_tile = 1;
-    else if (*ptr == RL2_EVEN_BLOCK_START)
+    else if (*ptr == RL2_EVEN_BLOCK_START || *ptr == RL2_EVEN_BLOCK_V2_START)
 	odd_tile = 0;
     else
 	return RL2_ERROR;	/* invalid start signature */
+    if (*ptr == RL2_ODD_BLOCK_V2_START || *ptr == RL2_EVEN_BLOCK_V2_START)
+	crc32c = 1;
     ptr++;
 
     if (odd_tile)
@@ -3073,6 +2942,13 @@ rl2_query_dbms_raster_tile (const unsigned char *blob, int blob_sz,
 	    case RL2_COMPRESSION_DEFLATE_NO:
 	    case RL2_COMPRESSION_LZMA:
 	    case RL2_COMPRESSION_LZMA_NO:
+	    case RL2_COMPRESSION_ZSTD:
+	    case RL2_COMPRESSION_ZSTD_NO:
+	    case RL2_COMPRESSION_LZ4:
+	    case RL2_COMPRESSION_LZ4_NO:
+	    case RL2_COMPRESSION_DEFLATE_FP:
+	    case RL2_COMPRESSION_LZMA_FP:
+	    case RL2_COMPRESSION_ZSTD_FP:
 	    case RL2_COMPRESSION_PNG:
 	    case RL2_COMPRESSION_JPEG:
 	    case RL2_COMPRESSION_LOSSY_WEBP:
@@ -3142,8 +3018,8 @@ rl2_query_dbms_raster_tile (const unsigned char *blob, int blob_sz,
 	  ptr += compressed_mask;
 	  if (*ptr++ != RL2_MASK_END)
 	      return RL2_ERROR;
-	  /* computing the CRC32 */
-	  crc = crc32 (0L, blob, ptr - blob);
+	  /* computing the checksum */
+	  crc = tile_checksum (blob, ptr - blob, crc32c);
 	  oldCrc = importU32 (ptr, endian, endian_arch);
 	  ptr += 4;
 	  if (crc != oldCrc)
@@ -3168,6 +3044,13 @@ rl2_query_dbms_raster_tile (const unsigned char *blob, int blob_sz,
 	    case RL2_COMPRESSION_DEFLATE_NO:
 	    case RL2_COMPRESSION_LZMA:
 	    case RL2_COMPRESSION_LZMA_NO:
+	    case RL2_COMPRESSION_ZSTD:
+	    case RL2_COMPRESSION_ZSTD_NO:
+	    case RL2_COMPRESSION_LZ4:
+	    case RL2_COMPRESSION_LZ4_NO:
+	    case RL2_COMPRESSION_DEFLATE_FP:
+	    case RL2_COMPRESSION_LZMA_FP:
+	    case RL2_COMPRESSION_ZSTD_FP:
 	    case RL2_COMPRESSION_PNG:
 	    case RL2_COMPRESSION_JPEG:
 	    case RL2_COMPRESSION_LOSSY_WEBP:
@@ -3229,8 +3112,8 @@ rl2_query_dbms_raster_tile (const unsigned char *blob, int blob_sz,
 	  ptr += compressed;
 	  if (*ptr++ != RL2_DATA_END)
 	      return RL2_ERROR;
-	  /* computing the CRC32 */
-	  crc = crc32 (0L, blob, ptr - blob);
+	  /* computing the checksum */
+	  crc = tile_checksum (blob, ptr - blob, crc32c);
 	  oldCrc = importU32 (ptr, endian, endian_arch);
 	  ptr += 4;
 	  if (crc != oldCrc)
@@ -3254,9 +3137,13 @@ static int
 check_blob_odd (const unsigned char *blob, int blob_sz, unsigned int *xwidth,
 		unsigned int *xheight, unsigned char *xsample_type,
 		unsigned char *xpixel_type, unsigned char *xnum_bands,
-		unsigned char *xcompression, uLong * xcrc)
+		unsigned char *xcompression, uLong * xcrc, int verify)
 {
-/* checking the OddBlock for validity */
+/* 
+/ checking the OddBlock for validity
+/ the checksum is only recomputed when "verify" is set; otherwise
+/ the stored one is simply returned for linking the EvenBlock
+*/
     const unsigned char *ptr;
     unsigned short width;
     unsigned short height;
@@ -3269,6 +3156,7 @@ check_blob_odd (const unsigned char *blob, int blob_sz, unsigned int *xwidth,
     uLong crc;
     uLong oldCrc;
     int endian;
+    int crc32c;
     int endian_arch = endianArch ();
 
     if (blob_sz < 41)
@@ -3276,8 +3164,13 @@ check_blob_odd (const unsigned char *blob, int blob_sz, unsigned int *xwidth,
     ptr = blob;
     if (*ptr++ != 0x00)
 	return 0;		/* invalid start signature */
-    if (*ptr++ != RL2_ODD_BLOCK_START)
+    if (*ptr == RL2_ODD_BLOCK_V2_START)
+	crc32c = 1;
+    else if (*ptr == RL2_ODD_BLOCK_START)
+	crc32c = 0;
+    else
 	return 0;		/* invalid start signature */
+    ptr++;
     endian = *ptr++;
     if (endian == RL2_LITTLE_ENDIAN || endian == RL2_BIG_ENDIAN)
 	;
@@ -3291,6 +3184,13 @@ check_blob_odd (const unsigned char *blob, int blob_sz, unsigned int *xwidth,
       case RL2_COMPRESSION_DEFLATE_NO:
       case RL2_COMPRESSION_LZMA:
       case RL2_COMPRESSION_LZMA_NO:
+      case RL2_COMPRESSION_ZSTD:
+      case RL2_COMPRESSION_ZSTD_NO:
+      case RL2_COMPRESSION_LZ4:
+      case RL2_COMPRESSION_LZ4_NO:
+      case RL2_COMPRESSION_DEFLATE_FP:
+      case RL2_COMPRESSION_LZMA_FP:
+      case RL2_COMPRESSION_ZSTD_FP:
       case RL2_COMPRESSION_PNG:
       case RL2_COMPRESSION_JPEG:
       case RL2_COMPRESSION_LOSSY_WEBP:
@@ -3358,12 +3258,15 @@ check_blob_odd (const unsigned char *blob, int blob_sz, unsigned int *xwidth,
     ptr += compressed_mask;
     if (*ptr++ != RL2_MASK_END)
 	return 0;
-/* computing the CRC32 */
-    crc = crc32 (0L, blob, ptr - blob);
     oldCrc = importU32 (ptr, endian, endian_arch);
-    ptr += 4;
-    if (crc != oldCrc)
-	return 0;
+    if (verify)
+      {
+	  /* computing the checksum */
+	  crc = tile_checksum (blob, ptr - blob, crc32c);
+	  if (crc != oldCrc)
+	      return 0;
+      }
+    ptr += 4;
     if (*ptr != RL2_ODD_BLOCK_END)
 	return 0;		/* invalid end signature */
 
@@ -3373,7 +3276,7 @@ check_blob_odd (const unsigned char *blob, int blob_sz, unsigned int *xwidth,
     *xpixel_type = pixel_type;
     *xnum_bands = num_bands;
     *xcompression = compression;
-    *xcrc = crc;
+    *xcrc = oldCrc;
     return 1;
 }
 
@@ -3382,7 +3285,7 @@ check_blob_even (const unsigned char *blob, int blob_sz,
 		 unsigned short xwidth, unsigned short xheight,
 		 unsigned char xsample_type, unsigned char xpixel_type,
 		 unsigned char xnum_bands, unsigned char xcompression,
-		 uLong xcrc)
+		 uLong xcrc, int verify)
 {
 /* checking the EvenBlock for validity */
     const unsigned char *ptr;
@@ -3396,6 +3299,7 @@ check_blob_even (const unsigned char *blob, int blob_sz,
     uLong crc;
     uLong oldCrc;
     int endian;
+    int crc32c;
     int endian_arch = endianArch ();
 
     if (blob_sz < 33)
@@ -3403,8 +3307,13 @@ check_blob_even (const unsigned char *blob, int blob_sz,
     ptr = blob;
     if (*ptr++ != 0x00)
 	return 0;		/* invalid start signature */
-    if (*ptr++ != RL2_EVEN_BLOCK_START)
+    if (*ptr == RL2_EVEN_BLOCK_V2_START)
+	crc32c = 1;
+    else if (*ptr == RL2_EVEN_BLOCK_START)
+	crc32c = 0;
+    else
 	return 0;		/* invalid start signature */
+    ptr++;
     endian = *ptr++;
     if (endian == RL2_LITTLE_ENDIAN || endian == RL2_BIG_ENDIAN)
 	;
@@ -3445,12 +3354,15 @@ check_blob_even (const unsigned char *blob, int blob_sz,
     ptr += compressed;
     if (*ptr++ != RL2_DATA_END)
 	return 0;
-/* computing the CRC32 */
-    crc = crc32 (0L, blob, ptr - blob);
-    oldCrc = importU32 (ptr, endian, endian_arch);
+    if (verify)
+      {
+	  /* computing the checksum */
+	  crc = tile_checksum (blob, ptr - blob, crc32c);
+	  oldCrc = importU32 (ptr, endian, endian_arch);
+	  if (crc != oldCrc)
+	      return 0;
+      }
     ptr += 4;
-    if (crc != oldCrc)
-	return 0;
     if (*ptr != RL2_EVEN_BLOCK_END)
 	return 0;		/* invalid end signature */
     return 1;
@@ -3526,1062 +3438,74 @@ check_scale2 (int scale, unsigned char sample_type)
     return 1;
 }
 
-static void
-do_copy2_int8 (const char *p_odd, char *buf, unsigned int width,
-	       unsigned int odd_rows)
-{
-/* reassembling an INT8 raster - scale 1:2 */
-    unsigned int row;
-    unsigned int col;
-    char *p_out;
-
-    p_out = buf;
-    for (row = 0; row < odd_rows; row++)
-      {
-	  for (col = 0; col < width; col += 2)
-	      *p_out++ = *p_odd++;
-	  p_odd++;
-      }
-}
-
-static void
-do_copy2_uint8 (const unsigned char *p_odd, unsigned char *buf,
-		unsigned int width, unsigned int odd_rows,
-		unsigned char num_bands)
-{
-/* reassembling a UINT8 raster - scale 1:2 */
-    unsigned int row;
-    unsigned int col;
-    int band;
-    unsigned char *p_out;
-
-    p_out = buf;
-    for (row = 0; row < odd_rows; row++)
-      {
-	  for (col = 0; col < width; col += 2)
-	    {
-		for (band = 0; band < num_bands; band++)
-		    *p_out++ = *p_odd++;
-		p_odd += num_bands;
-	    }
-      }
-}
-
-static void
-do_copy2_int16 (int swap, const short *p_odd, short *buf, unsigned int width,
-		unsigned int odd_rows)
-{
-/* reassembling an INT16 raster - scale 1:2 */
-    unsigned int row;
-    unsigned int col;
-    short *p_out;
-
-    p_out = buf;
-    for (row = 0; row < odd_rows; row++)
-      {
-	  for (col = 0; col < width; col += 2)
-	    {
-		if (swap)
-		    *p_out++ = swapINT16 (*p_odd++);
-		else
-		    *p_out++ = *p_odd++;
-		p_odd++;
-	    }
-      }
-}
-
-static void
-do_copy2_uint16 (int swap, const unsigned short *p_odd, unsigned short *buf,
-		 unsigned int width, unsigned int odd_rows,
-		 unsigned char num_bands)
-{
-/* reassembling a UINT16 raster - scale 1:2 */
-    unsigned int row;
-    unsigned int col;
-    int band;
-    unsigned short *p_out;
-
-    p_out = buf;
-    for (row = 0; row < odd_rows; row++)
-      {
-	  for (col = 0; col < width; col += 2)
-	    {
-		for (band = 0; band < num_bands; band++)
-		  {
-		      if (swap)
-			  *p_out++ = swapUINT16 (*p_odd++);
-		      else
-			  *p_out++ = *p_odd++;
-		  }
-		p_odd += num_bands;
-	    }
-      }
-}
-
-static void
-do_copy2_int32 (int swap, const int *p_odd, int *buf, unsigned int width,
-		unsigned int odd_rows)
-{
-/* reassembling an INT32 raster - scale 1:2 */
-    unsigned int row;
-    unsigned int col;
-    int *p_out;
-
-    p_out = buf;
-    for (row = 0; row < odd_rows; row++)
-      {
-	  for (col = 0; col < width; col += 2)
-	    {
-		if (swap)
-		    *p_out++ = swapINT32 (*p_odd++);
-		else
-		    *p_out++ = *p_odd++;
-		p_odd++;
-	    }
-      }
-}
-
-static void
-do_copy2_uint32 (int swap, const unsigned int *p_odd, unsigned int *buf,
-		 unsigned int width, unsigned int odd_rows)
-{
-/* reassembling an UINT32 raster - scale 1:2 */
-    unsigned int row;
-    unsigned int col;
-    unsigned int *p_out;
-
-    p_out = buf;
-    for (row = 0; row < odd_rows; row++)
-      {
-	  for (col = 0; col < width; col += 2)
-	    {
-		if (swap)
-		    *p_out++ = swapUINT32 (*p_odd++);
-		else
-		    *p_out++ = *p_odd++;
-		p_odd++;
-	    }
-      }
-}
-
-static void
-do_copy2_float (int swap, const float *p_odd, float *buf, unsigned int width,
-		unsigned int odd_rows)
-{
-/* reassembling a FLOAT raster - scale 1:2 */
-    unsigned int row;
-    unsigned int col;
-    float *p_out;
-
-    p_out = buf;
-    for (row = 0; row < odd_rows; row++)
-      {
-	  for (col = 0; col < width; col += 2)
-	    {
-		if (swap)
-		    *p_out++ = swapFloat (*p_odd++);
-		else
-		    *p_out++ = *p_odd++;
-		p_odd++;
-	    }
-      }
-}
-
-static void
-do_copy2_double (int swap, const double *p_odd, double *buf,
-		 unsigned int width, unsigned int odd_rows)
-{
-/* reassembling a FLOAT raster - scale 1:2 */
-    unsigned int row;
-    unsigned int col;
-    double *p_out;
-
-    p_out = buf;
-    for (row = 0; row < odd_rows; row++)
-      {
-	  for (col = 0; col < width; col += 2)
-	    {
-		if (swap)
-		    *p_out++ = swapDouble (*p_odd++);
-		else
-		    *p_out++ = *p_odd++;
-		p_odd++;
-	    }
-      }
-}
-
-static int
-build_pixel_buffer_2 (int swap, unsigned int *xwidth, unsigned int *xheight,
-		      unsigned char sample_type, unsigned char pixel_size,
-		      unsigned char num_bands, unsigned short odd_rows,
-		      const void *pixels_odd, void **pixels, int *pixels_sz)
+static unsigned char
+decode_pixel_size (unsigned char sample_type)
 {
-/* decoding the raster - scale 1:2 */
-    unsigned int width = 0;
-    unsigned int height = 0;
-    unsigned int row;
-    unsigned int col;
-    void *buf;
-    int buf_size;
-
-    for (row = 0; row < *xheight; row += 2)
-	height++;
-    for (col = 0; col < *xwidth; col += 2)
-	width++;
-
-    buf_size = width * height * pixel_size * num_bands;
-    buf = malloc (buf_size);
-    if (buf == NULL)
-	return 0;
-
+/* returning the size (in bytes) of a decoded sample */
     switch (sample_type)
       {
-      case RL2_SAMPLE_INT8:
-	  do_copy2_int8 (pixels_odd, buf, *xwidth, odd_rows);
-	  break;
-      case RL2_SAMPLE_UINT8:
-	  do_copy2_uint8 (pixels_odd, buf, *xwidth, odd_rows, num_bands);
-	  break;
       case RL2_SAMPLE_INT16:
-	  do_copy2_int16 (swap, pixels_odd, buf, *xwidth, odd_rows);
-	  break;
       case RL2_SAMPLE_UINT16:
-	  do_copy2_uint16 (swap, pixels_odd, buf, *xwidth, odd_rows, num_bands);
-	  break;
+	  return 2;
       case RL2_SAMPLE_INT32:
-	  do_copy2_int32 (swap, pixels_odd, buf, *xwidth, odd_rows);
-	  break;
       case RL2_SAMPLE_UINT32:
-	  do_copy2_uint32 (swap, pixels_odd, buf, *xwidth, odd_rows);
-	  break;
       case RL2_SAMPLE_FLOAT:
-	  do_copy2_float (swap, pixels_odd, buf, *xwidth, odd_rows);
-	  break;
+	  return 4;
       case RL2_SAMPLE_DOUBLE:
-	  do_copy2_double (swap, pixels_odd, buf, *xwidth, odd_rows);
-	  break;
+	  return 8;
       };
-
-    *xwidth = width;
-    *xheight = height;
-    *pixels = buf;
-    *pixels_sz = buf_size;
     return 1;
 }
 
-static void
-do_copy4_int8 (const char *p_odd, char *buf, unsigned int width,
-	       unsigned int odd_rows)
-{
-/* reassembling an INT8 raster - scale 1:4 */
-    unsigned int row;
-    unsigned int col;
-    char *p_out;
-
-    p_out = buf;
-    for (row = 0; row < odd_rows; row += 2)
-      {
-	  for (col = 0; col < width; col += 4)
-	    {
-		*p_out++ = *p_odd++;
-		p_odd += 3;
-	    }
-	  p_odd += width;
-      }
-}
-
-static void
-do_copy4_uint8 (const unsigned char *p_odd, unsigned char *buf,
-		unsigned int width, unsigned int odd_rows,
-		unsigned char num_bands)
+static int
+build_pixel_buffer_scaled (int swap, int step, unsigned int *xwidth,
+			   unsigned int *xheight, unsigned char pixel_size,
+			   unsigned char num_bands, unsigned short odd_rows,
+			   const void *pixels_odd, void **pixels,
+			   int *pixels_sz)
 {
-/* reassembling a UINT8 raster - scale 1:4 */
+/* decoding the raster - scale 1:2, 1:4 or 1:8 */
+    unsigned int width = 0;
+    unsigned int height = 0;
     unsigned int row;
     unsigned int col;
-    int band;
+    unsigned int in_row_bytes;
+    unsigned int out_row_bytes;
+    unsigned int odd_step = step / 2;
+    const unsigned char *p_odd = pixels_odd;
     unsigned char *p_out;
+    void *buf;
+    int buf_size;
 
-    p_out = buf;
-    for (row = 0; row < odd_rows; row += 2)
-      {
-	  for (col = 0; col < width; col += 4)
-	    {
-		for (band = 0; band < num_bands; band++)
-		    *p_out++ = *p_odd++;
-		p_odd += num_bands * 3;
-	    }
-	  p_odd += width * num_bands;
-      }
-}
-
-static void
-do_copy4_int16 (int swap, const short *p_odd, short *buf, unsigned int width,
-		unsigned int odd_rows)
-{
-/* reassembling an INT16 raster - scale 1:4 */
-    unsigned int row;
-    unsigned int col;
-    short *p_out;
-
-    p_out = buf;
-    for (row = 0; row < odd_rows; row += 2)
-      {
-	  for (col = 0; col < width; col += 4)
-	    {
-		if (swap)
-		    *p_out++ = swapINT16 (*p_odd++);
-		else
-		    *p_out++ = *p_odd++;
-		p_odd += 3;
-	    }
-	  p_odd += width;
-      }
-}
-
-static void
-do_copy4_uint16 (int swap, const unsigned short *p_odd, unsigned short *buf,
-		 unsigned int width, unsigned int odd_rows,
-		 unsigned char num_bands)
-{
-/* reassembling a UINT16 raster - scale 1:4 */
-    unsigned int row;
-    unsigned int col;
-    int band;
-    unsigned short *p_out;
-
-    p_out = buf;
-    for (row = 0; row < odd_rows; row += 2)
-      {
-	  for (col = 0; col < width; col += 4)
-	    {
-		for (band = 0; band < num_bands; band++)
-		  {
-		      if (swap)
-			  *p_out++ = swapUINT16 (*p_odd++);
-		      else
-			  *p_out++ = *p_odd++;
-		  }
-		p_odd += num_bands * 3;
-	    }
-	  p_odd += width * num_bands;
-      }
-}
-
-static void
-do_copy4_int32 (int swap, const int *p_odd, int *buf, unsigned int width,
-		unsigned int odd_rows)
-{
-/* reassembling an INT32 raster - scale 1:4 */
-    unsigned int row;
-    unsigned int col;
-    int *p_out;
-
-    p_out = buf;
-    for (row = 0; row < odd_rows; row += 2)
-      {
-	  for (col = 0; col < width; col += 4)
-	    {
-		if (swap)
-		    *p_out++ = swapINT32 (*p_odd++);
-		else
-		    *p_out++ = *p_odd++;
-		p_odd += 3;
-	    }
-	  p_odd += width;
-      }
-}
-
-static void
-do_copy4_uint32 (int swap, const unsigned int *p_odd, unsigned int *buf,
-		 unsigned int width, unsigned int odd_rows)
-{
-/* reassembling an UINT32 raster - scale 1:4 */
-    unsigned int row;
-    unsigned int col;
-    unsigned int *p_out;
-
-    p_out = buf;
-    for (row = 0; row < odd_rows; row += 2)
-      {
-	  for (col = 0; col < width; col += 4)
-	    {
-		if (swap)
-		    *p_out++ = swapUINT32 (*p_odd++);
-		else
-		    *p_out++ = *p_odd++;
-		p_odd += 3;
-	    }
-	  p_odd += width;
-      }
-}
-
-static void
-do_copy4_float (int swap, const float *p_odd, float *buf, unsigned int width,
-		unsigned int odd_rows)
-{
-/* reassembling a FLOAT raster - scale 1:4 */
-    unsigned int row;
-    unsigned int col;
-    float *p_out;
-
-    p_out = buf;
-    for (row = 0; row < odd_rows; row += 2)
-      {
-	  for (col = 0; col < width; col += 4)
-	    {
-		if (swap)
-		    *p_out++ = swapFloat (*p_odd++);
-		else
-		    *p_out++ = *p_odd++;
-		p_odd += 3;
-	    }
-	  p_odd += width;
-      }
-}
-
-static void
-do_copy4_double (int swap, const double *p_odd, double *buf,
-		 unsigned int width, unsigned int odd_rows)
-{
-/* reassembling a DOUBLE raster - scale 1:4 */
-    unsigned int row;
-    unsigned int col;
-    double *p_out;
-
-    p_out = buf;
-    for (row = 0; row < odd_rows; row += 2)
-      {
-	  for (col = 0; col < width; col += 4)
-	    {
-		if (swap)
-		    *p_out++ = swapDouble (*p_odd++);
-		else
-		    *p_out++ = *p_odd++;
-		p_odd += 3;
-	    }
-	  p_odd += width;
-      }
-}
-
-static int
-build_pixel_buffer_4 (int swap, unsigned int *xwidth, unsigned int *xheight,
-		      unsigned char sample_type, unsigned char pixel_size,
-		      unsigned char num_bands, unsigned int odd_rows,
-		      const void *pixels_odd, void **pixels, int *pixels_sz)
-{
-/* decoding the raster - scale 1:4 */
-    unsigned short width = 0;
-    unsigned short height = 0;
-    unsigned int row;
-    unsigned int col;
-    void *buf;
-    int buf_size;
-
-    for (row = 0; row < *xheight; row += 4)
-	height++;
-    for (col = 0; col < *xwidth; col += 4)
-	width++;
+    for (row = 0; row < *xheight; row += step)
+	height++;
+    for (col = 0; col < *xwidth; col += step)
+	width++;
 
     buf_size = width * height * pixel_size * num_bands;
     buf = malloc (buf_size);
-    if (buf == NULL)
-	return 0;
-
-    switch (sample_type)
-      {
-      case RL2_SAMPLE_INT8:
-	  do_copy4_int8 (pixels_odd, buf, *xwidth, odd_rows);
-	  break;
-      case RL2_SAMPLE_UINT8:
-	  do_copy4_uint8 (pixels_odd, buf, *xwidth, odd_rows, num_bands);
-	  break;
-      case RL2_SAMPLE_INT16:
-	  do_copy4_int16 (swap, pixels_odd, buf, *xwidth, odd_rows);
-	  break;
-      case RL2_SAMPLE_UINT16:
-	  do_copy4_uint16 (swap, pixels_odd, buf, *xwidth, odd_rows, num_bands);
-	  break;
-      case RL2_SAMPLE_INT32:
-	  do_copy4_int32 (swap, pixels_odd, buf, *xwidth, odd_rows);
-	  break;
-      case RL2_SAMPLE_UINT32:
-	  do_copy4_uint32 (swap, pixels_odd, buf, *xwidth, odd_rows);
-	  break;
-      case RL2_SAMPLE_FLOAT:
-	  do_copy4_float (swap, pixels_odd, buf, *xwidth, odd_rows);
-	  break;
-      case RL2_SAMPLE_DOUBLE:
-	  do_copy4_double (swap, pixels_odd, buf, *xwidth, odd_rows);
-	  break;
-      };
-
-    *xwidth = width;
-    *xheight = height;
-    *pixels = buf;
-    *pixels_sz = buf_size;
-    return 1;
-}
-
-static void
-do_copy8_int8 (const char *p_odd, char *buf, unsigned int width,
-	       unsigned int odd_rows)
-{
-/* reassembling an INT8 raster - scale 1:8 */
-    unsigned int row;
-    unsigned int col;
-    char *p_out;
-
-    p_out = buf;
-    for (row = 0; row < odd_rows; row += 4)
-      {
-	  for (col = 0; col < width; col += 8)
-	    {
-		*p_out++ = *p_odd++;
-		p_odd += 7;
-	    }
-	  p_odd += 3 * width;
-      }
-}
-
-static void
-do_copy8_uint8 (const unsigned char *p_odd, unsigned char *buf,
-		unsigned int width, unsigned int odd_rows,
-		unsigned char num_bands)
-{
-/* reassembling a UINT8 raster - scale 1:8 */
-    unsigned int row;
-    unsigned int col;
-    int band;
-    unsigned char *p_out;
-
-    p_out = buf;
-    for (row = 0; row < odd_rows; row += 4)
-      {
-	  for (col = 0; col < width; col += 8)
-	    {
-		for (band = 0; band < num_bands; band++)
-		    *p_out++ = *p_odd++;
-		p_odd += num_bands * 7;
-	    }
-	  p_odd += 3 * width * num_bands;
-      }
-}
-
-static void
-do_copy8_int16 (int swap, const short *p_odd, short *buf, unsigned int width,
-		unsigned int odd_rows)
-{
-/* reassembling an INT16 raster - scale 1:8 */
-    unsigned int row;
-    unsigned int col;
-    short *p_out;
-
-    p_out = buf;
-    for (row = 0; row < odd_rows; row += 4)
-      {
-	  for (col = 0; col < width; col += 8)
-	    {
-		if (swap)
-		    *p_out++ = swapINT16 (*p_odd++);
-		else
-		    *p_out++ = *p_odd++;
-		p_odd += 7;
-	    }
-	  p_odd += 3 * width;
-      }
-}
-
-static void
-do_copy8_uint16 (int swap, const unsigned short *p_odd, unsigned short *buf,
-		 unsigned int width, unsigned int odd_rows,
-		 unsigned char num_bands)
-{
-/* reassembling a UINT16 raster - scale 1:8 */
-    unsigned int row;
-    unsigned int col;
-    int band;
-    unsigned short *p_out;
-
-    p_out = buf;
-    for (row = 0; row < odd_rows; row += 4)
-      {
-	  for (col = 0; col < width; col += 8)
-	    {
-		for (band = 0; band < num_bands; band++)
-		  {
-		      if (swap)
-			  *p_out++ = swapUINT16 (*p_odd++);
-		      else
-			  *p_out++ = *p_odd++;
-		  }
-		p_odd += num_bands * 7;
-	    }
-	  p_odd += 3 * width * num_bands;
-      }
-}
-
-static void
-do_copy8_int32 (int swap, const int *p_odd, int *buf, unsigned int width,
-		unsigned int odd_rows)
-{
-/* reassembling an INT32 raster - scale 1:8 */
-    unsigned int row;
-    unsigned int col;
-    int *p_out;
-
-    p_out = buf;
-    for (row = 0; row < odd_rows; row += 4)
-      {
-	  for (col = 0; col < width; col += 8)
-	    {
-		if (swap)
-		    *p_out++ = swapINT32 (*p_odd++);
-		else
-		    *p_out++ = *p_odd++;
-		p_odd += 7;
-	    }
-	  p_odd += 3 * width;
-      }
-}
-
-static void
-do_copy8_uint32 (int swap, const unsigned int *p_odd, unsigned int *buf,
-		 unsigned short width, unsigned short odd_rows)
-{
-/* reassembling an UINT32 raster - scale 1:8 */
-    int row;
-    int col;
-    unsigned int *p_out;
-
-    p_out = buf;
-    for (row = 0; row < odd_rows; row += 4)
-      {
-	  for (col = 0; col < width; col += 8)
-	    {
-		if (swap)
-		    *p_out++ = swapUINT32 (*p_odd++);
-		else
-		    *p_out++ = *p_odd++;
-		p_odd += 7;
-	    }
-	  p_odd += 3 * width;
-      }
-}
-
-static void
-do_copy8_float (int swap, const float *p_odd, float *buf, unsigned int width,
-		unsigned int odd_rows)
-{
-/* reassembling a FLOAT raster - scale 1:8 */
-    unsigned int row;
-    unsigned int col;
-    float *p_out;
-
-    p_out = buf;
-    for (row = 0; row < odd_rows; row += 4)
-      {
-	  for (col = 0; col < width; col += 8)
-	    {
-		if (swap)
-		    *p_out++ = swapFloat (*p_odd++);
-		else
-		    *p_out++ = *p_odd++;
-		p_odd += 7;
-	    }
-	  p_odd += 3 * width;
-      }
-}
-
-static void
-do_copy8_double (int swap, const double *p_odd, double *buf,
-		 unsigned int width, unsigned int odd_rows)
-{
-/* reassembling a DOUBLE raster - scale 1:8 */
-    unsigned int row;
-    unsigned int col;
-    double *p_out;
-
-    p_out = buf;
-    for (row = 0; row < odd_rows; row += 4)
-      {
-	  for (col = 0; col < width; col += 8)
-	    {
-		if (swap)
-		    *p_out++ = swapDouble (*p_odd++);
-		else
-		    *p_out++ = *p_odd++;
-		p_odd += 7;
-	    }
-	  p_odd += 3 * width;
-      }
-}
-
-static int
-build_pixel_buffer_8 (int swap, unsigned int *xwidth, unsigned int *xheight,
-		      unsigned char sample_type, unsigned char pixel_size,
-		      unsigned char num_bands, unsigned short odd_rows,
-		      const void *pixels_odd, void **pixels, int *pixels_sz)
-{
-/* decoding the raster - scale 1:8 */
-    unsigned int width = 0;
-    unsigned int height = 0;
-    unsigned int row;
-    unsigned int col;
-    void *buf;
-    int buf_size;
-
-    for (row = 0; row < *xheight; row += 8)
-	height++;
-    for (col = 0; col < *xwidth; col += 8)
-	width++;
-
-    buf_size = width * height * pixel_size * num_bands;
-    buf = malloc (buf_size);
-    if (buf == NULL)
-	return 0;
-
-    switch (sample_type)
-      {
-      case RL2_SAMPLE_INT8:
-	  do_copy8_int8 (pixels_odd, buf, *xwidth, odd_rows);
-	  break;
-      case RL2_SAMPLE_UINT8:
-	  do_copy8_uint8 (pixels_odd, buf, *xwidth, odd_rows, num_bands);
-	  break;
-      case RL2_SAMPLE_INT16:
-	  do_copy8_int16 (swap, pixels_odd, buf, *xwidth, odd_rows);
-	  break;
-      case RL2_SAMPLE_UINT16:
-	  do_copy8_uint16 (swap, pixels_odd, buf, *xwidth, odd_rows, num_bands);
-	  break;
-      case RL2_SAMPLE_INT32:
-	  do_copy8_int32 (swap, pixels_odd, buf, *xwidth, odd_rows);
-	  break;
-      case RL2_SAMPLE_UINT32:
-	  do_copy8_uint32 (swap, pixels_odd, buf, *xwidth, odd_rows);
-	  break;
-      case RL2_SAMPLE_FLOAT:
-	  do_copy8_float (swap, pixels_odd, buf, *xwidth, odd_rows);
-	  break;
-      case RL2_SAMPLE_DOUBLE:
-	  do_copy8_double (swap, pixels_odd, buf, *xwidth, odd_rows);
-	  break;
-      };
-
-    *xwidth = width;
-    *xheight = height;
-    *pixels = buf;
-    *pixels_sz = buf_size;
-    return 1;
-}
-
-static void
-do_copy_int8 (const char *p_odd, const char *p_even, char *buf,
-	      unsigned short width, unsigned short odd_rows,
-	      unsigned short even_rows)
-{
-/* reassembling an INT8 raster - scale 1:1 */
-    int row;
-    int col;
-    char *p_out;
-
-    p_out = buf;
-    for (row = 0; row < odd_rows; row++)
-      {
-	  /* Odd scanlines */
-	  for (col = 0; col < width; col++)
-	      *p_out++ = *p_odd++;
-	  p_out += width;
-      }
-
-    p_out = buf;
-    for (row = 0; row < even_rows; row++)
-      {
-	  /* Even scanlines */
-	  p_out += width;
-	  for (col = 0; col < width; col++)
-	      *p_out++ = *p_even++;
-      }
-}
-
-static void
-do_copy_uint8 (const unsigned char *p_odd, const unsigned char *p_even,
-	       unsigned char *buf, unsigned short width,
-	       unsigned short odd_rows, unsigned short even_rows,
-	       unsigned char num_bands)
-{
-/* reassembling a UINT8 raster - scale 1:1 */
-    int row;
-    int col;
-    int band;
-    unsigned char *p_out;
-
-    p_out = buf;
-    for (row = 0; row < odd_rows; row++)
-      {
-	  /* Odd scanlines */
-	  for (col = 0; col < width; col++)
-	    {
-		for (band = 0; band < num_bands; band++)
-		    *p_out++ = *p_odd++;
-	    }
-	  p_out += width * num_bands;
-      }
-
-    p_out = buf;
-    for (row = 0; row < even_rows; row++)
-      {
-	  /* Even scanlines */
-	  p_out += width * num_bands;
-	  for (col = 0; col < width; col++)
-	    {
-		for (band = 0; band < num_bands; band++)
-		    *p_out++ = *p_even++;
-	    }
-      }
-}
-
-static void
-do_copy_int16 (int swap, const short *p_odd, const short *p_even, short *buf,
-	       unsigned short width, unsigned short odd_rows,
-	       unsigned short even_rows)
-{
-/* reassembling an INT16 raster - scale 1:1 */
-    int row;
-    int col;
-    short *p_out;
-
-    p_out = buf;
-    for (row = 0; row < odd_rows; row++)
-      {
-	  /* Odd scanlines */
-	  for (col = 0; col < width; col++)
-	    {
-		if (swap)
-		    *p_out++ = swapINT16 (*p_odd++);
-		else
-		    *p_out++ = *p_odd++;
-	    }
-	  p_out += width;
-      }
-
-    p_out = buf;
-    for (row = 0; row < even_rows; row++)
-      {
-	  /* Even scanlines */
-	  p_out += width;
-	  for (col = 0; col < width; col++)
-	    {
-		if (swap)
-		    *p_out++ = swapINT16 (*p_even++);
-		else
-		    *p_out++ = *p_even++;
-	    }
-      }
-}
-
-static void
-do_copy_uint16 (int swap, const unsigned short *p_odd,
-		const unsigned short *p_even, unsigned short *buf,
-		unsigned short width, unsigned short odd_rows,
-		unsigned short even_rows, unsigned char num_bands)
-{
-/* reassembling a UINT16 raster - scale 1:1 */
-    int row;
-    int col;
-    int band;
-    unsigned short *p_out;
-
-    p_out = buf;
-    for (row = 0; row < odd_rows; row++)
-      {
-	  /* Odd scanlines */
-	  for (col = 0; col < width; col++)
-	    {
-		for (band = 0; band < num_bands; band++)
-		  {
-		      if (swap)
-			  *p_out++ = swapUINT16 (*p_odd++);
-		      else
-			  *p_out++ = *p_odd++;
-		  }
-	    }
-	  p_out += width * num_bands;
-      }
-
-    p_out = buf;
-    for (row = 0; row < even_rows; row++)
-      {
-	  /* Even scanlines */
-	  p_out += width * num_bands;
-	  for (col = 0; col < width; col++)
-	    {
-		for (band = 0; band < num_bands; band++)
-		  {
-		      if (swap)
-			  *p_out++ = swapUINT16 (*p_even++);
-		      else
-			  *p_out++ = *p_even++;
-		  }
-	    }
-      }
-}
-
-static void
-do_copy_int32 (int swap, const int *p_odd, const int *p_even, int *buf,
-	       unsigned short width, unsigned short odd_rows,
-	       unsigned short even_rows)
-{
-/* reassembling an INT32 raster - scale 1:1 */
-    int row;
-    int col;
-    int *p_out;
-
-    p_out = buf;
-    for (row = 0; row < odd_rows; row++)
-      {
-	  /* Odd scanlines */
-	  for (col = 0; col < width; col++)
-	    {
-		if (swap)
-		    *p_out++ = swapINT32 (*p_odd++);
-		else
-		    *p_out++ = *p_odd++;
-	    }
-	  p_out += width;
-      }
-
-    p_out = buf;
-    for (row = 0; row < even_rows; row++)
-      {
-	  /* Even scanlines */
-	  p_out += width;
-	  for (col = 0; col < width; col++)
-	    {
-		if (swap)
-		    *p_out++ = swapINT32 (*p_even++);
-		else
-		    *p_out++ = *p_even++;
-	    }
-      }
-}
-
-static void
-do_copy_uint32 (int swap, const unsigned int *p_odd,
-		const unsigned int *p_even, unsigned int *buf,
-		unsigned short width, unsigned short odd_rows,
-		unsigned short even_rows)
-{
-/* reassembling an UINT32 raster - scale 1:1 */
-    int row;
-    int col;
-    unsigned int *p_out;
-
-    p_out = buf;
-    for (row = 0; row < odd_rows; row++)
-      {
-	  /* Odd scanlines */
-	  for (col = 0; col < width; col++)
-	    {
-		if (swap)
-		    *p_out++ = swapUINT32 (*p_odd++);
-		else
-		    *p_out++ = *p_odd++;
-	    }
-	  p_out += width;
-      }
-
-    p_out = buf;
-    for (row = 0; row < even_rows; row++)
-      {
-	  /* Even scanlines */
-	  p_out += width;
-	  for (col = 0; col < width; col++)
-	    {
-		if (swap)
-		    *p_out++ = swapUINT32 (*p_even++);
-		else
-		    *p_out++ = *p_even++;
-	    }
-      }
-}
-
-static void
-do_copy_float (int swap, const float *p_odd, const float *p_even, float *buf,
-	       unsigned short width, unsigned short odd_rows,
-	       unsigned short even_rows)
-{
-/* reassembling a FLOAT raster - scale 1:1 */
-    int row;
-    int col;
-    float *p_out;
-
-    p_out = buf;
-    for (row = 0; row < odd_rows; row++)
-      {
-	  /* Odd scanlines */
-	  for (col = 0; col < width; col++)
-	    {
-		if (swap)
-		    *p_out++ = swapFloat (*p_odd++);
-		else
-		    *p_out++ = *p_odd++;
-	    }
-	  p_out += width;
-      }
-
-    p_out = buf;
-    for (row = 0; row < even_rows; row++)
-      {
-	  /* Even scanlines */
-	  p_out += width;
-	  for (col = 0; col < width; col++)
-	    {
-		if (swap)
-		    *p_out++ = swapFloat (*p_even++);
-		else
-		    *p_out++ = *p_even++;
-	    }
-      }
-}
-
-static void
-do_copy_double (int swap, const double *p_odd, const double *p_even,
-		double *buf, unsigned short width, unsigned short odd_rows,
-		unsigned short even_rows)
-{
-/* reassembling a DOUBLE raster - scale 1:1 */
-    int row;
-    int col;
-    double *p_out;
-
-    p_out = buf;
-    for (row = 0; row < odd_rows; row++)
-      {
-	  /* Odd scanlines */
-	  for (col = 0; col < width; col++)
-	    {
-		if (swap)
-		    *p_out++ = swapDouble (*p_odd++);
-		else
-		    *p_out++ = *p_odd++;
-	    }
-	  p_out += width;
-      }
+    if (buf == NULL)
+	return 0;
 
+/* 
+/ all the sampled scanlines belong to the Odd block: a 1:N reduction
+/ takes one Odd row every N/2 and one pixel every N from each of them
+*/
+    in_row_bytes = *xwidth * pixel_size * num_bands;
+    out_row_bytes = width * pixel_size * num_bands;
     p_out = buf;
-    for (row = 0; row < even_rows; row++)
+    for (row = 0; row < height && row * odd_step < odd_rows; row++)
       {
-	  /* Even scanlines */
-	  p_out += width;
-	  for (col = 0; col < width; col++)
-	    {
-		if (swap)
-		    *p_out++ = swapDouble (*p_even++);
-		else
-		    *p_out++ = *p_even++;
-	    }
+	  rl2_copy_pixel_row (p_out, p_odd + (row * odd_step * in_row_bytes),
+			      width, pixel_size, num_bands, step, swap);
+	  p_out += out_row_bytes;
       }
+
+    *xwidth = width;
+    *xheight = height;
+    *pixels = buf;
+    *pixels_sz = buf_size;
+    return 1;
 }
 
 static int
@@ -4594,88 +3518,205 @@ build_pixel_buffer (int swap, int scale, unsigned int *xwidth,
 /* decoding the raster */
     unsigned int width = *xwidth;
     unsigned int height = *xheight;
+    unsigned int row;
+    unsigned int row_bytes;
+    const unsigned char *p_odd = pixels_odd;
+    const unsigned char *p_even = pixels_even;
+    unsigned char *p_out;
     void *buf;
     int buf_size;
-    unsigned char pixel_size;
-
-    switch (sample_type)
-      {
-      case RL2_SAMPLE_INT16:
-      case RL2_SAMPLE_UINT16:
-	  pixel_size = 2;
-	  break;
-      case RL2_SAMPLE_INT32:
-      case RL2_SAMPLE_UINT32:
-      case RL2_SAMPLE_FLOAT:
-	  pixel_size = 4;
-	  break;
-      case RL2_SAMPLE_DOUBLE:
-	  pixel_size = 8;
-	  break;
-      default:
-	  pixel_size = 1;
-	  break;
-      };
+    unsigned char pixel_size = decode_pixel_size (sample_type);
 
     if (scale == RL2_SCALE_2)
-	return build_pixel_buffer_2 (swap, xwidth, xheight, sample_type,
-				     pixel_size, num_bands, odd_rows,
-				     pixels_odd, pixels, pixels_sz);
+	return build_pixel_buffer_scaled (swap, 2, xwidth, xheight,
+					  pixel_size, num_bands, odd_rows,
+					  pixels_odd, pixels, pixels_sz);
     if (scale == RL2_SCALE_4)
-	return build_pixel_buffer_4 (swap, xwidth, xheight, sample_type,
-				     pixel_size, num_bands, odd_rows,
-				     pixels_odd, pixels, pixels_sz);
+	return build_pixel_buffer_scaled (swap, 4, xwidth, xheight,
+					  pixel_size, num_bands, odd_rows,
+					  pixels_odd, pixels, pixels_sz);
     if (scale == RL2_SCALE_8)
-	return build_pixel_buffer_8 (swap, xwidth, xheight, sample_type,
-				     pixel_size, num_bands, odd_rows,
-				     pixels_odd, pixels, pixels_sz);
+	return build_pixel_buffer_scaled (swap, 8, xwidth, xheight,
+					  pixel_size, num_bands, odd_rows,
+					  pixels_odd, pixels, pixels_sz);
 
     buf_size = width * height * pixel_size * num_bands;
     buf = malloc (buf_size);
     if (buf == NULL)
 	return 0;
 
-    switch (sample_type)
+/* Odd scanlines go to rows 0,2,4..., Even scanlines to rows 1,3,5... */
+    row_bytes = width * pixel_size * num_bands;
+    p_out = buf;
+    for (row = 0; row < odd_rows; row++)
       {
-      case RL2_SAMPLE_INT8:
-	  do_copy_int8 (pixels_odd, pixels_even, buf, width, odd_rows,
-			even_rows);
-	  break;
-      case RL2_SAMPLE_UINT8:
-	  do_copy_uint8 (pixels_odd, pixels_even, buf, width, odd_rows,
-			 even_rows, num_bands);
-	  break;
-      case RL2_SAMPLE_INT16:
-	  do_copy_int16 (swap, pixels_odd, pixels_even, buf, width, odd_rows,
-			 even_rows);
-	  break;
-      case RL2_SAMPLE_UINT16:
-	  do_copy_uint16 (swap, pixels_odd, pixels_even, buf, width, odd_rows,
-			  even_rows, num_bands);
-	  break;
-      case RL2_SAMPLE_INT32:
-	  do_copy_int32 (swap, pixels_odd, pixels_even, buf, width, odd_rows,
-			 even_rows);
-	  break;
-      case RL2_SAMPLE_UINT32:
-	  do_copy_uint32 (swap, pixels_odd, pixels_even, buf, width, odd_rows,
-			  even_rows);
-	  break;
-      case RL2_SAMPLE_FLOAT:
-	  do_copy_float (swap, pixels_odd, pixels_even, buf, width, odd_rows,
-			 even_rows);
-	  break;
-      case RL2_SAMPLE_DOUBLE:
-	  do_copy_double (swap, pixels_odd, pixels_even, buf, width, odd_rows,
-			  even_rows);
-	  break;
-      };
+	  rl2_copy_pixel_row (p_out, p_odd, width, pixel_size, num_bands, 1,
+			      swap);
+	  p_odd += row_bytes;
+	  p_out += row_bytes * 2;
+      }
+    p_out = (unsigned char *) buf + row_bytes;
+    for (row = 0; row < even_rows; row++)
+      {
+	  rl2_copy_pixel_row (p_out, p_even, width, pixel_size, num_bands, 1,
+			      swap);
+	  p_even += row_bytes;
+	  p_out += row_bytes * 2;
+      }
 
     *pixels = buf;
     *pixels_sz = buf_size;
     return 1;
 }
 
+static unsigned char *
+view_row_span (rl2DecodeViewPtr view, int pixel_bytes, unsigned int row,
+	       unsigned int *skip, unsigned int *count)
+{
+/* 
+/ clipping a Tile row against the View
+/ returns the first output pixel, or NULL if the row is outside
+*/
+    int out_row = view->row + (int) row;
+    int out_col = view->col;
+    unsigned int n = *count;
+    *skip = 0;
+    if (out_row < 0 || out_row >= (int) (view->height))
+	return NULL;
+    if (out_col < 0)
+      {
+	  if ((unsigned int) (-out_col) >= n)
+	      return NULL;
+	  *skip = -out_col;
+	  n -= *skip;
+	  out_col = 0;
+      }
+    if (out_col >= (int) (view->width))
+	return NULL;
+    if (out_col + n > view->width)
+	n = view->width - out_col;
+    *count = n;
+    return view->outbuf +
+	(((size_t) out_row * view->width) + out_col) * pixel_bytes;
+}
+
+static void
+build_pixel_view (int swap, int scale, unsigned int width,
+		  unsigned int height, unsigned char sample_type,
+		  unsigned char num_bands, unsigned short odd_rows,
+		  const void *pixels_odd, unsigned short even_rows,
+		  const void *pixels_even, rl2DecodeViewPtr view)
+{
+/* 
+/ same as build_pixel_buffer(), but merging the Odd and Even
+/ scanlines directly into their final place within the View
+*/
+    unsigned int row;
+    unsigned int col;
+    unsigned int out_width = 0;
+    unsigned int out_height = 0;
+    unsigned int skip;
+    unsigned int count;
+    unsigned int in_row_bytes;
+    unsigned char pixel_size = decode_pixel_size (sample_type);
+    int pixel_bytes = pixel_size * num_bands;
+    int step = 1;
+    unsigned int odd_step;
+    const unsigned char *p_odd = pixels_odd;
+    const unsigned char *p_even = pixels_even;
+    unsigned char *p_out;
+
+    in_row_bytes = width * pixel_bytes;
+    if (scale == RL2_SCALE_1)
+      {
+	  /* Odd scanlines go to rows 0,2,4..., Even scanlines to rows 1,3,5... */
+	  for (row = 0; row < odd_rows && row * 2 < height; row++)
+	    {
+		count = width;
+		p_out = view_row_span (view, pixel_bytes, row * 2, &skip,
+				       &count);
+		if (p_out != NULL)
+		    rl2_copy_pixel_row (p_out,
+					p_odd + (row * in_row_bytes) +
+					(skip * pixel_bytes), count,
+					pixel_size, num_bands, 1, swap);
+	    }
+	  for (row = 0; row < even_rows && (row * 2) + 1 < height; row++)
+	    {
+		count = width;
+		p_out = view_row_span (view, pixel_bytes, (row * 2) + 1,
+				       &skip, &count);
+		if (p_out != NULL)
+		    rl2_copy_pixel_row (p_out,
+					p_even + (row * in_row_bytes) +
+					(skip * pixel_bytes), count,
+					pixel_size, num_bands, 1, swap);
+	    }
+	  return;
+      }
+
+/* scale 1:2, 1:4 or 1:8 - all the sampled scanlines belong to the Odd block */
+    if (scale == RL2_SCALE_2)
+	step = 2;
+    else if (scale == RL2_SCALE_4)
+	step = 4;
+    else
+	step = 8;
+    odd_step = step / 2;
+    for (row = 0; row < height; row += step)
+	out_height++;
+    for (col = 0; col < width; col += step)
+	out_width++;
+    for (row = 0; row < out_height && row * odd_step < odd_rows; row++)
+      {
+	  count = out_width;
+	  p_out = view_row_span (view, pixel_bytes, row, &skip, &count);
+	  if (p_out != NULL)
+	      rl2_copy_pixel_row (p_out,
+				  p_odd + (row * odd_step * in_row_bytes) +
+				  (skip * step * pixel_bytes), count,
+				  pixel_size, num_bands, step, swap);
+      }
+}
+
+static void
+copy_pixels_to_view (rl2DecodeViewPtr view, unsigned int width,
+		     unsigned int height, int pixel_bytes,
+		     const unsigned char *pixels, const unsigned char *mask)
+{
+/* copying an already decoded pixel buffer into the View */
+    unsigned int row;
+    unsigned int col;
+    unsigned int skip;
+    unsigned int count;
+    const unsigned char *p_in;
+    const unsigned char *p_msk;
+    unsigned char *p_out;
+
+    for (row = 0; row < height; row++)
+      {
+	  count = width;
+	  p_out = view_row_span (view, pixel_bytes, row, &skip, &count);
+	  if (p_out == NULL)
+	      continue;
+	  p_in = pixels + (((size_t) row * width) + skip) * pixel_bytes;
+	  if (mask == NULL)
+	    {
+		memcpy (p_out, p_in, (size_t) count * pixel_bytes);
+		continue;
+	    }
+	  /* transparent pixels leave the View untouched */
+	  p_msk = mask + ((size_t) row * width) + skip;
+	  for (col = 0; col < count; col++)
+	    {
+		if (*p_msk++ != 0)
+		    memcpy (p_out, p_in, pixel_bytes);
+		p_in += pixel_bytes;
+		p_out += pixel_bytes;
+	    }
+      }
+}
+
 static int
 rescale_mask_2 (unsigned short *xwidth, unsigned short *xheight,
 		const unsigned char *mask_pix, unsigned char **mask,
@@ -4819,83 +3860,26 @@ rescale_mask (int scale, unsigned short *xwidth, unsigned short *xheight,
 }
 
 static int
-unpack_1bit (unsigned short width, unsigned short height,
-	     unsigned short row_stride, const unsigned char *pixels_in,
-	     unsigned char **pixels, int *pixels_sz)
+unpack_bit_rows (unsigned short width, unsigned short height,
+		 unsigned short row_stride, int bits,
+		 const unsigned char *pixels_in, unsigned char **pixels,
+		 int *pixels_sz)
 {
-/* unpacking a 1-BIT raster */
+/* unpacking a 1, 2 or 4-BIT raster */
     unsigned char *buf;
     int buf_size;
     int row;
-    int col;
-    unsigned char *p_out;
-    const unsigned char *p_in;
 
+    if ((row_stride * 8) < (width * bits))
+	return 0;
     buf_size = width * height;
     buf = malloc (buf_size);
     if (buf == NULL)
 	return 0;
 
-    p_in = pixels_in;
-    p_out = buf;
     for (row = 0; row < height; row++)
-      {
-	  int x = 0;
-	  for (col = 0; col < row_stride; col++)
-	    {
-		unsigned char byte = *p_in++;
-		if ((byte & 0x80) == 0x80)
-		    *p_out++ = 1;
-		else
-		    *p_out++ = 0;
-		x++;
-		if (x >= width)
-		    break;
-		if ((byte & 0x40) == 0x40)
-		    *p_out++ = 1;
-		else
-		    *p_out++ = 0;
-		x++;
-		if (x >= width)
-		    break;
-		if ((byte & 0x20) == 0x20)
-		    *p_out++ = 1;
-		else
-		    *p_out++ = 0;
-		x++;
-		if (x >= width)
-		    break;
-		if ((byte & 0x10) == 0x10)
-		    *p_out++ = 1;
-		else
-		    *p_out++ = 0;
-		x++;
-		if (x >= width)
-		    break;
-		if ((byte & 0x08) == 0x08)
-		    *p_out++ = 1;
-		else
-		    *p_out++ = 0;
-		if ((byte & 0x04) == 0x04)
-		    *p_out++ = 1;
-		else
-		    *p_out++ = 0;
-		x++;
-		if (x >= width)
-		    break;
-		if ((byte & 0x02) == 0x02)
-		    *p_out++ = 1;
-		else
-		    *p_out++ = 0;
-		x++;
-		if (x >= width)
-		    break;
-		if ((byte & 0x01) == 0x01)
-		    *p_out++ = 1;
-		else
-		    *p_out++ = 0;
-	    }
-      }
+	rl2_unpack_bits (buf + (row * width), pixels_in + (row * row_stride),
+			 width, bits);
 
     *pixels = buf;
     *pixels_sz = buf_size;
@@ -4903,253 +3887,34 @@ unpack_1bit (unsigned short width, unsigned short height,
 }
 
 static int
-unpack_2bit (unsigned short width, unsigned short height,
-	     unsigned short row_stride, const unsigned char *pixels_in,
-	     unsigned char **pixels, int *pixels_sz)
+unpack_bit_rows_rgba (unsigned short width, unsigned short height,
+		      unsigned short row_stride, int bits,
+		      const unsigned char *pixels_in, rl2DecodeViewPtr view)
 {
-/* unpacking a 2-BIT raster */
-    void *buf;
-    int buf_size;
+/* unpacking a 1, 2 or 4-BIT raster straight into some RGBA View */
     int row;
-    int col;
-    unsigned char *p_out;
-    const unsigned char *p_in;
 
-    buf_size = width * height;
-    buf = malloc (buf_size);
-    if (buf == NULL)
+    if ((row_stride * 8) < (width * bits))
 	return 0;
-
-    p_in = pixels_in;
-    p_out = buf;
     for (row = 0; row < height; row++)
-      {
-	  int x = 0;
-	  for (col = 0; col < row_stride; col++)
-	    {
-		unsigned char byte = *p_in++;
-		unsigned char hi0 = byte & 0xc0;
-		unsigned char hi1 = byte & 0x30;
-		unsigned char lo0 = byte & 0x0c;
-		unsigned char lo1 = byte & 0x03;
-		switch (hi0)
-		  {
-		  case 0x00:
-		      *p_out++ = 0;
-		      break;
-		  case 0x40:
-		      *p_out++ = 1;
-		      break;
-		  case 0x80:
-		      *p_out++ = 2;
-		      break;
-		  case 0xc0:
-		      *p_out++ = 3;
-		      break;
-		  };
-		x++;
-		if (x >= width)
-		    break;
-		switch (hi1)
-		  {
-		  case 0x00:
-		      *p_out++ = 0;
-		      break;
-		  case 0x10:
-		      *p_out++ = 1;
-		      break;
-		  case 0x20:
-		      *p_out++ = 2;
-		      break;
-		  case 0x30:
-		      *p_out++ = 3;
-		      break;
-		  };
-		x++;
-		if (x >= width)
-		    break;
-		switch (lo0)
-		  {
-		  case 0x00:
-		      *p_out++ = 0;
-		      break;
-		  case 0x04:
-		      *p_out++ = 1;
-		      break;
-		  case 0x08:
-		      *p_out++ = 2;
-		      break;
-		  case 0x0c:
-		      *p_out++ = 3;
-		      break;
-		  };
-		x++;
-		if (x >= width)
-		    break;
-		switch (lo1)
-		  {
-		  case 0x00:
-		      *p_out++ = 0;
-		      break;
-		  case 0x01:
-		      *p_out++ = 1;
-		      break;
-		  case 0x02:
-		      *p_out++ = 2;
-		      break;
-		  case 0x03:
-		      *p_out++ = 3;
-		      break;
-		  };
-		x++;
-	    }
-      }
-
-    *pixels = buf;
-    *pixels_sz = buf_size;
+	rl2_unpack_bits_rgba (view->outbuf + (row * width * 4),
+			      pixels_in + (row * row_stride), width, bits,
+			      view->rgba_lut);
     return 1;
 }
 
-static int
-unpack_4bit (unsigned short width, unsigned short height,
-	     unsigned short row_stride, const unsigned char *pixels_in,
-	     unsigned char **pixels, int *pixels_sz)
+static void
+mask_rgba_view (rl2DecodeViewPtr view, const unsigned char *mask)
 {
-/* unpacking a 4-BIT raster */
-    void *buf;
-    int buf_size;
-    int row;
-    int col;
-    unsigned char *p_out;
-    const unsigned char *p_in;
-
-    buf_size = width * height;
-    buf = malloc (buf_size);
-    if (buf == NULL)
-	return 0;
-
-    p_in = pixels_in;
-    p_out = buf;
-    for (row = 0; row < height; row++)
+/* applying the transparency mask to some RGBA View */
+    unsigned int i;
+    unsigned int count = view->width * view->height;
+    unsigned char *p_out = view->outbuf + 3;
+    for (i = 0; i < count; i++, p_out += 4)
       {
-	  int x = 0;
-	  for (col = 0; col < row_stride; col++)
-	    {
-		unsigned char byte = *p_in++;
-		unsigned char hi = byte & 0xf0;
-		unsigned char lo = byte & 0x0f;
-		switch (hi)
-		  {
-		  case 0x00:
-		      *p_out++ = 0;
-		      break;
-		  case 0x10:
-		      *p_out++ = 1;
-		      break;
-		  case 0x20:
-		      *p_out++ = 2;
-		      break;
-		  case 0x30:
-		      *p_out++ = 3;
-		      break;
-		  case 0x40:
-		      *p_out++ = 4;
-		      break;
-		  case 0x50:
-		      *p_out++ = 5;
-		      break;
-		  case 0x60:
-		      *p_out++ = 6;
-		      break;
-		  case 0x70:
-		      *p_out++ = 7;
-		      break;
-		  case 0x80:
-		      *p_out++ = 8;
-		      break;
-		  case 0x90:
-		      *p_out++ = 9;
-		      break;
-		  case 0xa0:
-		      *p_out++ = 10;
-		      break;
-		  case 0xb0:
-		      *p_out++ = 11;
-		      break;
-		  case 0xc0:
-		      *p_out++ = 12;
-		      break;
-		  case 0xd0:
-		      *p_out++ = 13;
-		      break;
-		  case 0xe0:
-		      *p_out++ = 14;
-		      break;
-		  case 0xf0:
-		      *p_out++ = 15;
-		      break;
-		  };
-		x++;
-		if (x >= width)
-		    break;
-		switch (lo)
-		  {
-		  case 0x00:
-		      *p_out++ = 0;
-		      break;
-		  case 0x01:
-		      *p_out++ = 1;
-		      break;
-		  case 0x02:
-		      *p_out++ = 2;
-		      break;
-		  case 0x03:
-		      *p_out++ = 3;
-		      break;
-		  case 0x04:
-		      *p_out++ = 4;
-		      break;
-		  case 0x05:
-		      *p_out++ = 5;
-		      break;
-		  case 0x06:
-		      *p_out++ = 6;
-		      break;
-		  case 0x07:
-		      *p_out++ = 7;
-		      break;
-		  case 0x08:
-		      *p_out++ = 8;
-		      break;
-		  case 0x09:
-		      *p_out++ = 9;
-		      break;
-		  case 0x0a:
-		      *p_out++ = 10;
-		      break;
-		  case 0x0b:
-		      *p_out++ = 11;
-		      break;
-		  case 0x0c:
-		      *p_out++ = 12;
-		      break;
-		  case 0x0d:
-		      *p_out++ = 13;
-		      break;
-		  case 0x0e:
-		      *p_out++ = 14;
-		      break;
-		  case 0x0f:
-		      *p_out++ = 15;
-		      break;
-		  };
-		x++;
-	    }
+	  if (*mask++ == 0)
+	      *p_out = 0;
       }
-
-    *pixels = buf;
-    *pixels_sz = buf_size;
-    return 1;
 }
 
 RL2_DECLARE int
@@ -5172,13 +3937,13 @@ rl2_is_valid_dbms_raster_tile (unsigned short level, unsigned int tile_width,
     uLong crc;
     if (!check_blob_odd
 	(blob_odd, blob_odd_sz, &width, &height, &xsample_type, &xpixel_type,
-	 &xnum_bands, &xcompression, &crc))
+	 &xnum_bands, &xcompression, &crc, 1))
 	return RL2_ERROR;
     if (blob_even != NULL)
       {
 	  if (!check_blob_even
 	      (blob_even, blob_even_sz, width, height, xsample_type,
-	       xpixel_type, xnum_bands, xcompression, crc))
+	       xpixel_type, xnum_bands, xcompression, crc, 1))
 	      return RL2_ERROR;
       }
     if (width != tile_width || height != tile_height)
@@ -5238,8 +4003,59 @@ rl2_raster_decode (int scale, const unsigned char *blob_odd,
 		   int blob_odd_sz, const unsigned char *blob_even,
 		   int blob_even_sz, rl2PalettePtr ext_palette)
 {
-/* decoding from internal RL2 binary format to Raster */
+/* decoding from internal RL2 binary format to Raster - always verifying */
+    return rl2_raster_decode_ex (scale, blob_odd, blob_odd_sz, blob_even,
+				 blob_even_sz, ext_palette, 1);
+}
+
+static int
+is_rgba_decodable (int scale, const unsigned char *blob_odd,
+		   int blob_odd_sz, rl2DecodeViewPtr view)
+{
+/* 
+/ checking if a Tile could be directly expanded into some RGBA View
+/ i.e. packed 1, 2 or 4-BIT pixels at full size not requiring any
+/ PNG or CCITT FAX4 decoding
+/ if "view" isn't NULL, its dimensions and sample type are set
+*/
+    int endian;
+    int endian_arch = endianArch ();
+    unsigned char compression;
+    if (blob_odd == NULL || blob_odd_sz < 41)
+	return 0;
+    if (scale != RL2_SCALE_1)
+	return 0;
+    if (packed_bits (*(blob_odd + 4)) == 0)
+	return 0;
+    compression = *(blob_odd + 3);
+    if (compression == RL2_COMPRESSION_PNG
+	|| compression == RL2_COMPRESSION_CCITTFAX4)
+	return 0;
+    if (view != NULL)
+      {
+	  endian = *(blob_odd + 2);
+	  view->width = importU16 (blob_odd + 7, endian, endian_arch);
+	  view->height = importU16 (blob_odd + 9, endian, endian_arch);
+	  view->sample_type = *(blob_odd + 4);
+	  view->num_bands = 1;
+      }
+    return 1;
+}
+
+static int
+do_raster_decode (int scale, const unsigned char *blob_odd,
+		  int blob_odd_sz, const unsigned char *blob_even,
+		  int blob_even_sz, rl2PalettePtr ext_palette,
+		  int verify_checksum, rl2DecodeViewPtr view,
+		  rl2RasterPtr * xraster)
+{
+/* 
+/ decoding from internal RL2 binary format
+/ - into a new Raster when "view" is NULL
+/ - otherwise directly into the destination View
+*/
     rl2RasterPtr raster;
+    int retcode = RL2_ERROR;
     rl2PalettePtr palette = NULL;
     rl2PalettePtr palette2 = NULL;
     unsigned int width;
@@ -5280,20 +4096,28 @@ rl2_raster_decode (int scale, const unsigned char *blob_odd,
     int delta_dist;
 
     if (blob_odd == NULL)
-	return NULL;
+	return RL2_ERROR;
     if (!check_blob_odd
 	(blob_odd, blob_odd_sz, &width, &height, &sample_type, &pixel_type,
-	 &num_bands, &compression, &crc))
-	return NULL;
+	 &num_bands, &compression, &crc, verify_checksum))
+	return RL2_ERROR;
     if (blob_even != NULL)
       {
 	  if (!check_blob_even
 	      (blob_even, blob_even_sz, width, height, sample_type,
-	       pixel_type, num_bands, compression, crc))
-	      return NULL;
+	       pixel_type, num_bands, compression, crc, verify_checksum))
+	      return RL2_ERROR;
       }
     if (!check_scale (scale, sample_type, compression, blob_even))
-	return NULL;
+	return RL2_ERROR;
+    if (view != NULL && view->rgba_lut != NULL)
+      {
+	  /* RGBA Views only accept full size packed pixels */
+	  if (!is_rgba_decodable (scale, blob_odd, blob_odd_sz, NULL))
+	      return RL2_ERROR;
+	  if (view->width != width || view->height != height)
+	      return RL2_ERROR;
+      }
 
     switch (pixel_type)
       {
@@ -5360,22 +4184,22 @@ rl2_raster_decode (int scale, const unsigned char *blob_odd,
     compressed_mask = importU32 (ptr, endian, endian_arch);
     ptr += 4;
     if (*ptr++ != RL2_DATA_START)
-	return NULL;
+	return RL2_ERROR;
     pixels_odd = ptr;
     if (uncompressed_mask > 0)
       {
 	  /* retrieving the mask */
 	  ptr += compressed_odd;
 	  if (*ptr++ != RL2_DATA_END)
-	      return NULL;
+	      return RL2_ERROR;
 	  if (*ptr++ != RL2_MASK_START)
-	      return NULL;
+	      return RL2_ERROR;
 	  pixels_mask = ptr;
 	  mask_width = width;
 	  mask_height = height;
 	  ptr += compressed_mask;
 	  if (*ptr++ != RL2_MASK_END)
-	      return NULL;
+	      return RL2_ERROR;
       }
     if (blob_even != NULL)
       {
@@ -5388,7 +4212,7 @@ rl2_raster_decode (int scale, const unsigned char *blob_odd,
 	  compressed_even = importU32 (ptr, endian, endian_arch);
 	  ptr += 4;
 	  if (*ptr++ != RL2_DATA_START)
-	      return NULL;
+	      return RL2_ERROR;
 	  pixels_even = ptr;
       }
     else
@@ -5572,6 +4396,84 @@ rl2_raster_decode (int scale, const unsigned char *blob_odd,
 	  goto error;
 #endif /* end LZMA conditional */
       }
+    if ((compression == RL2_COMPRESSION_ZSTD
+	 || compression == RL2_COMPRESSION_ZSTD_NO)
+	&& uncompressed_odd != compressed_odd)
+      {
+#ifndef OMIT_ZSTD		/* only if ZSTD is enabled */
+	  /* decompressing from Zstandard - ODD Block */
+	  int zstd_delta =
+	      (compression == RL2_COMPRESSION_ZSTD) ? delta_dist : 0;
+	  if (decompress_zstd
+	      (pixels_odd, compressed_odd, uncompressed_odd, zstd_delta,
+	       &odd_data) != RL2_OK)
+	      goto error;
+	  pixels_odd = odd_data;
+	  if (pixels_even != NULL && uncompressed_even != compressed_even)
+	    {
+		/* decompressing from Zstandard - EVEN Block */
+		if (decompress_zstd
+		    (pixels_even, compressed_even, uncompressed_even,
+		     zstd_delta, &even_data) != RL2_OK)
+		    goto error;
+		pixels_even = even_data;
+	    }
+#else /* ZSTD is disabled */
+	  fprintf (stderr,
+		   "librasterlite2 was built by disabling Zstandard support\n");
+	  goto error;
+#endif /* end ZSTD conditional */
+      }
+    if ((compression == RL2_COMPRESSION_LZ4
+	 || compression == RL2_COMPRESSION_LZ4_NO)
+	&& uncompressed_odd != compressed_odd)
+      {
+#ifndef OMIT_LZ4		/* only if LZ4 is enabled */
+	  /* decompressing from LZ4 - ODD Block */
+	  int lz4_shuffle =
+	      (compression == RL2_COMPRESSION_LZ4) ? delta_dist : 0;
+	  if (decompress_lz4
+	      (pixels_odd, compressed_odd, uncompressed_odd, lz4_shuffle,
+	       &odd_data) != RL2_OK)
+	      goto error;
+	  pixels_odd = odd_data;
+	  if (pixels_even != NULL && uncompressed_even != compressed_even)
+	    {
+		/* decompressing from LZ4 - EVEN Block */
+		if (decompress_lz4
+		    (pixels_even, compressed_even, uncompressed_even,
+		     lz4_shuffle, &even_data) != RL2_OK)
+		    goto error;
+		pixels_even = even_data;
+	    }
+#else /* LZ4 is disabled */
+	  fprintf (stderr,
+		   "librasterlite2 was built by disabling LZ4 support\n");
+	  goto error;
+#endif /* end LZ4 conditional */
+      }
+    if ((compression == RL2_COMPRESSION_DEFLATE_FP
+	 || compression == RL2_COMPRESSION_LZMA_FP
+	 || compression == RL2_COMPRESSION_ZSTD_FP)
+	&& uncompressed_odd != compressed_odd)
+      {
+	  /* decompressing from FloatPredictor - ODD Block */
+	  if (decompress_float_predictor
+	      (compression, pixels_odd, compressed_odd, uncompressed_odd,
+	       delta_dist, endian, &odd_data) != RL2_OK)
+	      goto error;
+	  pixels_odd = odd_data;
+	  if (pixels_even != NULL && uncompressed_even != compressed_even)
+	    {
+		/* decompressing from FloatPredictor - EVEN Block */
+		if (decompress_float_predictor
+		    (compression, pixels_even, compressed_even,
+		     uncompressed_even, delta_dist, endian,
+		     &even_data) != RL2_OK)
+		    goto error;
+		pixels_even = even_data;
+	    }
+      }
     if (compression == RL2_COMPRESSION_JPEG)
       {
 	  /* decompressing from JPEG - always on the ODD Block */
@@ -5797,22 +4699,20 @@ rl2_raster_decode (int scale, const unsigned char *blob_odd,
 #endif /* end OpenJpeg conditional */
       }
 
-    if (sample_type == RL2_SAMPLE_1_BIT)
-      {
-	  if (!unpack_1bit
-	      (width, height, row_stride_odd, pixels_odd, &pixels, &pixels_sz))
-	      goto error;
-      }
-    else if (sample_type == RL2_SAMPLE_2_BIT)
+    if (packed_bits (sample_type) > 0)
       {
-	  if (!unpack_2bit
-	      (width, height, row_stride_odd, pixels_odd, &pixels, &pixels_sz))
-	      goto error;
-      }
-    else if (sample_type == RL2_SAMPLE_4_BIT)
-      {
-	  if (!unpack_4bit
-	      (width, height, row_stride_odd, pixels_odd, &pixels, &pixels_sz))
+	  if (view != NULL && view->rgba_lut != NULL)
+	    {
+		/* fast path: expanding directly into the RGBA View */
+		if (!unpack_bit_rows_rgba
+		    (width, height, row_stride_odd, packed_bits (sample_type),
+		     pixels_odd, view))
+		    goto error;
+		goto done;
+	    }
+	  if (!unpack_bit_rows
+	      (width, height, row_stride_odd, packed_bits (sample_type),
+	       pixels_odd, &pixels, &pixels_sz))
 	      goto error;
       }
     else
@@ -5822,6 +4722,14 @@ rl2_raster_decode (int scale, const unsigned char *blob_odd,
 	      swap = 1;
 	  else
 	      swap = 0;
+	  if (view != NULL && pixels_mask == NULL)
+	    {
+		/* fast path: merging directly into the View */
+		build_pixel_view (swap, scale, width, height, sample_type,
+				  num_bands, odd_rows, pixels_odd, even_rows,
+				  pixels_even, view);
+		goto stop;
+	    }
 	  if (!build_pixel_buffer
 	      (swap, scale, &width, &height, sample_type, num_bands, odd_rows,
 	       pixels_odd, even_rows, pixels_even, (void **) (&pixels),
@@ -5850,6 +4758,22 @@ rl2_raster_decode (int scale, const unsigned char *blob_odd,
 	  free (mask_pix);
       }
 
+    if (view != NULL && view->rgba_lut != NULL)
+      {
+	  /* the RGBA View is already filled: just applying the mask */
+	  if (mask != NULL)
+	      mask_rgba_view (view, mask);
+	  goto stop;
+      }
+    if (view != NULL)
+      {
+	  /* copying the decoded pixels into the View */
+	  copy_pixels_to_view (view, width, height,
+			       decode_pixel_size (sample_type) * num_bands,
+			       pixels, mask);
+	  goto stop;
+      }
+
     if (palette == NULL)
       {
 	  palette = ext_palette;
@@ -5869,7 +4793,11 @@ rl2_raster_decode (int scale, const unsigned char *blob_odd,
 	free (odd_data);
     if (even_data != NULL)
 	free (even_data);
-    return raster;
+    *xraster = raster;
+    return RL2_OK;
+  stop:
+    /* successfully decoded into the View: just cleaning up */
+    retcode = RL2_OK;
   error:
     if (odd_mask != NULL)
 	free (odd_mask);
@@ -5887,7 +4815,194 @@ rl2_raster_decode (int scale, const unsigned char *blob_odd,
 	rl2_destroy_palette (palette);
     if (ext_palette != NULL)
 	rl2_destroy_palette (ext_palette);
-    return NULL;
+    return retcode;
+}
+
+RL2_PRIVATE rl2RasterPtr
+rl2_raster_decode_ex (int scale, const unsigned char *blob_odd,
+		      int blob_odd_sz, const unsigned char *blob_even,
+		      int blob_even_sz, rl2PalettePtr ext_palette,
+		      int verify_checksum)
+{
+/* decoding from internal RL2 binary format to Raster */
+    rl2RasterPtr raster = NULL;
+    if (do_raster_decode
+	(scale, blob_odd, blob_odd_sz, blob_even, blob_even_sz, ext_palette,
+	 verify_checksum, NULL, &raster) != RL2_OK)
+	return NULL;
+    return raster;
+}
+
+RL2_PRIVATE int
+rl2_is_view_decodable (const unsigned char *blob_odd, int blob_odd_sz,
+		       rl2DecodeViewPtr view)
+{
+/* 
+/ checking if a Tile could be directly decoded into some View
+/ i.e. the Tile and the View share the same pixel layout
+*/
+    if (blob_odd == NULL || view == NULL)
+	return 0;
+    if (blob_odd_sz < 41)
+	return 0;
+    if (*(blob_odd + 4) != view->sample_type)
+	return 0;		/* mismatching sample type */
+    if (*(blob_odd + 6) != view->num_bands)
+	return 0;		/* mismatching # bands */
+    return 1;
+}
+
+RL2_PRIVATE int
+rl2_raster_decode_view (int scale, const unsigned char *blob_odd,
+			int blob_odd_sz, const unsigned char *blob_even,
+			int blob_even_sz, int verify_checksum,
+			rl2DecodeViewPtr view)
+{
+/* decoding from internal RL2 binary format directly into a View */
+    if (view == NULL)
+	return RL2_ERROR;
+    return do_raster_decode (scale, blob_odd, blob_odd_sz, blob_even,
+			     blob_even_sz, NULL, verify_checksum, view, NULL);
+}
+
+static int
+build_rgba_lut (unsigned char sample_type, unsigned char pixel_type,
+		rl2PalettePtr palette, rl2PixelPtr no_data,
+		unsigned char *rgba_lut)
+{
+/*
+/ building the RGBA LUT of some packed pixel type by exporting a tiny
+/ Raster containing every possible value, so to share exactly the same
+/ colors and transparency rules; values beyond the Palette (never
+/ produced by the encoder) are rendered as opaque BLACK
+*/
+    rl2RasterPtr raster;
+    rl2PalettePtr plt = NULL;
+    rl2PixelPtr nd;
+    unsigned char *values;
+    unsigned char *rgba;
+    int rgba_sz;
+    unsigned short max_palette;
+    int max = 1 << packed_bits (sample_type);
+    int entries = max;
+    int i;
+
+    if (pixel_type == RL2_PIXEL_PALETTE)
+      {
+	  if (palette == NULL)
+	      return 0;
+	  if (rl2_get_palette_entries (palette, &max_palette) != RL2_OK)
+	      return 0;
+	  if (max_palette < entries)
+	      entries = max_palette;
+	  if (entries == 0)
+	      return 0;
+	  plt = rl2_clone_palette (palette);
+      }
+    values = malloc (entries);
+    if (values == NULL)
+	goto error;
+    for (i = 0; i < entries; i++)
+	values[i] = i;
+    raster =
+	rl2_create_raster (entries, 1, sample_type, pixel_type, 1, values,
+			   entries, plt, NULL, 0, NULL);
+    if (raster == NULL)
+	goto error;
+    if (no_data != NULL)
+      {
+	  nd = rl2_clone_pixel (no_data);
+	  if (rl2_set_raster_no_data (raster, nd) != RL2_OK)
+	      rl2_destroy_pixel (nd);
+      }
+    if (rl2_raster_data_to_RGBA (raster, &rgba, &rgba_sz) != RL2_OK)
+      {
+	  rl2_destroy_raster (raster);
+	  return 0;
+      }
+    rl2_destroy_raster (raster);
+    memcpy (rgba_lut, rgba, entries * 4);
+    free (rgba);
+    for (i = entries; i < max; i++)
+      {
+	  rgba_lut[(i * 4) + 0] = 0;
+	  rgba_lut[(i * 4) + 1] = 0;
+	  rgba_lut[(i * 4) + 2] = 0;
+	  rgba_lut[(i * 4) + 3] = 255;
+      }
+    return 1;
+
+  error:
+    if (values != NULL)
+	free (values);
+    if (plt != NULL)
+	rl2_destroy_palette (plt);
+    return 0;
+}
+
+RL2_PRIVATE int
+rl2_raster_decode_rgba (int scale, const unsigned char *blob_odd,
+			int blob_odd_sz, const unsigned char *blob_even,
+			int blob_even_sz, rl2PalettePtr palette,
+			rl2PixelPtr no_data, unsigned char **rgba,
+			int *rgba_sz)
+{
+/* 
+/ decoding from internal RL2 binary format to an RGBA array
+/ - packed 1, 2 or 4-BIT pixels are directly expanded through an
+/   RGBA LUT, thus skipping any intermediate Raster
+/ - all other Tiles are decoded the usual way
+/ both Palette and NO-DATA are never consumed
+*/
+    rl2RasterPtr raster;
+    rl2PixelPtr nd;
+    rl2DecodeView view;
+    unsigned char rgba_lut[16 * 4];
+    unsigned char *buf;
+    int buf_sz;
+    int ret;
+
+    *rgba = NULL;
+    *rgba_sz = 0;
+    if (is_rgba_decodable (scale, blob_odd, blob_odd_sz, &view)
+	&& build_rgba_lut (view.sample_type, *(blob_odd + 5), palette,
+			   no_data, rgba_lut))
+      {
+	  /* fast path: directly expanding the packed pixels */
+	  buf_sz = view.width * view.height * 4;
+	  buf = malloc (buf_sz);
+	  if (buf == NULL)
+	      return RL2_ERROR;
+	  view.outbuf = buf;
+	  view.col = 0;
+	  view.row = 0;
+	  view.rgba_lut = rgba_lut;
+	  if (do_raster_decode
+	      (scale, blob_odd, blob_odd_sz, blob_even, blob_even_sz, NULL, 1,
+	       &view, NULL) != RL2_OK)
+	    {
+		free (buf);
+		return RL2_ERROR;
+	    }
+	  *rgba = buf;
+	  *rgba_sz = buf_sz;
+	  return RL2_OK;
+      }
+
+    raster =
+	rl2_raster_decode (scale, blob_odd, blob_odd_sz, blob_even,
+			   blob_even_sz, rl2_clone_palette (palette));
+    if (raster == NULL)
+	return RL2_ERROR;
+    if (no_data != NULL)
+      {
+	  nd = rl2_clone_pixel (no_data);
+	  if (rl2_set_raster_no_data (raster, nd) != RL2_OK)
+	      rl2_destroy_pixel (nd);
+      }
+    ret = rl2_raster_data_to_RGBA (raster, rgba, rgba_sz);
+    rl2_destroy_raster (raster);
+    return ret;
 }
 
 RL2_PRIVATE rl2RasterPtr
@@ -5922,7 +5037,7 @@ rl2_raster_decode_mask (int scale, const unsigned char *blob_odd,
 	return NULL;
     if (!check_blob_odd
 	(blob_odd, blob_odd_sz, &width, &height, &sample_type, &pixel_type,
-	 &num_bands, &compression, &crc))
+	 &num_bands, &compression, &crc, 1))
 	return NULL;
     if (!check_scale2 (scale, sample_type))
 	return NULL;
@@ -6119,55 +5234,121 @@ update_no_data_stats (rl2PrivRasterStatisticsPtr st)
 }
 
 static void
-update_count_stats (rl2PrivRasterStatisticsPtr st)
+reset_sample_accumulators (rl2SampleAccumulatorPtr acc, int num_bands)
 {
-/* updating the samples count */
-    st->count += 1.0;
+/* initializing the per-band sample accumulators */
+    int ib;
+    for (ib = 0; ib < num_bands; ib++)
+      {
+	  rl2SampleAccumulatorPtr a = acc + ib;
+	  a->count = 0.0;
+	  a->shift = 0.0;
+	  a->min = DBL_MAX;
+	  a->max = 0.0 - DBL_MAX;
+	  a->sum = 0.0;
+	  a->sum_sq = 0.0;
+      }
 }
 
 static void
-update_stats (rl2PrivRasterStatisticsPtr st, int band, double value)
+accumulate_sample (rl2SampleAccumulatorPtr acc, double value)
 {
-/* updating the Statistics */
-    rl2PrivBandStatisticsPtr band_st = st->band_stats + band;
-    if (value < band_st->min)
-	band_st->min = value;
-    if (value > band_st->max)
-	band_st->max = value;
-    if (st->count == 0.0)
-      {
-	  band_st->mean = value;
-	  band_st->sum_sq_diff = 0.0;
-      }
-    else
-      {
-	  band_st->sum_sq_diff =
-	      band_st->sum_sq_diff +
-	      (((st->count -
-		 1.0) * ((value - band_st->mean) * (value -
-						    band_st->mean))) /
-	       st->count);
-	  band_st->mean = band_st->mean + ((value - band_st->mean) / st->count);
-      }
-    if (st->sampleType == RL2_SAMPLE_INT8)
+/*
+/ accumulating a single sample; all sums are shifted by the first
+/ sample so to preserve precision when computing the variance
+*/
+    double delta;
+    if (acc->count == 0.0)
+	acc->shift = value;
+    delta = value - acc->shift;
+    if (value < acc->min)
+	acc->min = value;
+    if (value > acc->max)
+	acc->max = value;
+    acc->count += 1.0;
+    acc->sum += delta;
+    acc->sum_sq += delta * delta;
+}
+
+static void
+flush_sample_accumulators (rl2PrivRasterStatisticsPtr st,
+			   rl2SampleAccumulatorPtr acc, double count)
+{
+/*
+/ merging a whole block of "count" valid pixels into the Statistics
+/ (pairwise update of the mean and of the sum of squared differences)
+*/
+    int ib;
+    if (count <= 0.0)
+	return;
+    for (ib = 0; ib < st->nBands; ib++)
       {
-	  int idx = value + 128;
-	  *(band_st->histogram + idx) += 1.0;
+	  rl2SampleAccumulatorPtr a = acc + ib;
+	  rl2PrivBandStatisticsPtr band_st = st->band_stats + ib;
+	  double mean = a->shift + (a->sum / count);
+	  double sum_sq_diff = a->sum_sq - ((a->sum * a->sum) / count);
+	  if (sum_sq_diff < 0.0)
+	      sum_sq_diff = 0.0;
+	  if (a->min < band_st->min)
+	      band_st->min = a->min;
+	  if (a->max > band_st->max)
+	      band_st->max = a->max;
+	  if (st->count == 0.0)
+	    {
+		band_st->mean = mean;
+		band_st->sum_sq_diff = sum_sq_diff;
+	    }
+	  else
+	    {
+		double delta = mean - band_st->mean;
+		double total = st->count + count;
+		band_st->sum_sq_diff +=
+		    sum_sq_diff + ((delta * delta) * st->count * count / total);
+		band_st->mean += delta * count / total;
+	    }
       }
-    else if (st->sampleType == RL2_SAMPLE_1_BIT
-	     || st->sampleType == RL2_SAMPLE_2_BIT
-	     || st->sampleType == RL2_SAMPLE_4_BIT
-	     || st->sampleType == RL2_SAMPLE_UINT8)
+    st->count += count;
+}
+
+static void
+update_histogram_8bit (rl2PrivRasterStatisticsPtr st, int band, int index)
+{
+/* updating an 8-bit Histogram: one bin for each value */
+    rl2PrivBandStatisticsPtr band_st = st->band_stats + band;
+    *(band_st->histogram + index) += 1.0;
+}
+
+static void
+histogram_uint8_samples (const unsigned char *in, int count, int stride,
+			 rl2PrivBandStatisticsPtr band_st)
+{
+/*
+/ counting a block of UINT8 samples into the Histogram; four
+/ interleaved sub-histograms avoid stalling on repeated values
+*/
+    unsigned int sub[4][256];
+    int i;
+    int ih;
+    memset (sub, 0, sizeof (sub));
+    for (i = 0; i + 4 <= count; i += 4, in += stride * 4)
       {
-	  int idx = value;
-	  *(band_st->histogram + idx) += 1.0;
+	  sub[0][in[0]]++;
+	  sub[1][in[stride]]++;
+	  sub[2][in[stride * 2]]++;
+	  sub[3][in[stride * 3]]++;
       }
+    for (; i < count; i++, in += stride)
+	sub[0][*in]++;
+    for (ih = 0; ih < 256 && ih < band_st->nHistogram; ih++)
+	*(band_st->histogram + ih) +=
+	    sub[0][ih] + sub[1][ih] + sub[2][ih] + sub[3][ih];
 }
 
 static void
 update_int8_stats (unsigned short width, unsigned short height,
 		   const char *pixels, const unsigned char *mask,
-		   rl2PrivRasterStatisticsPtr st, rl2PixelPtr no_data)
+		   rl2PrivRasterStatisticsPtr st,
+		   rl2SampleAccumulatorPtr acc, rl2PixelPtr no_data)
 {
 /* computing INT8 tile statistics */
     int x;
@@ -6179,6 +5360,7 @@ update_int8_stats (unsigned short width, unsigned short height,
     unsigned char pixel_type;
     unsigned char nbands;
     int ignore_no_data = 1;
+    double count = 0.0;
 
     if (no_data != NULL)
       {
@@ -6216,8 +5398,9 @@ update_int8_stats (unsigned short width, unsigned short height,
 			{
 			    /* opaque pixel */
 			    double value = *p_in++;
-			    update_count_stats (st);
-			    update_stats (st, 0, value);
+			    count += 1.0;
+			    accumulate_sample (acc, value);
+			    update_histogram_8bit (st, 0, (int) value + 128);
 			}
 		  }
 		else
@@ -6235,8 +5418,9 @@ update_int8_stats (unsigned short width, unsigned short height,
 			    double value;
 			    p_in = p_save;
 			    value = *p_in++;
-			    update_count_stats (st);
-			    update_stats (st, 0, value);
+			    count += 1.0;
+			    accumulate_sample (acc, value);
+			    update_histogram_8bit (st, 0, (int) value + 128);
 			}
 		      else
 			{
@@ -6246,13 +5430,15 @@ update_int8_stats (unsigned short width, unsigned short height,
 		  }
 	    }
       }
+    flush_sample_accumulators (st, acc, count);
 }
 
 static void
 update_uint8_stats (unsigned short width, unsigned short height,
 		    unsigned char num_bands,
 		    const unsigned char *pixels, const unsigned char *mask,
-		    rl2PrivRasterStatisticsPtr st, rl2PixelPtr no_data)
+		    rl2PrivRasterStatisticsPtr st,
+		    rl2SampleAccumulatorPtr acc, rl2PixelPtr no_data)
 {
 /* computing UINT8 tile statistics */
     int x;
@@ -6265,6 +5451,7 @@ update_uint8_stats (unsigned short width, unsigned short height,
     unsigned char pixel_type;
     unsigned char nbands;
     int ignore_no_data = 1;
+    double count = 0.0;
 
     if (no_data != NULL)
       {
@@ -6283,6 +5470,20 @@ update_uint8_stats (unsigned short width, unsigned short height,
 	      ignore_no_data = 1;
       }
 
+    if (mask == NULL && ignore_no_data)
+      {
+	  /* fast path: all pixels are valid */
+	  int n = width * height;
+	  for (ib = 0; ib < num_bands; ib++)
+	    {
+		rl2_simd_accumulate (pixels + ib, n, 1, num_bands, acc + ib);
+		histogram_uint8_samples (pixels + ib, n, num_bands,
+					 st->band_stats + ib);
+	    }
+	  flush_sample_accumulators (st, acc, n);
+	  return;
+      }
+
     for (y = 0; y < height; y++)
       {
 	  for (x = 0; x < width; x++)
@@ -6305,11 +5506,12 @@ update_uint8_stats (unsigned short width, unsigned short height,
 		      else
 			{
 			    /* opaque pixel */
-			    update_count_stats (st);
+			    count += 1.0;
 			    for (ib = 0; ib < num_bands; ib++)
 			      {
 				  double value = *p_in++;
-				  update_stats (st, ib, value);
+				  accumulate_sample (acc + ib, value);
+				  update_histogram_8bit (st, ib, (int) value);
 			      }
 			}
 		  }
@@ -6343,12 +5545,13 @@ update_uint8_stats (unsigned short width, unsigned short height,
 		      if (match != num_bands)
 			{
 			    /* opaque pixel */
-			    update_count_stats (st);
+			    count += 1.0;
 			    p_in = p_save;
 			    for (ib = 0; ib < num_bands; ib++)
 			      {
 				  double value = *p_in++;
-				  update_stats (st, ib, value);
+				  accumulate_sample (acc + ib, value);
+				  update_histogram_8bit (st, ib, (int) value);
 			      }
 			}
 		      else
@@ -6359,16 +5562,16 @@ update_uint8_stats (unsigned short width, unsigned short height,
 		  }
 	    }
       }
+    flush_sample_accumulators (st, acc, count);
 }
 
-static void
-update_histogram (rl2PrivRasterStatisticsPtr st, int band, double value)
+static unsigned int
+histogram_index (rl2PrivBandStatisticsPtr band_st, double value)
 {
-/* updating the Histogram */
+/* returning the Histogram bin corresponding to some value */
     double interval;
     double step;
     double index;
-    rl2PrivBandStatisticsPtr band_st = st->band_stats + band;
 
     interval = band_st->max - band_st->min;
     step = interval / ((double) (band_st->nHistogram) - 1.0);
@@ -6377,7 +5580,53 @@ update_histogram (rl2PrivRasterStatisticsPtr st, int band, double value)
 	index = 0.0;
     if (index > 255.0)
 	index = 255.0;
-    *(band_st->histogram + (unsigned int) index) += 1.0;
+    return (unsigned int) index;
+}
+
+static void
+update_histogram (rl2PrivRasterStatisticsPtr st, int band, double value)
+{
+/* updating the Histogram */
+    rl2PrivBandStatisticsPtr band_st = st->band_stats + band;
+    *(band_st->histogram + histogram_index (band_st, value)) += 1.0;
+}
+
+static unsigned char *
+build_uint16_histogram_lut (rl2PrivBandStatisticsPtr band_st, int count)
+{
+/*
+/ precomputing the Histogram bin of every UINT16 value within the
+/ band's min/max range; only worth when the range is narrower than
+/ the number of samples to be counted
+*/
+    int i;
+    int range;
+    unsigned char *lut;
+    if (band_st->min > band_st->max)
+	return NULL;
+    range = (int) (band_st->max - band_st->min) + 1;
+    if (range > count)
+	return NULL;
+    lut = malloc (range);
+    if (lut == NULL)
+	return NULL;
+    for (i = 0; i < range; i++)
+	lut[i] = histogram_index (band_st, band_st->min + i);
+    return lut;
+}
+
+static void
+update_uint16_histogram (rl2PrivRasterStatisticsPtr st, int band,
+			 const unsigned char *lut, unsigned short value)
+{
+/* updating the Histogram (UINT16) */
+    rl2PrivBandStatisticsPtr band_st = st->band_stats + band;
+    if (lut == NULL)
+      {
+	  update_histogram (st, band, value);
+	  return;
+      }
+    *(band_st->histogram + lut[value - (int) (band_st->min)]) += 1.0;
 }
 
 static void
@@ -6457,7 +5706,8 @@ compute_int16_histogram (unsigned short width, unsigned short height,
 static void
 update_int16_stats (unsigned short width, unsigned short height,
 		    const short *pixels, const unsigned char *mask,
-		    rl2PrivRasterStatisticsPtr st, rl2PixelPtr no_data)
+		    rl2PrivRasterStatisticsPtr st,
+		    rl2SampleAccumulatorPtr acc, rl2PixelPtr no_data)
 {
 /* computing INT16 tile statistics */
     int x;
@@ -6469,6 +5719,7 @@ update_int16_stats (unsigned short width, unsigned short height,
     unsigned char pixel_type;
     unsigned char nbands;
     int ignore_no_data = 1;
+    double count = 0.0;
 
     if (no_data != NULL)
       {
@@ -6506,8 +5757,8 @@ update_int16_stats (unsigned short width, unsigned short height,
 			{
 			    /* opaque pixel */
 			    double value = *p_in++;
-			    update_count_stats (st);
-			    update_stats (st, 0, value);
+			    count += 1.0;
+			    accumulate_sample (acc, value);
 			}
 		  }
 		else
@@ -6525,8 +5776,8 @@ update_int16_stats (unsigned short width, unsigned short height,
 			    double value;
 			    p_in = p_save;
 			    value = *p_in++;
-			    update_count_stats (st);
-			    update_stats (st, 0, value);
+			    count += 1.0;
+			    accumulate_sample (acc, value);
 			}
 		      else
 			{
@@ -6536,6 +5787,7 @@ update_int16_stats (unsigned short width, unsigned short height,
 		  }
 	    }
       }
+    flush_sample_accumulators (st, acc, count);
     compute_int16_histogram (width, height, pixels, mask, st, no_data);
 }
 
@@ -6546,7 +5798,7 @@ compute_uint16_histogram (unsigned short width, unsigned short height,
 			  const unsigned char *mask,
 			  rl2PrivRasterStatisticsPtr st, rl2PixelPtr no_data)
 {
-/* computing INT16 tile histogram */
+/* computing UINT16 tile histogram */
     int x;
     int y;
     int ib;
@@ -6557,6 +5809,7 @@ compute_uint16_histogram (unsigned short width, unsigned short height,
     unsigned char pixel_type;
     unsigned char nbands;
     int ignore_no_data = 1;
+    unsigned char **luts;
 
     if (no_data != NULL)
       {
@@ -6572,6 +5825,13 @@ compute_uint16_histogram (unsigned short width, unsigned short height,
 	      ignore_no_data = 1;
       }
 
+    luts = malloc (sizeof (unsigned char *) * num_bands);
+    if (luts == NULL)
+	return;
+    for (ib = 0; ib < num_bands; ib++)
+	*(luts + ib) =
+	    build_uint16_histogram_lut (st->band_stats + ib, width * height);
+
     for (y = 0; y < height; y++)
       {
 	  for (x = 0; x < width; x++)
@@ -6595,8 +5855,8 @@ compute_uint16_histogram (unsigned short width, unsigned short height,
 			    /* opaque pixel */
 			    for (ib = 0; ib < num_bands; ib++)
 			      {
-				  double value = *p_in++;
-				  update_histogram (st, ib, value);
+				  update_uint16_histogram (st, ib, *(luts + ib),
+							   *p_in++);
 			      }
 			}
 		  }
@@ -6618,20 +5878,27 @@ compute_uint16_histogram (unsigned short width, unsigned short height,
 			    p_in = p_save;
 			    for (ib = 0; ib < num_bands; ib++)
 			      {
-				  double value = *p_in++;
-				  update_histogram (st, ib, value);
+				  update_uint16_histogram (st, ib, *(luts + ib),
+							   *p_in++);
 			      }
 			}
 		  }
 	    }
       }
+    for (ib = 0; ib < num_bands; ib++)
+      {
+	  if (*(luts + ib) != NULL)
+	      free (*(luts + ib));
+      }
+    free (luts);
 }
 
 static void
 update_uint16_stats (unsigned short width, unsigned short height,
 		     unsigned char num_bands,
 		     const unsigned short *pixels, const unsigned char *mask,
-		     rl2PrivRasterStatisticsPtr st, rl2PixelPtr no_data)
+		     rl2PrivRasterStatisticsPtr st,
+		     rl2SampleAccumulatorPtr acc, rl2PixelPtr no_data)
 {
 /* computing UINT16 tile statistics */
     int x;
@@ -6644,6 +5911,7 @@ update_uint16_stats (unsigned short width, unsigned short height,
     unsigned char pixel_type;
     unsigned char nbands;
     int ignore_no_data = 1;
+    double count = 0.0;
 
     if (no_data != NULL)
       {
@@ -6659,6 +5927,18 @@ update_uint16_stats (unsigned short width, unsigned short height,
 	      ignore_no_data = 1;
       }
 
+    if (mask == NULL && ignore_no_data)
+      {
+	  /* fast path: all pixels are valid */
+	  int n = width * height;
+	  for (ib = 0; ib < num_bands; ib++)
+	      rl2_simd_accumulate (pixels + ib, n, 2, num_bands, acc + ib);
+	  flush_sample_accumulators (st, acc, n);
+	  compute_uint16_histogram (width, height, num_bands, pixels, mask, st,
+				    no_data);
+	  return;
+      }
+
     for (y = 0; y < height; y++)
       {
 	  for (x = 0; x < width; x++)
@@ -6681,11 +5961,11 @@ update_uint16_stats (unsigned short width, unsigned short height,
 		      else
 			{
 			    /* opaque pixel */
-			    update_count_stats (st);
+			    count += 1.0;
 			    for (ib = 0; ib < num_bands; ib++)
 			      {
 				  double value = *p_in++;
-				  update_stats (st, ib, value);
+				  accumulate_sample (acc + ib, value);
 			      }
 			}
 		  }
@@ -6704,12 +5984,12 @@ update_uint16_stats (unsigned short width, unsigned short height,
 		      if (match != num_bands)
 			{
 			    /* opaque pixel */
-			    update_count_stats (st);
+			    count += 1.0;
 			    p_in = p_save;
 			    for (ib = 0; ib < num_bands; ib++)
 			      {
 				  double value = *p_in++;
-				  update_stats (st, ib, value);
+				  accumulate_sample (acc + ib, value);
 			      }
 			}
 		      else
@@ -6720,6 +6000,7 @@ update_uint16_stats (unsigned short width, unsigned short height,
 		  }
 	    }
       }
+    flush_sample_accumulators (st, acc, count);
     compute_uint16_histogram (width, height, num_bands, pixels, mask, st,
 			      no_data);
 }
@@ -6801,7 +6082,8 @@ compute_int32_histogram (unsigned short width, unsigned short height,
 static void
 update_int32_stats (unsigned short width, unsigned short height,
 		    const int *pixels, const unsigned char *mask,
-		    rl2PrivRasterStatisticsPtr st, rl2PixelPtr no_data)
+		    rl2PrivRasterStatisticsPtr st,
+		    rl2SampleAccumulatorPtr acc, rl2PixelPtr no_data)
 {
 /* computing INT32 tile statistics */
     int x;
@@ -6813,6 +6095,7 @@ update_int32_stats (unsigned short width, unsigned short height,
     unsigned char pixel_type;
     unsigned char nbands;
     int ignore_no_data = 1;
+    double count = 0.0;
 
     if (no_data != NULL)
       {
@@ -6850,8 +6133,8 @@ update_int32_stats (unsigned short width, unsigned short height,
 			{
 			    /* opaque pixel */
 			    double value = *p_in++;
-			    update_count_stats (st);
-			    update_stats (st, 0, value);
+			    count += 1.0;
+			    accumulate_sample (acc, value);
 			}
 		  }
 		else
@@ -6869,8 +6152,8 @@ update_int32_stats (unsigned short width, unsigned short height,
 			    double value;
 			    p_in = p_save;
 			    value = *p_in++;
-			    update_count_stats (st);
-			    update_stats (st, 0, value);
+			    count += 1.0;
+			    accumulate_sample (acc, value);
 			}
 		      else
 			{
@@ -6880,6 +6163,7 @@ update_int32_stats (unsigned short width, unsigned short height,
 		  }
 	    }
       }
+    flush_sample_accumulators (st, acc, count);
     compute_int32_histogram (width, height, pixels, mask, st, no_data);
 }
 
@@ -6961,7 +6245,8 @@ compute_uint32_histogram (unsigned short width, unsigned short height,
 static void
 update_uint32_stats (unsigned short width, unsigned short height,
 		     const unsigned int *pixels, const unsigned char *mask,
-		     rl2PrivRasterStatisticsPtr st, rl2PixelPtr no_data)
+		     rl2PrivRasterStatisticsPtr st,
+		     rl2SampleAccumulatorPtr acc, rl2PixelPtr no_data)
 {
 /* computing UINT32 tile statistics */
     int x;
@@ -6973,6 +6258,7 @@ update_uint32_stats (unsigned short width, unsigned short height,
     unsigned char pixel_type;
     unsigned char nbands;
     int ignore_no_data = 1;
+    double count = 0.0;
 
     if (no_data != NULL)
       {
@@ -7010,8 +6296,8 @@ update_uint32_stats (unsigned short width, unsigned short height,
 			{
 			    /* opaque pixel */
 			    double value = *p_in++;
-			    update_count_stats (st);
-			    update_stats (st, 0, value);
+			    count += 1.0;
+			    accumulate_sample (acc, value);
 			}
 		  }
 		else
@@ -7029,8 +6315,8 @@ update_uint32_stats (unsigned short width, unsigned short height,
 			    double value;
 			    p_in = p_save;
 			    value = *p_in++;
-			    update_count_stats (st);
-			    update_stats (st, 0, value);
+			    count += 1.0;
+			    accumulate_sample (acc, value);
 			}
 		      else
 			{
@@ -7040,6 +6326,7 @@ update_uint32_stats (unsigned short width, unsigned short height,
 		  }
 	    }
       }
+    flush_sample_accumulators (st, acc, count);
     compute_uint32_histogram (width, height, pixels, mask, st, no_data);
 }
 
@@ -7120,7 +6407,8 @@ compute_float_histogram (unsigned short width, unsigned short height,
 static void
 update_float_stats (unsigned short width, unsigned short height,
 		    const float *pixels, const unsigned char *mask,
-		    rl2PrivRasterStatisticsPtr st, rl2PixelPtr no_data)
+		    rl2PrivRasterStatisticsPtr st,
+		    rl2SampleAccumulatorPtr acc, rl2PixelPtr no_data)
 {
 /* computing FLOAT tile statistics */
     int x;
@@ -7132,6 +6420,7 @@ update_float_stats (unsigned short width, unsigned short height,
     unsigned char pixel_type;
     unsigned char nbands;
     int ignore_no_data = 1;
+    double count = 0.0;
 
     if (no_data != NULL)
       {
@@ -7169,8 +6458,8 @@ update_float_stats (unsigned short width, unsigned short height,
 			{
 			    /* opaque pixel */
 			    double value = *p_in++;
-			    update_count_stats (st);
-			    update_stats (st, 0, value);
+			    count += 1.0;
+			    accumulate_sample (acc, value);
 			}
 		  }
 		else
@@ -7188,8 +6477,8 @@ update_float_stats (unsigned short width, unsigned short height,
 			    double value;
 			    p_in = p_save;
 			    value = *p_in++;
-			    update_count_stats (st);
-			    update_stats (st, 0, value);
+			    count += 1.0;
+			    accumulate_sample (acc, value);
 			}
 		      else
 			{
@@ -7199,6 +6488,7 @@ update_float_stats (unsigned short width, unsigned short height,
 		  }
 	    }
       }
+    flush_sample_accumulators (st, acc, count);
     compute_float_histogram (width, height, pixels, mask, st, no_data);
 }
 
@@ -7279,7 +6569,8 @@ compute_double_histogram (unsigned short width, unsigned short height,
 static void
 update_double_stats (unsigned short width, unsigned short height,
 		     const double *pixels, const unsigned char *mask,
-		     rl2PrivRasterStatisticsPtr st, rl2PixelPtr no_data)
+		     rl2PrivRasterStatisticsPtr st,
+		     rl2SampleAccumulatorPtr acc, rl2PixelPtr no_data)
 {
 /* computing DOUBLE tile statistics */
     int x;
@@ -7291,6 +6582,7 @@ update_double_stats (unsigned short width, unsigned short height,
     unsigned char pixel_type;
     unsigned char nbands;
     int ignore_no_data = 1;
+    double count = 0.0;
 
     if (no_data != NULL)
       {
@@ -7328,8 +6620,8 @@ update_double_stats (unsigned short width, unsigned short height,
 			{
 			    /* opaque pixel */
 			    double value = *p_in++;
-			    update_count_stats (st);
-			    update_stats (st, 0, value);
+			    count += 1.0;
+			    accumulate_sample (acc, value);
 			}
 		  }
 		else
@@ -7347,8 +6639,8 @@ update_double_stats (unsigned short width, unsigned short height,
 			    double value;
 			    p_in = p_save;
 			    value = *p_in++;
-			    update_count_stats (st);
-			    update_stats (st, 0, value);
+			    count += 1.0;
+			    accumulate_sample (acc, value);
 			}
 		      else
 			{
@@ -7358,6 +6650,7 @@ update_double_stats (unsigned short width, unsigned short height,
 		  }
 	    }
       }
+    flush_sample_accumulators (st, acc, count);
     compute_double_histogram (width, height, pixels, mask, st, no_data);
 }
 
@@ -7370,6 +6663,7 @@ rl2_build_raster_statistics (rl2RasterPtr raster, rl2PixelPtr noData)
     rl2PrivRasterStatisticsPtr st;
     rl2RasterStatisticsPtr stats = NULL;
     rl2PrivRasterPtr rst;
+    rl2SampleAccumulatorPtr acc = NULL;
     if (raster == NULL)
 	goto error;
     rst = (rl2PrivRasterPtr) raster;
@@ -7378,6 +6672,10 @@ rl2_build_raster_statistics (rl2RasterPtr raster, rl2PixelPtr noData)
     if (stats == NULL)
 	goto error;
     st = (rl2PrivRasterStatisticsPtr) stats;
+    acc = malloc (sizeof (rl2SampleAccumulator) * rst->nBands);
+    if (acc == NULL)
+	goto error;
+    reset_sample_accumulators (acc, rst->nBands);
 
     switch (rst->sampleType)
       {
@@ -7387,47 +6685,50 @@ rl2_build_raster_statistics (rl2RasterPtr raster, rl2PixelPtr noData)
       case RL2_SAMPLE_UINT8:
 	  update_uint8_stats (rst->width, rst->height, rst->nBands,
 			      (const unsigned char *) (rst->rasterBuffer),
-			      rst->maskBuffer, st, noData);
+			      rst->maskBuffer, st, acc, noData);
 	  break;
       case RL2_SAMPLE_INT8:
 	  update_int8_stats (rst->width, rst->height,
 			     (const char *) (rst->rasterBuffer),
-			     rst->maskBuffer, st, noData);
+			     rst->maskBuffer, st, acc, noData);
 	  break;
       case RL2_SAMPLE_UINT16:
 	  update_uint16_stats (rst->width, rst->height, rst->nBands,
 			       (const unsigned short *) (rst->rasterBuffer),
-			       rst->maskBuffer, st, noData);
+			       rst->maskBuffer, st, acc, noData);
 	  break;
       case RL2_SAMPLE_INT16:
 	  update_int16_stats (rst->width, rst->height,
 			      (const short *) (rst->rasterBuffer),
-			      rst->maskBuffer, st, noData);
+			      rst->maskBuffer, st, acc, noData);
 	  break;
       case RL2_SAMPLE_UINT32:
 	  update_uint32_stats (rst->width, rst->height,
 			       (const unsigned int *) (rst->rasterBuffer),
-			       rst->maskBuffer, st, noData);
+			       rst->maskBuffer, st, acc, noData);
 	  break;
       case RL2_SAMPLE_INT32:
 	  update_int32_stats (rst->width, rst->height,
 			      (const int *) (rst->rasterBuffer),
-			      rst->maskBuffer, st, noData);
+			      rst->maskBuffer, st, acc, noData);
 	  break;
       case RL2_SAMPLE_FLOAT:
 	  update_float_stats (rst->width, rst->height,
 			      (const float *) (rst->rasterBuffer),
-			      rst->maskBuffer, st, noData);
+			      rst->maskBuffer, st, acc, noData);
 	  break;
       case RL2_SAMPLE_DOUBLE:
 	  update_double_stats (rst->width, rst->height,
 			       (const double *) (rst->rasterBuffer),
-			       rst->maskBuffer, st, noData);
+			       rst->maskBuffer, st, acc, noData);
 	  break;
       };
+    free (acc);
     return stats;
 
   error:
+    if (acc != NULL)
+	free (acc);
     if (stats != NULL)
 	rl2_destroy_raster_statistics (stats);
     return NULL;
@@ -8604,6 +7905,61 @@ rl2_delta_decode (unsigned char *buffer, int size, int distance)
     return RL2_ERROR;
 }
 
+RL2_PRIVATE void
+rl2_float_predictor_encode (const unsigned char *in, unsigned char *out,
+			    int size, int sample_size, int little_endian)
+{
+/* 
+/ FloatPredictor: splitting the IEEE samples into byte planes, then
+/ replacing each sample by its integer difference from the previous
+/ one (computed on the raw bit patterns, so that it's fully lossless)
+*/
+    int i;
+    int k;
+    int count = size / sample_size;
+    rl2_byte_shuffle (in, out, size, sample_size);
+    for (i = count - 1; i > 0; i--)
+      {
+	  int borrow = 0;
+	  for (k = 0; k < sample_size; k++)
+	    {
+		/* from the least significant plane up to the most significant */
+		int plane = little_endian ? k : (sample_size - 1 - k);
+		unsigned char *p = out + (plane * count) + i;
+		int diff = (int) *p - (int) *(p - 1) - borrow;
+		borrow = (diff < 0) ? 1 : 0;
+		*p = (unsigned char) (diff & 0xff);
+	    }
+      }
+}
+
+RL2_PRIVATE void
+rl2_float_predictor_decode (unsigned char *in, unsigned char *out,
+			    int size, int sample_size, int little_endian)
+{
+/* 
+/ reverting the FloatPredictor: the byte planes of the input
+/ buffer are restored in place before being unshuffled
+*/
+    int i;
+    int k;
+    int count = size / sample_size;
+    for (i = 1; i < count; i++)
+      {
+	  int carry = 0;
+	  for (k = 0; k < sample_size; k++)
+	    {
+		/* from the least significant plane up to the most significant */
+		int plane = little_endian ? k : (sample_size - 1 - k);
+		unsigned char *p = in + (plane * count) + i;
+		int sum = (int) *p + (int) *(p - 1) + carry;
+		carry = sum >> 8;
+		*p = (unsigned char) (sum & 0xff);
+	    }
+      }
+    rl2_byte_unshuffle (in, out, size, sample_size);
+}
+
 RL2_DECLARE const char *
 rl2_zlib_version (void)
 {
@@ -8626,3 +7982,31 @@ rl2_lzma_version (void)
     return version;
 #endif
 }
+
+RL2_DECLARE const char *
+rl2_lz4_version (void)
+{
+/* returning the LZ4 version string */
+    static char version[128];
+#ifndef OMIT_LZ4
+    sprintf (version, "liblz4 %s", LZ4_versionString ());
+    return version;
+#else
+    strcpy (version, "unsupported");
+    return version;
+#endif
+}
+
+RL2_DECLARE const char *
+rl2_zstd_version (void)
+{
+/* returning the Zstandard version string */
+    static char version[128];
+#ifndef OMIT_ZSTD
+    sprintf (version, "libzstd %s", ZSTD_versionString ());
+    return version;
+#else
+    strcpy (version, "unsupported");
+    return version;
+#endif
+}
@@ -44,6 +44,7 @@ the terms of any one of the MPL, the GPL or the LGPL.
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <math.h>
 #include <float.h>
 
 #if defined(_WIN32) && !defined(__MINGW32__)
@@ -187,6 +188,27 @@ insert_into_raster_coverages (sqlite3 * handle, const char *coverage,
       case RL2_COMPRESSION_LZMA_NO:
 	  xcompression = "LZMA_NO";
 	  break;
+      case RL2_COMPRESSION_ZSTD:
+	  xcompression = "ZSTD";
+	  break;
+      case RL2_COMPRESSION_ZSTD_NO:
+	  xcompression = "ZSTD_NO";
+	  break;
+      case RL2_COMPRESSION_LZ4:
+	  xcompression = "LZ4";
+	  break;
+      case RL2_COMPRESSION_LZ4_NO:
+	  xcompression = "LZ4_NO";
+	  break;
+      case RL2_COMPRESSION_DEFLATE_FP:
+	  xcompression = "DEFLATE_FP";
+	  break;
+      case RL2_COMPRESSION_LZMA_FP:
+	  xcompression = "LZMA_FP";
+	  break;
+      case RL2_COMPRESSION_ZSTD_FP:
+	  xcompression = "ZSTD_FP";
+	  break;
       case RL2_COMPRESSION_PNG:
 	  xcompression = "PNG";
 	  break;
@@ -527,6 +549,122 @@ create_sections (sqlite3 * handle, const char *coverage, int srid)
     return 1;
 }
 
+static int
+create_tile_data_table (sqlite3 * handle, const char *coverage)
+{
+/* creating the TILE_DATA table */
+    int ret;
+    char *sql;
+    char *sql_err = NULL;
+    char *xcoverage;
+    char *xxcoverage;
+    char *xfk;
+    char *xxfk;
+    char *xmother;
+    char *xxmother;
+
+    xcoverage = sqlite3_mprintf ("%s_tile_data", coverage);
+    xxcoverage = rl2_double_quoted_sql (xcoverage);
+    sqlite3_free (xcoverage);
+    xmother = sqlite3_mprintf ("%s_tiles", coverage);
+    xxmother = rl2_double_quoted_sql (xmother);
+    sqlite3_free (xmother);
+    xfk = sqlite3_mprintf ("fk_%s_tile_data", coverage);
+    xxfk = rl2_double_quoted_sql (xfk);
+    sqlite3_free (xfk);
+    sql = sqlite3_mprintf ("CREATE TABLE \"%s\" ("
+			   "\ttile_id INTEGER NOT NULL PRIMARY KEY,\n"
+			   "\ttile_data_odd BLOB NOT NULL,\n"
+			   "\ttile_data_even BLOB,\n"
+			   "CONSTRAINT \"%s\" FOREIGN KEY (tile_id) "
+			   "REFERENCES \"%s\" (tile_id) ON DELETE CASCADE)",
+			   xxcoverage, xxfk, xxmother);
+    free (xxfk);
+    free (xxmother);
+    ret = sqlite3_exec (handle, sql, NULL, NULL, &sql_err);
+    sqlite3_free (sql);
+    if (ret != SQLITE_OK)
+      {
+	  fprintf (stderr, "CREATE TABLE \"%s_tile_data\" error: %s\n",
+		   xxcoverage, sql_err);
+	  sqlite3_free (sql_err);
+	  free (xxcoverage);
+	  return 0;
+      }
+    free (xxcoverage);
+    return 1;
+}
+
+static int
+create_tile_data_triggers (sqlite3 * handle, const char *coverage)
+{
+/* adding the safeguard Triggers to the TILE_DATA table */
+    int ret;
+    char *sql;
+    char *sql_err = NULL;
+    char *xcoverage;
+    char *xtrigger;
+    char *xxtrigger;
+    char *xtiles;
+    char *xxtiles;
+
+    xtrigger = sqlite3_mprintf ("%s_tile_data_insert", coverage);
+    xxtrigger = rl2_double_quoted_sql (xtrigger);
+    sqlite3_free (xtrigger);
+    xcoverage = sqlite3_mprintf ("%s_tile_data", coverage);
+    xtiles = sqlite3_mprintf ("%s_tiles", coverage);
+    xxtiles = rl2_double_quoted_sql (xtiles);
+    sqlite3_free (xtiles);
+    sql = sqlite3_mprintf ("CREATE TRIGGER \"%s\"\n"
+			   "BEFORE INSERT ON %Q\nFOR EACH ROW BEGIN\n"
+			   "SELECT RAISE(ABORT,'insert on %s violates constraint: "
+			   "invalid tile_data')\nWHERE IsValidRasterTile(NULL, %Q, "
+			   "(SELECT t.pyramid_level FROM \"%s\" AS t WHERE t.tile_id = NEW.tile_id), "
+			   "NEW.tile_data_odd, NEW.tile_data_even) <> 1;\nEND",
+			   xxtrigger, xcoverage, xcoverage, coverage, xxtiles);
+    sqlite3_free (xcoverage);
+    free (xxtiles);
+    ret = sqlite3_exec (handle, sql, NULL, NULL, &sql_err);
+    sqlite3_free (sql);
+    if (ret != SQLITE_OK)
+      {
+	  fprintf (stderr, "CREATE TRIGGER \"%s\" error: %s\n", xxtrigger,
+		   sql_err);
+	  sqlite3_free (sql_err);
+	  free (xxtrigger);
+	  return 0;
+      }
+    free (xxtrigger);
+    xtrigger = sqlite3_mprintf ("%s_tile_data_update", coverage);
+    xxtrigger = rl2_double_quoted_sql (xtrigger);
+    sqlite3_free (xtrigger);
+    xcoverage = sqlite3_mprintf ("%s_tile_data", coverage);
+    xtiles = sqlite3_mprintf ("%s_tiles", coverage);
+    xxtiles = rl2_double_quoted_sql (xtiles);
+    sqlite3_free (xtiles);
+    sql = sqlite3_mprintf ("CREATE TRIGGER \"%s\"\n"
+			   "BEFORE UPDATE ON %Q\nFOR EACH ROW BEGIN\n"
+			   "SELECT RAISE(ABORT, 'update on %s violates constraint: "
+			   "invalid tile_data')\nWHERE IsValidRasterTile(NULL, %Q, "
+			   "(SELECT t.pyramid_level FROM \"%s\" AS t WHERE t.tile_id = NEW.tile_id), "
+			   "NEW.tile_data_odd, NEW.tile_data_even) <> 1;\nEND",
+			   xxtrigger, xcoverage, xcoverage, coverage, xxtiles);
+    sqlite3_free (xcoverage);
+    free (xxtiles);
+    ret = sqlite3_exec (handle, sql, NULL, NULL, &sql_err);
+    sqlite3_free (sql);
+    if (ret != SQLITE_OK)
+      {
+	  fprintf (stderr, "CREATE TRIGGER \"%s\" error: %s\n", xxtrigger,
+		   sql_err);
+	  sqlite3_free (sql_err);
+	  free (xxtrigger);
+	  return 0;
+      }
+    free (xxtrigger);
+    return 1;
+}
+
 static int
 create_tiles (sqlite3 * handle, const char *coverage, int srid,
 	      int mixed_resolutions)
@@ -547,10 +685,6 @@ create_tiles (sqlite3 * handle, const char *coverage, int srid,
     char *xxfk2;
     char *xmother2;
     char *xxmother2;
-    char *xtrigger;
-    char *xxtrigger;
-    char *xtiles;
-    char *xxtiles;
 
     xcoverage = sqlite3_mprintf ("%s_tiles", coverage);
     xxcoverage = rl2_double_quoted_sql (xcoverage);
@@ -690,92 +824,9 @@ create_tiles (sqlite3 * handle, const char *coverage, int srid,
     free (xxindex);
 
 /* creating the TILE_DATA table */
-    xcoverage = sqlite3_mprintf ("%s_tile_data", coverage);
-    xxcoverage = rl2_double_quoted_sql (xcoverage);
-    sqlite3_free (xcoverage);
-    xmother = sqlite3_mprintf ("%s_tiles", coverage);
-    xxmother = rl2_double_quoted_sql (xmother);
-    sqlite3_free (xmother);
-    xfk = sqlite3_mprintf ("fk_%s_tile_data", coverage);
-    xxfk = rl2_double_quoted_sql (xfk);
-    sqlite3_free (xfk);
-    sql = sqlite3_mprintf ("CREATE TABLE \"%s\" ("
-			   "\ttile_id INTEGER NOT NULL PRIMARY KEY,\n"
-			   "\ttile_data_odd BLOB NOT NULL,\n"
-			   "\ttile_data_even BLOB,\n"
-			   "CONSTRAINT \"%s\" FOREIGN KEY (tile_id) "
-			   "REFERENCES \"%s\" (tile_id) ON DELETE CASCADE)",
-			   xxcoverage, xxfk, xxmother);
-    free (xxfk);
-    free (xxmother);
-    ret = sqlite3_exec (handle, sql, NULL, NULL, &sql_err);
-    sqlite3_free (sql);
-    if (ret != SQLITE_OK)
-      {
-	  fprintf (stderr, "CREATE TABLE \"%s_tile_data\" error: %s\n",
-		   xxcoverage, sql_err);
-	  sqlite3_free (sql_err);
-	  free (xxcoverage);
-	  return 0;
-      }
-    free (xxcoverage);
-
-/* adding the safeguard Triggers */
-    xtrigger = sqlite3_mprintf ("%s_tile_data_insert", coverage);
-    xxtrigger = rl2_double_quoted_sql (xtrigger);
-    sqlite3_free (xtrigger);
-    xcoverage = sqlite3_mprintf ("%s_tile_data", coverage);
-    xtiles = sqlite3_mprintf ("%s_tiles", coverage);
-    xxtiles = rl2_double_quoted_sql (xtiles);
-    sqlite3_free (xtiles);
-    sql = sqlite3_mprintf ("CREATE TRIGGER \"%s\"\n"
-			   "BEFORE INSERT ON %Q\nFOR EACH ROW BEGIN\n"
-			   "SELECT RAISE(ABORT,'insert on %s violates constraint: "
-			   "invalid tile_data')\nWHERE IsValidRasterTile(NULL, %Q, "
-			   "(SELECT t.pyramid_level FROM \"%s\" AS t WHERE t.tile_id = NEW.tile_id), "
-			   "NEW.tile_data_odd, NEW.tile_data_even) <> 1;\nEND",
-			   xxtrigger, xcoverage, xcoverage, coverage, xxtiles);
-    sqlite3_free (xcoverage);
-    free (xxtiles);
-    ret = sqlite3_exec (handle, sql, NULL, NULL, &sql_err);
-    sqlite3_free (sql);
-    if (ret != SQLITE_OK)
-      {
-	  fprintf (stderr, "CREATE TRIGGER \"%s\" error: %s\n", xxtrigger,
-		   sql_err);
-	  sqlite3_free (sql_err);
-	  free (xxtrigger);
-	  return 0;
-      }
-    free (xxtrigger);
-    xtrigger = sqlite3_mprintf ("%s_tile_data_update", coverage);
-    xxtrigger = rl2_double_quoted_sql (xtrigger);
-    sqlite3_free (xtrigger);
-    xcoverage = sqlite3_mprintf ("%s_tile_data", coverage);
-    xtiles = sqlite3_mprintf ("%s_tiles", coverage);
-    xxtiles = rl2_double_quoted_sql (xtiles);
-    sqlite3_free (xtiles);
-    sql = sqlite3_mprintf ("CREATE TRIGGER \"%s\"\n"
-			   "BEFORE UPDATE ON %Q\nFOR EACH ROW BEGIN\n"
-			   "SELECT RAISE(ABORT, 'update on %s violates constraint: "
-			   "invalid tile_data')\nWHERE IsValidRasterTile(NULL, %Q, "
-			   "(SELECT t.pyramid_level FROM \"%s\" AS t WHERE t.tile_id = NEW.tile_id), "
-			   "NEW.tile_data_odd, NEW.tile_data_even) <> 1;\nEND",
-			   xxtrigger, xcoverage, xcoverage, coverage, xxtiles);
-    sqlite3_free (xcoverage);
-    free (xxtiles);
-    ret = sqlite3_exec (handle, sql, NULL, NULL, &sql_err);
-    sqlite3_free (sql);
-    if (ret != SQLITE_OK)
-      {
-	  fprintf (stderr, "CREATE TRIGGER \"%s\" error: %s\n", xxtrigger,
-		   sql_err);
-	  sqlite3_free (sql_err);
-	  free (xxtrigger);
-	  return 0;
-      }
-    free (xxtrigger);
-    return 1;
+    if (!create_tile_data_table (handle, coverage))
+	return 0;
+    return create_tile_data_triggers (handle, coverage);
 }
 
 RL2_DECLARE int
@@ -1208,6 +1259,663 @@ rl2_is_dbms_coverage_auto_ndvi_enabled (sqlite3 * handle, const char *db_prefix,
     return RL2_ERROR;
 }
 
+RL2_DECLARE int
+rl2_is_dbms_coverage_split_tiles_enabled (sqlite3 * handle,
+					  const char *db_prefix,
+					  const char *coverage)
+{
+/* 
+/  checking if the ODD and EVEN blocks of some Coverage are stored into
+/  two separate tables (<coverage>_tile_data then being a View)
+/  returns RL2_TRUE or RL2_FALSE; RL2_ERROR if no such Coverage exists
+*/
+    int ret;
+    sqlite3_stmt *stmt = NULL;
+    char *sql;
+    char *xdb_prefix;
+    char *table;
+    int split = RL2_ERROR;
+
+    if (coverage == NULL)
+	return RL2_ERROR;
+    if (db_prefix == NULL)
+	db_prefix = "MAIN";
+    xdb_prefix = rl2_double_quoted_sql (db_prefix);
+    sql = sqlite3_mprintf ("SELECT type FROM \"%s\".sqlite_master "
+			   "WHERE Lower(name) = Lower(?)", xdb_prefix);
+    free (xdb_prefix);
+    ret = sqlite3_prepare_v2 (handle, sql, strlen (sql), &stmt, NULL);
+    sqlite3_free (sql);
+    if (ret != SQLITE_OK)
+      {
+	  printf ("SELECT IsEnabled Split Tiles SQL error: %s\n",
+		  sqlite3_errmsg (handle));
+	  return RL2_ERROR;
+      }
+
+    table = sqlite3_mprintf ("%s_tile_data", coverage);
+    sqlite3_reset (stmt);
+    sqlite3_clear_bindings (stmt);
+    sqlite3_bind_text (stmt, 1, table, strlen (table), sqlite3_free);
+    while (1)
+      {
+	  ret = sqlite3_step (stmt);
+	  if (ret == SQLITE_DONE)
+	      break;
+	  if (ret == SQLITE_ROW)
+	    {
+		const char *type = (const char *) sqlite3_column_text (stmt, 0);
+		if (strcasecmp (type, "view") == 0)
+		    split = RL2_TRUE;
+		else if (strcasecmp (type, "table") == 0)
+		    split = RL2_FALSE;
+	    }
+	  else
+	    {
+		fprintf (stderr,
+			 "SELECT IsEnabled Split Tiles; sqlite3_step() error: %s\n",
+			 sqlite3_errmsg (handle));
+		split = RL2_ERROR;
+		break;
+	    }
+      }
+    sqlite3_finalize (stmt);
+    return split;
+}
+
+static int
+exec_tile_data_sql (sqlite3 * handle, char *sql)
+{
+/* executing (and then freeing) some TILE_DATA layout SQL statement */
+    int ret;
+    char *sql_err = NULL;
+    ret = sqlite3_exec (handle, sql, NULL, NULL, &sql_err);
+    if (ret != SQLITE_OK)
+      {
+	  fprintf (stderr, "%s\nerror: %s\n", sql, sql_err);
+	  sqlite3_free (sql_err);
+	  sqlite3_free (sql);
+	  return 0;
+      }
+    sqlite3_free (sql);
+    return 1;
+}
+
+static int
+drop_split_tile_data (sqlite3 * handle, const char *coverage)
+{
+/* dropping the TILE_DATA View and both the ODD and EVEN tables */
+    char *table;
+    char *xtable;
+    char *sql;
+
+    table = sqlite3_mprintf ("%s_tile_data", coverage);
+    xtable = rl2_double_quoted_sql (table);
+    sqlite3_free (table);
+    sql = sqlite3_mprintf ("DROP VIEW main.\"%s\"", xtable);
+    free (xtable);
+    if (!exec_tile_data_sql (handle, sql))
+	return 0;
+    table = sqlite3_mprintf ("%s_tile_data_even", coverage);
+    xtable = rl2_double_quoted_sql (table);
+    sqlite3_free (table);
+    sql = sqlite3_mprintf ("DROP TABLE main.\"%s\"", xtable);
+    free (xtable);
+    if (!exec_tile_data_sql (handle, sql))
+	return 0;
+    table = sqlite3_mprintf ("%s_tile_data_odd", coverage);
+    xtable = rl2_double_quoted_sql (table);
+    sqlite3_free (table);
+    sql = sqlite3_mprintf ("DROP TABLE main.\"%s\"", xtable);
+    free (xtable);
+    return exec_tile_data_sql (handle, sql);
+}
+
+static int
+do_split_tile_data (sqlite3 * handle, const char *coverage)
+{
+/* 
+/  moving the ODD and EVEN blocks into two separate tables; the ODD
+/  blocks are copied first, so to be densely packed on their own pages
+/  <coverage>_tile_data then becomes a View (always joining the EVEN
+/  blocks by a LEFT JOIN on their Primary Key, that SQLite will simply
+/  skip whenever tile_data_even isn't referenced at all)
+*/
+    int ok = 0;
+    char *sql;
+    char *data = NULL;
+    char *odd = NULL;
+    char *even = NULL;
+    char *tiles = NULL;
+    char *fk_odd = NULL;
+    char *fk_even = NULL;
+    char *trg_ins = NULL;
+    char *trg_upd = NULL;
+    char *trg_del = NULL;
+    char *xname;
+
+    xname = sqlite3_mprintf ("%s_tile_data", coverage);
+    data = rl2_double_quoted_sql (xname);
+    sqlite3_free (xname);
+    xname = sqlite3_mprintf ("%s_tile_data_odd", coverage);
+    odd = rl2_double_quoted_sql (xname);
+    sqlite3_free (xname);
+    xname = sqlite3_mprintf ("%s_tile_data_even", coverage);
+    even = rl2_double_quoted_sql (xname);
+    sqlite3_free (xname);
+    xname = sqlite3_mprintf ("%s_tiles", coverage);
+    tiles = rl2_double_quoted_sql (xname);
+    sqlite3_free (xname);
+    xname = sqlite3_mprintf ("fk_%s_tile_data_odd", coverage);
+    fk_odd = rl2_double_quoted_sql (xname);
+    sqlite3_free (xname);
+    xname = sqlite3_mprintf ("fk_%s_tile_data_even", coverage);
+    fk_even = rl2_double_quoted_sql (xname);
+    sqlite3_free (xname);
+    xname = sqlite3_mprintf ("%s_tile_data_insert", coverage);
+    trg_ins = rl2_double_quoted_sql (xname);
+    sqlite3_free (xname);
+    xname = sqlite3_mprintf ("%s_tile_data_update", coverage);
+    trg_upd = rl2_double_quoted_sql (xname);
+    sqlite3_free (xname);
+    xname = sqlite3_mprintf ("%s_tile_data_delete", coverage);
+    trg_del = rl2_double_quoted_sql (xname);
+    sqlite3_free (xname);
+
+/* creating the ODD and EVEN tables */
+    sql = sqlite3_mprintf ("CREATE TABLE main.\"%s\" ("
+			   "\ttile_id INTEGER NOT NULL PRIMARY KEY,\n"
+			   "\ttile_data_odd BLOB NOT NULL,\n"
+			   "CONSTRAINT \"%s\" FOREIGN KEY (tile_id) "
+			   "REFERENCES \"%s\" (tile_id) ON DELETE CASCADE)",
+			   odd, fk_odd, tiles);
+    if (!exec_tile_data_sql (handle, sql))
+	goto end;
+    sql = sqlite3_mprintf ("CREATE TABLE main.\"%s\" ("
+			   "\ttile_id INTEGER NOT NULL PRIMARY KEY,\n"
+			   "\ttile_data_even BLOB NOT NULL,\n"
+			   "CONSTRAINT \"%s\" FOREIGN KEY (tile_id) "
+			   "REFERENCES \"%s\" (tile_id) ON DELETE CASCADE)",
+			   even, fk_even, tiles);
+    if (!exec_tile_data_sql (handle, sql))
+	goto end;
+
+/* moving the Tile blocks */
+    sql = sqlite3_mprintf ("INSERT INTO main.\"%s\" (tile_id, tile_data_odd) "
+			   "SELECT tile_id, tile_data_odd FROM main.\"%s\" "
+			   "ORDER BY tile_id", odd, data);
+    if (!exec_tile_data_sql (handle, sql))
+	goto end;
+    sql =
+	sqlite3_mprintf ("INSERT INTO main.\"%s\" (tile_id, tile_data_even) "
+			 "SELECT tile_id, tile_data_even FROM main.\"%s\" "
+			 "WHERE tile_data_even IS NOT NULL ORDER BY tile_id",
+			 even, data);
+    if (!exec_tile_data_sql (handle, sql))
+	goto end;
+    sql = sqlite3_mprintf ("DROP TABLE main.\"%s\"", data);
+    if (!exec_tile_data_sql (handle, sql))
+	goto end;
+
+/* creating the TILE_DATA View and its Triggers */
+    sql = sqlite3_mprintf ("CREATE VIEW main.\"%s\" AS "
+			   "SELECT o.tile_id AS tile_id, o.tile_data_odd AS tile_data_odd, "
+			   "e.tile_data_even AS tile_data_even FROM \"%s\" AS o "
+			   "LEFT JOIN \"%s\" AS e ON (e.tile_id = o.tile_id)",
+			   data, odd, even);
+    if (!exec_tile_data_sql (handle, sql))
+	goto end;
+    sql = sqlite3_mprintf ("CREATE TRIGGER main.\"%s\"\n"
+			   "INSTEAD OF INSERT ON \"%s\"\nFOR EACH ROW BEGIN\n"
+			   "SELECT RAISE(ABORT,'insert on %s_tile_data violates constraint: "
+			   "invalid tile_data')\nWHERE IsValidRasterTile(NULL, %Q, "
+			   "(SELECT t.pyramid_level FROM \"%s\" AS t WHERE t.tile_id = NEW.tile_id), "
+			   "NEW.tile_data_odd, NEW.tile_data_even) <> 1;\n"
+			   "INSERT INTO \"%s\" (tile_id, tile_data_odd) "
+			   "VALUES (NEW.tile_id, NEW.tile_data_odd);\n"
+			   "INSERT INTO \"%s\" (tile_id, tile_data_even) "
+			   "SELECT NEW.tile_id, NEW.tile_data_even "
+			   "WHERE NEW.tile_data_even IS NOT NULL;\nEND",
+			   trg_ins, data, coverage, coverage, tiles, odd, even);
+    if (!exec_tile_data_sql (handle, sql))
+	goto end;
+    sql = sqlite3_mprintf ("CREATE TRIGGER main.\"%s\"\n"
+			   "INSTEAD OF UPDATE ON \"%s\"\nFOR EACH ROW BEGIN\n"
+			   "SELECT RAISE(ABORT, 'update on %s_tile_data violates constraint: "
+			   "invalid tile_data')\nWHERE IsValidRasterTile(NULL, %Q, "
+			   "(SELECT t.pyramid_level FROM \"%s\" AS t WHERE t.tile_id = NEW.tile_id), "
+			   "NEW.tile_data_odd, NEW.tile_data_even) <> 1;\n"
+			   "DELETE FROM \"%s\" WHERE tile_id = OLD.tile_id;\n"
+			   "UPDATE \"%s\" SET tile_id = NEW.tile_id, "
+			   "tile_data_odd = NEW.tile_data_odd WHERE tile_id = OLD.tile_id;\n"
+			   "INSERT INTO \"%s\" (tile_id, tile_data_even) "
+			   "SELECT NEW.tile_id, NEW.tile_data_even "
+			   "WHERE NEW.tile_data_even IS NOT NULL;\nEND",
+			   trg_upd, data, coverage, coverage, tiles, even, odd,
+			   even);
+    if (!exec_tile_data_sql (handle, sql))
+	goto end;
+    sql = sqlite3_mprintf ("CREATE TRIGGER main.\"%s\"\n"
+			   "INSTEAD OF DELETE ON \"%s\"\nFOR EACH ROW BEGIN\n"
+			   "DELETE FROM \"%s\" WHERE tile_id = OLD.tile_id;\n"
+			   "DELETE FROM \"%s\" WHERE tile_id = OLD.tile_id;\nEND",
+			   trg_del, data, even, odd);
+    if (!exec_tile_data_sql (handle, sql))
+	goto end;
+    ok = 1;
+
+  end:
+    free (data);
+    free (odd);
+    free (even);
+    free (tiles);
+    free (fk_odd);
+    free (fk_even);
+    free (trg_ins);
+    free (trg_upd);
+    free (trg_del);
+    return ok;
+}
+
+static int
+do_merge_tile_data (sqlite3 * handle, const char *coverage)
+{
+/* restoring the standard layout: a single TILE_DATA table */
+    int ok = 0;
+    char *sql;
+    char *data = NULL;
+    char *odd = NULL;
+    char *even = NULL;
+    char *xname;
+
+    xname = sqlite3_mprintf ("%s_tile_data", coverage);
+    data = rl2_double_quoted_sql (xname);
+    sqlite3_free (xname);
+    xname = sqlite3_mprintf ("%s_tile_data_odd", coverage);
+    odd = rl2_double_quoted_sql (xname);
+    sqlite3_free (xname);
+    xname = sqlite3_mprintf ("%s_tile_data_even", coverage);
+    even = rl2_double_quoted_sql (xname);
+    sqlite3_free (xname);
+
+    sql = sqlite3_mprintf ("DROP VIEW main.\"%s\"", data);
+    if (!exec_tile_data_sql (handle, sql))
+	goto end;
+    if (!create_tile_data_table (handle, coverage))
+	goto end;
+    sql = sqlite3_mprintf ("INSERT INTO main.\"%s\" "
+			   "(tile_id, tile_data_odd, tile_data_even) "
+			   "SELECT o.tile_id, o.tile_data_odd, e.tile_data_even "
+			   "FROM main.\"%s\" AS o LEFT JOIN main.\"%s\" AS e "
+			   "ON (e.tile_id = o.tile_id) ORDER BY o.tile_id",
+			   data, odd, even);
+    if (!exec_tile_data_sql (handle, sql))
+	goto end;
+    sql = sqlite3_mprintf ("DROP TABLE main.\"%s\"", even);
+    if (!exec_tile_data_sql (handle, sql))
+	goto end;
+    sql = sqlite3_mprintf ("DROP TABLE main.\"%s\"", odd);
+    if (!exec_tile_data_sql (handle, sql))
+	goto end;
+    if (!create_tile_data_triggers (handle, coverage))
+	goto end;
+    ok = 1;
+
+  end:
+    free (data);
+    free (odd);
+    free (even);
+    return ok;
+}
+
+RL2_DECLARE int
+rl2_enable_dbms_coverage_split_tiles (sqlite3 * handle, const char *coverage,
+				      int on_off)
+{
+/* 
+/  enabling or disabling the Split Tiles layout of some Coverage,
+/  i.e. storing the ODD and EVEN blocks into two separate tables
+/  all Tiles already stored in the Coverage are migrated; this
+/  always happens within a SAVEPOINT, so to be an atomic change
+*/
+    int ret;
+    int split;
+
+    split = rl2_is_dbms_coverage_split_tiles_enabled (handle, NULL, coverage);
+    if (split == RL2_ERROR)
+	return RL2_ERROR;
+    if (on_off && split == RL2_TRUE)
+	return RL2_OK;
+    if (!on_off && split == RL2_FALSE)
+	return RL2_OK;
+
+    ret = sqlite3_exec (handle, "SAVEPOINT rl2_split_tiles", NULL, NULL, NULL);
+    if (ret != SQLITE_OK)
+	return RL2_ERROR;
+    if (on_off)
+	ret = do_split_tile_data (handle, coverage);
+    else
+	ret = do_merge_tile_data (handle, coverage);
+    if (!ret)
+      {
+	  sqlite3_exec (handle, "ROLLBACK TO rl2_split_tiles", NULL, NULL,
+			NULL);
+	  sqlite3_exec (handle, "RELEASE rl2_split_tiles", NULL, NULL, NULL);
+	  return RL2_ERROR;
+      }
+    ret = sqlite3_exec (handle, "RELEASE rl2_split_tiles", NULL, NULL, NULL);
+    if (ret != SQLITE_OK)
+	return RL2_ERROR;
+    return RL2_OK;
+}
+
+RL2_PRIVATE int
+rl2_enable_dirty_regions (sqlite3 * handle, const char *coverage)
+{
+/* 
+/  creating (if not already existing) the DIRTY_REGIONS table of some
+/  Coverage, and the Triggers recording there the extent of any Section
+/  being INSERTed or DELETEd since the last Monolithic Pyramid update
+*/
+    char *sql;
+    char *xname;
+    char *regions;
+    char *sections;
+    char *trg_ins;
+    char *trg_del;
+    int ok = 0;
+
+    xname = sqlite3_mprintf ("%s_dirty_regions", coverage);
+    regions = rl2_double_quoted_sql (xname);
+    sqlite3_free (xname);
+    xname = sqlite3_mprintf ("%s_sections", coverage);
+    sections = rl2_double_quoted_sql (xname);
+    sqlite3_free (xname);
+    xname = sqlite3_mprintf ("%s_sections_dirty_insert", coverage);
+    trg_ins = rl2_double_quoted_sql (xname);
+    sqlite3_free (xname);
+    xname = sqlite3_mprintf ("%s_sections_dirty_delete", coverage);
+    trg_del = rl2_double_quoted_sql (xname);
+    sqlite3_free (xname);
+
+    sql = sqlite3_mprintf ("CREATE TABLE IF NOT EXISTS main.\"%s\" ("
+			   "\tregion_id INTEGER PRIMARY KEY AUTOINCREMENT,\n"
+			   "\tminx DOUBLE NOT NULL,\n"
+			   "\tminy DOUBLE NOT NULL,\n"
+			   "\tmaxx DOUBLE NOT NULL,\n"
+			   "\tmaxy DOUBLE NOT NULL)", regions);
+    if (!exec_tile_data_sql (handle, sql))
+	goto end;
+    sql = sqlite3_mprintf ("CREATE TRIGGER IF NOT EXISTS main.\"%s\"\n"
+			   "AFTER INSERT ON \"%s\"\nFOR EACH ROW BEGIN\n"
+			   "INSERT INTO \"%s\" (minx, miny, maxx, maxy) "
+			   "SELECT MbrMinX(NEW.geometry), MbrMinY(NEW.geometry), "
+			   "MbrMaxX(NEW.geometry), MbrMaxY(NEW.geometry) "
+			   "WHERE NEW.geometry IS NOT NULL;\nEND",
+			   trg_ins, sections, regions);
+    if (!exec_tile_data_sql (handle, sql))
+	goto end;
+    sql = sqlite3_mprintf ("CREATE TRIGGER IF NOT EXISTS main.\"%s\"\n"
+			   "AFTER DELETE ON \"%s\"\nFOR EACH ROW BEGIN\n"
+			   "INSERT INTO \"%s\" (minx, miny, maxx, maxy) "
+			   "SELECT MbrMinX(OLD.geometry), MbrMinY(OLD.geometry), "
+			   "MbrMaxX(OLD.geometry), MbrMaxY(OLD.geometry) "
+			   "WHERE OLD.geometry IS NOT NULL;\nEND",
+			   trg_del, sections, regions);
+    if (!exec_tile_data_sql (handle, sql))
+	goto end;
+    ok = 1;
+
+  end:
+    free (regions);
+    free (sections);
+    free (trg_ins);
+    free (trg_del);
+    return ok;
+}
+
+RL2_PRIVATE int
+rl2_parse_resampling_name (const char *name, unsigned char *resampling)
+{
+/* parsing a Pyramid Resampling name */
+    if (name == NULL)
+	return 0;
+    if (strcasecmp (name, "DEFAULT") == 0)
+	*resampling = RL2_RESAMPLING_DEFAULT;
+    else if (strcasecmp (name, "AVERAGE") == 0)
+	*resampling = RL2_RESAMPLING_AVERAGE;
+    else if (strcasecmp (name, "NEAREST") == 0)
+	*resampling = RL2_RESAMPLING_NEAREST;
+    else if (strcasecmp (name, "MODE") == 0)
+	*resampling = RL2_RESAMPLING_MODE;
+    else if (strcasecmp (name, "BILINEAR") == 0)
+	*resampling = RL2_RESAMPLING_BILINEAR;
+    else if (strcasecmp (name, "CUBIC") == 0)
+	*resampling = RL2_RESAMPLING_CUBIC;
+    else
+	return 0;
+    return 1;
+}
+
+RL2_PRIVATE const char *
+rl2_resampling_name (unsigned char resampling)
+{
+/* returning the name of some Pyramid Resampling */
+    switch (resampling)
+      {
+      case RL2_RESAMPLING_DEFAULT:
+	  return "DEFAULT";
+      case RL2_RESAMPLING_AVERAGE:
+	  return "AVERAGE";
+      case RL2_RESAMPLING_NEAREST:
+	  return "NEAREST";
+      case RL2_RESAMPLING_MODE:
+	  return "MODE";
+      case RL2_RESAMPLING_BILINEAR:
+	  return "BILINEAR";
+      case RL2_RESAMPLING_CUBIC:
+	  return "CUBIC";
+      };
+    return NULL;
+}
+
+static int
+check_resampling_table (sqlite3 * handle, const char *db_prefix)
+{
+/* checking if the COVERAGE_RESAMPLING table does exist */
+    int ret;
+    char *sql;
+    char *xdb_prefix;
+    char **results;
+    int rows;
+    int columns;
+    int exists = 0;
+
+    if (db_prefix == NULL)
+	db_prefix = "MAIN";
+    xdb_prefix = rl2_double_quoted_sql (db_prefix);
+    sql = sqlite3_mprintf ("SELECT name FROM \"%s\".sqlite_master "
+			   "WHERE type = 'table' AND "
+			   "Lower(name) = 'rl2_coverage_resampling'",
+			   xdb_prefix);
+    free (xdb_prefix);
+    ret = sqlite3_get_table (handle, sql, &results, &rows, &columns, NULL);
+    sqlite3_free (sql);
+    if (ret != SQLITE_OK)
+	return 0;
+    if (rows > 0)
+	exists = 1;
+    sqlite3_free_table (results);
+    return exists;
+}
+
+RL2_DECLARE int
+rl2_set_dbms_coverage_resampling (sqlite3 * handle, const char *coverage,
+				  unsigned char resampling)
+{
+/* 
+/  setting up the Resampling policy used when building the Pyramid
+/  of some Coverage; the rl2_coverage_resampling table will be
+/  automatically created if not already existing
+*/
+    int ret;
+    sqlite3_stmt *stmt = NULL;
+    const char *sql;
+    const char *name;
+    int count = 0;
+
+    name = rl2_resampling_name (resampling);
+    if (name == NULL || coverage == NULL)
+	return RL2_ERROR;
+
+    sql = "SELECT coverage_name FROM main.raster_coverages "
+	"WHERE Lower(coverage_name) = Lower(?)";
+    ret = sqlite3_prepare_v2 (handle, sql, strlen (sql), &stmt, NULL);
+    if (ret != SQLITE_OK)
+      {
+	  printf ("SELECT Coverage Resampling SQL error: %s\n",
+		  sqlite3_errmsg (handle));
+	  goto error;
+      }
+    sqlite3_reset (stmt);
+    sqlite3_clear_bindings (stmt);
+    sqlite3_bind_text (stmt, 1, coverage, strlen (coverage), SQLITE_STATIC);
+    while (1)
+      {
+	  ret = sqlite3_step (stmt);
+	  if (ret == SQLITE_DONE)
+	      break;
+	  if (ret == SQLITE_ROW)
+	      count++;
+	  else
+	    {
+		fprintf (stderr,
+			 "SELECT Coverage Resampling; sqlite3_step() error: %s\n",
+			 sqlite3_errmsg (handle));
+		goto error;
+	    }
+      }
+    sqlite3_finalize (stmt);
+    stmt = NULL;
+    if (count != 1)
+	goto error;
+
+    if (!exec_tile_data_sql
+	(handle,
+	 sqlite3_mprintf
+	 ("CREATE TABLE IF NOT EXISTS main.rl2_coverage_resampling (\n"
+	  "\tcoverage_name TEXT NOT NULL PRIMARY KEY,\n"
+	  "\tresampling TEXT NOT NULL CHECK (Upper(resampling) IN "
+	  "('DEFAULT', 'AVERAGE', 'NEAREST', 'MODE', 'BILINEAR', 'CUBIC')))")))
+	goto error;
+
+    sql = "INSERT OR REPLACE INTO main.rl2_coverage_resampling "
+	"(coverage_name, resampling) VALUES (Lower(?), ?)";
+    ret = sqlite3_prepare_v2 (handle, sql, strlen (sql), &stmt, NULL);
+    if (ret != SQLITE_OK)
+      {
+	  printf ("INSERT Coverage Resampling SQL error: %s\n",
+		  sqlite3_errmsg (handle));
+	  goto error;
+      }
+    sqlite3_reset (stmt);
+    sqlite3_clear_bindings (stmt);
+    sqlite3_bind_text (stmt, 1, coverage, strlen (coverage), SQLITE_STATIC);
+    sqlite3_bind_text (stmt, 2, name, strlen (name), SQLITE_STATIC);
+    ret = sqlite3_step (stmt);
+    if (ret == SQLITE_DONE || ret == SQLITE_ROW)
+	;
+    else
+      {
+	  fprintf (stderr,
+		   "sqlite3_step() error: INSERT Coverage Resampling \"%s\"\n",
+		   sqlite3_errmsg (handle));
+	  goto error;
+      }
+    sqlite3_finalize (stmt);
+    return RL2_OK;
+
+  error:
+    if (stmt != NULL)
+	sqlite3_finalize (stmt);
+    return RL2_ERROR;
+}
+
+RL2_DECLARE int
+rl2_get_dbms_coverage_resampling (sqlite3 * handle, const char *db_prefix,
+				  const char *coverage,
+				  unsigned char *resampling)
+{
+/* 
+/  retrieving the Resampling policy used when building the Pyramid
+/  of some Coverage; RL2_RESAMPLING_DEFAULT if never set
+/  RL2_ERROR if no such Coverage exists
+*/
+    int ret;
+    sqlite3_stmt *stmt = NULL;
+    char *sql;
+    char *xdb_prefix;
+    int count = 0;
+    unsigned char value = RL2_RESAMPLING_DEFAULT;
+
+    if (coverage == NULL)
+	return RL2_ERROR;
+    if (db_prefix == NULL)
+	db_prefix = "MAIN";
+    xdb_prefix = rl2_double_quoted_sql (db_prefix);
+    if (check_resampling_table (handle, db_prefix))
+	sql =
+	    sqlite3_mprintf
+	    ("SELECT r.resampling FROM \"%s\".raster_coverages AS c "
+	     "LEFT JOIN \"%s\".rl2_coverage_resampling AS r "
+	     "ON (r.coverage_name = Lower(c.coverage_name)) "
+	     "WHERE Lower(c.coverage_name) = Lower(?)", xdb_prefix,
+	     xdb_prefix);
+    else
+	sql = sqlite3_mprintf ("SELECT NULL FROM \"%s\".raster_coverages "
+			       "WHERE Lower(coverage_name) = Lower(?)",
+			       xdb_prefix);
+    free (xdb_prefix);
+    ret = sqlite3_prepare_v2 (handle, sql, strlen (sql), &stmt, NULL);
+    sqlite3_free (sql);
+    if (ret != SQLITE_OK)
+      {
+	  printf ("SELECT Coverage Resampling SQL error: %s\n",
+		  sqlite3_errmsg (handle));
+	  return RL2_ERROR;
+      }
+    sqlite3_reset (stmt);
+    sqlite3_clear_bindings (stmt);
+    sqlite3_bind_text (stmt, 1, coverage, strlen (coverage), SQLITE_STATIC);
+    while (1)
+      {
+	  ret = sqlite3_step (stmt);
+	  if (ret == SQLITE_DONE)
+	      break;
+	  if (ret == SQLITE_ROW)
+	    {
+		if (sqlite3_column_type (stmt, 0) == SQLITE_TEXT)
+		    rl2_parse_resampling_name ((const char *)
+					       sqlite3_column_text (stmt, 0),
+					       &value);
+		count++;
+	    }
+	  else
+	    {
+		fprintf (stderr,
+			 "SELECT Coverage Resampling; sqlite3_step() error: %s\n",
+			 sqlite3_errmsg (handle));
+		sqlite3_finalize (stmt);
+		return RL2_ERROR;
+	    }
+      }
+    sqlite3_finalize (stmt);
+    if (count != 1)
+	return RL2_ERROR;
+    *resampling = value;
+    return RL2_OK;
+}
+
 static int
 resolve_base_resolution_section (sqlite3 * handle, const char *db_prefix,
 				 const char *coverage, sqlite3_int64 section_id,
@@ -1590,6 +2298,7 @@ rl2_delete_dbms_section (sqlite3 * handle, const char *coverage,
 	  goto error;
       }
     sqlite3_finalize (stmt);
+    rl2_invalidate_tile_cache (handle, NULL, coverage);
 
     rl2_destroy_coverage (cvg);
     return RL2_OK;
@@ -1677,20 +2386,31 @@ rl2_drop_dbms_coverage (sqlite3 * handle, const char *coverage)
     sqlite3_free (table);
 
 /* dropping the TILE_DATA table */
-    table = sqlite3_mprintf ("%s_tile_data", coverage);
-    xtable = rl2_double_quoted_sql (table);
-    sql = sqlite3_mprintf ("DROP TABLE main.\"%s\"", xtable);
-    free (xtable);
-    ret = sqlite3_exec (handle, sql, NULL, NULL, &sql_err);
-    sqlite3_free (sql);
-    if (ret != SQLITE_OK)
+    if (rl2_is_dbms_coverage_split_tiles_enabled (handle, NULL, coverage) ==
+	RL2_TRUE)
       {
-	  fprintf (stderr, "DROP TABLE \"%s\" error: %s\n", table, sql_err);
-	  sqlite3_free (sql_err);
+	  /* Split Tiles: dropping the View and both ODD and EVEN tables */
+	  if (!drop_split_tile_data (handle, coverage))
+	      goto error;
+      }
+    else
+      {
+	  table = sqlite3_mprintf ("%s_tile_data", coverage);
+	  xtable = rl2_double_quoted_sql (table);
+	  sql = sqlite3_mprintf ("DROP TABLE main.\"%s\"", xtable);
+	  free (xtable);
+	  ret = sqlite3_exec (handle, sql, NULL, NULL, &sql_err);
+	  sqlite3_free (sql);
+	  if (ret != SQLITE_OK)
+	    {
+		fprintf (stderr, "DROP TABLE \"%s\" error: %s\n", table,
+			 sql_err);
+		sqlite3_free (sql_err);
+		sqlite3_free (table);
+		goto error;
+	    }
 	  sqlite3_free (table);
-	  goto error;
       }
-    sqlite3_free (table);
 
 /* deleting the TILES Geometry definition */
     table = sqlite3_mprintf ("%s_tiles", coverage);
@@ -1742,6 +2462,39 @@ rl2_drop_dbms_coverage (sqlite3 * handle, const char *coverage)
       }
     sqlite3_free (table);
 
+/* dropping the DIRTY_REGIONS table (if any) */
+    table = sqlite3_mprintf ("%s_dirty_regions", coverage);
+    xtable = rl2_double_quoted_sql (table);
+    sql = sqlite3_mprintf ("DROP TABLE IF EXISTS main.\"%s\"", xtable);
+    free (xtable);
+    ret = sqlite3_exec (handle, sql, NULL, NULL, &sql_err);
+    sqlite3_free (sql);
+    if (ret != SQLITE_OK)
+      {
+	  fprintf (stderr, "DROP TABLE \"%s\" error: %s\n", table, sql_err);
+	  sqlite3_free (sql_err);
+	  sqlite3_free (table);
+	  goto error;
+      }
+    sqlite3_free (table);
+
+/* deleting the Pyramid Resampling policy (if any) */
+    if (check_resampling_table (handle, NULL))
+      {
+	  sql = sqlite3_mprintf ("DELETE FROM main.rl2_coverage_resampling "
+				 "WHERE coverage_name = Lower(%Q)", coverage);
+	  ret = sqlite3_exec (handle, sql, NULL, NULL, &sql_err);
+	  sqlite3_free (sql);
+	  if (ret != SQLITE_OK)
+	    {
+		fprintf (stderr,
+			 "DELETE rl2_coverage_resampling \"%s\" error: %s\n",
+			 coverage, sql_err);
+		sqlite3_free (sql_err);
+		goto error;
+	    }
+      }
+
 /* dropping the SECTIONS table */
     table = sqlite3_mprintf ("%s_sections", coverage);
     xtable = rl2_double_quoted_sql (table);
@@ -2175,6 +2928,7 @@ rl2_create_coverage_from_dbms (sqlite3 * handle, const char *db_prefix,
     int section_paths = 0;
     int section_md5 = 0;
     int section_summary = 0;
+    unsigned char resampling;
     int ok = 0;
     const char *value;
     rl2PixelPtr no_data = NULL;
@@ -2354,6 +3108,41 @@ rl2_create_coverage_from_dbms (sqlite3 * handle, const char *db_prefix,
 			    ok_compression = 1;
 			    compression = RL2_COMPRESSION_LZMA_NO;
 			}
+		      if (strcasecmp (value, "ZSTD") == 0)
+			{
+			    ok_compression = 1;
+			    compression = RL2_COMPRESSION_ZSTD;
+			}
+		      if (strcasecmp (value, "ZSTD_NO") == 0)
+			{
+			    ok_compression = 1;
+			    compression = RL2_COMPRESSION_ZSTD_NO;
+			}
+		      if (strcasecmp (value, "LZ4") == 0)
+			{
+			    ok_compression = 1;
+			    compression = RL2_COMPRESSION_LZ4;
+			}
+		      if (strcasecmp (value, "LZ4_NO") == 0)
+			{
+			    ok_compression = 1;
+			    compression = RL2_COMPRESSION_LZ4_NO;
+			}
+		      if (strcasecmp (value, "DEFLATE_FP") == 0)
+			{
+			    ok_compression = 1;
+			    compression = RL2_COMPRESSION_DEFLATE_FP;
+			}
+		      if (strcasecmp (value, "LZMA_FP") == 0)
+			{
+			    ok_compression = 1;
+			    compression = RL2_COMPRESSION_LZMA_FP;
+			}
+		      if (strcasecmp (value, "ZSTD_FP") == 0)
+			{
+			    ok_compression = 1;
+			    compression = RL2_COMPRESSION_ZSTD_FP;
+			}
 		      if (strcasecmp (value, "PNG") == 0)
 			{
 			    ok_compression = 1;
@@ -2506,6 +3295,16 @@ rl2_create_coverage_from_dbms (sqlite3 * handle, const char *db_prefix,
 	  rl2_destroy_coverage (cvg);
 	  return NULL;
       }
+    if (rl2_get_dbms_coverage_resampling
+	(handle, db_prefix, coverage, &resampling) != RL2_OK
+	|| rl2_set_coverage_resampling (cvg, resampling) != RL2_OK)
+      {
+	  fprintf (stderr,
+		   "ERROR: unable to set the Resampling on the Coverage Object supporting \"%s\"\n",
+		   coverage);
+	  rl2_destroy_coverage (cvg);
+	  return NULL;
+      }
     return cvg;
 }
 
@@ -3232,29 +4031,117 @@ void_raw_buffer_palette (unsigned char *buffer, unsigned int width,
       }
 }
 
+static int
+tile_view_offset (double origin, double tile_origin, double res, int *offset)
+{
+/* checking if a Tile origin exactly matches some output pixel */
+    double d = (tile_origin - origin) / res;
+    double rounded = floor (d + 0.5);
+    if (fabs (d - rounded) > 0.01)
+	return 0;
+    *offset = (int) rounded;
+    return 1;
+}
+
+static int
+prepare_tile_view (rl2AuxDecoderPtr decoder, rl2DecodeViewPtr view)
+{
+/* 
+/ checking if the Tile could be directly decoded into the output buffer,
+/ i.e. no NO-DATA, no Style to be applied and a Tile aligned on the
+/ output pixel grid; all other cases require an intermediate Raster
+*/
+    if (decoder->no_data != NULL)
+	return 0;
+    if (decoder->style != NULL && decoder->stats != NULL)
+	return 0;
+    if (!tile_view_offset
+	(decoder->minx, decoder->tile_minx, decoder->x_res, &(view->col)))
+	return 0;
+    if (!tile_view_offset
+	(decoder->tile_maxy, decoder->maxy, decoder->y_res, &(view->row)))
+	return 0;
+    view->outbuf = decoder->outbuf;
+    view->width = decoder->width;
+    view->height = decoder->height;
+    view->sample_type = decoder->sample_type;
+    view->num_bands = decoder->num_bands;
+    view->rgba_lut = NULL;
+    return rl2_is_view_decodable (decoder->blob_odd, decoder->blob_odd_sz,
+				  view);
+}
+
 static void
 do_decode_tile (rl2AuxDecoderPtr decoder)
 {
 /* servicing an AuxDecoder Tile request */
-    decoder->raster =
-	(rl2PrivRasterPtr) rl2_raster_decode (decoder->scale,
-					      decoder->blob_odd,
-					      decoder->blob_odd_sz,
-					      decoder->blob_even,
-					      decoder->blob_even_sz,
-					      (rl2PalettePtr)
-					      (decoder->palette));
-    if (decoder->blob_odd != NULL)
-	free (decoder->blob_odd);
-    if (decoder->blob_even != NULL)
-	free (decoder->blob_even);
-    decoder->blob_odd = NULL;
-    decoder->blob_even = NULL;
-    decoder->palette = NULL;
-    if (decoder->raster == NULL)
+    if (decoder->cached_tile == NULL && decoder->reader != NULL)
+      {
+	  /* reading the BLOBs by using a private read-only connection */
+	  if (rl2_read_tile_blobs
+	      (decoder->reader, decoder->cache_coverage, decoder->tile_id,
+	       (decoder->scale == RL2_SCALE_1) ? 1 : 0, &(decoder->blob_odd),
+	       &(decoder->blob_odd_sz), &(decoder->blob_even),
+	       &(decoder->blob_even_sz)) != RL2_OK)
+	    {
+		decoder->retcode = RL2_ERROR;
+		return;
+	    }
+	  if (decoder->blob_odd == NULL)
+	    {
+		/* empty Tile: nothing to be decoded */
+		decoder->retcode = RL2_OK;
+		return;
+	    }
+      }
+    if (decoder->cached_tile == NULL && decoder->cache_key == NULL)
       {
-	  decoder->retcode = RL2_ERROR;
-	  return;
+	  /* attempting to decode the Tile straight into the output buffer */
+	  rl2DecodeView view;
+	  if (prepare_tile_view (decoder, &view))
+	    {
+		int ret = rl2_raster_decode_view (decoder->scale,
+						  decoder->blob_odd,
+						  decoder->blob_odd_sz,
+						  decoder->blob_even,
+						  decoder->blob_even_sz,
+						  decoder->verify_checksum,
+						  &view);
+		if (decoder->palette != NULL)
+		    rl2_destroy_palette ((rl2PalettePtr) (decoder->palette));
+		decoder->blob_odd = NULL;
+		decoder->blob_even = NULL;
+		decoder->palette = NULL;
+		decoder->retcode = ret;
+		return;
+	    }
+      }
+    if (decoder->cached_tile == NULL)
+      {
+	  /* decoding the Tile */
+	  decoder->raster =
+	      (rl2PrivRasterPtr) rl2_raster_decode_ex (decoder->scale,
+						       decoder->blob_odd,
+						       decoder->blob_odd_sz,
+						       decoder->blob_even,
+						       decoder->blob_even_sz,
+						       (rl2PalettePtr)
+						       (decoder->palette),
+						       decoder->verify_checksum);
+	  decoder->blob_odd = NULL;
+	  decoder->blob_even = NULL;
+	  decoder->palette = NULL;
+	  if (decoder->raster == NULL)
+	    {
+		decoder->retcode = RL2_ERROR;
+		return;
+	    }
+	  /* attempting to store the decoded Tile into the Tile Cache */
+	  decoder->cached_tile =
+	      rl2_store_cached_tile (decoder->cache_key,
+				     decoder->cache_level, decoder->tile_id,
+				     decoder->scale,
+				     (rl2RasterPtr) (decoder->raster));
       }
     if (!rl2_copy_raw_pixels
 	((rl2RasterPtr) (decoder->raster), decoder->outbuf, decoder->width,
@@ -3269,7 +4156,11 @@ do_decode_tile (rl2AuxDecoderPtr decoder)
 	  decoder->retcode = RL2_ERROR;
 	  return;
       }
-    rl2_destroy_raster ((rl2RasterPtr) (decoder->raster));
+    if (decoder->cached_tile != NULL)
+	rl2_release_cached_tile (decoder->cached_tile);
+    else
+	rl2_destroy_raster ((rl2RasterPtr) (decoder->raster));
+    decoder->cached_tile = NULL;
     decoder->raster = NULL;
     decoder->retcode = RL2_OK;
 }
@@ -3284,8 +4175,6 @@ do_decode_masktile (rl2AuxMaskDecoderPtr decoder)
 						   decoder->blob_odd,
 						   decoder->blob_odd_sz,
 						   &status);
-    if (decoder->blob_odd != NULL)
-	free (decoder->blob_odd);
     decoder->blob_odd = NULL;
     if (decoder->raster == NULL)
       {
@@ -3306,326 +4195,338 @@ do_decode_masktile (rl2AuxMaskDecoderPtr decoder)
     decoder->retcode = RL2_OK;
 }
 
-#if defined(_WIN32) && !defined(__MINGW32__)
-DWORD WINAPI
-doRunDecoderThread (void *arg)
-#else
-void *
-doRunDecoderThread (void *arg)
-#endif
+static void
+doRunDecoderJob (void *arg)
 {
-/* threaded function: decoding a Tile */
+/* Job function: decoding a Tile */
     rl2AuxDecoderPtr decoder = (rl2AuxDecoderPtr) arg;
     do_decode_tile (decoder);
-#if defined(_WIN32) && !defined(__MINGW32__)
-    return 0;
-#else
-    pthread_exit (NULL);
-#endif
 }
 
-#if defined(_WIN32) && !defined(__MINGW32__)
-DWORD WINAPI
-doRunMaskDecoderThread (void *arg)
-#else
-void *
-doRunMaskDecoderThread (void *arg)
-#endif
+static void
+doRunMaskDecoderJob (void *arg)
 {
-/* threaded function: decoding a Tile */
+/* Job function: decoding a Mask Tile */
     rl2AuxMaskDecoderPtr decoder = (rl2AuxMaskDecoderPtr) arg;
     do_decode_masktile (decoder);
-#if defined(_WIN32) && !defined(__MINGW32__)
-    return 0;
-#else
-    pthread_exit (NULL);
-#endif
 }
 
-static void
-start_decoder_thread (rl2AuxDecoderPtr decoder)
+static int
+do_release_decoder (rl2AuxDecoderPtr decoder)
 {
-/* starting a concurrent thread */
-#if defined(_WIN32) && !defined(__MINGW32__)
-    HANDLE thread_handle;
-    HANDLE *p_thread;
-    DWORD dwThreadId;
-    thread_handle =
-	CreateThread (NULL, 0, doRunDecoderThread, decoder, 0, &dwThreadId);
-    SetThreadPriority (thread_handle, THREAD_PRIORITY_IDLE);
-    p_thread = malloc (sizeof (HANDLE));
-    *p_thread = thread_handle;
-    decoder->opaque_thread_id = p_thread;
-#else
-    pthread_t thread_id;
-    pthread_t *p_thread;
-    int ok_prior = 0;
-    int policy;
-    int min_prio;
-    pthread_attr_t attr;
-    struct sched_param sp;
-    pthread_attr_init (&attr);
-    if (pthread_attr_setschedpolicy (&attr, SCHED_RR) == 0)
-      {
-	  /* attempting to set the lowest priority */
-	  if (pthread_attr_getschedpolicy (&attr, &policy) == 0)
-	    {
-		min_prio = sched_get_priority_min (policy);
-		sp.sched_priority = min_prio;
-		if (pthread_attr_setschedparam (&attr, &sp) == 0)
-		  {
-		      /* ok, setting the lowest priority */
-		      ok_prior = 1;
-		      pthread_create (&thread_id, &attr, doRunDecoderThread,
-				      decoder);
-		  }
-	    }
+/* 
+/ cleaning up a completed request slot and checking for errors
+/ (the BLOB buffers are never freed here, so to be reused by the
+/ next Tile)
+*/
+    if (decoder->cached_tile != NULL)
+	rl2_release_cached_tile (decoder->cached_tile);
+    else if (decoder->raster != NULL)
+	rl2_destroy_raster ((rl2RasterPtr) (decoder->raster));
+    if (decoder->palette != NULL)
+	rl2_destroy_palette ((rl2PalettePtr) (decoder->palette));
+    decoder->cached_tile = NULL;
+    decoder->blob_odd = NULL;
+    decoder->blob_even = NULL;
+    decoder->blob_odd_sz = 0;
+    decoder->blob_even_sz = 0;
+    decoder->raster = NULL;
+    decoder->palette = NULL;
+    if (decoder->retcode != RL2_OK)
+      {
+	  fprintf (stderr, ERR_FRMT64, decoder->tile_id);
+	  return 0;
+      }
+    return 1;
+}
+
+static int
+do_copy_to_slot_buffers (rl2AuxDecoderPtr decoder)
+{
+/* 
+/ copying the BLOBs into the slot's own reusable buffers, so that they
+/ will survive until the Tile will be decoded by some worker thread
+*/
+    struct rl2_slot_buffer *pool = decoder->pool;
+    if (decoder->blob_odd != NULL)
+      {
+	  if (!rl2_grow_blob_buffer
+	      (&(pool->buf_odd), &(pool->buf_odd_max), decoder->blob_odd_sz))
+	      return 0;
+	  memcpy (pool->buf_odd, decoder->blob_odd, decoder->blob_odd_sz);
+	  decoder->blob_odd = pool->buf_odd;
       }
-    if (!ok_prior)
+    if (decoder->blob_even != NULL)
       {
-	  /* failure: using standard priority */
-	  pthread_create (&thread_id, NULL, doRunDecoderThread, decoder);
+	  if (!rl2_grow_blob_buffer
+	      (&(pool->buf_even), &(pool->buf_even_max),
+	       decoder->blob_even_sz))
+	      return 0;
+	  memcpy (pool->buf_even, decoder->blob_even, decoder->blob_even_sz);
+	  decoder->blob_even = pool->buf_even;
       }
-    p_thread = malloc (sizeof (pthread_t));
-    *p_thread = thread_id;
-    decoder->opaque_thread_id = p_thread;
-#endif
+    return 1;
 }
 
-static void
-start_mask_decoder_thread (rl2AuxMaskDecoderPtr decoder)
+static int
+do_read_to_slot_buffers (sqlite3 * handle, const char *db_prefix,
+			 const char *coverage, int split,
+			 sqlite3_blob ** blob_odd, sqlite3_blob ** blob_even,
+			 rl2AuxDecoderPtr decoder)
 {
-/* starting a concurrent thread */
-#if defined(_WIN32) && !defined(__MINGW32__)
-    HANDLE thread_handle;
-    HANDLE *p_thread;
-    DWORD dwThreadId;
-    thread_handle =
-	CreateThread (NULL, 0, doRunMaskDecoderThread, decoder, 0, &dwThreadId);
-    SetThreadPriority (thread_handle, THREAD_PRIORITY_IDLE);
-    p_thread = malloc (sizeof (HANDLE));
-    *p_thread = thread_handle;
-    decoder->opaque_thread_id = p_thread;
-#else
-    pthread_t thread_id;
-    pthread_t *p_thread;
-    int ok_prior = 0;
-    int policy;
-    int min_prio;
-    pthread_attr_t attr;
-    struct sched_param sp;
-    pthread_attr_init (&attr);
-    if (pthread_attr_setschedpolicy (&attr, SCHED_RR) == 0)
-      {
-	  /* attempting to set the lowest priority */
-	  if (pthread_attr_getschedpolicy (&attr, &policy) == 0)
+/* 
+/ reading the BLOBs of some Tile from the main connection straight into
+/ the slot's own reusable buffers
+/ 
+/ returns 0 if the ODD BLOB can't be read this way; the SELECT statement
+/ will then be used as a fallback
+*/
+    struct rl2_slot_buffer *pool = decoder->pool;
+    const char *tbl_odd = split ? "tile_data_odd" : "tile_data";
+    const char *tbl_even = split ? "tile_data_even" : "tile_data";
+    int sz;
+    if (!rl2_read_incremental_blob
+	(handle, db_prefix, coverage, tbl_odd, "tile_data_odd",
+	 decoder->tile_id, blob_odd, &(pool->buf_odd), &(pool->buf_odd_max),
+	 &sz))
+	return 0;
+    decoder->blob_odd = pool->buf_odd;
+    decoder->blob_odd_sz = sz;
+    if (decoder->scale == RL2_SCALE_1)
+      {
+	  /* the EVEN BLOB could legitimately be NULL or missing */
+	  if (rl2_read_incremental_blob
+	      (handle, db_prefix, coverage, tbl_even, "tile_data_even",
+	       decoder->tile_id, blob_even, &(pool->buf_even),
+	       &(pool->buf_even_max), &sz))
 	    {
-		min_prio = sched_get_priority_min (policy);
-		sp.sched_priority = min_prio;
-		if (pthread_attr_setschedparam (&attr, &sp) == 0)
-		  {
-		      /* ok, setting the lowest priority */
-		      ok_prior = 1;
-		      pthread_create (&thread_id, &attr, doRunMaskDecoderThread,
-				      decoder);
-		  }
+		decoder->blob_even = pool->buf_even;
+		decoder->blob_even_sz = sz;
 	    }
       }
-    if (!ok_prior)
+    return 1;
+}
+
+static void
+do_release_decoder_blobs (rl2AuxDecoderPtr aux, int num_slots,
+			  sqlite3_blob * blob_odd, sqlite3_blob * blob_even)
+{
+/* 
+/ closing all BLOB handles, both of the Tile Readers and of the main
+/ connection (all Jobs are expected to be completed); the slot buffers
+/ will be reused by the next request
+*/
+    int i;
+    rl2AuxDecoderPtr decoder;
+    for (i = 0; i < num_slots; i++)
       {
-	  /* failure: using standard priority */
-	  pthread_create (&thread_id, NULL, doRunMaskDecoderThread, decoder);
+	  decoder = aux + i;
+	  if (decoder->reader != NULL)
+	      rl2_release_tile_reader (decoder->reader);
+	  decoder->blob_odd = NULL;
+	  decoder->blob_even = NULL;
       }
-    p_thread = malloc (sizeof (pthread_t));
-    *p_thread = thread_id;
-    decoder->opaque_thread_id = p_thread;
-#endif
+    if (blob_odd != NULL)
+	sqlite3_blob_close (blob_odd);
+    if (blob_even != NULL)
+	sqlite3_blob_close (blob_even);
 }
 
 static int
-do_run_decoder_children (rl2AuxDecoderPtr * thread_slots, int thread_count)
+do_recycle_decoders (rl2WorkerBatchPtr batch, rl2AuxDecoderPtr aux,
+		     int num_slots, rl2AuxDecoderPtr * free_slots,
+		     int *free_count)
 {
-/* concurrent execution of all decoder children threads */
-    rl2AuxDecoderPtr decoder;
+/* waiting for the next decoder Job to complete, then recycling its slot */
     int i;
-#if defined(_WIN32) && !defined(__MINGW32__)
-    HANDLE *handles;
-#endif
-
-    for (i = 0; i < thread_count; i++)
+    rl2AuxDecoderPtr decoder = rl2_next_completed_worker_job (batch);
+    if (decoder != NULL)
       {
-	  /* starting all children threads */
-	  decoder = *(thread_slots + i);
-	  start_decoder_thread (decoder);
+	  *(free_slots + *free_count) = decoder;
+	  *free_count += 1;
+	  return do_release_decoder (decoder);
       }
 
-/* waiting until all child threads exit */
-#if defined(_WIN32) && !defined(__MINGW32__)
-    handles = malloc (sizeof (HANDLE) * thread_count);
-    for (i = 0; i < thread_count; i++)
-      {
-	  /* initializing the HANDLEs array */
-	  HANDLE *pOpaque;
-	  decoder = *(thread_slots + i);
-	  pOpaque = (HANDLE *) (decoder->opaque_thread_id);
-	  *(handles + i) = *pOpaque;
-      }
-    WaitForMultipleObjects (thread_count, handles, TRUE, INFINITE);
-    free (handles);
-#else
-    for (i = 0; i < thread_count; i++)
+/* no Job is still pending: all slots are now available */
+    *free_count = 0;
+    for (i = 0; i < num_slots; i++)
       {
-	  pthread_t *pOpaque;
-	  decoder = *(thread_slots + i);
-	  pOpaque = (pthread_t *) (decoder->opaque_thread_id);
-	  pthread_join (*pOpaque, NULL);
+	  decoder = aux + i;
+	  *(free_slots + i) = decoder;
+	  *free_count += 1;
+	  if (!do_release_decoder (decoder))
+	      return 0;
       }
-#endif
+    return 1;
+}
 
-/* all children threads have now finished: resuming the main thread */
-    for (i = 0; i < thread_count; i++)
-      {
-	  /* cleaning up a request slot */
-	  decoder = *(thread_slots + i);
-	  if (decoder->blob_odd != NULL)
-	      free (decoder->blob_odd);
-	  if (decoder->blob_even != NULL)
-	      free (decoder->blob_even);
-	  if (decoder->raster != NULL)
-	      rl2_destroy_raster ((rl2RasterPtr) (decoder->raster));
-	  if (decoder->palette != NULL)
-	      rl2_destroy_palette ((rl2PalettePtr) (decoder->palette));
-	  if (decoder->opaque_thread_id != NULL)
-	      free (decoder->opaque_thread_id);
-	  decoder->blob_odd = NULL;
-	  decoder->blob_even = NULL;
-	  decoder->blob_odd_sz = 0;
-	  decoder->blob_even_sz = 0;
-	  decoder->raster = NULL;
-	  decoder->palette = NULL;
-	  decoder->opaque_thread_id = NULL;
-      }
-    for (i = 0; i < thread_count; i++)
+static int
+do_release_mask_decoder (rl2AuxMaskDecoderPtr decoder)
+{
+/* cleaning up a completed mask request slot and checking for errors */
+    if (decoder->raster != NULL)
+	rl2_destroy_raster ((rl2RasterPtr) (decoder->raster));
+    decoder->blob_odd = NULL;
+    decoder->blob_odd_sz = 0;
+    decoder->raster = NULL;
+    if (decoder->retcode != RL2_OK)
       {
-	  /* checking for eventual errors */
-	  decoder = *(thread_slots + i);
-	  if (decoder->retcode != RL2_OK)
-	    {
-		fprintf (stderr, ERR_FRMT64, decoder->tile_id);
-		goto error;
-	    }
+	  fprintf (stderr, ERR_FRMT64, decoder->tile_id);
+	  return 0;
       }
     return 1;
+}
 
-  error:
-    return 0;
+static int
+do_read_mask_to_slot_buffer (sqlite3 * handle, const char *db_prefix,
+			     const char *coverage, int split,
+			     sqlite3_blob ** blob_odd,
+			     rl2AuxMaskDecoderPtr decoder)
+{
+/* 
+/ reading the ODD BLOB of some mask Tile from the main connection
+/ straight into the slot's own reusable buffer
+/ 
+/ returns 0 if the BLOB can't be read this way; the SELECT statement
+/ will then be used as a fallback
+*/
+    struct rl2_slot_buffer *pool = decoder->pool;
+    const char *tbl_odd = split ? "tile_data_odd" : "tile_data";
+    int sz;
+    if (!rl2_read_incremental_blob
+	(handle, db_prefix, coverage, tbl_odd, "tile_data_odd",
+	 decoder->tile_id, blob_odd, &(pool->buf_odd), &(pool->buf_odd_max),
+	 &sz))
+	return 0;
+    decoder->blob_odd = pool->buf_odd;
+    decoder->blob_odd_sz = sz;
+    return 1;
 }
 
 static int
-do_run_mask_decoder_children (rl2AuxMaskDecoderPtr * thread_slots,
-			      int thread_count)
+do_recycle_mask_decoders (rl2WorkerBatchPtr batch, rl2AuxMaskDecoderPtr aux,
+			  int num_slots, rl2AuxMaskDecoderPtr * free_slots,
+			  int *free_count)
 {
-/* concurrent execution of all mask decoder children threads */
-    rl2AuxMaskDecoderPtr decoder;
+/* waiting for the next mask decoder Job to complete, then recycling its slot */
     int i;
-#if defined(_WIN32) && !defined(__MINGW32__)
-    HANDLE *handles;
-#endif
-
-    for (i = 0; i < thread_count; i++)
+    rl2AuxMaskDecoderPtr decoder = rl2_next_completed_worker_job (batch);
+    if (decoder != NULL)
       {
-	  /* starting all children threads */
-	  decoder = *(thread_slots + i);
-	  start_mask_decoder_thread (decoder);
+	  *(free_slots + *free_count) = decoder;
+	  *free_count += 1;
+	  return do_release_mask_decoder (decoder);
       }
 
-/* waiting until all child threads exit */
-#if defined(_WIN32) && !defined(__MINGW32__)
-    handles = malloc (sizeof (HANDLE) * thread_count);
-    for (i = 0; i < thread_count; i++)
+/* no Job is still pending: all slots are now available */
+    *free_count = 0;
+    for (i = 0; i < num_slots; i++)
       {
-	  /* initializing the HANDLEs array */
-	  HANDLE *pOpaque;
-	  decoder = *(thread_slots + i);
-	  pOpaque = (HANDLE *) (decoder->opaque_thread_id);
-	  *(handles + i) = *pOpaque;
+	  decoder = aux + i;
+	  *(free_slots + i) = decoder;
+	  *free_count += 1;
+	  if (!do_release_mask_decoder (decoder))
+	      return 0;
       }
-    WaitForMultipleObjects (thread_count, handles, TRUE, INFINITE);
-    free (handles);
-#else
-    for (i = 0; i < thread_count; i++)
+    return 1;
+}
+
+static int
+do_drain_decoders (rl2WorkerBatchPtr batch, rl2AuxDecoderPtr aux,
+		   int num_slots)
+{
+/* waiting until all decoder Jobs have been completed */
+    int i;
+    int ok = 1;
+    rl2_wait_worker_batch (batch);
+    for (i = 0; i < num_slots; i++)
       {
-	  pthread_t *pOpaque;
-	  decoder = *(thread_slots + i);
-	  pOpaque = (pthread_t *) (decoder->opaque_thread_id);
-	  pthread_join (*pOpaque, NULL);
+	  if (!do_release_decoder (aux + i))
+	      ok = 0;
       }
-#endif
+    return ok;
+}
 
-/* all children threads have now finished: resuming the main thread */
-    for (i = 0; i < thread_count; i++)
-      {
-	  /* cleaning up a request slot */
-	  decoder = *(thread_slots + i);
-	  if (decoder->blob_odd != NULL)
-	      free (decoder->blob_odd);
-	  if (decoder->raster != NULL)
-	      rl2_destroy_raster ((rl2RasterPtr) (decoder->raster));
-	  if (decoder->opaque_thread_id != NULL)
-	      free (decoder->opaque_thread_id);
-	  decoder->blob_odd = NULL;
-	  decoder->blob_odd_sz = 0;
-	  decoder->raster = NULL;
-	  decoder->opaque_thread_id = NULL;
-      }
-    for (i = 0; i < thread_count; i++)
+static int
+do_drain_mask_decoders (rl2WorkerBatchPtr batch, rl2AuxMaskDecoderPtr aux,
+			int num_slots)
+{
+/* waiting until all mask decoder Jobs have been completed */
+    int i;
+    int ok = 1;
+    rl2_wait_worker_batch (batch);
+    for (i = 0; i < num_slots; i++)
       {
-	  /* checking for eventual errors */
-	  decoder = *(thread_slots + i);
-	  if (decoder->retcode != RL2_OK)
-	    {
-		fprintf (stderr, ERR_FRMT64, decoder->tile_id);
-		goto error;
-	    }
+	  if (!do_release_mask_decoder (aux + i))
+	      ok = 0;
       }
-    return 1;
-
-  error:
-    return 0;
+    return ok;
 }
 
 static int
-rl2_load_dbms_masktiles (sqlite3 * handle, int max_threads, int by_section,
-			 sqlite3_int64 section_id, sqlite3_stmt * stmt_tiles,
-			 sqlite3_stmt * stmt_data, unsigned char *maskbuf,
-			 unsigned int width, unsigned int height, double x_res,
-			 double y_res, double minx, double miny, double maxx,
-			 double maxy, int level, int scale)
+rl2_load_dbms_masktiles (sqlite3 * handle, const void *data, int max_threads,
+			 const char *db_prefix, const char *coverage,
+			 int by_section, sqlite3_int64 section_id,
+			 sqlite3_stmt * stmt_tiles, sqlite3_stmt * stmt_data,
+			 unsigned char *maskbuf, unsigned int width,
+			 unsigned int height, double x_res, double y_res,
+			 double minx, double miny, double maxx, double maxy,
+			 int level, int scale)
 {
 /* retrieving a transparenct mask from DBMS tiles */
     rl2RasterPtr raster = NULL;
     int ret;
     rl2AuxMaskDecoderPtr aux = NULL;
     rl2AuxMaskDecoderPtr decoder;
-    rl2AuxMaskDecoderPtr *thread_slots = NULL;
-    int thread_count;
+    rl2AuxMaskDecoderPtr *free_slots = NULL;
+    rl2WorkerBatchPtr batch = NULL;
+    struct rl2_slot_buffers *buffers = NULL;
+    sqlite3_blob *blob_odd_h = NULL;
+    int split = 0;
+    int num_slots;
+    int free_count;
     int iaux;
 
     if (max_threads < 1)
 	max_threads = 1;
     if (max_threads > 64)
 	max_threads = 64;
-/* allocating the AuxDecoder array */
-    aux = malloc (sizeof (rl2AuxMaskDecoder) * max_threads);
+/* 
+/ allocating the AuxDecoder array
+/ when multithreading twice as many slots as threads are allocated, so
+/ that further tiles can be fetched from the DBMS while the previous
+/ ones are still being decoded
+*/
+    num_slots = (max_threads > 1) ? max_threads * 2 : 1;
+    aux = malloc (sizeof (rl2AuxMaskDecoder) * num_slots);
     if (aux == NULL)
 	return 0;
-    for (iaux = 0; iaux < max_threads; iaux++)
+    if (max_threads > 1)
+      {
+	  /* 
+	  / the BLOBs will be read into the slot buffers; the ones owned
+	  / by the connection are reused from a request to the next
+	  */
+	  buffers = rl2_get_slot_buffers (data, num_slots);
+	  if (buffers == NULL)
+	    {
+		free (aux);
+		return 0;
+	    }
+	  if (coverage != NULL)
+	      split =
+		  (rl2_is_dbms_coverage_split_tiles_enabled
+		   (handle, db_prefix, coverage) == RL2_TRUE) ? 1 : 0;
+      }
+    for (iaux = 0; iaux < num_slots; iaux++)
       {
 	  /* initializing an empty AuxDecoder */
 	  decoder = aux + iaux;
-	  decoder->opaque_thread_id = NULL;
+	  decoder->tile_id = -1;
+	  decoder->retcode = RL2_OK;
 	  decoder->blob_odd = NULL;
 	  decoder->blob_odd_sz = 0;
+	  decoder->pool = (buffers != NULL) ? buffers->items + iaux : NULL;
 	  decoder->maskbuf = maskbuf;
 	  decoder->width = width;
 	  decoder->height = height;
@@ -3637,12 +4538,20 @@ rl2_load_dbms_masktiles (sqlite3 * handle, int max_threads, int by_section,
 	  decoder->raster = NULL;
       }
 
-/* preparing the thread_slots stuct */
-    thread_slots = malloc (sizeof (rl2AuxMaskDecoderPtr) * max_threads);
-    for (thread_count = 0; thread_count < max_threads; thread_count++)
-	*(thread_slots + thread_count) = NULL;
-    thread_count = 0;
-
+/* preparing the free_slots stack */
+    free_slots = malloc (sizeof (rl2AuxMaskDecoderPtr) * num_slots);
+    if (free_slots == NULL)
+	goto error;
+    for (free_count = 0; free_count < num_slots; free_count++)
+	*(free_slots + free_count) = aux + free_count;
+    if (max_threads > 1)
+      {
+	  /* preparing a Batch of concurrent Jobs */
+	  batch = rl2_create_worker_batch (max_threads);
+	  if (batch == NULL)
+	      goto error;
+      }
+
 /* binding the query args */
     sqlite3_reset (stmt_tiles);
     sqlite3_clear_bindings (stmt_tiles);
@@ -3678,44 +4587,77 @@ rl2_load_dbms_masktiles (sqlite3 * handle, int max_threads, int by_section,
 		sqlite3_int64 tile_id = sqlite3_column_int64 (stmt_tiles, 0);
 		double tile_minx = sqlite3_column_double (stmt_tiles, 1);
 		double tile_maxy = sqlite3_column_double (stmt_tiles, 2);
-		decoder = aux + thread_count;
+		if (free_count == 0)
+		  {
+		      /* all slots are busy: waiting for a decoded Tile */
+		      if (!do_recycle_mask_decoders
+			  (batch, aux, num_slots, free_slots, &free_count))
+			  goto error;
+		  }
+		decoder = *(free_slots + free_count - 1);
 		decoder->tile_id = tile_id;
 		decoder->tile_minx = tile_minx;
 		decoder->tile_maxy = tile_maxy;
 
-		/* retrieving tile raw data from BLOBs */
-		sqlite3_reset (stmt_data);
-		sqlite3_clear_bindings (stmt_data);
-		sqlite3_bind_int64 (stmt_data, 1, tile_id);
-		ret = sqlite3_step (stmt_data);
-		if (ret == SQLITE_DONE)
-		    break;
-		if (ret == SQLITE_ROW)
+		if (coverage != NULL && max_threads > 1
+		    && do_read_mask_to_slot_buffer (handle, db_prefix,
+						    coverage, split,
+						    &blob_odd_h, decoder))
 		  {
-		      /* decoding a Tile - may be by using concurrent multithreading */
-		      if (sqlite3_column_type (stmt_data, 0) == SQLITE_BLOB)
-			{
-			    blob_odd = sqlite3_column_blob (stmt_data, 0);
-			    blob_odd_sz = sqlite3_column_bytes (stmt_data, 0);
-			    decoder->blob_odd = malloc (blob_odd_sz);
-			    if (decoder->blob_odd == NULL)
-				goto error;
-			    memcpy (decoder->blob_odd, blob_odd, blob_odd_sz);
-			    decoder->blob_odd_sz = blob_odd_sz;
-			    ok = 1;
-			}
+		      /* the BLOB has been directly read into the slot buffer */
+		      ok = 1;
 		  }
 		else
 		  {
-		      fprintf (stderr,
-			       "SELECT tiles data; sqlite3_step() error: %s\n",
-			       sqlite3_errmsg (handle));
-		      goto error;
+		      /* retrieving tile raw data from BLOBs */
+		      sqlite3_reset (stmt_data);
+		      sqlite3_clear_bindings (stmt_data);
+		      sqlite3_bind_int64 (stmt_data, 1, tile_id);
+		      ret = sqlite3_step (stmt_data);
+		      if (ret == SQLITE_DONE)
+			  break;
+		      if (ret == SQLITE_ROW)
+			{
+			    /* decoding a Tile - may be by using concurrent multithreading */
+			    if (sqlite3_column_type (stmt_data, 0) ==
+				SQLITE_BLOB)
+			      {
+				  blob_odd = sqlite3_column_blob (stmt_data, 0);
+				  blob_odd_sz =
+				      sqlite3_column_bytes (stmt_data, 0);
+				  if (max_threads > 1)
+				    {
+					/* copying into the slot's own buffer */
+					if (!rl2_grow_blob_buffer
+					    (&(decoder->pool->buf_odd),
+					     &(decoder->pool->buf_odd_max),
+					     blob_odd_sz))
+					    goto error;
+					memcpy (decoder->pool->buf_odd,
+						blob_odd, blob_odd_sz);
+					decoder->blob_odd =
+					    decoder->pool->buf_odd;
+				    }
+				  else
+				    {
+					/* decoded at once: no copy is required */
+					decoder->blob_odd =
+					    (unsigned char *) blob_odd;
+				    }
+				  decoder->blob_odd_sz = blob_odd_sz;
+				  ok = 1;
+			      }
+			}
+		      else
+			{
+			    fprintf (stderr,
+				     "SELECT tiles data; sqlite3_step() error: %s\n",
+				     sqlite3_errmsg (handle));
+			    goto error;
+			}
 		  }
 		if (!ok)
 		  {
-		      if (decoder->blob_odd != NULL)
-			  free (decoder->blob_odd);
 		      decoder->blob_odd = NULL;
 		      decoder->blob_odd_sz = 0;
 		  }
@@ -3725,15 +4667,9 @@ rl2_load_dbms_masktiles (sqlite3 * handle, int max_threads, int by_section,
 		      if (max_threads > 1)
 			{
 			    /* adopting a multithreaded strategy */
-			    *(thread_slots + thread_count) = decoder;
-			    thread_count++;
-			    if (thread_count == max_threads)
-			      {
-				  if (!do_run_mask_decoder_children
-				      (thread_slots, thread_count))
-				      goto error;
-				  thread_count = 0;
-			      }
+			    free_count--;
+			    rl2_submit_worker_job (batch, doRunMaskDecoderJob,
+						   decoder);
 			}
 		      else
 			{
@@ -3755,43 +4691,81 @@ rl2_load_dbms_masktiles (sqlite3 * handle, int max_threads, int by_section,
 		goto error;
 	    }
       }
-    if (max_threads > 1 && thread_count > 0)
+    if (max_threads > 1)
       {
-	  /* launching the last multithreaded burst */
-	  if (!do_run_mask_decoder_children (thread_slots, thread_count))
+	  /* waiting for the last pending Tiles */
+	  if (!do_drain_mask_decoders (batch, aux, num_slots))
 	      goto error;
       }
 
+    rl2_destroy_worker_batch (batch);
+    if (blob_odd_h != NULL)
+	sqlite3_blob_close (blob_odd_h);
+    rl2_release_slot_buffers (buffers);
     free (aux);
-    free (thread_slots);
+    free (free_slots);
     return 1;
 
   error:
+    rl2_destroy_worker_batch (batch);
+    if (blob_odd_h != NULL)
+	sqlite3_blob_close (blob_odd_h);
+    rl2_release_slot_buffers (buffers);
     if (aux != NULL)
       {
 	  /* AuxMaskDecoder cleanup */
-	  for (iaux = 0; iaux < max_threads; iaux++)
+	  for (iaux = 0; iaux < num_slots; iaux++)
 	    {
 		decoder = aux + iaux;
-		if (decoder->blob_odd != NULL)
-		    free (decoder->blob_odd);
 		if (decoder->raster != NULL)
 		    rl2_destroy_raster ((rl2RasterPtr) (decoder->raster));
-		if (decoder->opaque_thread_id != NULL)
-		    free (decoder->opaque_thread_id);
 	    }
 	  free (aux);
       }
-    if (thread_slots != NULL)
-	free (thread_slots);
+    if (free_slots != NULL)
+	free (free_slots);
     if (raster != NULL)
 	rl2_destroy_raster (raster);
     return 0;
 }
 
 static int
-rl2_load_dbms_tiles_common (sqlite3 * handle, int max_threads,
-			    sqlite3_stmt * stmt_tiles,
+do_fetch_next_tile (sqlite3_stmt * stmt_tiles, rl2GridTileRefsPtr grid,
+		    sqlite3_int64 * tile_id, double *tile_minx,
+		    double *tile_maxy)
+{
+/* 
+/ fetching the next Tile to be loaded, either from the SpatialIndex
+/ query or from the Tiles already resolved by the Grid Index
+*/
+    int ret;
+    rl2GridTileRefPtr ref;
+    if (grid != NULL)
+      {
+	  if (grid->next >= grid->count)
+	      return SQLITE_DONE;
+	  ref = grid->items + grid->next;
+	  grid->next += 1;
+	  *tile_id = ref->tile_id;
+	  *tile_minx = ref->minx;
+	  *tile_maxy = ref->maxy;
+	  return SQLITE_ROW;
+      }
+    ret = sqlite3_step (stmt_tiles);
+    if (ret == SQLITE_ROW)
+      {
+	  *tile_id = sqlite3_column_int64 (stmt_tiles, 0);
+	  *tile_minx = sqlite3_column_double (stmt_tiles, 1);
+	  *tile_maxy = sqlite3_column_double (stmt_tiles, 2);
+      }
+    return ret;
+}
+
+static int
+rl2_load_dbms_tiles_common (sqlite3 * handle, const void *data,
+			    int max_threads, const char *db_prefix, const char *coverage,
+			    int level, sqlite3_stmt * stmt_tiles,
+			    rl2GridTileRefsPtr grid,
 			    sqlite3_stmt * stmt_data, unsigned char *outbuf,
 			    unsigned int width, unsigned int height,
 			    unsigned char sample_type,
@@ -3809,27 +4783,63 @@ rl2_load_dbms_tiles_common (sqlite3 * handle, int max_threads,
     int ret;
     rl2AuxDecoderPtr aux = NULL;
     rl2AuxDecoderPtr decoder;
-    rl2AuxDecoderPtr *thread_slots = NULL;
-    int thread_count;
+    rl2AuxDecoderPtr *free_slots = NULL;
+    rl2WorkerBatchPtr batch = NULL;
+    rl2TileCacheKeyPtr cache_key = NULL;
+    struct rl2_tile_readers *readers = NULL;
+    struct rl2_slot_buffers *buffers = NULL;
+    sqlite3_blob *blob_odd_h = NULL;
+    sqlite3_blob *blob_even_h = NULL;
+    int split = 0;
+    struct rl2_private_data *priv_data = (struct rl2_private_data *) data;
+    int verify = 1;
+    sqlite3_int64 tile_id;
+    double tile_minx;
+    double tile_maxy;
+    int num_slots;
+    int free_count;
     int iaux;
 
+    if (priv_data != NULL)
+	verify = priv_data->verify_tile_checksums;
     if (max_threads < 1)
 	max_threads = 1;
     if (max_threads > 64)
 	max_threads = 64;
-/* allocating the AuxDecoder array */
-    aux = malloc (sizeof (rl2AuxDecoder) * max_threads);
+/* 
+/ allocating the AuxDecoder array
+/ when multithreading twice as many slots as threads are allocated, so
+/ that further tiles can be fetched from the DBMS while the previous
+/ ones are still being decoded
+*/
+    num_slots = (max_threads > 1) ? max_threads * 2 : 1;
+    aux = malloc (sizeof (rl2AuxDecoder) * num_slots);
     if (aux == NULL)
 	return 0;
-    for (iaux = 0; iaux < max_threads; iaux++)
+    if (max_threads > 1)
+      {
+	  /* 
+	  / the BLOBs will be read into the slot buffers; the ones owned
+	  / by the connection are reused from a request to the next
+	  */
+	  buffers = rl2_get_slot_buffers (data, num_slots);
+	  if (buffers == NULL)
+	    {
+		free (aux);
+		return 0;
+	    }
+      }
+    for (iaux = 0; iaux < num_slots; iaux++)
       {
 	  /* initializing an empty AuxDecoder */
 	  decoder = aux + iaux;
-	  decoder->opaque_thread_id = NULL;
+	  decoder->tile_id = -1;
+	  decoder->retcode = RL2_OK;
 	  decoder->blob_odd = NULL;
 	  decoder->blob_even = NULL;
 	  decoder->blob_odd_sz = 0;
 	  decoder->blob_even_sz = 0;
+	  decoder->pool = (buffers != NULL) ? buffers->items + iaux : NULL;
 	  decoder->outbuf = outbuf;
 	  decoder->width = width;
 	  decoder->height = height;
@@ -3848,18 +4858,59 @@ rl2_load_dbms_tiles_common (sqlite3 * handle, int max_threads,
 	  decoder->stats = (rl2PrivRasterStatisticsPtr) stats;
 	  decoder->raster = NULL;
 	  decoder->palette = NULL;
+	  decoder->cache_key = NULL;
+	  decoder->cache_coverage = coverage;
+	  decoder->cache_level = level;
+	  decoder->cached_tile = NULL;
+	  decoder->reader = NULL;
+	  decoder->verify_checksum = verify;
+      }
+    if (coverage != NULL)
+      {
+	  /* checking if the Tile Cache is enabled */
+	  cache_key = rl2_get_tile_cache_key (handle, data, db_prefix, coverage);
+	  for (iaux = 0; iaux < num_slots; iaux++)
+	      (aux + iaux)->cache_key = cache_key;
+      }
+    if (coverage != NULL && max_threads > 1)
+      {
+	  /* 
+	  / checking if the Tile Readers are enabled
+	  / each slot owns its own read-only connection; a slot never
+	  / services more than one Job at once, so no locking is required
+	  */
+	  readers = rl2_get_tile_readers (handle, data, db_prefix, num_slots);
+	  if (readers != NULL)
+	    {
+		for (iaux = 0; iaux < num_slots; iaux++)
+		    (aux + iaux)->reader = readers->items + iaux;
+	    }
+	  else
+	      split =
+		  (rl2_is_dbms_coverage_split_tiles_enabled
+		   (handle, db_prefix, coverage) == RL2_TRUE) ? 1 : 0;
       }
 
-/* preparing the thread_slots stuct */
-    thread_slots = malloc (sizeof (rl2AuxDecoderPtr) * max_threads);
-    for (thread_count = 0; thread_count < max_threads; thread_count++)
-	*(thread_slots + thread_count) = NULL;
-    thread_count = 0;
+/* preparing the free_slots stack */
+    free_slots = malloc (sizeof (rl2AuxDecoderPtr) * num_slots);
+    if (free_slots == NULL)
+	goto error;
+    for (free_count = 0; free_count < num_slots; free_count++)
+	*(free_slots + free_count) = aux + free_count;
+    if (max_threads > 1)
+      {
+	  /* preparing a Batch of concurrent Jobs */
+	  batch = rl2_create_worker_batch (max_threads);
+	  if (batch == NULL)
+	      goto error;
+      }
 
 /* querying the tiles */
     while (1)
       {
-	  ret = sqlite3_step (stmt_tiles);
+	  ret =
+	      do_fetch_next_tile (stmt_tiles, grid, &tile_id, &tile_minx,
+				  &tile_maxy);
 	  if (ret == SQLITE_DONE)
 	      break;
 	  if (ret == SQLITE_ROW)
@@ -3869,66 +4920,101 @@ rl2_load_dbms_tiles_common (sqlite3 * handle, int max_threads,
 		int blob_odd_sz = 0;
 		const unsigned char *blob_even = NULL;
 		int blob_even_sz = 0;
-		sqlite3_int64 tile_id = sqlite3_column_int64 (stmt_tiles, 0);
-		double tile_minx = sqlite3_column_double (stmt_tiles, 1);
-		double tile_maxy = sqlite3_column_double (stmt_tiles, 2);
-		decoder = aux + thread_count;
+		rl2RasterPtr cached_raster;
+		if (free_count == 0)
+		  {
+		      /* all slots are busy: waiting for a decoded Tile */
+		      if (!do_recycle_decoders
+			  (batch, aux, num_slots, free_slots, &free_count))
+			  goto error;
+		  }
+		decoder = *(free_slots + free_count - 1);
 		decoder->tile_id = tile_id;
 		decoder->tile_minx = tile_minx;
 		decoder->tile_maxy = tile_maxy;
 
-		/* retrieving tile raw data from BLOBs */
-		sqlite3_reset (stmt_data);
-		sqlite3_clear_bindings (stmt_data);
-		sqlite3_bind_int64 (stmt_data, 1, tile_id);
-		ret = sqlite3_step (stmt_data);
-		if (ret == SQLITE_DONE)
-		    break;
-		if (ret == SQLITE_ROW)
+		/* checking the Tile Cache first */
+		decoder->cached_tile =
+		    rl2_lookup_cached_tile (cache_key, level, tile_id, scale,
+					    &cached_raster);
+		if (decoder->cached_tile != NULL)
 		  {
-		      /* decoding a Tile - may be by using concurrent multithreading */
-		      if (sqlite3_column_type (stmt_data, 0) == SQLITE_BLOB)
-			{
-			    blob_odd = sqlite3_column_blob (stmt_data, 0);
-			    blob_odd_sz = sqlite3_column_bytes (stmt_data, 0);
-			    decoder->blob_odd = malloc (blob_odd_sz);
-			    if (decoder->blob_odd == NULL)
-				goto error;
-			    memcpy (decoder->blob_odd, blob_odd, blob_odd_sz);
-			    decoder->blob_odd_sz = blob_odd_sz;
-			    ok = 1;
-			}
-		      if (scale == RL2_SCALE_1)
+		      /* already decoded: no need to read the BLOBs */
+		      decoder->raster = (rl2PrivRasterPtr) cached_raster;
+		      ok = 1;
+		  }
+		else if (decoder->reader != NULL)
+		  {
+		      /* the BLOBs will be read by the worker thread itself */
+		      ok = 1;
+		  }
+		else if (coverage != NULL && max_threads > 1
+			 && do_read_to_slot_buffers (handle, db_prefix,
+						     coverage, split,
+						     &blob_odd_h, &blob_even_h,
+						     decoder))
+		  {
+		      /* the BLOBs have been directly read into the slot buffers */
+		      ok = 1;
+		  }
+		else
+		  {
+		      /* retrieving tile raw data from BLOBs */
+		      sqlite3_reset (stmt_data);
+		      sqlite3_clear_bindings (stmt_data);
+		      sqlite3_bind_int64 (stmt_data, 1, tile_id);
+		      ret = sqlite3_step (stmt_data);
+		      if (ret == SQLITE_DONE)
+			  break;
+		      if (ret == SQLITE_ROW)
 			{
-			    if (sqlite3_column_type (stmt_data, 1) ==
+			    /* decoding a Tile - may be by using concurrent multithreading */
+			    if (sqlite3_column_type (stmt_data, 0) ==
 				SQLITE_BLOB)
 			      {
-				  blob_even =
-				      sqlite3_column_blob (stmt_data, 1);
-				  blob_even_sz =
-				      sqlite3_column_bytes (stmt_data, 1);
-				  decoder->blob_even = malloc (blob_even_sz);
-				  if (decoder->blob_even == NULL)
+				  blob_odd =
+				      sqlite3_column_blob (stmt_data, 0);
+				  blob_odd_sz =
+				      sqlite3_column_bytes (stmt_data, 0);
+				  decoder->blob_odd =
+				      (unsigned char *) blob_odd;
+				  decoder->blob_odd_sz = blob_odd_sz;
+				  ok = 1;
+			      }
+			    if (scale == RL2_SCALE_1)
+			      {
+				  if (sqlite3_column_type (stmt_data, 1) ==
+				      SQLITE_BLOB)
+				    {
+					blob_even =
+					    sqlite3_column_blob (stmt_data, 1);
+					blob_even_sz =
+					    sqlite3_column_bytes (stmt_data, 1);
+					decoder->blob_even =
+					    (unsigned char *) blob_even;
+					decoder->blob_even_sz = blob_even_sz;
+				    }
+			      }
+			    if (ok && max_threads > 1)
+			      {
+				  /* 
+				  / copying into the slot's own buffers; not required
+				  / when decoding at once on the current thread
+				  */
+				  if (!do_copy_to_slot_buffers (decoder))
 				      goto error;
-				  memcpy (decoder->blob_even, blob_even,
-					  blob_even_sz);
-				  decoder->blob_even_sz = blob_even_sz;
 			      }
 			}
-		  }
-		else
-		  {
-		      fprintf (stderr,
-			       "SELECT tiles data; sqlite3_step() error: %s\n",
-			       sqlite3_errmsg (handle));
-		      goto error;
+		      else
+			{
+			    fprintf (stderr,
+				     "SELECT tiles data; sqlite3_step() error: %s\n",
+				     sqlite3_errmsg (handle));
+			    goto error;
+			}
 		  }
 		if (!ok)
 		  {
-		      if (decoder->blob_odd != NULL)
-			  free (decoder->blob_odd);
-		      if (decoder->blob_even != NULL)
-			  free (decoder->blob_even);
 		      decoder->blob_odd = NULL;
 		      decoder->blob_even = NULL;
 		      decoder->blob_odd_sz = 0;
@@ -3937,20 +5023,15 @@ rl2_load_dbms_tiles_common (sqlite3 * handle, int max_threads,
 		else
 		  {
 		      /* processing a Tile request (may be under parallel execution) */
-		      decoder->palette =
-			  (rl2PrivPalettePtr) rl2_clone_palette (palette);
+		      if (decoder->cached_tile == NULL)
+			  decoder->palette =
+			      (rl2PrivPalettePtr) rl2_clone_palette (palette);
 		      if (max_threads > 1)
 			{
 			    /* adopting a multithreaded strategy */
-			    *(thread_slots + thread_count) = decoder;
-			    thread_count++;
-			    if (thread_count == max_threads)
-			      {
-				  if (!do_run_decoder_children
-				      (thread_slots, thread_count))
-				      goto error;
-				  thread_count = 0;
-			      }
+			    free_count--;
+			    rl2_submit_worker_job (batch, doRunDecoderJob,
+						   decoder);
 			}
 		      else
 			{
@@ -3972,39 +5053,43 @@ rl2_load_dbms_tiles_common (sqlite3 * handle, int max_threads,
 		goto error;
 	    }
       }
-    if (max_threads > 1 && thread_count > 0)
+    if (max_threads > 1)
       {
-	  /* launching the last multithreaded burst */
-	  if (!do_run_decoder_children (thread_slots, thread_count))
+	  /* waiting for the last pending Tiles */
+	  if (!do_drain_decoders (batch, aux, num_slots))
 	      goto error;
       }
 
+    rl2_destroy_worker_batch (batch);
+    do_release_decoder_blobs (aux, num_slots, blob_odd_h, blob_even_h);
+    rl2_release_slot_buffers (buffers);
     free (aux);
-    free (thread_slots);
+    free (free_slots);
+    rl2_destroy_tile_cache_key (cache_key);
     return 1;
 
   error:
+    rl2_destroy_worker_batch (batch);
     if (aux != NULL)
       {
 	  /* AuxDecoder cleanup */
-	  for (iaux = 0; iaux < max_threads; iaux++)
+	  do_release_decoder_blobs (aux, num_slots, blob_odd_h, blob_even_h);
+	  rl2_release_slot_buffers (buffers);
+	  for (iaux = 0; iaux < num_slots; iaux++)
 	    {
 		decoder = aux + iaux;
-		if (decoder->blob_odd != NULL)
-		    free (decoder->blob_odd);
-		if (decoder->blob_even != NULL)
-		    free (decoder->blob_even);
-		if (decoder->raster != NULL)
+		if (decoder->cached_tile != NULL)
+		    rl2_release_cached_tile (decoder->cached_tile);
+		else if (decoder->raster != NULL)
 		    rl2_destroy_raster ((rl2RasterPtr) (decoder->raster));
 		if (decoder->palette != NULL)
 		    rl2_destroy_palette ((rl2PalettePtr) (decoder->palette));
-		if (decoder->opaque_thread_id != NULL)
-		    free (decoder->opaque_thread_id);
 	    }
 	  free (aux);
       }
-    if (thread_slots != NULL)
-	free (thread_slots);
+    if (free_slots != NULL)
+	free (free_slots);
+    rl2_destroy_tile_cache_key (cache_key);
     if (raster != NULL)
 	rl2_destroy_raster (raster);
     if (plt != NULL)
@@ -4813,8 +5898,10 @@ load_mono_band_dbms_tiles (sqlite3 * handle, sqlite3_stmt * stmt_tiles,
 }
 
 RL2_PRIVATE int
-rl2_load_dbms_tiles (sqlite3 * handle, int max_threads,
-		     sqlite3_stmt * stmt_tiles, sqlite3_stmt * stmt_data,
+rl2_load_dbms_tiles (sqlite3 * handle, const void *data, int max_threads,
+		     const char *db_prefix, const char *coverage,
+		     sqlite3_stmt * stmt_tiles,
+		     sqlite3_stmt * stmt_data,
 		     unsigned char *outbuf, unsigned int width,
 		     unsigned int height, unsigned char sample_type,
 		     unsigned char num_bands, unsigned char auto_ndvi,
@@ -4825,25 +5912,39 @@ rl2_load_dbms_tiles (sqlite3 * handle, int max_threads,
 		     rl2PixelPtr no_data, rl2RasterSymbolizerPtr style,
 		     rl2RasterStatisticsPtr stats)
 {
-/* binding the query args */
-    sqlite3_reset (stmt_tiles);
-    sqlite3_clear_bindings (stmt_tiles);
-    sqlite3_bind_int (stmt_tiles, 1, level);
-    sqlite3_bind_double (stmt_tiles, 2, minx);
-    sqlite3_bind_double (stmt_tiles, 3, miny);
-    sqlite3_bind_double (stmt_tiles, 4, maxx);
-    sqlite3_bind_double (stmt_tiles, 5, maxy);
+/* attempting to resolve the Tiles by using the Grid Index */
+    int ret;
+    rl2GridTileRefsPtr grid =
+	rl2_get_grid_tile_refs (handle, data, db_prefix, coverage, 0, 0,
+				level, minx, miny, maxx, maxy);
+    if (grid == NULL)
+      {
+	  /* binding the query args */
+	  sqlite3_reset (stmt_tiles);
+	  sqlite3_clear_bindings (stmt_tiles);
+	  sqlite3_bind_int (stmt_tiles, 1, level);
+	  sqlite3_bind_double (stmt_tiles, 2, minx);
+	  sqlite3_bind_double (stmt_tiles, 3, miny);
+	  sqlite3_bind_double (stmt_tiles, 4, maxx);
+	  sqlite3_bind_double (stmt_tiles, 5, maxy);
+      }
 
-    if (!rl2_load_dbms_tiles_common
-	(handle, max_threads, stmt_tiles, stmt_data, outbuf, width, height,
-	 sample_type, num_bands, auto_ndvi, red_band_index, nir_band_index,
-	 x_res, y_res, minx, maxy, scale, palette, no_data, style, stats))
-	return 0;
-    return 1;
+    ret =
+	rl2_load_dbms_tiles_common (handle, data, max_threads, db_prefix,
+				    coverage, level, stmt_tiles, grid,
+				    stmt_data, outbuf, width, height,
+				    sample_type, num_bands, auto_ndvi,
+				    red_band_index,
+				    nir_band_index, x_res, y_res, minx, maxy,
+				    scale, palette, no_data, style, stats);
+    rl2_destroy_grid_tile_refs (grid);
+    return ret;
 }
 
 RL2_PRIVATE int
-rl2_load_dbms_tiles_section (sqlite3 * handle, int max_threads,
+rl2_load_dbms_tiles_section (sqlite3 * handle, const void *data,
+			     int max_threads, const char *db_prefix,
+			     const char *coverage,
 			     sqlite3_int64 section_id,
 			     sqlite3_stmt * stmt_tiles,
 			     sqlite3_stmt * stmt_data, unsigned char *outbuf,
@@ -4856,22 +5957,34 @@ rl2_load_dbms_tiles_section (sqlite3 * handle, int max_threads,
 			     double maxx, double maxy, int level, int scale,
 			     rl2PalettePtr palette, rl2PixelPtr no_data)
 {
-/* binding the query args */
-    sqlite3_reset (stmt_tiles);
-    sqlite3_clear_bindings (stmt_tiles);
-    sqlite3_bind_int (stmt_tiles, 1, section_id);
-    sqlite3_bind_int (stmt_tiles, 2, level);
-    sqlite3_bind_double (stmt_tiles, 3, minx);
-    sqlite3_bind_double (stmt_tiles, 4, miny);
-    sqlite3_bind_double (stmt_tiles, 5, maxx);
-    sqlite3_bind_double (stmt_tiles, 6, maxy);
-
-    if (!rl2_load_dbms_tiles_common
-	(handle, max_threads, stmt_tiles, stmt_data, outbuf, width, height,
-	 sample_type, num_bands, auto_ndvi, red_band_index, nir_band_index,
-	 x_res, y_res, minx, maxy, scale, palette, no_data, NULL, NULL))
-	return 0;
-    return 1;
+/* attempting to resolve the Tiles by using the Grid Index */
+    int ret;
+    rl2GridTileRefsPtr grid =
+	rl2_get_grid_tile_refs (handle, data, db_prefix, coverage, 1,
+				section_id, level, minx, miny, maxx, maxy);
+    if (grid == NULL)
+      {
+	  /* binding the query args */
+	  sqlite3_reset (stmt_tiles);
+	  sqlite3_clear_bindings (stmt_tiles);
+	  sqlite3_bind_int (stmt_tiles, 1, section_id);
+	  sqlite3_bind_int (stmt_tiles, 2, level);
+	  sqlite3_bind_double (stmt_tiles, 3, minx);
+	  sqlite3_bind_double (stmt_tiles, 4, miny);
+	  sqlite3_bind_double (stmt_tiles, 5, maxx);
+	  sqlite3_bind_double (stmt_tiles, 6, maxy);
+      }
+
+    ret =
+	rl2_load_dbms_tiles_common (handle, data, max_threads, db_prefix,
+				    coverage, level, stmt_tiles, grid,
+				    stmt_data, outbuf, width, height,
+				    sample_type, num_bands, auto_ndvi,
+				    red_band_index,
+				    nir_band_index, x_res, y_res, minx, maxy,
+				    scale, palette, no_data, NULL, NULL);
+    rl2_destroy_grid_tile_refs (grid);
+    return ret;
 }
 
 RL2_DECLARE int
@@ -5187,7 +6300,7 @@ rl2_get_raw_raster_mask (sqlite3 * handle, int max_threads,
 			 double y_res, unsigned char **mask, int *mask_size)
 {
 /* attempting to return a transparency mask from the DBMS Coverage */
-    return rl2_get_raw_raster_mask_common (handle, max_threads,
+    return rl2_get_raw_raster_mask_common (handle, NULL, max_threads,
 					   cvg, 0, 0, width, height, minx, miny,
 					   maxx, maxy, x_res, y_res, mask,
 					   mask_size);
@@ -5204,16 +6317,16 @@ rl2_get_section_raw_raster_mask (sqlite3 * handle, int max_threads,
 				 unsigned char **mask, int *mask_size)
 {
 /* attempting to return a transparency mask from the DBMS Coverage */
-    return rl2_get_raw_raster_mask_common (handle, max_threads,
+    return rl2_get_raw_raster_mask_common (handle, NULL, max_threads,
 					   cvg, 1, section_id, width, height,
 					   minx, miny, maxx, maxy, x_res, y_res,
 					   mask, mask_size);
 }
 
 RL2_PRIVATE int
-rl2_get_raw_raster_mask_common (sqlite3 * handle, int max_threads,
-				rl2CoveragePtr cvg, int by_section,
-				sqlite3_int64 section_id, unsigned int width,
+rl2_get_raw_raster_mask_common (sqlite3 * handle, const void *data,
+				int max_threads, rl2CoveragePtr cvg,
+				int by_section, sqlite3_int64 section_id, unsigned int width,
 				unsigned int height, double minx, double miny,
 				double maxx, double maxy, double x_res,
 				double y_res, unsigned char **mask,
@@ -5221,6 +6334,7 @@ rl2_get_raw_raster_mask_common (sqlite3 * handle, int max_threads,
 {
 /* attempting to return a transparency mask from the DBMS Coverage */
     const char *db_prefix;
+    const char *cache_prefix;
     const char *coverage;
     unsigned char level;
     unsigned char scale;
@@ -5236,11 +6350,11 @@ rl2_get_raw_raster_mask_common (sqlite3 * handle, int max_threads,
     char *sql;
     sqlite3_stmt *stmt_tiles = NULL;
     sqlite3_stmt *stmt_data = NULL;
-    int ret;
 
     if (cvg == NULL || handle == NULL)
 	goto error;
     db_prefix = rl2_get_coverage_prefix (cvg);
+    cache_prefix = db_prefix;
     coverage = rl2_get_coverage_name (cvg);
     if (coverage == NULL)
 	goto error;
@@ -5293,13 +6407,13 @@ rl2_get_raw_raster_mask_common (sqlite3 * handle, int max_threads,
     free (xdb_prefix);
     free (xxtiles);
     fprintf (stderr, "%s\n", sql);
-    ret = sqlite3_prepare_v2 (handle, sql, strlen (sql), &stmt_tiles, NULL);
+    stmt_tiles =
+	rl2_acquire_cached_stmt (handle, data, cache_prefix, coverage,
+				 by_section ? RL2_STMT_RAW_SECTION_TILES :
+				 RL2_STMT_RAW_TILES, sql);
     sqlite3_free (sql);
-    if (ret != SQLITE_OK)
-      {
-	  printf ("SELECT raw tiles SQL error: %s\n", sqlite3_errmsg (handle));
-	  goto error;
-      }
+    if (stmt_tiles == NULL)
+	goto error;
 
     /* preparing the data SQL query - only ODD */
     xdb_prefix = rl2_double_quoted_sql (db_prefix);
@@ -5311,43 +6425,40 @@ rl2_get_raw_raster_mask_common (sqlite3 * handle, int max_threads,
 			   xxdata);
     free (xdb_prefix);
     free (xxdata);
-    ret = sqlite3_prepare_v2 (handle, sql, strlen (sql), &stmt_data, NULL);
+    stmt_data =
+	rl2_acquire_cached_stmt (handle, data, cache_prefix, coverage,
+				 RL2_STMT_RAW_TILE_DATA_ODD, sql);
     sqlite3_free (sql);
-    if (ret != SQLITE_OK)
-      {
-	  printf ("SELECT raw tiles data(1) SQL error: %s\n",
-		  sqlite3_errmsg (handle));
-	  goto error;
-      }
+    if (stmt_data == NULL)
+	goto error;
 
 /* preparing a fully opaque mask */
     memset (bufpix, 0, bufpix_size);
 
     if (!rl2_load_dbms_masktiles
-	(handle, max_threads, by_section, section_id, stmt_tiles, stmt_data,
-	 bufpix, width, height, xx_res, yy_res, minx, miny, maxx, maxy, level,
+	(handle, data, max_threads, db_prefix, coverage, by_section,
+	 section_id, stmt_tiles, stmt_data, bufpix, width, height, xx_res, yy_res, minx, miny, maxx, maxy, level,
 	 scale))
 	goto error;
-    sqlite3_finalize (stmt_tiles);
-    sqlite3_finalize (stmt_data);
+    rl2_release_cached_stmt (data, stmt_tiles);
+    rl2_release_cached_stmt (data, stmt_data);
     *mask = bufpix;
     *mask_size = bufpix_size;
 
     return RL2_OK;
 
   error:
-    if (stmt_tiles != NULL)
-	sqlite3_finalize (stmt_tiles);
-    if (stmt_data != NULL)
-	sqlite3_finalize (stmt_data);
+    rl2_release_cached_stmt (data, stmt_tiles);
+    rl2_release_cached_stmt (data, stmt_data);
     if (bufpix != NULL)
 	free (bufpix);
     return RL2_ERROR;
 }
 
 RL2_PRIVATE int
-rl2_get_raw_raster_data_common (sqlite3 * handle, int max_threads,
-				rl2CoveragePtr cvg, int by_section,
+rl2_get_raw_raster_data_common (sqlite3 * handle, const void *data,
+				int max_threads, rl2CoveragePtr cvg,
+				int by_section,
 				sqlite3_int64 section_id, unsigned int width,
 				unsigned int height, double minx, double miny,
 				double maxx, double maxy, double x_res,
@@ -5362,6 +6473,7 @@ rl2_get_raw_raster_data_common (sqlite3 * handle, int max_threads,
     rl2PixelPtr no_data = NULL;
     rl2PixelPtr kill_no_data = NULL;
     const char *db_prefix;
+    const char *cache_prefix;
     const char *coverage;
     unsigned char level;
     unsigned char scale;
@@ -5382,7 +6494,6 @@ rl2_get_raw_raster_data_common (sqlite3 * handle, int max_threads,
     char *sql;
     sqlite3_stmt *stmt_tiles = NULL;
     sqlite3_stmt *stmt_data = NULL;
-    int ret;
     int has_shaded_relief;
     int brightness_only;
     double relief_factor;
@@ -5397,6 +6508,7 @@ rl2_get_raw_raster_data_common (sqlite3 * handle, int max_threads,
     if (cvg == NULL || handle == NULL)
 	goto error;
     db_prefix = rl2_get_coverage_prefix (cvg);
+    cache_prefix = db_prefix;
     coverage = rl2_get_coverage_name (cvg);
     if (coverage == NULL)
 	goto error;
@@ -5669,13 +6781,13 @@ rl2_get_raw_raster_data_common (sqlite3 * handle, int max_threads,
     sqlite3_free (xtiles);
     free (xdb_prefix);
     free (xxtiles);
-    ret = sqlite3_prepare_v2 (handle, sql, strlen (sql), &stmt_tiles, NULL);
+    stmt_tiles =
+	rl2_acquire_cached_stmt (handle, data, cache_prefix, coverage,
+				 by_section ? RL2_STMT_RAW_SECTION_TILES :
+				 RL2_STMT_RAW_TILES, sql);
     sqlite3_free (sql);
-    if (ret != SQLITE_OK)
-      {
-	  printf ("SELECT raw tiles SQL error: %s\n", sqlite3_errmsg (handle));
-	  goto error;
-      }
+    if (stmt_tiles == NULL)
+	goto error;
 
     if (scale == RL2_SCALE_1)
       {
@@ -5689,15 +6801,12 @@ rl2_get_raw_raster_data_common (sqlite3 * handle, int max_threads,
 				 xdb_prefix, xxdata);
 	  free (xdb_prefix);
 	  free (xxdata);
-	  ret =
-	      sqlite3_prepare_v2 (handle, sql, strlen (sql), &stmt_data, NULL);
+	  stmt_data =
+	      rl2_acquire_cached_stmt (handle, data, cache_prefix, coverage,
+				       RL2_STMT_RAW_TILE_DATA, sql);
 	  sqlite3_free (sql);
-	  if (ret != SQLITE_OK)
-	    {
-		printf ("SELECT raw tiles data(2) SQL error: %s\n",
-			sqlite3_errmsg (handle));
-		goto error;
-	    }
+	  if (stmt_data == NULL)
+	      goto error;
       }
     else
       {
@@ -5711,15 +6820,12 @@ rl2_get_raw_raster_data_common (sqlite3 * handle, int max_threads,
 				 xdb_prefix, xxdata);
 	  free (xdb_prefix);
 	  free (xxdata);
-	  ret =
-	      sqlite3_prepare_v2 (handle, sql, strlen (sql), &stmt_data, NULL);
+	  stmt_data =
+	      rl2_acquire_cached_stmt (handle, data, cache_prefix, coverage,
+				       RL2_STMT_RAW_TILE_DATA_ODD, sql);
 	  sqlite3_free (sql);
-	  if (ret != SQLITE_OK)
-	    {
-		printf ("SELECT raw tiles data(1) SQL error: %s\n",
-			sqlite3_errmsg (handle));
-		goto error;
-	    }
+	  if (stmt_data == NULL)
+	      goto error;
       }
 
 /* preparing a raw pixels buffer */
@@ -5738,26 +6844,28 @@ rl2_get_raw_raster_data_common (sqlite3 * handle, int max_threads,
       {
 	  /* only from a single Section */
 	  if (!rl2_load_dbms_tiles_section
-	      (handle, max_threads, section_id, stmt_tiles, stmt_data, bufpix,
-	       width, height, sample_type, num_bands, auto_ndvi, red_band,
-	       nir_band, xx_res, yy_res, minx, miny, maxx, maxy, level, scale,
-	       plt, no_data))
+	      (handle, data, max_threads, db_prefix, coverage,
+	       section_id, stmt_tiles, stmt_data, bufpix, width, height,
+	       sample_type,
+	       num_bands, auto_ndvi, red_band, nir_band, xx_res, yy_res, minx,
+	       miny, maxx, maxy, level, scale, plt, no_data))
 	      goto error;
       }
     else
       {
 	  /* whole Coverage */
 	  if (!rl2_load_dbms_tiles
-	      (handle, max_threads, stmt_tiles, stmt_data, bufpix, width,
-	       height, sample_type, num_bands, auto_ndvi, red_band, nir_band,
-	       xx_res, yy_res, minx, miny, maxx, maxy, level, scale, plt,
-	       no_data, style, stats))
+	      (handle, data, max_threads, db_prefix, coverage,
+	       stmt_tiles, stmt_data, bufpix, width, height, sample_type,
+	       num_bands,
+	       auto_ndvi, red_band, nir_band, xx_res, yy_res, minx, miny, maxx,
+	       maxy, level, scale, plt, no_data, style, stats))
 	      goto error;
       }
     if (kill_no_data != NULL)
 	rl2_destroy_pixel (kill_no_data);
-    sqlite3_finalize (stmt_tiles);
-    sqlite3_finalize (stmt_data);
+    rl2_release_cached_stmt (data, stmt_tiles);
+    rl2_release_cached_stmt (data, stmt_data);
     if (shaded_relief != NULL)
       {
 	  /* applying the Shaded Relief */
@@ -5794,10 +6902,8 @@ rl2_get_raw_raster_data_common (sqlite3 * handle, int max_threads,
     return RL2_OK;
 
   error:
-    if (stmt_tiles != NULL)
-	sqlite3_finalize (stmt_tiles);
-    if (stmt_data != NULL)
-	sqlite3_finalize (stmt_data);
+    rl2_release_cached_stmt (data, stmt_tiles);
+    rl2_release_cached_stmt (data, stmt_data);
     if (bufpix != NULL)
 	free (bufpix);
     if (kill_no_data != NULL)
@@ -5816,8 +6922,8 @@ rl2_get_raw_raster_data (sqlite3 * handle, int max_threads,
 			 rl2PalettePtr * palette, unsigned char out_pixel)
 {
 /* attempting to return a buffer containing raw pixels from the DBMS Coverage */
-    return rl2_get_raw_raster_data_common (handle, max_threads, cvg, 0, 0,
-					   width, height, minx, miny, maxx,
+    return rl2_get_raw_raster_data_common (handle, NULL, max_threads, cvg, 0,
+					   0, width, height, minx, miny, maxx,
 					   maxy, x_res, y_res, buffer,
 					   buf_size, palette, out_pixel, NULL,
 					   NULL, NULL);
@@ -5834,8 +6940,8 @@ rl2_get_section_raw_raster_data (sqlite3 * handle, int max_threads,
 				 unsigned char out_pixel)
 {
 /* attempting to return a buffer containing raw pixels from the DBMS Coverage/Section */
-    return rl2_get_raw_raster_data_common (handle, max_threads, cvg, 1,
-					   section_id, width, height, minx,
+    return rl2_get_raw_raster_data_common (handle, NULL, max_threads, cvg,
+					   1, section_id, width, height, minx,
 					   miny, maxx, maxy, x_res, y_res,
 					   buffer, buf_size, palette,
 					   out_pixel, NULL, NULL, NULL);
@@ -6259,19 +7365,22 @@ rl2_get_section_mono_band_raw_raster_data (sqlite3 * handle,
 						 no_data);
 }
 
-RL2_DECLARE int
-rl2_get_raw_raster_data_bgcolor (sqlite3 * handle, int max_threads,
-				 rl2CoveragePtr cvg, unsigned int width,
-				 unsigned int height, double minx,
-				 double miny, double maxx, double maxy,
-				 double x_res, double y_res,
-				 unsigned char **buffer, int *buf_size,
-				 rl2PalettePtr * palette,
-				 unsigned char *out_pixel,
-				 unsigned char bg_red, unsigned char bg_green,
-				 unsigned char bg_blue,
-				 rl2RasterSymbolizerPtr style,
-				 rl2RasterStatisticsPtr stats)
+RL2_PRIVATE int
+rl2_get_raw_raster_data_bgcolor_common (sqlite3 * handle, const void *data,
+					int max_threads, rl2CoveragePtr cvg,
+					unsigned int width,
+					unsigned int height, double minx,
+					double miny, double maxx,
+					double maxy, double x_res,
+					double y_res, unsigned char **buffer,
+					int *buf_size,
+					rl2PalettePtr * palette,
+					unsigned char *out_pixel,
+					unsigned char bg_red,
+					unsigned char bg_green,
+					unsigned char bg_blue,
+					rl2RasterSymbolizerPtr style,
+					rl2RasterStatisticsPtr stats)
 {
 /* attempting to return a buffer containing raw pixels from the DBMS Coverage + bgcolor */
     int ret;
@@ -6505,10 +7614,11 @@ rl2_get_raw_raster_data_bgcolor (sqlite3 * handle, int max_threads,
     if (pixel_type == RL2_PIXEL_MONOCHROME)
 	xstyle = NULL;
     ret =
-	rl2_get_raw_raster_data_common (handle, max_threads, cvg, 0, 0, width,
-					height, minx, miny, maxx, maxy, x_res,
-					y_res, buffer, buf_size, palette,
-					*out_pixel, no_data, xstyle, stats);
+	rl2_get_raw_raster_data_common (handle, data, max_threads, cvg, 0, 0,
+					width, height, minx, miny, maxx, maxy,
+					x_res, y_res, buffer, buf_size,
+					palette, *out_pixel, no_data, xstyle,
+					stats);
     if (no_data != NULL)
 	rl2_destroy_pixel (no_data);
     if (*out_pixel == RL2_PIXEL_GRAYSCALE && pixel_type == RL2_PIXEL_DATAGRID)
@@ -6606,6 +7716,30 @@ rl2_get_raw_raster_data_bgcolor (sqlite3 * handle, int max_threads,
     return ret;
 }
 
+RL2_DECLARE int
+rl2_get_raw_raster_data_bgcolor (sqlite3 * handle, int max_threads,
+				 rl2CoveragePtr cvg, unsigned int width,
+				 unsigned int height, double minx,
+				 double miny, double maxx, double maxy,
+				 double x_res, double y_res,
+				 unsigned char **buffer, int *buf_size,
+				 rl2PalettePtr * palette,
+				 unsigned char *out_pixel,
+				 unsigned char bg_red, unsigned char bg_green,
+				 unsigned char bg_blue,
+				 rl2RasterSymbolizerPtr style,
+				 rl2RasterStatisticsPtr stats)
+{
+/* attempting to return a buffer containing raw pixels from the DBMS Coverage + bgcolor */
+    return rl2_get_raw_raster_data_bgcolor_common (handle, NULL, max_threads,
+						   cvg, width, height, minx,
+						   miny, maxx, maxy, x_res,
+						   y_res, buffer, buf_size,
+						   palette, out_pixel, bg_red,
+						   bg_green, bg_blue, style,
+						   stats);
+}
+
 RL2_DECLARE rl2PalettePtr
 rl2_get_dbms_palette (sqlite3 * handle, const char *db_prefix,
 		      const char *coverage)
@@ -6775,6 +7909,7 @@ rl2_update_dbms_palette (sqlite3 * handle, const char *coverage,
     if (ret == SQLITE_DONE || ret == SQLITE_ROW)
       {
 	  sqlite3_finalize (stmt);
+	  rl2_invalidate_tile_cache (handle, NULL, coverage);
 	  return RL2_OK;
       }
     fprintf (stderr,
@@ -6935,6 +8070,9 @@ rl2_update_dbms_coverage (sqlite3 * handle, const char *coverage)
     sqlite3_stmt *stmt_stats_in = NULL;
     sqlite3_stmt *stmt_stats_out = NULL;
 
+/* the Coverage has changed: discarding any cached Tile */
+    rl2_invalidate_tile_cache (handle, NULL, coverage);
+
 /* Extent query stmt */
     xtable = sqlite3_mprintf ("%s_sections", coverage);
     xxtable = rl2_double_quoted_sql (xtable);
@@ -7908,8 +9046,8 @@ rl2_check_raster_coverage_origin (sqlite3 * sqlite,
 /* checking for the coverage-TILE_DATA table */
     xcoverage = sqlite3_mprintf ("%s_tile_data", coverage_name);
     sql = sqlite3_mprintf ("SELECT count(*) FROM \"%s\".sqlite_master "
-			   "WHERE Lower(tbl_name) = Lower(?) AND type = 'table'",
-			   xdb);
+			   "WHERE Lower(tbl_name) = Lower(?) "
+			   "AND type IN ('table', 'view')", xdb);
     ret = sqlite3_prepare_v2 (sqlite, sql, strlen (sql), &stmt, NULL);
     sqlite3_free (sql);
     if (ret != SQLITE_OK)
@@ -8266,6 +9404,41 @@ rl2_copy_raster_coverage (sqlite3 * sqlite, const char *db_prefix,
 			    ok_compression = 1;
 			    compression = value;
 			}
+		      if (strcasecmp (value, "ZSTD") == 0)
+			{
+			    ok_compression = 1;
+			    compression = value;
+			}
+		      if (strcasecmp (value, "ZSTD_NO") == 0)
+			{
+			    ok_compression = 1;
+			    compression = value;
+			}
+		      if (strcasecmp (value, "LZ4") == 0)
+			{
+			    ok_compression = 1;
+			    compression = value;
+			}
+		      if (strcasecmp (value, "LZ4_NO") == 0)
+			{
+			    ok_compression = 1;
+			    compression = value;
+			}
+		      if (strcasecmp (value, "DEFLATE_FP") == 0)
+			{
+			    ok_compression = 1;
+			    compression = value;
+			}
+		      if (strcasecmp (value, "LZMA_FP") == 0)
+			{
+			    ok_compression = 1;
+			    compression = value;
+			}
+		      if (strcasecmp (value, "ZSTD_FP") == 0)
+			{
+			    ok_compression = 1;
+			    compression = value;
+			}
 		      if (strcasecmp (value, "PNG") == 0)
 			{
 			    ok_compression = 1;
@@ -8319,6 +9492,20 @@ rl2_copy_raster_coverage (sqlite3 * sqlite, const char *db_prefix,
 				compr = RL2_COMPRESSION_LZMA;
 			    if (strcasecmp (compression, "LZMA_NO") == 0)
 				compr = RL2_COMPRESSION_LZMA_NO;
+			    if (strcasecmp (compression, "ZSTD") == 0)
+				compr = RL2_COMPRESSION_ZSTD;
+			    if (strcasecmp (compression, "ZSTD_NO") == 0)
+				compr = RL2_COMPRESSION_ZSTD_NO;
+			    if (strcasecmp (compression, "LZ4") == 0)
+				compr = RL2_COMPRESSION_LZ4;
+			    if (strcasecmp (compression, "LZ4_NO") == 0)
+				compr = RL2_COMPRESSION_LZ4_NO;
+			    if (strcasecmp (compression, "DEFLATE_FP") == 0)
+				compr = RL2_COMPRESSION_DEFLATE_FP;
+			    if (strcasecmp (compression, "LZMA_FP") == 0)
+				compr = RL2_COMPRESSION_LZMA_FP;
+			    if (strcasecmp (compression, "ZSTD_FP") == 0)
+				compr = RL2_COMPRESSION_ZSTD_FP;
 			    if (strcasecmp (compression, "PNG") == 0)
 				compr = RL2_COMPRESSION_PNG;
 			    if (strcasecmp (compression, "GIF") == 0)
@@ -80,10 +80,10 @@ destroyAuxImporterTile (rl2AuxImporterTilePtr tile)
 /* destroying an AuxImporter Tile */
     if (tile == NULL)
 	return;
-    if (tile->opaque_thread_id != NULL)
-	free (tile->opaque_thread_id);
     if (tile->raster != NULL)
 	rl2_destroy_raster (tile->raster);
+    if (tile->stats != NULL)
+	rl2_destroy_raster_statistics (tile->stats);
     if (tile->blob_odd != NULL)
 	free (tile->blob_odd);
     if (tile->blob_even != NULL)
@@ -101,6 +101,9 @@ doAuxImporterTileCleanup (rl2AuxImporterTilePtr tile)
     tile->blob_even = NULL;
     rl2_destroy_raster (tile->raster);
     tile->raster = NULL;
+    if (tile->stats != NULL)
+	rl2_destroy_raster_statistics (tile->stats);
+    tile->stats = NULL;
 }
 
 static void
@@ -113,7 +116,6 @@ addTile2AuxImporter (rl2AuxImporterPtr aux, unsigned int row,
 	return;
 
     tile = malloc (sizeof (rl2AuxImporterTile));
-    tile->opaque_thread_id = NULL;
     tile->mother = aux;
     tile->raster = NULL;
     tile->row = row;
@@ -131,6 +133,7 @@ addTile2AuxImporter (rl2AuxImporterPtr aux, unsigned int row,
     tile->blob_even = NULL;
     tile->blob_odd_sz = 0;
     tile->blob_even_sz = 0;
+    tile->stats = NULL;
     tile->next = NULL;
 /* appending to the double linked list */
     if (aux->first == NULL)
@@ -247,19 +250,33 @@ do_insert_tile (sqlite3 * handle, unsigned char *blob_odd, int blob_odd_sz,
 		sqlite3_int64 section_id, int srid, double tile_minx,
 		double tile_miny, double tile_maxx, double tile_maxy,
 		rl2PalettePtr aux_palette, rl2PixelPtr no_data,
-		sqlite3_stmt * stmt_tils, sqlite3_stmt * stmt_data,
-		rl2RasterStatisticsPtr section_stats)
+		rl2RasterStatisticsPtr tile_stats, sqlite3_stmt * stmt_tils,
+		sqlite3_stmt * stmt_data, rl2RasterStatisticsPtr section_stats)
 {
-/* INSERTing the tile */
+/* 
+/ INSERTing the tile
+/ "tile_stats" are the Tile statistics, if already computed by a worker;
+/ when NULL the Tile will be decoded again so to compute them
+*/
     int ret;
     sqlite3_int64 tile_id;
     rl2RasterStatisticsPtr stats = NULL;
 
-    stats = rl2_get_raster_statistics
-	(blob_odd, blob_odd_sz, blob_even, blob_even_sz, aux_palette, no_data);
-    if (stats == NULL)
-	goto error;
-    rl2_aggregate_raster_statistics (stats, section_stats);
+    if (tile_stats != NULL)
+      {
+	  if (aux_palette != NULL)
+	      rl2_destroy_palette (aux_palette);
+	  rl2_aggregate_raster_statistics (tile_stats, section_stats);
+      }
+    else
+      {
+	  stats = rl2_get_raster_statistics
+	      (blob_odd, blob_odd_sz, blob_even, blob_even_sz, aux_palette,
+	       no_data);
+	  if (stats == NULL)
+	      goto error;
+	  rl2_aggregate_raster_statistics (stats, section_stats);
+      }
     sqlite3_reset (stmt_tils);
     sqlite3_clear_bindings (stmt_tils);
     sqlite3_bind_int64 (stmt_tils, 1, section_id);
@@ -298,7 +315,8 @@ do_insert_tile (sqlite3 * handle, unsigned char *blob_odd, int blob_odd_sz,
 		   sqlite3_errmsg (handle));
 	  goto error;
       }
-    rl2_destroy_raster_statistics (stats);
+    if (stats != NULL)
+	rl2_destroy_raster_statistics (stats);
     return 1;
   error:
     if (stats != NULL)
@@ -391,6 +409,31 @@ do_get_tile (rl2AuxImporterTilePtr tile)
       };
 }
 
+static rl2RasterStatisticsPtr
+build_tile_statistics (rl2AuxImporterTilePtr tile)
+{
+/* 
+/ computing the Tile statistics (still on the worker thread)
+/ lossy compressed Tiles are decoded first, so that the statistics
+/ will always reflect the pixels actually stored into the DBMS
+*/
+    rl2AuxImporterPtr aux = tile->mother;
+    rl2PixelPtr no_data =
+	rl2_get_coverage_no_data ((rl2CoveragePtr) (aux->coverage));
+    switch (aux->compression)
+      {
+      case RL2_COMPRESSION_JPEG:
+      case RL2_COMPRESSION_LOSSY_WEBP:
+      case RL2_COMPRESSION_LOSSY_JP2:
+	  return rl2_get_raster_statistics (tile->blob_odd,
+					    tile->blob_odd_sz,
+					    tile->blob_even,
+					    tile->blob_even_sz, NULL,
+					    no_data);
+      };
+    return rl2_build_raster_statistics (tile->raster, no_data);
+}
+
 static void
 do_encode_tile (rl2AuxImporterTilePtr tile)
 {
@@ -417,6 +460,14 @@ do_encode_tile (rl2AuxImporterTilePtr tile)
 		   tile->row, tile->col);
 	  goto error;
       }
+    tile->stats = build_tile_statistics (tile);
+    if (tile->stats == NULL)
+      {
+	  fprintf (stderr,
+		   "ERROR: unable to compute the tile statistics [Row=%d Col=%d]\n",
+		   tile->row, tile->col);
+	  goto error;
+      }
     tile->retcode = RL2_OK;
     return;
 
@@ -425,72 +476,12 @@ do_encode_tile (rl2AuxImporterTilePtr tile)
     tile->retcode = RL2_ERROR;
 }
 
-#if defined(_WIN32) && !defined(__MINGW32__)
-DWORD WINAPI
-doRunImportThread (void *arg)
-#else
-void *
-doRunImportThread (void *arg)
-#endif
+static void
+doRunImportJob (void *arg)
 {
-/* threaded function: preparing a compressed Tile to be imported */
+/* Job function: preparing a compressed Tile to be imported */
     rl2AuxImporterTilePtr aux_tile = (rl2AuxImporterTilePtr) arg;
     do_encode_tile (aux_tile);
-#if defined(_WIN32) && !defined(__MINGW32__)
-    return 0;
-#else
-    pthread_exit (NULL);
-#endif
-}
-
-static void
-start_tile_thread (rl2AuxImporterTilePtr aux_tile)
-{
-/* starting a concurrent thread */
-#if defined(_WIN32) && !defined(__MINGW32__)
-    HANDLE thread_handle;
-    HANDLE *p_thread;
-    DWORD dwThreadId;
-    thread_handle =
-	CreateThread (NULL, 0, doRunImportThread, aux_tile, 0, &dwThreadId);
-    SetThreadPriority (thread_handle, THREAD_PRIORITY_IDLE);
-    p_thread = malloc (sizeof (HANDLE));
-    *p_thread = thread_handle;
-    aux_tile->opaque_thread_id = p_thread;
-#else
-    pthread_t thread_id;
-    pthread_t *p_thread;
-    int ok_prior = 0;
-    int policy;
-    int min_prio;
-    pthread_attr_t attr;
-    struct sched_param sp;
-    pthread_attr_init (&attr);
-    if (pthread_attr_setschedpolicy (&attr, SCHED_RR) == 0)
-      {
-	  /* attempting to set the lowest priority */
-	  if (pthread_attr_getschedpolicy (&attr, &policy) == 0)
-	    {
-		min_prio = sched_get_priority_min (policy);
-		sp.sched_priority = min_prio;
-		if (pthread_attr_setschedparam (&attr, &sp) == 0)
-		  {
-		      /* ok, setting the lowest priority */
-		      ok_prior = 1;
-		      pthread_create (&thread_id, &attr, doRunImportThread,
-				      aux_tile);
-		  }
-	    }
-      }
-    if (!ok_prior)
-      {
-	  /* failure: using standard priority */
-	  pthread_create (&thread_id, NULL, doRunImportThread, aux_tile);
-      }
-    p_thread = malloc (sizeof (pthread_t));
-    *p_thread = thread_id;
-    aux_tile->opaque_thread_id = p_thread;
-#endif
 }
 
 static int
@@ -537,6 +528,7 @@ do_import_ascii_grid (sqlite3 * handle, int max_threads, const char *src_path,
     rl2AuxImporterPtr aux = NULL;
     rl2AuxImporterTilePtr aux_tile;
     rl2AuxImporterTilePtr *thread_slots = NULL;
+    rl2WorkerBatchPtr batch = NULL;
     int thread_count;
 
     time (&start);
@@ -699,6 +691,13 @@ do_import_ascii_grid (sqlite3 * handle, int max_threads, const char *src_path,
     for (thread_count = 0; thread_count < max_threads; thread_count++)
 	*(thread_slots + thread_count) = NULL;
     thread_count = 0;
+    if (max_threads > 1)
+      {
+	  /* preparing a Batch of concurrent Jobs */
+	  batch = rl2_create_worker_batch (max_threads);
+	  if (batch == NULL)
+	      goto error;
+      }
     aux_tile = aux->first;
     while (aux_tile != NULL)
       {
@@ -709,51 +708,13 @@ do_import_ascii_grid (sqlite3 * handle, int max_threads, const char *src_path,
 		do_get_tile (aux_tile);
 		*(thread_slots + thread_count) = aux_tile;
 		thread_count++;
-		start_tile_thread (aux_tile);
+		rl2_submit_worker_job (batch, doRunImportJob, aux_tile);
 		if (thread_count == max_threads || aux_tile->next == NULL)
 		  {
-		      /* waiting until all child threads exit */
-#if defined(_WIN32) && !defined(__MINGW32__)
-		      HANDLE *handles;
-		      int z;
-		      int cnt = 0;
-		      for (z = 0; z < max_threads; z++)
-			{
-			    /* counting how many active threads we currently have */
-			    rl2AuxImporterTilePtr pTile = *(thread_slots + z);
-			    if (pTile == NULL)
-				continue;
-			    cnt++;
-			}
-		      handles = malloc (sizeof (HANDLE) * cnt);
-		      cnt = 0;
-		      for (z = 0; z < max_threads; z++)
-			{
-			    /* initializing the HANDLEs array */
-			    HANDLE *pOpaque;
-			    rl2AuxImporterTilePtr pTile = *(thread_slots + z);
-			    if (pTile == NULL)
-				continue;
-			    pOpaque = (HANDLE *) (pTile->opaque_thread_id);
-			    *(handles + cnt) = *pOpaque;
-			    cnt++;
-			}
-		      WaitForMultipleObjects (cnt, handles, TRUE, INFINITE);
-#else
-		      for (thread_count = 0; thread_count < max_threads;
-			   thread_count++)
-			{
-			    pthread_t *pOpaque;
-			    rl2AuxImporterTilePtr pTile =
-				*(thread_slots + thread_count);
-			    if (pTile == NULL)
-				continue;
-			    pOpaque = (pthread_t *) (pTile->opaque_thread_id);
-			    pthread_join (*pOpaque, NULL);
-			}
-#endif
+		      /* waiting until all Jobs have been completed */
+		      rl2_wait_worker_batch (batch);
 
-		      /* all children threads have now finished: resuming the main thread */
+		      /* all Jobs have now finished: resuming the main thread */
 		      for (thread_count = 0; thread_count < max_threads;
 			   thread_count++)
 			{
@@ -765,9 +726,6 @@ do_import_ascii_grid (sqlite3 * handle, int max_threads, const char *src_path,
 			    if (pTile->retcode != RL2_OK)
 				goto error;
 			}
-#if defined(_WIN32) && !defined(__MINGW32__)
-		      free (handles);
-#endif
 		      thread_count = 0;
 		      /* we can now continue by inserting all tiles into the DBMS */
 		  }
@@ -797,7 +755,8 @@ do_import_ascii_grid (sqlite3 * handle, int max_threads, const char *src_path,
 		    (handle, pTile->blob_odd, pTile->blob_odd_sz,
 		     pTile->blob_even, pTile->blob_even_sz, section_id, srid,
 		     pTile->minx, pTile->miny, pTile->maxx, pTile->maxy,
-		     NULL, no_data, stmt_tils, stmt_data, section_stats))
+		     NULL, no_data, pTile->stats, stmt_tils, stmt_data,
+		     section_stats))
 		  {
 		      pTile->blob_odd = NULL;
 		      pTile->blob_even = NULL;
@@ -810,6 +769,8 @@ do_import_ascii_grid (sqlite3 * handle, int max_threads, const char *src_path,
 	  thread_count = 0;
 	  aux_tile = aux_tile->next;
       }
+    rl2_destroy_worker_batch (batch);
+    batch = NULL;
     destroyAuxImporter (aux);
     aux = NULL;
     free (thread_slots);
@@ -849,6 +810,7 @@ do_import_ascii_grid (sqlite3 * handle, int max_threads, const char *src_path,
     return 1;
 
   error:
+    rl2_destroy_worker_batch (batch);
     if (aux != NULL)
 	destroyAuxImporter (aux);
     if (thread_slots != NULL)
@@ -1200,6 +1162,7 @@ do_import_jpeg_image (sqlite3 * handle, int max_threads, const char *src_path,
     rl2AuxImporterPtr aux = NULL;
     rl2AuxImporterTilePtr aux_tile;
     rl2AuxImporterTilePtr *thread_slots = NULL;
+    rl2WorkerBatchPtr batch = NULL;
     int thread_count;
 
     if (rl2_get_coverage_resolution (cvg, &base_res_x, &base_res_y) != RL2_OK)
@@ -1376,6 +1339,13 @@ do_import_jpeg_image (sqlite3 * handle, int max_threads, const char *src_path,
     for (thread_count = 0; thread_count < max_threads; thread_count++)
 	*(thread_slots + thread_count) = NULL;
     thread_count = 0;
+    if (max_threads > 1)
+      {
+	  /* preparing a Batch of concurrent Jobs */
+	  batch = rl2_create_worker_batch (max_threads);
+	  if (batch == NULL)
+	      goto error;
+      }
     aux_tile = aux->first;
     while (aux_tile != NULL)
       {
@@ -1386,51 +1356,13 @@ do_import_jpeg_image (sqlite3 * handle, int max_threads, const char *src_path,
 		do_get_tile (aux_tile);
 		*(thread_slots + thread_count) = aux_tile;
 		thread_count++;
-		start_tile_thread (aux_tile);
+		rl2_submit_worker_job (batch, doRunImportJob, aux_tile);
 		if (thread_count == max_threads || aux_tile->next == NULL)
 		  {
-		      /* waiting until all child threads exit */
-#if defined(_WIN32) && !defined(__MINGW32__)
-		      HANDLE *handles;
-		      int z;
-		      int cnt = 0;
-		      for (z = 0; z < max_threads; z++)
-			{
-			    /* counting how many active threads we currently have */
-			    rl2AuxImporterTilePtr pTile = *(thread_slots + z);
-			    if (pTile == NULL)
-				continue;
-			    cnt++;
-			}
-		      handles = malloc (sizeof (HANDLE) * cnt);
-		      cnt = 0;
-		      for (z = 0; z < max_threads; z++)
-			{
-			    /* initializing the HANDLEs array */
-			    HANDLE *pOpaque;
-			    rl2AuxImporterTilePtr pTile = *(thread_slots + z);
-			    if (pTile == NULL)
-				continue;
-			    pOpaque = (HANDLE *) (pTile->opaque_thread_id);
-			    *(handles + cnt) = *pOpaque;
-			    cnt++;
-			}
-		      WaitForMultipleObjects (cnt, handles, TRUE, INFINITE);
-#else
-		      for (thread_count = 0; thread_count < max_threads;
-			   thread_count++)
-			{
-			    pthread_t *pOpaque;
-			    rl2AuxImporterTilePtr pTile =
-				*(thread_slots + thread_count);
-			    if (pTile == NULL)
-				continue;
-			    pOpaque = (pthread_t *) (pTile->opaque_thread_id);
-			    pthread_join (*pOpaque, NULL);
-			}
-#endif
+		      /* waiting until all Jobs have been completed */
+		      rl2_wait_worker_batch (batch);
 
-		      /* all children threads have now finished: resuming the main thread */
+		      /* all Jobs have now finished: resuming the main thread */
 		      for (thread_count = 0; thread_count < max_threads;
 			   thread_count++)
 			{
@@ -1441,9 +1373,6 @@ do_import_jpeg_image (sqlite3 * handle, int max_threads, const char *src_path,
 			    if (pTile->retcode != RL2_OK)
 				goto error;
 			}
-#if defined(_WIN32) && !defined(__MINGW32__)
-		      free (handles);
-#endif
 		      thread_count = 0;
 		      /* we can now continue by inserting all tiles into the DBMS */
 		  }
@@ -1473,7 +1402,8 @@ do_import_jpeg_image (sqlite3 * handle, int max_threads, const char *src_path,
 		    (handle, pTile->blob_odd, pTile->blob_odd_sz,
 		     pTile->blob_even, pTile->blob_even_sz, section_id, srid,
 		     pTile->minx, pTile->miny, pTile->maxx, pTile->maxy,
-		     NULL, no_data, stmt_tils, stmt_data, section_stats))
+		     NULL, no_data, pTile->stats, stmt_tils, stmt_data,
+		     section_stats))
 		  {
 		      pTile->blob_odd = NULL;
 		      pTile->blob_even = NULL;
@@ -1486,6 +1416,8 @@ do_import_jpeg_image (sqlite3 * handle, int max_threads, const char *src_path,
 	  thread_count = 0;
 	  aux_tile = aux_tile->next;
       }
+    rl2_destroy_worker_batch (batch);
+    batch = NULL;
     destroyAuxImporter (aux);
     aux = NULL;
     free (thread_slots);
@@ -1525,6 +1457,7 @@ do_import_jpeg_image (sqlite3 * handle, int max_threads, const char *src_path,
     return 1;
 
   error:
+    rl2_destroy_worker_batch (batch);
     if (aux != NULL)
 	destroyAuxImporter (aux);
     if (thread_slots != NULL)
@@ -1642,6 +1575,7 @@ do_import_jpeg2000_image (sqlite3 * handle, int max_threads,
     rl2AuxImporterPtr aux = NULL;
     rl2AuxImporterTilePtr aux_tile;
     rl2AuxImporterTilePtr *thread_slots = NULL;
+    rl2WorkerBatchPtr batch = NULL;
     int thread_count;
 
     if (rl2_get_coverage_resolution (cvg, &base_res_x, &base_res_y) != RL2_OK)
@@ -1830,6 +1764,13 @@ do_import_jpeg2000_image (sqlite3 * handle, int max_threads,
     for (thread_count = 0; thread_count < max_threads; thread_count++)
 	*(thread_slots + thread_count) = NULL;
     thread_count = 0;
+    if (max_threads > 1)
+      {
+	  /* preparing a Batch of concurrent Jobs */
+	  batch = rl2_create_worker_batch (max_threads);
+	  if (batch == NULL)
+	      goto error;
+      }
     aux_tile = aux->first;
     while (aux_tile != NULL)
       {
@@ -1840,51 +1781,13 @@ do_import_jpeg2000_image (sqlite3 * handle, int max_threads,
 		do_get_tile (aux_tile);
 		*(thread_slots + thread_count) = aux_tile;
 		thread_count++;
-		start_tile_thread (aux_tile);
+		rl2_submit_worker_job (batch, doRunImportJob, aux_tile);
 		if (thread_count == max_threads || aux_tile->next == NULL)
 		  {
-		      /* waiting until all child threads exit */
-#if defined(_WIN32) && !defined(__MINGW32__)
-		      HANDLE *handles;
-		      int z;
-		      int cnt = 0;
-		      for (z = 0; z < max_threads; z++)
-			{
-			    /* counting how many active threads we currently have */
-			    rl2AuxImporterTilePtr pTile = *(thread_slots + z);
-			    if (pTile == NULL)
-				continue;
-			    cnt++;
-			}
-		      handles = malloc (sizeof (HANDLE) * cnt);
-		      cnt = 0;
-		      for (z = 0; z < max_threads; z++)
-			{
-			    /* initializing the HANDLEs array */
-			    HANDLE *pOpaque;
-			    rl2AuxImporterTilePtr pTile = *(thread_slots + z);
-			    if (pTile == NULL)
-				continue;
-			    pOpaque = (HANDLE *) (pTile->opaque_thread_id);
-			    *(handles + cnt) = *pOpaque;
-			    cnt++;
-			}
-		      WaitForMultipleObjects (cnt, handles, TRUE, INFINITE);
-#else
-		      for (thread_count = 0; thread_count < max_threads;
-			   thread_count++)
-			{
-			    pthread_t *pOpaque;
-			    rl2AuxImporterTilePtr pTile =
-				*(thread_slots + thread_count);
-			    if (pTile == NULL)
-				continue;
-			    pOpaque = (pthread_t *) (pTile->opaque_thread_id);
-			    pthread_join (*pOpaque, NULL);
-			}
-#endif
+		      /* waiting until all Jobs have been completed */
+		      rl2_wait_worker_batch (batch);
 
-		      /* all children threads have now finished: resuming the main thread */
+		      /* all Jobs have now finished: resuming the main thread */
 		      for (thread_count = 0; thread_count < max_threads;
 			   thread_count++)
 			{
@@ -1895,9 +1798,6 @@ do_import_jpeg2000_image (sqlite3 * handle, int max_threads,
 			    if (pTile->retcode != RL2_OK)
 				goto error;
 			}
-#if defined(_WIN32) && !defined(__MINGW32__)
-		      free (handles);
-#endif
 		      thread_count = 0;
 		      /* we can now continue by inserting all tiles into the DBMS */
 		  }
@@ -1927,7 +1827,8 @@ do_import_jpeg2000_image (sqlite3 * handle, int max_threads,
 		    (handle, pTile->blob_odd, pTile->blob_odd_sz,
 		     pTile->blob_even, pTile->blob_even_sz, section_id, srid,
 		     pTile->minx, pTile->miny, pTile->maxx, pTile->maxy,
-		     NULL, no_data, stmt_tils, stmt_data, section_stats))
+		     NULL, no_data, pTile->stats, stmt_tils, stmt_data,
+		     section_stats))
 		  {
 		      pTile->blob_odd = NULL;
 		      pTile->blob_even = NULL;
@@ -1940,6 +1841,8 @@ do_import_jpeg2000_image (sqlite3 * handle, int max_threads,
 	  thread_count = 0;
 	  aux_tile = aux_tile->next;
       }
+    rl2_destroy_worker_batch (batch);
+    batch = NULL;
     destroyAuxImporter (aux);
     aux = NULL;
     free (thread_slots);
@@ -1979,6 +1882,7 @@ do_import_jpeg2000_image (sqlite3 * handle, int max_threads,
     return 1;
 
   error:
+    rl2_destroy_worker_batch (batch);
     if (aux != NULL)
 	destroyAuxImporter (aux);
     if (thread_slots != NULL)
@@ -2053,7 +1957,6 @@ do_import_file (sqlite3 * handle, int max_threads, const char *src_path,
     rl2PrivCoveragePtr coverage = (rl2PrivCoveragePtr) cvg;
     int ret;
     rl2TiffOriginPtr origin = NULL;
-    rl2PalettePtr aux_palette = NULL;
     rl2RasterStatisticsPtr section_stats = NULL;
     rl2PixelPtr no_data = NULL;
     unsigned int row;
@@ -2085,6 +1988,7 @@ do_import_file (sqlite3 * handle, int max_threads, const char *src_path,
     rl2AuxImporterPtr aux = NULL;
     rl2AuxImporterTilePtr aux_tile;
     rl2AuxImporterTilePtr *thread_slots = NULL;
+    rl2WorkerBatchPtr batch = NULL;
     int thread_count;
 
     if (is_ascii_grid (src_path))
@@ -2315,6 +2219,13 @@ do_import_file (sqlite3 * handle, int max_threads, const char *src_path,
     for (thread_count = 0; thread_count < max_threads; thread_count++)
 	*(thread_slots + thread_count) = NULL;
     thread_count = 0;
+    if (max_threads > 1)
+      {
+	  /* preparing a Batch of concurrent Jobs */
+	  batch = rl2_create_worker_batch (max_threads);
+	  if (batch == NULL)
+	      goto error;
+      }
     aux_tile = aux->first;
     while (aux_tile != NULL)
       {
@@ -2325,51 +2236,13 @@ do_import_file (sqlite3 * handle, int max_threads, const char *src_path,
 		do_get_tile (aux_tile);
 		*(thread_slots + thread_count) = aux_tile;
 		thread_count++;
-		start_tile_thread (aux_tile);
+		rl2_submit_worker_job (batch, doRunImportJob, aux_tile);
 		if (thread_count == max_threads || aux_tile->next == NULL)
 		  {
-		      /* waiting until all child threads exit */
-#if defined(_WIN32) && !defined(__MINGW32__)
-		      HANDLE *handles;
-		      int z;
-		      int cnt = 0;
-		      for (z = 0; z < max_threads; z++)
-			{
-			    /* counting how many active threads we currently have */
-			    rl2AuxImporterTilePtr pTile = *(thread_slots + z);
-			    if (pTile == NULL)
-				continue;
-			    cnt++;
-			}
-		      handles = malloc (sizeof (HANDLE) * cnt);
-		      cnt = 0;
-		      for (z = 0; z < max_threads; z++)
-			{
-			    /* initializing the HANDLEs array */
-			    HANDLE *pOpaque;
-			    rl2AuxImporterTilePtr pTile = *(thread_slots + z);
-			    if (pTile == NULL)
-				continue;
-			    pOpaque = (HANDLE *) (pTile->opaque_thread_id);
-			    *(handles + cnt) = *pOpaque;
-			    cnt++;
-			}
-		      WaitForMultipleObjects (cnt, handles, TRUE, INFINITE);
-#else
-		      for (thread_count = 0; thread_count < max_threads;
-			   thread_count++)
-			{
-			    pthread_t *pOpaque;
-			    rl2AuxImporterTilePtr pTile =
-				*(thread_slots + thread_count);
-			    if (pTile == NULL)
-				continue;
-			    pOpaque = (pthread_t *) (pTile->opaque_thread_id);
-			    pthread_join (*pOpaque, NULL);
-			}
-#endif
+		      /* waiting until all Jobs have been completed */
+		      rl2_wait_worker_batch (batch);
 
-		      /* all children threads have now finished: resuming the main thread */
+		      /* all Jobs have now finished: resuming the main thread */
 		      for (thread_count = 0; thread_count < max_threads;
 			   thread_count++)
 			{
@@ -2380,9 +2253,6 @@ do_import_file (sqlite3 * handle, int max_threads, const char *src_path,
 			    if (pTile->retcode != RL2_OK)
 				goto error;
 			}
-#if defined(_WIN32) && !defined(__MINGW32__)
-		      free (handles);
-#endif
 		      thread_count = 0;
 		      /* we can now continue by inserting all tiles into the DBMS */
 		  }
@@ -2408,14 +2278,12 @@ do_import_file (sqlite3 * handle, int max_threads, const char *src_path,
 		rl2AuxImporterTilePtr pTile = *(thread_slots + thread_count);
 		if (pTile == NULL)
 		    continue;
-		aux_palette =
-		    rl2_clone_palette (rl2_get_raster_palette
-				       (aux_tile->raster));
 		if (!do_insert_tile
 		    (handle, pTile->blob_odd, pTile->blob_odd_sz,
 		     pTile->blob_even, pTile->blob_even_sz, section_id, srid,
 		     pTile->minx, pTile->miny, pTile->maxx, pTile->maxy,
-		     aux_palette, no_data, stmt_tils, stmt_data, section_stats))
+		     NULL, no_data, pTile->stats, stmt_tils, stmt_data,
+		     section_stats))
 		  {
 		      pTile->blob_odd = NULL;
 		      pTile->blob_even = NULL;
@@ -2428,6 +2296,8 @@ do_import_file (sqlite3 * handle, int max_threads, const char *src_path,
 	  thread_count = 0;
 	  aux_tile = aux_tile->next;
       }
+    rl2_destroy_worker_batch (batch);
+    batch = NULL;
     destroyAuxImporter (aux);
     aux = NULL;
     free (thread_slots);
@@ -2467,6 +2337,7 @@ do_import_file (sqlite3 * handle, int max_threads, const char *src_path,
     return 1;
 
   error:
+    rl2_destroy_worker_batch (batch);
     if (aux != NULL)
 	destroyAuxImporter (aux);
     if (thread_slots != NULL)
@@ -5715,7 +5586,6 @@ rl2_load_raw_raster_into_dbms (sqlite3 * handle, int max_threads,
     double tile_maxy;
     rl2RasterStatisticsPtr section_stats = NULL;
     rl2PixelPtr no_data = NULL;
-    rl2PalettePtr aux_palette = NULL;
     unsigned int row;
     unsigned int col;
     double res_x;
@@ -5732,6 +5602,7 @@ rl2_load_raw_raster_into_dbms (sqlite3 * handle, int max_threads,
     rl2AuxImporterPtr aux = NULL;
     rl2AuxImporterTilePtr aux_tile;
     rl2AuxImporterTilePtr *thread_slots = NULL;
+    rl2WorkerBatchPtr batch = NULL;
     int thread_count;
 
     if (cvg == NULL)
@@ -5928,6 +5799,13 @@ rl2_load_raw_raster_into_dbms (sqlite3 * handle, int max_threads,
     for (thread_count = 0; thread_count < max_threads; thread_count++)
 	*(thread_slots + thread_count) = NULL;
     thread_count = 0;
+    if (max_threads > 1)
+      {
+	  /* preparing a Batch of concurrent Jobs */
+	  batch = rl2_create_worker_batch (max_threads);
+	  if (batch == NULL)
+	      goto error;
+      }
     aux_tile = aux->first;
     while (aux_tile != NULL)
       {
@@ -5938,51 +5816,13 @@ rl2_load_raw_raster_into_dbms (sqlite3 * handle, int max_threads,
 		do_get_tile (aux_tile);
 		*(thread_slots + thread_count) = aux_tile;
 		thread_count++;
-		start_tile_thread (aux_tile);
+		rl2_submit_worker_job (batch, doRunImportJob, aux_tile);
 		if (thread_count == max_threads || aux_tile->next == NULL)
 		  {
-		      /* waiting until all child threads exit */
-#if defined(_WIN32) && !defined(__MINGW32__)
-		      HANDLE *handles;
-		      int z;
-		      int cnt = 0;
-		      for (z = 0; z < max_threads; z++)
-			{
-			    /* counting how many active threads we currently have */
-			    rl2AuxImporterTilePtr pTile = *(thread_slots + z);
-			    if (pTile == NULL)
-				continue;
-			    cnt++;
-			}
-		      handles = malloc (sizeof (HANDLE) * cnt);
-		      cnt = 0;
-		      for (z = 0; z < max_threads; z++)
-			{
-			    /* initializing the HANDLEs array */
-			    HANDLE *pOpaque;
-			    rl2AuxImporterTilePtr pTile = *(thread_slots + z);
-			    if (pTile == NULL)
-				continue;
-			    pOpaque = (HANDLE *) (pTile->opaque_thread_id);
-			    *(handles + cnt) = *pOpaque;
-			    cnt++;
-			}
-		      WaitForMultipleObjects (cnt, handles, TRUE, INFINITE);
-#else
-		      for (thread_count = 0; thread_count < max_threads;
-			   thread_count++)
-			{
-			    pthread_t *pOpaque;
-			    rl2AuxImporterTilePtr pTile =
-				*(thread_slots + thread_count);
-			    if (pTile == NULL)
-				continue;
-			    pOpaque = (pthread_t *) (pTile->opaque_thread_id);
-			    pthread_join (*pOpaque, NULL);
-			}
-#endif
+		      /* waiting until all Jobs have been completed */
+		      rl2_wait_worker_batch (batch);
 
-		      /* all children threads have now finished: resuming the main thread */
+		      /* all Jobs have now finished: resuming the main thread */
 		      for (thread_count = 0; thread_count < max_threads;
 			   thread_count++)
 			{
@@ -5994,9 +5834,6 @@ rl2_load_raw_raster_into_dbms (sqlite3 * handle, int max_threads,
 			    if (pTile->retcode != RL2_OK)
 				goto error;
 			}
-#if defined(_WIN32) && !defined(__MINGW32__)
-		      free (handles);
-#endif
 		      thread_count = 0;
 		      /* we can now continue by inserting all tiles into the DBMS */
 		  }
@@ -6017,13 +5854,12 @@ rl2_load_raw_raster_into_dbms (sqlite3 * handle, int max_threads,
 	    }
 
 	  /* INSERTing the tile */
-	  aux_palette =
-	      rl2_clone_palette (rl2_get_raster_palette (aux_tile->raster));
 	  if (!do_insert_tile
 	      (handle, aux_tile->blob_odd, aux_tile->blob_odd_sz,
 	       aux_tile->blob_even, aux_tile->blob_even_sz, section_id, srid,
 	       aux_tile->minx, aux_tile->miny, aux_tile->maxx, aux_tile->maxy,
-	       aux_palette, no_data, stmt_tils, stmt_data, section_stats))
+	       NULL, no_data, aux_tile->stats, stmt_tils, stmt_data,
+	       section_stats))
 	    {
 		aux_tile->blob_odd = NULL;
 		aux_tile->blob_even = NULL;
@@ -6032,6 +5868,8 @@ rl2_load_raw_raster_into_dbms (sqlite3 * handle, int max_threads,
 	  doAuxImporterTileCleanup (aux_tile);
 	  aux_tile = aux_tile->next;
       }
+    rl2_destroy_worker_batch (batch);
+    batch = NULL;
     destroyAuxImporter (aux);
     aux = NULL;
     free (thread_slots);
@@ -6079,6 +5917,7 @@ rl2_load_raw_raster_into_dbms (sqlite3 * handle, int max_threads,
     return RL2_OK;
 
   error:
+    rl2_destroy_worker_batch (batch);
     if (aux != NULL)
 	destroyAuxImporter (aux);
     if (thread_slots != NULL)
@@ -6415,8 +6254,8 @@ rl2_load_raw_tiles_into_dbms (sqlite3 * handle,
 		if (!do_insert_tile
 		    (handle, blob_odd, blob_odd_sz, blob_even, blob_even_sz,
 		     section_id, srid, tile_minx, tile_miny, tile_maxx,
-		     tile_maxy, aux_palette, no_data, stmt_tils, stmt_data,
-		     section_stats))
+		     tile_maxy, aux_palette, no_data, NULL, stmt_tils,
+		     stmt_data, section_stats))
 		    goto error;
 
 		/* next tile */
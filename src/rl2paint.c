@@ -3320,15 +3320,10 @@ rl2_is_valid_affine_transform (rl2AffineTransformDataPtr xptr)
     return 0;
 }
 
-#if defined(_WIN32) && !defined(__MINGW32__)
-DWORD WINAPI
-doRunTransformThread (void *arg)
-#else
-void *
-doRunTransformThread (void *arg)
-#endif
+static void
+doRunTransformJob (void *arg)
 {
-/* threaded function: Affine Transform */
+/* Job function: Affine Transform */
     rl2TransformParamsPtr params = (rl2TransformParamsPtr) arg;
     int x;
     int y;
@@ -3367,61 +3362,6 @@ doRunTransformThread (void *arg)
 		  }
 	    }
       }
-#if defined(_WIN32) && !defined(__MINGW32__)
-    return 0;
-#else
-    pthread_exit (NULL);
-#endif
-}
-
-static void
-start_transform_thread (rl2TransformParamsPtr params)
-{
-/* starting a concurrent thread */
-#if defined(_WIN32) && !defined(__MINGW32__)
-    HANDLE thread_handle;
-    HANDLE *p_thread;
-    DWORD dwThreadId;
-    thread_handle =
-	CreateThread (NULL, 0, doRunTransformThread, params, 0, &dwThreadId);
-    SetThreadPriority (thread_handle, THREAD_PRIORITY_IDLE);
-    p_thread = malloc (sizeof (HANDLE));
-    *p_thread = thread_handle;
-    params->opaque_thread_id = p_thread;
-#else
-    pthread_t thread_id;
-    pthread_t *p_thread;
-    int ok_prior = 0;
-    int policy;
-    int min_prio;
-    pthread_attr_t attr;
-    struct sched_param sp;
-    pthread_attr_init (&attr);
-    if (pthread_attr_setschedpolicy (&attr, SCHED_RR) == 0)
-      {
-	  /* attempting to set the lowest priority */
-	  if (pthread_attr_getschedpolicy (&attr, &policy) == 0)
-	    {
-		min_prio = sched_get_priority_min (policy);
-		sp.sched_priority = min_prio;
-		if (pthread_attr_setschedparam (&attr, &sp) == 0)
-		  {
-		      /* ok, setting the lowest priority */
-		      ok_prior = 1;
-		      pthread_create (&thread_id, &attr, doRunTransformThread,
-				      params);
-		  }
-	    }
-      }
-    if (!ok_prior)
-      {
-	  /* failure: using standard priority */
-	  pthread_create (&thread_id, NULL, doRunTransformThread, params);
-      }
-    p_thread = malloc (sizeof (pthread_t));
-    *p_thread = thread_id;
-    params->opaque_thread_id = p_thread;
-#endif
 }
 
 static void
@@ -3429,49 +3369,27 @@ do_multi_thread_transform (rl2TransformParamsPtr params_array, int count)
 {
 /* applying the Affine Transform  - multi-thread */
     rl2TransformParamsPtr params;
+    rl2WorkerBatchPtr batch;
     int i;
-#if defined(_WIN32) && !defined(__MINGW32__)
-    HANDLE *handles;
-#endif
 
+    batch = rl2_create_worker_batch (count);
     for (i = 0; i < count; i++)
       {
-	  /* starting all children threads */
+	  /* submitting all Jobs */
 	  params = params_array + i;
-	  start_transform_thread (params);
+	  rl2_submit_worker_job (batch, doRunTransformJob, params);
       }
 
-/* waiting until all child threads exit */
-#if defined(_WIN32) && !defined(__MINGW32__)
-    handles = malloc (sizeof (HANDLE) * count);
-    for (i = 0; i < count; i++)
-      {
-	  /* initializing the HANDLEs array */
-	  HANDLE *pOpaque;
-	  params = params_array + i;
-	  pOpaque = (HANDLE *) (params->opaque_thread_id);
-	  *(handles + i) = *pOpaque;
-      }
-    WaitForMultipleObjects (count, handles, TRUE, INFINITE);
-    free (handles);
-#else
-    for (i = 0; i < count; i++)
-      {
-	  pthread_t *pOpaque;
-	  params = params_array + i;
-	  pOpaque = (pthread_t *) (params->opaque_thread_id);
-	  pthread_join (*pOpaque, NULL);
-      }
-#endif
+/* waiting until all Jobs have been completed */
+    rl2_destroy_worker_batch (batch);
 
-/* all children threads have now finished: resuming the main thread */
+/* all Jobs have now finished: resuming the main thread */
     for (i = 0; i < count; i++)
       {
 	  params = params_array + i;
 	  params->at_data = NULL;
 	  params->in = NULL;
 	  params->out = NULL;
-	  params->opaque_thread_id = NULL;
       }
 }
 
@@ -3585,7 +3503,6 @@ rl2_transform_bitmap (rl2AffineTransformDataPtr at_data,
 	  params->at_data = at_data;
 	  params->in = in;
 	  params->out = out;
-	  params->opaque_thread_id = NULL;
 	  params->base_row = ipar;
 	  params->row_incr = max_threads;
       }
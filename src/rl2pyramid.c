@@ -44,6 +44,7 @@ the terms of any one of the MPL, the GPL or the LGPL.
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <math.h>
 #include <float.h>
 
 #include <sys/types.h>
@@ -232,6 +233,7 @@ delete_section_pyramid (sqlite3 * handle, const char *coverage,
 	  sqlite3_free (err_msg);
 	  return 0;
       }
+    rl2_invalidate_tile_cache (handle, NULL, coverage);
     return 1;
 }
 
@@ -421,7 +423,7 @@ alloc_sect_pyramid (sqlite3_int64 sect_id, unsigned int sect_width,
 		    unsigned char compression, int quality, int srid,
 		    double res_x, double res_y, double tile_width,
 		    double tile_height, double minx, double miny, double maxx,
-		    double maxy, int scale)
+		    double maxy, int scale, unsigned char resampling)
 {
 /* allocating a Section Pyramid object */
     double ext_x = maxx - minx;
@@ -437,6 +439,7 @@ alloc_sect_pyramid (sqlite3_int64 sect_id, unsigned int sect_width,
     pyr->pixel_type = pixel_type;
     pyr->num_samples = num_samples;
     pyr->compression = compression;
+    pyr->resampling = resampling;
     pyr->quality = quality;
     pyr->srid = srid;
     pyr->res_x = res_x;
@@ -590,845 +593,1050 @@ set_pyramid_tile_destination (SectionPyramidPtr pyr, double minx, double miny,
 }
 
 static unsigned char *
-load_tile_base (sqlite3_stmt * stmt, sqlite3_int64 tile_id,
-		rl2PalettePtr palette, rl2PixelPtr no_data)
+load_tile_base (rl2AuxPyramidBasePtr base, rl2PalettePtr palette,
+		rl2PixelPtr no_data)
 {
-/* attempting to read a lower-level tile */
-    int ret;
-    const unsigned char *blob_odd = NULL;
-    int blob_odd_sz = 0;
-    const unsigned char *blob_even = NULL;
-    int blob_even_sz = 0;
-    rl2RasterPtr raster = NULL;
-    rl2PalettePtr plt = NULL;
+/* attempting to decode a lower-level tile */
     unsigned char *rgba_tile = NULL;
     int rgba_sz;
-    rl2PixelPtr nd;
 
-    sqlite3_reset (stmt);
-    sqlite3_clear_bindings (stmt);
-    sqlite3_bind_int64 (stmt, 1, tile_id);
-    while (1)
+    if (rl2_raster_decode_rgba
+	(RL2_SCALE_1, base->blob_odd, base->blob_odd_sz, base->blob_even,
+	 base->blob_even_sz, palette, no_data, &rgba_tile,
+	 &rgba_sz) != RL2_OK)
       {
-	  /* scrolling the result set rows */
-	  ret = sqlite3_step (stmt);
-	  if (ret == SQLITE_DONE)
-	      break;		/* end of result set */
-	  if (ret == SQLITE_ROW)
-	    {
-		if (sqlite3_column_type (stmt, 0) == SQLITE_BLOB)
-		  {
-		      blob_odd = sqlite3_column_blob (stmt, 0);
-		      blob_odd_sz = sqlite3_column_bytes (stmt, 0);
-		  }
-		if (sqlite3_column_type (stmt, 1) == SQLITE_BLOB)
-		  {
-		      blob_even = sqlite3_column_blob (stmt, 1);
-		      blob_even_sz = sqlite3_column_bytes (stmt, 1);
-		  }
-		plt = rl2_clone_palette (palette);
-		raster =
-		    rl2_raster_decode (RL2_SCALE_1, blob_odd, blob_odd_sz,
-				       blob_even, blob_even_sz, plt);
-		if (raster == NULL)
-		  {
-		      fprintf (stderr, ERR_FRMT64, tile_id);
-		      return NULL;
-		  }
-		nd = rl2_clone_pixel (no_data);
-		rl2_set_raster_no_data (raster, nd);
-		if (rl2_raster_data_to_RGBA (raster, &rgba_tile, &rgba_sz) !=
-		    RL2_OK)
-		    rgba_tile = NULL;
-		rl2_destroy_raster (raster);
-		break;
-	    }
-	  else
-	      return NULL;
+	  fprintf (stderr, ERR_FRMT64, base->tile_id);
+	  return NULL;
       }
     return rgba_tile;
 }
 
 static rl2RasterPtr
-load_tile_base_generic (sqlite3_stmt * stmt, sqlite3_int64 tile_id)
+load_tile_base_generic (rl2AuxPyramidBasePtr base)
 {
-/* attempting to read a lower-level tile */
-    int ret;
-    const unsigned char *blob_odd = NULL;
-    int blob_odd_sz = 0;
-    const unsigned char *blob_even = NULL;
-    int blob_even_sz = 0;
-    rl2RasterPtr raster = NULL;
+/* attempting to decode a lower-level tile */
+    rl2RasterPtr raster =
+	rl2_raster_decode (RL2_SCALE_1, base->blob_odd, base->blob_odd_sz,
+			   base->blob_even, base->blob_even_sz, NULL);
+    if (raster == NULL)
+	fprintf (stderr, ERR_FRMT64, base->tile_id);
+    return raster;
+}
 
-    sqlite3_reset (stmt);
-    sqlite3_clear_bindings (stmt);
-    sqlite3_bind_int64 (stmt, 1, tile_id);
-    while (1)
+/*
+/
+/ Pyramid resampling kernels: reducing a DataGrid, MultiBand or RGBA
+/ base tile by some factor
+/
+/ the kernel is chosen once for each tile, and each one of them then
+/ runs its own specialized loop over whole rows:
+/ - AVERAGE: the (SIMD) box filter
+/ - NEAREST: the central sample of each block
+/ - MODE: the most frequent valid value of each block
+/ - BILINEAR and CUBIC: separable convolution, the kernel being
+/   stretched by the reduction factor; the weights are normalized
+/   over the valid samples found within each base tile
+/
+/ an output sample becomes NO-DATA when invalid samples are at least
+/ as many (or as heavy) as the valid ones
+/
+*/
+
+/* valid weights exactly matching the invalid ones always mean NO-DATA */
+#define RL2_RESAMPLE_EPSILON	1e-9
+
+static int
+resample_sample_size (unsigned char sample_type)
+{
+/* returning the size (in bytes) of a single sample */
+    switch (sample_type)
       {
-	  /* scrolling the result set rows */
-	  ret = sqlite3_step (stmt);
-	  if (ret == SQLITE_DONE)
-	      break;		/* end of result set */
-	  if (ret == SQLITE_ROW)
-	    {
-		if (sqlite3_column_type (stmt, 0) == SQLITE_BLOB)
-		  {
-		      blob_odd = sqlite3_column_blob (stmt, 0);
-		      blob_odd_sz = sqlite3_column_bytes (stmt, 0);
-		  }
-		if (sqlite3_column_type (stmt, 1) == SQLITE_BLOB)
-		  {
-		      blob_even = sqlite3_column_blob (stmt, 1);
-		      blob_even_sz = sqlite3_column_bytes (stmt, 1);
-		  }
-		raster =
-		    rl2_raster_decode (RL2_SCALE_1, blob_odd, blob_odd_sz,
-				       blob_even, blob_even_sz, NULL);
-		if (raster == NULL)
-		  {
-		      fprintf (stderr, ERR_FRMT64, tile_id);
-		      return NULL;
-		  }
-		return raster;
-	    }
-      }
-    return NULL;
+      case RL2_SAMPLE_INT16:
+      case RL2_SAMPLE_UINT16:
+	  return 2;
+      case RL2_SAMPLE_INT32:
+      case RL2_SAMPLE_UINT32:
+      case RL2_SAMPLE_FLOAT:
+	  return 4;
+      case RL2_SAMPLE_DOUBLE:
+	  return 8;
+      };
+    return 1;
 }
 
-static double
-rescale_pixel_int8 (const char *buf_in, unsigned int tileWidth,
-		    unsigned int tileHeight, int x, int y, char nd)
+static double *
+resample_no_data (rl2BoxFilterPtr flt)
 {
-/* rescaling a DataGrid pixel (8x8) - INT8 */
-    unsigned int row;
-    unsigned int col;
-    int nodata = 0;
-    int valid = 0;
-    double sum = 0.0;
+/* returning the NO-DATA samples as doubles (NULL if none) */
+    double *nd;
+    int ib;
+    if (flt->no_data == NULL)
+	return NULL;
+    nd = malloc (sizeof (double) * flt->num_bands);
+    if (nd == NULL)
+	return NULL;
+    for (ib = 0; ib < flt->num_bands; ib++)
+	nd[ib] = rl2_box_sample_value (flt->no_data + ib, flt->sample_type);
+    return nd;
+}
 
-    for (row = 0; row < 8; row++)
-      {
-	  const char *p_in_base;
-	  unsigned int yy = y + row;
-	  if (yy >= tileHeight)
-	      break;
-	  p_in_base = buf_in + (yy * tileWidth);
-	  for (col = 0; col < 8; col++)
-	    {
-		const char *p_in;
-		unsigned int xx = x + col;
-		if (xx >= tileWidth)
-		    break;
-		p_in = p_in_base + x;
-		if (*p_in == nd)
-		    nodata++;
-		else
-		  {
-		      valid++;
-		      sum += *p_in;
-		  }
-	    }
-      }
+static unsigned int
+resample_block (unsigned int index, unsigned int limit, unsigned int factor)
+{
+/* returning how many input samples are covered by some output sample */
+    unsigned int start = index * factor;
+    unsigned int count;
+    if (start >= limit)
+	return 0;
+    count = limit - start;
+    if (count > factor)
+	count = factor;
+    return count;
+}
 
-    if (nodata >= valid)
-	return nd;
-    return (char) (sum / (double) valid);
+static double
+resample_clamp (double value, double min, double max)
+{
+/* rounding an integer sample and clamping it to the range of its type */
+    value = floor (value + 0.5);
+    if (value < min)
+	return min;
+    if (value > max)
+	return max;
+    return value;
 }
 
 static void
-rescale_grid_int8 (char *buf_out, unsigned int tileWidth,
-		   unsigned int tileHeight, const char *buf_in, int x, int y,
-		   int tic_x, int tic_y, rl2PixelPtr no_data)
+resample_emit_row (rl2BoxFilterPtr flt, unsigned int oy, double *vals,
+		   const unsigned char *valid, const double *nd)
 {
-/* rescaling a DataGrid tile - int 8 bit */
-    unsigned int row;
-    unsigned int col;
-    char nd = 0;
-    rl2PrivPixelPtr pxl = (rl2PrivPixelPtr) no_data;
+/*
+/ storing a row of resampled samples; NO-DATA samples are only written
+/ when no transparency mask is being built, the output being left
+/ untouched otherwise
+*/
+    int nb = flt->num_bands;
+    unsigned int n = flt->out_width * nb;
+    size_t base = (size_t) oy * flt->out_stride * nb;
+    int all = (flt->mask_out == NULL) ? 1 : 0;
+    unsigned int i;
+    unsigned int ox;
+    int ib;
 
-    if (pxl != NULL)
+    for (i = 0; i < n; i++)
       {
-	  /* retrieving the NO-DATA value */
-	  if (pxl->sampleType == RL2_SAMPLE_INT8 && pxl->nBands == 1)
-	    {
-		rl2PrivSamplePtr sample = pxl->Samples + 0;
-		nd = sample->int8;
-	    }
+	  if (!valid[i])
+	      vals[i] = (nd == NULL) ? 0.0 : nd[i % nb];
       }
-
-    for (row = 0; row < (unsigned) tic_y; row++)
+    switch (flt->sample_type)
       {
-	  unsigned int yy = row + y;
-	  char *p_out_base = buf_out + (yy * tileWidth);
-	  if (yy >= tileHeight)
-	      break;
-	  for (col = 0; col < (unsigned int) tic_x; col++)
+      case RL2_SAMPLE_INT8:
+	  {
+	      char *p = (char *) (flt->out) + base;
+	      for (i = 0; i < n; i++)
+		{
+		    if (all || valid[i])
+			p[i] = (char) resample_clamp (vals[i], -128.0, 127.0);
+		}
+	  }
+	  break;
+      case RL2_SAMPLE_UINT8:
+	  {
+	      unsigned char *p = (unsigned char *) (flt->out) + base;
+	      for (i = 0; i < n; i++)
+		{
+		    if (all || valid[i])
+			p[i] = (unsigned char) resample_clamp (vals[i], 0.0,
+							       255.0);
+		}
+	  }
+	  break;
+      case RL2_SAMPLE_INT16:
+	  {
+	      short *p = (short *) (flt->out) + base;
+	      for (i = 0; i < n; i++)
+		{
+		    if (all || valid[i])
+			p[i] = (short) resample_clamp (vals[i], -32768.0,
+						       32767.0);
+		}
+	  }
+	  break;
+      case RL2_SAMPLE_UINT16:
+	  {
+	      unsigned short *p = (unsigned short *) (flt->out) + base;
+	      for (i = 0; i < n; i++)
+		{
+		    if (all || valid[i])
+			p[i] = (unsigned short) resample_clamp (vals[i], 0.0,
+								65535.0);
+		}
+	  }
+	  break;
+      case RL2_SAMPLE_INT32:
+	  {
+	      int *p = (int *) (flt->out) + base;
+	      for (i = 0; i < n; i++)
+		{
+		    if (all || valid[i])
+			p[i] = (int) resample_clamp (vals[i], -2147483648.0,
+						     2147483647.0);
+		}
+	  }
+	  break;
+      case RL2_SAMPLE_UINT32:
+	  {
+	      unsigned int *p = (unsigned int *) (flt->out) + base;
+	      for (i = 0; i < n; i++)
+		{
+		    if (all || valid[i])
+			p[i] = (unsigned int) resample_clamp (vals[i], 0.0,
+							      4294967295.0);
+		}
+	  }
+	  break;
+      case RL2_SAMPLE_FLOAT:
+	  {
+	      float *p = (float *) (flt->out) + base;
+	      for (i = 0; i < n; i++)
+		{
+		    if (all || valid[i])
+			p[i] = (float) vals[i];
+		}
+	  }
+	  break;
+      case RL2_SAMPLE_DOUBLE:
+	  {
+	      double *p = (double *) (flt->out) + base;
+	      for (i = 0; i < n; i++)
+		{
+		    if (all || valid[i])
+			p[i] = vals[i];
+		}
+	  }
+	  break;
+      };
+    if (flt->mask_out == NULL)
+	return;
+    for (ox = 0; ox < flt->out_width; ox++)
+      {
+	  /* marking any pixel containing at least a valid sample */
+	  for (ib = 0; ib < nb; ib++)
 	    {
-		unsigned int xx = col + x;
-		char *p_out = p_out_base + xx;
-		if (xx >= tileWidth)
-		    break;
-		*p_out =
-		    rescale_pixel_int8 (buf_in, tileWidth, tileHeight,
-					col * 8, row * 8, nd);
+		if (valid[(ox * nb) + ib])
+		  {
+		      *(flt->mask_out + ((size_t) oy * flt->out_stride) + ox) =
+			  1;
+		      break;
+		  }
 	    }
       }
 }
 
-static double
-rescale_pixel_uint8 (const unsigned char *buf_in, unsigned int tileWidth,
-		     unsigned int tileHeight, int x, int y, unsigned char nd)
+static int
+resample_nearest_copy (rl2BoxFilterPtr flt)
 {
-/* rescaling a DataGrid pixel (8x8) - UINT8 */
-    unsigned int row;
-    unsigned int col;
-    int nodata = 0;
-    int valid = 0;
-    double sum = 0.0;
+/*
+/ NEAREST - plain copy of the central samples; no mask is involved,
+/ so NO-DATA samples are simply copied as they are
+*/
+    int nb = flt->num_bands;
+    int sample_sz = resample_sample_size (flt->sample_type);
+    int pixel_sz = sample_sz * nb;
+    unsigned int f = flt->factor;
+    size_t in_row = (size_t) flt->in_width * pixel_sz;
+    size_t out_row = (size_t) flt->out_stride * pixel_sz;
+    unsigned char *nd_pixel;
+    unsigned char *out;
+    const unsigned char *in;
+    unsigned int fast = 0;
+    unsigned int ox;
+    unsigned int oy;
+    unsigned int rows;
+    unsigned int cols;
+    int ib;
 
-    for (row = 0; row < 8; row++)
-      {
-	  const unsigned char *p_in_base;
-	  unsigned int yy = y + row;
-	  if (yy >= tileHeight)
-	      break;
-	  p_in_base = buf_in + (yy * tileWidth);
-	  for (col = 0; col < 8; col++)
+    nd_pixel = malloc (pixel_sz);
+    if (nd_pixel == NULL)
+	return RL2_ERROR;
+    memset (nd_pixel, 0, pixel_sz);
+    if (flt->no_data != NULL)
+      {
+	  /* all union members do start at the very same address */
+	  for (ib = 0; ib < nb; ib++)
+	      memcpy (nd_pixel + (ib * sample_sz), flt->no_data + ib,
+		      sample_sz);
+      }
+/* full blocks that can be safely gathered without overrunning the row */
+    if (flt->in_width >= f / 2)
+	fast = (flt->in_width - (f / 2)) / f;
+    if (fast > flt->out_width)
+	fast = flt->out_width;
+
+    for (oy = 0; oy < flt->out_height; oy++)
+      {
+	  out = (unsigned char *) (flt->out) + ((size_t) oy * out_row);
+	  rows = resample_block (oy, flt->in_height, f);
+	  if (rows == 0)
+	    {
+		/* entirely beyond the input tile */
+		for (ox = 0; ox < flt->out_width; ox++)
+		    memcpy (out + ((size_t) ox * pixel_sz), nd_pixel,
+			    pixel_sz);
+		continue;
+	    }
+	  in = (const unsigned char *) (flt->in) +
+	      ((size_t) ((oy * f) + (rows / 2)) * in_row);
+	  rl2_copy_pixel_row (out, in + ((f / 2) * pixel_sz), fast, sample_sz,
+			      nb, f, 0);
+	  for (ox = fast; ox < flt->out_width; ox++)
 	    {
-		const unsigned char *p_in;
-		unsigned int xx = x + col;
-		if (xx >= tileWidth)
-		    break;
-		p_in = p_in_base + x;
-		if (*p_in == nd)
-		    nodata++;
+		cols = resample_block (ox, flt->in_width, f);
+		if (cols == 0)
+		    memcpy (out + ((size_t) ox * pixel_sz), nd_pixel,
+			    pixel_sz);
 		else
-		  {
-		      valid++;
-		      sum += *p_in;
-		  }
+		    memcpy (out + ((size_t) ox * pixel_sz),
+			    in + (((size_t) (ox * f) + (cols / 2)) * pixel_sz),
+			    pixel_sz);
 	    }
       }
-
-    if (nodata >= valid)
-	return nd;
-    return (unsigned char) (sum / (double) valid);
+    free (nd_pixel);
+    return RL2_OK;
 }
 
-static void
-rescale_grid_uint8 (unsigned char *buf_out, unsigned int tileWidth,
-		    unsigned int tileHeight, const unsigned char *buf_in,
-		    int x, int y, int tic_x, int tic_y, rl2PixelPtr no_data)
+static int
+resample_nearest (rl2BoxFilterPtr flt)
 {
-/* rescaling a DataGrid tile - unsigned int 8 bit */
-    unsigned int row;
-    unsigned int col;
-    unsigned char nd = 0;
-    rl2PrivPixelPtr pxl = (rl2PrivPixelPtr) no_data;
+/* NEAREST - the central sample of each block */
+    int nb = flt->num_bands;
+    unsigned int n_in = flt->in_width * nb;
+    unsigned int n_out = flt->out_width * nb;
+    unsigned int f = flt->factor;
+    double *nd = NULL;
+    double *row = NULL;
+    double *vals = NULL;
+    unsigned char *ok = NULL;
+    unsigned char *valid = NULL;
+    unsigned int ox;
+    unsigned int oy;
+    unsigned int y;
+    unsigned int rows;
+    unsigned int cols;
+    int ib;
+    int retcode = RL2_ERROR;
 
-    if (pxl != NULL)
-      {
-	  /* retrieving the NO-DATA value */
-	  if (pxl->sampleType == RL2_SAMPLE_UINT8 && pxl->nBands == 1)
-	    {
-		rl2PrivSamplePtr sample = pxl->Samples + 0;
-		nd = sample->uint8;
-	    }
-      }
+    if (flt->mask_in == NULL && flt->mask_out == NULL)
+	return resample_nearest_copy (flt);
 
-    for (row = 0; row < (unsigned int) tic_y; row++)
+    row = malloc (sizeof (double) * n_in);
+    ok = malloc (n_in);
+    vals = malloc (sizeof (double) * n_out);
+    valid = malloc (n_out);
+    if (row == NULL || ok == NULL || vals == NULL || valid == NULL)
+	goto error;
+    if (flt->no_data != NULL)
       {
-	  unsigned int yy = row + y;
-	  unsigned char *p_out_base = buf_out + (yy * tileWidth);
-	  if (yy >= tileHeight)
-	      break;
-	  for (col = 0; col < (unsigned int) tic_x; col++)
-	    {
-		unsigned int xx = col + x;
-		unsigned char *p_out = p_out_base + xx;
-		if (xx >= tileWidth)
-		    break;
-		*p_out =
-		    rescale_pixel_uint8 (buf_in, tileWidth, tileHeight,
-					 col * 8, row * 8, nd);
-	    }
+	  nd = resample_no_data (flt);
+	  if (nd == NULL)
+	      goto error;
       }
-}
-
-static double
-rescale_pixel_int16 (const short *buf_in, unsigned int tileWidth,
-		     unsigned int tileHeight, int x, int y, short nd)
-{
-/* rescaling a DataGrid pixel (8x8) - INT32 */
-    unsigned int row;
-    unsigned int col;
-    int nodata = 0;
-    int valid = 0;
-    double sum = 0.0;
 
-    for (row = 0; row < 8; row++)
+    for (oy = 0; oy < flt->out_height; oy++)
       {
-	  const short *p_in_base;
-	  unsigned int yy = y + row;
-	  if (yy >= tileHeight)
-	      break;
-	  p_in_base = buf_in + (yy * tileWidth);
-	  for (col = 0; col < 8; col++)
+	  memset (valid, 0, n_out);
+	  rows = resample_block (oy, flt->in_height, f);
+	  if (rows > 0)
 	    {
-		const short *p_in;
-		unsigned int xx = x + col;
-		if (xx >= tileWidth)
-		    break;
-		p_in = p_in_base + x;
-		if (*p_in == nd)
-		    nodata++;
-		else
+		y = (oy * f) + (rows / 2);
+		rl2_box_widen_row (flt->in, (size_t) y * n_in, n_in,
+				   flt->sample_type, row);
+		rl2_box_check_row (flt, y, row, nd, ok);
+		for (ox = 0; ox < flt->out_width; ox++)
 		  {
-		      valid++;
-		      sum += *p_in;
+		      unsigned int x;
+		      cols = resample_block (ox, flt->in_width, f);
+		      if (cols == 0)
+			  continue;
+		      x = ((ox * f) + (cols / 2)) * nb;
+		      for (ib = 0; ib < nb; ib++)
+			{
+			    vals[(ox * nb) + ib] = row[x + ib];
+			    valid[(ox * nb) + ib] = ok[x + ib];
+			}
 		  }
 	    }
+	  resample_emit_row (flt, oy, vals, valid, nd);
       }
+    retcode = RL2_OK;
 
-    if (nodata >= valid)
-	return nd;
-    return (short) (sum / (double) valid);
+  error:
+    if (nd != NULL)
+	free (nd);
+    if (row != NULL)
+	free (row);
+    if (ok != NULL)
+	free (ok);
+    if (vals != NULL)
+	free (vals);
+    if (valid != NULL)
+	free (valid);
+    return retcode;
 }
 
-static void
-rescale_grid_int16 (short *buf_out, unsigned int tileWidth,
-		    unsigned int tileHeight, const short *buf_in, int x,
-		    int y, int tic_x, int tic_y, rl2PixelPtr no_data)
+static double
+resample_mode_histogram (const double *values, int count, int *histogram,
+			 int offset)
 {
-/* rescaling a DataGrid tile - int 16 bit */
-    unsigned int row;
-    unsigned int col;
-    short nd = 0;
-    rl2PrivPixelPtr pxl = (rl2PrivPixelPtr) no_data;
-
-    if (pxl != NULL)
+/* MODE - 8 bit samples: counting each value into a Histogram */
+    int i;
+    int best = 0;
+    double mode = values[0];
+    for (i = 0; i < count; i++)
+	histogram[(int) values[i] + offset] += 1;
+    for (i = 0; i < count; i++)
       {
-	  /* retrieving the NO-DATA value */
-	  if (pxl->sampleType == RL2_SAMPLE_INT16 && pxl->nBands == 1)
+	  int freq = histogram[(int) values[i] + offset];
+	  if (freq > best || (freq == best && values[i] < mode))
 	    {
-		rl2PrivSamplePtr sample = pxl->Samples + 0;
-		nd = sample->int16;
+		best = freq;
+		mode = values[i];
 	    }
       }
+    for (i = 0; i < count; i++)
+	histogram[(int) values[i] + offset] = 0;
+    return mode;
+}
 
-    for (row = 0; row < (unsigned int) tic_y; row++)
-      {
-	  unsigned int yy = row + y;
-	  short *p_out_base = buf_out + (yy * tileWidth);
-	  if (yy >= tileHeight)
-	      break;
-	  for (col = 0; col < (unsigned int) tic_x; col++)
-	    {
-		unsigned int xx = col + x;
-		short *p_out = p_out_base + xx;
-		if (xx >= tileWidth)
-		    break;
-		*p_out =
-		    rescale_pixel_int16 (buf_in, tileWidth, tileHeight,
-					 col * 8, row * 8, nd);
-	    }
-      }
+static int
+cmp_resample_values (const void *p1, const void *p2)
+{
+/* compares two sample values [for QSORT] */
+    double v1 = *((const double *) p1);
+    double v2 = *((const double *) p2);
+    if (v1 < v2)
+	return -1;
+    if (v1 > v2)
+	return 1;
+    return 0;
 }
 
 static double
-rescale_pixel_uint16 (const unsigned short *buf_in, unsigned int tileWidth,
-		      unsigned int tileHeight, int x, int y, unsigned short nd)
+resample_mode_sorted (double *values, int count)
 {
-/* rescaling a DataGrid pixel (8x8) - UINT16 */
-    unsigned int row;
-    unsigned int col;
-    int nodata = 0;
-    int valid = 0;
-    double sum = 0.0;
-
-    for (row = 0; row < 8; row++)
-      {
-	  const unsigned short *p_in_base;
-	  unsigned int yy = y + row;
-	  if (yy >= tileHeight)
-	      break;
-	  p_in_base = buf_in + (yy * tileWidth);
-	  for (col = 0; col < 8; col++)
+/* MODE - any other sample type: sorting the values and finding the longest run */
+    int i;
+    int run = 1;
+    int best = 1;
+    double mode;
+    qsort (values, count, sizeof (double), cmp_resample_values);
+    mode = values[0];
+    for (i = 1; i < count; i++)
+      {
+	  if (values[i] == values[i - 1])
+	      run++;
+	  else
+	      run = 1;
+	  if (run > best)
 	    {
-		const unsigned short *p_in;
-		unsigned int xx = x + col;
-		if (xx >= tileWidth)
-		    break;
-		p_in = p_in_base + x;
-		if (*p_in == nd)
-		    nodata++;
-		else
-		  {
-		      valid++;
-		      sum += *p_in;
-		  }
+		/* ties are won by the smallest value (sorted first) */
+		best = run;
+		mode = values[i];
 	    }
       }
-
-    if (nodata >= valid)
-	return nd;
-    return (unsigned short) (sum / (double) valid);
+    return mode;
 }
 
-static void
-rescale_grid_uint16 (unsigned short *buf_out, unsigned int tileWidth,
-		     unsigned int tileHeight, const unsigned short *buf_in,
-		     int x, int y, int tic_x, int tic_y, rl2PixelPtr no_data)
+static int
+resample_mode (rl2BoxFilterPtr flt)
 {
-/* rescaling a DataGrid tile - unsigned int 16 bit */
-    unsigned int row;
-    unsigned int col;
-    unsigned short nd = 0;
-    rl2PrivPixelPtr pxl = (rl2PrivPixelPtr) no_data;
-
-    if (pxl != NULL)
+/* MODE - the most frequent valid value of each block */
+    int nb = flt->num_bands;
+    unsigned int n_in = flt->in_width * nb;
+    unsigned int n_out = flt->out_width * nb;
+    unsigned int f = flt->factor;
+    double *nd = NULL;
+    double *rows_buf = NULL;
+    double *vals = NULL;
+    double *block = NULL;
+    unsigned char *ok = NULL;
+    unsigned char *valid = NULL;
+    int histogram[256];
+    int offset = -1;
+    unsigned int ox;
+    unsigned int oy;
+    unsigned int x;
+    unsigned int r;
+    unsigned int rows;
+    unsigned int cols;
+    int ib;
+    int retcode = RL2_ERROR;
+
+    if (flt->sample_type == RL2_SAMPLE_INT8)
+	offset = 128;
+    else if (flt->sample_type == RL2_SAMPLE_UINT8)
+	offset = 0;
+    memset (histogram, 0, sizeof (histogram));
+    rows_buf = malloc (sizeof (double) * n_in * f);
+    ok = malloc ((size_t) n_in * f);
+    block = malloc (sizeof (double) * f * f);
+    vals = malloc (sizeof (double) * n_out);
+    valid = malloc (n_out);
+    if (rows_buf == NULL || ok == NULL || block == NULL || vals == NULL
+	|| valid == NULL)
+	goto error;
+    if (flt->no_data != NULL)
       {
-	  /* retrieving the NO-DATA value */
-	  if (pxl->sampleType == RL2_SAMPLE_UINT16 && pxl->nBands == 1)
-	    {
-		rl2PrivSamplePtr sample = pxl->Samples + 0;
-		nd = sample->uint16;
-	    }
+	  nd = resample_no_data (flt);
+	  if (nd == NULL)
+	      goto error;
       }
 
-    for (row = 0; row < (unsigned int) tic_y; row++)
+    for (oy = 0; oy < flt->out_height; oy++)
       {
-	  unsigned int yy = row + y;
-	  unsigned short *p_out_base = buf_out + (yy * tileWidth);
-	  if (yy >= tileHeight)
-	      break;
-	  for (col = 0; col < (unsigned int) tic_x; col++)
+	  memset (valid, 0, n_out);
+	  rows = resample_block (oy, flt->in_height, f);
+	  for (r = 0; r < rows; r++)
 	    {
-		unsigned int xx = col + x;
-		unsigned short *p_out = p_out_base + xx;
-		if (xx >= tileWidth)
-		    break;
-		*p_out =
-		    rescale_pixel_uint16 (buf_in, tileWidth, tileHeight,
-					  col * 8, row * 8, nd);
+		unsigned int y = (oy * f) + r;
+		rl2_box_widen_row (flt->in, (size_t) y * n_in, n_in,
+				   flt->sample_type, rows_buf + (r * n_in));
+		rl2_box_check_row (flt, y, rows_buf + (r * n_in), nd,
+				   ok + (r * n_in));
 	    }
-      }
-}
-
-static double
-rescale_pixel_int32 (const int *buf_in, unsigned int tileWidth,
-		     unsigned int tileHeight, int x, int y, int nd)
-{
-/* rescaling a DataGrid pixel (8x8) - INT32 */
-    unsigned int row;
-    unsigned int col;
-    int nodata = 0;
-    int valid = 0;
-    double sum = 0.0;
-
-    for (row = 0; row < 8; row++)
-      {
-	  const int *p_in_base;
-	  unsigned int yy = y + row;
-	  if (yy >= tileHeight)
-	      break;
-	  p_in_base = buf_in + (yy * tileWidth);
-	  for (col = 0; col < 8; col++)
+	  if (rows == 0)
 	    {
-		const int *p_in;
-		unsigned int xx = x + col;
-		if (xx >= tileWidth)
-		    break;
-		p_in = p_in_base + x;
-		if (*p_in == nd)
-		    nodata++;
-		else
+		/* entirely beyond the input tile */
+		resample_emit_row (flt, oy, vals, valid, nd);
+		continue;
+	    }
+	  for (ox = 0; ox < flt->out_width; ox++)
+	    {
+		cols = resample_block (ox, flt->in_width, f);
+		for (ib = 0; ib < nb; ib++)
 		  {
-		      valid++;
-		      sum += *p_in;
+		      int count = 0;
+		      int total = rows * cols;
+		      for (r = 0; r < rows; r++)
+			{
+			    for (x = ox * f; x < (ox * f) + cols; x++)
+			      {
+				  unsigned int i = (r * n_in) + (x * nb) + ib;
+				  if (ok[i])
+				      block[count++] = rows_buf[i];
+			      }
+			}
+		      if (total - count >= count)
+			  continue;	/* NO-DATA */
+		      if (offset >= 0)
+			  vals[(ox * nb) + ib] =
+			      resample_mode_histogram (block, count,
+						       histogram, offset);
+		      else
+			  vals[(ox * nb) + ib] =
+			      resample_mode_sorted (block, count);
+		      valid[(ox * nb) + ib] = 1;
 		  }
 	    }
+	  resample_emit_row (flt, oy, vals, valid, nd);
       }
+    retcode = RL2_OK;
 
-    if (nodata >= valid)
-	return nd;
-    return (int) (sum / (double) valid);
+  error:
+    if (nd != NULL)
+	free (nd);
+    if (rows_buf != NULL)
+	free (rows_buf);
+    if (ok != NULL)
+	free (ok);
+    if (block != NULL)
+	free (block);
+    if (vals != NULL)
+	free (vals);
+    if (valid != NULL)
+	free (valid);
+    return retcode;
 }
 
-static void
-rescale_grid_int32 (int *buf_out, unsigned int tileWidth,
-		    unsigned int tileHeight, const int *buf_in, int x, int y,
-		    int tic_x, int tic_y, rl2PixelPtr no_data)
+static double
+resample_kernel_bilinear (double t)
 {
-/* rescaling a DataGrid tile - int 32 bit */
-    unsigned int row;
-    unsigned int col;
-    int nd = 0;
-    rl2PrivPixelPtr pxl = (rl2PrivPixelPtr) no_data;
+/* BILINEAR - triangle kernel (radius 1) */
+    if (t < 0.0)
+	t = -t;
+    if (t >= 1.0)
+	return 0.0;
+    return 1.0 - t;
+}
 
-    if (pxl != NULL)
-      {
-	  /* retrieving the NO-DATA value */
-	  if (pxl->sampleType == RL2_SAMPLE_INT32 && pxl->nBands == 1)
-	    {
-		rl2PrivSamplePtr sample = pxl->Samples + 0;
-		nd = sample->int32;
-	    }
-      }
+static double
+resample_kernel_cubic (double t)
+{
+/* CUBIC - Catmull-Rom kernel (a = -0.5, radius 2) */
+    if (t < 0.0)
+	t = -t;
+    if (t < 1.0)
+	return ((1.5 * t - 2.5) * t * t) + 1.0;
+    if (t < 2.0)
+	return (((-0.5 * t + 2.5) * t - 4.0) * t) + 2.0;
+    return 0.0;
+}
 
-    for (row = 0; row < (unsigned int) tic_y; row++)
-      {
-	  unsigned int yy = row + y;
-	  int *p_out_base = buf_out + (yy * tileWidth);
-	  if (yy >= tileHeight)
-	      break;
-	  for (col = 0; col < (unsigned int) tic_x; col++)
+static void
+resample_build_taps (unsigned int out_count, unsigned int in_count,
+		     unsigned int factor, int radius,
+		     double (*kernel) (double), unsigned int max_taps,
+		     unsigned int *first, unsigned int *count,
+		     double *weights, double *totals)
+{
+/*
+/ precomputing the convolution weights along one axis; the kernel is
+/ stretched by the reduction factor, and it's clipped at the edges
+/ of the input tile
+*/
+    unsigned int o;
+    unsigned int t;
+    for (o = 0; o < out_count; o++)
+      {
+	  double center = (((double) o + 0.5) * (double) factor) - 0.5;
+	  double lo = ceil (center - ((double) radius * factor));
+	  double hi = floor (center + ((double) radius * factor));
+	  first[o] = 0;
+	  count[o] = 0;
+	  totals[o] = 0.0;
+	  if (lo < 0.0)
+	      lo = 0.0;
+	  if (hi > (double) in_count - 1.0)
+	      hi = (double) in_count - 1.0;
+	  if (hi < lo)
+	      continue;
+	  first[o] = (unsigned int) lo;
+	  count[o] = (unsigned int) (hi - lo) + 1;
+	  if (count[o] > max_taps)
+	      count[o] = max_taps;
+	  for (t = 0; t < count[o]; t++)
 	    {
-		unsigned int xx = col + x;
-		int *p_out = p_out_base + xx;
-		if (xx >= tileWidth)
-		    break;
-		*p_out =
-		    rescale_pixel_int32 (buf_in, tileWidth, tileHeight,
-					 col * 8, row * 8, nd);
+		double w =
+		    kernel (((double) (first[o] + t) - center) /
+			    (double) factor);
+		weights[(o * max_taps) + t] = w;
+		totals[o] += w;
 	    }
       }
 }
 
-static double
-rescale_pixel_uint32 (const unsigned int *buf_in, unsigned int tileWidth,
-		      unsigned int tileHeight, int x, int y, unsigned int nd)
+static void
+resample_convolve_row (rl2BoxFilterPtr flt, const double *row,
+		       const unsigned char *ok, unsigned int max_taps,
+		       const unsigned int *first, const unsigned int *count,
+		       const double *weights, double *sums, double *wsums)
 {
-/* rescaling a DataGrid pixel (8x8) - UINT32 */
-    unsigned int row;
-    unsigned int col;
-    int nodata = 0;
-    int valid = 0;
-    double sum = 0.0;
-
-    for (row = 0; row < 8; row++)
+/* horizontal pass: convolving a single input row */
+    int nb = flt->num_bands;
+    unsigned int ox;
+    unsigned int t;
+    int ib;
+    for (ox = 0; ox < flt->out_width; ox++)
       {
-	  const unsigned int *p_in_base;
-	  unsigned int yy = y + row;
-	  if (yy >= tileHeight)
-	      break;
-	  p_in_base = buf_in + (yy * tileWidth);
-	  for (col = 0; col < 8; col++)
+	  const double *w = weights + (ox * max_taps);
+	  for (ib = 0; ib < nb; ib++)
 	    {
-		const unsigned int *p_in;
-		unsigned int xx = x + col;
-		if (xx >= tileWidth)
-		    break;
-		p_in = p_in_base + x;
-		if (*p_in == nd)
-		    nodata++;
-		else
+		double s = 0.0;
+		double ws = 0.0;
+		unsigned int i = (first[ox] * nb) + ib;
+		for (t = 0; t < count[ox]; t++, i += nb)
 		  {
-		      valid++;
-		      sum += *p_in;
+		      if (!ok[i])
+			  continue;
+		      s += w[t] * row[i];
+		      ws += w[t];
 		  }
+		sums[(ox * nb) + ib] = s;
+		wsums[(ox * nb) + ib] = ws;
 	    }
       }
-
-    if (nodata >= valid)
-	return nd;
-    return (unsigned int) (sum / (double) valid);
 }
 
-static void
-rescale_grid_uint32 (unsigned int *buf_out, unsigned int tileWidth,
-		     unsigned int tileHeight, const unsigned int *buf_in,
-		     int x, int y, int tic_x, int tic_y, rl2PixelPtr no_data)
+static int
+resample_convolve (rl2BoxFilterPtr flt, int radius,
+		   double (*kernel) (double))
 {
-/* rescaling a DataGrid tile - unsigned int 32 bit */
-    unsigned int row;
-    unsigned int col;
-    unsigned int nd = 0;
-    rl2PrivPixelPtr pxl = (rl2PrivPixelPtr) no_data;
-
-    if (pxl != NULL)
+/*
+/ BILINEAR or CUBIC - separable convolution: each input row is first
+/ convolved horizontally (just once, the results being kept into a
+/ ring buffer), then the output rows are vertically combined
+*/
+    int nb = flt->num_bands;
+    unsigned int n_in = flt->in_width * nb;
+    unsigned int n_out = flt->out_width * nb;
+    unsigned int f = flt->factor;
+    unsigned int max_taps = (2 * radius * f) + 2;
+    unsigned int ring = max_taps;
+    double *nd = NULL;
+    double *row = NULL;
+    unsigned char *ok = NULL;
+    unsigned int *x_first = NULL;
+    unsigned int *x_count = NULL;
+    double *x_weights = NULL;
+    double *x_totals = NULL;
+    unsigned int *y_first = NULL;
+    unsigned int *y_count = NULL;
+    double *y_weights = NULL;
+    double *y_totals = NULL;
+    double *sums = NULL;
+    double *wsums = NULL;
+    double *vals = NULL;
+    double *weight = NULL;
+    unsigned char *valid = NULL;
+    unsigned int next_row = 0;
+    unsigned int ox;
+    unsigned int oy;
+    unsigned int t;
+    unsigned int i;
+    int retcode = RL2_ERROR;
+
+    row = malloc (sizeof (double) * n_in);
+    ok = malloc (n_in);
+    x_first = malloc (sizeof (unsigned int) * flt->out_width);
+    x_count = malloc (sizeof (unsigned int) * flt->out_width);
+    x_weights = malloc (sizeof (double) * max_taps * flt->out_width);
+    x_totals = malloc (sizeof (double) * flt->out_width);
+    y_first = malloc (sizeof (unsigned int) * flt->out_height);
+    y_count = malloc (sizeof (unsigned int) * flt->out_height);
+    y_weights = malloc (sizeof (double) * max_taps * flt->out_height);
+    y_totals = malloc (sizeof (double) * flt->out_height);
+    sums = malloc (sizeof (double) * n_out * ring);
+    wsums = malloc (sizeof (double) * n_out * ring);
+    vals = malloc (sizeof (double) * n_out);
+    weight = malloc (sizeof (double) * n_out);
+    valid = malloc (n_out);
+    if (row == NULL || ok == NULL || x_first == NULL || x_count == NULL
+	|| x_weights == NULL || x_totals == NULL || y_first == NULL
+	|| y_count == NULL || y_weights == NULL || y_totals == NULL
+	|| sums == NULL || wsums == NULL || vals == NULL || weight == NULL
+	|| valid == NULL)
+	goto error;
+    if (flt->no_data != NULL)
       {
-	  /* retrieving the NO-DATA value */
-	  if (pxl->sampleType == RL2_SAMPLE_UINT32 && pxl->nBands == 1)
-	    {
-		rl2PrivSamplePtr sample = pxl->Samples + 0;
-		nd = sample->uint32;
-	    }
+	  nd = resample_no_data (flt);
+	  if (nd == NULL)
+	      goto error;
       }
+    resample_build_taps (flt->out_width, flt->in_width, f, radius, kernel,
+			 max_taps, x_first, x_count, x_weights, x_totals);
+    resample_build_taps (flt->out_height, flt->in_height, f, radius, kernel,
+			 max_taps, y_first, y_count, y_weights, y_totals);
 
-    for (row = 0; row < (unsigned int) tic_y; row++)
+    for (oy = 0; oy < flt->out_height; oy++)
       {
-	  unsigned int yy = row + y;
-	  unsigned int *p_out_base = buf_out + (yy * tileWidth);
-	  if (yy >= tileHeight)
-	      break;
-	  for (col = 0; col < (unsigned int) tic_x; col++)
+	  const double *wy = y_weights + (oy * max_taps);
+	  memset (valid, 0, n_out);
+	  if (y_count[oy] == 0)
 	    {
-		unsigned int xx = col + x;
-		unsigned int *p_out = p_out_base + xx;
-		if (xx >= tileWidth)
-		    break;
-		*p_out =
-		    rescale_pixel_uint32 (buf_in, tileWidth, tileHeight,
-					  col * 8, row * 8, nd);
+		/* entirely beyond the input tile */
+		resample_emit_row (flt, oy, vals, valid, nd);
+		continue;
 	    }
-      }
-}
-
-static double
-rescale_pixel_float (const float *buf_in, unsigned int tileWidth,
-		     unsigned int tileHeight, int x, int y, float nd)
-{
-/* rescaling a DataGrid pixel (8x8) - Float */
-    unsigned int row;
-    unsigned int col;
-    int nodata = 0;
-    int valid = 0;
-    double sum = 0.0;
-
-    for (row = 0; row < 8; row++)
-      {
-	  const float *p_in_base;
-	  unsigned int yy = y + row;
-	  if (yy >= tileHeight)
-	      break;
-	  p_in_base = buf_in + (yy * tileWidth);
-	  for (col = 0; col < 8; col++)
+	  if (next_row < y_first[oy])
+	      next_row = y_first[oy];
+	  while (next_row < y_first[oy] + y_count[oy])
 	    {
-		const float *p_in;
-		unsigned int xx = x + col;
-		if (xx >= tileWidth)
-		    break;
-		p_in = p_in_base + x;
-		if (*p_in == nd)
-		    nodata++;
-		else
+		/* horizontal pass on any input row not yet convolved */
+		unsigned int slot = (next_row % ring) * n_out;
+		rl2_box_widen_row (flt->in, (size_t) next_row * n_in, n_in,
+				   flt->sample_type, row);
+		rl2_box_check_row (flt, next_row, row, nd, ok);
+		resample_convolve_row (flt, row, ok, max_taps, x_first,
+				       x_count, x_weights, sums + slot,
+				       wsums + slot);
+		next_row++;
+	    }
+	  for (i = 0; i < n_out; i++)
+	    {
+		vals[i] = 0.0;
+		weight[i] = 0.0;
+	    }
+	  for (t = 0; t < y_count[oy]; t++)
+	    {
+		/* vertical pass */
+		unsigned int slot = ((y_first[oy] + t) % ring) * n_out;
+		for (i = 0; i < n_out; i++)
+		  {
+		      vals[i] += wy[t] * sums[slot + i];
+		      weight[i] += wy[t] * wsums[slot + i];
+		  }
+	    }
+	  for (ox = 0; ox < flt->out_width; ox++)
+	    {
+		double total = x_totals[ox] * y_totals[oy];
+		int ib;
+		for (ib = 0; ib < nb; ib++)
 		  {
-		      valid++;
-		      sum += *p_in;
+		      i = (ox * nb) + ib;
+		      if (total <= 0.0
+			  || weight[i] <= (0.5 + RL2_RESAMPLE_EPSILON) * total)
+			  continue;	/* NO-DATA */
+		      vals[i] /= weight[i];
+		      valid[i] = 1;
 		  }
 	    }
+	  resample_emit_row (flt, oy, vals, valid, nd);
       }
+    retcode = RL2_OK;
 
-    if (nodata >= valid)
-	return nd;
-    return (float) (sum / (double) valid);
+  error:
+    if (nd != NULL)
+	free (nd);
+    if (row != NULL)
+	free (row);
+    if (ok != NULL)
+	free (ok);
+    if (x_first != NULL)
+	free (x_first);
+    if (x_count != NULL)
+	free (x_count);
+    if (x_weights != NULL)
+	free (x_weights);
+    if (x_totals != NULL)
+	free (x_totals);
+    if (y_first != NULL)
+	free (y_first);
+    if (y_count != NULL)
+	free (y_count);
+    if (y_weights != NULL)
+	free (y_weights);
+    if (y_totals != NULL)
+	free (y_totals);
+    if (sums != NULL)
+	free (sums);
+    if (wsums != NULL)
+	free (wsums);
+    if (vals != NULL)
+	free (vals);
+    if (weight != NULL)
+	free (weight);
+    if (valid != NULL)
+	free (valid);
+    return retcode;
 }
 
-static void
-rescale_grid_float (float *buf_out, unsigned int tileWidth,
-		    unsigned int tileHeight, const float *buf_in, int x,
-		    int y, int tic_x, int tic_y, rl2PixelPtr no_data)
+static int
+resample_tile (rl2BoxFilterPtr flt, unsigned char resampling)
 {
-/* rescaling a DataGrid tile - Float */
-    unsigned int row;
-    unsigned int col;
-    float nd = 0.0;
+/* reducing a base tile: dispatching to the selected kernel */
+    if (flt->in == NULL || flt->out == NULL || flt->factor < 1
+	|| flt->num_bands < 1)
+	return RL2_ERROR;
+    switch (resampling)
+      {
+      case RL2_RESAMPLING_NEAREST:
+	  return resample_nearest (flt);
+      case RL2_RESAMPLING_MODE:
+	  return resample_mode (flt);
+      case RL2_RESAMPLING_BILINEAR:
+	  return resample_convolve (flt, 1, resample_kernel_bilinear);
+      case RL2_RESAMPLING_CUBIC:
+	  return resample_convolve (flt, 2, resample_kernel_cubic);
+      };
+    return rl2_box_reduce (flt);
+}
+
+static int
+rescale_base_tile (void *buf_out, unsigned int tileWidth,
+		   unsigned int tileHeight, const void *buf_in,
+		   unsigned char sample_type, unsigned char num_bands,
+		   int pixel_sz, unsigned int x, unsigned int y,
+		   unsigned int tic_x, unsigned int tic_y, rl2PixelPtr no_data,
+		   unsigned int factor, unsigned char resampling)
+{
+/* rescaling a DataGrid or MultiBand base tile */
+    rl2BoxFilter filter;
+    rl2PrivSample zero_nd[256];
     rl2PrivPixelPtr pxl = (rl2PrivPixelPtr) no_data;
 
+    if (x >= tileWidth || y >= tileHeight)
+	return 1;
+    memset (zero_nd, 0, sizeof (rl2PrivSample) * num_bands);
+    filter.no_data = zero_nd;
     if (pxl != NULL)
       {
 	  /* retrieving the NO-DATA value */
-	  if (pxl->sampleType == RL2_SAMPLE_FLOAT && pxl->nBands == 1)
-	    {
-		rl2PrivSamplePtr sample = pxl->Samples + 0;
-		nd = sample->float32;
-	    }
-      }
+	  if (pxl->sampleType == sample_type && pxl->nBands == num_bands)
+	      filter.no_data = pxl->Samples;
+      }
+    filter.in = buf_in;
+    filter.mask_in = NULL;
+    filter.in_width = tileWidth;
+    filter.in_height = tileHeight;
+    filter.sample_type = sample_type;
+    filter.num_bands = num_bands;
+    filter.factor = factor;
+    filter.pixel_nodata = 0;
+    filter.out =
+	(unsigned char *) buf_out +
+	((((size_t) y * tileWidth) + x) * pixel_sz * num_bands);
+    filter.mask_out = NULL;
+    filter.out_width = tic_x;
+    if (x + tic_x > tileWidth)
+	filter.out_width = tileWidth - x;
+    filter.out_height = tic_y;
+    if (y + tic_y > tileHeight)
+	filter.out_height = tileHeight - y;
+    filter.out_stride = tileWidth;
+    if (resample_tile (&filter, resampling) != RL2_OK)
+	return 0;
+    return 1;
+}
 
-    for (row = 0; row < (unsigned int) tic_y; row++)
-      {
-	  unsigned int yy = row + y;
-	  float *p_out_base = buf_out + (yy * tileWidth);
-	  if (yy >= tileHeight)
-	      break;
-	  for (col = 0; col < (unsigned int) tic_x; col++)
-	    {
-		unsigned int xx = col + x;
-		float *p_out = p_out_base + xx;
-		if (xx >= tileWidth)
-		    break;
-		*p_out =
-		    rescale_pixel_float (buf_in, tileWidth, tileHeight,
-					 col * 8, row * 8, nd);
-	    }
-      }
+static int
+resample_rgba_base_tile (unsigned char *rgba_out, unsigned char *mask_out,
+			 unsigned int tileWidth, unsigned int tileHeight,
+			 const unsigned char *rgba_in, unsigned int x,
+			 unsigned int y, unsigned int factor,
+			 unsigned char resampling)
+{
+/*
+/ rescaling an RGBA base tile by some resampling kernel (not Cairo);
+/ any pixel with alpha < 128 is considered to be transparent
+*/
+    rl2BoxFilter filter;
+    unsigned char *mask_in;
+    unsigned int i;
+    unsigned int n = tileWidth * tileHeight;
+    int ret;
+
+    if (x >= tileWidth || y >= tileHeight)
+	return 1;
+    mask_in = malloc (n);
+    if (mask_in == NULL)
+	return 0;
+    for (i = 0; i < n; i++)
+	mask_in[i] = (rgba_in[(i * 4) + 3] < 128) ? 0 : 1;
+    filter.in = rgba_in;
+    filter.mask_in = mask_in;
+    filter.in_width = tileWidth;
+    filter.in_height = tileHeight;
+    filter.sample_type = RL2_SAMPLE_UINT8;
+    filter.num_bands = 4;
+    filter.factor = factor;
+    filter.no_data = NULL;
+    filter.pixel_nodata = 1;
+    filter.out = rgba_out + ((((size_t) y * tileWidth) + x) * 4);
+    filter.mask_out = mask_out + ((size_t) y * tileWidth) + x;
+    filter.out_width = tileWidth / factor;
+    if (x + filter.out_width > tileWidth)
+	filter.out_width = tileWidth - x;
+    filter.out_height = tileHeight / factor;
+    if (y + filter.out_height > tileHeight)
+	filter.out_height = tileHeight - y;
+    filter.out_stride = tileWidth;
+    ret = resample_tile (&filter, resampling);
+    free (mask_in);
+    if (ret != RL2_OK)
+	return 0;
+    return 1;
 }
 
-static double
-rescale_pixel_double (const double *buf_in, unsigned int tileWidth,
-		      unsigned int tileHeight, int x, int y, double nd)
+static void
+locate_base_tile (rl2AuxPyramidTilePtr job, rl2AuxPyramidBasePtr base,
+		  unsigned int *x, unsigned int *y)
 {
-/* rescaling a DataGrid pixel (8x8) - Double */
+/* locating the position of some base Tile within the Pyramid tile */
+    SectionPyramidPtr pyr = job->pyr;
+    SectionPyramidTileOutPtr tile_out = job->tile_out;
     unsigned int row;
     unsigned int col;
-    int nodata = 0;
-    int valid = 0;
-    double sum = 0.0;
+    unsigned int tic_x = job->tile_width / pyr->scale;
+    unsigned int tic_y = job->tile_height / pyr->scale;
+    double geo_x = (double) tic_x * pyr->res_x;
+    double geo_y = (double) tic_y * pyr->res_y;
+    double pos_x;
+    double pos_y = tile_out->maxy;
 
-    for (row = 0; row < 8; row++)
+    *x = 0;
+    *y = 0;
+    for (row = 0; row < job->tile_height; row += tic_y)
       {
-	  const double *p_in_base;
-	  unsigned int yy = y + row;
-	  if (yy >= tileHeight)
-	      break;
-	  p_in_base = buf_in + (yy * tileWidth);
-	  for (col = 0; col < 8; col++)
+	  pos_x = tile_out->minx;
+	  for (col = 0; col < job->tile_width; col += tic_x)
 	    {
-		const double *p_in;
-		unsigned int xx = x + col;
-		if (xx >= tileWidth)
-		    break;
-		p_in = p_in_base + x;
-		if (*p_in == nd)
-		    nodata++;
-		else
+		if (base->y < pos_y && base->y > (pos_y - geo_y)
+		    && base->x > pos_x && base->x < (pos_x + geo_x))
 		  {
-		      valid++;
-		      sum += *p_in;
+		      *x = col;
+		      *y = row;
+		      break;
 		  }
+		pos_x += geo_x;
 	    }
+	  pos_y -= geo_y;
       }
-
-    if (nodata >= valid)
-	return nd;
-    return sum / (double) valid;
 }
 
-static void
-rescale_grid_double (double *buf_out, unsigned int tileWidth,
-		     unsigned int tileHeight, const double *buf_in, int x,
-		     int y, int tic_x, int tic_y, rl2PixelPtr no_data)
+static unsigned char *
+create_sect_tile_mask (rl2AuxPyramidTilePtr job, int *mask_sz)
 {
-/* rescaling a DataGrid tile - Double */
+/* 
+/ allocating and initializing a transparency mask (only required when
+/ some portion of the tile exceeds the scaled section size)
+*/
+    SectionPyramidPtr pyr = job->pyr;
+    SectionPyramidTileOutPtr tile_out = job->tile_out;
+    unsigned char *mask;
+    unsigned char *p;
     unsigned int row;
     unsigned int col;
-    double nd = 0.0;
-    rl2PrivPixelPtr pxl = (rl2PrivPixelPtr) no_data;
-
-    if (pxl != NULL)
-      {
-	  /* retrieving the NO-DATA value */
-	  if (pxl->sampleType == RL2_SAMPLE_DOUBLE && pxl->nBands == 1)
-	    {
-		rl2PrivSamplePtr sample = pxl->Samples + 0;
-		nd = sample->float64;
-	    }
-      }
 
-    for (row = 0; row < (unsigned int) tic_y; row++)
+    *mask_sz = job->tile_width * job->tile_height;
+    mask = malloc (*mask_sz);
+    if (mask == NULL)
+	return NULL;
+    p = mask;
+    for (row = 0; row < job->tile_height; row++)
       {
-	  unsigned int yy = row + y;
-	  double *p_out_base = buf_out + (yy * tileWidth);
-	  if (yy >= tileHeight)
-	      break;
-	  for (col = 0; col < (unsigned int) tic_x; col++)
+	  unsigned int x_row = tile_out->row + row;
+	  for (col = 0; col < job->tile_width; col++)
 	    {
-		unsigned int xx = col + x;
-		double *p_out = p_out_base + xx;
-		if (xx >= tileWidth)
-		    break;
-		*p_out =
-		    rescale_pixel_double (buf_in, tileWidth, tileHeight,
-					  col * 8, row * 8, nd);
+		unsigned int x_col = tile_out->col + col;
+		if (x_row >= pyr->scaled_height || x_col >= pyr->scaled_width)
+		  {
+		      /* masking any portion of the tile exceeding the scaled section size */
+		      *p++ = 0;
+		  }
+		else
+		    *p++ = 1;
 	    }
       }
-}
-
-static void
-rescale_grid (void *buf_out, unsigned int tileWidth,
-	      unsigned int tileHeight, const void *buf_in,
-	      unsigned char sample_type, int x, int y, int tic_x, int tic_y,
-	      rl2PixelPtr no_data)
-{
-/* rescaling a DataGrid tile */
-    switch (sample_type)
-      {
-      case RL2_SAMPLE_INT8:
-	  rescale_grid_int8 ((char *) buf_out, tileWidth, tileHeight,
-			     (const char *) buf_in, x, y, tic_x, tic_y,
-			     no_data);
-	  break;
-      case RL2_SAMPLE_UINT8:
-	  rescale_grid_uint8 ((unsigned char *) buf_out, tileWidth,
-			      tileHeight, (const unsigned char *) buf_in, x,
-			      y, tic_x, tic_y, no_data);
-	  break;
-      case RL2_SAMPLE_INT16:
-	  rescale_grid_int16 ((short *) buf_out, tileWidth, tileHeight,
-			      (const short *) buf_in, x, y, tic_x, tic_y,
-			      no_data);
-	  break;
-      case RL2_SAMPLE_UINT16:
-	  rescale_grid_uint16 ((unsigned short *) buf_out, tileWidth,
-			       tileHeight, (const unsigned short *) buf_in, x,
-			       y, tic_x, tic_y, no_data);
-	  break;
-      case RL2_SAMPLE_INT32:
-	  rescale_grid_int32 ((int *) buf_out, tileWidth, tileHeight,
-			      (const int *) buf_in, x, y, tic_x, tic_y,
-			      no_data);
-	  break;
-      case RL2_SAMPLE_UINT32:
-	  rescale_grid_uint32 ((unsigned int *) buf_out, tileWidth,
-			       tileHeight, (const unsigned int *) buf_in, x,
-			       y, tic_x, tic_y, no_data);
-	  break;
-      case RL2_SAMPLE_FLOAT:
-	  rescale_grid_float ((float *) buf_out, tileWidth, tileHeight,
-			      (const float *) buf_in, x, y, tic_x, tic_y,
-			      no_data);
-	  break;
-      case RL2_SAMPLE_DOUBLE:
-	  rescale_grid_double ((double *) buf_out, tileWidth, tileHeight,
-			       (const double *) buf_in, x, y, tic_x, tic_y,
-			       no_data);
-	  break;
-      };
+    return mask;
 }
 
 static int
-update_sect_pyramid_grid (sqlite3 * handle, sqlite3_stmt * stmt_rd,
-			  sqlite3_stmt * stmt_tils, sqlite3_stmt * stmt_data,
-			  SectionPyramid * pyr, unsigned int tileWidth,
-			  unsigned int tileHeight, int id_level,
-			  rl2PixelPtr no_data, unsigned char sample_type)
+rescale_sect_tile_grid (rl2AuxPyramidTilePtr job)
 {
-/* creating and inserting Pyramid tiles */
+/* creating a rescaled Pyramid tile - DataGrid */
+    SectionPyramidPtr pyr = job->pyr;
+    SectionPyramidTileOutPtr tile_out = job->tile_out;
+    unsigned int tileWidth = job->tile_width;
+    unsigned int tileHeight = job->tile_height;
+    unsigned char sample_type = pyr->sample_type;
     unsigned char *buf_out = NULL;
     unsigned char *mask = NULL;
-    SectionPyramidTileOutPtr tile_out;
-    SectionPyramidTileRefPtr tile_in;
+    rl2AuxPyramidBasePtr base;
     unsigned int x;
     unsigned int y;
-    unsigned int row;
-    unsigned int col;
-    int tic_x;
-    int tic_y;
-    double pos_y;
-    double pos_x;
-    double geo_x;
-    double geo_y;
+    int ib;
+    unsigned int tic_x;
+    unsigned int tic_y;
     rl2PixelPtr nd = NULL;
     rl2RasterPtr raster_out = NULL;
     rl2RasterPtr raster_in = NULL;
-    unsigned char *blob_odd;
-    int blob_odd_sz;
-    unsigned char *blob_even;
-    int blob_even_sz;
+    rl2PrivRasterPtr rst;
     int pixel_sz = 1;
     int out_sz;
     int mask_sz = 0;
-    unsigned char compression;
 
-    if (pyr == NULL)
-	goto error;
     tic_x = tileWidth / pyr->scale;
     tic_y = tileHeight / pyr->scale;
-    geo_x = (double) tic_x *pyr->res_x;
-    geo_y = (double) tic_y *pyr->res_y;
-    compression = pyr->compression;
-
     switch (sample_type)
       {
       case RL2_SAMPLE_INT16:
@@ -1446,122 +1654,58 @@ update_sect_pyramid_grid (sqlite3 * handle, sqlite3_stmt * stmt_rd,
       };
     out_sz = tileWidth * tileHeight * pixel_sz;
 
-    tile_out = pyr->first_out;
-    while (tile_out != NULL)
+/* allocating the output buffer */
+    buf_out = malloc (out_sz);
+    if (buf_out == NULL)
+	goto error;
+    rl2_prime_void_tile (buf_out, tileWidth, tileHeight, sample_type, 1,
+			 job->no_data);
+    if (tile_out->col + tileWidth > pyr->scaled_width
+	|| tile_out->row + tileHeight > pyr->scaled_height)
       {
-	  rl2PrivRasterPtr rst;
-	  /* allocating the output buffer */
-	  buf_out = malloc (out_sz);
-	  if (buf_out == NULL)
+	  mask = create_sect_tile_mask (job, &mask_sz);
+	  if (mask == NULL)
 	      goto error;
-	  rl2_prime_void_tile (buf_out, tileWidth, tileHeight, sample_type, 1,
-			       no_data);
-
-	  if (tile_out->col + tileWidth > pyr->scaled_width
-	      || tile_out->row + tileHeight > pyr->scaled_height)
-	    {
-		/* allocating and initializing a transparency mask */
-		unsigned char *p;
-		mask_sz = tileWidth * tileHeight;
-		mask = malloc (mask_sz);
-		if (mask == NULL)
-		    goto error;
-		p = mask;
-		for (row = 0; row < tileHeight; row++)
-		  {
-		      unsigned int x_row = tile_out->row + row;
-		      for (col = 0; col < tileWidth; col++)
-			{
-			    unsigned int x_col = tile_out->col + col;
-			    if (x_row >= pyr->scaled_height
-				|| x_col >= pyr->scaled_width)
-			      {
-				  /* masking any portion of the tile exceeding the scaled section size */
-				  *p++ = 0;
-			      }
-			    else
-				*p++ = 1;
-			}
-		  }
-	    }
-	  else
-	    {
-		mask = NULL;
-		mask_sz = 0;
-	    }
-
-	  /* creating the output (rescaled) tile */
-	  tile_in = tile_out->first;
-	  while (tile_in != NULL)
-	    {
-		/* loading and rescaling the base tiles */
-		raster_in =
-		    load_tile_base_generic (stmt_rd, tile_in->child->tile_id);
-		if (raster_in == NULL)
-		    goto error;
-		pos_y = tile_out->maxy;
-		x = 0;
-		y = 0;
-		for (row = 0; row < tileHeight; row += tic_y)
-		  {
-		      pos_x = tile_out->minx;
-		      for (col = 0; col < tileWidth; col += tic_x)
-			{
-			    if (tile_in->child->cy < pos_y
-				&& tile_in->child->cy > (pos_y - geo_y)
-				&& tile_in->child->cx > pos_x
-				&& tile_in->child->cx < (pos_x + geo_x))
-			      {
-				  x = col;
-				  y = row;
-				  break;
-			      }
-			    pos_x += geo_x;
-			}
-		      pos_y -= geo_y;
-		  }
-		rst = (rl2PrivRasterPtr) raster_in;
-		rescale_grid (buf_out, tileWidth, tileHeight,
-			      rst->rasterBuffer, sample_type, x, y, tic_x,
-			      tic_y, no_data);
-		rl2_destroy_raster (raster_in);
-		raster_in = NULL;
-		tile_in = tile_in->next;
-	    }
+      }
 
-	  raster_out = NULL;
-	  raster_out =
-	      rl2_create_raster (tileWidth, tileHeight, sample_type,
-				 RL2_PIXEL_DATAGRID, 1, buf_out,
-				 out_sz, NULL, mask, mask_sz, nd);
-	  buf_out = NULL;
-	  mask = NULL;
-	  if (raster_out == NULL)
-	    {
-		fprintf (stderr, "ERROR: unable to create a Pyramid Tile\n");
-		goto error;
-	    }
-	  if (rl2_raster_encode
-	      (raster_out, compression, &blob_odd, &blob_odd_sz,
-	       &blob_even, &blob_even_sz, 100, 1) != RL2_OK)
-	    {
-		fprintf (stderr, "ERROR: unable to encode a Pyramid tile\n");
-		goto error;
-	    }
-	  rl2_destroy_raster (raster_out);
-	  raster_out = NULL;
-
-	  /* INSERTing the tile */
-	  if (!do_insert_pyramid_tile
-	      (handle, blob_odd, blob_odd_sz, blob_even, blob_even_sz,
-	       id_level, pyr->section_id, pyr->srid, tile_out->minx,
-	       tile_out->miny, tile_out->maxx, tile_out->maxy, stmt_tils,
-	       stmt_data))
+/* creating the output (rescaled) tile */
+    for (ib = 0; ib < job->num_bases; ib++)
+      {
+	  /* decoding and rescaling the base tiles */
+	  base = job->bases + ib;
+	  raster_in = load_tile_base_generic (base);
+	  if (raster_in == NULL)
 	      goto error;
-
-	  tile_out = tile_out->next;
+	  locate_base_tile (job, base, &x, &y);
+	  rst = (rl2PrivRasterPtr) raster_in;
+	  if (!rescale_base_tile
+	      (buf_out, tileWidth, tileHeight, rst->rasterBuffer, sample_type, 1,
+	       pixel_sz, x, y, tic_x, tic_y, job->no_data, pyr->scale,
+	       pyr->resampling))
+	      goto error;
+	  rl2_destroy_raster (raster_in);
+	  raster_in = NULL;
       }
 
+    raster_out =
+	rl2_create_raster (tileWidth, tileHeight, sample_type,
+			   RL2_PIXEL_DATAGRID, 1, buf_out, out_sz, NULL, mask,
+			   mask_sz, nd);
+    buf_out = NULL;
+    mask = NULL;
+    if (raster_out == NULL)
+      {
+	  fprintf (stderr, "ERROR: unable to create a Pyramid Tile\n");
+	  goto error;
+      }
+    if (rl2_raster_encode
+	(raster_out, pyr->compression, &(job->blob_odd), &(job->blob_odd_sz),
+	 &(job->blob_even), &(job->blob_even_sz), 100, 1) != RL2_OK)
+      {
+	  fprintf (stderr, "ERROR: unable to encode a Pyramid tile\n");
+	  goto error;
+      }
+    rl2_destroy_raster (raster_out);
     return 1;
 
   error:
@@ -1576,620 +1720,691 @@ update_sect_pyramid_grid (sqlite3 * handle, sqlite3_stmt * stmt_rd,
     return 0;
 }
 
-static double
-rescale_mb_pixel_uint8 (const unsigned char *buf_in, unsigned int tileWidth,
-			unsigned int tileHeight, unsigned int x,
-			unsigned int y, unsigned char nd, unsigned char nb,
-			unsigned char num_bands)
+static int
+rescale_sect_tile_multiband (rl2AuxPyramidTilePtr job)
 {
-/* rescaling a MultiBand pixel sample (8x8) - UINT8 */
-    unsigned int row;
-    unsigned int col;
-    int nodata = 0;
-    int valid = 0;
-    double sum = 0.0;
+/* creating a rescaled Pyramid tile - MultiBand */
+    SectionPyramidPtr pyr = job->pyr;
+    SectionPyramidTileOutPtr tile_out = job->tile_out;
+    unsigned int tileWidth = job->tile_width;
+    unsigned int tileHeight = job->tile_height;
+    unsigned char sample_type = pyr->sample_type;
+    unsigned char num_bands = pyr->num_samples;
+    unsigned char *buf_out = NULL;
+    unsigned char *mask = NULL;
+    rl2AuxPyramidBasePtr base;
+    unsigned int x;
+    unsigned int y;
+    int ib;
+    unsigned int tic_x;
+    unsigned int tic_y;
+    rl2PixelPtr nd = NULL;
+    rl2RasterPtr raster_out = NULL;
+    rl2RasterPtr raster_in = NULL;
+    rl2PrivRasterPtr rst;
+    int pixel_sz = 1;
+    int out_sz;
+    int mask_sz = 0;
 
-    for (row = 0; row < 8; row++)
+    tic_x = tileWidth / pyr->scale;
+    tic_y = tileHeight / pyr->scale;
+    switch (sample_type)
       {
-	  const unsigned char *p_in_base;
-	  unsigned int yy = y + row;
-	  if (yy >= tileHeight)
-	      break;
-	  p_in_base = buf_in + (yy * tileWidth * num_bands);
-	  for (col = 0; col < 8; col++)
-	    {
-		const unsigned char *p_in;
-		unsigned int xx = x + col;
-		if (xx >= tileWidth)
-		    break;
-		p_in = p_in_base + (xx * num_bands) + nb;
-		if (*p_in == nd)
-		    nodata++;
-		else
-		  {
-		      valid++;
-		      sum += *p_in;
-		  }
-	    }
-      }
-
-    if (nodata >= valid)
-	return nd;
-    return (unsigned char) (sum / (double) valid);
-}
-
-static void
-rescale_multiband_uint8 (unsigned char *buf_out, unsigned int tileWidth,
-			 unsigned int tileHeight, const unsigned char *buf_in,
-			 unsigned int x, unsigned int y, unsigned int tic_x,
-			 unsigned int tic_y, unsigned char num_bands,
-			 rl2PixelPtr no_data)
-{
-/* rescaling a MultiBand tile - unsigned int 8 bit */
-    unsigned int row;
-    unsigned int col;
-    unsigned char nb;
-    unsigned char nd = 0;
-    rl2PrivPixelPtr pxl = (rl2PrivPixelPtr) no_data;
+      case RL2_SAMPLE_UINT16:
+	  pixel_sz = 2;
+	  break;
+      };
+    out_sz = tileWidth * tileHeight * pixel_sz * num_bands;
 
-    for (row = 0; row < tic_y; row++)
+/* allocating the output buffer */
+    buf_out = malloc (out_sz);
+    if (buf_out == NULL)
+	goto error;
+    rl2_prime_void_tile (buf_out, tileWidth, tileHeight, sample_type,
+			 num_bands, job->no_data);
+    if (tile_out->col + tileWidth > pyr->scaled_width
+	|| tile_out->row + tileHeight > pyr->scaled_height)
       {
-	  unsigned int yy = row + y;
-	  unsigned char *p_out_base = buf_out + (yy * tileWidth * num_bands);
-	  if (yy >= tileHeight)
-	      break;
-	  for (col = 0; col < tic_x; col++)
-	    {
-		unsigned int xx = col + x;
-		unsigned char *p_out = p_out_base + (xx * num_bands);
-		if (xx >= tileWidth)
-		    break;
-		for (nb = 0; nb < num_bands; nb++)
-		  {
-		      if (pxl != NULL)
-			{
-			    if (pxl->sampleType == RL2_SAMPLE_UINT8
-				&& pxl->nBands == num_bands)
-			      {
-				  rl2PrivSamplePtr sample = pxl->Samples + nb;
-				  nd = sample->uint8;
-			      }
-			}
-		      *(p_out + nb) =
-			  rescale_mb_pixel_uint8 (buf_in, tileWidth,
-						  tileHeight, col * 8,
-						  row * 8, nd, nb, num_bands);
-		  }
-	    }
+	  mask = create_sect_tile_mask (job, &mask_sz);
+	  if (mask == NULL)
+	      goto error;
       }
-}
 
-static double
-rescale_mb_pixel_uint16 (const unsigned short *buf_in, unsigned int tileWidth,
-			 unsigned int tileHeight, unsigned int x,
-			 unsigned int y, unsigned short nd, unsigned char nb,
-			 unsigned char num_bands)
-{
-/* rescaling a MultiBand pixel sample (8x8) - UINT16 */
-    unsigned int row;
-    unsigned int col;
-    int nodata = 0;
-    int valid = 0;
-    double sum = 0.0;
+/* creating the output (rescaled) tile */
+    for (ib = 0; ib < job->num_bases; ib++)
+      {
+	  /* decoding and rescaling the base tiles */
+	  base = job->bases + ib;
+	  raster_in = load_tile_base_generic (base);
+	  if (raster_in == NULL)
+	      goto error;
+	  locate_base_tile (job, base, &x, &y);
+	  rst = (rl2PrivRasterPtr) raster_in;
+	  if (!rescale_base_tile
+	      (buf_out, tileWidth, tileHeight, rst->rasterBuffer, sample_type,
+	       num_bands, pixel_sz, x, y, tic_x, tic_y, job->no_data,
+	       pyr->scale, pyr->resampling))
+	      goto error;
+	  rl2_destroy_raster (raster_in);
+	  raster_in = NULL;
+      }
 
-    for (row = 0; row < 8; row++)
+    raster_out =
+	rl2_create_raster (tileWidth, tileHeight, sample_type,
+			   RL2_PIXEL_MULTIBAND, num_bands, buf_out, out_sz,
+			   NULL, mask, mask_sz, nd);
+    buf_out = NULL;
+    mask = NULL;
+    if (raster_out == NULL)
       {
-	  const unsigned short *p_in_base;
-	  unsigned int yy = y + row;
-	  if (yy >= tileHeight)
-	      break;
-	  p_in_base = buf_in + (yy * tileWidth * num_bands);
-	  for (col = 0; col < 8; col++)
-	    {
-		const unsigned short *p_in;
-		unsigned int xx = x + col;
-		if (xx >= tileWidth)
-		    break;
-		p_in = p_in_base + (xx * num_bands) + nb;
-		if (*p_in == nd)
-		    nodata++;
-		else
-		  {
-		      valid++;
-		      sum += *p_in;
-		  }
-	    }
+	  fprintf (stderr, "ERROR: unable to create a Pyramid Tile\n");
+	  goto error;
+      }
+    if (rl2_raster_encode
+	(raster_out, pyr->compression, &(job->blob_odd), &(job->blob_odd_sz),
+	 &(job->blob_even), &(job->blob_even_sz), 100, 1) != RL2_OK)
+      {
+	  fprintf (stderr, "ERROR: unable to encode a Pyramid tile\n");
+	  goto error;
       }
+    rl2_destroy_raster (raster_out);
+    return 1;
 
-    if (nodata >= valid)
-	return nd;
-    return (unsigned short) (sum / (double) valid);
+  error:
+    if (raster_in != NULL)
+	rl2_destroy_raster (raster_in);
+    if (raster_out != NULL)
+	rl2_destroy_raster (raster_out);
+    if (buf_out != NULL)
+	free (buf_out);
+    if (mask != NULL)
+	free (mask);
+    return 0;
 }
 
-static void
-rescale_multiband_uint16 (unsigned short *buf_out, unsigned int tileWidth,
-			  unsigned int tileHeight,
-			  const unsigned short *buf_in, unsigned int x,
-			  unsigned int y, unsigned int tic_x,
-			  unsigned int tic_y, unsigned char num_bands,
-			  rl2PixelPtr no_data)
+static int
+draw_sect_tile_rgba (rl2AuxPyramidTilePtr job, unsigned char **rgb,
+		     unsigned char **alpha)
 {
-/* rescaling a MultiBand tile - unsigned int 16 bit */
-    unsigned int row;
-    unsigned int col;
-    unsigned char nb;
-    unsigned short nd = 0;
-    rl2PrivPixelPtr pxl = (rl2PrivPixelPtr) no_data;
+/* rescaling all base tiles by Cairo - RGB or Grayscale */
+    SectionPyramidPtr pyr = job->pyr;
+    unsigned int tileWidth = job->tile_width;
+    unsigned int tileHeight = job->tile_height;
+    unsigned char *buf_in = NULL;
+    rl2AuxPyramidBasePtr base;
+    rl2GraphicsBitmapPtr base_tile;
+    rl2GraphicsContextPtr ctx = NULL;
+    unsigned int x;
+    unsigned int y;
+    int ib;
+    int half_transparent;
 
-    for (row = 0; row < tic_y; row++)
+    *rgb = NULL;
+    *alpha = NULL;
+    ctx = rl2_graph_create_context (tileWidth, tileHeight);
+    if (ctx == NULL)
+	goto error;
+    for (ib = 0; ib < job->num_bases; ib++)
       {
-	  unsigned int yy = row + y;
-	  unsigned short *p_out_base = buf_out + (yy * tileWidth * num_bands);
-	  if (yy >= tileHeight)
-	      break;
-	  for (col = 0; col < tic_x; col++)
+	  /* decoding and rescaling the base tiles */
+	  base = job->bases + ib;
+	  buf_in = load_tile_base (base, job->palette, job->no_data);
+	  if (buf_in == NULL)
+	      goto error;
+	  base_tile = rl2_graph_create_bitmap (buf_in, tileWidth, tileHeight);
+	  if (base_tile == NULL)
 	    {
-		unsigned int xx = col + x;
-		unsigned short *p_out = p_out_base + (xx * num_bands);
-		if (xx >= tileWidth)
-		    break;
-		for (nb = 0; nb < num_bands; nb++)
-		  {
-		      if (pxl != NULL)
-			{
-			    if (pxl->sampleType == RL2_SAMPLE_UINT16
-				&& pxl->nBands == num_bands)
-			      {
-				  rl2PrivSamplePtr sample = pxl->Samples + nb;
-				  nd = sample->uint16;
-			      }
-			}
-		      *(p_out + nb) =
-			  rescale_mb_pixel_uint16 (buf_in, tileWidth,
-						   tileHeight, col * 8,
-						   row * 8, nd, nb, num_bands);
-		  }
+		free (buf_in);
+		goto error;
 	    }
+	  locate_base_tile (job, base, &x, &y);
+	  rl2_graph_draw_rescaled_bitmap (ctx, base_tile, 1.0 / pyr->scale,
+					  1.0 / pyr->scale, x, y);
+	  rl2_graph_destroy_bitmap (base_tile);
       }
-}
 
-static void
-rescale_multiband (void *buf_out, unsigned int tileWidth,
-		   unsigned int tileHeight, const void *buf_in,
-		   unsigned char sample_type, unsigned char num_bands,
-		   unsigned int x, unsigned int y, unsigned int tic_x,
-		   unsigned int tic_y, rl2PixelPtr no_data)
-{
-/* rescaling a Multiband tile */
-    switch (sample_type)
-      {
-      case RL2_SAMPLE_UINT8:
-	  rescale_multiband_uint8 ((unsigned char *) buf_out, tileWidth,
-				   tileHeight, (const unsigned char *) buf_in,
-				   x, y, tic_x, tic_y, num_bands, no_data);
-	  break;
-      case RL2_SAMPLE_UINT16:
-	  rescale_multiband_uint16 ((unsigned short *) buf_out, tileWidth,
-				    tileHeight,
-				    (const unsigned short *) buf_in, x, y,
-				    tic_x, tic_y, num_bands, no_data);
-	  break;
-      };
+    *rgb = rl2_graph_get_context_rgb_array (ctx);
+    if (*rgb == NULL)
+	goto error;
+    *alpha = rl2_graph_get_context_alpha_array (ctx, &half_transparent);
+    if (*alpha == NULL)
+	goto error;
+    rl2_graph_destroy_context (ctx);
+    return 1;
+
+  error:
+    if (*rgb != NULL)
+	free (*rgb);
+    *rgb = NULL;
+    if (ctx != NULL)
+	rl2_graph_destroy_context (ctx);
+    return 0;
 }
 
 static int
-update_sect_pyramid_multiband (sqlite3 * handle, sqlite3_stmt * stmt_rd,
-			       sqlite3_stmt * stmt_tils,
-			       sqlite3_stmt * stmt_data, SectionPyramid * pyr,
-			       unsigned int tileWidth,
-			       unsigned int tileHeight, int id_level,
-			       rl2PixelPtr no_data, unsigned char sample_type,
-			       unsigned char num_bands)
+resample_sect_tile_rgba (rl2AuxPyramidTilePtr job, unsigned char **rgb,
+			 unsigned char **alpha)
 {
-/* creating and inserting Pyramid tiles */
-    unsigned char *buf_out = NULL;
-    unsigned char *mask = NULL;
-    SectionPyramidTileOutPtr tile_out;
-    SectionPyramidTileRefPtr tile_in;
+/* rescaling all base tiles by the Resampling kernel - RGB or Grayscale */
+    SectionPyramidPtr pyr = job->pyr;
+    unsigned int tileWidth = job->tile_width;
+    unsigned int tileHeight = job->tile_height;
+    unsigned int n = tileWidth * tileHeight;
+    unsigned char *buf_in;
+    unsigned char *rgba = NULL;
+    rl2AuxPyramidBasePtr base;
     unsigned int x;
     unsigned int y;
-    unsigned int row;
-    unsigned int col;
-    unsigned int tic_x;
-    unsigned int tic_y;
-    double pos_y;
-    double pos_x;
-    double geo_x;
-    double geo_y;
-    rl2PixelPtr nd = NULL;
-    rl2RasterPtr raster_out = NULL;
-    rl2RasterPtr raster_in = NULL;
-    unsigned char *blob_odd;
-    int blob_odd_sz;
-    unsigned char *blob_even;
-    int blob_even_sz;
-    int pixel_sz = 1;
-    int out_sz;
-    int mask_sz = 0;
-    unsigned char compression;
+    unsigned int i;
+    int ib;
+    int ret;
 
-    if (pyr == NULL)
+    *rgb = NULL;
+    *alpha = NULL;
+    rgba = malloc (n * 4);
+    *alpha = malloc (n);
+    if (rgba == NULL || *alpha == NULL)
 	goto error;
-    tic_x = tileWidth / pyr->scale;
-    tic_y = tileHeight / pyr->scale;
-    geo_x = (double) tic_x *pyr->res_x;
-    geo_y = (double) tic_y *pyr->res_y;
-    compression = pyr->compression;
-
-    switch (sample_type)
-      {
-      case RL2_SAMPLE_UINT16:
-	  pixel_sz = 2;
-	  break;
-      };
-    out_sz = tileWidth * tileHeight * pixel_sz * num_bands;
-
-    tile_out = pyr->first_out;
-    while (tile_out != NULL)
-      {
-	  rl2PrivRasterPtr rst;
-	  /* allocating the output buffer */
-	  buf_out = malloc (out_sz);
-	  if (buf_out == NULL)
+    memset (rgba, 0, n * 4);
+    memset (*alpha, 0, n);
+    for (ib = 0; ib < job->num_bases; ib++)
+      {
+	  /* decoding and rescaling the base tiles */
+	  base = job->bases + ib;
+	  buf_in = load_tile_base (base, job->palette, job->no_data);
+	  if (buf_in == NULL)
 	      goto error;
-	  rl2_prime_void_tile (buf_out, tileWidth, tileHeight, sample_type,
-			       num_bands, no_data);
-
-	  if (tile_out->col + tileWidth > pyr->scaled_width
-	      || tile_out->row + tileHeight > pyr->scaled_height)
-	    {
-		/* allocating and initializing a transparency mask */
-		unsigned char *p;
-		mask_sz = tileWidth * tileHeight;
-		mask = malloc (mask_sz);
-		if (mask == NULL)
-		    goto error;
-		p = mask;
-		for (row = 0; row < tileHeight; row++)
-		  {
-		      unsigned int x_row = tile_out->row + row;
-		      for (col = 0; col < tileWidth; col++)
-			{
-			    unsigned int x_col = tile_out->col + col;
-			    if (x_row >= pyr->scaled_height
-				|| x_col >= pyr->scaled_width)
-			      {
-				  /* masking any portion of the tile exceeding the scaled section size */
-				  *p++ = 0;
-			      }
-			    else
-				*p++ = 1;
-			}
-		  }
-	    }
-	  else
-	    {
-		mask = NULL;
-		mask_sz = 0;
-	    }
-
-	  /* creating the output (rescaled) tile */
-	  tile_in = tile_out->first;
-	  while (tile_in != NULL)
-	    {
-		/* loading and rescaling the base tiles */
-		raster_in =
-		    load_tile_base_generic (stmt_rd, tile_in->child->tile_id);
-		if (raster_in == NULL)
-		    goto error;
-		pos_y = tile_out->maxy;
-		x = 0;
-		y = 0;
-		for (row = 0; row < tileHeight; row += tic_y)
-		  {
-		      pos_x = tile_out->minx;
-		      for (col = 0; col < tileWidth; col += tic_x)
-			{
-			    if (tile_in->child->cy < pos_y
-				&& tile_in->child->cy > (pos_y - geo_y)
-				&& tile_in->child->cx > pos_x
-				&& tile_in->child->cx < (pos_x + geo_x))
-			      {
-				  x = col;
-				  y = row;
-				  break;
-			      }
-			    pos_x += geo_x;
-			}
-		      pos_y -= geo_y;
-		  }
-		rst = (rl2PrivRasterPtr) raster_in;
-		rescale_multiband (buf_out, tileWidth, tileHeight,
-				   rst->rasterBuffer, sample_type, num_bands,
-				   x, y, tic_x, tic_y, no_data);
-		rl2_destroy_raster (raster_in);
-		raster_in = NULL;
-		tile_in = tile_in->next;
-	    }
-
-	  raster_out = NULL;
-	  raster_out =
-	      rl2_create_raster (tileWidth, tileHeight, sample_type,
-				 RL2_PIXEL_MULTIBAND, num_bands, buf_out,
-				 out_sz, NULL, mask, mask_sz, nd);
-	  buf_out = NULL;
-	  mask = NULL;
-	  if (raster_out == NULL)
-	    {
-		fprintf (stderr, "ERROR: unable to create a Pyramid Tile\n");
-		goto error;
-	    }
-	  if (rl2_raster_encode
-	      (raster_out, compression, &blob_odd, &blob_odd_sz,
-	       &blob_even, &blob_even_sz, 100, 1) != RL2_OK)
-	    {
-		fprintf (stderr, "ERROR: unable to encode a Pyramid tile\n");
-		goto error;
-	    }
-	  rl2_destroy_raster (raster_out);
-	  raster_out = NULL;
-
-	  /* INSERTing the tile */
-	  if (!do_insert_pyramid_tile
-	      (handle, blob_odd, blob_odd_sz, blob_even, blob_even_sz,
-	       id_level, pyr->section_id, pyr->srid, tile_out->minx,
-	       tile_out->miny, tile_out->maxx, tile_out->maxy, stmt_tils,
-	       stmt_data))
+	  locate_base_tile (job, base, &x, &y);
+	  ret =
+	      resample_rgba_base_tile (rgba, *alpha, tileWidth, tileHeight,
+				       buf_in, x, y, pyr->scale,
+				       pyr->resampling);
+	  free (buf_in);
+	  if (!ret)
 	      goto error;
-
-	  tile_out = tile_out->next;
       }
 
+    *rgb = malloc (n * 3);
+    if (*rgb == NULL)
+	goto error;
+    for (i = 0; i < n; i++)
+	memcpy (*rgb + (i * 3), rgba + (i * 4), 3);
+    free (rgba);
     return 1;
 
   error:
-    if (raster_in != NULL)
-	rl2_destroy_raster (raster_in);
-    if (raster_out != NULL)
-	rl2_destroy_raster (raster_out);
-    if (buf_out != NULL)
-	free (buf_out);
-    if (mask != NULL)
-	free (mask);
+    if (rgba != NULL)
+	free (rgba);
+    if (*alpha != NULL)
+	free (*alpha);
+    *alpha = NULL;
     return 0;
 }
 
 static int
-update_sect_pyramid (sqlite3 * handle, sqlite3_stmt * stmt_rd,
-		     sqlite3_stmt * stmt_tils, sqlite3_stmt * stmt_data,
-		     SectionPyramid * pyr, unsigned int tileWidth,
-		     unsigned int tileHeight, int id_level,
-		     rl2PalettePtr palette, rl2PixelPtr no_data)
+rescale_sect_tile_rgba (rl2AuxPyramidTilePtr job)
 {
-/* creating and inserting Pyramid tiles */
-    unsigned char *buf_in;
-    SectionPyramidTileOutPtr tile_out;
-    SectionPyramidTileRefPtr tile_in;
-    rl2GraphicsBitmapPtr base_tile;
-    rl2GraphicsContextPtr ctx = NULL;
-    unsigned int x;
-    unsigned int y;
+/* creating a rescaled Pyramid tile - RGB or Grayscale */
+    SectionPyramidPtr pyr = job->pyr;
+    SectionPyramidTileOutPtr tile_out = job->tile_out;
+    unsigned int tileWidth = job->tile_width;
+    unsigned int tileHeight = job->tile_height;
     unsigned int row;
     unsigned int col;
-    unsigned int tic_x;
-    unsigned int tic_y;
-    double pos_y;
-    double pos_x;
-    double geo_x;
-    double geo_y;
     unsigned char *rgb = NULL;
     unsigned char *alpha = NULL;
     rl2PixelPtr nd = NULL;
     rl2RasterPtr raster = NULL;
-    unsigned char *blob_odd;
-    int blob_odd_sz;
-    unsigned char *blob_even;
-    int blob_even_sz;
     unsigned char *p;
-    unsigned char compression;
-    int hald_transparent;
+    unsigned char compression = pyr->compression;
+    int ret;
 
-    if (pyr == NULL)
+/* creating the output (rescaled) tile */
+    if (pyr->resampling == RL2_RESAMPLING_DEFAULT)
+	ret = draw_sect_tile_rgba (job, &rgb, &alpha);
+    else
+	ret = resample_sect_tile_rgba (job, &rgb, &alpha);
+    if (!ret)
 	goto error;
-    tic_x = tileWidth / pyr->scale;
-    tic_y = tileHeight / pyr->scale;
-    geo_x = (double) tic_x *pyr->res_x;
-    geo_y = (double) tic_y *pyr->res_y;
-    compression = pyr->compression;
-
-    tile_out = pyr->first_out;
-    while (tile_out != NULL)
+    p = alpha;
+    for (row = 0; row < tileHeight; row++)
       {
-	  /* creating the output (rescaled) tile */
-	  ctx = rl2_graph_create_context (tileWidth, tileHeight);
-	  if (ctx == NULL)
-	      goto error;
-	  tile_in = tile_out->first;
-	  while (tile_in != NULL)
+	  unsigned int x_row = tile_out->row + row;
+	  for (col = 0; col < tileWidth; col++)
 	    {
-		/* loading and rescaling the base tiles */
-		buf_in =
-		    load_tile_base (stmt_rd, tile_in->child->tile_id, palette,
-				    no_data);
-		if (buf_in == NULL)
-		    goto error;
-		base_tile =
-		    rl2_graph_create_bitmap (buf_in, tileWidth, tileHeight);
-		if (base_tile == NULL)
+		unsigned int x_col = tile_out->col + col;
+		if (x_row >= pyr->scaled_height || x_col >= pyr->scaled_width)
 		  {
-		      free (buf_in);
-		      goto error;
+		      /* masking any portion of the tile exceeding the scaled section size */
+		      *p++ = 0;
 		  }
-		pos_y = tile_out->maxy;
-		x = 0;
-		y = 0;
-		for (row = 0; row < tileHeight; row += tic_y)
+		else
 		  {
-		      pos_x = tile_out->minx;
-		      for (col = 0; col < tileWidth; col += tic_x)
-			{
-			    if (tile_in->child->cy < pos_y
-				&& tile_in->child->cy > (pos_y - geo_y)
-				&& tile_in->child->cx > pos_x
-				&& tile_in->child->cx < (pos_x + geo_x))
-			      {
-				  x = col;
-				  y = row;
-				  break;
-			      }
-			    pos_x += geo_x;
-			}
-		      pos_y -= geo_y;
+		      if (*p == 0)
+			  p++;
+		      else
+			  *p++ = 1;
 		  }
-		rl2_graph_draw_rescaled_bitmap (ctx, base_tile,
-						1.0 / pyr->scale,
-						1.0 / pyr->scale, x, y);
-		rl2_graph_destroy_bitmap (base_tile);
-		tile_in = tile_in->next;
 	    }
+      }
 
-	  rgb = rl2_graph_get_context_rgb_array (ctx);
-	  if (rgb == NULL)
-	      goto error;
-	  alpha = rl2_graph_get_context_alpha_array (ctx, &hald_transparent);
-	  if (alpha == NULL)
+    if (pyr->pixel_type == RL2_PIXEL_GRAYSCALE
+	|| pyr->pixel_type == RL2_PIXEL_MONOCHROME)
+      {
+	  /* Grayscale Pyramid */
+	  unsigned char *p_in;
+	  unsigned char *p_out;
+	  unsigned char *gray = malloc (tileWidth * tileHeight);
+	  if (gray == NULL)
 	      goto error;
-	  p = alpha;
+	  p_in = rgb;
+	  p_out = gray;
 	  for (row = 0; row < tileHeight; row++)
 	    {
-		unsigned int x_row = tile_out->row + row;
 		for (col = 0; col < tileWidth; col++)
 		  {
-		      unsigned int x_col = tile_out->col + col;
-		      if (x_row >= pyr->scaled_height
-			  || x_col >= pyr->scaled_width)
-			{
-			    /* masking any portion of the tile exceeding the scaled section size */
-			    *p++ = 0;
-			}
-		      else
-			{
-			    if (*p == 0)
-				p++;
-			    else
-				*p++ = 1;
-			}
+		      *p_out++ = *p_in++;
+		      p_in += 2;
 		  }
 	    }
-
-	  raster = NULL;
-	  if (pyr->pixel_type == RL2_PIXEL_GRAYSCALE
-	      || pyr->pixel_type == RL2_PIXEL_MONOCHROME)
+	  free (rgb);
+	  rgb = NULL;
+	  if (pyr->pixel_type == RL2_PIXEL_MONOCHROME)
 	    {
-		/* Grayscale Pyramid */
-		unsigned char *p_in;
-		unsigned char *p_out;
-		unsigned char *gray = malloc (tileWidth * tileHeight);
-		if (gray == NULL)
-		    goto error;
-		p_in = rgb;
-		p_out = gray;
-		for (row = 0; row < tileHeight; row++)
-		  {
-		      for (col = 0; col < tileWidth; col++)
-			{
-			    *p_out++ = *p_in++;
-			    p_in += 2;
-			}
-		  }
-		free (rgb);
-		if (pyr->pixel_type == RL2_PIXEL_MONOCHROME)
+		if (job->no_data == NULL)
+		    nd = NULL;
+		else
 		  {
-		      if (no_data == NULL)
-			  nd = NULL;
+		      /* converting the NO-DATA pixel */
+		      rl2PrivPixelPtr pxl = (rl2PrivPixelPtr) (job->no_data);
+		      rl2PrivSamplePtr sample = pxl->Samples + 0;
+		      nd = rl2_create_pixel (RL2_SAMPLE_UINT8,
+					     RL2_PIXEL_GRAYSCALE, 1);
+		      if (sample->uint8 == 0)
+			  rl2_set_pixel_sample_uint8 (nd, RL2_GRAYSCALE_BAND,
+						      255);
 		      else
-			{
-			    /* converting the NO-DATA pixel */
-			    rl2PrivPixelPtr pxl = (rl2PrivPixelPtr) no_data;
-			    rl2PrivSamplePtr sample = pxl->Samples + 0;
-			    nd = rl2_create_pixel (RL2_SAMPLE_UINT8,
-						   RL2_PIXEL_GRAYSCALE, 1);
-			    if (sample->uint8 == 0)
-				rl2_set_pixel_sample_uint8 (nd,
-							    RL2_GRAYSCALE_BAND,
-							    255);
-			    else
-				rl2_set_pixel_sample_uint8 (nd,
-							    RL2_GRAYSCALE_BAND,
-							    0);
-			}
-		      compression = RL2_COMPRESSION_PNG;
+			  rl2_set_pixel_sample_uint8 (nd, RL2_GRAYSCALE_BAND,
+						      0);
 		  }
-		else
-		    nd = rl2_clone_pixel (no_data);
-		raster =
-		    rl2_create_raster (tileWidth, tileHeight,
-				       RL2_SAMPLE_UINT8, RL2_PIXEL_GRAYSCALE,
-				       1, gray, tileWidth * tileHeight, NULL,
-				       alpha, tileWidth * tileHeight, nd);
-	    }
-	  else if (pyr->pixel_type == RL2_PIXEL_RGB)
-	    {
-		/* RGB Pyramid */
-		nd = rl2_clone_pixel (no_data);
-		raster =
-		    rl2_create_raster (tileWidth, tileHeight,
-				       RL2_SAMPLE_UINT8, RL2_PIXEL_RGB, 3,
-				       rgb, tileWidth * tileHeight * 3, NULL,
-				       alpha, tileWidth * tileHeight, nd);
-	    }
-	  if (raster == NULL)
-	    {
-		fprintf (stderr, "ERROR: unable to create a Pyramid Tile\n");
-		goto error;
-	    }
-	  if (rl2_raster_encode
-	      (raster, compression, &blob_odd, &blob_odd_sz, &blob_even,
-	       &blob_even_sz, 80, 1) != RL2_OK)
-	    {
-		fprintf (stderr, "ERROR: unable to encode a Pyramid tile\n");
-		goto error;
+		compression = RL2_COMPRESSION_PNG;
 	    }
-	  rl2_destroy_raster (raster);
-	  raster = NULL;
-	  rl2_graph_destroy_context (ctx);
-	  ctx = NULL;
-
-	  /* INSERTing the tile */
-	  if (!do_insert_pyramid_tile
-	      (handle, blob_odd, blob_odd_sz, blob_even, blob_even_sz,
-	       id_level, pyr->section_id, pyr->srid, tile_out->minx,
-	       tile_out->miny, tile_out->maxx, tile_out->maxy, stmt_tils,
-	       stmt_data))
-	      goto error;
-
-	  tile_out = tile_out->next;
+	  else
+	      nd = rl2_clone_pixel (job->no_data);
+	  raster =
+	      rl2_create_raster (tileWidth, tileHeight, RL2_SAMPLE_UINT8,
+				 RL2_PIXEL_GRAYSCALE, 1, gray,
+				 tileWidth * tileHeight, NULL, alpha,
+				 tileWidth * tileHeight, nd);
+	  alpha = NULL;
+      }
+    else if (pyr->pixel_type == RL2_PIXEL_RGB)
+      {
+	  /* RGB Pyramid */
+	  nd = rl2_clone_pixel (job->no_data);
+	  raster =
+	      rl2_create_raster (tileWidth, tileHeight, RL2_SAMPLE_UINT8,
+				 RL2_PIXEL_RGB, 3, rgb,
+				 tileWidth * tileHeight * 3, NULL, alpha,
+				 tileWidth * tileHeight, nd);
+	  rgb = NULL;
+	  alpha = NULL;
       }
-
-    return 1;
+    if (raster == NULL)
+      {
+	  fprintf (stderr, "ERROR: unable to create a Pyramid Tile\n");
+	  goto error;
+      }
+    if (rl2_raster_encode
+	(raster, compression, &(job->blob_odd), &(job->blob_odd_sz),
+	 &(job->blob_even), &(job->blob_even_sz), 80, 1) != RL2_OK)
+      {
+	  fprintf (stderr, "ERROR: unable to encode a Pyramid tile\n");
+	  goto error;
+      }
+    rl2_destroy_raster (raster);
+    return 1;
 
   error:
+    if (rgb != NULL)
+	free (rgb);
+    if (alpha != NULL)
+	free (alpha);
     if (raster != NULL)
 	rl2_destroy_raster (raster);
-    if (ctx != NULL)
-	rl2_graph_destroy_context (ctx);
+    return 0;
+}
+
+static void
+doRunPyramidTileJob (void *arg)
+{
+/* Job function: rescaling and encoding a Pyramid tile */
+    int ret;
+    rl2AuxPyramidTilePtr job = (rl2AuxPyramidTilePtr) arg;
+    if (job->pyr->pixel_type == RL2_PIXEL_DATAGRID)
+	ret = rescale_sect_tile_grid (job);
+    else if (job->pyr->pixel_type == RL2_PIXEL_MULTIBAND)
+	ret = rescale_sect_tile_multiband (job);
+    else
+	ret = rescale_sect_tile_rgba (job);
+    job->retcode = ret ? RL2_OK : RL2_ERROR;
+}
+
+static int
+do_grow_pyramid_bases (rl2AuxPyramidBasePtr * bases, int *max_bases,
+		       int count)
+{
+/* ensuring that the base Tiles array can hold at least "count" items */
+    int new_max;
+    rl2AuxPyramidBasePtr items;
+    rl2AuxPyramidBasePtr base;
+    if (count <= *max_bases)
+	return 1;
+    new_max = *max_bases * 2;
+    if (new_max < count)
+	new_max = count;
+    items = realloc (*bases, sizeof (rl2AuxPyramidBase) * new_max);
+    if (items == NULL)
+	return 0;
+    *bases = items;
+    while (*max_bases < new_max)
+      {
+	  base = items + *max_bases;
+	  base->blob_odd = NULL;
+	  base->blob_even = NULL;
+	  base->blob_odd_max = 0;
+	  base->blob_even_max = 0;
+	  *max_bases += 1;
+      }
+    return 1;
+}
+
+static void
+do_free_pyramid_bases (rl2AuxPyramidBasePtr bases, int max_bases)
+{
+/* memory cleanup - destroying a base Tiles array */
+    int ib;
+    rl2AuxPyramidBasePtr base;
+    if (bases == NULL)
+	return;
+    for (ib = 0; ib < max_bases; ib++)
+      {
+	  base = bases + ib;
+	  if (base->blob_odd != NULL)
+	      free (base->blob_odd);
+	  if (base->blob_even != NULL)
+	      free (base->blob_even);
+      }
+    free (bases);
+}
+
+static int
+do_fetch_pyramid_base (sqlite3 * handle, sqlite3_stmt * stmt_rd,
+		       rl2AuxPyramidBasePtr base)
+{
+/* 
+/ reading the BLOBs of some base Tile (always on the calling thread)
+/ the BLOBs are copied into the base Tile's own reusable buffers
+*/
+    int ret;
+    const unsigned char *blob;
+    int blob_sz;
+
+    base->blob_odd_sz = 0;
+    base->blob_even_sz = 0;
+    sqlite3_reset (stmt_rd);
+    sqlite3_clear_bindings (stmt_rd);
+    sqlite3_bind_int64 (stmt_rd, 1, base->tile_id);
+    ret = sqlite3_step (stmt_rd);
+    if (ret != SQLITE_ROW)
+      {
+	  fprintf (stderr, "SELECT tile data; sqlite3_step() error: %s\n",
+		   sqlite3_errmsg (handle));
+	  return 0;
+      }
+    if (sqlite3_column_type (stmt_rd, 0) == SQLITE_BLOB)
+      {
+	  blob = sqlite3_column_blob (stmt_rd, 0);
+	  blob_sz = sqlite3_column_bytes (stmt_rd, 0);
+	  if (!rl2_grow_blob_buffer
+	      (&(base->blob_odd), &(base->blob_odd_max), blob_sz))
+	      return 0;
+	  memcpy (base->blob_odd, blob, blob_sz);
+	  base->blob_odd_sz = blob_sz;
+      }
+    if (sqlite3_column_type (stmt_rd, 1) == SQLITE_BLOB)
+      {
+	  blob = sqlite3_column_blob (stmt_rd, 1);
+	  blob_sz = sqlite3_column_bytes (stmt_rd, 1);
+	  if (!rl2_grow_blob_buffer
+	      (&(base->blob_even), &(base->blob_even_max), blob_sz))
+	      return 0;
+	  memcpy (base->blob_even, blob, blob_sz);
+	  base->blob_even_sz = blob_sz;
+      }
+    sqlite3_reset (stmt_rd);
+    return 1;
+}
+
+static int
+do_fetch_pyramid_bases (sqlite3 * handle, sqlite3_stmt * stmt_rd,
+			rl2AuxPyramidTilePtr job)
+{
+/* reading the BLOBs of all base Tiles required by some Pyramid tile */
+    int count = 0;
+    rl2AuxPyramidBasePtr base;
+    SectionPyramidTileRefPtr tile_in;
+
+    tile_in = job->tile_out->first;
+    while (tile_in != NULL)
+      {
+	  count++;
+	  tile_in = tile_in->next;
+      }
+    if (!do_grow_pyramid_bases (&(job->bases), &(job->max_bases), count))
+	return 0;
+
+    job->num_bases = 0;
+    tile_in = job->tile_out->first;
+    while (tile_in != NULL)
+      {
+	  base = job->bases + job->num_bases;
+	  base->tile_id = tile_in->child->tile_id;
+	  base->x = tile_in->child->cx;
+	  base->y = tile_in->child->cy;
+	  if (!do_fetch_pyramid_base (handle, stmt_rd, base))
+	      return 0;
+	  job->num_bases += 1;
+	  tile_in = tile_in->next;
+      }
+    return 1;
+}
+
+static int
+do_retire_pyramid_tile (sqlite3 * handle, rl2WorkerBatchPtr batch,
+			rl2AuxPyramidTilePtr job, int id_level,
+			sqlite3_stmt * stmt_tils, sqlite3_stmt * stmt_data)
+{
+/* 
+/ waiting until some Pyramid tile has been encoded, then INSERTing it
+/ (tiles are always retired in the same order they were submitted, so
+/ that the Tile IDs will be exactly the same as in serial execution)
+*/
+    int ret;
+    rl2AuxPyramidTilePtr done;
+    SectionPyramidTileOutPtr tile_out = job->tile_out;
+    while (!job->done)
+      {
+	  done = rl2_next_completed_worker_job (batch);
+	  if (done == NULL)
+	      break;
+	  done->done = 1;
+      }
+    job->done = 0;
+    job->tile_out = NULL;
+    if (job->retcode != RL2_OK)
+	return 0;
+    ret =
+	do_insert_pyramid_tile (handle, job->blob_odd, job->blob_odd_sz,
+				job->blob_even, job->blob_even_sz, id_level,
+				job->pyr->section_id, job->pyr->srid,
+				tile_out->minx, tile_out->miny,
+				tile_out->maxx, tile_out->maxy, stmt_tils,
+				stmt_data);
+    /* the BLOBs have been passed to SQLite */
+    job->blob_odd = NULL;
+    job->blob_even = NULL;
+    return ret;
+}
+
+static void
+do_cleanup_pyramid_tiles (rl2AuxPyramidTilePtr aux, int num_slots)
+{
+/* memory cleanup - destroying all Pyramid tile slots */
+    int i;
+    rl2AuxPyramidTilePtr job;
+    for (i = 0; i < num_slots; i++)
+      {
+	  job = aux + i;
+	  do_free_pyramid_bases (job->bases, job->max_bases);
+	  if (job->blob_odd != NULL)
+	      free (job->blob_odd);
+	  if (job->blob_even != NULL)
+	      free (job->blob_even);
+      }
+    free (aux);
+}
+
+static int
+update_sect_pyramid_tiles (sqlite3 * handle, int max_threads,
+			   sqlite3_stmt * stmt_rd, sqlite3_stmt * stmt_tils,
+			   sqlite3_stmt * stmt_data, SectionPyramid * pyr,
+			   unsigned int tileWidth, unsigned int tileHeight,
+			   int id_level, rl2PalettePtr palette,
+			   rl2PixelPtr no_data)
+{
+/* 
+/ creating and inserting Pyramid tiles - may be by using concurrent
+/ multithreading
+/ 
+/ the base Tiles are read and the Pyramid tiles are INSERTed by the
+/ calling thread alone; decoding, rescaling and encoding are the only
+/ tasks delegated to the worker threads
+*/
+    rl2AuxPyramidTilePtr aux = NULL;
+    rl2AuxPyramidTilePtr job;
+    rl2WorkerBatchPtr batch = NULL;
+    SectionPyramidTileOutPtr tile_out;
+    int num_slots;
+    int head = 0;
+    int busy = 0;
+    int iaux;
+
+    if (pyr == NULL)
+	return 0;
+    if (max_threads < 1)
+	max_threads = 1;
+    if (max_threads > 64)
+	max_threads = 64;
+/* 
+/ allocating the Pyramid tile slots
+/ when multithreading twice as many slots as threads are allocated, so
+/ that further base tiles can be read while the previous Pyramid tiles
+/ are still being encoded
+*/
+    num_slots = (max_threads > 1) ? max_threads * 2 : 1;
+    aux = malloc (sizeof (rl2AuxPyramidTile) * num_slots);
+    if (aux == NULL)
+	return 0;
+    for (iaux = 0; iaux < num_slots; iaux++)
+      {
+	  /* initializing an empty slot */
+	  job = aux + iaux;
+	  job->pyr = pyr;
+	  job->tile_out = NULL;
+	  job->tile_width = tileWidth;
+	  job->tile_height = tileHeight;
+	  job->palette = palette;
+	  job->no_data = no_data;
+	  job->num_bases = 0;
+	  job->max_bases = 0;
+	  job->bases = NULL;
+	  job->blob_odd = NULL;
+	  job->blob_even = NULL;
+	  job->blob_odd_sz = 0;
+	  job->blob_even_sz = 0;
+	  job->done = 0;
+	  job->retcode = RL2_OK;
+      }
+    if (max_threads > 1)
+      {
+	  /* preparing a Batch of concurrent Jobs */
+	  batch = rl2_create_worker_batch (max_threads);
+	  if (batch == NULL)
+	      goto error;
+      }
+
+    tile_out = pyr->first_out;
+    while (tile_out != NULL)
+      {
+	  if (busy == num_slots)
+	    {
+		/* all slots are busy: retiring the oldest Pyramid tile */
+		if (!do_retire_pyramid_tile
+		    (handle, batch, aux + head, id_level, stmt_tils,
+		     stmt_data))
+		    goto error;
+		head = (head + 1) % num_slots;
+		busy--;
+	    }
+	  job = aux + ((head + busy) % num_slots);
+	  job->tile_out = tile_out;
+	  job->retcode = RL2_ERROR;
+	  busy++;
+	  if (!do_fetch_pyramid_bases (handle, stmt_rd, job))
+	      goto error;
+	  if (max_threads > 1)
+	    {
+		/* adopting a multithreaded strategy */
+		rl2_submit_worker_job (batch, doRunPyramidTileJob, job);
+	    }
+	  else
+	    {
+		/* single thread execution */
+		doRunPyramidTileJob (job);
+		job->done = 1;
+	    }
+	  tile_out = tile_out->next;
+      }
+    while (busy > 0)
+      {
+	  /* retiring the last pending Pyramid tiles */
+	  if (!do_retire_pyramid_tile
+	      (handle, batch, aux + head, id_level, stmt_tils, stmt_data))
+	      goto error;
+	  head = (head + 1) % num_slots;
+	  busy--;
+      }
+
+    rl2_destroy_worker_batch (batch);
+    do_cleanup_pyramid_tiles (aux, num_slots);
+    return 1;
+
+  error:
+    /* waiting for any pending Job before releasing the slots */
+    rl2_destroy_worker_batch (batch);
+    do_cleanup_pyramid_tiles (aux, num_slots);
     return 0;
 }
 
 static int
-rescale_monolithic_rgba (int id_level,
+rescale_monolithic_rgba (rl2AuxPyramidBasePtr bases, int num_bases,
 			 unsigned int tileWidth, unsigned int tileHeight,
 			 int factor, double res_x, double res_y, double minx,
 			 double miny, double maxx, double maxy,
 			 unsigned char *buffer, int buf_size,
 			 unsigned char *mask, int *mask_size,
-			 rl2PalettePtr palette, rl2PixelPtr no_data,
-			 sqlite3_stmt * stmt_geo, sqlite3_stmt * stmt_data)
+			 rl2PalettePtr palette, rl2PixelPtr no_data)
 {
 /* rescaling a monolithic RGBA tile */
     rl2GraphicsContextPtr ctx = NULL;
@@ -2197,7 +2412,7 @@ rescale_monolithic_rgba (int id_level,
     unsigned char *rgba = NULL;
     unsigned int x;
     unsigned int y;
-    int ret;
+    int ib;
     double shift_x;
     double shift_y;
     double scale_x;
@@ -2214,46 +2429,33 @@ rescale_monolithic_rgba (int id_level,
     ctx = rl2_graph_create_context (tileWidth, tileHeight);
     if (ctx == NULL)
 	goto error;
-/* binding the BBOX to be queried */
-    sqlite3_reset (stmt_geo);
-    sqlite3_clear_bindings (stmt_geo);
-    sqlite3_bind_int (stmt_geo, 1, id_level);
-    sqlite3_bind_double (stmt_geo, 2, minx);
-    sqlite3_bind_double (stmt_geo, 3, miny);
-    sqlite3_bind_double (stmt_geo, 4, maxx);
-    sqlite3_bind_double (stmt_geo, 5, maxy);
-    while (1)
+/* looping on the lower-level tiles */
+    for (ib = 0; ib < num_bases; ib++)
       {
-	  /* scrolling the result set rows */
-	  ret = sqlite3_step (stmt_geo);
-	  if (ret == SQLITE_DONE)
-	      break;		/* end of result set */
-	  if (ret == SQLITE_ROW)
-	    {
-		sqlite3_int64 tile_id = sqlite3_column_int64 (stmt_geo, 0);
-		double tile_x = sqlite3_column_double (stmt_geo, 1);
-		double tile_y = sqlite3_column_double (stmt_geo, 2);
+	  /* rescaling a lower-level tile */
+	  rl2AuxPyramidBasePtr base = bases + ib;
+	  double tile_x = base->x;
+	  double tile_y = base->y;
 
-		rgba = load_tile_base (stmt_data, tile_id, palette, no_data);
-		if (rgba == NULL)
-		    goto error;
-		base_tile =
-		    rl2_graph_create_bitmap (rgba, tileWidth, tileHeight);
-		if (base_tile == NULL)
-		  {
-		      free (rgba);
-		      goto error;
-		  }
-		shift_x = tile_x - minx;
-		shift_y = maxy - tile_y;
-		scale_x = 1.0 / (double) factor;
-		scale_y = 1.0 / (double) factor;
-		x = (int) (shift_x / res_x);
-		y = (int) (shift_y / res_y);
-		rl2_graph_draw_rescaled_bitmap (ctx, base_tile,
-						scale_x, scale_y, x, y);
-		rl2_graph_destroy_bitmap (base_tile);
+	  rgba = load_tile_base (base, palette, no_data);
+	  if (rgba == NULL)
+	      goto error;
+	  base_tile =
+	      rl2_graph_create_bitmap (rgba, tileWidth, tileHeight);
+	  if (base_tile == NULL)
+	    {
+		free (rgba);
+		goto error;
 	    }
+	  shift_x = tile_x - minx;
+	  shift_y = maxy - tile_y;
+	  scale_x = 1.0 / (double) factor;
+	  scale_y = 1.0 / (double) factor;
+	  x = (int) (shift_x / res_x);
+	  y = (int) (shift_y / res_y);
+	  rl2_graph_draw_rescaled_bitmap (ctx, base_tile,
+					  scale_x, scale_y, x, y);
+	  rl2_graph_destroy_bitmap (base_tile);
       }
 
     rgb = rl2_graph_get_context_rgb_array (ctx);
@@ -2348,6 +2550,74 @@ rescale_monolithic_rgba (int id_level,
     return 0;
 }
 
+static int
+resample_monolithic_rgba (rl2AuxPyramidBasePtr bases, int num_bases,
+			  unsigned int tileWidth, unsigned int tileHeight,
+			  int factor, unsigned char resampling, double res_x,
+			  double res_y, double minx, double maxy,
+			  unsigned char *buffer, int buf_size,
+			  unsigned char *mask, int *mask_size,
+			  rl2PalettePtr palette, rl2PixelPtr no_data)
+{
+/* rescaling a monolithic RGBA tile by the Resampling kernel */
+    unsigned int n = tileWidth * tileHeight;
+    unsigned char *rgba = NULL;
+    unsigned char *rgba_in;
+    unsigned int x;
+    unsigned int y;
+    unsigned int i;
+    int ib;
+    int ret;
+    int valid_mask = 0;
+
+    rgba = malloc (n * 4);
+    if (rgba == NULL)
+	return 0;
+    memset (rgba, 0, n * 4);
+/* looping on the lower-level tiles */
+    for (ib = 0; ib < num_bases; ib++)
+      {
+	  /* rescaling a lower-level tile */
+	  rl2AuxPyramidBasePtr base = bases + ib;
+	  rgba_in = load_tile_base (base, palette, no_data);
+	  if (rgba_in == NULL)
+	      goto error;
+	  x = (int) ((base->x - minx) / res_x);
+	  y = (int) ((maxy - base->y) / res_y);
+	  ret =
+	      resample_rgba_base_tile (rgba, mask, tileWidth, tileHeight,
+				       rgba_in, x, y, factor, resampling);
+	  free (rgba_in);
+	  if (!ret)
+	      goto error;
+      }
+
+    for (i = 0; i < n; i++)
+      {
+	  if (mask[i] == 0)
+	    {
+		/* skipping a transparent pixel */
+		valid_mask = 1;
+		continue;
+	    }
+	  if (buf_size == (int) n)
+	      buffer[i] = rgba[i * 4];	/* Grayscale */
+	  else
+	      memcpy (buffer + (i * 3), rgba + (i * 4), 3);	/* RGB */
+      }
+    free (rgba);
+    if (!valid_mask)
+      {
+	  free (mask);
+	  *mask_size = 0;
+      }
+    return 1;
+
+  error:
+    free (rgba);
+    return 0;
+}
+
 #define floor2(exp) ((long) exp)
 
 static rl2RasterPtr
@@ -2652,14 +2922,13 @@ copy_124_rescaled (rl2RasterPtr raster_out, rl2RasterPtr raster_in,
 }
 
 static int
-rescale_monolithic_124 (int id_level,
+rescale_monolithic_124 (rl2AuxPyramidBasePtr bases, int num_bases,
 			unsigned int tileWidth, unsigned int tileHeight,
 			int factor, unsigned char pixel_type, double res_x,
 			double res_y, double minx, double miny, double maxx,
 			double maxy, unsigned char *buffer, int buf_size,
 			unsigned char *mask, int *mask_size,
-			rl2PalettePtr palette, rl2PixelPtr no_data,
-			sqlite3_stmt * stmt_geo, sqlite3_stmt * stmt_data)
+			rl2PalettePtr palette, rl2PixelPtr no_data)
 {
 /* rescaling a monolithic 1,2 or 4 bit tile */
     rl2RasterPtr raster = NULL;
@@ -2668,7 +2937,7 @@ rescale_monolithic_124 (int id_level,
     unsigned char *rgba = NULL;
     unsigned int x;
     unsigned int y;
-    int ret;
+    int ib;
     double shift_x;
     double shift_y;
     int valid_mask = 0;
@@ -2728,42 +2997,29 @@ rescale_monolithic_124 (int id_level,
     if (raster == NULL)
 	goto error;
 
-/* binding the BBOX to be queried */
-    sqlite3_reset (stmt_geo);
-    sqlite3_clear_bindings (stmt_geo);
-    sqlite3_bind_int (stmt_geo, 1, id_level);
-    sqlite3_bind_double (stmt_geo, 2, minx);
-    sqlite3_bind_double (stmt_geo, 3, miny);
-    sqlite3_bind_double (stmt_geo, 4, maxx);
-    sqlite3_bind_double (stmt_geo, 5, maxy);
-    while (1)
+/* looping on the lower-level tiles */
+    for (ib = 0; ib < num_bases; ib++)
       {
-	  /* scrolling the result set rows */
-	  ret = sqlite3_step (stmt_geo);
-	  if (ret == SQLITE_DONE)
-	      break;		/* end of result set */
-	  if (ret == SQLITE_ROW)
-	    {
-		sqlite3_int64 tile_id = sqlite3_column_int64 (stmt_geo, 0);
-		double tile_x = sqlite3_column_double (stmt_geo, 1);
-		double tile_y = sqlite3_column_double (stmt_geo, 2);
+	  /* rescaling a lower-level tile */
+	  rl2AuxPyramidBasePtr base = bases + ib;
+	  double tile_x = base->x;
+	  double tile_y = base->y;
 
-		rgba = load_tile_base (stmt_data, tile_id, palette, no_data);
-		if (rgba == NULL)
-		    goto error;
-		base_tile =
-		    create_124_rescaled_raster (rgba, out_pixel_type,
-						tileWidth, tileHeight, factor);
-		free (rgba);
-		if (base_tile == NULL)
-		    goto error;
-		shift_x = tile_x - minx;
-		shift_y = maxy - tile_y;
-		x = (int) (shift_x / res_x);
-		y = (int) (shift_y / res_y);
-		copy_124_rescaled (raster, base_tile, x, y);
-		rl2_destroy_raster (base_tile);
-	    }
+	  rgba = load_tile_base (base, palette, no_data);
+	  if (rgba == NULL)
+	      goto error;
+	  base_tile =
+	      create_124_rescaled_raster (rgba, out_pixel_type,
+					  tileWidth, tileHeight, factor);
+	  free (rgba);
+	  if (base_tile == NULL)
+	      goto error;
+	  shift_x = tile_x - minx;
+	  shift_y = maxy - tile_y;
+	  x = (int) (shift_x / res_x);
+	  y = (int) (shift_y / res_y);
+	  copy_124_rescaled (raster, base_tile, x, y);
+	  rl2_destroy_raster (base_tile);
       }
 
 /* releasing buffers ownership */
@@ -2928,267 +3184,69 @@ copy_multiband_rescaled (rl2RasterPtr raster_out, rl2RasterPtr raster_in,
       }
 }
 
-static int
-is_mb_nodata_u8 (const unsigned char *pixel, unsigned char num_bands,
-		 rl2PixelPtr no_data)
+static void
+mb_prime_nodata_u8 (unsigned char *buf, unsigned int width,
+		    unsigned int height, unsigned char num_bands,
+		    rl2PixelPtr no_data)
 {
-/* testing for NO-DATA pixel */
-    int is_valid = 0;
+/* priming a void buffer */
     rl2PrivPixelPtr nd = (rl2PrivPixelPtr) no_data;
+    unsigned int x;
+    unsigned int y;
     unsigned char ib;
-    const unsigned char *p_in = pixel;
+    unsigned char *p = buf;
+    int is_valid = 0;
+
     if (nd != NULL)
       {
 	  if (nd->nBands == num_bands && nd->sampleType == RL2_SAMPLE_UINT8
 	      && nd->pixelType == RL2_PIXEL_MULTIBAND)
 	      is_valid = 1;
       }
-    if (!is_valid)
-	return 0;
-    for (ib = 0; ib < num_bands; ib++)
+    for (y = 0; y < height; y++)
       {
-	  if (*p_in++ != (nd->Samples + ib)->uint8)
-	      return 0;
+	  for (x = 0; x < width; x++)
+	    {
+		for (ib = 0; ib < num_bands; ib++)
+		  {
+		      if (is_valid)
+			  *p++ = (nd->Samples + ib)->uint8;
+		      else
+			  *p++ = 0;
+		  }
+	    }
       }
-    return 1;
 }
 
 static void
-rescale_multiband_u8 (unsigned int tileWidth, unsigned int tileHeight,
-		      unsigned char num_bands, unsigned int out_width,
-		      unsigned int out_height, unsigned int factor,
-		      unsigned char *buf_in, const unsigned char *mask_in,
-		      unsigned char *buf_out, unsigned char *mask,
-		      unsigned int x, unsigned int y, unsigned int ox,
-		      unsigned int oy, rl2PixelPtr no_data)
+mb_prime_nodata_u16 (unsigned short *buf, unsigned int width,
+		     unsigned int height, unsigned char num_bands,
+		     rl2PixelPtr no_data)
 {
-/* rescaling a MultiBand (monolithic)- UINT8 */
-    unsigned int row;
-    unsigned int col;
-    int nodata = 0;
-    int valid = 0;
+/* priming a void buffer */
+    rl2PrivPixelPtr nd = (rl2PrivPixelPtr) no_data;
+    unsigned int x;
+    unsigned int y;
     unsigned char ib;
-    double *sum;
-    unsigned char *p_out;
-    unsigned char *p_msk;
-
-    if (ox >= out_width || oy >= out_height)
-	return;
-    p_out = buf_out + (out_width * oy * num_bands) + (ox * num_bands);
-    p_msk = mask + (out_width * oy) + ox;
-    sum = malloc (sizeof (double) * num_bands);
-    for (ib = 0; ib < num_bands; ib++)
-	*(sum + ib) = 0.0;
+    unsigned short *p = buf;
+    int is_valid = 0;
 
-    for (row = 0; row < factor; row++)
+    if (nd != NULL)
       {
-	  const unsigned char *p_in_base;
-	  unsigned int yy = y + row;
-	  if (yy >= tileHeight)
-	      break;
-	  p_in_base = buf_in + (yy * tileWidth * num_bands);
-	  for (col = 0; col < factor; col++)
+	  if (nd->nBands == num_bands && nd->sampleType == RL2_SAMPLE_UINT16
+	      && nd->pixelType == RL2_PIXEL_MULTIBAND)
+	      is_valid = 1;
+      }
+    for (y = 0; y < height; y++)
+      {
+	  for (x = 0; x < width; x++)
 	    {
-		const unsigned char *p_in;
-		unsigned int xx = x + col;
-		if (xx >= tileWidth)
-		    break;
-		p_in = p_in_base + (xx * num_bands);
-		if (mask_in != NULL)
+		for (ib = 0; ib < num_bands; ib++)
 		  {
-		      /* checking the transparency mask */
-		      const unsigned char *p_msk_in =
-			  mask_in + (yy * tileWidth) + xx;
-		      if (*p_msk_in == 0)
-			{
-			    nodata++;
-			    continue;
-			}
-		  }
-		if (is_mb_nodata_u8 (p_in, num_bands, no_data))
-		    nodata++;
-		else
-		  {
-		      valid++;
-		      for (ib = 0; ib < num_bands; ib++)
-			  *(sum + ib) += *p_in++;
-		  }
-	    }
-      }
-
-    if (nodata >= valid)
-      {
-	  free (sum);
-	  return;
-      }
-    for (ib = 0; ib < num_bands; ib++)
-	*p_out++ = (unsigned char) (*(sum + ib) / (double) valid);
-    free (sum);
-    *p_msk = 1;
-}
-
-static int
-is_mb_nodata_u16 (const unsigned short *pixel, unsigned char num_bands,
-		  rl2PixelPtr no_data)
-{
-/* testing for NO-DATA pixel */
-    int is_valid = 0;
-    rl2PrivPixelPtr nd = (rl2PrivPixelPtr) no_data;
-    unsigned char ib;
-    const unsigned short *p_in = pixel;
-    if (nd != NULL)
-      {
-	  if (nd->nBands == num_bands && nd->sampleType == RL2_SAMPLE_UINT16
-	      && nd->pixelType == RL2_PIXEL_MULTIBAND)
-	      is_valid = 1;
-      }
-    if (!is_valid)
-	return 0;
-    for (ib = 0; ib < num_bands; ib++)
-      {
-	  if (*p_in++ != (nd->Samples + ib)->uint16)
-	      return 0;
-      }
-    return 1;
-}
-
-static void
-rescale_multiband_u16 (unsigned int tileWidth, unsigned int tileHeight,
-		       unsigned char num_bands, unsigned int out_width,
-		       unsigned int out_height, unsigned int factor,
-		       unsigned short *buf_in, const unsigned char *mask_in,
-		       unsigned short *buf_out, unsigned char *mask,
-		       unsigned int x, unsigned int y, unsigned int ox,
-		       unsigned int oy, rl2PixelPtr no_data)
-{
-/* rescaling a MultiBand (monolithic)- UINT16 */
-    unsigned int row;
-    unsigned int col;
-    int nodata = 0;
-    int valid = 0;
-    unsigned char ib;
-    double *sum;
-    unsigned short *p_out;
-    unsigned char *p_msk;
-
-    if (ox >= out_width || oy >= out_height)
-	return;
-    p_out = buf_out + (out_width * oy * num_bands) + (ox * num_bands);
-    p_msk = mask + (out_width * oy) + ox;
-    sum = malloc (sizeof (double) * num_bands);
-    for (ib = 0; ib < num_bands; ib++)
-	*(sum + ib) = 0.0;
-
-    for (row = 0; row < factor; row++)
-      {
-	  const unsigned short *p_in_base;
-	  unsigned int yy = y + row;
-	  if (yy >= tileHeight)
-	      break;
-	  p_in_base = buf_in + (yy * tileWidth * num_bands);
-	  for (col = 0; col < factor; col++)
-	    {
-		const unsigned short *p_in;
-		unsigned int xx = x + col;
-		if (xx >= tileWidth)
-		    break;
-		if (mask_in != NULL)
-		  {
-		      /* checking the transparency mask */
-		      const unsigned char *p_msk_in =
-			  mask_in + (yy * tileWidth) + xx;
-		      if (*p_msk_in == 0)
-			{
-			    nodata++;
-			    continue;
-			}
-		  }
-		p_in = p_in_base + (xx * num_bands);
-		if (is_mb_nodata_u16 (p_in, num_bands, no_data))
-		    nodata++;
-		else
-		  {
-		      valid++;
-		      for (ib = 0; ib < num_bands; ib++)
-			  *(sum + ib) += *p_in++;
-		  }
-	    }
-      }
-
-    if (nodata >= valid)
-      {
-	  free (sum);
-	  return;
-      }
-    for (ib = 0; ib < num_bands; ib++)
-	*p_out++ = (unsigned char) (*(sum + ib) / (double) valid);
-    free (sum);
-    *p_msk = 1;
-}
-
-static void
-mb_prime_nodata_u8 (unsigned char *buf, unsigned int width,
-		    unsigned int height, unsigned char num_bands,
-		    rl2PixelPtr no_data)
-{
-/* priming a void buffer */
-    rl2PrivPixelPtr nd = (rl2PrivPixelPtr) no_data;
-    unsigned int x;
-    unsigned int y;
-    unsigned char ib;
-    unsigned char *p = buf;
-    int is_valid = 0;
-
-    if (nd != NULL)
-      {
-	  if (nd->nBands == num_bands && nd->sampleType == RL2_SAMPLE_UINT8
-	      && nd->pixelType == RL2_PIXEL_MULTIBAND)
-	      is_valid = 1;
-      }
-    for (y = 0; y < height; y++)
-      {
-	  for (x = 0; x < width; x++)
-	    {
-		for (ib = 0; ib < num_bands; ib++)
-		  {
-		      if (is_valid)
-			  *p++ = (nd->Samples + ib)->uint8;
-		      else
-			  *p++ = 0;
-		  }
-	    }
-      }
-}
-
-static void
-mb_prime_nodata_u16 (unsigned short *buf, unsigned int width,
-		     unsigned int height, unsigned char num_bands,
-		     rl2PixelPtr no_data)
-{
-/* priming a void buffer */
-    rl2PrivPixelPtr nd = (rl2PrivPixelPtr) no_data;
-    unsigned int x;
-    unsigned int y;
-    unsigned char ib;
-    unsigned short *p = buf;
-    int is_valid = 0;
-
-    if (nd != NULL)
-      {
-	  if (nd->nBands == num_bands && nd->sampleType == RL2_SAMPLE_UINT16
-	      && nd->pixelType == RL2_PIXEL_MULTIBAND)
-	      is_valid = 1;
-      }
-    for (y = 0; y < height; y++)
-      {
-	  for (x = 0; x < width; x++)
-	    {
-		for (ib = 0; ib < num_bands; ib++)
-		  {
-		      if (is_valid)
-			  *p++ = (nd->Samples + ib)->uint16;
-		      else
-			  *p++ = 0;
+		      if (is_valid)
+			  *p++ = (nd->Samples + ib)->uint16;
+		      else
+			  *p++ = 0;
 		  }
 	    }
       }
@@ -3199,13 +3257,12 @@ create_rescaled_multiband_raster (unsigned int factor, unsigned int tileWidth,
 				  unsigned int tileHeight, const void *buf_in,
 				  const unsigned char *mask_in,
 				  unsigned char sample_type,
-				  unsigned char num_bands, rl2PixelPtr no_data)
+				  unsigned char num_bands, rl2PixelPtr no_data,
+				  unsigned char resampling)
 {
 /* rescaling a Multiband tile */
-    unsigned int x;
-    unsigned int y;
-    unsigned int ox;
-    unsigned int oy;
+    rl2PrivPixelPtr pxl = (rl2PrivPixelPtr) no_data;
+    rl2BoxFilter filter;
     rl2RasterPtr raster = NULL;
     unsigned char *mask;
     void *buf;
@@ -3239,32 +3296,32 @@ create_rescaled_multiband_raster (unsigned int factor, unsigned int tileWidth,
     else
 	mb_prime_nodata_u8 (buf, out_width, out_height, num_bands, no_data);
 
-    oy = 0;
-    for (y = 0; y < tileHeight; y += factor)
+/* NO-DATA only applies when the whole pixel matches */
+    filter.no_data = NULL;
+    if (pxl != NULL)
       {
-	  ox = 0;
-	  for (x = 0; x < tileWidth; x += factor)
-	    {
-		switch (sample_type)
-		  {
-		  case RL2_SAMPLE_UINT8:
-		      rescale_multiband_u8 (tileWidth, tileHeight, num_bands,
-					    out_width, out_height, factor,
-					    (unsigned char *) buf_in, mask_in,
-					    (unsigned char *) buf, mask, x, y,
-					    ox, oy, no_data);
-		      break;
-		  case RL2_SAMPLE_UINT16:
-		      rescale_multiband_u16 (tileWidth, tileHeight, num_bands,
-					     out_width, out_height, factor,
-					     (unsigned short *) buf_in,
-					     mask_in, (unsigned short *) buf,
-					     mask, x, y, ox, oy, no_data);
-		      break;
-		  };
-		ox++;
-	    }
-	  oy++;
+	  if (pxl->nBands == num_bands && pxl->sampleType == sample_type
+	      && pxl->pixelType == RL2_PIXEL_MULTIBAND)
+	      filter.no_data = pxl->Samples;
+      }
+    filter.in = buf_in;
+    filter.mask_in = mask_in;
+    filter.in_width = tileWidth;
+    filter.in_height = tileHeight;
+    filter.sample_type = sample_type;
+    filter.num_bands = num_bands;
+    filter.factor = factor;
+    filter.pixel_nodata = 1;
+    filter.out = buf;
+    filter.mask_out = mask;
+    filter.out_width = out_width;
+    filter.out_height = out_height;
+    filter.out_stride = out_width;
+    if (resample_tile (&filter, resampling) != RL2_OK)
+      {
+	  free (buf);
+	  free (mask);
+	  return NULL;
       }
 
     raster =
@@ -3520,990 +3577,486 @@ copy_datagrid_rescaled (rl2RasterPtr raster_out, rl2RasterPtr raster_in,
       }
 }
 
-static void
-rescale_datagrid_8 (unsigned int tileWidth, unsigned int tileHeight,
-		    unsigned int out_width, unsigned int out_height,
-		    unsigned int factor, char *buf_in, char *buf_out,
-		    unsigned char *mask, unsigned int x, unsigned int y,
-		    unsigned int ox, unsigned int oy, char nd)
+static rl2RasterPtr
+create_rescaled_datagrid_raster (unsigned int factor, unsigned int tileWidth,
+				 unsigned int tileHeight, const void *buf_in,
+				 unsigned char sample_type, rl2PixelPtr no_data,
+				 unsigned char resampling)
 {
-/* rescaling a DataGrid (monolithic)- INT8 */
-    unsigned int row;
-    unsigned int col;
-    int nodata = 0;
-    int valid = 0;
-    double sum = 0.0;
-    char *p_out;
-    unsigned char *p_msk;
+/* rescaling a Datagrid tile */
+    rl2PrivPixelPtr pxl;
+    rl2PrivSample nd;
+    rl2BoxFilter filter;
+    rl2RasterPtr raster = NULL;
+    unsigned char *mask;
+    void *buf;
+    unsigned int mask_sz;
+    unsigned char pix_sz = 1;
+    unsigned int buf_sz;
+    unsigned int out_width = tileWidth / factor;
+    unsigned int out_height = tileHeight / factor;
 
-    if (ox >= out_width || oy >= out_height)
-	return;
-    p_out = buf_out + (out_width * oy) + ox;
-    p_msk = mask + (out_width * oy) + ox;
+/* retrieving NO-DATA */
+    memset (&nd, 0, sizeof (rl2PrivSample));
+    pxl = (rl2PrivPixelPtr) no_data;
+    if (pxl != NULL)
+      {
+	  if (pxl->nBands == 1 && pxl->pixelType == RL2_PIXEL_DATAGRID
+	      && pxl->sampleType == sample_type)
+	      nd = *(pxl->Samples);
+      }
+/* computing sizes */
+    mask_sz = out_width * out_height;
+    switch (sample_type)
+      {
+      case RL2_SAMPLE_INT16:
+      case RL2_SAMPLE_UINT16:
+	  pix_sz = 2;
+	  break;
+      case RL2_SAMPLE_INT32:
+      case RL2_SAMPLE_UINT32:
+      case RL2_SAMPLE_FLOAT:
+	  pix_sz = 4;
+	  break;
+      case RL2_SAMPLE_DOUBLE:
+	  pix_sz = 8;
+	  break;
+      };
+    buf_sz = out_width * out_height * pix_sz;
+    buf = malloc (buf_sz);
+    if (buf == NULL)
+	return NULL;
+    mask = malloc (mask_sz);
+    if (mask == NULL)
+      {
+	  free (buf);
+	  return NULL;
+      }
+    rl2_prime_void_tile (buf, out_width, out_height, sample_type, 1, no_data);
+    memset (mask, 0, mask_sz);
 
-    for (row = 0; row < factor; row++)
+    filter.in = buf_in;
+    filter.mask_in = NULL;
+    filter.in_width = tileWidth;
+    filter.in_height = tileHeight;
+    filter.sample_type = sample_type;
+    filter.num_bands = 1;
+    filter.factor = factor;
+    filter.no_data = &nd;
+    filter.pixel_nodata = 0;
+    filter.out = buf;
+    filter.mask_out = mask;
+    filter.out_width = out_width;
+    filter.out_height = out_height;
+    filter.out_stride = out_width;
+    if (resample_tile (&filter, resampling) != RL2_OK)
       {
-	  const char *p_in_base;
-	  unsigned int yy = y + row;
-	  if (yy >= tileHeight)
-	      break;
-	  p_in_base = buf_in + (yy * tileWidth);
-	  for (col = 0; col < factor; col++)
-	    {
-		const char *p_in;
-		unsigned int xx = x + col;
-		if (xx >= tileWidth)
-		    break;
-		p_in = p_in_base + xx;
-		if (*p_in == nd)
-		    nodata++;
-		else
-		  {
-		      valid++;
-		      sum += *p_in;
-		  }
-	    }
+	  free (buf);
+	  free (mask);
+	  return NULL;
       }
 
-    if (nodata >= valid)
-	return;
-    *p_out = (char) (sum / (double) valid);
-    *p_msk = 1;
+    raster =
+	rl2_create_raster (out_width, out_height, sample_type,
+			   RL2_PIXEL_DATAGRID, 1, buf, buf_sz, NULL, mask,
+			   mask_sz, NULL);
+    return raster;
 }
 
-static void
-rescale_datagrid_u8 (unsigned int tileWidth, unsigned int tileHeight,
-		     unsigned int out_width, unsigned int out_height,
-		     unsigned int factor, unsigned char *buf_in,
-		     unsigned char *buf_out, unsigned char *mask,
-		     unsigned int x, unsigned int y, unsigned int ox,
-		     unsigned int oy, unsigned char nd)
+static int
+rescale_monolithic_multiband (rl2AuxPyramidBasePtr bases,
+			      int num_bases, unsigned int tileWidth,
+			      unsigned int tileHeight,
+			      unsigned char sample_type,
+			      unsigned char num_bands, int factor,
+			      unsigned char resampling, double res_x,
+			      double res_y, double minx,
+			      double miny, double maxx, double maxy,
+			      unsigned char *buffer, int buf_size,
+			      unsigned char *mask, int *mask_size,
+			      rl2PixelPtr no_data)
 {
-/* rescaling a DataGrid (monolithic)- UINT8 */
-    unsigned int row;
-    unsigned int col;
-    int nodata = 0;
-    int valid = 0;
-    double sum = 0.0;
+/* rescaling monolithic MultiBand */
+    rl2RasterPtr raster = NULL;
+    rl2RasterPtr base_tile = NULL;
+    rl2PrivRasterPtr rst;
+    unsigned int x;
+    unsigned int y;
+    int ib;
+    double shift_x;
+    double shift_y;
+    int valid_mask = 0;
+    unsigned char *p_in;
     unsigned char *p_out;
-    unsigned char *p_msk;
-
-    if (ox >= out_width || oy >= out_height)
-	return;
-    p_out = buf_out + (out_width * oy) + ox;
-    p_msk = mask + (out_width * oy) + ox;
+    rl2PixelPtr nd = NULL;
 
-    for (row = 0; row < factor; row++)
+    nd = rl2_clone_pixel (no_data);
+    p_out = mask;
+    for (y = 0; y < tileHeight; y++)
       {
-	  const unsigned char *p_in_base;
-	  unsigned int yy = y + row;
-	  if (yy >= tileHeight)
-	      break;
-	  p_in_base = buf_in + (yy * tileWidth);
-	  for (col = 0; col < factor; col++)
-	    {
-		const unsigned char *p_in;
-		unsigned int xx = x + col;
-		if (xx >= tileWidth)
-		    break;
-		p_in = p_in_base + xx;
-		if (*p_in == nd)
-		    nodata++;
-		else
-		  {
-		      valid++;
-		      sum += *p_in;
-		  }
-	    }
+	  /* priming full transparency */
+	  for (x = 0; x < tileWidth; x++)
+	      *p_out++ = 0;
       }
+    rl2_prime_void_tile (buffer, tileWidth, tileHeight, sample_type,
+			 num_bands, no_data);
+/* creating the output raster */
+    raster =
+	rl2_create_raster (tileWidth, tileHeight, sample_type,
+			   RL2_PIXEL_MULTIBAND, num_bands, buffer, buf_size,
+			   NULL, mask, *mask_size, nd);
+    if (raster == NULL)
+	goto error;
 
-    if (nodata >= valid)
-	return;
-    *p_out = (unsigned char) (sum / (double) valid);
-    *p_msk = 1;
-}
+/* looping on the lower-level tiles */
+    for (ib = 0; ib < num_bases; ib++)
+      {
+	  /* rescaling a lower-level tile */
+	  rl2RasterPtr raster_in = NULL;
+	  rl2PrivRasterPtr rst_in;
+	  rl2AuxPyramidBasePtr base = bases + ib;
+	  double tile_x = base->x;
+	  double tile_y = base->y;
 
-static void
-rescale_datagrid_16 (unsigned int tileWidth, unsigned int tileHeight,
-		     unsigned int out_width, unsigned int out_height,
-		     unsigned int factor, short *buf_in, short *buf_out,
-		     unsigned char *mask, unsigned int x, unsigned int y,
-		     unsigned int ox, unsigned int oy, short nd)
-{
-/* rescaling a DataGrid (monolithic)- INT16 */
-    unsigned int row;
-    unsigned int col;
-    int nodata = 0;
-    int valid = 0;
-    double sum = 0.0;
-    short *p_out;
-    unsigned char *p_msk;
+	  raster_in = load_tile_base_generic (base);
+	  if (raster_in == NULL)
+	      goto error;
+	  rst_in = (rl2PrivRasterPtr) raster_in;
+	  base_tile =
+	      create_rescaled_multiband_raster (factor, tileWidth,
+						tileHeight,
+						rst_in->rasterBuffer,
+						rst_in->maskBuffer,
+						sample_type, num_bands,
+						no_data, resampling);
+	  rl2_destroy_raster (raster_in);
+	  raster_in = NULL;
+
+	  if (base_tile == NULL)
+	      goto error;
+	  shift_x = tile_x - minx;
+	  shift_y = maxy - tile_y;
+	  x = (int) (shift_x / res_x);
+	  y = (int) (shift_y / res_y);
+	  copy_multiband_rescaled (raster, base_tile, x, y);
+	  rl2_destroy_raster (base_tile);
+      }
 
-    if (ox >= out_width || oy >= out_height)
-	return;
-    p_out = buf_out + (out_width * oy) + ox;
-    p_msk = mask + (out_width * oy) + ox;
+/* releasing buffers ownership */
+    rst = (rl2PrivRasterPtr) raster;
+    rst->rasterBuffer = NULL;
+    rst->maskBuffer = NULL;
+    rl2_destroy_raster (raster);
 
-    for (row = 0; row < factor; row++)
+    p_in = mask;
+    for (y = 0; y < tileHeight; y++)
       {
-	  const short *p_in_base;
-	  unsigned int yy = y + row;
-	  if (yy >= tileHeight)
-	      break;
-	  p_in_base = buf_in + (yy * tileWidth);
-	  for (col = 0; col < factor; col++)
+	  for (x = 0; x < tileWidth; x++)
 	    {
-		const short *p_in;
-		unsigned int xx = x + col;
-		if (xx >= tileWidth)
-		    break;
-		p_in = p_in_base + xx;
-		if (*p_in == nd)
-		    nodata++;
-		else
-		  {
-		      valid++;
-		      sum += *p_in;
-		  }
+		if (*p_in++ == 0)
+		    valid_mask = 1;
 	    }
       }
-
-    if (nodata >= valid)
-	return;
-    *p_out = (short) (sum / (double) valid);
-    *p_msk = 1;
-}
-
-static void
-rescale_datagrid_u16 (unsigned int tileWidth, unsigned int tileHeight,
-		      unsigned int out_width, unsigned int out_height,
-		      unsigned int factor, unsigned short *buf_in,
-		      unsigned short *buf_out, unsigned char *mask,
-		      unsigned int x, unsigned int y, unsigned int ox,
-		      unsigned int oy, unsigned short nd)
-{
-/* rescaling a DataGrid (monolithic)- UINT16 */
-    unsigned int row;
-    unsigned int col;
-    int nodata = 0;
-    int valid = 0;
-    double sum = 0.0;
-    unsigned short *p_out;
-    unsigned char *p_msk;
-
-    if (ox >= out_width || oy >= out_height)
-	return;
-    p_out = buf_out + (out_width * oy) + ox;
-    p_msk = mask + (out_width * oy) + ox;
-
-    for (row = 0; row < factor; row++)
+    if (!valid_mask)
       {
-	  const unsigned short *p_in_base;
-	  unsigned int yy = y + row;
-	  if (yy >= tileHeight)
-	      break;
-	  p_in_base = buf_in + (yy * tileWidth);
-	  for (col = 0; col < factor; col++)
-	    {
-		const unsigned short *p_in;
-		unsigned int xx = x + col;
-		if (xx >= tileWidth)
-		    break;
-		p_in = p_in_base + xx;
-		if (*p_in == nd)
-		    nodata++;
-		else
-		  {
-		      valid++;
-		      sum += *p_in;
-		  }
-	    }
+	  free (mask);
+	  *mask_size = 0;
       }
 
-    if (nodata >= valid)
-	return;
-    *p_out = (unsigned short) (sum / (double) valid);
-    *p_msk = 1;
-}
-
-static void
-rescale_datagrid_32 (unsigned int tileWidth, unsigned int tileHeight,
-		     unsigned int out_width, unsigned int out_height,
-		     unsigned int factor, int *buf_in, int *buf_out,
-		     unsigned char *mask, unsigned int x, unsigned int y,
-		     unsigned int ox, unsigned int oy, int nd)
-{
-/* rescaling a DataGrid (monolithic)- INT32 */
-    unsigned int row;
-    unsigned int col;
-    int nodata = 0;
-    int valid = 0;
-    double sum = 0.0;
-    int *p_out;
-    unsigned char *p_msk;
-
-    if (ox >= out_width || oy >= out_height)
-	return;
-    p_out = buf_out + (out_width * oy) + ox;
-    p_msk = mask + (out_width * oy) + ox;
-
-    for (row = 0; row < factor; row++)
+    return 1;
+  error:
+    if (raster != NULL)
       {
-	  const int *p_in_base;
-	  unsigned int yy = y + row;
-	  if (yy >= tileHeight)
-	      break;
-	  p_in_base = buf_in + (yy * tileWidth);
-	  for (col = 0; col < factor; col++)
-	    {
-		const int *p_in;
-		unsigned int xx = x + col;
-		if (xx >= tileWidth)
-		    break;
-		p_in = p_in_base + xx;
-		if (*p_in == nd)
-		    nodata++;
-		else
-		  {
-		      valid++;
-		      sum += *p_in;
-		  }
-	    }
+	  /* releasing buffers ownership */
+	  rst = (rl2PrivRasterPtr) raster;
+	  rst->rasterBuffer = NULL;
+	  rst->maskBuffer = NULL;
+	  rl2_destroy_raster (raster);
       }
-
-    if (nodata >= valid)
-	return;
-    *p_out = (int) (sum / (double) valid);
-    *p_msk = 1;
+    return 0;
 }
 
-static void
-rescale_datagrid_u32 (unsigned int tileWidth, unsigned int tileHeight,
-		      unsigned int out_width, unsigned int out_height,
-		      unsigned int factor, unsigned int *buf_in,
-		      unsigned int *buf_out, unsigned char *mask,
-		      unsigned int x, unsigned int y, unsigned int ox,
-		      unsigned int oy, unsigned int nd)
+static int
+rescale_monolithic_datagrid (rl2AuxPyramidBasePtr bases,
+			     int num_bases, unsigned int tileWidth,
+			     unsigned int tileHeight,
+			     unsigned char sample_type, int factor,
+			     unsigned char resampling, double res_x,
+			     double res_y, double minx,
+			     double miny, double maxx, double maxy,
+			     unsigned char *buffer, int buf_size,
+			     unsigned char *mask, int *mask_size,
+			     rl2PixelPtr no_data)
 {
-/* rescaling a DataGrid (monolithic)- UINT32 */
-    unsigned int row;
-    unsigned int col;
-    int nodata = 0;
-    int valid = 0;
-    double sum = 0.0;
-    unsigned int *p_out;
-    unsigned char *p_msk;
-
-    if (ox >= out_width || oy >= out_height)
-	return;
-    p_out = buf_out + (out_width * oy) + ox;
-    p_msk = mask + (out_width * oy) + ox;
+/* rescaling monolithic DataGrid */
+    rl2RasterPtr raster = NULL;
+    rl2RasterPtr base_tile = NULL;
+    rl2PrivRasterPtr rst;
+    unsigned int x;
+    unsigned int y;
+    int ib;
+    double shift_x;
+    double shift_y;
+    int valid_mask = 0;
+    unsigned char *p_in;
+    unsigned char *p_out;
+    rl2PixelPtr nd = NULL;
 
-    for (row = 0; row < factor; row++)
+    nd = rl2_clone_pixel (no_data);
+    p_out = mask;
+    for (y = 0; y < tileHeight; y++)
       {
-	  const unsigned int *p_in_base;
-	  unsigned int yy = y + row;
-	  if (yy >= tileHeight)
-	      break;
-	  p_in_base = buf_in + (yy * tileWidth);
-	  for (col = 0; col < factor; col++)
-	    {
-		const unsigned int *p_in;
-		unsigned int xx = x + col;
-		if (xx >= tileWidth)
-		    break;
-		p_in = p_in_base + xx;
-		if (*p_in == nd)
-		    nodata++;
-		else
-		  {
-		      valid++;
-		      sum += *p_in;
-		  }
-	    }
+	  /* priming full transparency */
+	  for (x = 0; x < tileWidth; x++)
+	      *p_out++ = 0;
       }
+    rl2_prime_void_tile (buffer, tileWidth, tileHeight, sample_type, 1,
+			 no_data);
+/* creating the output raster */
+    raster =
+	rl2_create_raster (tileWidth, tileHeight, sample_type,
+			   RL2_PIXEL_DATAGRID, 1, buffer, buf_size,
+			   NULL, mask, *mask_size, nd);
+    if (raster == NULL)
+	goto error;
 
-    if (nodata >= valid)
-	return;
-    *p_out = (unsigned int) (sum / (double) valid);
-    *p_msk = 1;
-}
+/* looping on the lower-level tiles */
+    for (ib = 0; ib < num_bases; ib++)
+      {
+	  /* rescaling a lower-level tile */
+	  rl2RasterPtr raster_in = NULL;
+	  rl2PrivRasterPtr rst_in;
+	  rl2AuxPyramidBasePtr base = bases + ib;
+	  double tile_x = base->x;
+	  double tile_y = base->y;
 
-static void
-rescale_datagrid_flt (unsigned int tileWidth, unsigned int tileHeight,
-		      unsigned int out_width, unsigned int out_height,
-		      unsigned int factor, float *buf_in, float *buf_out,
-		      unsigned char *mask, unsigned int x, unsigned int y,
-		      unsigned int ox, unsigned int oy, float nd)
-{
-/* rescaling a DataGrid (monolithic)- FLOAT */
-    unsigned int row;
-    unsigned int col;
-    int nodata = 0;
-    int valid = 0;
-    double sum = 0.0;
-    float *p_out;
-    unsigned char *p_msk;
+	  raster_in = load_tile_base_generic (base);
+	  if (raster_in == NULL)
+	      goto error;
+	  rst_in = (rl2PrivRasterPtr) raster_in;
+	  base_tile =
+	      create_rescaled_datagrid_raster (factor, tileWidth,
+					       tileHeight,
+					       rst_in->rasterBuffer,
+					       sample_type, no_data,
+					       resampling);
+	  rl2_destroy_raster (raster_in);
+	  raster_in = NULL;
+
+	  if (base_tile == NULL)
+	      goto error;
+	  shift_x = tile_x - minx;
+	  shift_y = maxy - tile_y;
+	  x = (int) (shift_x / res_x);
+	  y = (int) (shift_y / res_y);
+	  copy_datagrid_rescaled (raster, base_tile, x, y);
+	  rl2_destroy_raster (base_tile);
+      }
 
-    if (ox >= out_width || oy >= out_height)
-	return;
-    p_out = buf_out + (out_width * oy) + ox;
-    p_msk = mask + (out_width * oy) + ox;
+/* releasing buffers ownership */
+    rst = (rl2PrivRasterPtr) raster;
+    rst->rasterBuffer = NULL;
+    rst->maskBuffer = NULL;
+    rl2_destroy_raster (raster);
 
-    for (row = 0; row < factor; row++)
+    p_in = mask;
+    for (y = 0; y < tileHeight; y++)
       {
-	  const float *p_in_base;
-	  unsigned int yy = y + row;
-	  if (yy >= tileHeight)
-	      break;
-	  p_in_base = buf_in + (yy * tileWidth);
-	  for (col = 0; col < factor; col++)
+	  for (x = 0; x < tileWidth; x++)
 	    {
-		const float *p_in;
-		unsigned int xx = x + col;
-		if (xx >= tileWidth)
-		    break;
-		p_in = p_in_base + xx;
-		if (*p_in == nd)
-		    nodata++;
-		else
-		  {
-		      valid++;
-		      sum += *p_in;
-		  }
+		if (*p_in++ == 0)
+		    valid_mask = 1;
 	    }
       }
+    if (!valid_mask)
+      {
+	  free (mask);
+	  *mask_size = 0;
+      }
 
-    if (nodata >= valid)
-	return;
-    *p_out = (float) (sum / (double) valid);
-    *p_msk = 1;
+    return 1;
+  error:
+    if (raster != NULL)
+      {
+	  /* releasing buffers ownership */
+	  rst = (rl2PrivRasterPtr) raster;
+	  rst->rasterBuffer = NULL;
+	  rst->maskBuffer = NULL;
+	  rl2_destroy_raster (raster);
+      }
+    return 0;
 }
 
-static void
-rescale_datagrid_dbl (unsigned int tileWidth, unsigned int tileHeight,
-		      unsigned int out_width, unsigned int out_height,
-		      unsigned int factor, double *buf_in, double *buf_out,
-		      unsigned char *mask, unsigned int x, unsigned int y,
-		      unsigned int ox, unsigned int oy, double nd)
+static int
+prepare_section_pyramid_stmts (sqlite3 * handle, const char *coverage,
+			       int mixed_resolutions,
+			       sqlite3_stmt ** xstmt_rd,
+			       sqlite3_stmt ** xstmt_levl,
+			       sqlite3_stmt ** xstmt_tils,
+			       sqlite3_stmt ** xstmt_data)
 {
-/* rescaling a DataGrid (monolithic)- DOUBLE */
-    unsigned int row;
-    unsigned int col;
-    int nodata = 0;
-    int valid = 0;
-    double sum = 0.0;
-    double *p_out;
-    unsigned char *p_msk;
+/* 
+/ preparing the section pyramid related SQL statements
+/
+/ not taken from the Statement Cache: these are prepared just once
+/ for a whole Section, and the tiles they insert would invalidate
+/ the cached Statements of this Coverage anyway
+*/
+    char *table_tile_data;
+    char *xtable_tile_data;
+    char *table;
+    char *xtable;
+    char *sql;
+    sqlite3_stmt *stmt_rd = NULL;
+    sqlite3_stmt *stmt_levl = NULL;
+    sqlite3_stmt *stmt_tils = NULL;
+    sqlite3_stmt *stmt_data = NULL;
+    int ret;
 
-    if (ox >= out_width || oy >= out_height)
-	return;
-    p_out = buf_out + (out_width * oy) + ox;
-    p_msk = mask + (out_width * oy) + ox;
+    *xstmt_rd = NULL;
+    *xstmt_levl = NULL;
+    *xstmt_tils = NULL;
+    *xstmt_data = NULL;
 
-    for (row = 0; row < factor; row++)
+    table_tile_data = sqlite3_mprintf ("%s_tile_data", coverage);
+    xtable_tile_data = rl2_double_quoted_sql (table_tile_data);
+    sqlite3_free (table_tile_data);
+    sql = sqlite3_mprintf ("SELECT tile_data_odd, tile_data_even "
+			   "FROM main.\"%s\" WHERE tile_id = ?",
+			   xtable_tile_data);
+    free (xtable_tile_data);
+    ret = sqlite3_prepare_v2 (handle, sql, strlen (sql), &stmt_rd, NULL);
+    sqlite3_free (sql);
+    if (ret != SQLITE_OK)
       {
-	  const double *p_in_base;
-	  unsigned int yy = y + row;
-	  if (yy >= tileHeight)
-	      break;
-	  p_in_base = buf_in + (yy * tileWidth);
-	  for (col = 0; col < factor; col++)
-	    {
-		const double *p_in;
-		unsigned int xx = x + col;
-		if (xx >= tileWidth)
-		    break;
-		p_in = p_in_base + xx;
-		if (*p_in == nd)
-		    nodata++;
-		else
-		  {
-		      valid++;
-		      sum += *p_in;
-		  }
-	    }
+	  fprintf (stderr, "SQL error: %s\n%s\n", sql, sqlite3_errmsg (handle));
+	  goto error;
       }
-
-    if (nodata >= valid)
-	return;
-    *p_out = (double) (sum / (double) valid);
-    *p_msk = 1;
-}
-
-static rl2RasterPtr
-create_rescaled_datagrid_raster (unsigned int factor, unsigned int tileWidth,
-				 unsigned int tileHeight, const void *buf_in,
-				 unsigned char sample_type, rl2PixelPtr no_data)
-{
-/* rescaling a Datagrid tile */
-    rl2PrivPixelPtr pxl;
-    unsigned int x;
-    unsigned int y;
-    unsigned int ox;
-    unsigned int oy;
-    rl2RasterPtr raster = NULL;
-    unsigned char *mask;
-    void *buf;
-    unsigned int mask_sz;
-    unsigned char pix_sz = 1;
-    unsigned int buf_sz;
-    unsigned int out_width = tileWidth / factor;
-    unsigned int out_height = tileHeight / factor;
-    char no_data_8 = 0;
-    unsigned char no_data_u8 = 0;
-    short no_data_16 = 0;
-    unsigned short no_data_u16 = 0;
-    int no_data_32 = 0;
-    unsigned int no_data_u32 = 0;
-    float no_data_flt = 0.0;
-    double no_data_dbl = 0.0;
-
-/* retrieving NO-DATA */
-    pxl = (rl2PrivPixelPtr) no_data;
-    if (pxl != NULL)
+    if (mixed_resolutions)
       {
-	  if (pxl->nBands == 1 && pxl->pixelType == RL2_PIXEL_DATAGRID
-	      && pxl->sampleType == sample_type)
-	    {
-		rl2PrivSamplePtr sample = pxl->Samples;
-		switch (sample_type)
-		  {
-		  case RL2_SAMPLE_INT8:
-		      no_data_8 = sample->int8;
-		      break;
-		  case RL2_SAMPLE_UINT8:
-		      no_data_u8 = sample->uint8;
-		      break;
-		  case RL2_SAMPLE_INT16:
-		      no_data_16 = sample->int16;
-		      break;
-		  case RL2_SAMPLE_UINT16:
-		      no_data_u16 = sample->uint16;
-		      break;
-		  case RL2_SAMPLE_INT32:
-		      no_data_32 = sample->int32;
-		      break;
-		  case RL2_SAMPLE_UINT32:
-		      no_data_u32 = sample->uint32;
-		      break;
-		  case RL2_SAMPLE_FLOAT:
-		      no_data_flt = sample->float32;
-		      break;
-		  case RL2_SAMPLE_DOUBLE:
-		      no_data_dbl = sample->float64;
-		      break;
-		  };
-	    }
-      }
-/* computing sizes */
-    mask_sz = out_width * out_height;
-    switch (sample_type)
-      {
-      case RL2_SAMPLE_INT16:
-      case RL2_SAMPLE_UINT16:
-	  pix_sz = 2;
-	  break;
-      case RL2_SAMPLE_INT32:
-      case RL2_SAMPLE_UINT32:
-      case RL2_SAMPLE_FLOAT:
-	  pix_sz = 4;
-	  break;
-      case RL2_SAMPLE_DOUBLE:
-	  pix_sz = 8;
-	  break;
-      };
-    buf_sz = out_width * out_height * pix_sz;
-    buf = malloc (buf_sz);
-    if (buf == NULL)
-	return NULL;
-    mask = malloc (mask_sz);
-    if (mask == NULL)
-      {
-	  free (buf);
-	  return NULL;
+	  /* mixed resolution Coverage */
+	  table = sqlite3_mprintf ("%s_section_levels", coverage);
+	  xtable = rl2_double_quoted_sql (table);
+	  sqlite3_free (table);
+	  sql =
+	      sqlite3_mprintf
+	      ("INSERT OR IGNORE INTO main.\"%s\" (section_id, pyramid_level, "
+	       "x_resolution_1_1, y_resolution_1_1, "
+	       "x_resolution_1_2, y_resolution_1_2, x_resolution_1_4, "
+	       "y_resolution_1_4, x_resolution_1_8, y_resolution_1_8) "
+	       "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?)", xtable);
       }
-    rl2_prime_void_tile (buf, out_width, out_height, sample_type, 1, no_data);
-    memset (mask, 0, mask_sz);
-
-    oy = 0;
-    for (y = 0; y < tileHeight; y += factor)
+    else
       {
-	  ox = 0;
-	  for (x = 0; x < tileWidth; x += factor)
-	    {
-		switch (sample_type)
-		  {
-		  case RL2_SAMPLE_INT8:
-		      rescale_datagrid_8 (tileWidth, tileHeight, out_width,
-					  out_height, factor, (char *) buf_in,
-					  (char *) buf, mask, x, y, ox, oy,
-					  no_data_8);
-		      break;
-		  case RL2_SAMPLE_UINT8:
-		      rescale_datagrid_u8 (tileWidth, tileHeight, out_width,
-					   out_height, factor,
-					   (unsigned char *) buf_in,
-					   (unsigned char *) buf, mask, x, y,
-					   ox, oy, no_data_u8);
-		      break;
-		  case RL2_SAMPLE_INT16:
-		      rescale_datagrid_16 (tileWidth, tileHeight, out_width,
-					   out_height, factor,
-					   (short *) buf_in, (short *) buf,
-					   mask, x, y, ox, oy, no_data_16);
-		      break;
-		  case RL2_SAMPLE_UINT16:
-		      rescale_datagrid_u16 (tileWidth, tileHeight, out_width,
-					    out_height, factor,
-					    (unsigned short *) buf_in,
-					    (unsigned short *) buf, mask, x,
-					    y, ox, oy, no_data_u16);
-		      break;
-		  case RL2_SAMPLE_INT32:
-		      rescale_datagrid_32 (tileWidth, tileHeight, out_width,
-					   out_height, factor, (int *) buf_in,
-					   (int *) buf, mask, x, y, ox, oy,
-					   no_data_32);
-		      break;
-		  case RL2_SAMPLE_UINT32:
-		      rescale_datagrid_u32 (tileWidth, tileHeight, out_width,
-					    out_height, factor,
-					    (unsigned int *) buf_in,
-					    (unsigned int *) buf, mask, x, y,
-					    ox, oy, no_data_u32);
-		      break;
-		  case RL2_SAMPLE_FLOAT:
-		      rescale_datagrid_flt (tileWidth, tileHeight, out_width,
-					    out_height, factor,
-					    (float *) buf_in, (float *) buf,
-					    mask, x, y, ox, oy, no_data_flt);
-		      break;
-		  case RL2_SAMPLE_DOUBLE:
-		      rescale_datagrid_dbl (tileWidth, tileHeight, out_width,
-					    out_height, factor,
-					    (double *) buf_in, (double *) buf,
-					    mask, x, y, ox, oy, no_data_dbl);
-		      break;
-		  };
-		ox++;
-	    }
-	  oy++;
+	  /* ordinary Coverage */
+	  table = sqlite3_mprintf ("%s_levels", coverage);
+	  xtable = rl2_double_quoted_sql (table);
+	  sqlite3_free (table);
+	  sql =
+	      sqlite3_mprintf
+	      ("INSERT OR IGNORE INTO main.\"%s\" (pyramid_level, "
+	       "x_resolution_1_1, y_resolution_1_1, "
+	       "x_resolution_1_2, y_resolution_1_2, x_resolution_1_4, "
+	       "y_resolution_1_4, x_resolution_1_8, y_resolution_1_8) "
+	       "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?)", xtable);
       }
-
-    raster =
-	rl2_create_raster (out_width, out_height, sample_type,
-			   RL2_PIXEL_DATAGRID, 1, buf, buf_sz, NULL, mask,
-			   mask_sz, NULL);
-    return raster;
-}
-
-static int
-rescale_monolithic_multiband (int id_level,
-			      unsigned int tileWidth, unsigned int tileHeight,
-			      unsigned char sample_type,
-			      unsigned char num_bands, int factor,
-			      double res_x, double res_y, double minx,
-			      double miny, double maxx, double maxy,
-			      unsigned char *buffer, int buf_size,
-			      unsigned char *mask, int *mask_size,
-			      rl2PixelPtr no_data, sqlite3_stmt * stmt_geo,
-			      sqlite3_stmt * stmt_data)
-{
-/* rescaling monolithic MultiBand */
-    rl2RasterPtr raster = NULL;
-    rl2RasterPtr base_tile = NULL;
-    rl2PrivRasterPtr rst;
-    unsigned int x;
-    unsigned int y;
-    int ret;
-    double shift_x;
-    double shift_y;
-    int valid_mask = 0;
-    unsigned char *p_in;
-    unsigned char *p_out;
-    rl2PixelPtr nd = NULL;
-
-    nd = rl2_clone_pixel (no_data);
-    p_out = mask;
-    for (y = 0; y < tileHeight; y++)
+    free (xtable);
+    ret = sqlite3_prepare_v2 (handle, sql, strlen (sql), &stmt_levl, NULL);
+    sqlite3_free (sql);
+    if (ret != SQLITE_OK)
       {
-	  /* priming full transparency */
-	  for (x = 0; x < tileWidth; x++)
-	      *p_out++ = 0;
+	  printf ("INSERT INTO levels SQL error: %s\n",
+		  sqlite3_errmsg (handle));
+	  goto error;
       }
-    rl2_prime_void_tile (buffer, tileWidth, tileHeight, sample_type,
-			 num_bands, no_data);
-/* creating the output raster */
-    raster =
-	rl2_create_raster (tileWidth, tileHeight, sample_type,
-			   RL2_PIXEL_MULTIBAND, num_bands, buffer, buf_size,
-			   NULL, mask, *mask_size, nd);
-    if (raster == NULL)
-	goto error;
 
-/* binding the BBOX to be queried */
-    sqlite3_reset (stmt_geo);
-    sqlite3_clear_bindings (stmt_geo);
-    sqlite3_bind_int (stmt_geo, 1, id_level);
-    sqlite3_bind_double (stmt_geo, 2, minx);
-    sqlite3_bind_double (stmt_geo, 3, miny);
-    sqlite3_bind_double (stmt_geo, 4, maxx);
-    sqlite3_bind_double (stmt_geo, 5, maxy);
-    while (1)
+    table = sqlite3_mprintf ("%s_tiles", coverage);
+    xtable = rl2_double_quoted_sql (table);
+    sqlite3_free (table);
+    sql =
+	sqlite3_mprintf
+	("INSERT INTO main.\"%s\" (tile_id, pyramid_level, section_id, geometry) "
+	 "VALUES (NULL, ?, ?, BuildMBR(?, ?, ?, ?, ?))", xtable);
+    free (xtable);
+    ret = sqlite3_prepare_v2 (handle, sql, strlen (sql), &stmt_tils, NULL);
+    sqlite3_free (sql);
+    if (ret != SQLITE_OK)
       {
-	  /* scrolling the result set rows */
-	  ret = sqlite3_step (stmt_geo);
-	  if (ret == SQLITE_DONE)
-	      break;		/* end of result set */
-	  if (ret == SQLITE_ROW)
-	    {
-		rl2RasterPtr raster_in = NULL;
-		rl2PrivRasterPtr rst_in;
-		sqlite3_int64 tile_id = sqlite3_column_int64 (stmt_geo, 0);
-		double tile_x = sqlite3_column_double (stmt_geo, 1);
-		double tile_y = sqlite3_column_double (stmt_geo, 2);
-
-		raster_in = load_tile_base_generic (stmt_data, tile_id);
-		rst_in = (rl2PrivRasterPtr) raster_in;
-		base_tile =
-		    create_rescaled_multiband_raster (factor, tileWidth,
-						      tileHeight,
-						      rst_in->rasterBuffer,
-						      rst_in->maskBuffer,
-						      sample_type, num_bands,
-						      no_data);
-		rl2_destroy_raster (raster_in);
-		raster_in = NULL;
-
-		if (base_tile == NULL)
-		    goto error;
-		shift_x = tile_x - minx;
-		shift_y = maxy - tile_y;
-		x = (int) (shift_x / res_x);
-		y = (int) (shift_y / res_y);
-		copy_multiband_rescaled (raster, base_tile, x, y);
-		rl2_destroy_raster (base_tile);
-	    }
+	  printf ("INSERT INTO tiles SQL error: %s\n", sqlite3_errmsg (handle));
+	  goto error;
       }
 
-/* releasing buffers ownership */
-    rst = (rl2PrivRasterPtr) raster;
-    rst->rasterBuffer = NULL;
-    rst->maskBuffer = NULL;
-    rl2_destroy_raster (raster);
-
-    p_in = mask;
-    for (y = 0; y < tileHeight; y++)
-      {
-	  for (x = 0; x < tileWidth; x++)
-	    {
-		if (*p_in++ == 0)
-		    valid_mask = 1;
-	    }
-      }
-    if (!valid_mask)
+    table = sqlite3_mprintf ("%s_tile_data", coverage);
+    xtable = rl2_double_quoted_sql (table);
+    sqlite3_free (table);
+    sql =
+	sqlite3_mprintf
+	("INSERT INTO main.\"%s\" (tile_id, tile_data_odd, tile_data_even) "
+	 "VALUES (?, ?, ?)", xtable);
+    free (xtable);
+    ret = sqlite3_prepare_v2 (handle, sql, strlen (sql), &stmt_data, NULL);
+    sqlite3_free (sql);
+    if (ret != SQLITE_OK)
       {
-	  free (mask);
-	  *mask_size = 0;
+	  printf ("INSERT INTO tile_data SQL error: %s\n",
+		  sqlite3_errmsg (handle));
+	  goto error;
       }
 
+    *xstmt_rd = stmt_rd;
+    *xstmt_levl = stmt_levl;
+    *xstmt_tils = stmt_tils;
+    *xstmt_data = stmt_data;
     return 1;
+
   error:
-    if (raster != NULL)
-      {
-	  /* releasing buffers ownership */
-	  rst = (rl2PrivRasterPtr) raster;
-	  rst->rasterBuffer = NULL;
-	  rst->maskBuffer = NULL;
-	  rl2_destroy_raster (raster);
-      }
+    if (stmt_rd != NULL)
+	sqlite3_finalize (stmt_rd);
+    if (stmt_levl != NULL)
+	sqlite3_finalize (stmt_levl);
+    if (stmt_tils != NULL)
+	sqlite3_finalize (stmt_tils);
+    if (stmt_data != NULL)
+	sqlite3_finalize (stmt_data);
     return 0;
 }
 
 static int
-rescale_monolithic_datagrid (int id_level,
-			     unsigned int tileWidth, unsigned int tileHeight,
-			     unsigned char sample_type, int factor,
-			     double res_x, double res_y, double minx,
-			     double miny, double maxx, double maxy,
-			     unsigned char *buffer, int buf_size,
-			     unsigned char *mask, int *mask_size,
-			     rl2PixelPtr no_data, sqlite3_stmt * stmt_geo,
-			     sqlite3_stmt * stmt_data)
+do_build_section_pyramid (sqlite3 * handle, int max_threads,
+			  const char *coverage, sqlite3_int64 section_id,
+			  unsigned char sample_type,
+			  unsigned char pixel_type, unsigned char num_samples,
+			  unsigned char compression, int mixed_resolutions,
+			  int quality, int srid, unsigned int tileWidth,
+			  unsigned int tileHeight, unsigned char resampling)
 {
-/* rescaling monolithic DataGrid */
-    rl2RasterPtr raster = NULL;
-    rl2RasterPtr base_tile = NULL;
-    rl2PrivRasterPtr rst;
-    unsigned int x;
-    unsigned int y;
-    int ret;
-    double shift_x;
-    double shift_y;
-    int valid_mask = 0;
-    unsigned char *p_in;
-    unsigned char *p_out;
-    rl2PixelPtr nd = NULL;
-
-    nd = rl2_clone_pixel (no_data);
-    p_out = mask;
-    for (y = 0; y < tileHeight; y++)
-      {
-	  /* priming full transparency */
-	  for (x = 0; x < tileWidth; x++)
-	      *p_out++ = 0;
-      }
-    rl2_prime_void_tile (buffer, tileWidth, tileHeight, sample_type, 1,
-			 no_data);
-/* creating the output raster */
-    raster =
-	rl2_create_raster (tileWidth, tileHeight, sample_type,
-			   RL2_PIXEL_DATAGRID, 1, buffer, buf_size,
-			   NULL, mask, *mask_size, nd);
-    if (raster == NULL)
-	goto error;
-
-/* binding the BBOX to be queried */
-    sqlite3_reset (stmt_geo);
-    sqlite3_clear_bindings (stmt_geo);
-    sqlite3_bind_int (stmt_geo, 1, id_level);
-    sqlite3_bind_double (stmt_geo, 2, minx);
-    sqlite3_bind_double (stmt_geo, 3, miny);
-    sqlite3_bind_double (stmt_geo, 4, maxx);
-    sqlite3_bind_double (stmt_geo, 5, maxy);
-    while (1)
-      {
-	  /* scrolling the result set rows */
-	  ret = sqlite3_step (stmt_geo);
-	  if (ret == SQLITE_DONE)
-	      break;		/* end of result set */
-	  if (ret == SQLITE_ROW)
-	    {
-		rl2RasterPtr raster_in = NULL;
-		rl2PrivRasterPtr rst_in;
-		sqlite3_int64 tile_id = sqlite3_column_int64 (stmt_geo, 0);
-		double tile_x = sqlite3_column_double (stmt_geo, 1);
-		double tile_y = sqlite3_column_double (stmt_geo, 2);
-
-		raster_in = load_tile_base_generic (stmt_data, tile_id);
-		rst_in = (rl2PrivRasterPtr) raster_in;
-		base_tile =
-		    create_rescaled_datagrid_raster (factor, tileWidth,
-						     tileHeight,
-						     rst_in->rasterBuffer,
-						     sample_type, no_data);
-		rl2_destroy_raster (raster_in);
-		raster_in = NULL;
-
-		if (base_tile == NULL)
-		    goto error;
-		shift_x = tile_x - minx;
-		shift_y = maxy - tile_y;
-		x = (int) (shift_x / res_x);
-		y = (int) (shift_y / res_y);
-		copy_datagrid_rescaled (raster, base_tile, x, y);
-		rl2_destroy_raster (base_tile);
-	    }
-      }
-
-/* releasing buffers ownership */
-    rst = (rl2PrivRasterPtr) raster;
-    rst->rasterBuffer = NULL;
-    rst->maskBuffer = NULL;
-    rl2_destroy_raster (raster);
-
-    p_in = mask;
-    for (y = 0; y < tileHeight; y++)
-      {
-	  for (x = 0; x < tileWidth; x++)
-	    {
-		if (*p_in++ == 0)
-		    valid_mask = 1;
-	    }
-      }
-    if (!valid_mask)
-      {
-	  free (mask);
-	  *mask_size = 0;
-      }
-
-    return 1;
-  error:
-    if (raster != NULL)
-      {
-	  /* releasing buffers ownership */
-	  rst = (rl2PrivRasterPtr) raster;
-	  rst->rasterBuffer = NULL;
-	  rst->maskBuffer = NULL;
-	  rl2_destroy_raster (raster);
-      }
-    return 0;
-}
-
-static int
-prepare_section_pyramid_stmts (sqlite3 * handle, const char *coverage,
-			       int mixed_resolutions,
-			       sqlite3_stmt ** xstmt_rd,
-			       sqlite3_stmt ** xstmt_levl,
-			       sqlite3_stmt ** xstmt_tils,
-			       sqlite3_stmt ** xstmt_data)
-{
-/* preparing the section pyramid related SQL statements */
-    char *table_tile_data;
-    char *xtable_tile_data;
-    char *table;
-    char *xtable;
-    char *sql;
-    sqlite3_stmt *stmt_rd = NULL;
-    sqlite3_stmt *stmt_levl = NULL;
-    sqlite3_stmt *stmt_tils = NULL;
-    sqlite3_stmt *stmt_data = NULL;
-    int ret;
-
-    *xstmt_rd = NULL;
-    *xstmt_levl = NULL;
-    *xstmt_tils = NULL;
-    *xstmt_data = NULL;
-
-    table_tile_data = sqlite3_mprintf ("%s_tile_data", coverage);
-    xtable_tile_data = rl2_double_quoted_sql (table_tile_data);
-    sqlite3_free (table_tile_data);
-    sql = sqlite3_mprintf ("SELECT tile_data_odd, tile_data_even "
-			   "FROM main.\"%s\" WHERE tile_id = ?",
-			   xtable_tile_data);
-    free (xtable_tile_data);
-    ret = sqlite3_prepare_v2 (handle, sql, strlen (sql), &stmt_rd, NULL);
-    sqlite3_free (sql);
-    if (ret != SQLITE_OK)
-      {
-	  fprintf (stderr, "SQL error: %s\n%s\n", sql, sqlite3_errmsg (handle));
-	  goto error;
-      }
-    if (mixed_resolutions)
-      {
-	  /* mixed resolution Coverage */
-	  table = sqlite3_mprintf ("%s_section_levels", coverage);
-	  xtable = rl2_double_quoted_sql (table);
-	  sqlite3_free (table);
-	  sql =
-	      sqlite3_mprintf
-	      ("INSERT OR IGNORE INTO main.\"%s\" (section_id, pyramid_level, "
-	       "x_resolution_1_1, y_resolution_1_1, "
-	       "x_resolution_1_2, y_resolution_1_2, x_resolution_1_4, "
-	       "y_resolution_1_4, x_resolution_1_8, y_resolution_1_8) "
-	       "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?)", xtable);
-      }
-    else
-      {
-	  /* ordinary Coverage */
-	  table = sqlite3_mprintf ("%s_levels", coverage);
-	  xtable = rl2_double_quoted_sql (table);
-	  sqlite3_free (table);
-	  sql =
-	      sqlite3_mprintf
-	      ("INSERT OR IGNORE INTO main.\"%s\" (pyramid_level, "
-	       "x_resolution_1_1, y_resolution_1_1, "
-	       "x_resolution_1_2, y_resolution_1_2, x_resolution_1_4, "
-	       "y_resolution_1_4, x_resolution_1_8, y_resolution_1_8) "
-	       "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?)", xtable);
-      }
-    free (xtable);
-    ret = sqlite3_prepare_v2 (handle, sql, strlen (sql), &stmt_levl, NULL);
-    sqlite3_free (sql);
-    if (ret != SQLITE_OK)
-      {
-	  printf ("INSERT INTO levels SQL error: %s\n",
-		  sqlite3_errmsg (handle));
-	  goto error;
-      }
-
-    table = sqlite3_mprintf ("%s_tiles", coverage);
-    xtable = rl2_double_quoted_sql (table);
-    sqlite3_free (table);
-    sql =
-	sqlite3_mprintf
-	("INSERT INTO main.\"%s\" (tile_id, pyramid_level, section_id, geometry) "
-	 "VALUES (NULL, ?, ?, BuildMBR(?, ?, ?, ?, ?))", xtable);
-    free (xtable);
-    ret = sqlite3_prepare_v2 (handle, sql, strlen (sql), &stmt_tils, NULL);
-    sqlite3_free (sql);
-    if (ret != SQLITE_OK)
-      {
-	  printf ("INSERT INTO tiles SQL error: %s\n", sqlite3_errmsg (handle));
-	  goto error;
-      }
-
-    table = sqlite3_mprintf ("%s_tile_data", coverage);
-    xtable = rl2_double_quoted_sql (table);
-    sqlite3_free (table);
-    sql =
-	sqlite3_mprintf
-	("INSERT INTO main.\"%s\" (tile_id, tile_data_odd, tile_data_even) "
-	 "VALUES (?, ?, ?)", xtable);
-    free (xtable);
-    ret = sqlite3_prepare_v2 (handle, sql, strlen (sql), &stmt_data, NULL);
-    sqlite3_free (sql);
-    if (ret != SQLITE_OK)
-      {
-	  printf ("INSERT INTO tile_data SQL error: %s\n",
-		  sqlite3_errmsg (handle));
-	  goto error;
-      }
-
-    *xstmt_rd = stmt_rd;
-    *xstmt_levl = stmt_levl;
-    *xstmt_tils = stmt_tils;
-    *xstmt_data = stmt_data;
-    return 1;
-
-  error:
-    if (stmt_rd != NULL)
-	sqlite3_finalize (stmt_rd);
-    if (stmt_levl != NULL)
-	sqlite3_finalize (stmt_levl);
-    if (stmt_tils != NULL)
-	sqlite3_finalize (stmt_tils);
-    if (stmt_data != NULL)
-	sqlite3_finalize (stmt_data);
-    return 0;
-}
-
-static int
-do_build_section_pyramid (sqlite3 * handle, const char *coverage,
-			  sqlite3_int64 section_id, unsigned char sample_type,
-			  unsigned char pixel_type, unsigned char num_samples,
-			  unsigned char compression, int mixed_resolutions,
-			  int quality, int srid, unsigned int tileWidth,
-			  unsigned int tileHeight)
-{
-/* attempting to (re)build a section pyramid from scratch */
-    char *table_levels;
-    char *xtable_levels;
-    char *table_tiles;
-    char *xtable_tiles;
-    char *sql;
-    int id_level = 0;
-    double new_res_x;
-    double new_res_y;
-    unsigned int sect_width;
-    unsigned int sect_height;
-    double minx;
-    double miny;
-    double maxx;
-    double maxy;
-    unsigned int row;
-    unsigned int col;
-    double out_minx;
-    double out_miny;
-    double out_maxx;
-    double out_maxy;
-    sqlite3_stmt *stmt = NULL;
-    sqlite3_stmt *stmt_rd = NULL;
-    sqlite3_stmt *stmt_levl = NULL;
-    sqlite3_stmt *stmt_tils = NULL;
-    sqlite3_stmt *stmt_data = NULL;
-    SectionPyramid *pyr = NULL;
+/* attempting to (re)build a section pyramid from scratch */
+    char *table_levels;
+    char *xtable_levels;
+    char *table_tiles;
+    char *xtable_tiles;
+    char *sql;
+    int id_level = 0;
+    double new_res_x;
+    double new_res_y;
+    unsigned int sect_width;
+    unsigned int sect_height;
+    double minx;
+    double miny;
+    double maxx;
+    double maxy;
+    unsigned int row;
+    unsigned int col;
+    double out_minx;
+    double out_miny;
+    double out_maxx;
+    double out_maxy;
+    sqlite3_stmt *stmt = NULL;
+    sqlite3_stmt *stmt_rd = NULL;
+    sqlite3_stmt *stmt_levl = NULL;
+    sqlite3_stmt *stmt_tils = NULL;
+    sqlite3_stmt *stmt_data = NULL;
+    SectionPyramid *pyr = NULL;
     int ret;
     int first;
     int scale;
@@ -4603,7 +4156,8 @@ do_build_section_pyramid (sqlite3 * handle, const char *coverage,
 						    new_res_x,
 						    (double) tileHeight *
 						    new_res_y, minx, miny,
-						    maxx, maxy, scale);
+						    maxx, maxy, scale,
+						    resampling);
 			    first = 0;
 			    if (pyr == NULL)
 				goto error;
@@ -4661,30 +4215,10 @@ do_build_section_pyramid (sqlite3 * handle, const char *coverage,
 		    (handle, id_level, pyr->res_x, pyr->res_y, stmt_levl))
 		    goto error;
 	    }
-	  if (pixel_type == RL2_PIXEL_DATAGRID)
-	    {
-		/* DataGrid Pyramid */
-		if (!update_sect_pyramid_grid
-		    (handle, stmt_rd, stmt_tils, stmt_data, pyr, tileWidth,
-		     tileHeight, id_level, no_data, sample_type))
-		    goto error;
-	    }
-	  else if (pixel_type == RL2_PIXEL_MULTIBAND)
-	    {
-		/* MultiBand Pyramid */
-		if (!update_sect_pyramid_multiband
-		    (handle, stmt_rd, stmt_tils, stmt_data, pyr, tileWidth,
-		     tileHeight, id_level, no_data, sample_type, num_samples))
-		    goto error;
-	    }
-	  else
-	    {
-		/* any other Pyramid [not a DataGrid] */
-		if (!update_sect_pyramid
-		    (handle, stmt_rd, stmt_tils, stmt_data, pyr, tileWidth,
-		     tileHeight, id_level, palette, no_data))
-		    goto error;
-	    }
+	  if (!update_sect_pyramid_tiles
+	      (handle, max_threads, stmt_rd, stmt_tils, stmt_data, pyr,
+	       tileWidth, tileHeight, id_level, palette, no_data))
+	      goto error;
 	  delete_sect_pyramid (pyr);
 	  pyr = NULL;
       }
@@ -4704,30 +4238,10 @@ do_build_section_pyramid (sqlite3 * handle, const char *coverage,
 		    (handle, id_level, pyr->res_x, pyr->res_y, stmt_levl))
 		    goto error;
 	    }
-	  if (pixel_type == RL2_PIXEL_DATAGRID)
-	    {
-		/* DataGrid Pyramid */
-		if (!update_sect_pyramid_grid
-		    (handle, stmt_rd, stmt_tils, stmt_data, pyr, tileWidth,
-		     tileHeight, id_level, no_data, sample_type))
-		    goto error;
-	    }
-	  else if (pixel_type == RL2_PIXEL_MULTIBAND)
-	    {
-		/* MultiBand Pyramid */
-		if (!update_sect_pyramid_multiband
-		    (handle, stmt_rd, stmt_tils, stmt_data, pyr, tileWidth,
-		     tileHeight, id_level, no_data, sample_type, num_samples))
-		    goto error;
-	    }
-	  else
-	    {
-		/* any other Pyramid [not a DataGrid] */
-		if (!update_sect_pyramid
-		    (handle, stmt_rd, stmt_tils, stmt_data, pyr, tileWidth,
-		     tileHeight, id_level, palette, no_data))
-		    goto error;
-	    }
+	  if (!update_sect_pyramid_tiles
+	      (handle, max_threads, stmt_rd, stmt_tils, stmt_data, pyr,
+	       tileWidth, tileHeight, id_level, palette, no_data))
+	      goto error;
 	  delete_sect_pyramid (pyr);
       }
     sqlite3_finalize (stmt_rd);
@@ -5063,9 +4577,10 @@ get_section_raw_raster_data (sqlite3 * handle, int max_threads,
 	void_raw_buffer (bufpix, width, height, sample_type, num_bands,
 			 no_data);
     if (!rl2_load_dbms_tiles_section
-	(handle, max_threads, sect_id, stmt_tiles, stmt_data, bufpix, width,
-	 height, sample_type, num_bands, 0, 0, 0, x_res, y_res, minx, miny,
-	 maxx, maxy, 0, RL2_SCALE_1, palette, no_data))
+	(handle, NULL, max_threads, NULL, coverage, sect_id, stmt_tiles,
+	 stmt_data, bufpix, width, height, sample_type, num_bands, 0, 0, 0,
+	 x_res, y_res, minx, miny, maxx, maxy, 0, RL2_SCALE_1, palette,
+	 no_data))
 	goto error;
     sqlite3_finalize (stmt_tiles);
     sqlite3_finalize (stmt_data);
@@ -5911,107 +5426,1162 @@ do_build_palette_section_pyramid (sqlite3 * handle, int max_threads,
     return 0;
 }
 
-static void
-get_background_color (sqlite3 * handle, rl2CoveragePtr coverage,
-		      unsigned char *bgRed, unsigned char *bgGreen,
-		      unsigned char *bgBlue)
+static void
+get_background_color (sqlite3 * handle, rl2CoveragePtr coverage,
+		      unsigned char *bgRed, unsigned char *bgGreen,
+		      unsigned char *bgBlue)
+{
+/* retrieving the background color for 1,2,4 bit samples */
+    sqlite3_stmt *stmt = NULL;
+    char *sql;
+    int ret;
+    rl2PrivPalettePtr plt;
+    rl2PalettePtr palette = NULL;
+    rl2PrivSamplePtr smp;
+    rl2PrivPixelPtr pxl;
+    rl2PrivCoveragePtr cvg = (rl2PrivCoveragePtr) coverage;
+    unsigned char index;
+    *bgRed = 255;
+    *bgGreen = 255;
+    *bgBlue = 255;
+
+    if (cvg == NULL)
+	return;
+    if (cvg->noData == NULL)
+	return;
+    pxl = (rl2PrivPixelPtr) (cvg->noData);
+    smp = pxl->Samples;
+    index = smp->uint8;
+
+    if (cvg->pixelType == RL2_PIXEL_MONOCHROME)
+      {
+	  if (index == 1)
+	    {
+		*bgRed = 0;
+		*bgGreen = 0;
+		*bgBlue = 0;
+	    }
+	  return;
+      }
+
+/* Coverage's palette */
+    sql = sqlite3_mprintf ("SELECT palette FROM main.raster_coverages "
+			   "WHERE Lower(coverage_name) = Lower(%Q)",
+			   cvg->coverageName);
+    ret = sqlite3_prepare_v2 (handle, sql, strlen (sql), &stmt, NULL);
+    sqlite3_free (sql);
+    if (ret != SQLITE_OK)
+      {
+	  fprintf (stderr, "SQL error: %s\n%s\n", sql, sqlite3_errmsg (handle));
+	  goto error;
+      }
+    while (1)
+      {
+	  ret = sqlite3_step (stmt);
+	  if (ret == SQLITE_DONE)
+	      break;
+	  if (ret == SQLITE_ROW)
+	    {
+		if (sqlite3_column_type (stmt, 0) == SQLITE_BLOB)
+		  {
+		      const unsigned char *blob = sqlite3_column_blob (stmt, 0);
+		      int blob_sz = sqlite3_column_bytes (stmt, 0);
+		      palette = rl2_deserialize_dbms_palette (blob, blob_sz);
+		  }
+	    }
+	  else
+	    {
+		fprintf (stderr,
+			 "SELECT section_info; sqlite3_step() error: %s\n",
+			 sqlite3_errmsg (handle));
+		goto error;
+	    }
+      }
+    sqlite3_finalize (stmt);
+    if (palette == NULL)
+	goto error;
+
+    plt = (rl2PrivPalettePtr) palette;
+    if (index < plt->nEntries)
+      {
+	  rl2PrivPaletteEntryPtr rgb = plt->entries + index;
+	  *bgRed = rgb->red;
+	  *bgGreen = rgb->green;
+	  *bgBlue = rgb->blue;
+      }
+    rl2_destroy_palette (palette);
+    return;
+
+  error:
+    if (stmt != NULL)
+	sqlite3_finalize (stmt);
+    if (palette != NULL)
+	rl2_destroy_palette (palette);
+}
+
+RL2_DECLARE int
+rl2_build_section_pyramid (sqlite3 * handle, int max_threads,
+			   const char *coverage, sqlite3_int64 section_id,
+			   int forced_rebuild, int verbose)
+{
+/* (re)building section-level pyramid for a single Section */
+    rl2CoveragePtr cvg = NULL;
+    rl2PrivCoveragePtr ptrcvg;
+    unsigned char sample_type;
+    unsigned char pixel_type;
+    unsigned char num_bands;
+    unsigned char compression;
+    int quality;
+    unsigned int tileWidth;
+    unsigned int tileHeight;
+    int srid;
+    int build = 0;
+    unsigned char bgRed;
+    unsigned char bgGreen;
+    unsigned char bgBlue;
+
+    cvg = rl2_create_coverage_from_dbms (handle, NULL, coverage);
+    if (cvg == NULL)
+	goto error;
+
+    if (rl2_get_coverage_type (cvg, &sample_type, &pixel_type, &num_bands) !=
+	RL2_OK)
+	goto error;
+    if (rl2_get_coverage_compression (cvg, &compression, &quality) != RL2_OK)
+	goto error;
+    if (rl2_get_coverage_tile_size (cvg, &tileWidth, &tileHeight) != RL2_OK)
+	goto error;
+    if (rl2_get_coverage_srid (cvg, &srid) != RL2_OK)
+	goto error;
+    ptrcvg = (rl2PrivCoveragePtr) cvg;
+
+    if (!forced_rebuild)
+      {
+	  /* checking if the section pyramid already exists */
+	  build = check_section_pyramid (handle, coverage, section_id);
+      }
+    else
+      {
+	  /* unconditional rebuilding */
+	  build = 1;
+      }
+
+    if (build)
+      {
+	  /* attempting to delete the section pyramid */
+	  if (!delete_section_pyramid (handle, coverage, section_id))
+	      goto error;
+	  /* attempting to (re)build the section pyramid */
+	  if ((sample_type == RL2_SAMPLE_1_BIT
+	       && pixel_type == RL2_PIXEL_MONOCHROME && num_bands == 1)
+	      || (sample_type == RL2_SAMPLE_1_BIT
+		  && pixel_type == RL2_PIXEL_PALETTE && num_bands == 1)
+	      || (sample_type == RL2_SAMPLE_2_BIT
+		  && pixel_type == RL2_PIXEL_PALETTE && num_bands == 1)
+	      || (sample_type == RL2_SAMPLE_4_BIT
+		  && pixel_type == RL2_PIXEL_PALETTE && num_bands == 1))
+	    {
+		/* special case: 1,2,4 bit Pyramid */
+		get_background_color (handle, cvg, &bgRed, &bgGreen, &bgBlue);
+		if (!do_build_124_bit_section_pyramid
+		    (handle, max_threads, coverage, ptrcvg->mixedResolutions,
+		     section_id, sample_type, pixel_type, num_bands, srid,
+		     tileWidth, tileHeight, bgRed, bgGreen, bgBlue))
+		    goto error;
+	    }
+	  else if (sample_type == RL2_SAMPLE_UINT8
+		   && pixel_type == RL2_PIXEL_PALETTE && num_bands == 1)
+	    {
+		/* special case: 8 bit Palette Pyramid */
+		get_background_color (handle, cvg, &bgRed, &bgGreen, &bgBlue);
+		if (!do_build_palette_section_pyramid
+		    (handle, max_threads, coverage, ptrcvg->mixedResolutions,
+		     section_id, srid, tileWidth, tileHeight, bgRed, bgGreen,
+		     bgBlue))
+		    goto error;
+	    }
+	  else
+	    {
+		/* ordinary RGB, Grayscale, MultiBand or DataGrid Pyramid */
+		if (!do_build_section_pyramid
+		    (handle, max_threads, coverage, section_id, sample_type,
+		     pixel_type, num_bands, compression,
+		     ptrcvg->mixedResolutions, quality, srid, tileWidth,
+		     tileHeight, ptrcvg->pyramidResampling))
+		    goto error;
+	    }
+	  if (verbose)
+	    {
+		printf ("  ----------\n");
+#if defined(_WIN32) && !defined(__MINGW32__)
+		printf
+		    ("    Pyramid levels successfully built for Section %I64d\n",
+		     section_id);
+#else
+		printf
+		    ("    Pyramid levels successfully built for Section %lld\n",
+		     section_id);
+#endif
+	    }
+      }
+    rl2_destroy_coverage (cvg);
+
+    return RL2_OK;
+
+  error:
+    if (cvg != NULL)
+	rl2_destroy_coverage (cvg);
+    return RL2_ERROR;
+}
+
+RL2_DECLARE int
+rl2_build_all_section_pyramids (sqlite3 * handle, int max_threads,
+				const char *coverage, int forced_rebuild,
+				int verbose)
+{
+/* (re)building section-level pyramids for a whole Coverage */
+    char *table;
+    char *xtable;
+    int ret;
+    sqlite3_stmt *stmt;
+    char *sql;
+
+    table = sqlite3_mprintf ("%s_sections", coverage);
+    xtable = rl2_double_quoted_sql (table);
+    sqlite3_free (table);
+    sql = sqlite3_mprintf ("SELECT section_id FROM main.\"%s\"", xtable);
+    free (xtable);
+    ret = sqlite3_prepare_v2 (handle, sql, strlen (sql), &stmt, NULL);
+    sqlite3_free (sql);
+    if (ret != SQLITE_OK)
+	goto error;
+    while (1)
+      {
+	  ret = sqlite3_step (stmt);
+	  if (ret == SQLITE_DONE)
+	      break;
+	  if (ret == SQLITE_ROW)
+	    {
+		sqlite3_int64 section_id = sqlite3_column_int64 (stmt, 0);
+		if (rl2_build_section_pyramid
+		    (handle, max_threads, coverage, section_id,
+		     forced_rebuild, verbose) != RL2_OK)
+		    goto error;
+	    }
+	  else
+	    {
+		fprintf (stderr,
+			 "SELECT section_id; sqlite3_step() error: %s\n",
+			 sqlite3_errmsg (handle));
+		goto error;
+	    }
+      }
+    sqlite3_finalize (stmt);
+    return RL2_OK;
+
+  error:
+    return RL2_ERROR;
+}
+
+static int
+is_full_mask (const unsigned char *mask, int mask_size)
+{
+/* testing for a completely transparent mask */
+    const unsigned char *p = mask;
+    int i;
+    int count = 0;
+    if (mask == NULL)
+	return 0;
+    for (i = 0; i < mask_size; i++)
+      {
+	  if (*p++ == 0)
+	      count++;
+      }
+    if (count == mask_size)
+	return 1;
+    return 0;
+}
+
+static rl2PixelPtr
+build_monolithic_no_data (unsigned char pixel_type, rl2PixelPtr no_data)
+{
+/* building the NO-DATA pixel of some Monolithic Pyramid tile */
+    rl2PixelPtr nd;
+    if (no_data == NULL)
+	return NULL;
+    if (pixel_type == RL2_PIXEL_MONOCHROME)
+      {
+	  rl2PrivPixelPtr pxl = (rl2PrivPixelPtr) no_data;
+	  rl2PrivSamplePtr sample = pxl->Samples + 0;
+	  nd = rl2_create_pixel (RL2_SAMPLE_UINT8, RL2_PIXEL_GRAYSCALE, 1);
+	  if (sample->uint8 == 0)
+	      rl2_set_pixel_sample_uint8 (nd, RL2_GRAYSCALE_BAND, 255);
+	  else
+	      rl2_set_pixel_sample_uint8 (nd, RL2_GRAYSCALE_BAND, 0);
+	  return nd;
+      }
+    if (pixel_type == RL2_PIXEL_PALETTE)
+      {
+	  nd = rl2_create_pixel (RL2_SAMPLE_UINT8, RL2_PIXEL_RGB, 3);
+	  rl2_set_pixel_sample_uint8 (nd, RL2_RED_BAND, 255);
+	  rl2_set_pixel_sample_uint8 (nd, RL2_GREEN_BAND, 255);
+	  rl2_set_pixel_sample_uint8 (nd, RL2_BLUE_BAND, 255);
+	  return nd;
+      }
+    return rl2_clone_pixel (no_data);
+}
+
+static int
+rescale_monolithic_tile (rl2AuxMonolithicTilePtr job)
+{
+/* rescaling and encoding a Monolithic Pyramid tile */
+    unsigned char *buffer = NULL;
+    int buf_size;
+    int sample_sz;
+    unsigned char *mask = NULL;
+    int mask_size;
+    rl2PixelPtr nd;
+    rl2RasterPtr raster = NULL;
+    unsigned char sample_type = job->sample_type;
+    unsigned char pixel_type = job->pixel_type;
+    unsigned char num_bands = job->num_bands;
+
+/* allocating output tile buffers */
+    switch (job->out_sample_type)
+      {
+      case RL2_SAMPLE_INT16:
+      case RL2_SAMPLE_UINT16:
+	  sample_sz = 2;
+	  break;
+      case RL2_SAMPLE_INT32:
+      case RL2_SAMPLE_UINT32:
+      case RL2_SAMPLE_FLOAT:
+	  sample_sz = 4;
+	  break;
+      case RL2_SAMPLE_DOUBLE:
+	  sample_sz = 8;
+	  break;
+      default:
+	  sample_sz = 1;
+	  break;
+      }
+    buf_size =
+	job->tile_width * job->tile_height * job->out_num_bands * sample_sz;
+    buffer = malloc (buf_size);
+    if (buffer == NULL)
+	goto error;
+    memset (buffer, 0, buf_size);
+    mask_size = job->tile_width * job->tile_height;
+    mask = malloc (mask_size);
+    if (mask == NULL)
+	goto error;
+    memset (mask, 0, mask_size);
+
+    if ((sample_type == RL2_SAMPLE_UINT8
+	 && pixel_type == RL2_PIXEL_GRAYSCALE && num_bands == 1)
+	|| (sample_type == RL2_SAMPLE_UINT8
+	    && pixel_type == RL2_PIXEL_RGB && num_bands == 3)
+	|| (sample_type == RL2_SAMPLE_UINT8
+	    && pixel_type == RL2_PIXEL_PALETTE && num_bands == 1))
+      {
+	  /* RGB, PALETTE or GRAYSCALE datasource (UINT8) */
+	  if (job->resampling == RL2_RESAMPLING_DEFAULT)
+	    {
+		if (!rescale_monolithic_rgba
+		    (job->bases, job->num_bases, job->tile_width,
+		     job->tile_height, job->factor, job->res_x, job->res_y,
+		     job->minx, job->miny, job->maxx, job->maxy, buffer,
+		     buf_size, mask, &mask_size, job->palette, job->no_data))
+		    goto error;
+	    }
+	  else
+	    {
+		if (!resample_monolithic_rgba
+		    (job->bases, job->num_bases, job->tile_width,
+		     job->tile_height, job->factor, job->resampling,
+		     job->res_x, job->res_y, job->minx, job->maxy, buffer,
+		     buf_size, mask, &mask_size, job->palette, job->no_data))
+		    goto error;
+	    }
+      }
+    else if (((sample_type == RL2_SAMPLE_1_BIT
+	       || sample_type == RL2_SAMPLE_2_BIT
+	       || sample_type == RL2_SAMPLE_4_BIT)
+	      && pixel_type == RL2_PIXEL_PALETTE && num_bands == 1)
+	     || (sample_type == RL2_SAMPLE_1_BIT
+		 && pixel_type == RL2_PIXEL_MONOCHROME && num_bands == 1))
+      {
+	  /* MONOCHROME and 1,2,4 bit PALETTE */
+	  if (!rescale_monolithic_124
+	      (job->bases, job->num_bases, job->tile_width, job->tile_height,
+	       job->factor, pixel_type, job->res_x, job->res_y, job->minx,
+	       job->miny, job->maxx, job->maxy, buffer, buf_size, mask,
+	       &mask_size, job->palette, job->no_data))
+	      goto error;
+      }
+    else if (pixel_type == RL2_PIXEL_MULTIBAND)
+      {
+	  /* MultiBand */
+	  if (!rescale_monolithic_multiband
+	      (job->bases, job->num_bases, job->tile_width, job->tile_height,
+	       sample_type, num_bands, job->factor, job->resampling,
+	       job->res_x, job->res_y, job->minx, job->miny, job->maxx,
+	       job->maxy, buffer, buf_size, mask, &mask_size, job->no_data))
+	      goto error;
+      }
+    else if (pixel_type == RL2_PIXEL_DATAGRID)
+      {
+	  /* DataGrid */
+	  if (!rescale_monolithic_datagrid
+	      (job->bases, job->num_bases, job->tile_width, job->tile_height,
+	       sample_type, job->factor, job->resampling, job->res_x,
+	       job->res_y, job->minx, job->miny, job->maxx, job->maxy, buffer,
+	       buf_size, mask, &mask_size, job->no_data))
+	      goto error;
+      }
+    else
+      {
+	  /* unknown */
+	  fprintf (stderr, "ERROR: unsupported Monolithic pyramid type\n");
+	  goto error;
+      }
+    if (mask_size == 0)
+	mask = NULL;		/* already freed by the rescaler */
+    if (is_full_mask (mask, mask_size))
+      {
+	  /* skipping a completely void tile */
+	  free (buffer);
+	  free (mask);
+	  job->void_tile = 1;
+	  return 1;
+      }
+
+    nd = build_monolithic_no_data (pixel_type, job->no_data);
+    raster =
+	rl2_create_raster (job->tile_width, job->tile_height,
+			   job->out_sample_type, job->out_pixel_type,
+			   job->out_num_bands, buffer, buf_size, NULL, mask,
+			   mask_size, nd);
+    buffer = NULL;
+    mask = NULL;
+    if (raster == NULL)
+      {
+	  fprintf (stderr, "ERROR: unable to create a Pyramid Tile\n");
+	  goto error;
+      }
+    if (rl2_raster_encode
+	(raster, job->out_compression, &(job->blob_odd), &(job->blob_odd_sz),
+	 &(job->blob_even), &(job->blob_even_sz), job->out_quality,
+	 1) != RL2_OK)
+      {
+	  fprintf (stderr, "ERROR: unable to encode a Pyramid tile\n");
+	  goto error;
+      }
+    rl2_destroy_raster (raster);
+    return 1;
+
+  error:
+    if (buffer != NULL)
+	free (buffer);
+    if (mask != NULL)
+	free (mask);
+    if (raster != NULL)
+	rl2_destroy_raster (raster);
+    return 0;
+}
+
+static void
+doRunMonolithicTileJob (void *arg)
+{
+/* Job function: rescaling and encoding a Monolithic Pyramid tile */
+    rl2AuxMonolithicTilePtr job = (rl2AuxMonolithicTilePtr) arg;
+    if (rescale_monolithic_tile (job))
+	job->retcode = RL2_OK;
+    else
+	job->retcode = RL2_ERROR;
+}
+
+static int
+do_fetch_monolithic_bases (sqlite3 * handle, sqlite3_stmt * stmt_geo,
+			   sqlite3_stmt * stmt_rd, rl2AuxMonolithicTilePtr job,
+			   int id_level)
+{
+/* reading the BLOBs of all base Tiles required by some Monolithic tile */
+    int ret;
+    rl2AuxPyramidBasePtr base;
+
+    job->num_bases = 0;
+    sqlite3_reset (stmt_geo);
+    sqlite3_clear_bindings (stmt_geo);
+    sqlite3_bind_int (stmt_geo, 1, id_level);
+    sqlite3_bind_double (stmt_geo, 2, job->minx);
+    sqlite3_bind_double (stmt_geo, 3, job->miny);
+    sqlite3_bind_double (stmt_geo, 4, job->maxx);
+    sqlite3_bind_double (stmt_geo, 5, job->maxy);
+    while (1)
+      {
+	  /* scrolling the result set rows */
+	  ret = sqlite3_step (stmt_geo);
+	  if (ret == SQLITE_DONE)
+	      break;		/* end of result set */
+	  if (ret != SQLITE_ROW)
+	    {
+		fprintf (stderr,
+			 "SELECT monolithic tiles; sqlite3_step() error: %s\n",
+			 sqlite3_errmsg (handle));
+		return 0;
+	    }
+	  if (!do_grow_pyramid_bases
+	      (&(job->bases), &(job->max_bases), job->num_bases + 1))
+	      return 0;
+	  base = job->bases + job->num_bases;
+	  base->tile_id = sqlite3_column_int64 (stmt_geo, 0);
+	  base->x = sqlite3_column_double (stmt_geo, 1);
+	  base->y = sqlite3_column_double (stmt_geo, 2);
+	  if (!do_fetch_pyramid_base (handle, stmt_rd, base))
+	      return 0;
+	  job->num_bases += 1;
+      }
+    return 1;
+}
+
+static int
+do_retire_monolithic_tile (sqlite3 * handle, rl2WorkerBatchPtr batch,
+			   rl2AuxMonolithicTilePtr job, int srid,
+			   sqlite3_stmt * stmt_tils, sqlite3_stmt * stmt_data)
+{
+/* 
+/ waiting until some Monolithic tile has been encoded, then INSERTing it
+/ (tiles are always retired in the same order they were submitted)
+*/
+    int ret;
+    rl2AuxMonolithicTilePtr done;
+    while (!job->done)
+      {
+	  done = rl2_next_completed_worker_job (batch);
+	  if (done == NULL)
+	      break;
+	  done->done = 1;
+      }
+    job->done = 0;
+    if (job->retcode != RL2_OK)
+	return 0;
+    if (job->void_tile)
+      {
+	  job->level->retired += 1;
+	  return 1;
+      }
+    ret =
+	do_insert_pyramid_tile (handle, job->blob_odd, job->blob_odd_sz,
+				job->blob_even, job->blob_even_sz,
+				job->level->id_level + 1, -1, srid, job->minx,
+				job->end_y, job->end_x, job->maxy, stmt_tils,
+				stmt_data);
+    /* the BLOBs have been passed to SQLite */
+    job->blob_odd = NULL;
+    job->blob_even = NULL;
+    if (ret)
+	job->level->retired += 1;
+    return ret;
+}
+
+static rl2AuxMonolithicLevelPtr
+prepare_monolithic_levels (rl2PrivCoveragePtr cov, unsigned int tileWidth,
+			   unsigned int tileHeight, double minx, double miny,
+			   double maxx, double maxy, int resize_factor,
+			   int *num_levels)
+{
+/* 
+/ pre-computing the grid of all Monolithic Pyramid levels
+/ each level is resize_factor times coarser than the previous one, and
+/ the last level is the one following the first level being wholly
+/ covered by a single column of tiles
+*/
+    rl2AuxMonolithicLevelPtr levels = NULL;
+    rl2AuxMonolithicLevelPtr items;
+    rl2AuxMonolithicLevelPtr lvl;
+    int count = 0;
+    int max = 0;
+    int factor = resize_factor;
+    int stop = 0;
+    double res_x;
+    double res_y;
+    double tile_minx;
+    double tile_maxy;
+
+    *num_levels = 0;
+    while (1)
+      {
+	  /* looping on pyramid levels */
+	  if (count == max)
+	    {
+		max = (max == 0) ? 16 : max * 2;
+		items = realloc (levels, sizeof (rl2AuxMonolithicLevel) * max);
+		if (items == NULL)
+		  {
+		      free (levels);
+		      return NULL;
+		  }
+		levels = items;
+	    }
+	  res_x = cov->hResolution * (double) factor;
+	  res_y = cov->vResolution * (double) factor;
+	  lvl = levels + count;
+	  lvl->id_level = count;
+	  lvl->factor = resize_factor;
+	  lvl->res_x = res_x;
+	  lvl->res_y = res_y;
+	  lvl->rows = 0;
+	  lvl->columns = 0;
+	  lvl->row = 0;
+	  lvl->col = 0;
+	  lvl->tile_minx = minx;
+	  lvl->tile_maxy = maxy;
+	  lvl->retired = 0;
+	  tile_maxy = maxy;
+	  while (tile_maxy >= miny)
+	    {
+		/* counting rows */
+		lvl->rows += 1;
+		tile_maxy -= ((double) tileHeight * res_y);
+	    }
+	  tile_minx = minx;
+	  while (tile_minx <= maxx)
+	    {
+		/* counting columns */
+		lvl->columns += 1;
+		tile_minx += ((double) tileWidth * res_x);
+	    }
+	  count++;
+	  if (stop)
+	      break;
+	  if ((minx +
+	       ((double) tileWidth * res_x) > maxx)
+	      && (maxy - ((double) tileHeight * res_y) < maxy))
+	      stop = 1;
+	  factor *= resize_factor;
+      }
+    *num_levels = count;
+    return levels;
+}
+
+static rl2AuxMonolithicLevelPtr
+do_pick_monolithic_level (rl2AuxMonolithicLevelPtr levels, int num_levels)
+{
+/* 
+/ picking the highest Monolithic level whose next tile could be submitted
+/ 
+/ a tile is ready as soon as all tiles of the level below overlapping
+/ (or just touching) its extent have been INSERTed; the tiles of each
+/ level are always retired in row-major order, so simply counting them
+/ is enough
+/ 
+/ returns NULL if no tile is ready
+*/
+    int i;
+    unsigned int dep_row;
+    unsigned int dep_col;
+    rl2AuxMonolithicLevelPtr lvl;
+    rl2AuxMonolithicLevelPtr below;
+    for (i = num_levels - 1; i >= 0; i--)
+      {
+	  lvl = levels + i;
+	  if (lvl->row >= lvl->rows)
+	      continue;		/* already completed */
+	  if (i == 0)
+	      return lvl;	/* the base level is always ready */
+	  below = levels + (i - 1);
+	  dep_row = (lvl->row + 1) * lvl->factor;
+	  if (dep_row >= below->rows)
+	      dep_row = below->rows - 1;
+	  dep_col = (lvl->col + 1) * lvl->factor;
+	  if (dep_col >= below->columns)
+	      dep_col = below->columns - 1;
+	  if (below->retired > (dep_row * below->columns) + dep_col)
+	      return lvl;
+      }
+    return NULL;
+}
+
+static void
+do_cleanup_monolithic_tiles (rl2AuxMonolithicTilePtr aux, int num_slots)
+{
+/* memory cleanup - destroying all Monolithic tile slots */
+    int i;
+    rl2AuxMonolithicTilePtr job;
+    if (aux == NULL)
+	return;
+    for (i = 0; i < num_slots; i++)
+      {
+	  job = aux + i;
+	  do_free_pyramid_bases (job->bases, job->max_bases);
+	  if (job->blob_odd != NULL)
+	      free (job->blob_odd);
+	  if (job->blob_even != NULL)
+	      free (job->blob_even);
+      }
+    free (aux);
+}
+
+static int
+do_clear_dirty_regions (sqlite3 * handle, const char *coverage)
+{
+/* resetting the DIRTY_REGIONS table of some Coverage */
+    int ret;
+    char *sql;
+    char *table;
+    char *xtable;
+    char *err_msg = NULL;
+
+    table = sqlite3_mprintf ("%s_dirty_regions", coverage);
+    xtable = rl2_double_quoted_sql (table);
+    sqlite3_free (table);
+    sql = sqlite3_mprintf ("DELETE FROM main.\"%s\"", xtable);
+    free (xtable);
+    ret = sqlite3_exec (handle, sql, NULL, NULL, &err_msg);
+    sqlite3_free (sql);
+    if (ret != SQLITE_OK)
+      {
+	  fprintf (stderr, "DELETE FROM \"%s_dirty_regions\" error: %s\n",
+		   coverage, err_msg);
+	  sqlite3_free (err_msg);
+	  return 0;
+      }
+    return 1;
+}
+
+static int
+load_dirty_regions (sqlite3 * handle, const char *coverage,
+		    double **regions, int *num_regions)
+{
+/* 
+/ loading all pending dirty regions (minx, miny, maxx, maxy) 
+/ returns 0 if the Coverage doesn't support dirty regions tracking
+*/
+    int ret;
+    char *sql;
+    char *table;
+    char *xtable;
+    sqlite3_stmt *stmt = NULL;
+    double *items = NULL;
+    double *p;
+    int count = 0;
+    int max = 0;
+
+    *regions = NULL;
+    *num_regions = 0;
+    table = sqlite3_mprintf ("%s_dirty_regions", coverage);
+    xtable = rl2_double_quoted_sql (table);
+    sqlite3_free (table);
+    sql =
+	sqlite3_mprintf ("SELECT minx, miny, maxx, maxy FROM main.\"%s\"",
+			 xtable);
+    free (xtable);
+    ret = sqlite3_prepare_v2 (handle, sql, strlen (sql), &stmt, NULL);
+    sqlite3_free (sql);
+    if (ret != SQLITE_OK)
+	return 0;
+    while (1)
+      {
+	  /* scrolling the result set rows */
+	  ret = sqlite3_step (stmt);
+	  if (ret == SQLITE_DONE)
+	      break;		/* end of result set */
+	  if (ret != SQLITE_ROW)
+	    {
+		fprintf (stderr,
+			 "SELECT dirty regions; sqlite3_step() error: %s\n",
+			 sqlite3_errmsg (handle));
+		goto error;
+	    }
+	  if (count == max)
+	    {
+		max = (max == 0) ? 64 : max * 2;
+		p = realloc (items, sizeof (double) * 4 * max);
+		if (p == NULL)
+		    goto error;
+		items = p;
+	    }
+	  p = items + (count * 4);
+	  *(p + 0) = sqlite3_column_double (stmt, 0);
+	  *(p + 1) = sqlite3_column_double (stmt, 1);
+	  *(p + 2) = sqlite3_column_double (stmt, 2);
+	  *(p + 3) = sqlite3_column_double (stmt, 3);
+	  count++;
+      }
+    sqlite3_finalize (stmt);
+    *regions = items;
+    *num_regions = count;
+    return 1;
+
+  error:
+    if (stmt != NULL)
+	sqlite3_finalize (stmt);
+    if (items != NULL)
+	free (items);
+    return 0;
+}
+
+static int
+get_monolithic_levels (sqlite3 * handle, const char *coverage,
+		       double **resolutions, int *num_levels)
+{
+/* 
+/ retrieving the resolutions (horz, vert) of all Monolithic Pyramid
+/ levels; item #0 is left free for the base level
+*/
+    int ret;
+    char *sql;
+    char *table;
+    char *xtable;
+    sqlite3_stmt *stmt = NULL;
+    double *items = NULL;
+    int max_level = 0;
+    int count = 0;
+
+    *resolutions = NULL;
+    *num_levels = 0;
+    table = sqlite3_mprintf ("%s_tiles", coverage);
+    xtable = rl2_double_quoted_sql (table);
+    sqlite3_free (table);
+    sql =
+	sqlite3_mprintf ("SELECT Max(pyramid_level) FROM main.\"%s\" "
+			 "WHERE pyramid_level > 0 AND section_id IS NULL",
+			 xtable);
+    free (xtable);
+    ret = sqlite3_prepare_v2 (handle, sql, strlen (sql), &stmt, NULL);
+    sqlite3_free (sql);
+    if (ret != SQLITE_OK)
+	goto error;
+    ret = sqlite3_step (stmt);
+    if (ret == SQLITE_ROW && sqlite3_column_type (stmt, 0) == SQLITE_INTEGER)
+	max_level = sqlite3_column_int (stmt, 0);
+    sqlite3_finalize (stmt);
+    stmt = NULL;
+    if (max_level <= 0)
+	return 1;		/* not a Monolithic Pyramid */
+
+    items = malloc (sizeof (double) * 2 * (max_level + 1));
+    if (items == NULL)
+	goto error;
+    table = sqlite3_mprintf ("%s_levels", coverage);
+    xtable = rl2_double_quoted_sql (table);
+    sqlite3_free (table);
+    sql =
+	sqlite3_mprintf ("SELECT pyramid_level, x_resolution_1_1, "
+			 "y_resolution_1_1 FROM main.\"%s\" WHERE "
+			 "pyramid_level BETWEEN 1 AND ? ORDER BY pyramid_level",
+			 xtable);
+    free (xtable);
+    ret = sqlite3_prepare_v2 (handle, sql, strlen (sql), &stmt, NULL);
+    sqlite3_free (sql);
+    if (ret != SQLITE_OK)
+	goto error;
+    sqlite3_bind_int (stmt, 1, max_level);
+    while (1)
+      {
+	  /* scrolling the result set rows */
+	  ret = sqlite3_step (stmt);
+	  if (ret == SQLITE_DONE)
+	      break;		/* end of result set */
+	  if (ret != SQLITE_ROW)
+	      goto error;
+	  count++;
+	  if (sqlite3_column_int (stmt, 0) != count)
+	      goto error;	/* not a contiguous sequence of levels */
+	  *(items + (count * 2)) = sqlite3_column_double (stmt, 1);
+	  *(items + (count * 2) + 1) = sqlite3_column_double (stmt, 2);
+      }
+    sqlite3_finalize (stmt);
+    if (count != max_level)
+      {
+	  free (items);
+	  return 0;
+      }
+    *resolutions = items;
+    *num_levels = max_level;
+    return 1;
+
+  error:
+    if (stmt != NULL)
+	sqlite3_finalize (stmt);
+    if (items != NULL)
+	free (items);
+    return 0;
+}
+
+static int
+check_monolithic_grid (sqlite3 * handle, const char *coverage, double minx,
+		       double maxy, double tile_ext_x, double tile_ext_y)
 {
-/* retrieving the background color for 1,2,4 bit samples */
-    sqlite3_stmt *stmt = NULL;
-    char *sql;
+/* 
+/ checking if the Monolithic Pyramid tiles are still aligned on the
+/ grid implied by the current Coverage's extent
+*/
     int ret;
-    rl2PrivPalettePtr plt;
-    rl2PalettePtr palette = NULL;
-    rl2PrivSamplePtr smp;
-    rl2PrivPixelPtr pxl;
-    rl2PrivCoveragePtr cvg = (rl2PrivCoveragePtr) coverage;
-    unsigned char index;
-    *bgRed = 255;
-    *bgGreen = 255;
-    *bgBlue = 255;
-
-    if (cvg == NULL)
-	return;
-    if (cvg->noData == NULL)
-	return;
-    pxl = (rl2PrivPixelPtr) (cvg->noData);
-    smp = pxl->Samples;
-    index = smp->uint8;
+    char *sql;
+    char *table;
+    char *xtable;
+    sqlite3_stmt *stmt = NULL;
+    double nx;
+    double ny;
+    int aligned = 0;
 
-    if (cvg->pixelType == RL2_PIXEL_MONOCHROME)
+    table = sqlite3_mprintf ("%s_tiles", coverage);
+    xtable = rl2_double_quoted_sql (table);
+    sqlite3_free (table);
+    sql =
+	sqlite3_mprintf ("SELECT MbrMinX(geometry), MbrMaxY(geometry) "
+			 "FROM main.\"%s\" WHERE pyramid_level = 1 AND "
+			 "section_id IS NULL LIMIT 1", xtable);
+    free (xtable);
+    ret = sqlite3_prepare_v2 (handle, sql, strlen (sql), &stmt, NULL);
+    sqlite3_free (sql);
+    if (ret != SQLITE_OK)
+	return 0;
+    ret = sqlite3_step (stmt);
+    if (ret == SQLITE_ROW)
       {
-	  if (index == 1)
+	  nx = (sqlite3_column_double (stmt, 0) - minx) / tile_ext_x;
+	  ny = (maxy - sqlite3_column_double (stmt, 1)) / tile_ext_y;
+	  if (nx > -0.000001 && ny > -0.000001)
 	    {
-		*bgRed = 0;
-		*bgGreen = 0;
-		*bgBlue = 0;
+		nx -= (double) ((long) (nx + 0.5));
+		ny -= (double) ((long) (ny + 0.5));
+		if (nx > -0.000001 && nx < 0.000001 && ny > -0.000001
+		    && ny < 0.000001)
+		    aligned = 1;
 	    }
-	  return;
       }
+    sqlite3_finalize (stmt);
+    return aligned;
+}
 
-/* Coverage's palette */
-    sql = sqlite3_mprintf ("SELECT palette FROM main.raster_coverages "
-			   "WHERE Lower(coverage_name) = Lower(%Q)",
-			   cvg->coverageName);
+static int
+delete_section_pyramid_tiles (sqlite3 * handle, const char *coverage)
+{
+/* deleting any Section Pyramid tile mixed to a Monolithic Pyramid */
+    int ret;
+    char *sql;
+    char *table;
+    char *xtable;
+    char *err_msg = NULL;
+
+    table = sqlite3_mprintf ("%s_tiles", coverage);
+    xtable = rl2_double_quoted_sql (table);
+    sqlite3_free (table);
+    sql =
+	sqlite3_mprintf ("DELETE FROM main.\"%s\" WHERE pyramid_level > 0 "
+			 "AND section_id IS NOT NULL", xtable);
+    free (xtable);
+    ret = sqlite3_exec (handle, sql, NULL, NULL, &err_msg);
+    sqlite3_free (sql);
+    if (ret != SQLITE_OK)
+      {
+	  fprintf (stderr, "DELETE FROM \"%s_tiles\" error: %s\n", coverage,
+		   err_msg);
+	  sqlite3_free (err_msg);
+	  return 0;
+      }
+    return 1;
+}
+
+static int
+prepare_monolithic_stmt_del (sqlite3 * handle, const char *coverage,
+			     sqlite3_stmt ** stmt_del)
+{
+/* preparing the SQL query deleting the Monolithic tile covering a point */
+    int ret;
+    char *sql;
+    char *xtiles;
+    char *xxtiles;
+    sqlite3_stmt *stmt;
+
+    *stmt_del = NULL;
+    xtiles = sqlite3_mprintf ("%s_tiles", coverage);
+    xxtiles = rl2_double_quoted_sql (xtiles);
+    sql =
+	sqlite3_mprintf
+	("DELETE FROM main.\"%s\" WHERE pyramid_level = ? AND "
+	 "section_id IS NULL AND ROWID IN (SELECT ROWID FROM SpatialIndex "
+	 "WHERE f_table_name = %Q AND search_frame = BuildMBR(?, ?, ?, ?))",
+	 xxtiles, xtiles);
+    sqlite3_free (xtiles);
+    free (xxtiles);
     ret = sqlite3_prepare_v2 (handle, sql, strlen (sql), &stmt, NULL);
     sqlite3_free (sql);
     if (ret != SQLITE_OK)
       {
-	  fprintf (stderr, "SQL error: %s\n%s\n", sql, sqlite3_errmsg (handle));
-	  goto error;
+	  printf ("DELETE monolithic tiles SQL error: %s\n",
+		  sqlite3_errmsg (handle));
+	  return 0;
+      }
+    *stmt_del = stmt;
+    return 1;
+}
+
+static int
+do_delete_monolithic_tile (sqlite3 * handle, sqlite3_stmt * stmt_del,
+			   int id_level, double x, double y)
+{
+/* deleting the Monolithic tile covering a given point */
+    int ret;
+    sqlite3_reset (stmt_del);
+    sqlite3_clear_bindings (stmt_del);
+    sqlite3_bind_int (stmt_del, 1, id_level);
+    sqlite3_bind_double (stmt_del, 2, x);
+    sqlite3_bind_double (stmt_del, 3, y);
+    sqlite3_bind_double (stmt_del, 4, x);
+    sqlite3_bind_double (stmt_del, 5, y);
+    ret = sqlite3_step (stmt_del);
+    if (ret == SQLITE_DONE || ret == SQLITE_ROW)
+	return 1;
+    fprintf (stderr, "DELETE monolithic tile; sqlite3_step() error: %s\n",
+	     sqlite3_errmsg (handle));
+    return 0;
+}
+
+static int
+mark_dirty_tiles (unsigned char *dirty, int num_cols, int num_rows,
+		  double minx, double maxy, double tile_ext_x,
+		  double tile_ext_y, const double *regions, int num_regions)
+{
+/* 
+/ marking all grid cells intersecting at least one dirty region 
+/ returns the number of marked cells
+*/
+    int ir;
+    int row;
+    int col;
+    int c0;
+    int c1;
+    int r0;
+    int r1;
+    int count = 0;
+    const double *p;
+
+    memset (dirty, 0, num_cols * num_rows);
+    for (ir = 0; ir < num_regions; ir++)
+      {
+	  p = regions + (ir * 4);
+	  c0 = (int) ((*(p + 0) - minx) / tile_ext_x);
+	  c1 = (int) ((*(p + 2) - minx) / tile_ext_x);
+	  r0 = (int) ((maxy - *(p + 3)) / tile_ext_y);
+	  r1 = (int) ((maxy - *(p + 1)) / tile_ext_y);
+	  if (*(p + 2) < minx || *(p + 1) > maxy)
+	      continue;		/* outside the grid */
+	  if (c0 < 0)
+	      c0 = 0;
+	  if (r0 < 0)
+	      r0 = 0;
+	  if (c1 >= num_cols)
+	      c1 = num_cols - 1;
+	  if (r1 >= num_rows)
+	      r1 = num_rows - 1;
+	  for (row = r0; row <= r1; row++)
+	    {
+		for (col = c0; col <= c1; col++)
+		  {
+		      unsigned char *cell = dirty + (row * num_cols) + col;
+		      if (*cell == 0)
+			  count++;
+		      *cell = 1;
+		  }
+	    }
       }
+    return count;
+}
+
+static int
+build_grid_edges (double origin, double limit, double step, int decreasing,
+		  double **edges, int *count)
+{
+/* 
+/ computing the tile edges of some Monolithic Pyramid level exactly in
+/ the same way rl2_build_monolithic_pyramid() does
+*/
+    double *items = NULL;
+    double *p;
+    int max = 0;
+    int n = 0;
+    double value = origin;
+
     while (1)
       {
-	  ret = sqlite3_step (stmt);
-	  if (ret == SQLITE_DONE)
-	      break;
-	  if (ret == SQLITE_ROW)
+	  if (n + 1 >= max)
 	    {
-		if (sqlite3_column_type (stmt, 0) == SQLITE_BLOB)
+		max = (max == 0) ? 64 : max * 2;
+		p = realloc (items, sizeof (double) * max);
+		if (p == NULL)
 		  {
-		      const unsigned char *blob = sqlite3_column_blob (stmt, 0);
-		      int blob_sz = sqlite3_column_bytes (stmt, 0);
-		      palette = rl2_deserialize_dbms_palette (blob, blob_sz);
+		      if (items != NULL)
+			  free (items);
+		      return 0;
 		  }
+		items = p;
+	    }
+	  *(items + n) = value;
+	  if (decreasing)
+	    {
+		if (value < limit)
+		    break;
+		value = value - step;
 	    }
 	  else
 	    {
-		fprintf (stderr,
-			 "SELECT section_info; sqlite3_step() error: %s\n",
-			 sqlite3_errmsg (handle));
-		goto error;
+		if (value > limit)
+		    break;
+		value = value + step;
 	    }
+	  n++;
       }
-    sqlite3_finalize (stmt);
-    if (palette == NULL)
-	goto error;
+    *edges = items;
+    *count = n;
+    return 1;
+}
 
-    plt = (rl2PrivPalettePtr) palette;
-    if (index < plt->nEntries)
+static int
+prepare_monolithic_stmt_geo (sqlite3 * handle, const char *coverage,
+			     sqlite3_stmt ** stmt_geo)
+{
+/* preparing the SQL query searching the base tiles of Monolithic tiles */
+    int ret;
+    char *sql;
+    char *xtiles;
+    char *xxtiles;
+    sqlite3_stmt *stmt;
+
+    *stmt_geo = NULL;
+    xtiles = sqlite3_mprintf ("%s_tiles", coverage);
+    xxtiles = rl2_double_quoted_sql (xtiles);
+    sql =
+	sqlite3_mprintf
+	("SELECT tile_id, MbrMinX(geometry), MbrMaxY(geometry) FROM main.\"%s\" "
+	 "WHERE pyramid_level = ? AND ROWID IN (SELECT ROWID FROM SpatialIndex "
+	 "WHERE f_table_name = %Q AND search_frame = BuildMBR(?, ?, ?, ?)) "
+	 "ORDER BY ST_Area(geometry)", xxtiles, xtiles);
+    sqlite3_free (xtiles);
+    free (xxtiles);
+    ret = sqlite3_prepare_v2 (handle, sql, strlen (sql), &stmt, NULL);
+    sqlite3_free (sql);
+    if (ret != SQLITE_OK)
       {
-	  rl2PrivPaletteEntryPtr rgb = plt->entries + index;
-	  *bgRed = rgb->red;
-	  *bgGreen = rgb->green;
-	  *bgBlue = rgb->blue;
+	  printf ("SELECT monolithic RGBA tiles SQL error: %s\n",
+		  sqlite3_errmsg (handle));
+	  return 0;
       }
-    rl2_destroy_palette (palette);
-    return;
-
-  error:
-    if (stmt != NULL)
-	sqlite3_finalize (stmt);
-    if (palette != NULL)
-	rl2_destroy_palette (palette);
+    *stmt_geo = stmt;
+    return 1;
 }
 
-RL2_DECLARE int
-rl2_build_section_pyramid (sqlite3 * handle, int max_threads,
-			   const char *coverage, sqlite3_int64 section_id,
-			   int forced_rebuild, int verbose)
+static int
+prepare_monolithic_model (rl2CoveragePtr cvg, rl2AuxMonolithicTilePtr model,
+			  int *single_level)
 {
-/* (re)building section-level pyramid for a single Section */
-    rl2CoveragePtr cvg = NULL;
-    rl2PrivCoveragePtr ptrcvg;
+/* 
+/ initializing the model of all Monolithic tiles from the Coverage
+/ (single_level is set when the output colorspace forbids virt-levels)
+*/
     unsigned char sample_type;
     unsigned char pixel_type;
     unsigned char num_bands;
@@ -6019,622 +6589,677 @@ rl2_build_section_pyramid (sqlite3 * handle, int max_threads,
     int quality;
     unsigned int tileWidth;
     unsigned int tileHeight;
+
+    *single_level = 0;
+    if (rl2_get_coverage_type (cvg, &sample_type, &pixel_type, &num_bands) !=
+	RL2_OK)
+	return 0;
+    if (rl2_get_coverage_compression (cvg, &compression, &quality) != RL2_OK)
+	return 0;
+    if (rl2_get_coverage_tile_size (cvg, &tileWidth, &tileHeight) != RL2_OK)
+	return 0;
+    model->tile_width = tileWidth;
+    model->tile_height = tileHeight;
+    model->sample_type = sample_type;
+    model->pixel_type = pixel_type;
+    model->num_bands = num_bands;
+    model->no_data = rl2_get_coverage_no_data (cvg);
+    if (rl2_get_coverage_resampling (cvg, &(model->resampling)) != RL2_OK)
+	return 0;
+    if (pixel_type == RL2_PIXEL_PALETTE || pixel_type == RL2_PIXEL_MONOCHROME)
+      {
+	  /* Palette and Monochrome Pyramids are always rescaled by Cairo */
+	  model->resampling = RL2_RESAMPLING_DEFAULT;
+      }
+
+    if (sample_type == RL2_SAMPLE_1_BIT
+	&& pixel_type == RL2_PIXEL_MONOCHROME && num_bands == 1)
+      {
+	  /* monochrome: output colorspace is Grayscale compression PNG */
+	  model->out_sample_type = RL2_SAMPLE_UINT8;
+	  model->out_pixel_type = RL2_PIXEL_GRAYSCALE;
+	  model->out_num_bands = 1;
+	  model->out_compression = RL2_COMPRESSION_PNG;
+	  model->out_quality = 100;
+	  *single_level = 1;
+      }
+    else if ((sample_type == RL2_SAMPLE_1_BIT
+	      && pixel_type == RL2_PIXEL_PALETTE && num_bands == 1)
+	     || (sample_type == RL2_SAMPLE_2_BIT
+		 && pixel_type == RL2_PIXEL_PALETTE && num_bands == 1)
+	     || (sample_type == RL2_SAMPLE_4_BIT))
+      {
+	  /* palette 1,2,4: output colorspace is RGB compression PNG */
+	  model->out_sample_type = RL2_SAMPLE_UINT8;
+	  model->out_pixel_type = RL2_PIXEL_RGB;
+	  model->out_num_bands = 3;
+	  model->out_compression = RL2_COMPRESSION_PNG;
+	  model->out_quality = 100;
+	  *single_level = 1;
+      }
+    else if (sample_type == RL2_SAMPLE_UINT8
+	     && pixel_type == RL2_PIXEL_PALETTE && num_bands == 1)
+      {
+	  /* palette 8: output colorspace is RGB compression PNG */
+	  model->out_sample_type = RL2_SAMPLE_UINT8;
+	  model->out_pixel_type = RL2_PIXEL_RGB;
+	  model->out_num_bands = 3;
+	  model->out_compression = RL2_COMPRESSION_PNG;
+	  model->out_quality = 100;
+      }
+    else
+      {
+	  /* unaltered output colorspace */
+	  model->out_sample_type = sample_type;
+	  model->out_pixel_type = pixel_type;
+	  model->out_num_bands = num_bands;
+	  model->out_compression = compression;
+	  model->out_quality = quality;
+      }
+    return 1;
+}
+
+static rl2AuxMonolithicTilePtr
+create_monolithic_tiles (rl2AuxMonolithicTilePtr model, int num_slots)
+{
+/* allocating and initializing the Monolithic tile slots */
+    int iaux;
+    rl2AuxMonolithicTilePtr job;
+    rl2AuxMonolithicTilePtr aux =
+	malloc (sizeof (rl2AuxMonolithicTile) * num_slots);
+    if (aux == NULL)
+	return NULL;
+    for (iaux = 0; iaux < num_slots; iaux++)
+      {
+	  /* initializing an empty slot */
+	  job = aux + iaux;
+	  job->level = NULL;
+	  job->tile_width = model->tile_width;
+	  job->tile_height = model->tile_height;
+	  job->sample_type = model->sample_type;
+	  job->pixel_type = model->pixel_type;
+	  job->num_bands = model->num_bands;
+	  job->out_sample_type = model->out_sample_type;
+	  job->out_pixel_type = model->out_pixel_type;
+	  job->out_num_bands = model->out_num_bands;
+	  job->out_compression = model->out_compression;
+	  job->out_quality = model->out_quality;
+	  job->resampling = model->resampling;
+	  job->no_data = model->no_data;
+	  job->palette = NULL;
+	  job->num_bases = 0;
+	  job->max_bases = 0;
+	  job->bases = NULL;
+	  job->blob_odd = NULL;
+	  job->blob_even = NULL;
+	  job->blob_odd_sz = 0;
+	  job->blob_even_sz = 0;
+	  job->void_tile = 0;
+	  job->done = 0;
+	  job->retcode = RL2_OK;
+      }
+    return aux;
+}
+
+RL2_DECLARE int
+rl2_build_monolithic_pyramid_ex (sqlite3 * handle, int max_threads,
+				 const char *coverage, int virt_levels,
+				 int verbose)
+{
+/* 
+/ (re)building monolithic pyramid for a whole coverage - may be by
+/ using concurrent multithreading
+/ 
+/ decoding, rescaling and encoding are the only tasks delegated to the
+/ worker threads; the base Tiles are read and the Pyramid tiles are
+/ INSERTed by the calling thread alone, because the tiles of the levels
+/ being built are still uncommitted and thus invisible to any other
+/ connection
+/ 
+/ the levels are not built one after the other: a tile of level N+1 is
+/ submitted as soon as all the tiles of level N it depends on have been
+/ INSERTed, so that the worker threads never run idle between levels
+*/
+    rl2CoveragePtr cvg = NULL;
+    rl2PrivCoveragePtr cov;
+    unsigned int tileWidth;
+    unsigned int tileHeight;
     int srid;
-    int build = 0;
-    unsigned char bgRed;
-    unsigned char bgGreen;
-    unsigned char bgBlue;
+    double minx;
+    double miny;
+    double maxx;
+    double maxy;
+    int resize_factor;
+    rl2PalettePtr palette = NULL;
+    rl2AuxMonolithicTile model;
+    int single_level;
+    rl2AuxMonolithicLevelPtr levels = NULL;
+    rl2AuxMonolithicLevelPtr lvl;
+    int num_levels = 0;
+    int il;
+    rl2AuxMonolithicTilePtr aux = NULL;
+    rl2AuxMonolithicTilePtr job;
+    rl2WorkerBatchPtr batch = NULL;
+    int num_slots = 0;
+    int head = 0;
+    int busy = 0;
+    sqlite3_stmt *stmt_geo = NULL;
+    sqlite3_stmt *stmt_rd = NULL;
+    sqlite3_stmt *stmt_levl = NULL;
+    sqlite3_stmt *stmt_tils = NULL;
+    sqlite3_stmt *stmt_data = NULL;
+    double tile_miny;
+    double tile_maxx;
+    double end_x;
+    double end_y;
+
+/* preparing the "tiles" SQL query */
+    if (!prepare_monolithic_stmt_geo (handle, coverage, &stmt_geo))
+	goto error;
 
     cvg = rl2_create_coverage_from_dbms (handle, NULL, coverage);
     if (cvg == NULL)
 	goto error;
+    cov = (rl2PrivCoveragePtr) cvg;
+    if (cov->mixedResolutions)
+      {
+	  fprintf (stderr,
+		   "MixedResolutions forbids a Monolithic Pyramid on \"%s\"\n",
+		   cov->coverageName);
+	  goto error;
+      }
 
-    if (rl2_get_coverage_type (cvg, &sample_type, &pixel_type, &num_bands) !=
-	RL2_OK)
-	goto error;
-    if (rl2_get_coverage_compression (cvg, &compression, &quality) != RL2_OK)
-	goto error;
     if (rl2_get_coverage_tile_size (cvg, &tileWidth, &tileHeight) != RL2_OK)
 	goto error;
     if (rl2_get_coverage_srid (cvg, &srid) != RL2_OK)
 	goto error;
-    ptrcvg = (rl2PrivCoveragePtr) cvg;
+    if (!get_coverage_extent (handle, coverage, &minx, &miny, &maxx, &maxy))
+	goto error;
+    palette = rl2_get_dbms_palette (handle, NULL, coverage);
+    if (!prepare_section_pyramid_stmts
+	(handle, coverage, 0, &stmt_rd, &stmt_levl, &stmt_tils, &stmt_data))
+	goto error;
 
-    if (!forced_rebuild)
+    if (!prepare_monolithic_model (cvg, &model, &single_level))
+	goto error;
+    if (single_level)
+	virt_levels = 1;
+
+    /* setting the requested virt_levels */
+    switch (virt_levels)
       {
-	  /* checking if the section pyramid already exists */
-	  build = check_section_pyramid (handle, coverage, section_id);
-      }
-    else
+      case 1:			/* separating each physical level */
+	  resize_factor = 2;
+	  break;
+      case 2:			/* one physical + one virtual */
+	  resize_factor = 4;
+	  break;
+      case 3:			/* one physical + two virtuals */
+	  resize_factor = 8;
+	  break;
+      default:
+	  resize_factor = 8;
+	  break;
+      };
+    levels =
+	prepare_monolithic_levels (cov, tileWidth, tileHeight, minx, miny,
+				   maxx, maxy, resize_factor, &num_levels);
+    if (levels == NULL)
+	goto error;
+
+/* 
+/ allocating the Monolithic tile slots
+/ when multithreading twice as many slots as threads are allocated, so
+/ that further base tiles can be read while the previous Pyramid tiles
+/ are still being encoded
+*/
+    if (max_threads < 1)
+	max_threads = 1;
+    if (max_threads > 64)
+	max_threads = 64;
+    num_slots = (max_threads > 1) ? max_threads * 2 : 1;
+    aux = create_monolithic_tiles (&model, num_slots);
+    if (aux == NULL)
+	goto error;
+    if (max_threads > 1)
       {
-	  /* unconditional rebuilding */
-	  build = 1;
+	  /* preparing a Batch of concurrent Jobs */
+	  batch = rl2_create_worker_batch (max_threads);
+	  if (batch == NULL)
+	      goto error;
       }
 
-    if (build)
+/* attempting to delete the section pyramid */
+    if (rl2_delete_all_pyramids (handle, coverage) != RL2_OK)
+	goto error;
+
+/* attempting to (re)build the section pyramid */
+    for (il = 0; il < num_levels; il++)
       {
-	  /* attempting to delete the section pyramid */
-	  if (!delete_section_pyramid (handle, coverage, section_id))
+	  /* registering all pyramid levels */
+	  lvl = levels + il;
+	  if (!do_insert_pyramid_levels
+	      (handle, lvl->id_level + 1, lvl->res_x, lvl->res_y, stmt_levl))
 	      goto error;
-	  /* attempting to (re)build the section pyramid */
-	  if ((sample_type == RL2_SAMPLE_1_BIT
-	       && pixel_type == RL2_PIXEL_MONOCHROME && num_bands == 1)
-	      || (sample_type == RL2_SAMPLE_1_BIT
-		  && pixel_type == RL2_PIXEL_PALETTE && num_bands == 1)
-	      || (sample_type == RL2_SAMPLE_2_BIT
-		  && pixel_type == RL2_PIXEL_PALETTE && num_bands == 1)
-	      || (sample_type == RL2_SAMPLE_4_BIT
-		  && pixel_type == RL2_PIXEL_PALETTE && num_bands == 1))
+      }
+    while (1)
+      {
+	  /* looping on tiles, whatever is their level */
+	  lvl = do_pick_monolithic_level (levels, num_levels);
+	  if (lvl == NULL || busy == num_slots)
 	    {
-		/* special case: 1,2,4 bit Pyramid */
-		get_background_color (handle, cvg, &bgRed, &bgGreen, &bgBlue);
-		if (!do_build_124_bit_section_pyramid
-		    (handle, max_threads, coverage, ptrcvg->mixedResolutions,
-		     section_id, sample_type, pixel_type, num_bands, srid,
-		     tileWidth, tileHeight, bgRed, bgGreen, bgBlue))
+		if (busy == 0)
+		  {
+		      if (lvl == NULL)
+			  break;	/* all levels have been completed */
+		      goto error;
+		  }
+		/* 
+		/ retiring the oldest tile; some further tile of the
+		/ level above could become ready
+		*/
+		if (!do_retire_monolithic_tile
+		    (handle, batch, aux + head, srid, stmt_tils, stmt_data))
 		    goto error;
+		head = (head + 1) % num_slots;
+		busy--;
+		continue;
 	    }
-	  else if (sample_type == RL2_SAMPLE_UINT8
-		   && pixel_type == RL2_PIXEL_PALETTE && num_bands == 1)
+	  tile_miny = lvl->tile_maxy - ((double) tileHeight * lvl->res_y);
+	  tile_maxx = lvl->tile_minx + ((double) tileWidth * lvl->res_x);
+	  end_x = tile_maxx;
+	  if (tile_maxx > maxx)
+	      end_x = maxx;
+	  end_y = tile_miny;
+	  if (tile_miny < miny)
+	      end_y = miny;
+	  job = aux + ((head + busy) % num_slots);
+	  job->level = lvl;
+	  job->factor = lvl->factor;
+	  job->res_x = lvl->res_x;
+	  job->res_y = lvl->res_y;
+	  /* an eventual Palette only applies to the first level */
+	  job->palette = (lvl->id_level == 0) ? palette : NULL;
+	  job->minx = lvl->tile_minx;
+	  job->miny = tile_miny;
+	  job->maxx = tile_maxx;
+	  job->maxy = lvl->tile_maxy;
+	  job->end_x = end_x;
+	  job->end_y = end_y;
+	  job->void_tile = 0;
+	  job->retcode = RL2_ERROR;
+	  busy++;
+	  if (!do_fetch_monolithic_bases
+	      (handle, stmt_geo, stmt_rd, job, lvl->id_level))
+	      goto error;
+	  if (max_threads > 1)
 	    {
-		/* special case: 8 bit Palette Pyramid */
-		get_background_color (handle, cvg, &bgRed, &bgGreen, &bgBlue);
-		if (!do_build_palette_section_pyramid
-		    (handle, max_threads, coverage, ptrcvg->mixedResolutions,
-		     section_id, srid, tileWidth, tileHeight, bgRed, bgGreen,
-		     bgBlue))
-		    goto error;
+		/* adopting a multithreaded strategy */
+		rl2_submit_worker_job (batch, doRunMonolithicTileJob, job);
 	    }
 	  else
 	    {
-		/* ordinary RGB, Grayscale, MultiBand or DataGrid Pyramid */
-		if (!do_build_section_pyramid
-		    (handle, coverage, section_id, sample_type, pixel_type,
-		     num_bands, compression, ptrcvg->mixedResolutions,
-		     quality, srid, tileWidth, tileHeight))
-		    goto error;
+		/* single thread execution */
+		doRunMonolithicTileJob (job);
+		job->done = 1;
 	    }
-	  if (verbose)
+
+	  /* moving to the next tile of the same level */
+	  lvl->tile_minx = tile_maxx;
+	  lvl->col += 1;
+	  if (lvl->col >= lvl->columns)
 	    {
-		printf ("  ----------\n");
-#if defined(_WIN32) && !defined(__MINGW32__)
-		printf
-		    ("    Pyramid levels successfully built for Section %I64d\n",
-		     section_id);
-#else
-		printf
-		    ("    Pyramid levels successfully built for Section %lld\n",
-		     section_id);
-#endif
+		lvl->tile_minx = minx;
+		lvl->tile_maxy = tile_miny;
+		lvl->col = 0;
+		lvl->row += 1;
+		if (verbose)
+		  {
+		      printf ("  ----------\n");
+		      printf
+			  ("    %s: Monolithic Pyramid Level %d - Row %d of %d  successfully built\n",
+			   coverage, lvl->id_level + 1, lvl->row, lvl->rows);
+		  }
 	    }
       }
+/* from now on any change to the Sections will be tracked */
+    if (!rl2_enable_dirty_regions (handle, coverage))
+	goto error;
+    if (!do_clear_dirty_regions (handle, coverage))
+	goto error;
+    rl2_destroy_worker_batch (batch);
+    do_cleanup_monolithic_tiles (aux, num_slots);
+    free (levels);
+    sqlite3_finalize (stmt_geo);
+    sqlite3_finalize (stmt_rd);
+    sqlite3_finalize (stmt_levl);
+    sqlite3_finalize (stmt_tils);
+    sqlite3_finalize (stmt_data);
+    if (verbose)
+      {
+	  printf ("  ----------\n");
+	  printf
+	      ("    Monolithic Pyramid levels successfully built for: %s\n",
+	       coverage);
+      }
     rl2_destroy_coverage (cvg);
+    if (palette != NULL)
+	rl2_destroy_palette (palette);
 
     return RL2_OK;
 
   error:
+    /* waiting for any pending Job before releasing the slots */
+    rl2_destroy_worker_batch (batch);
+    do_cleanup_monolithic_tiles (aux, num_slots);
+    if (levels != NULL)
+	free (levels);
+    if (stmt_geo != NULL)
+	sqlite3_finalize (stmt_geo);
+    if (stmt_rd != NULL)
+	sqlite3_finalize (stmt_rd);
+    if (stmt_levl != NULL)
+	sqlite3_finalize (stmt_levl);
+    if (stmt_tils != NULL)
+	sqlite3_finalize (stmt_tils);
+    if (stmt_data != NULL)
+	sqlite3_finalize (stmt_data);
     if (cvg != NULL)
 	rl2_destroy_coverage (cvg);
+    if (palette != NULL)
+	rl2_destroy_palette (palette);
     return RL2_ERROR;
 }
 
 RL2_DECLARE int
-rl2_build_all_section_pyramids (sqlite3 * handle, int max_threads,
-				const char *coverage, int forced_rebuild,
-				int verbose)
-{
-/* (re)building section-level pyramids for a whole Coverage */
-    char *table;
-    char *xtable;
-    int ret;
-    sqlite3_stmt *stmt;
-    char *sql;
-
-    table = sqlite3_mprintf ("%s_sections", coverage);
-    xtable = rl2_double_quoted_sql (table);
-    sqlite3_free (table);
-    sql = sqlite3_mprintf ("SELECT section_id FROM main.\"%s\"", xtable);
-    free (xtable);
-    ret = sqlite3_prepare_v2 (handle, sql, strlen (sql), &stmt, NULL);
-    sqlite3_free (sql);
-    if (ret != SQLITE_OK)
-	goto error;
-    while (1)
-      {
-	  ret = sqlite3_step (stmt);
-	  if (ret == SQLITE_DONE)
-	      break;
-	  if (ret == SQLITE_ROW)
-	    {
-		sqlite3_int64 section_id = sqlite3_column_int64 (stmt, 0);
-		if (rl2_build_section_pyramid
-		    (handle, max_threads, coverage, section_id,
-		     forced_rebuild, verbose) != RL2_OK)
-		    goto error;
-	    }
-	  else
-	    {
-		fprintf (stderr,
-			 "SELECT section_id; sqlite3_step() error: %s\n",
-			 sqlite3_errmsg (handle));
-		goto error;
-	    }
-      }
-    sqlite3_finalize (stmt);
-    return RL2_OK;
-
-  error:
-    return RL2_ERROR;
-}
-
-static int
-is_full_mask (const unsigned char *mask, int mask_size)
+rl2_build_monolithic_pyramid (sqlite3 * handle, const char *coverage,
+			      int virt_levels, int verbose)
 {
-/* testing for a completely transparent mask */
-    const unsigned char *p = mask;
-    int i;
-    int count = 0;
-    if (mask == NULL)
-	return 0;
-    for (i = 0; i < mask_size; i++)
-      {
-	  if (*p++ == 0)
-	      count++;
-      }
-    if (count == mask_size)
-	return 1;
-    return 0;
+/* (re)building monolithic pyramid for a whole coverage - single thread */
+    return rl2_build_monolithic_pyramid_ex (handle, 1, coverage, virt_levels,
+					    verbose);
 }
 
 RL2_DECLARE int
-rl2_build_monolithic_pyramid (sqlite3 * handle, const char *coverage,
-			      int virt_levels, int verbose)
+rl2_build_incremental_pyramid (sqlite3 * handle, int max_threads,
+			       const char *coverage, int verbose)
 {
-/* (re)building monolithic pyramid for a whole coverage */
+/* 
+/ updating the pyramid of a whole coverage by only rebuilding the tiles
+/ affected by the Sections INSERTed or DELETEd since the last update
+/ 
+/ Section pyramids: all missing Section pyramids will be built
+/ Monolithic pyramid: all tiles intersecting a dirty region will be
+/ rebuilt, level after level; a complete rebuild is performed when
+/ the Coverage's grid has changed or no dirty region is being tracked
+*/
     rl2CoveragePtr cvg = NULL;
     rl2PrivCoveragePtr cov;
-    unsigned char sample_type;
-    unsigned char pixel_type;
-    unsigned char num_bands;
-    unsigned char compression;
-    int quality;
-    unsigned int tileWidth;
-    unsigned int tileHeight;
     int srid;
     double minx;
     double miny;
     double maxx;
     double maxy;
-    unsigned int row;
-    unsigned int col;
-    unsigned int tot_rows;
+    unsigned int tileWidth;
+    unsigned int tileHeight;
+    double *regions = NULL;
+    int num_regions = 0;
+    double *resolutions = NULL;
+    int num_levels = 0;
+    double *xs = NULL;
+    double *ys = NULL;
+    int num_cols;
+    int num_rows;
+    unsigned char *dirty = NULL;
+    int num_dirty;
+    int id_level;
+    int row;
+    int col;
+    int ir;
+    double *p;
     double res_x;
     double res_y;
+    int virt_levels;
     int factor;
-    int resize_factor;
-    int id_level = 0;
-    unsigned char out_sample_type;
-    unsigned char out_pixel_type;
-    unsigned char out_num_bands;
-    unsigned char out_compression;
-    int out_quality;
-    rl2PixelPtr no_data = NULL;
-    rl2PixelPtr nd = NULL;
-    rl2PalettePtr palette = NULL;
-    unsigned char *buffer = NULL;
-    int buf_size;
-    int sample_sz;
-    unsigned char *mask = NULL;
-    int mask_size;
-    rl2RasterPtr raster = NULL;
-    unsigned char *blob_odd = NULL;
-    unsigned char *blob_even = NULL;
-    int blob_odd_sz;
-    int blob_even_sz;
+    rl2PalettePtr palette = NULL;
+    rl2AuxMonolithicTile model;
+    rl2AuxMonolithicLevel level;
+    int single_level;
+    rl2AuxMonolithicTilePtr aux = NULL;
+    rl2AuxMonolithicTilePtr job;
+    rl2WorkerBatchPtr batch = NULL;
+    int num_slots = 0;
+    int head = 0;
+    int busy = 0;
     sqlite3_stmt *stmt_geo = NULL;
+    sqlite3_stmt *stmt_del = NULL;
     sqlite3_stmt *stmt_rd = NULL;
     sqlite3_stmt *stmt_levl = NULL;
     sqlite3_stmt *stmt_tils = NULL;
     sqlite3_stmt *stmt_data = NULL;
-    char *xtiles;
-    char *xxtiles;
-    int ret;
-    char *sql;
-    double tile_minx;
-    double tile_miny;
-    double tile_maxx;
-    double tile_maxy;
-    double end_x;
-    double end_y;
-    int stop = 0;
-
-/* preparing the "tiles" SQL query */
-    xtiles = sqlite3_mprintf ("%s_tiles", coverage);
-    xxtiles = rl2_double_quoted_sql (xtiles);
-    sql =
-	sqlite3_mprintf
-	("SELECT tile_id, MbrMinX(geometry), MbrMaxY(geometry) FROM main.\"%s\" "
-	 "WHERE pyramid_level = ? AND ROWID IN (SELECT ROWID FROM SpatialIndex "
-	 "WHERE f_table_name = %Q AND search_frame = BuildMBR(?, ?, ?, ?)) "
-	 "ORDER BY ST_Area(geometry)", xxtiles, xtiles);
-    sqlite3_free (xtiles);
-    free (xxtiles);
-    ret = sqlite3_prepare_v2 (handle, sql, strlen (sql), &stmt_geo, NULL);
-    sqlite3_free (sql);
-    if (ret != SQLITE_OK)
-      {
-	  printf ("SELECT monolithic RGBA tiles SQL error: %s\n",
-		  sqlite3_errmsg (handle));
-	  goto error;
-      }
 
     cvg = rl2_create_coverage_from_dbms (handle, NULL, coverage);
     if (cvg == NULL)
 	goto error;
     cov = (rl2PrivCoveragePtr) cvg;
-    if (cov->mixedResolutions)
+    if (!cov->mixedResolutions)
       {
-	  fprintf (stderr,
-		   "MixedResolutions forbids a Monolithic Pyramid on \"%s\"\n",
-		   cov->coverageName);
-	  goto error;
+	  if (!get_monolithic_levels
+	      (handle, coverage, &resolutions, &num_levels))
+	    {
+		/* unable to figure out the Monolithic levels: full rebuild */
+		rl2_destroy_coverage (cvg);
+		return rl2_build_monolithic_pyramid_ex (handle, max_threads,
+							coverage, 3, verbose);
+	    }
+      }
+    if (num_levels <= 0)
+      {
+	  /* Section pyramids: building all missing ones */
+	  rl2_destroy_coverage (cvg);
+	  return rl2_build_all_section_pyramids (handle, max_threads,
+						 coverage, 0, verbose);
       }
 
-    if (rl2_get_coverage_type (cvg, &sample_type, &pixel_type, &num_bands) !=
-	RL2_OK)
-	goto error;
-    if (rl2_get_coverage_compression (cvg, &compression, &quality) != RL2_OK)
+    /* Monolithic pyramid */
+    if (rl2_get_coverage_srid (cvg, &srid) != RL2_OK)
 	goto error;
     if (rl2_get_coverage_tile_size (cvg, &tileWidth, &tileHeight) != RL2_OK)
 	goto error;
-    if (rl2_get_coverage_srid (cvg, &srid) != RL2_OK)
-	goto error;
     if (!get_coverage_extent (handle, coverage, &minx, &miny, &maxx, &maxy))
 	goto error;
-    no_data = rl2_get_coverage_no_data (cvg);
-    palette = rl2_get_dbms_palette (handle, NULL, coverage);
+    *(resolutions + 0) = cov->hResolution;
+    *(resolutions + 1) = cov->vResolution;
+    factor = (int) ((*(resolutions + 2) / cov->hResolution) + 0.5);
+    if (factor <= 2)
+	virt_levels = 1;
+    else if (factor <= 4)
+	virt_levels = 2;
+    else
+	virt_levels = 3;
+    res_x = *(resolutions + (num_levels * 2));
+    if (!load_dirty_regions (handle, coverage, &regions, &num_regions)
+	|| !check_monolithic_grid (handle, coverage, minx, maxy,
+				   (double) tileWidth * *(resolutions + 2),
+				   (double) tileHeight * *(resolutions + 3))
+	|| minx + ((double) tileWidth * res_x) <= maxx)
+      {
+	  /* the current Pyramid can't be updated: full rebuild */
+	  if (verbose)
+	      printf ("  Monolithic Pyramid for %s: complete rebuild\n",
+		      coverage);
+	  if (regions != NULL)
+	      free (regions);
+	  free (resolutions);
+	  rl2_destroy_coverage (cvg);
+	  return rl2_build_monolithic_pyramid_ex (handle, max_threads,
+						  coverage, virt_levels,
+						  verbose);
+      }
+
+/* any Section pyramid tile would be a spurious input */
+    if (!delete_section_pyramid_tiles (handle, coverage))
+	goto error;
+    if (num_regions == 0)
+	goto done;
+    for (ir = 0; ir < num_regions; ir++)
+      {
+	  /* 
+	  / expanding each dirty region by one base tile, so to include
+	  / any padding of the border tiles of the Sections
+	  */
+	  p = regions + (ir * 4);
+	  *(p + 0) -= (double) tileWidth * cov->hResolution;
+	  *(p + 1) -= (double) tileHeight * cov->vResolution;
+	  *(p + 2) += (double) tileWidth * cov->hResolution;
+	  *(p + 3) += (double) tileHeight * cov->vResolution;
+      }
+
+    if (!prepare_monolithic_stmt_geo (handle, coverage, &stmt_geo))
+	goto error;
+    if (!prepare_monolithic_stmt_del (handle, coverage, &stmt_del))
+	goto error;
     if (!prepare_section_pyramid_stmts
 	(handle, coverage, 0, &stmt_rd, &stmt_levl, &stmt_tils, &stmt_data))
 	goto error;
+    if (!prepare_monolithic_model (cvg, &model, &single_level))
+	goto error;
+    palette = rl2_get_dbms_palette (handle, NULL, coverage);
 
-    if (sample_type == RL2_SAMPLE_1_BIT
-	&& pixel_type == RL2_PIXEL_MONOCHROME && num_bands == 1)
-      {
-	  /* monochrome: output colorspace is Grayscale compression PNG */
-	  out_sample_type = RL2_SAMPLE_UINT8;
-	  out_pixel_type = RL2_PIXEL_GRAYSCALE;
-	  out_num_bands = 1;
-	  out_compression = RL2_COMPRESSION_PNG;
-	  out_quality = 100;
-	  virt_levels = 1;
-      }
-    else if ((sample_type == RL2_SAMPLE_1_BIT
-	      && pixel_type == RL2_PIXEL_PALETTE && num_bands == 1)
-	     || (sample_type == RL2_SAMPLE_2_BIT
-		 && pixel_type == RL2_PIXEL_PALETTE && num_bands == 1)
-	     || (sample_type == RL2_SAMPLE_4_BIT))
-      {
-	  /* palette 1,2,4: output colorspace is RGB compression PNG */
-	  out_sample_type = RL2_SAMPLE_UINT8;
-	  out_pixel_type = RL2_PIXEL_RGB;
-	  out_num_bands = 3;
-	  out_compression = RL2_COMPRESSION_PNG;
-	  out_quality = 100;
-	  virt_levels = 1;
-      }
-    else if (sample_type == RL2_SAMPLE_UINT8
-	     && pixel_type == RL2_PIXEL_PALETTE && num_bands == 1)
-      {
-	  /* palette 8: output colorspace is RGB compression PNG */
-	  out_sample_type = RL2_SAMPLE_UINT8;
-	  out_pixel_type = RL2_PIXEL_RGB;
-	  out_num_bands = 3;
-	  out_compression = RL2_COMPRESSION_PNG;
-	  out_quality = 100;
-      }
-    else
-      {
-	  /* unaltered output colorspace */
-	  out_sample_type = sample_type;
-	  out_pixel_type = pixel_type;
-	  out_num_bands = num_bands;
-	  out_compression = compression;
-	  out_quality = quality;
-      }
-
-    /* setting the requested virt_levels */
-    switch (virt_levels)
-      {
-      case 1:			/* separating each physical level */
-	  resize_factor = 2;
-	  break;
-      case 2:			/* one physical + one virtual */
-	  resize_factor = 4;
-	  break;
-      case 3:			/* one physical + two virtuals */
-	  resize_factor = 8;
-	  break;
-      default:
-	  resize_factor = 8;
-	  break;
-      };
-    factor = resize_factor;
-
-/* computing output tile buffers */
-    switch (out_sample_type)
+/* allocating the Monolithic tile slots */
+    if (max_threads < 1)
+	max_threads = 1;
+    if (max_threads > 64)
+	max_threads = 64;
+    num_slots = (max_threads > 1) ? max_threads * 2 : 1;
+    aux = create_monolithic_tiles (&model, num_slots);
+    if (aux == NULL)
+	goto error;
+    if (max_threads > 1)
       {
-      case RL2_SAMPLE_INT16:
-      case RL2_SAMPLE_UINT16:
-	  sample_sz = 2;
-	  break;
-      case RL2_SAMPLE_INT32:
-      case RL2_SAMPLE_UINT32:
-      case RL2_SAMPLE_FLOAT:
-	  sample_sz = 4;
-	  break;
-      case RL2_SAMPLE_DOUBLE:
-	  sample_sz = 8;
-	  break;
-      default:
-	  sample_sz = 1;
-	  break;
+	  /* preparing a Batch of concurrent Jobs */
+	  batch = rl2_create_worker_batch (max_threads);
+	  if (batch == NULL)
+	      goto error;
       }
-    buf_size = tileWidth * tileHeight * out_num_bands * sample_sz;
-
-/* attempting to delete the section pyramid */
-    if (rl2_delete_all_pyramids (handle, coverage) != RL2_OK)
-	goto error;
 
-/* attempting to (re)build the section pyramid */
-    while (1)
+    for (id_level = 1; id_level <= num_levels; id_level++)
       {
 	  /* looping on pyramid levels */
-	  tile_maxy = maxy;
-	  row = 0;
-	  res_x = cov->hResolution * (double) factor;
-	  res_y = cov->vResolution * (double) factor;
-	  if (!do_insert_pyramid_levels
-	      (handle, id_level + 1, res_x, res_y, stmt_levl))
+	  res_x = *(resolutions + (id_level * 2));
+	  res_y = *(resolutions + (id_level * 2) + 1);
+	  factor =
+	      (int) ((res_x / *(resolutions + ((id_level - 1) * 2))) + 0.5);
+	  level.id_level = id_level - 1;
+	  level.factor = factor;
+	  level.res_x = res_x;
+	  level.res_y = res_y;
+	  level.retired = 0;
+	  if (!build_grid_edges
+	      (minx, maxx, (double) tileWidth * res_x, 0, &xs, &num_cols))
 	      goto error;
-	  tot_rows = 0;
-	  while (1)
+	  if (!build_grid_edges
+	      (maxy, miny, (double) tileHeight * res_y, 1, &ys, &num_rows))
+	      goto error;
+	  if (num_cols > 0 && num_rows > 0)
 	    {
-		/* pre-computing the max row-number */
-		tile_miny = tile_maxy - ((double) tileHeight * res_y);
-		tile_minx = minx;
-		if (tile_maxy < miny)
-		    break;
-		tot_rows++;
-		tile_maxy = tile_miny;
+		dirty = malloc (num_cols * num_rows);
+		if (dirty == NULL)
+		    goto error;
+		num_dirty =
+		    mark_dirty_tiles (dirty, num_cols, num_rows, minx, maxy,
+				      (double) tileWidth * res_x,
+				      (double) tileHeight * res_y, regions,
+				      num_regions);
 	    }
-
-	  tile_maxy = maxy;
-	  while (1)
+	  else
+	      num_dirty = 0;
+	  for (row = 0; num_dirty > 0 && row < num_rows; row++)
 	    {
-		/* looping on rows */
-		tile_miny = tile_maxy - ((double) tileHeight * res_y);
-		tile_minx = minx;
-		if (tile_maxy < miny)
-		    break;
-		col = 0;
-		while (1)
+		for (col = 0; col < num_cols; col++)
 		  {
-		      /* looping on columns */
-		      tile_maxx = tile_minx + ((double) tileWidth * res_x);
-		      if (tile_minx > maxx)
-			  break;
-		      /* allocating output tile buffers */
-		      buffer = malloc (buf_size);
-		      if (buffer == NULL)
-			  goto error;
-		      memset (buffer, 0, buf_size);
-		      mask_size = tileWidth * tileHeight;
-		      mask = malloc (mask_size);
-		      if (mask == NULL)
+		      double tile_minx = *(xs + col);
+		      double tile_maxx = *(xs + col + 1);
+		      double tile_maxy = *(ys + row);
+		      double tile_miny = *(ys + row + 1);
+		      if (*(dirty + (row * num_cols) + col) == 0)
+			  continue;
+		      /* 
+		      / removing the stale tile (if any); border tiles are
+		      / clipped to the extent, so the probe is placed half a
+		      / pixel inside the upper left corner
+		      */
+		      if (!do_delete_monolithic_tile
+			  (handle, stmt_del, id_level,
+			   tile_minx + (res_x / 2.0),
+			   tile_maxy - (res_y / 2.0)))
 			  goto error;
-		      memset (mask, 0, mask_size);
-		      end_x = tile_maxx;
-		      if (tile_maxx > maxx)
-			  end_x = maxx;
-		      end_y = tile_miny;
-		      if (tile_miny < miny)
-			  end_y = miny;
-
-		      if ((sample_type == RL2_SAMPLE_UINT8
-			   && pixel_type == RL2_PIXEL_GRAYSCALE
-			   && num_bands == 1)
-			  || (sample_type == RL2_SAMPLE_UINT8
-			      && pixel_type == RL2_PIXEL_RGB
-			      && num_bands == 3)
-			  || (sample_type == RL2_SAMPLE_UINT8
-			      && pixel_type == RL2_PIXEL_PALETTE
-			      && num_bands == 1))
-			{
-			    /* RGB, PALETTE or GRAYSCALE datasource (UINT8) */
-			    if (!rescale_monolithic_rgba
-				(id_level, tileWidth, tileHeight,
-				 resize_factor, res_x, res_y, tile_minx,
-				 tile_miny, tile_maxx, tile_maxy, buffer,
-				 buf_size, mask, &mask_size, palette, no_data,
-				 stmt_geo, stmt_rd))
-				goto error;
-			    if (mask_size == 0)
-				mask = NULL;
-			}
-		      else if (((sample_type == RL2_SAMPLE_1_BIT
-				 || sample_type == RL2_SAMPLE_2_BIT
-				 || sample_type == RL2_SAMPLE_4_BIT)
-				&& pixel_type == RL2_PIXEL_PALETTE
-				&& num_bands == 1)
-			       || (sample_type == RL2_SAMPLE_1_BIT
-				   && pixel_type == RL2_PIXEL_MONOCHROME
-				   && num_bands == 1))
-			{
-			    /* MONOCHROME and 1,2,4 bit PALETTE */
-			    if (!rescale_monolithic_124
-				(id_level, tileWidth,
-				 tileHeight, resize_factor, pixel_type,
-				 res_x, res_y, tile_minx, tile_miny,
-				 tile_maxx, tile_maxy, buffer, buf_size, mask,
-				 &mask_size, palette, no_data, stmt_geo,
-				 stmt_rd))
-				goto error;
-			    if (mask_size == 0)
-				mask = NULL;
-			}
-		      else if (pixel_type == RL2_PIXEL_MULTIBAND)
-			{
-			    /* MultiBand */
-			    if (!rescale_monolithic_multiband
-				(id_level, tileWidth, tileHeight, sample_type,
-				 num_bands, resize_factor, res_x, res_y,
-				 tile_minx, tile_miny, tile_maxx, tile_maxy,
-				 buffer, buf_size, mask, &mask_size, no_data,
-				 stmt_geo, stmt_rd))
-				goto error;
-			    if (mask_size == 0)
-				mask = NULL;
-			}
-		      else if (pixel_type == RL2_PIXEL_DATAGRID)
+		      if (busy == num_slots)
 			{
-			    /* DataGrid */
-			    if (!rescale_monolithic_datagrid
-				(id_level, tileWidth, tileHeight, sample_type,
-				 resize_factor, res_x, res_y, tile_minx,
-				 tile_miny, tile_maxx, tile_maxy, buffer,
-				 buf_size, mask, &mask_size, no_data,
-				 stmt_geo, stmt_rd))
+			    /* all slots are busy: retiring the oldest tile */
+			    if (!do_retire_monolithic_tile
+				(handle, batch, aux + head, srid, stmt_tils,
+				 stmt_data))
 				goto error;
-			    if (mask_size == 0)
-				mask = NULL;
-			}
-		      else
-			{
-			    /* unknown */
-			    fprintf (stderr,
-				     "ERROR: unsupported Monolithic pyramid type\n");
-			    goto error;
-			}
-		      if (is_full_mask (mask, mask_size))
-			{
-			    /* skipping a completely void tile */
-			    free (buffer);
-			    free (mask);
-			    buffer = NULL;
-			    mask = NULL;
-			    goto done;
-			}
-
-		      if (pixel_type == RL2_PIXEL_MONOCHROME)
-			{
-			    if (no_data == NULL)
-				nd = NULL;
-			    else
-			      {
-				  rl2PrivPixelPtr pxl =
-				      (rl2PrivPixelPtr) no_data;
-				  rl2PrivSamplePtr sample = pxl->Samples + 0;
-				  nd = rl2_create_pixel (RL2_SAMPLE_UINT8,
-							 RL2_PIXEL_GRAYSCALE,
-							 1);
-				  if (sample->uint8 == 0)
-				      rl2_set_pixel_sample_uint8 (nd,
-								  RL2_GRAYSCALE_BAND,
-								  255);
-				  else
-				      rl2_set_pixel_sample_uint8 (nd,
-								  RL2_GRAYSCALE_BAND,
-								  0);
-			      }
+			    head = (head + 1) % num_slots;
+			    busy--;
 			}
-		      else if (pixel_type == RL2_PIXEL_PALETTE)
+		      job = aux + ((head + busy) % num_slots);
+		      job->level = &level;
+		      job->factor = factor;
+		      job->res_x = res_x;
+		      job->res_y = res_y;
+		      job->palette = palette;
+		      job->minx = tile_minx;
+		      job->miny = tile_miny;
+		      job->maxx = tile_maxx;
+		      job->maxy = tile_maxy;
+		      job->end_x = (tile_maxx > maxx) ? maxx : tile_maxx;
+		      job->end_y = (tile_miny < miny) ? miny : tile_miny;
+		      job->void_tile = 0;
+		      job->retcode = RL2_ERROR;
+		      busy++;
+		      if (!do_fetch_monolithic_bases
+			  (handle, stmt_geo, stmt_rd, job, id_level - 1))
+			  goto error;
+		      if (max_threads > 1)
 			{
-			    if (no_data == NULL)
-				nd = NULL;
-			    else
-			      {
-				  nd = rl2_create_pixel (RL2_SAMPLE_UINT8,
-							 RL2_PIXEL_RGB, 3);
-				  rl2_set_pixel_sample_uint8 (nd,
-							      RL2_RED_BAND,
-							      255);
-				  rl2_set_pixel_sample_uint8 (nd,
-							      RL2_GREEN_BAND,
-							      255);
-				  rl2_set_pixel_sample_uint8 (nd,
-							      RL2_BLUE_BAND,
-							      255);
-			      }
+			    /* adopting a multithreaded strategy */
+			    rl2_submit_worker_job (batch,
+						   doRunMonolithicTileJob,
+						   job);
 			}
 		      else
-			  nd = rl2_clone_pixel (no_data);
-
-		      raster =
-			  rl2_create_raster (tileWidth, tileHeight,
-					     out_sample_type, out_pixel_type,
-					     out_num_bands, buffer, buf_size,
-					     NULL, mask, mask_size, nd);
-		      buffer = NULL;
-		      mask = NULL;
-		      if (raster == NULL)
-			{
-			    fprintf (stderr,
-				     "ERROR: unable to create a Pyramid Tile\n");
-			    goto error;
-			}
-		      if (rl2_raster_encode
-			  (raster, out_compression, &blob_odd, &blob_odd_sz,
-			   &blob_even, &blob_even_sz, out_quality, 1) != RL2_OK)
 			{
-			    fprintf (stderr,
-				     "ERROR: unable to encode a Pyramid tile\n");
-			    goto error;
+			    /* single thread execution */
+			    doRunMonolithicTileJob (job);
+			    job->done = 1;
 			}
-
-		      /* INSERTing the tile */
-		      if (!do_insert_pyramid_tile
-			  (handle, blob_odd, blob_odd_sz, blob_even,
-			   blob_even_sz, id_level + 1, -1, srid, tile_minx,
-			   end_y, end_x, tile_maxy, stmt_tils, stmt_data))
-			  goto error;
-		      rl2_destroy_raster (raster);
-		      raster = NULL;
-
-		    done:
-		      tile_minx = tile_maxx;
-		      col++;
-		  }
-		tile_maxy = tile_miny;
-		row++;
-		if (verbose)
-		  {
-		      printf ("  ----------\n");
-		      printf
-			  ("    %s: Monolithic Pyramid Level %d - Row %d of %d  successfully built\n",
-			   coverage, id_level + 1, row, tot_rows);
 		  }
 	    }
-	  if (stop)
-	      break;
-	  if ((minx +
-	       ((double) tileWidth * res_x) > maxx)
-	      && (maxy - ((double) tileHeight * res_y) < maxy))
-	      stop = 1;
-	  /* setting the requested virt_levels */
-	  switch (virt_levels)
+	  while (busy > 0)
 	    {
-	    case 1:		/* separating each physical level */
-		resize_factor = 2;
-		break;
-	    case 2:		/* one physical + one virtual */
-		resize_factor = 4;
-		break;
-	    case 3:		/* one physical + two virtuals */
-		resize_factor = 8;
-		break;
-	    };
-	  factor *= resize_factor;
-	  id_level++;
+		/* retiring all pending tiles before moving to the next level */
+		if (!do_retire_monolithic_tile
+		    (handle, batch, aux + head, srid, stmt_tils, stmt_data))
+		    goto error;
+		head = (head + 1) % num_slots;
+		busy--;
+	    }
+	  if (verbose)
+	    {
+		printf ("  ----------\n");
+		printf
+		    ("    %s: Monolithic Pyramid Level %d - %d tiles updated\n",
+		     coverage, id_level, num_dirty);
+	    }
+	  free (xs);
+	  xs = NULL;
+	  free (ys);
+	  ys = NULL;
+	  if (dirty != NULL)
+	      free (dirty);
+	  dirty = NULL;
 	  if (palette != NULL)
 	    {
 		/* destroying an eventual Palette after completing the first level */
@@ -6642,27 +7267,47 @@ rl2_build_monolithic_pyramid (sqlite3 * handle, const char *coverage,
 		palette = NULL;
 	    }
       }
-    sqlite3_finalize (stmt_geo);
-    sqlite3_finalize (stmt_rd);
-    sqlite3_finalize (stmt_levl);
-    sqlite3_finalize (stmt_tils);
-    sqlite3_finalize (stmt_data);
+    rl2_destroy_worker_batch (batch);
+    batch = NULL;
+
+  done:
+    if (!do_clear_dirty_regions (handle, coverage))
+	goto error;
+    rl2_invalidate_tile_cache (handle, NULL, coverage);
+    do_cleanup_monolithic_tiles (aux, num_slots);
+    if (stmt_geo != NULL)
+	sqlite3_finalize (stmt_geo);
+    if (stmt_del != NULL)
+	sqlite3_finalize (stmt_del);
+    if (stmt_rd != NULL)
+	sqlite3_finalize (stmt_rd);
+    if (stmt_levl != NULL)
+	sqlite3_finalize (stmt_levl);
+    if (stmt_tils != NULL)
+	sqlite3_finalize (stmt_tils);
+    if (stmt_data != NULL)
+	sqlite3_finalize (stmt_data);
+    if (regions != NULL)
+	free (regions);
+    free (resolutions);
+    rl2_destroy_coverage (cvg);
     if (verbose)
       {
 	  printf ("  ----------\n");
 	  printf
-	      ("    Monolithic Pyramid levels successfully built for: %s\n",
+	      ("    Monolithic Pyramid levels successfully updated for: %s\n",
 	       coverage);
       }
-    free (buffer);
-    free (mask);
-    rl2_destroy_coverage (cvg);
-
     return RL2_OK;
 
   error:
+    /* waiting for any pending Job before releasing the slots */
+    rl2_destroy_worker_batch (batch);
+    do_cleanup_monolithic_tiles (aux, num_slots);
     if (stmt_geo != NULL)
 	sqlite3_finalize (stmt_geo);
+    if (stmt_del != NULL)
+	sqlite3_finalize (stmt_del);
     if (stmt_rd != NULL)
 	sqlite3_finalize (stmt_rd);
     if (stmt_levl != NULL)
@@ -6671,16 +7316,20 @@ rl2_build_monolithic_pyramid (sqlite3 * handle, const char *coverage,
 	sqlite3_finalize (stmt_tils);
     if (stmt_data != NULL)
 	sqlite3_finalize (stmt_data);
-    if (buffer != NULL)
-	free (buffer);
-    if (mask != NULL)
-	free (mask);
-    if (cvg != NULL)
-	rl2_destroy_coverage (cvg);
+    if (regions != NULL)
+	free (regions);
+    if (resolutions != NULL)
+	free (resolutions);
+    if (xs != NULL)
+	free (xs);
+    if (ys != NULL)
+	free (ys);
+    if (dirty != NULL)
+	free (dirty);
     if (palette != NULL)
 	rl2_destroy_palette (palette);
-    if (raster != NULL)
-	rl2_destroy_raster (raster);
+    if (cvg != NULL)
+	rl2_destroy_coverage (cvg);
     return RL2_ERROR;
 }
 
@@ -6715,6 +7364,7 @@ rl2_delete_all_pyramids (sqlite3 * handle, const char *coverage)
 	  sqlite3_free (err_msg);
 	  return RL2_ERROR;
       }
+    rl2_invalidate_tile_cache (handle, NULL, coverage);
 
     if (mixed_resolutions)
       {
@@ -4903,15 +4903,10 @@ shaded_relief_value (double relief_factor, double scale_factor,
 				  azRadians, ennuple);
 }
 
-#if defined(_WIN32) && !defined(__MINGW32__)
-DWORD WINAPI
-doRunShadowerThread (void *arg)
-#else
-void *
-doRunShadowerThread (void *arg)
-#endif
+static void
+doRunShadowerJob (void *arg)
 {
-/* threaded function: decoding a Tile */
+/* Job function: computing a Shaded Relief stripe */
     float *p_out;
     unsigned short row;
     unsigned short col;
@@ -4930,111 +4925,26 @@ doRunShadowerThread (void *arg)
 				       shadower->sample_type,
 				       (rl2PixelPtr) (shadower->no_data));
       }
-#if defined(_WIN32) && !defined(__MINGW32__)
-    return 0;
-#else
-    pthread_exit (NULL);
-#endif
-}
-
-static void
-start_shadower_thread (rl2AuxShadowerPtr shadower)
-{
-/* starting a concurrent thread */
-#if defined(_WIN32) && !defined(__MINGW32__)
-    HANDLE thread_handle;
-    HANDLE *p_thread;
-    DWORD dwThreadId;
-    thread_handle =
-	CreateThread (NULL, 0, doRunShadowerThread, shadower, 0, &dwThreadId);
-    SetThreadPriority (thread_handle, THREAD_PRIORITY_IDLE);
-    p_thread = malloc (sizeof (HANDLE));
-    *p_thread = thread_handle;
-    shadower->opaque_thread_id = p_thread;
-#else
-    pthread_t thread_id;
-    pthread_t *p_thread;
-    int ok_prior = 0;
-    int policy;
-    int min_prio;
-    pthread_attr_t attr;
-    struct sched_param sp;
-    pthread_attr_init (&attr);
-    if (pthread_attr_setschedpolicy (&attr, SCHED_RR) == 0)
-      {
-	  /* attempting to set the lowest priority */
-	  if (pthread_attr_getschedpolicy (&attr, &policy) == 0)
-	    {
-		min_prio = sched_get_priority_min (policy);
-		sp.sched_priority = min_prio;
-		if (pthread_attr_setschedparam (&attr, &sp) == 0)
-		  {
-		      /* ok, setting the lowest priority */
-		      ok_prior = 1;
-		      pthread_create (&thread_id, &attr, doRunShadowerThread,
-				      shadower);
-		  }
-	    }
-      }
-    if (!ok_prior)
-      {
-	  /* failure: using standard priority */
-	  pthread_create (&thread_id, NULL, doRunShadowerThread, shadower);
-      }
-    p_thread = malloc (sizeof (pthread_t));
-    *p_thread = thread_id;
-    shadower->opaque_thread_id = p_thread;
-#endif
 }
 
 static void
 do_run_concurrent_shadower (rl2AuxShadowerPtr aux, int max_threads)
 {
-/* concurrent execution of all shadower children threads */
+/* concurrent execution of all shadower Jobs */
     rl2AuxShadowerPtr shadower;
+    rl2WorkerBatchPtr batch;
     int i;
-#if defined(_WIN32) && !defined(__MINGW32__)
-    HANDLE *handles;
-#endif
-
-    for (i = 0; i < max_threads; i++)
-      {
-	  /* starting all children threads */
-	  shadower = aux + i;
-	  start_shadower_thread (shadower);
-      }
 
-/* waiting until all child threads exit */
-#if defined(_WIN32) && !defined(__MINGW32__)
-    handles = malloc (sizeof (HANDLE) * max_threads);
-    for (i = 0; i < max_threads; i++)
-      {
-	  /* initializing the HANDLEs array */
-	  HANDLE *pOpaque;
-	  shadower = aux + i;
-	  pOpaque = (HANDLE *) (shadower->opaque_thread_id);
-	  *(handles + i) = *pOpaque;
-      }
-    WaitForMultipleObjects (max_threads, handles, TRUE, INFINITE);
-    free (handles);
-#else
+    batch = rl2_create_worker_batch (max_threads);
     for (i = 0; i < max_threads; i++)
       {
-	  pthread_t *pOpaque;
+	  /* submitting all Jobs */
 	  shadower = aux + i;
-	  pOpaque = (pthread_t *) (shadower->opaque_thread_id);
-	  pthread_join (*pOpaque, NULL);
+	  rl2_submit_worker_job (batch, doRunShadowerJob, shadower);
       }
-#endif
 
-/* all children threads have now finished: resuming the main thread */
-    for (i = 0; i < max_threads; i++)
-      {
-	  /* cleaning up a request slot */
-	  if (shadower->opaque_thread_id != NULL)
-	      free (shadower->opaque_thread_id);
-	  shadower->opaque_thread_id = NULL;
-      }
+/* waiting until all Jobs have been completed */
+    rl2_destroy_worker_batch (batch);
 }
 
 RL2_PRIVATE int
@@ -5205,10 +5115,10 @@ rl2_build_shaded_relief_mask (sqlite3 * handle, int max_threads,
       }
     void_raw_buffer (rawbuf, width + 2, height + 2, sample_type, 1, no_data);
     if (!rl2_load_dbms_tiles
-	(handle, max_threads, stmt_tiles, stmt_data, rawbuf, width + 2,
-	 height + 2, sample_type, 1, 0, 0, 0, xx_res, yy_res, minx - xx_res,
-	 miny - yy_res, maxx + xx_res, maxy + yy_res, level, scale, NULL,
-	 no_data, NULL, NULL))
+	(handle, NULL, max_threads, db_prefix, coverage, stmt_tiles,
+	 stmt_data, rawbuf, width + 2, height + 2, sample_type, 1, 0, 0, 0,
+	 xx_res, yy_res, minx - xx_res, miny - yy_res, maxx + xx_res,
+	 maxy + yy_res, level, scale, NULL, no_data, NULL, NULL))
 	goto error;
     sqlite3_finalize (stmt_tiles);
     sqlite3_finalize (stmt_data);
@@ -5256,7 +5166,6 @@ rl2_build_shaded_relief_mask (sqlite3 * handle, int max_threads,
 	    {
 		/* initializing an empty AuxShadower slot */
 		shadower = aux + iaux;
-		shadower->opaque_thread_id = NULL;
 		shadower->width = width;
 		shadower->height = height;
 		shadower->relief_factor = relief_factor;
@@ -0,0 +1,2437 @@
+/*
+
+ rl2simd -- SIMD kernels for pixel reassembly, byte swapping, CRC32C
+            and statistics
+
+ version 0.1, 2026 October 17
+
+ -----------------------------------------------------------------------------
+
+ Version: MPL 1.1/GPL 2.0/LGPL 2.1
+
+ The contents of this file are subject to the Mozilla Public License Version
+ 1.1 (the "License"); you may not use this file except in compliance with
+ the License. You may obtain a copy of the License at
+ http://www.mozilla.org/MPL/
+
+Software distributed under the License is distributed on an "AS IS" basis,
+WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+for the specific language governing rights and limitations under the
+License.
+
+The Original Code is the RasterLite2 library
+
+The Initial Developer of the Original Code is Alessandro Furieri
+
+Portions created by the Initial Developer are Copyright (C) 2026
+the Initial Developer. All Rights Reserved.
+
+Alternatively, the contents of this file may be used under the terms of
+either the GNU General Public License Version 2 or later (the "GPL"), or
+the GNU Lesser General Public License Version 2.1 or later (the "LGPL"),
+in which case the provisions of the GPL or the LGPL are applicable instead
+of those above. If you wish to allow use of your version of this file only
+under the terms of either the GPL or the LGPL, and not to allow others to
+use your version of this file under the terms of the MPL, indicate your
+decision by deleting the provisions above and replace them with the notice
+and other provisions required by the GPL or the LGPL. If you do not delete
+the provisions above, a recipient may use your version of this file under
+the terms of any one of the MPL, the GPL or the LGPL.
+
+*/
+
+/*
+/ the Odd/Even block codec spends most of its non-compression time
+/ moving pixels between the tile buffers: reassembling rows, taking
+/ one pixel every 2/4/8 when decoding at reduced scales, and swapping
+/ bytes whenever the tile endianness differs from the CPU one.
+/ all these kernels are implemented here once, with a portable C
+/ version always available and SIMD variants selected at runtime:
+/ - AVX2 (x86, checked at runtime via the CPU features)
+/ - SSE2 (x86, always available on x86_64)
+/ - NEON (always available on AArch64)
+/
+/ the ByteShuffle used by the LZ4 codec and by the FloatPredictor is
+/ implemented here too, so that it follows the same runtime selection
+/
+/ the CRC32C checksums of the tile blocks are computed here as well,
+/ using the SSE4.2 or ARMv8 CRC32 instructions when available, and
+/ so are the min/max/sum/sum-of-squares of UINT8 and UINT16 samples
+/ required by the Tile statistics
+*/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define RL2_SIMD_SSE2
+#endif
+
+#if defined(RL2_SIMD_SSE2) && defined(__GNUC__) && \
+	(defined(__x86_64__) || defined(__i386__)) && \
+	(defined(__clang__) || (__GNUC__ > 4) || \
+	 (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))
+#include <immintrin.h>
+#define RL2_SIMD_AVX2
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define RL2_SIMD_NEON
+#endif
+
+#if defined(_WIN32) && !defined(__MINGW32__)
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+#ifdef LOADABLE_EXTENSION
+#include "rasterlite2/sqlite.h"
+#endif
+
+#include "rasterlite2/rasterlite2.h"
+#include "rasterlite2_private.h"
+
+#define RL2_SIMD_NONE		0
+#define RL2_SIMD_SSE2_LEVEL	1
+#define RL2_SIMD_AVX2_LEVEL	2
+#define RL2_SIMD_NEON_LEVEL	3
+
+#if defined(_WIN32) && !defined(__MINGW32__)
+typedef INIT_ONCE rl2SimdOnce;
+#define RL2_SIMD_ONCE_INIT	INIT_ONCE_STATIC_INIT
+#else
+typedef pthread_once_t rl2SimdOnce;
+#define RL2_SIMD_ONCE_INIT	PTHREAD_ONCE_INIT
+#endif
+
+static int simd_detected = RL2_SIMD_NONE;
+static rl2SimdOnce simd_detect_once = RL2_SIMD_ONCE_INIT;
+
+/*
+/ process-wide switch, only intended for testing and benchmarking:
+/ see rl2_enable_simd()
+*/
+static volatile int simd_enabled = 1;
+
+#if defined(_WIN32) && !defined(__MINGW32__)
+static BOOL CALLBACK
+simd_once_callback (PINIT_ONCE once, PVOID param, PVOID * context)
+{
+/* adapting a plain init function to InitOnceExecuteOnce() */
+    void (*init) (void) = (void (*)(void)) param;
+    init ();
+    return TRUE;
+}
+#endif
+
+static void
+simd_once (rl2SimdOnce * once, void (*init) (void))
+{
+/* 
+/ running some one-time initializer (CPU detection, lookup tables)
+/ exactly once; any other thread calling it meanwhile waits until it
+/ has completed, and will then see all of its results
+*/
+#if defined(_WIN32) && !defined(__MINGW32__)
+    InitOnceExecuteOnce (once, simd_once_callback, (PVOID) init, NULL);
+#else
+    pthread_once (once, init);
+#endif
+}
+
+static void
+simd_detect_level (void)
+{
+/* detecting the best SIMD level supported by the current CPU */
+    int level = RL2_SIMD_NONE;
+#ifdef RL2_SIMD_SSE2
+    level = RL2_SIMD_SSE2_LEVEL;
+#endif
+#ifdef RL2_SIMD_AVX2
+    __builtin_cpu_init ();
+    if (__builtin_cpu_supports ("avx2"))
+	level = RL2_SIMD_AVX2_LEVEL;
+#endif
+#ifdef RL2_SIMD_NEON
+    level = RL2_SIMD_NEON_LEVEL;
+#endif
+    simd_detected = level;
+}
+
+static int
+simd_detect (void)
+{
+/* returning the SIMD level supported by the current CPU (thread safe) */
+    simd_once (&simd_detect_once, simd_detect_level);
+    return simd_detected;
+}
+
+static int
+simd_level (void)
+{
+/* returning the currently active SIMD level */
+    if (!simd_enabled)
+	return RL2_SIMD_NONE;
+    return simd_detect ();
+}
+
+RL2_DECLARE const char *
+rl2_simd_kernels (void)
+{
+/* return the name of the SIMD kernels currently in use */
+    switch (simd_level ())
+      {
+      case RL2_SIMD_SSE2_LEVEL:
+	  return "SSE2";
+      case RL2_SIMD_AVX2_LEVEL:
+	  return "AVX2";
+      case RL2_SIMD_NEON_LEVEL:
+	  return "NEON";
+      };
+    return "none";
+}
+
+RL2_DECLARE int
+rl2_enable_simd (int enabled)
+{
+/* 
+/ enabling or disabling the SIMD kernels (returns the previous state)
+/ not synchronized: only meant to be called by tests and benchmarks
+/ while no other thread is using the library
+*/
+    int old = simd_enabled;
+    simd_enabled = enabled ? 1 : 0;
+    return old;
+}
+
+/*
+/
+/ byte swapping kernels: "in" and "out" may be the same buffer
+/
+*/
+
+static void
+swap16_c (unsigned char *out, const unsigned char *in, int count)
+{
+/* swapping 16 bit samples - portable C */
+    int i;
+    for (i = 0; i < count; i++)
+      {
+	  unsigned char b0 = in[0];
+	  unsigned char b1 = in[1];
+	  out[0] = b1;
+	  out[1] = b0;
+	  in += 2;
+	  out += 2;
+      }
+}
+
+static void
+swap32_c (unsigned char *out, const unsigned char *in, int count)
+{
+/* swapping 32 bit samples - portable C */
+    int i;
+    for (i = 0; i < count; i++)
+      {
+	  unsigned char b0 = in[0];
+	  unsigned char b1 = in[1];
+	  unsigned char b2 = in[2];
+	  unsigned char b3 = in[3];
+	  out[0] = b3;
+	  out[1] = b2;
+	  out[2] = b1;
+	  out[3] = b0;
+	  in += 4;
+	  out += 4;
+      }
+}
+
+static void
+swap64_c (unsigned char *out, const unsigned char *in, int count)
+{
+/* swapping 64 bit samples - portable C */
+    int i;
+    int b;
+    for (i = 0; i < count; i++)
+      {
+	  unsigned char tmp[8];
+	  memcpy (tmp, in, 8);
+	  for (b = 0; b < 8; b++)
+	      out[b] = tmp[7 - b];
+	  in += 8;
+	  out += 8;
+      }
+}
+
+#ifdef RL2_SIMD_SSE2
+static int
+swap_sse2 (unsigned char *out, const unsigned char *in, int count,
+	   int sample_size)
+{
+/* swapping 16/32/64 bit samples - SSE2; returns the number of samples done */
+    int per_vector = 16 / sample_size;
+    int done;
+    for (done = 0; done + per_vector <= count; done += per_vector)
+      {
+	  __m128i v = _mm_loadu_si128 ((const __m128i *) in);
+	  if (sample_size == 8)
+	      v = _mm_shuffle_epi32 (v, 0xb1);
+	  if (sample_size >= 4)
+	    {
+		v = _mm_shufflelo_epi16 (v, 0xb1);
+		v = _mm_shufflehi_epi16 (v, 0xb1);
+	    }
+	  v = _mm_or_si128 (_mm_slli_epi16 (v, 8), _mm_srli_epi16 (v, 8));
+	  _mm_storeu_si128 ((__m128i *) out, v);
+	  in += 16;
+	  out += 16;
+      }
+    return done;
+}
+#endif
+
+#ifdef RL2_SIMD_AVX2
+static int swap_avx2 (unsigned char *out, const unsigned char *in, int count,
+		      int sample_size) __attribute__ ((target ("avx2")));
+
+static int
+swap_avx2 (unsigned char *out, const unsigned char *in, int count,
+	   int sample_size)
+{
+/* swapping 16/32/64 bit samples - AVX2; returns the number of samples done */
+    int per_vector = 32 / sample_size;
+    int done;
+    __m256i mask;
+    if (sample_size == 2)
+	mask =
+	    _mm256_setr_epi8 (1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15,
+			      14, 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12,
+			      15, 14);
+    else if (sample_size == 4)
+	mask =
+	    _mm256_setr_epi8 (3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13,
+			      12, 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14,
+			      13, 12);
+    else
+	mask =
+	    _mm256_setr_epi8 (7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9,
+			      8, 7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10,
+			      9, 8);
+    for (done = 0; done + per_vector <= count; done += per_vector)
+      {
+	  __m256i v = _mm256_loadu_si256 ((const __m256i *) in);
+	  v = _mm256_shuffle_epi8 (v, mask);
+	  _mm256_storeu_si256 ((__m256i *) out, v);
+	  in += 32;
+	  out += 32;
+      }
+    return done;
+}
+#endif
+
+#ifdef RL2_SIMD_NEON
+static int
+swap_neon (unsigned char *out, const unsigned char *in, int count,
+	   int sample_size)
+{
+/* swapping 16/32/64 bit samples - NEON; returns the number of samples done */
+    int per_vector = 16 / sample_size;
+    int done;
+    for (done = 0; done + per_vector <= count; done += per_vector)
+      {
+	  uint8x16_t v = vld1q_u8 (in);
+	  if (sample_size == 2)
+	      v = vrev16q_u8 (v);
+	  else if (sample_size == 4)
+	      v = vrev32q_u8 (v);
+	  else
+	      v = vrev64q_u8 (v);
+	  vst1q_u8 (out, v);
+	  in += 16;
+	  out += 16;
+      }
+    return done;
+}
+#endif
+
+RL2_PRIVATE void
+rl2_simd_swap (unsigned char *out, const unsigned char *in, int count,
+	       int sample_size)
+{
+/*
+/ copying "count" samples while reversing their byte order
+/ (in-place swapping is supported as well)
+*/
+    int done = 0;
+    if (sample_size != 2 && sample_size != 4 && sample_size != 8)
+      {
+	  if (out != in)
+	      memcpy (out, in, count * sample_size);
+	  return;
+      }
+    switch (simd_level ())
+      {
+#ifdef RL2_SIMD_AVX2
+      case RL2_SIMD_AVX2_LEVEL:
+	  done = swap_avx2 (out, in, count, sample_size);
+	  break;
+#endif
+#ifdef RL2_SIMD_SSE2
+      case RL2_SIMD_SSE2_LEVEL:
+	  done = swap_sse2 (out, in, count, sample_size);
+	  break;
+#endif
+#ifdef RL2_SIMD_NEON
+      case RL2_SIMD_NEON_LEVEL:
+	  done = swap_neon (out, in, count, sample_size);
+	  break;
+#endif
+      };
+    in += done * sample_size;
+    out += done * sample_size;
+    count -= done;
+    if (sample_size == 2)
+	swap16_c (out, in, count);
+    else if (sample_size == 4)
+	swap32_c (out, in, count);
+    else
+	swap64_c (out, in, count);
+}
+
+/*
+/
+/ strided subsampling kernels: taking one pixel every "step" pixels
+/
+*/
+
+static void
+gather_c (unsigned char *out, const unsigned char *in, int count,
+	  int pixel_bytes, int step)
+{
+/* taking one pixel every "step" - portable C */
+    int i;
+    int b;
+    int skip = pixel_bytes * step;
+    switch (pixel_bytes)
+      {
+      case 1:
+	  for (i = 0; i < count; i++, in += skip)
+	      *out++ = *in;
+	  break;
+      case 2:
+	  for (i = 0; i < count; i++, in += skip, out += 2)
+	      memcpy (out, in, 2);
+	  break;
+      case 4:
+	  for (i = 0; i < count; i++, in += skip, out += 4)
+	      memcpy (out, in, 4);
+	  break;
+      case 8:
+	  for (i = 0; i < count; i++, in += skip, out += 8)
+	      memcpy (out, in, 8);
+	  break;
+      default:
+	  for (i = 0; i < count; i++, in += skip)
+	    {
+		for (b = 0; b < pixel_bytes; b++)
+		    *out++ = in[b];
+	    }
+	  break;
+      };
+}
+
+#ifdef RL2_SIMD_SSE2
+static int
+gather_bytes_sse2 (unsigned char *out, const unsigned char *in, int count,
+		   int step)
+{
+/*
+/ taking one byte every 2, 4 or 8 - SSE2: masking the leading byte
+/ of each lane and then narrowing by saturated packs; returns the
+/ number of pixels done
+*/
+    int done;
+    __m128i v[8];
+    int k;
+    int n;
+    __m128i mask;
+    if (step == 2)
+	mask = _mm_set1_epi16 (0x00ff);
+    else if (step == 4)
+	mask = _mm_set1_epi32 (0x000000ff);
+    else
+	mask = _mm_set_epi32 (0, 0x000000ff, 0, 0x000000ff);
+    for (done = 0; done + 16 <= count; done += 16)
+      {
+	  for (k = 0; k < step; k++)
+	      v[k] =
+		  _mm_and_si128 (_mm_loadu_si128
+				 ((const __m128i *) (in + (k * 16))), mask);
+	  n = step;
+	  while (n > 2)
+	    {
+		/* narrowing 32 bit lanes into 16 bit lanes */
+		for (k = 0; k < n / 2; k++)
+		    v[k] = _mm_packs_epi32 (v[k * 2], v[k * 2 + 1]);
+		n /= 2;
+	    }
+	  _mm_storeu_si128 ((__m128i *) out, _mm_packus_epi16 (v[0], v[1]));
+	  in += 16 * step;
+	  out += 16;
+      }
+    return done;
+}
+
+static int
+gather2_sse2 (unsigned char *out, const unsigned char *in, int count,
+	      int pixel_bytes)
+{
+/* taking one pixel every 2 - SSE2; returns the number of pixels done */
+    int done = 0;
+    __m128i a;
+    __m128i b;
+    switch (pixel_bytes)
+      {
+      case 1:
+	  return gather_bytes_sse2 (out, in, count, 2);
+      case 2:
+	  for (done = 0; done + 8 <= count; done += 8)
+	    {
+		/* sign extending the low 16 bits, so that packs is lossless */
+		a = _mm_loadu_si128 ((const __m128i *) in);
+		b = _mm_loadu_si128 ((const __m128i *) (in + 16));
+		a = _mm_srai_epi32 (_mm_slli_epi32 (a, 16), 16);
+		b = _mm_srai_epi32 (_mm_slli_epi32 (b, 16), 16);
+		_mm_storeu_si128 ((__m128i *) out, _mm_packs_epi32 (a, b));
+		in += 32;
+		out += 16;
+	    }
+	  break;
+      case 4:
+	  for (done = 0; done + 4 <= count; done += 4)
+	    {
+		a = _mm_shuffle_epi32 (_mm_loadu_si128 ((const __m128i *) in),
+				       0x08);
+		b = _mm_shuffle_epi32 (_mm_loadu_si128
+				       ((const __m128i *) (in + 16)), 0x08);
+		_mm_storeu_si128 ((__m128i *) out, _mm_unpacklo_epi64 (a, b));
+		in += 32;
+		out += 16;
+	    }
+	  break;
+      case 8:
+	  for (done = 0; done + 2 <= count; done += 2)
+	    {
+		a = _mm_loadu_si128 ((const __m128i *) in);
+		b = _mm_loadu_si128 ((const __m128i *) (in + 16));
+		_mm_storeu_si128 ((__m128i *) out, _mm_unpacklo_epi64 (a, b));
+		in += 32;
+		out += 16;
+	    }
+	  break;
+      };
+    return done;
+}
+#endif
+
+#ifdef RL2_SIMD_NEON
+static int
+gather_neon (unsigned char *out, const unsigned char *in, int count,
+	     int pixel_bytes, int step)
+{
+/* taking one pixel every 2 or 4 - NEON; returns the number of pixels done */
+    int done = 0;
+    if (step == 2)
+      {
+	  switch (pixel_bytes)
+	    {
+	    case 1:
+		for (done = 0; done + 16 <= count; done += 16)
+		  {
+		      uint8x16x2_t v = vld2q_u8 (in);
+		      vst1q_u8 (out, v.val[0]);
+		      in += 32;
+		      out += 16;
+		  }
+		break;
+	    case 2:
+		for (done = 0; done + 8 <= count; done += 8)
+		  {
+		      uint16x8x2_t v = vld2q_u16 ((const uint16_t *) in);
+		      vst1q_u16 ((uint16_t *) out, v.val[0]);
+		      in += 32;
+		      out += 16;
+		  }
+		break;
+	    case 4:
+		for (done = 0; done + 4 <= count; done += 4)
+		  {
+		      uint32x4x2_t v = vld2q_u32 ((const uint32_t *) in);
+		      vst1q_u32 ((uint32_t *) out, v.val[0]);
+		      in += 32;
+		      out += 16;
+		  }
+		break;
+	    };
+      }
+    else if (step == 4)
+      {
+	  switch (pixel_bytes)
+	    {
+	    case 1:
+		for (done = 0; done + 16 <= count; done += 16)
+		  {
+		      uint8x16x4_t v = vld4q_u8 (in);
+		      vst1q_u8 (out, v.val[0]);
+		      in += 64;
+		      out += 16;
+		  }
+		break;
+	    case 2:
+		for (done = 0; done + 8 <= count; done += 8)
+		  {
+		      uint16x8x4_t v = vld4q_u16 ((const uint16_t *) in);
+		      vst1q_u16 ((uint16_t *) out, v.val[0]);
+		      in += 64;
+		      out += 16;
+		  }
+		break;
+	    case 4:
+		for (done = 0; done + 4 <= count; done += 4)
+		  {
+		      uint32x4x4_t v = vld4q_u32 ((const uint32_t *) in);
+		      vst1q_u32 ((uint32_t *) out, v.val[0]);
+		      in += 64;
+		      out += 16;
+		  }
+		break;
+	    };
+      }
+    return done;
+}
+#endif
+
+RL2_PRIVATE void
+rl2_simd_gather (unsigned char *out, const unsigned char *in, int count,
+		 int pixel_bytes, int step)
+{
+/* copying "count" pixels, taking one pixel every "step" */
+    int done = 0;
+    if (step <= 1)
+      {
+	  memcpy (out, in, count * pixel_bytes);
+	  return;
+      }
+    switch (simd_level ())
+      {
+#ifdef RL2_SIMD_SSE2
+      case RL2_SIMD_AVX2_LEVEL:
+      case RL2_SIMD_SSE2_LEVEL:
+	  if (pixel_bytes == 1 && (step == 2 || step == 4 || step == 8))
+	      done = gather_bytes_sse2 (out, in, count, step);
+	  else if (step == 2)
+	      done = gather2_sse2 (out, in, count, pixel_bytes);
+	  break;
+#endif
+#ifdef RL2_SIMD_NEON
+      case RL2_SIMD_NEON_LEVEL:
+	  done = gather_neon (out, in, count, pixel_bytes, step);
+	  break;
+#endif
+      };
+    in += done * pixel_bytes * step;
+    out += done * pixel_bytes;
+    gather_c (out, in, count - done, pixel_bytes, step);
+}
+
+RL2_PRIVATE void
+rl2_copy_pixel_row (unsigned char *out, const unsigned char *in,
+		    unsigned int count, int sample_size, int num_bands,
+		    int step, int swap)
+{
+/*
+/ copying a row of "count" output pixels, taking one input pixel
+/ every "step" and swapping the sample bytes if required
+*/
+    int pixel_bytes = sample_size * num_bands;
+    if (step <= 1)
+      {
+	  if (swap && sample_size > 1)
+	      rl2_simd_swap (out, in, count * num_bands, sample_size);
+	  else
+	      memcpy (out, in, count * pixel_bytes);
+	  return;
+      }
+    rl2_simd_gather (out, in, count, pixel_bytes, step);
+    if (swap && sample_size > 1)
+	rl2_simd_swap (out, out, count * num_bands, sample_size);
+}
+
+/*
+/
+/ statistics kernels: min/max/sum/sum-of-squares of UINT8 and UINT16
+/ samples, all accumulated as exact integers
+/
+*/
+
+#define RL2_ACCUMULATE_CHUNK	(1024 * 1024)
+
+typedef struct rl2_int_accumulator
+{
+    unsigned int min;
+    unsigned int max;
+    unsigned long long sum;
+    unsigned long long sum_sq;
+} rl2IntAccumulator;
+
+static void
+accumulate_u8_c (const unsigned char *in, int count, int stride,
+		 rl2IntAccumulator * acc)
+{
+/* accumulating UINT8 samples - portable C */
+    int i;
+    unsigned int v;
+    for (i = 0; i < count; i++, in += stride)
+      {
+	  v = *in;
+	  if (v < acc->min)
+	      acc->min = v;
+	  if (v > acc->max)
+	      acc->max = v;
+	  acc->sum += v;
+	  acc->sum_sq += v * v;
+      }
+}
+
+static void
+accumulate_u16_c (const unsigned short *in, int count, int stride,
+		  rl2IntAccumulator * acc)
+{
+/* accumulating UINT16 samples - portable C */
+    int i;
+    unsigned int v;
+    for (i = 0; i < count; i++, in += stride)
+      {
+	  v = *in;
+	  if (v < acc->min)
+	      acc->min = v;
+	  if (v > acc->max)
+	      acc->max = v;
+	  acc->sum += v;
+	  acc->sum_sq += v * v;
+      }
+}
+
+static void
+reduce_accumulator (const unsigned char *vmin, const unsigned char *vmax,
+		    int lanes, int sample_size, const unsigned long long *sum,
+		    const unsigned long long *sum_sq, int sum_lanes,
+		    rl2IntAccumulator * acc)
+{
+/* folding the SIMD lanes into the final accumulator */
+    int i;
+    unsigned int v;
+    for (i = 0; i < lanes; i++)
+      {
+	  if (sample_size == 1)
+	      v = vmin[i];
+	  else
+	      v = ((const unsigned short *) vmin)[i];
+	  if (v < acc->min)
+	      acc->min = v;
+	  if (sample_size == 1)
+	      v = vmax[i];
+	  else
+	      v = ((const unsigned short *) vmax)[i];
+	  if (v > acc->max)
+	      acc->max = v;
+      }
+    for (i = 0; i < sum_lanes; i++)
+      {
+	  acc->sum += sum[i];
+	  acc->sum_sq += sum_sq[i];
+      }
+}
+
+#ifdef RL2_SIMD_SSE2
+static int
+accumulate_u8_sse2 (const unsigned char *in, int count,
+		    rl2IntAccumulator * acc)
+{
+/* accumulating UINT8 samples - SSE2; returns the number of samples done */
+    int done;
+    __m128i zero = _mm_setzero_si128 ();
+    __m128i vmin = _mm_set1_epi8 ((char) 0xff);
+    __m128i vmax = zero;
+    __m128i vsum = zero;
+    __m128i vsq = zero;
+    unsigned char lmin[16];
+    unsigned char lmax[16];
+    unsigned long long lsum[2];
+    unsigned long long lsq[2];
+    for (done = 0; done + 16 <= count; done += 16)
+      {
+	  __m128i v = _mm_loadu_si128 ((const __m128i *) (in + done));
+	  __m128i lo = _mm_unpacklo_epi8 (v, zero);
+	  __m128i hi = _mm_unpackhi_epi8 (v, zero);
+	  __m128i sq =
+	      _mm_add_epi32 (_mm_madd_epi16 (lo, lo), _mm_madd_epi16 (hi, hi));
+	  vmin = _mm_min_epu8 (vmin, v);
+	  vmax = _mm_max_epu8 (vmax, v);
+	  vsum = _mm_add_epi64 (vsum, _mm_sad_epu8 (v, zero));
+	  vsq = _mm_add_epi64 (vsq, _mm_unpacklo_epi32 (sq, zero));
+	  vsq = _mm_add_epi64 (vsq, _mm_unpackhi_epi32 (sq, zero));
+      }
+    _mm_storeu_si128 ((__m128i *) lmin, vmin);
+    _mm_storeu_si128 ((__m128i *) lmax, vmax);
+    _mm_storeu_si128 ((__m128i *) lsum, vsum);
+    _mm_storeu_si128 ((__m128i *) lsq, vsq);
+    if (done > 0)
+	reduce_accumulator (lmin, lmax, 16, 1, lsum, lsq, 2, acc);
+    return done;
+}
+
+static int
+accumulate_u16_sse2 (const unsigned short *in, int count,
+		     rl2IntAccumulator * acc)
+{
+/*
+/ accumulating UINT16 samples - SSE2 (no unsigned 16 bit min/max,
+/ so the samples are biased into the signed range); returns the
+/ number of samples done
+*/
+    int done;
+    __m128i zero = _mm_setzero_si128 ();
+    __m128i bias = _mm_set1_epi16 ((short) 0x8000);
+    __m128i vmin = _mm_set1_epi16 (0x7fff);
+    __m128i vmax = bias;
+    __m128i vsum = zero;
+    __m128i vsq = zero;
+    unsigned short lmin[8];
+    unsigned short lmax[8];
+    unsigned long long lsum[2];
+    unsigned long long lsq[2];
+    for (done = 0; done + 8 <= count; done += 8)
+      {
+	  __m128i v = _mm_loadu_si128 ((const __m128i *) (in + done));
+	  __m128i b = _mm_xor_si128 (v, bias);
+	  __m128i lo = _mm_unpacklo_epi16 (v, zero);
+	  __m128i hi = _mm_unpackhi_epi16 (v, zero);
+	  __m128i s = _mm_add_epi32 (lo, hi);
+	  vmin = _mm_min_epi16 (vmin, b);
+	  vmax = _mm_max_epi16 (vmax, b);
+	  vsum = _mm_add_epi64 (vsum, _mm_unpacklo_epi32 (s, zero));
+	  vsum = _mm_add_epi64 (vsum, _mm_unpackhi_epi32 (s, zero));
+	  vsq = _mm_add_epi64 (vsq, _mm_mul_epu32 (lo, lo));
+	  lo = _mm_srli_epi64 (lo, 32);
+	  vsq = _mm_add_epi64 (vsq, _mm_mul_epu32 (lo, lo));
+	  vsq = _mm_add_epi64 (vsq, _mm_mul_epu32 (hi, hi));
+	  hi = _mm_srli_epi64 (hi, 32);
+	  vsq = _mm_add_epi64 (vsq, _mm_mul_epu32 (hi, hi));
+      }
+    _mm_storeu_si128 ((__m128i *) lmin, _mm_xor_si128 (vmin, bias));
+    _mm_storeu_si128 ((__m128i *) lmax, _mm_xor_si128 (vmax, bias));
+    _mm_storeu_si128 ((__m128i *) lsum, vsum);
+    _mm_storeu_si128 ((__m128i *) lsq, vsq);
+    if (done > 0)
+	reduce_accumulator ((unsigned char *) lmin, (unsigned char *) lmax,
+			    8, 2, lsum, lsq, 2, acc);
+    return done;
+}
+#endif
+
+#ifdef RL2_SIMD_AVX2
+static int accumulate_u8_avx2 (const unsigned char *in, int count,
+			       rl2IntAccumulator * acc)
+    __attribute__ ((target ("avx2")));
+
+static int
+accumulate_u8_avx2 (const unsigned char *in, int count,
+		    rl2IntAccumulator * acc)
+{
+/* accumulating UINT8 samples - AVX2; returns the number of samples done */
+    int done;
+    __m256i zero = _mm256_setzero_si256 ();
+    __m256i vmin = _mm256_set1_epi8 ((char) 0xff);
+    __m256i vmax = zero;
+    __m256i vsum = zero;
+    __m256i vsq = zero;
+    unsigned char lmin[32];
+    unsigned char lmax[32];
+    unsigned long long lsum[4];
+    unsigned long long lsq[4];
+    for (done = 0; done + 32 <= count; done += 32)
+      {
+	  __m256i v = _mm256_loadu_si256 ((const __m256i *) (in + done));
+	  __m256i lo = _mm256_unpacklo_epi8 (v, zero);
+	  __m256i hi = _mm256_unpackhi_epi8 (v, zero);
+	  __m256i sq = _mm256_add_epi32 (_mm256_madd_epi16 (lo, lo),
+					 _mm256_madd_epi16 (hi, hi));
+	  vmin = _mm256_min_epu8 (vmin, v);
+	  vmax = _mm256_max_epu8 (vmax, v);
+	  vsum = _mm256_add_epi64 (vsum, _mm256_sad_epu8 (v, zero));
+	  vsq = _mm256_add_epi64 (vsq, _mm256_unpacklo_epi32 (sq, zero));
+	  vsq = _mm256_add_epi64 (vsq, _mm256_unpackhi_epi32 (sq, zero));
+      }
+    _mm256_storeu_si256 ((__m256i *) lmin, vmin);
+    _mm256_storeu_si256 ((__m256i *) lmax, vmax);
+    _mm256_storeu_si256 ((__m256i *) lsum, vsum);
+    _mm256_storeu_si256 ((__m256i *) lsq, vsq);
+    if (done > 0)
+	reduce_accumulator (lmin, lmax, 32, 1, lsum, lsq, 4, acc);
+    return done;
+}
+
+static int accumulate_u16_avx2 (const unsigned short *in, int count,
+				rl2IntAccumulator * acc)
+    __attribute__ ((target ("avx2")));
+
+static int
+accumulate_u16_avx2 (const unsigned short *in, int count,
+		     rl2IntAccumulator * acc)
+{
+/* accumulating UINT16 samples - AVX2; returns the number of samples done */
+    int done;
+    __m256i zero = _mm256_setzero_si256 ();
+    __m256i vmin = _mm256_set1_epi16 ((short) 0xffff);
+    __m256i vmax = zero;
+    __m256i vsum = zero;
+    __m256i vsq = zero;
+    unsigned short lmin[16];
+    unsigned short lmax[16];
+    unsigned long long lsum[4];
+    unsigned long long lsq[4];
+    for (done = 0; done + 16 <= count; done += 16)
+      {
+	  __m256i v = _mm256_loadu_si256 ((const __m256i *) (in + done));
+	  __m256i lo = _mm256_unpacklo_epi16 (v, zero);
+	  __m256i hi = _mm256_unpackhi_epi16 (v, zero);
+	  __m256i s = _mm256_add_epi32 (lo, hi);
+	  vmin = _mm256_min_epu16 (vmin, v);
+	  vmax = _mm256_max_epu16 (vmax, v);
+	  vsum = _mm256_add_epi64 (vsum, _mm256_unpacklo_epi32 (s, zero));
+	  vsum = _mm256_add_epi64 (vsum, _mm256_unpackhi_epi32 (s, zero));
+	  vsq = _mm256_add_epi64 (vsq, _mm256_mul_epu32 (lo, lo));
+	  lo = _mm256_srli_epi64 (lo, 32);
+	  vsq = _mm256_add_epi64 (vsq, _mm256_mul_epu32 (lo, lo));
+	  vsq = _mm256_add_epi64 (vsq, _mm256_mul_epu32 (hi, hi));
+	  hi = _mm256_srli_epi64 (hi, 32);
+	  vsq = _mm256_add_epi64 (vsq, _mm256_mul_epu32 (hi, hi));
+      }
+    _mm256_storeu_si256 ((__m256i *) lmin, vmin);
+    _mm256_storeu_si256 ((__m256i *) lmax, vmax);
+    _mm256_storeu_si256 ((__m256i *) lsum, vsum);
+    _mm256_storeu_si256 ((__m256i *) lsq, vsq);
+    if (done > 0)
+	reduce_accumulator ((unsigned char *) lmin, (unsigned char *) lmax,
+			    16, 2, lsum, lsq, 4, acc);
+    return done;
+}
+#endif
+
+#ifdef RL2_SIMD_NEON
+static int
+accumulate_u8_neon (const unsigned char *in, int count,
+		    rl2IntAccumulator * acc)
+{
+/* accumulating UINT8 samples - NEON; returns the number of samples done */
+    int done;
+    uint8x16_t vmin = vdupq_n_u8 (0xff);
+    uint8x16_t vmax = vdupq_n_u8 (0);
+    uint64x2_t vsum = vdupq_n_u64 (0);
+    uint64x2_t vsq = vdupq_n_u64 (0);
+    unsigned char lmin[16];
+    unsigned char lmax[16];
+    unsigned long long lsum[2];
+    unsigned long long lsq[2];
+    for (done = 0; done + 16 <= count; done += 16)
+      {
+	  uint8x16_t v = vld1q_u8 (in + done);
+	  uint16x8_t lo = vmull_u8 (vget_low_u8 (v), vget_low_u8 (v));
+	  uint16x8_t hi = vmull_u8 (vget_high_u8 (v), vget_high_u8 (v));
+	  uint32x4_t sq = vaddq_u32 (vpaddlq_u16 (lo), vpaddlq_u16 (hi));
+	  vmin = vminq_u8 (vmin, v);
+	  vmax = vmaxq_u8 (vmax, v);
+	  vsum = vaddq_u64 (vsum, vpaddlq_u32 (vpaddlq_u16 (vpaddlq_u8 (v))));
+	  vsq = vaddq_u64 (vsq, vpaddlq_u32 (sq));
+      }
+    vst1q_u8 (lmin, vmin);
+    vst1q_u8 (lmax, vmax);
+    vst1q_u64 ((uint64_t *) lsum, vsum);
+    vst1q_u64 ((uint64_t *) lsq, vsq);
+    if (done > 0)
+	reduce_accumulator (lmin, lmax, 16, 1, lsum, lsq, 2, acc);
+    return done;
+}
+
+static int
+accumulate_u16_neon (const unsigned short *in, int count,
+		     rl2IntAccumulator * acc)
+{
+/* accumulating UINT16 samples - NEON; returns the number of samples done */
+    int done;
+    uint16x8_t vmin = vdupq_n_u16 (0xffff);
+    uint16x8_t vmax = vdupq_n_u16 (0);
+    uint64x2_t vsum = vdupq_n_u64 (0);
+    uint64x2_t vsq = vdupq_n_u64 (0);
+    unsigned short lmin[8];
+    unsigned short lmax[8];
+    unsigned long long lsum[2];
+    unsigned long long lsq[2];
+    for (done = 0; done + 8 <= count; done += 8)
+      {
+	  uint16x8_t v = vld1q_u16 (in + done);
+	  uint32x4_t lo = vmull_u16 (vget_low_u16 (v), vget_low_u16 (v));
+	  uint32x4_t hi = vmull_u16 (vget_high_u16 (v), vget_high_u16 (v));
+	  vmin = vminq_u16 (vmin, v);
+	  vmax = vmaxq_u16 (vmax, v);
+	  vsum = vaddq_u64 (vsum, vpaddlq_u32 (vpaddlq_u16 (v)));
+	  vsq = vaddq_u64 (vsq, vpaddlq_u32 (lo));
+	  vsq = vaddq_u64 (vsq, vpaddlq_u32 (hi));
+      }
+    vst1q_u16 (lmin, vmin);
+    vst1q_u16 (lmax, vmax);
+    vst1q_u64 ((uint64_t *) lsum, vsum);
+    vst1q_u64 ((uint64_t *) lsq, vsq);
+    if (done > 0)
+	reduce_accumulator ((unsigned char *) lmin, (unsigned char *) lmax,
+			    8, 2, lsum, lsq, 2, acc);
+    return done;
+}
+#endif
+
+static void
+accumulate_chunk (const unsigned char *in, int count, int sample_size,
+		  int stride, rl2IntAccumulator * acc)
+{
+/* accumulating a chunk of samples, SIMD kernels being contiguous only */
+    int done = 0;
+    if (stride == 1)
+      {
+	  switch (simd_level ())
+	    {
+#ifdef RL2_SIMD_AVX2
+	    case RL2_SIMD_AVX2_LEVEL:
+		if (sample_size == 1)
+		    done = accumulate_u8_avx2 (in, count, acc);
+		else
+		    done =
+			accumulate_u16_avx2 ((const unsigned short *) in,
+					     count, acc);
+		break;
+#endif
+#ifdef RL2_SIMD_SSE2
+	    case RL2_SIMD_SSE2_LEVEL:
+		if (sample_size == 1)
+		    done = accumulate_u8_sse2 (in, count, acc);
+		else
+		    done =
+			accumulate_u16_sse2 ((const unsigned short *) in,
+					     count, acc);
+		break;
+#endif
+#ifdef RL2_SIMD_NEON
+	    case RL2_SIMD_NEON_LEVEL:
+		if (sample_size == 1)
+		    done = accumulate_u8_neon (in, count, acc);
+		else
+		    done =
+			accumulate_u16_neon ((const unsigned short *) in,
+					     count, acc);
+		break;
+#endif
+	    };
+      }
+    in += done * sample_size;
+    count -= done;
+    if (sample_size == 1)
+	accumulate_u8_c (in, count, stride, acc);
+    else
+	accumulate_u16_c ((const unsigned short *) in, count, stride, acc);
+}
+
+RL2_PRIVATE void
+rl2_simd_accumulate (const void *in, int count, int sample_size, int stride,
+		     rl2SampleAccumulatorPtr acc)
+{
+/*
+/ accumulating "count" UINT8 or UINT16 samples (taking one sample
+/ every "stride") into a zero-shifted accumulator
+/ the integer sums are exact; they are flushed into the accumulator
+/ every RL2_ACCUMULATE_CHUNK samples so to never overflow
+*/
+    const unsigned char *p_in = in;
+    rl2IntAccumulator chunk;
+    int n;
+    if (sample_size != 1 && sample_size != 2)
+	return;
+    while (count > 0)
+      {
+	  n = count;
+	  if (n > RL2_ACCUMULATE_CHUNK)
+	      n = RL2_ACCUMULATE_CHUNK;
+	  chunk.min = 0xffffffff;
+	  chunk.max = 0;
+	  chunk.sum = 0;
+	  chunk.sum_sq = 0;
+	  accumulate_chunk (p_in, n, sample_size, stride, &chunk);
+	  if ((double) (chunk.min) < acc->min)
+	      acc->min = chunk.min;
+	  if ((double) (chunk.max) > acc->max)
+	      acc->max = chunk.max;
+	  acc->count += n;
+	  acc->sum += (double) (chunk.sum);
+	  acc->sum_sq += (double) (chunk.sum_sq);
+	  p_in += (size_t) (n * stride * sample_size);
+	  count -= n;
+      }
+}
+
+/*
+/
+/ box filter kernels: reducing a DataGrid or MultiBand tile by
+/ averaging the valid samples of each "factor x factor" block
+/
+/ 8 and 16 bit samples are summed as exact integers: the block rows
+/ are first accumulated column by column (SIMD) and then folded
+/ horizontally; any other case is accumulated in double precision,
+/ adding the samples in the same order as the per-pixel reducers did
+/
+*/
+
+#define RL2_BOX_MAX_FACTOR	64
+
+static int
+box_sample_size (unsigned char sample_type)
+{
+/* returning the size (in bytes) of a single sample */
+    switch (sample_type)
+      {
+      case RL2_SAMPLE_INT16:
+      case RL2_SAMPLE_UINT16:
+	  return 2;
+      case RL2_SAMPLE_INT32:
+      case RL2_SAMPLE_UINT32:
+      case RL2_SAMPLE_FLOAT:
+	  return 4;
+      case RL2_SAMPLE_DOUBLE:
+	  return 8;
+      };
+    return 1;
+}
+
+RL2_PRIVATE double
+rl2_box_sample_value (const rl2PrivSample * sample,
+		      unsigned char sample_type)
+{
+/* returning a NO-DATA sample as a double */
+    switch (sample_type)
+      {
+      case RL2_SAMPLE_INT8:
+	  return sample->int8;
+      case RL2_SAMPLE_UINT8:
+	  return sample->uint8;
+      case RL2_SAMPLE_INT16:
+	  return sample->int16;
+      case RL2_SAMPLE_UINT16:
+	  return sample->uint16;
+      case RL2_SAMPLE_INT32:
+	  return sample->int32;
+      case RL2_SAMPLE_UINT32:
+	  return sample->uint32;
+      case RL2_SAMPLE_FLOAT:
+	  return sample->float32;
+      case RL2_SAMPLE_DOUBLE:
+	  return sample->float64;
+      };
+    return 0.0;
+}
+
+static int
+box_int_sample (const void *in, size_t idx, unsigned char sample_type)
+{
+/* returning an 8 or 16 bit sample as an int */
+    switch (sample_type)
+      {
+      case RL2_SAMPLE_INT8:
+	  return *((const char *) in + idx);
+      case RL2_SAMPLE_UINT8:
+	  return *((const unsigned char *) in + idx);
+      case RL2_SAMPLE_INT16:
+	  return *((const short *) in + idx);
+      case RL2_SAMPLE_UINT16:
+	  return *((const unsigned short *) in + idx);
+      };
+    return 0;
+}
+
+static void
+box_store (void *out, size_t idx, unsigned char sample_type, double value)
+{
+/* storing a single output sample */
+    switch (sample_type)
+      {
+      case RL2_SAMPLE_INT8:
+	  *((char *) out + idx) = (char) value;
+	  break;
+      case RL2_SAMPLE_UINT8:
+	  *((unsigned char *) out + idx) = (unsigned char) value;
+	  break;
+      case RL2_SAMPLE_INT16:
+	  *((short *) out + idx) = (short) value;
+	  break;
+      case RL2_SAMPLE_UINT16:
+	  *((unsigned short *) out + idx) = (unsigned short) value;
+	  break;
+      case RL2_SAMPLE_INT32:
+	  *((int *) out + idx) = (int) value;
+	  break;
+      case RL2_SAMPLE_UINT32:
+	  *((unsigned int *) out + idx) = (unsigned int) value;
+	  break;
+      case RL2_SAMPLE_FLOAT:
+	  *((float *) out + idx) = (float) value;
+	  break;
+      case RL2_SAMPLE_DOUBLE:
+	  *((double *) out + idx) = value;
+	  break;
+      };
+}
+
+static unsigned int
+box_block_rows (rl2BoxFilterPtr flt, unsigned int oy)
+{
+/* returning how many input rows are covered by some output row */
+    unsigned int y0 = oy * flt->factor;
+    unsigned int rows;
+    if (y0 >= flt->in_height)
+	return 0;
+    rows = flt->in_height - y0;
+    if (rows > flt->factor)
+	rows = flt->factor;
+    return rows;
+}
+
+static unsigned int
+box_block_cols (rl2BoxFilterPtr flt, unsigned int ox)
+{
+/* returning how many input columns are covered by some output column */
+    unsigned int x0 = ox * flt->factor;
+    unsigned int cols;
+    if (x0 >= flt->in_width)
+	return 0;
+    cols = flt->in_width - x0;
+    if (cols > flt->factor)
+	cols = flt->factor;
+    return cols;
+}
+
+static void
+box_columns_c (const void *in, unsigned int stride, unsigned int rows,
+	       unsigned int start, unsigned int count,
+	       unsigned char sample_type, int nd, int *sum, int *cnt)
+{
+/* accumulating the block rows column by column - portable C */
+    unsigned int r;
+    unsigned int i;
+    int v;
+    for (i = start; i < start + count; i++)
+      {
+	  sum[i] = 0;
+	  cnt[i] = 0;
+	  for (r = 0; r < rows; r++)
+	    {
+		v = box_int_sample (in, (size_t) r * stride + i, sample_type);
+		if (v == nd)
+		    continue;
+		sum[i] += v;
+		cnt[i] += 1;
+	    }
+      }
+}
+
+#ifdef RL2_SIMD_SSE2
+static unsigned int
+box_columns8_sse2 (const unsigned char *in, unsigned int stride,
+		   unsigned int rows, unsigned int count, int is_signed,
+		   int nd, int *sum, int *cnt)
+{
+/* accumulating the block rows column by column - 8 bit SSE2 */
+    unsigned int done;
+    unsigned int r;
+    __m128i zero = _mm_setzero_si128 ();
+    __m128i vnd = _mm_set1_epi8 ((char) nd);
+    __m128i vrows = _mm_set1_epi32 ((int) rows);
+    for (done = 0; done + 16 <= count; done += 16)
+      {
+	  const unsigned char *p = in + done;
+	  __m128i lo = zero;
+	  __m128i hi = zero;
+	  __m128i miss = zero;
+	  __m128i ext;
+	  __m128i m;
+	  for (r = 0; r < rows; r++, p += stride)
+	    {
+		__m128i v = _mm_loadu_si128 ((const __m128i *) p);
+		__m128i eq = _mm_cmpeq_epi8 (v, vnd);
+		v = _mm_andnot_si128 (eq, v);
+		ext = is_signed ? _mm_cmpgt_epi8 (zero, v) : zero;
+		lo = _mm_add_epi16 (lo, _mm_unpacklo_epi8 (v, ext));
+		hi = _mm_add_epi16 (hi, _mm_unpackhi_epi8 (v, ext));
+		miss = _mm_sub_epi8 (miss, eq);
+	    }
+	  /* the 16 bit sums never exceed +/- (64 * 255) */
+	  ext = _mm_srai_epi16 (lo, 15);
+	  _mm_storeu_si128 ((__m128i *) (sum + done),
+			    _mm_unpacklo_epi16 (lo, ext));
+	  _mm_storeu_si128 ((__m128i *) (sum + done + 4),
+			    _mm_unpackhi_epi16 (lo, ext));
+	  ext = _mm_srai_epi16 (hi, 15);
+	  _mm_storeu_si128 ((__m128i *) (sum + done + 8),
+			    _mm_unpacklo_epi16 (hi, ext));
+	  _mm_storeu_si128 ((__m128i *) (sum + done + 12),
+			    _mm_unpackhi_epi16 (hi, ext));
+	  m = _mm_unpacklo_epi8 (miss, zero);
+	  _mm_storeu_si128 ((__m128i *) (cnt + done),
+			    _mm_sub_epi32 (vrows, _mm_unpacklo_epi16 (m, zero)));
+	  _mm_storeu_si128 ((__m128i *) (cnt + done + 4),
+			    _mm_sub_epi32 (vrows, _mm_unpackhi_epi16 (m, zero)));
+	  m = _mm_unpackhi_epi8 (miss, zero);
+	  _mm_storeu_si128 ((__m128i *) (cnt + done + 8),
+			    _mm_sub_epi32 (vrows, _mm_unpacklo_epi16 (m, zero)));
+	  _mm_storeu_si128 ((__m128i *) (cnt + done + 12),
+			    _mm_sub_epi32 (vrows, _mm_unpackhi_epi16 (m, zero)));
+      }
+    return done;
+}
+
+static unsigned int
+box_columns16_sse2 (const unsigned short *in, unsigned int stride,
+		    unsigned int rows, unsigned int count, int is_signed,
+		    int nd, int *sum, int *cnt)
+{
+/* accumulating the block rows column by column - 16 bit SSE2 */
+    unsigned int done;
+    unsigned int r;
+    __m128i zero = _mm_setzero_si128 ();
+    __m128i vnd = _mm_set1_epi16 ((short) nd);
+    __m128i vrows = _mm_set1_epi32 ((int) rows);
+    for (done = 0; done + 8 <= count; done += 8)
+      {
+	  const unsigned short *p = in + done;
+	  __m128i lo = zero;
+	  __m128i hi = zero;
+	  __m128i miss = zero;
+	  for (r = 0; r < rows; r++, p += stride)
+	    {
+		__m128i v = _mm_loadu_si128 ((const __m128i *) p);
+		__m128i eq = _mm_cmpeq_epi16 (v, vnd);
+		__m128i ext;
+		v = _mm_andnot_si128 (eq, v);
+		ext = is_signed ? _mm_srai_epi16 (v, 15) : zero;
+		lo = _mm_add_epi32 (lo, _mm_unpacklo_epi16 (v, ext));
+		hi = _mm_add_epi32 (hi, _mm_unpackhi_epi16 (v, ext));
+		miss = _mm_sub_epi16 (miss, eq);
+	    }
+	  _mm_storeu_si128 ((__m128i *) (sum + done), lo);
+	  _mm_storeu_si128 ((__m128i *) (sum + done + 4), hi);
+	  _mm_storeu_si128 ((__m128i *) (cnt + done),
+			    _mm_sub_epi32 (vrows,
+					   _mm_unpacklo_epi16 (miss, zero)));
+	  _mm_storeu_si128 ((__m128i *) (cnt + done + 4),
+			    _mm_sub_epi32 (vrows,
+					   _mm_unpackhi_epi16 (miss, zero)));
+      }
+    return done;
+}
+#endif
+
+#ifdef RL2_SIMD_NEON
+static unsigned int
+box_columns8_neon (const unsigned char *in, unsigned int stride,
+		   unsigned int rows, unsigned int count, int is_signed,
+		   int nd, int *sum, int *cnt)
+{
+/* accumulating the block rows column by column - 8 bit NEON */
+    unsigned int done;
+    unsigned int r;
+    uint8x16_t vnd = vdupq_n_u8 ((unsigned char) nd);
+    int32x4_t vrows = vdupq_n_s32 ((int) rows);
+    for (done = 0; done + 16 <= count; done += 16)
+      {
+	  const unsigned char *p = in + done;
+	  int16x8_t lo = vdupq_n_s16 (0);
+	  int16x8_t hi = vdupq_n_s16 (0);
+	  uint8x16_t miss = vdupq_n_u8 (0);
+	  uint16x8_t m;
+	  for (r = 0; r < rows; r++, p += stride)
+	    {
+		uint8x16_t v = vld1q_u8 (p);
+		uint8x16_t eq = vceqq_u8 (v, vnd);
+		v = vbicq_u8 (v, eq);
+		if (is_signed)
+		  {
+		      int8x16_t s = vreinterpretq_s8_u8 (v);
+		      lo = vaddq_s16 (lo, vmovl_s8 (vget_low_s8 (s)));
+		      hi = vaddq_s16 (hi, vmovl_s8 (vget_high_s8 (s)));
+		  }
+		else
+		  {
+		      lo = vaddq_s16 (lo,
+				      vreinterpretq_s16_u16 (vmovl_u8
+							     (vget_low_u8
+							      (v))));
+		      hi = vaddq_s16 (hi,
+				      vreinterpretq_s16_u16 (vmovl_u8
+							     (vget_high_u8
+							      (v))));
+		  }
+		miss = vsubq_u8 (miss, eq);
+	    }
+	  vst1q_s32 (sum + done, vmovl_s16 (vget_low_s16 (lo)));
+	  vst1q_s32 (sum + done + 4, vmovl_s16 (vget_high_s16 (lo)));
+	  vst1q_s32 (sum + done + 8, vmovl_s16 (vget_low_s16 (hi)));
+	  vst1q_s32 (sum + done + 12, vmovl_s16 (vget_high_s16 (hi)));
+	  m = vmovl_u8 (vget_low_u8 (miss));
+	  vst1q_s32 (cnt + done,
+		     vsubq_s32 (vrows,
+				vreinterpretq_s32_u32 (vmovl_u16
+						       (vget_low_u16 (m)))));
+	  vst1q_s32 (cnt + done + 4,
+		     vsubq_s32 (vrows,
+				vreinterpretq_s32_u32 (vmovl_u16
+						       (vget_high_u16 (m)))));
+	  m = vmovl_u8 (vget_high_u8 (miss));
+	  vst1q_s32 (cnt + done + 8,
+		     vsubq_s32 (vrows,
+				vreinterpretq_s32_u32 (vmovl_u16
+						       (vget_low_u16 (m)))));
+	  vst1q_s32 (cnt + done + 12,
+		     vsubq_s32 (vrows,
+				vreinterpretq_s32_u32 (vmovl_u16
+						       (vget_high_u16 (m)))));
+      }
+    return done;
+}
+
+static unsigned int
+box_columns16_neon (const unsigned short *in, unsigned int stride,
+		    unsigned int rows, unsigned int count, int is_signed,
+		    int nd, int *sum, int *cnt)
+{
+/* accumulating the block rows column by column - 16 bit NEON */
+    unsigned int done;
+    unsigned int r;
+    uint16x8_t vnd = vdupq_n_u16 ((unsigned short) nd);
+    int32x4_t vrows = vdupq_n_s32 ((int) rows);
+    for (done = 0; done + 8 <= count; done += 8)
+      {
+	  const unsigned short *p = in + done;
+	  int32x4_t lo = vdupq_n_s32 (0);
+	  int32x4_t hi = vdupq_n_s32 (0);
+	  uint16x8_t miss = vdupq_n_u16 (0);
+	  for (r = 0; r < rows; r++, p += stride)
+	    {
+		uint16x8_t v = vld1q_u16 (p);
+		uint16x8_t eq = vceqq_u16 (v, vnd);
+		v = vbicq_u16 (v, eq);
+		if (is_signed)
+		  {
+		      int16x8_t s = vreinterpretq_s16_u16 (v);
+		      lo = vaddq_s32 (lo, vmovl_s16 (vget_low_s16 (s)));
+		      hi = vaddq_s32 (hi, vmovl_s16 (vget_high_s16 (s)));
+		  }
+		else
+		  {
+		      lo = vaddq_s32 (lo,
+				      vreinterpretq_s32_u32 (vmovl_u16
+							     (vget_low_u16
+							      (v))));
+		      hi = vaddq_s32 (hi,
+				      vreinterpretq_s32_u32 (vmovl_u16
+							     (vget_high_u16
+							      (v))));
+		  }
+		miss = vsubq_u16 (miss, eq);
+	    }
+	  vst1q_s32 (sum + done, lo);
+	  vst1q_s32 (sum + done + 4, hi);
+	  vst1q_s32 (cnt + done,
+		     vsubq_s32 (vrows,
+				vreinterpretq_s32_u32 (vmovl_u16
+						       (vget_low_u16 (miss)))));
+	  vst1q_s32 (cnt + done + 4,
+		     vsubq_s32 (vrows,
+				vreinterpretq_s32_u32 (vmovl_u16
+						       (vget_high_u16
+							(miss)))));
+      }
+    return done;
+}
+#endif
+
+static unsigned int
+box_columns_simd (const void *in, unsigned int stride, unsigned int rows,
+		  unsigned int count, unsigned char sample_type, int nd,
+		  int *sum, int *cnt)
+{
+/* accumulating the block rows column by column; returns the columns done */
+    int is_signed = (sample_type == RL2_SAMPLE_INT8
+		     || sample_type == RL2_SAMPLE_INT16) ? 1 : 0;
+    int sample_size = box_sample_size (sample_type);
+    switch (simd_level ())
+      {
+#ifdef RL2_SIMD_SSE2
+      case RL2_SIMD_AVX2_LEVEL:
+      case RL2_SIMD_SSE2_LEVEL:
+	  if (sample_size == 1)
+	      return box_columns8_sse2 (in, stride, rows, count, is_signed, nd,
+					sum, cnt);
+	  return box_columns16_sse2 (in, stride, rows, count, is_signed, nd,
+				     sum, cnt);
+#endif
+#ifdef RL2_SIMD_NEON
+      case RL2_SIMD_NEON_LEVEL:
+	  if (sample_size == 1)
+	      return box_columns8_neon (in, stride, rows, count, is_signed, nd,
+					sum, cnt);
+	  return box_columns16_neon (in, stride, rows, count, is_signed, nd,
+				     sum, cnt);
+#endif
+      };
+    return 0;
+}
+
+static int
+box_use_integers (rl2BoxFilterPtr flt)
+{
+/* checking if the exact integer kernels apply */
+    int ib;
+    double nd;
+    if (simd_level () == RL2_SIMD_NONE)
+	return 0;
+    switch (flt->sample_type)
+      {
+      case RL2_SAMPLE_INT8:
+      case RL2_SAMPLE_UINT8:
+      case RL2_SAMPLE_INT16:
+      case RL2_SAMPLE_UINT16:
+	  break;
+      default:
+	  return 0;
+      };
+    if (flt->factor > RL2_BOX_MAX_FACTOR || flt->mask_in != NULL
+	|| flt->no_data == NULL)
+	return 0;
+    if (flt->pixel_nodata && flt->num_bands > 1)
+	return 0;
+    /* all bands must share the same NO-DATA value */
+    nd = rl2_box_sample_value (flt->no_data, flt->sample_type);
+    for (ib = 1; ib < flt->num_bands; ib++)
+      {
+	  if (rl2_box_sample_value (flt->no_data + ib, flt->sample_type) != nd)
+	      return 0;
+      }
+    return 1;
+}
+
+static int
+box_reduce_int (rl2BoxFilterPtr flt)
+{
+/* box filter - 8 and 16 bit samples, exact integer sums */
+    int nb = flt->num_bands;
+    unsigned int n = flt->in_width * nb;
+    int sample_size = box_sample_size (flt->sample_type);
+    int nd = (int) rl2_box_sample_value (flt->no_data, flt->sample_type);
+    int *sum;
+    int *cnt;
+    unsigned int ox;
+    unsigned int oy;
+    unsigned int x;
+    unsigned int rows;
+    unsigned int cols;
+    unsigned int done;
+    int ib;
+
+    sum = malloc (sizeof (int) * n * 2);
+    if (sum == NULL)
+	return RL2_ERROR;
+    cnt = sum + n;
+    for (oy = 0; oy < flt->out_height; oy++)
+      {
+	  rows = box_block_rows (flt, oy);
+	  if (rows > 0)
+	    {
+		const unsigned char *p_in = (const unsigned char *) (flt->in) +
+		    ((size_t) oy * flt->factor * n * sample_size);
+		done =
+		    box_columns_simd (p_in, n, rows, n, flt->sample_type, nd,
+				      sum, cnt);
+		box_columns_c (p_in, n, rows, done, n - done,
+			       flt->sample_type, nd, sum, cnt);
+	    }
+	  for (ox = 0; ox < flt->out_width; ox++)
+	    {
+		size_t idx = ((size_t) oy * flt->out_stride + ox) * nb;
+		unsigned int x0 = ox * flt->factor;
+		int total;
+		int ok = 0;
+		cols = (rows > 0) ? box_block_cols (flt, ox) : 0;
+		total = rows * cols;
+		for (ib = 0; ib < nb; ib++)
+		  {
+		      int s = 0;
+		      int valid = 0;
+		      for (x = x0; x < x0 + cols; x++)
+			{
+			    s += sum[x * nb + ib];
+			    valid += cnt[x * nb + ib];
+			}
+		      if (total - valid >= valid)
+			{
+			    /* NO-DATA */
+			    if (flt->mask_out == NULL)
+				box_store (flt->out, idx + ib, flt->sample_type,
+					   nd);
+			    continue;
+			}
+		      box_store (flt->out, idx + ib, flt->sample_type,
+				 s / valid);
+		      ok = 1;
+		  }
+		if (ok && flt->mask_out != NULL)
+		    *(flt->mask_out + ((size_t) oy * flt->out_stride) + ox) =
+			1;
+	    }
+      }
+    free (sum);
+    return RL2_OK;
+}
+
+RL2_PRIVATE void
+rl2_box_widen_row (const void *in, size_t offset, unsigned int count,
+		   unsigned char sample_type, double *vals)
+{
+/* widening a row of samples to double precision */
+    unsigned int i;
+    switch (sample_type)
+      {
+      case RL2_SAMPLE_INT8:
+	  for (i = 0; i < count; i++)
+	      vals[i] = *((const char *) in + offset + i);
+	  break;
+      case RL2_SAMPLE_UINT8:
+	  for (i = 0; i < count; i++)
+	      vals[i] = *((const unsigned char *) in + offset + i);
+	  break;
+      case RL2_SAMPLE_INT16:
+	  for (i = 0; i < count; i++)
+	      vals[i] = *((const short *) in + offset + i);
+	  break;
+      case RL2_SAMPLE_UINT16:
+	  for (i = 0; i < count; i++)
+	      vals[i] = *((const unsigned short *) in + offset + i);
+	  break;
+      case RL2_SAMPLE_INT32:
+	  for (i = 0; i < count; i++)
+	      vals[i] = *((const int *) in + offset + i);
+	  break;
+      case RL2_SAMPLE_UINT32:
+	  for (i = 0; i < count; i++)
+	      vals[i] = *((const unsigned int *) in + offset + i);
+	  break;
+      case RL2_SAMPLE_FLOAT:
+	  for (i = 0; i < count; i++)
+	      vals[i] = *((const float *) in + offset + i);
+	  break;
+      case RL2_SAMPLE_DOUBLE:
+	  memcpy (vals, (const double *) in + offset, sizeof (double) * count);
+	  break;
+      };
+}
+
+RL2_PRIVATE void
+rl2_box_check_row (rl2BoxFilterPtr flt, unsigned int y, const double *vals,
+		   const double *nd, unsigned char *ok)
+{
+/* flagging the valid samples of a row */
+    int nb = flt->num_bands;
+    unsigned int x;
+    int ib;
+    int valid;
+    for (x = 0; x < flt->in_width; x++, vals += nb, ok += nb)
+      {
+	  if (flt->mask_in != NULL)
+	    {
+		/* checking the transparency mask */
+		if (*(flt->mask_in + ((size_t) y * flt->in_width) + x) == 0)
+		  {
+		      memset (ok, 0, nb);
+		      continue;
+		  }
+	    }
+	  if (nd == NULL)
+	    {
+		memset (ok, 1, nb);
+		continue;
+	    }
+	  if (flt->pixel_nodata)
+	    {
+		/* the whole pixel has to match NO-DATA */
+		valid = 0;
+		for (ib = 0; ib < nb; ib++)
+		  {
+		      if (vals[ib] != nd[ib])
+			  valid = 1;
+		  }
+		memset (ok, valid, nb);
+		continue;
+	    }
+	  for (ib = 0; ib < nb; ib++)
+	      ok[ib] = (vals[ib] == nd[ib]) ? 0 : 1;
+      }
+}
+
+static int
+box_reduce_double (rl2BoxFilterPtr flt)
+{
+/* box filter - any sample type, double precision sums */
+    int nb = flt->num_bands;
+    unsigned int n_in = flt->in_width * nb;
+    unsigned int n_out = flt->out_width * nb;
+    double *nd = NULL;
+    double *vals = NULL;
+    double *sum = NULL;
+    int *valid = NULL;
+    unsigned char *ok = NULL;
+    unsigned int ox;
+    unsigned int oy;
+    unsigned int x;
+    unsigned int r;
+    unsigned int i;
+    unsigned int rows;
+    unsigned int cols;
+    int ib;
+    int retcode = RL2_ERROR;
+
+    vals = malloc (sizeof (double) * n_in);
+    sum = malloc (sizeof (double) * n_out);
+    valid = malloc (sizeof (int) * n_out);
+    ok = malloc (n_in);
+    if (vals == NULL || sum == NULL || valid == NULL || ok == NULL)
+	goto error;
+    if (flt->no_data != NULL)
+      {
+	  nd = malloc (sizeof (double) * nb);
+	  if (nd == NULL)
+	      goto error;
+	  for (ib = 0; ib < nb; ib++)
+	      nd[ib] =
+		  rl2_box_sample_value (flt->no_data + ib, flt->sample_type);
+      }
+
+    for (oy = 0; oy < flt->out_height; oy++)
+      {
+	  rows = box_block_rows (flt, oy);
+	  for (i = 0; i < n_out; i++)
+	    {
+		sum[i] = 0.0;
+		valid[i] = 0;
+	    }
+	  for (r = 0; r < rows; r++)
+	    {
+		unsigned int y = (oy * flt->factor) + r;
+		rl2_box_widen_row (flt->in, (size_t) y * n_in, n_in,
+				   flt->sample_type, vals);
+		rl2_box_check_row (flt, y, vals, nd, ok);
+		for (ox = 0; ox < flt->out_width; ox++)
+		  {
+		      unsigned int x0 = ox * flt->factor;
+		      cols = box_block_cols (flt, ox);
+		      for (x = x0; x < x0 + cols; x++)
+			{
+			    for (ib = 0; ib < nb; ib++)
+			      {
+				  i = (x * nb) + ib;
+				  if (!ok[i])
+				      continue;
+				  sum[(ox * nb) + ib] += vals[i];
+				  valid[(ox * nb) + ib] += 1;
+			      }
+			}
+		  }
+	    }
+	  for (ox = 0; ox < flt->out_width; ox++)
+	    {
+		size_t idx = ((size_t) oy * flt->out_stride + ox) * nb;
+		int total;
+		int done = 0;
+		cols = box_block_cols (flt, ox);
+		total = rows * cols;
+		for (ib = 0; ib < nb; ib++)
+		  {
+		      int v = valid[(ox * nb) + ib];
+		      if (total - v >= v)
+			{
+			    /* NO-DATA */
+			    if (flt->mask_out == NULL)
+				box_store (flt->out, idx + ib,
+					   flt->sample_type,
+					   (nd == NULL) ? 0.0 : nd[ib]);
+			    continue;
+			}
+		      box_store (flt->out, idx + ib, flt->sample_type,
+				 sum[(ox * nb) + ib] / (double) v);
+		      done = 1;
+		  }
+		if (done && flt->mask_out != NULL)
+		    *(flt->mask_out + ((size_t) oy * flt->out_stride) + ox) =
+			1;
+	    }
+      }
+    retcode = RL2_OK;
+
+  error:
+    if (nd != NULL)
+	free (nd);
+    if (vals != NULL)
+	free (vals);
+    if (sum != NULL)
+	free (sum);
+    if (valid != NULL)
+	free (valid);
+    if (ok != NULL)
+	free (ok);
+    return retcode;
+}
+
+RL2_PRIVATE int
+rl2_box_reduce (rl2BoxFilterPtr flt)
+{
+/*
+/ reducing a DataGrid or MultiBand tile: each output pixel is the
+/ average of the valid samples found in the corresponding block
+/ it becomes NO-DATA when invalid samples are at least as many as
+/ the valid ones; in this case the output is left untouched if a
+/ transparency mask is being built, otherwise NO-DATA is written
+*/
+    if (flt == NULL)
+	return RL2_ERROR;
+    if (flt->in == NULL || flt->out == NULL || flt->factor < 1
+	|| flt->num_bands < 1)
+	return RL2_ERROR;
+    if (box_use_integers (flt))
+	return box_reduce_int (flt);
+    return box_reduce_double (flt);
+}
+
+/*
+/
+/ bit packing kernels: 1, 2 or 4 bit pixels (MSB first) expanded
+/ into one byte per pixel and vice versa
+/
+*/
+
+static unsigned char bits1_table[256][8];
+static unsigned char bits2_table[256][4];
+static unsigned char bits4_table[256][2];
+static unsigned char bits_reverse[256];
+static rl2SimdOnce bits_tables_once = RL2_SIMD_ONCE_INIT;
+
+static void
+bits_build_tables (void)
+{
+/* building the bit expansion lookup tables */
+    int i;
+    int j;
+    unsigned char rev;
+    for (i = 0; i < 256; i++)
+      {
+	  rev = 0;
+	  for (j = 0; j < 8; j++)
+	    {
+		bits1_table[i][j] = (i >> (7 - j)) & 0x01;
+		if (i & (1 << j))
+		    rev |= 0x80 >> j;
+	    }
+	  for (j = 0; j < 4; j++)
+	      bits2_table[i][j] = (i >> (6 - (j * 2))) & 0x03;
+	  bits4_table[i][0] = i >> 4;
+	  bits4_table[i][1] = i & 0x0f;
+	  bits_reverse[i] = rev;
+      }
+}
+
+static void
+bits_init_tables (void)
+{
+/* ensuring that the bit expansion lookup tables are ready (thread safe) */
+    simd_once (&bits_tables_once, bits_build_tables);
+}
+
+static void
+unpack_bits_c (unsigned char *out, const unsigned char *in, int count,
+	       int bits)
+{
+/* expanding packed pixels by table lookup - portable C */
+    switch (bits)
+      {
+      case 1:
+	  for (; count >= 8; count -= 8, out += 8)
+	      memcpy (out, bits1_table[*in++], 8);
+	  if (count > 0)
+	      memcpy (out, bits1_table[*in], count);
+	  break;
+      case 2:
+	  for (; count >= 4; count -= 4, out += 4)
+	      memcpy (out, bits2_table[*in++], 4);
+	  if (count > 0)
+	      memcpy (out, bits2_table[*in], count);
+	  break;
+      case 4:
+	  for (; count >= 2; count -= 2, out += 2)
+	      memcpy (out, bits4_table[*in++], 2);
+	  if (count > 0)
+	      *out = bits4_table[*in][0];
+	  break;
+      };
+}
+
+static void
+pack_bits_c (unsigned char *out, const unsigned char *in, int count,
+	     int bits)
+{
+/*
+/ packing one byte per pixel into 1, 2 or 4 bit pixels - portable C
+/ any 1-bit pixel not being zero is set; out of range 2 and 4 bit
+/ pixels are stored as zero
+*/
+    int ppb = 8 / bits;
+    int max = (1 << bits) - 1;
+    int shift;
+    int i;
+    unsigned char packed;
+    unsigned char pixel;
+    while (count > 0)
+      {
+	  packed = 0x00;
+	  shift = 8 - bits;
+	  for (i = 0; i < ppb && i < count; i++, shift -= bits)
+	    {
+		pixel = *in++;
+		if (bits == 1)
+		  {
+		      if (pixel != 0)
+			  packed |= 0x80 >> i;
+		  }
+		else if (pixel <= max)
+		    packed |= pixel << shift;
+	    }
+	  *out++ = packed;
+	  count -= ppb;
+      }
+}
+
+#ifdef RL2_SIMD_SSE2
+static int
+unpack_bits1_sse2 (unsigned char *out, const unsigned char *in, int count)
+{
+/*
+/ expanding 1-bit pixels - SSE2: each input byte is broadcast over
+/ eight lanes and then tested against the single bits; returns the
+/ number of pixels done
+*/
+    const __m128i bit =
+	_mm_setr_epi8 ((char) 0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01,
+		       (char) 0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01);
+    const __m128i one = _mm_set1_epi8 (1);
+    __m128i v;
+    int done;
+    for (done = 0; done + 16 <= count; done += 16, in += 2)
+      {
+	  v = _mm_cvtsi32_si128 (in[0] | (in[1] << 8));
+	  v = _mm_unpacklo_epi8 (v, v);
+	  v = _mm_unpacklo_epi16 (v, v);
+	  v = _mm_unpacklo_epi32 (v, v);
+	  v = _mm_cmpeq_epi8 (_mm_and_si128 (v, bit), bit);
+	  _mm_storeu_si128 ((__m128i *) (out + done), _mm_and_si128 (v, one));
+      }
+    return done;
+}
+
+static int
+pack_bits1_sse2 (unsigned char *out, const unsigned char *in, int count)
+{
+/*
+/ packing 1-bit pixels - SSE2: the non-zero lanes are collected by
+/ movemask (LSB first) and then bit-reversed; returns the number of
+/ pixels done
+*/
+    const __m128i zero = _mm_setzero_si128 ();
+    __m128i v;
+    int m;
+    int done;
+    for (done = 0; done + 16 <= count; done += 16)
+      {
+	  v = _mm_loadu_si128 ((const __m128i *) (in + done));
+	  m = ~_mm_movemask_epi8 (_mm_cmpeq_epi8 (v, zero));
+	  *out++ = bits_reverse[m & 0xff];
+	  *out++ = bits_reverse[(m >> 8) & 0xff];
+      }
+    return done;
+}
+#endif
+
+#ifdef RL2_SIMD_NEON
+static int
+unpack_bits1_neon (unsigned char *out, const unsigned char *in, int count)
+{
+/*
+/ expanding 1-bit pixels - NEON: each input byte is broadcast over
+/ eight lanes and then tested against the single bits; returns the
+/ number of pixels done
+*/
+    static const unsigned char bits[16] =
+	{ 0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01,
+	0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01
+    };
+    const uint8x16_t bit = vld1q_u8 (bits);
+    const uint8x16_t one = vdupq_n_u8 (1);
+    uint8x16_t v;
+    int done;
+    for (done = 0; done + 16 <= count; done += 16, in += 2)
+      {
+	  v = vcombine_u8 (vdup_n_u8 (in[0]), vdup_n_u8 (in[1]));
+	  vst1q_u8 (out + done, vandq_u8 (vtstq_u8 (v, bit), one));
+      }
+    return done;
+}
+#endif
+
+RL2_PRIVATE void
+rl2_unpack_bits (unsigned char *out, const unsigned char *in, int count,
+		 int bits)
+{
+/* expanding "count" packed 1, 2 or 4 bit pixels to one byte each */
+    int done = 0;
+    bits_init_tables ();
+    if (bits == 1)
+      {
+	  switch (simd_level ())
+	    {
+#ifdef RL2_SIMD_SSE2
+	    case RL2_SIMD_AVX2_LEVEL:
+	    case RL2_SIMD_SSE2_LEVEL:
+		done = unpack_bits1_sse2 (out, in, count);
+		break;
+#endif
+#ifdef RL2_SIMD_NEON
+	    case RL2_SIMD_NEON_LEVEL:
+		done = unpack_bits1_neon (out, in, count);
+		break;
+#endif
+	    };
+      }
+    unpack_bits_c (out + done, in + ((done * bits) / 8), count - done, bits);
+}
+
+RL2_PRIVATE void
+rl2_pack_bits (unsigned char *out, const unsigned char *in, int count,
+	       int bits)
+{
+/*
+/ packing "count" pixels (one byte each) into 1, 2 or 4 bits;
+/ the trailing byte is zero padded
+*/
+    int done = 0;
+    bits_init_tables ();
+    if (bits == 1)
+      {
+	  switch (simd_level ())
+	    {
+#ifdef RL2_SIMD_SSE2
+	    case RL2_SIMD_AVX2_LEVEL:
+	    case RL2_SIMD_SSE2_LEVEL:
+		done = pack_bits1_sse2 (out, in, count);
+		break;
+#endif
+	    };
+      }
+    pack_bits_c (out + ((done * bits) / 8), in + done, count - done, bits);
+}
+
+RL2_PRIVATE void
+rl2_unpack_bits_rgba (unsigned char *out, const unsigned char *in,
+		      int count, int bits, const unsigned char *rgba_lut)
+{
+/*
+/ expanding "count" packed 1, 2 or 4 bit pixels straight into RGBA;
+/ "rgba_lut" holds four bytes (RGBA) for each pixel value, and the
+/ indices are expanded in short runs so to always stay in the L1 cache
+*/
+    unsigned char index[256];
+    int n;
+    int i;
+    while (count > 0)
+      {
+	  n = count;
+	  if (n > 256)
+	      n = 256;
+	  rl2_unpack_bits (index, in, n, bits);
+	  for (i = 0; i < n; i++, out += 4)
+	      memcpy (out, rgba_lut + (index[i] * 4), 4);
+	  in += (n * bits) / 8;
+	  count -= n;
+      }
+}
+
+/*
+/
+/ ByteShuffle: splitting "stride"-sized items into byte planes (and
+/ reassembling them back) for the LZ4 codec and the FloatPredictor
+/
+*/
+
+static void
+shuffle_c (unsigned char *out, const unsigned char *in, int count,
+	   int stride, int done)
+{
+/* splitting the items from "done" to "count" into their byte planes */
+    int i;
+    int b;
+    const unsigned char *p_in;
+    unsigned char *p_out;
+    for (b = 0; b < stride; b++)
+      {
+	  p_in = in + (done * stride) + b;
+	  p_out = out + (b * count) + done;
+	  for (i = done; i < count; i++)
+	    {
+		*p_out++ = *p_in;
+		p_in += stride;
+	    }
+      }
+}
+
+static void
+unshuffle_c (unsigned char *out, const unsigned char *in, int count,
+	     int stride, int done)
+{
+/* reassembling the items from "done" to "count" from their byte planes */
+    int i;
+    int b;
+    const unsigned char *p_in;
+    unsigned char *p_out;
+    for (b = 0; b < stride; b++)
+      {
+	  p_in = in + (b * count) + done;
+	  p_out = out + (done * stride) + b;
+	  for (i = done; i < count; i++)
+	    {
+		*p_out = *p_in++;
+		p_out += stride;
+	    }
+      }
+}
+
+#ifdef RL2_SIMD_SSE2
+static void
+byte_transpose_sse2 (__m128i * v, int stride, int rounds)
+{
+/* 
+/ interleaving "stride" byte registers (2, 4 or 8) as a butterfly
+/ network: 4 rounds split 16 items into their byte planes, while
+/ log2(stride) rounds reassemble the items from their byte planes
+*/
+    __m128i t[8];
+    int half = stride / 2;
+    int r;
+    int k;
+    for (r = 0; r < rounds; r++)
+      {
+	  for (k = 0; k < half; k++)
+	    {
+		t[k * 2] = _mm_unpacklo_epi8 (v[k], v[k + half]);
+		t[k * 2 + 1] = _mm_unpackhi_epi8 (v[k], v[k + half]);
+	    }
+	  for (k = 0; k < stride; k++)
+	      v[k] = t[k];
+      }
+}
+
+static int
+shuffle_sse2 (unsigned char *out, const unsigned char *in, int count,
+	      int stride)
+{
+/* SSE2: splitting 16 items at once into their byte planes */
+    __m128i v[8];
+    const unsigned char *p_in;
+    int done;
+    int k;
+    for (done = 0; done + 16 <= count; done += 16)
+      {
+	  p_in = in + (done * stride);
+	  for (k = 0; k < stride; k++)
+	      v[k] = _mm_loadu_si128 ((const __m128i *) (p_in + (k * 16)));
+	  byte_transpose_sse2 (v, stride, 4);
+	  for (k = 0; k < stride; k++)
+	      _mm_storeu_si128 ((__m128i *) (out + (k * count) + done), v[k]);
+      }
+    return done;
+}
+
+static int
+unshuffle_sse2 (unsigned char *out, const unsigned char *in, int count,
+		int stride)
+{
+/* SSE2: reassembling 16 items at once from their byte planes */
+    __m128i v[8];
+    unsigned char *p_out;
+    int rounds = (stride == 2) ? 1 : ((stride == 4) ? 2 : 3);
+    int done;
+    int k;
+    for (done = 0; done + 16 <= count; done += 16)
+      {
+	  for (k = 0; k < stride; k++)
+	      v[k] =
+		  _mm_loadu_si128 ((const __m128i *) (in + (k * count) + done));
+	  byte_transpose_sse2 (v, stride, rounds);
+	  p_out = out + (done * stride);
+	  for (k = 0; k < stride; k++)
+	      _mm_storeu_si128 ((__m128i *) (p_out + (k * 16)), v[k]);
+      }
+    return done;
+}
+#endif
+
+RL2_PRIVATE void
+rl2_byte_shuffle (const unsigned char *in, unsigned char *out, int size,
+		  int stride)
+{
+/* 
+/ ByteShuffle: splitting a buffer of "stride"-sized items into
+/ "stride" byte planes (any trailing partial item is copied as is)
+*/
+    int count = size / stride;
+    int done = 0;
+    if (stride == 2 || stride == 4 || stride == 8)
+      {
+	  switch (simd_level ())
+	    {
+#ifdef RL2_SIMD_SSE2
+	    case RL2_SIMD_AVX2_LEVEL:
+	    case RL2_SIMD_SSE2_LEVEL:
+		done = shuffle_sse2 (out, in, count, stride);
+		break;
+#endif
+	    };
+      }
+    shuffle_c (out, in, count, stride, done);
+    if (count * stride < size)
+	memcpy (out + (count * stride), in + (count * stride),
+		size - (count * stride));
+}
+
+RL2_PRIVATE void
+rl2_byte_unshuffle (const unsigned char *in, unsigned char *out, int size,
+		    int stride)
+{
+/* ByteUnshuffle: reassembling the original items from the byte planes */
+    int count = size / stride;
+    int done = 0;
+    if (stride == 2 || stride == 4 || stride == 8)
+      {
+	  switch (simd_level ())
+	    {
+#ifdef RL2_SIMD_SSE2
+	    case RL2_SIMD_AVX2_LEVEL:
+	    case RL2_SIMD_SSE2_LEVEL:
+		done = unshuffle_sse2 (out, in, count, stride);
+		break;
+#endif
+	    };
+      }
+    unshuffle_c (out, in, count, stride, done);
+    if (count * stride < size)
+	memcpy (out + (count * stride), in + (count * stride),
+		size - (count * stride));
+}
+
+/*
+/
+/ CRC32C (Castagnoli) checksums protecting the Odd/Even tile blocks
+/
+*/
+
+#if defined(RL2_SIMD_AVX2)
+#define RL2_CRC32C_SSE42
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#define RL2_CRC32C_ARMV8
+#endif
+
+#define RL2_CRC32C_POLY		0x82f63b78
+
+static unsigned int crc32c_table[8][256];
+static int crc32c_hw = 0;
+static rl2SimdOnce crc32c_once = RL2_SIMD_ONCE_INIT;
+
+static void
+crc32c_build_table (void)
+{
+/* 
+/ building the slicing-by-8 lookup tables, and checking if the
+/ current CPU supports the CRC32C instructions
+*/
+    unsigned int i;
+    int j;
+    unsigned int crc;
+#ifdef RL2_CRC32C_SSE42
+    __builtin_cpu_init ();
+    if (__builtin_cpu_supports ("sse4.2"))
+	crc32c_hw = 1;
+#endif
+#ifdef RL2_CRC32C_ARMV8
+    crc32c_hw = 1;
+#endif
+    for (i = 0; i < 256; i++)
+      {
+	  crc = i;
+	  for (j = 0; j < 8; j++)
+	      crc = (crc & 1) ? (crc >> 1) ^ RL2_CRC32C_POLY : crc >> 1;
+	  crc32c_table[0][i] = crc;
+      }
+    for (i = 0; i < 256; i++)
+      {
+	  crc = crc32c_table[0][i];
+	  for (j = 1; j < 8; j++)
+	    {
+		crc = crc32c_table[0][crc & 0xff] ^ (crc >> 8);
+		crc32c_table[j][i] = crc;
+	    }
+      }
+}
+
+static void
+crc32c_init_table (void)
+{
+/* ensuring that the CRC32C lookup tables are ready (thread safe) */
+    simd_once (&crc32c_once, crc32c_build_table);
+}
+
+static unsigned int
+crc32c_c (unsigned int crc, const unsigned char *p, int size)
+{
+/* CRC32C - portable C (slicing-by-8) */
+    unsigned int lo;
+    unsigned int hi;
+    crc32c_init_table ();
+    while (size >= 8)
+      {
+	  lo = crc ^ (p[0] | (p[1] << 8) | (p[2] << 16) |
+		      ((unsigned int) p[3] << 24));
+	  hi = p[4] | (p[5] << 8) | (p[6] << 16) | ((unsigned int) p[7] << 24);
+	  crc = crc32c_table[7][lo & 0xff] ^
+	      crc32c_table[6][(lo >> 8) & 0xff] ^
+	      crc32c_table[5][(lo >> 16) & 0xff] ^
+	      crc32c_table[4][lo >> 24] ^
+	      crc32c_table[3][hi & 0xff] ^
+	      crc32c_table[2][(hi >> 8) & 0xff] ^
+	      crc32c_table[1][(hi >> 16) & 0xff] ^ crc32c_table[0][hi >> 24];
+	  p += 8;
+	  size -= 8;
+      }
+    while (size-- > 0)
+	crc = crc32c_table[0][(crc ^ *p++) & 0xff] ^ (crc >> 8);
+    return crc;
+}
+
+#ifdef RL2_CRC32C_SSE42
+static unsigned int crc32c_sse42 (unsigned int crc, const unsigned char *p,
+				  int size)
+    __attribute__ ((target ("sse4.2")));
+
+static unsigned int
+crc32c_sse42 (unsigned int crc, const unsigned char *p, int size)
+{
+/* CRC32C - SSE4.2 CRC32 instruction */
+    unsigned int v32;
+#ifdef __x86_64__
+    unsigned long long crc64 = crc;
+    unsigned long long v64;
+    while (size >= 8)
+      {
+	  memcpy (&v64, p, 8);
+	  crc64 = _mm_crc32_u64 (crc64, v64);
+	  p += 8;
+	  size -= 8;
+      }
+    crc = (unsigned int) crc64;
+#endif
+    while (size >= 4)
+      {
+	  memcpy (&v32, p, 4);
+	  crc = _mm_crc32_u32 (crc, v32);
+	  p += 4;
+	  size -= 4;
+      }
+    while (size-- > 0)
+	crc = _mm_crc32_u8 (crc, *p++);
+    return crc;
+}
+#endif
+
+#ifdef RL2_CRC32C_ARMV8
+static unsigned int
+crc32c_armv8 (unsigned int crc, const unsigned char *p, int size)
+{
+/* CRC32C - ARMv8 CRC32 instructions */
+    uint64_t v64;
+    while (size >= 8)
+      {
+	  memcpy (&v64, p, 8);
+	  crc = __crc32cd (crc, v64);
+	  p += 8;
+	  size -= 8;
+      }
+    while (size-- > 0)
+	crc = __crc32cb (crc, *p++);
+    return crc;
+}
+#endif
+
+static int
+crc32c_hw_detect (void)
+{
+/* checking if the current CPU supports the CRC32C instructions */
+    crc32c_init_table ();
+    return crc32c_hw;
+}
+
+RL2_PRIVATE unsigned int
+rl2_crc32c (const unsigned char *buf, int size)
+{
+/* 
+/ computing the CRC32C of a memory block
+/ the hardware instructions are used whenever available, unless
+/ the SIMD kernels have been disabled by rl2_enable_simd()
+*/
+    unsigned int crc = 0xffffffff;
+    if (simd_enabled && crc32c_hw_detect ())
+      {
+#if defined(RL2_CRC32C_SSE42)
+	  crc = crc32c_sse42 (crc, buf, size);
+#elif defined(RL2_CRC32C_ARMV8)
+	  crc = crc32c_armv8 (crc, buf, size);
+#endif
+      }
+    else
+	crc = crc32c_c (crc, buf, size);
+    return crc ^ 0xffffffff;
+}
@@ -152,6 +152,38 @@ fnct_rl2_lzma_version (sqlite3_context * context, int argc,
     sqlite3_result_text (context, p_result, len, SQLITE_TRANSIENT);
 }
 
+static void
+fnct_rl2_zstd_version (sqlite3_context * context, int argc,
+		       sqlite3_value ** argv)
+{
+/* SQL function:
+/ rl2_zstd_version()
+/
+/ return a text string representing the current Zstandard version
+*/
+    int len;
+    const char *p_result = rl2_zstd_version ();
+    RL2_UNUSED ();		/* LCOV_EXCL_LINE */
+    len = strlen (p_result);
+    sqlite3_result_text (context, p_result, len, SQLITE_TRANSIENT);
+}
+
+static void
+fnct_rl2_lz4_version (sqlite3_context * context, int argc,
+		      sqlite3_value ** argv)
+{
+/* SQL function:
+/ rl2_lz4_version()
+/
+/ return a text string representing the current LZ4 version
+*/
+    int len;
+    const char *p_result = rl2_lz4_version ();
+    RL2_UNUSED ();		/* LCOV_EXCL_LINE */
+    len = strlen (p_result);
+    sqlite3_result_text (context, p_result, len, SQLITE_TRANSIENT);
+}
+
 static void
 fnct_rl2_png_version (sqlite3_context * context, int argc,
 		      sqlite3_value ** argv)
@@ -392,6 +424,118 @@ fnct_rl2_has_codec_lzma_no (sqlite3_context * context, int argc,
     sqlite3_result_int (context, ret);
 }
 
+static void
+fnct_rl2_has_codec_zstd (sqlite3_context * context, int argc,
+			 sqlite3_value ** argv)
+{
+/* SQL function:
+/ rl2_has_codec_zstd()
+/
+/ will return 1 (TRUE) or 0 (FALSE) depending of OMIT_ZSTD
+*/
+    int ret = rl2_is_supported_codec (RL2_COMPRESSION_ZSTD);
+    RL2_UNUSED ();		/* LCOV_EXCL_LINE */
+    if (ret < 0)
+	ret = 0;
+    sqlite3_result_int (context, ret);
+}
+
+static void
+fnct_rl2_has_codec_zstd_no (sqlite3_context * context, int argc,
+			    sqlite3_value ** argv)
+{
+/* SQL function:
+/ rl2_has_codec_zstd_no()
+/
+/ will return 1 (TRUE) or 0 (FALSE) depending of OMIT_ZSTD
+*/
+    int ret = rl2_is_supported_codec (RL2_COMPRESSION_ZSTD_NO);
+    RL2_UNUSED ();		/* LCOV_EXCL_LINE */
+    if (ret < 0)
+	ret = 0;
+    sqlite3_result_int (context, ret);
+}
+
+static void
+fnct_rl2_has_codec_lz4 (sqlite3_context * context, int argc,
+			sqlite3_value ** argv)
+{
+/* SQL function:
+/ rl2_has_codec_lz4()
+/
+/ will return 1 (TRUE) or 0 (FALSE) depending of OMIT_LZ4
+*/
+    int ret = rl2_is_supported_codec (RL2_COMPRESSION_LZ4);
+    RL2_UNUSED ();		/* LCOV_EXCL_LINE */
+    if (ret < 0)
+	ret = 0;
+    sqlite3_result_int (context, ret);
+}
+
+static void
+fnct_rl2_has_codec_lz4_no (sqlite3_context * context, int argc,
+			   sqlite3_value ** argv)
+{
+/* SQL function:
+/ rl2_has_codec_lz4_no()
+/
+/ will return 1 (TRUE) or 0 (FALSE) depending of OMIT_LZ4
+*/
+    int ret = rl2_is_supported_codec (RL2_COMPRESSION_LZ4_NO);
+    RL2_UNUSED ();		/* LCOV_EXCL_LINE */
+    if (ret < 0)
+	ret = 0;
+    sqlite3_result_int (context, ret);
+}
+
+static void
+fnct_rl2_has_codec_deflate_fp (sqlite3_context * context, int argc,
+			       sqlite3_value ** argv)
+{
+/* SQL function:
+/ rl2_has_codec_deflate_fp()
+/
+/ will always return 1 (TRUE)
+*/
+    int ret = rl2_is_supported_codec (RL2_COMPRESSION_DEFLATE_FP);
+    RL2_UNUSED ();		/* LCOV_EXCL_LINE */
+    if (ret < 0)
+	ret = 0;
+    sqlite3_result_int (context, ret);
+}
+
+static void
+fnct_rl2_has_codec_lzma_fp (sqlite3_context * context, int argc,
+			    sqlite3_value ** argv)
+{
+/* SQL function:
+/ rl2_has_codec_lzma_fp()
+/
+/ will return 1 (TRUE) or 0 (FALSE) depending of OMIT_LZMA
+*/
+    int ret = rl2_is_supported_codec (RL2_COMPRESSION_LZMA_FP);
+    RL2_UNUSED ();		/* LCOV_EXCL_LINE */
+    if (ret < 0)
+	ret = 0;
+    sqlite3_result_int (context, ret);
+}
+
+static void
+fnct_rl2_has_codec_zstd_fp (sqlite3_context * context, int argc,
+			    sqlite3_value ** argv)
+{
+/* SQL function:
+/ rl2_has_codec_zstd_fp()
+/
+/ will return 1 (TRUE) or 0 (FALSE) depending of OMIT_ZSTD
+*/
+    int ret = rl2_is_supported_codec (RL2_COMPRESSION_ZSTD_FP);
+    RL2_UNUSED ();		/* LCOV_EXCL_LINE */
+    if (ret < 0)
+	ret = 0;
+    sqlite3_result_int (context, ret);
+}
+
 static void
 fnct_rl2_has_codec_charls (sqlite3_context * context, int argc,
 			   sqlite3_value ** argv)
@@ -504,36 +648,379 @@ fnct_GetMaxThreads (sqlite3_context * context, int argc, sqlite3_value ** argv)
 }
 
 static void
-fnct_SetMaxThreads (sqlite3_context * context, int argc, sqlite3_value ** argv)
+fnct_SetMaxThreads (sqlite3_context * context, int argc, sqlite3_value ** argv)
+{
+/* SQL function:
+/ RL2_SetMaxThreads(INTEGER max)
+/
+/ return the currently set Max number of concurrent threads (after this call)
+/ -1 on invalid arguments
+*/
+    int max_threads = 1;
+    struct rl2_private_data *priv_data = sqlite3_user_data (context);
+    RL2_UNUSED ();		/* LCOV_EXCL_LINE */
+    if (sqlite3_value_type (argv[0]) == SQLITE_INTEGER)
+	max_threads = sqlite3_value_int (argv[0]);
+    else
+      {
+	  sqlite3_result_int (context, -1);
+	  return;
+      }
+
+/* normalizing between 1 and 64 */
+    if (max_threads < 1)
+	max_threads = 1;
+    if (max_threads > 64)
+	max_threads = 64;
+
+    if (priv_data != NULL)
+	priv_data->max_threads = max_threads;
+    else
+	max_threads = 1;
+    if (max_threads > 1)
+	rl2_set_worker_threads (max_threads);
+    sqlite3_result_int (context, max_threads);
+}
+
+static void
+fnct_SetTileCacheSize (sqlite3_context * context, int argc,
+		       sqlite3_value ** argv)
+{
+/* SQL function:
+/ RL2_SetTileCacheSize(INTEGER max_bytes)
+/
+/ sets the memory budget (in bytes) of the process-wide cache of
+/ decoded Tiles; 0 will disable the cache
+/ return the currently set Tile Cache size (after this call)
+/ -1 on invalid arguments
+*/
+    sqlite3_int64 max_size;
+    RL2_UNUSED ();		/* LCOV_EXCL_LINE */
+    if (sqlite3_value_type (argv[0]) == SQLITE_INTEGER)
+	max_size = sqlite3_value_int64 (argv[0]);
+    else
+      {
+	  sqlite3_result_int (context, -1);
+	  return;
+      }
+    max_size = rl2_set_tile_cache_size (max_size);
+    sqlite3_result_int64 (context, max_size);
+}
+
+static void
+fnct_GetTileCacheSize (sqlite3_context * context, int argc,
+		       sqlite3_value ** argv)
+{
+/* SQL function:
+/ RL2_GetTileCacheSize()
+/
+/ return the currently set Tile Cache size (in bytes)
+*/
+    sqlite3_int64 max_size;
+    sqlite3_int64 curr_size;
+    sqlite3_int64 hits;
+    sqlite3_int64 misses;
+    RL2_UNUSED ();		/* LCOV_EXCL_LINE */
+    rl2_get_tile_cache_stats (&max_size, &curr_size, &hits, &misses);
+    sqlite3_result_int64 (context, max_size);
+}
+
+static void
+fnct_GetTileCacheHits (sqlite3_context * context, int argc,
+		       sqlite3_value ** argv)
+{
+/* SQL function:
+/ RL2_GetTileCacheHits()
+/
+/ return how many Tiles have been found into the Tile Cache
+*/
+    sqlite3_int64 max_size;
+    sqlite3_int64 curr_size;
+    sqlite3_int64 hits;
+    sqlite3_int64 misses;
+    RL2_UNUSED ();		/* LCOV_EXCL_LINE */
+    rl2_get_tile_cache_stats (&max_size, &curr_size, &hits, &misses);
+    sqlite3_result_int64 (context, hits);
+}
+
+static void
+fnct_GetTileCacheMisses (sqlite3_context * context, int argc,
+			 sqlite3_value ** argv)
+{
+/* SQL function:
+/ RL2_GetTileCacheMisses()
+/
+/ return how many Tiles have been searched into the Tile Cache
+/ without finding them
+*/
+    sqlite3_int64 max_size;
+    sqlite3_int64 curr_size;
+    sqlite3_int64 hits;
+    sqlite3_int64 misses;
+    RL2_UNUSED ();		/* LCOV_EXCL_LINE */
+    rl2_get_tile_cache_stats (&max_size, &curr_size, &hits, &misses);
+    sqlite3_result_int64 (context, misses);
+}
+
+static void
+fnct_FlushTileCache (sqlite3_context * context, int argc,
+		     sqlite3_value ** argv)
+{
+/* SQL function:
+/ RL2_FlushTileCache()
+/
+/ removes all Tiles from the Tile Cache
+/ always return 1
+*/
+    RL2_UNUSED ();		/* LCOV_EXCL_LINE */
+    rl2_flush_tile_cache ();
+    sqlite3_result_int (context, 1);
+}
+
+static void
+fnct_SetRasterCacheSize (sqlite3_context * context, int argc,
+			 sqlite3_value ** argv)
+{
+/* SQL function:
+/ RL2_SetRasterCacheSize(INTEGER max_tiles)
+/
+/ sets the max number of Tiles kept into the per-connection Raster
+/ Cache used by GetPixelFromRasterByPoint()
+/ return the currently set Raster Cache size (after this call)
+/ -1 on invalid arguments
+*/
+    int items;
+    struct rl2_private_data *priv_data = sqlite3_user_data (context);
+    RL2_UNUSED ();		/* LCOV_EXCL_LINE */
+    if (sqlite3_value_type (argv[0]) == SQLITE_INTEGER)
+	items = sqlite3_value_int (argv[0]);
+    else
+      {
+	  sqlite3_result_int (context, -1);
+	  return;
+      }
+    if (rl2_set_raster_cache_items (priv_data, items) != RL2_OK)
+      {
+	  sqlite3_result_int (context, -1);
+	  return;
+      }
+    sqlite3_result_int (context, priv_data->raster_cache_items);
+}
+
+static void
+fnct_GetRasterCacheSize (sqlite3_context * context, int argc,
+			 sqlite3_value ** argv)
+{
+/* SQL function:
+/ RL2_GetRasterCacheSize()
+/
+/ return the currently set Raster Cache size (max number of Tiles)
+*/
+    int items = 0;
+    struct rl2_private_data *priv_data = sqlite3_user_data (context);
+    RL2_UNUSED ();		/* LCOV_EXCL_LINE */
+    if (priv_data != NULL)
+	items = priv_data->raster_cache_items;
+    sqlite3_result_int (context, items);
+}
+
+static void
+fnct_SetStatementCache (sqlite3_context * context, int argc,
+			sqlite3_value ** argv)
+{
+/* SQL function:
+/ RL2_SetStatementCache(INTEGER enabled)
+/
+/ enables or disables the per-connection Cache of prepared Statements
+/ used by GetTileImage() and GetPixelFromRasterByPoint()
+/ note: cached Statements will cause sqlite3_close() to fail with
+/ SQLITE_BUSY, so the Cache should be disabled before closing the
+/ connection (or sqlite3_close_v2() should be used)
+/ return the current setting (after this call)
+/ -1 on invalid arguments
+*/
+    int enabled;
+    struct rl2_private_data *priv_data = sqlite3_user_data (context);
+    RL2_UNUSED ();		/* LCOV_EXCL_LINE */
+    if (sqlite3_value_type (argv[0]) == SQLITE_INTEGER)
+	enabled = sqlite3_value_int (argv[0]);
+    else
+      {
+	  sqlite3_result_int (context, -1);
+	  return;
+      }
+    if (priv_data == NULL)
+      {
+	  sqlite3_result_int (context, -1);
+	  return;
+      }
+    rl2_enable_stmt_cache (priv_data, enabled);
+    sqlite3_result_int (context, priv_data->stmt_cache_enabled);
+}
+
+static void
+fnct_GetStatementCache (sqlite3_context * context, int argc,
+			sqlite3_value ** argv)
+{
+/* SQL function:
+/ RL2_GetStatementCache()
+/
+/ return 1 if the Cache of prepared Statements is enabled, 0 if not
+*/
+    int enabled = 0;
+    struct rl2_private_data *priv_data = sqlite3_user_data (context);
+    RL2_UNUSED ();		/* LCOV_EXCL_LINE */
+    if (priv_data != NULL)
+	enabled = priv_data->stmt_cache_enabled;
+    sqlite3_result_int (context, enabled);
+}
+
+static void
+fnct_SetTileGridIndex (sqlite3_context * context, int argc,
+		       sqlite3_value ** argv)
+{
+/* SQL function:
+/ RL2_SetTileGridIndex(INTEGER enabled)
+/
+/ enables or disables the per-connection Grid Index, directly resolving
+/ the Tiles of regular-grid Coverages (Mixed Resolutions Coverages will
+/ always query the SpatialIndex)
+/ return the current setting (after this call)
+/ -1 on invalid arguments
+*/
+    int enabled;
+    struct rl2_private_data *priv_data = sqlite3_user_data (context);
+    RL2_UNUSED ();		/* LCOV_EXCL_LINE */
+    if (sqlite3_value_type (argv[0]) == SQLITE_INTEGER)
+	enabled = sqlite3_value_int (argv[0]);
+    else
+      {
+	  sqlite3_result_int (context, -1);
+	  return;
+      }
+    if (priv_data == NULL)
+      {
+	  sqlite3_result_int (context, -1);
+	  return;
+      }
+    rl2_enable_tile_grid (priv_data, enabled);
+    sqlite3_result_int (context, priv_data->tile_grid_enabled);
+}
+
+static void
+fnct_GetTileGridIndex (sqlite3_context * context, int argc,
+		       sqlite3_value ** argv)
+{
+/* SQL function:
+/ RL2_GetTileGridIndex()
+/
+/ return 1 if the Grid Index is enabled, 0 if not
+*/
+    int enabled = 0;
+    struct rl2_private_data *priv_data = sqlite3_user_data (context);
+    RL2_UNUSED ();		/* LCOV_EXCL_LINE */
+    if (priv_data != NULL)
+	enabled = priv_data->tile_grid_enabled;
+    sqlite3_result_int (context, enabled);
+}
+
+static void
+fnct_SetTileReaders (sqlite3_context * context, int argc,
+		     sqlite3_value ** argv)
+{
+/* SQL function:
+/ RL2_SetTileReaders(INTEGER enabled)
+/
+/ enables or disables the per-connection pool of read-only connections
+/ allowing the decoder threads to directly read the Tile BLOBs
+/ (only file-based DBs and multithreaded rendering will benefit)
+/ return the current setting (after this call)
+/ -1 on invalid arguments
+*/
+    int enabled;
+    struct rl2_private_data *priv_data = sqlite3_user_data (context);
+    RL2_UNUSED ();		/* LCOV_EXCL_LINE */
+    if (sqlite3_value_type (argv[0]) == SQLITE_INTEGER)
+	enabled = sqlite3_value_int (argv[0]);
+    else
+      {
+	  sqlite3_result_int (context, -1);
+	  return;
+      }
+    if (priv_data == NULL)
+      {
+	  sqlite3_result_int (context, -1);
+	  return;
+      }
+    rl2_enable_tile_readers (priv_data, enabled);
+    sqlite3_result_int (context, priv_data->tile_readers_enabled);
+}
+
+static void
+fnct_GetTileReaders (sqlite3_context * context, int argc,
+		     sqlite3_value ** argv)
+{
+/* SQL function:
+/ RL2_GetTileReaders()
+/
+/ return 1 if the Tile Readers are enabled, 0 if not
+*/
+    int enabled = 0;
+    struct rl2_private_data *priv_data = sqlite3_user_data (context);
+    RL2_UNUSED ();		/* LCOV_EXCL_LINE */
+    if (priv_data != NULL)
+	enabled = priv_data->tile_readers_enabled;
+    sqlite3_result_int (context, enabled);
+}
+
+static void
+fnct_SetTileChecksums (sqlite3_context * context, int argc,
+		       sqlite3_value ** argv)
 {
 /* SQL function:
-/ RL2_SetMaxThreads(INTEGER max)
+/ RL2_SetTileChecksums(INTEGER enabled)
 /
-/ return the currently set Max number of concurrent threads (after this call)
+/ enables or disables the per-connection verification of the Tile
+/ checksums when rendering (default: enabled)
+/ Import, Pyramid building and IsValidRasterTile() will always
+/ verify the checksums anyway
+/ return the current setting (after this call)
 / -1 on invalid arguments
 */
-    int max_threads = 1;
+    int enabled;
     struct rl2_private_data *priv_data = sqlite3_user_data (context);
     RL2_UNUSED ();		/* LCOV_EXCL_LINE */
     if (sqlite3_value_type (argv[0]) == SQLITE_INTEGER)
-	max_threads = sqlite3_value_int (argv[0]);
+	enabled = sqlite3_value_int (argv[0]);
     else
       {
 	  sqlite3_result_int (context, -1);
 	  return;
       }
+    if (priv_data == NULL)
+      {
+	  sqlite3_result_int (context, -1);
+	  return;
+      }
+    priv_data->verify_tile_checksums = enabled ? 1 : 0;
+    sqlite3_result_int (context, priv_data->verify_tile_checksums);
+}
 
-/* normalizing between 1 and 64 */
-    if (max_threads < 1)
-	max_threads = 1;
-    if (max_threads > 64)
-	max_threads = 64;
-
+static void
+fnct_GetTileChecksums (sqlite3_context * context, int argc,
+		       sqlite3_value ** argv)
+{
+/* SQL function:
+/ RL2_GetTileChecksums()
+/
+/ return 1 if the Tile checksums are verified when rendering, 0 if not
+*/
+    int enabled = 1;
+    struct rl2_private_data *priv_data = sqlite3_user_data (context);
+    RL2_UNUSED ();		/* LCOV_EXCL_LINE */
     if (priv_data != NULL)
-	priv_data->max_threads = max_threads;
-    else
-	max_threads = 1;
-    sqlite3_result_int (context, max_threads);
+	enabled = priv_data->verify_tile_checksums;
+    sqlite3_result_int (context, enabled);
 }
 
 static void
@@ -2616,6 +3103,20 @@ fnct_CreateRasterCoverage (sqlite3_context * context, int argc,
 	compr = RL2_COMPRESSION_LZMA;
     if (strcasecmp (compression, "LZMA_NO") == 0)
 	compr = RL2_COMPRESSION_LZMA_NO;
+    if (strcasecmp (compression, "ZSTD") == 0)
+	compr = RL2_COMPRESSION_ZSTD;
+    if (strcasecmp (compression, "ZSTD_NO") == 0)
+	compr = RL2_COMPRESSION_ZSTD_NO;
+    if (strcasecmp (compression, "LZ4") == 0)
+	compr = RL2_COMPRESSION_LZ4;
+    if (strcasecmp (compression, "LZ4_NO") == 0)
+	compr = RL2_COMPRESSION_LZ4_NO;
+    if (strcasecmp (compression, "DEFLATE_FP") == 0)
+	compr = RL2_COMPRESSION_DEFLATE_FP;
+    if (strcasecmp (compression, "LZMA_FP") == 0)
+	compr = RL2_COMPRESSION_LZMA_FP;
+    if (strcasecmp (compression, "ZSTD_FP") == 0)
+	compr = RL2_COMPRESSION_ZSTD_FP;
     if (strcasecmp (compression, "PNG") == 0)
 	compr = RL2_COMPRESSION_PNG;
     if (strcasecmp (compression, "GIF") == 0)
@@ -2952,6 +3453,171 @@ fnct_IsRasterCoverageAutoNdviEnabled (sqlite3_context * context, int argc,
 	sqlite3_result_int (context, -1);
 }
 
+static void
+fnct_EnableRasterCoverageSplitTiles (sqlite3_context * context, int argc,
+				     sqlite3_value ** argv)
+{
+/* SQL function:
+/ EnableRasterCoverageSplitTiles(String coverage_name, int on_off)
+/
+/ enables or disables the Split Tiles layout on a Raster Coverage:
+/ ODD and EVEN tile blocks stored into two separate tables, so that
+/ reading at reduced scales (1:2, 1:4, 1:8) never touches the EVEN
+/ blocks; all Tiles already stored are migrated
+/ returns 1 on success
+/ 0 on failure, -1 on invalid arguments
+*/
+    const char *coverage_name;
+    int on_off;
+    sqlite3 *sqlite = sqlite3_context_db_handle (context);
+    RL2_UNUSED ();		/* LCOV_EXCL_LINE */
+    if (sqlite3_value_type (argv[0]) != SQLITE_TEXT)
+      {
+	  sqlite3_result_int (context, -1);
+	  return;
+      }
+    if (sqlite3_value_type (argv[1]) != SQLITE_INTEGER)
+      {
+	  sqlite3_result_int (context, -1);
+	  return;
+      }
+    coverage_name = (const char *) sqlite3_value_text (argv[0]);
+    on_off = sqlite3_value_int (argv[1]);
+    if (rl2_enable_dbms_coverage_split_tiles (sqlite, coverage_name, on_off)
+	== RL2_OK)
+	sqlite3_result_int (context, 1);
+    else
+	sqlite3_result_int (context, 0);
+}
+
+static void
+fnct_IsRasterCoverageSplitTilesEnabled (sqlite3_context * context, int argc,
+					sqlite3_value ** argv)
+{
+/* SQL function:
+/ IsRasterCoverageSplitTilesEnabled(String db_prefix, String coverage_name)
+/
+/ checks if a Raster Coverage stores its ODD and EVEN tile blocks
+/ into two separate tables
+/ returns 1 (TRUE) or 0 (FALSE)
+/ -1 on invalid arguments or if the Raster Coverage doesn't exist
+*/
+    const char *db_prefix = NULL;
+    const char *coverage_name;
+    int ret;
+    sqlite3 *sqlite = sqlite3_context_db_handle (context);
+    RL2_UNUSED ();		/* LCOV_EXCL_LINE */
+    if (sqlite3_value_type (argv[0]) == SQLITE_TEXT
+	|| sqlite3_value_type (argv[0]) == SQLITE_NULL)
+	;
+    else
+      {
+	  sqlite3_result_int (context, -1);
+	  return;
+      }
+    if (sqlite3_value_type (argv[1]) != SQLITE_TEXT)
+      {
+	  sqlite3_result_int (context, -1);
+	  return;
+      }
+    if (sqlite3_value_type (argv[0]) == SQLITE_TEXT)
+	db_prefix = (const char *) sqlite3_value_text (argv[0]);
+    coverage_name = (const char *) sqlite3_value_text (argv[1]);
+    ret =
+	rl2_is_dbms_coverage_split_tiles_enabled (sqlite, db_prefix,
+						  coverage_name);
+    if (ret == RL2_TRUE)
+	sqlite3_result_int (context, 1);
+    else if (ret == RL2_FALSE)
+	sqlite3_result_int (context, 0);
+    else
+	sqlite3_result_int (context, -1);
+}
+
+static void
+fnct_SetRasterCoverageResampling (sqlite3_context * context, int argc,
+				  sqlite3_value ** argv)
+{
+/* SQL function:
+/ SetRasterCoverageResampling(String coverage_name, String resampling)
+/
+/ sets the Resampling policy used when building the Pyramid of
+/ a Raster Coverage: one of 'DEFAULT', 'AVERAGE', 'NEAREST',
+/ 'MODE', 'BILINEAR' or 'CUBIC'
+/ returns 1 on success
+/ 0 on failure, -1 on invalid arguments
+*/
+    const char *coverage_name;
+    unsigned char resampling;
+    sqlite3 *sqlite = sqlite3_context_db_handle (context);
+    RL2_UNUSED ();		/* LCOV_EXCL_LINE */
+    if (sqlite3_value_type (argv[0]) != SQLITE_TEXT)
+      {
+	  sqlite3_result_int (context, -1);
+	  return;
+      }
+    if (sqlite3_value_type (argv[1]) != SQLITE_TEXT)
+      {
+	  sqlite3_result_int (context, -1);
+	  return;
+      }
+    coverage_name = (const char *) sqlite3_value_text (argv[0]);
+    if (!rl2_parse_resampling_name
+	((const char *) sqlite3_value_text (argv[1]), &resampling))
+      {
+	  sqlite3_result_int (context, -1);
+	  return;
+      }
+    if (rl2_set_dbms_coverage_resampling (sqlite, coverage_name, resampling)
+	== RL2_OK)
+	sqlite3_result_int (context, 1);
+    else
+	sqlite3_result_int (context, 0);
+}
+
+static void
+fnct_GetRasterCoverageResampling (sqlite3_context * context, int argc,
+				  sqlite3_value ** argv)
+{
+/* SQL function:
+/ GetRasterCoverageResampling(String db_prefix, String coverage_name)
+/
+/ returns the name of the Resampling policy used when building the
+/ Pyramid of a Raster Coverage
+/ NULL on invalid arguments or if the Raster Coverage doesn't exist
+*/
+    const char *db_prefix = NULL;
+    const char *coverage_name;
+    unsigned char resampling;
+    const char *name;
+    sqlite3 *sqlite = sqlite3_context_db_handle (context);
+    RL2_UNUSED ();		/* LCOV_EXCL_LINE */
+    if (sqlite3_value_type (argv[0]) == SQLITE_TEXT
+	|| sqlite3_value_type (argv[0]) == SQLITE_NULL)
+	;
+    else
+      {
+	  sqlite3_result_null (context);
+	  return;
+      }
+    if (sqlite3_value_type (argv[1]) != SQLITE_TEXT)
+      {
+	  sqlite3_result_null (context);
+	  return;
+      }
+    if (sqlite3_value_type (argv[0]) == SQLITE_TEXT)
+	db_prefix = (const char *) sqlite3_value_text (argv[0]);
+    coverage_name = (const char *) sqlite3_value_text (argv[1]);
+    if (rl2_get_dbms_coverage_resampling
+	(sqlite, db_prefix, coverage_name, &resampling) != RL2_OK)
+      {
+	  sqlite3_result_null (context);
+	  return;
+      }
+    name = rl2_resampling_name (resampling);
+    sqlite3_result_text (context, name, strlen (name), SQLITE_STATIC);
+}
+
 static void
 fnct_CopyRasterCoverage (sqlite3_context * context, int argc,
 			 sqlite3_value ** argv)
@@ -3772,14 +4438,119 @@ fnct_LoadRastersFromDir (sqlite3_context * context, int argc,
 }
 
 static void
-fnct_Pyramidize (sqlite3_context * context, int argc, sqlite3_value ** argv)
+fnct_Pyramidize (sqlite3_context * context, int argc, sqlite3_value ** argv)
+{
+/* SQL function:
+/ Pyramidize(text coverage)
+/ Pyramidize(text coverage, integer section_id)
+/ Pyramidize(text coverage, integer section_id, int force_rebuild)
+/ Pyramidize(text coverage, integer section_id, int force_rebuild,
+/            int transaction)
+/
+/ will return 1 (TRUE, success) or 0 (FALSE, failure)
+/ or -1 (INVALID ARGS)
+/
+*/
+    int err = 0;
+    const char *cvg_name;
+    sqlite3_int64 section_id = 0;
+    int null_id = 1;
+    int forced_rebuild = 0;
+    int transaction = 1;
+    sqlite3 *sqlite;
+    int ret;
+    const void *data;
+    int max_threads = 1;
+    RL2_UNUSED ();		/* LCOV_EXCL_LINE */
+
+    if (sqlite3_value_type (argv[0]) != SQLITE_TEXT)
+	err = 1;
+    if (argc > 1 && sqlite3_value_type (argv[1]) != SQLITE_INTEGER
+	&& sqlite3_value_type (argv[1]) != SQLITE_NULL)
+	err = 1;
+    if (argc > 2 && sqlite3_value_type (argv[2]) != SQLITE_INTEGER)
+	err = 1;
+    if (argc > 3 && sqlite3_value_type (argv[3]) != SQLITE_INTEGER)
+	err = 1;
+    if (err)
+      {
+	  sqlite3_result_int (context, -1);
+	  return;
+      }
+/* attempting to (re)build Pyramid levels */
+    sqlite = sqlite3_context_db_handle (context);
+    data = sqlite3_user_data (context);
+    if (data != NULL)
+      {
+	  struct rl2_private_data *priv_data = (struct rl2_private_data *) data;
+	  max_threads = priv_data->max_threads;
+	  if (max_threads < 1)
+	      max_threads = 1;
+	  if (max_threads > 64)
+	      max_threads = 64;
+      }
+    cvg_name = (const char *) sqlite3_value_text (argv[0]);
+    if (argc > 1)
+      {
+	  if (sqlite3_value_type (argv[1]) == SQLITE_INTEGER)
+	    {
+		section_id = sqlite3_value_int64 (argv[1]);
+		null_id = 0;
+	    }
+      }
+    if (argc > 2)
+	forced_rebuild = sqlite3_value_int (argv[2]);
+    if (argc > 3)
+	transaction = sqlite3_value_int (argv[3]);
+    if (transaction)
+      {
+	  /* starting a DBMS Transaction */
+	  ret = sqlite3_exec (sqlite, "BEGIN", NULL, NULL, NULL);
+	  if (ret != SQLITE_OK)
+	    {
+		sqlite3_result_int (context, -1);
+		return;
+	    }
+      }
+    if (null_id)
+	ret =
+	    rl2_build_all_section_pyramids (sqlite, max_threads, cvg_name,
+					    forced_rebuild, 1);
+    else
+	ret =
+	    rl2_build_section_pyramid (sqlite, max_threads, cvg_name,
+				       section_id, forced_rebuild, 1);
+    if (ret != RL2_OK)
+      {
+	  sqlite3_result_int (context, 0);
+	  if (transaction)
+	    {
+		/* invalidating the pending transaction */
+		sqlite3_exec (sqlite, "ROLLBACK", NULL, NULL, NULL);
+	    }
+	  return;
+      }
+    if (transaction)
+      {
+	  /* committing the still pending transaction */
+	  ret = sqlite3_exec (sqlite, "COMMIT", NULL, NULL, NULL);
+	  if (ret != SQLITE_OK)
+	    {
+		sqlite3_result_int (context, -1);
+		return;
+	    }
+      }
+    sqlite3_result_int (context, 1);
+}
+
+static void
+fnct_PyramidizeMonolithic (sqlite3_context * context, int argc,
+			   sqlite3_value ** argv)
 {
 /* SQL function:
-/ Pyramidize(text coverage)
-/ Pyramidize(text coverage, integer section_id)
-/ Pyramidize(text coverage, integer section_id, int force_rebuild)
-/ Pyramidize(text coverage, integer section_id, int force_rebuild,
-/            int transaction)
+/ PyramidizeMonolithic(text coverage)
+/ PyramidizeMonolithic(text coverage, int virt_levels)
+/ PyramidizeMonolithic(text coverage, int virt_levels, int transaction)
 /
 / will return 1 (TRUE, success) or 0 (FALSE, failure)
 / or -1 (INVALID ARGS)
@@ -3787,25 +4558,20 @@ fnct_Pyramidize (sqlite3_context * context, int argc, sqlite3_value ** argv)
 */
     int err = 0;
     const char *cvg_name;
-    sqlite3_int64 section_id = 0;
-    int null_id = 1;
-    int forced_rebuild = 0;
+    int virt_levels = 0;
     int transaction = 1;
+    int max_threads = 1;
     sqlite3 *sqlite;
-    int ret;
     const void *data;
-    int max_threads = 1;
+    int ret;
     RL2_UNUSED ();		/* LCOV_EXCL_LINE */
 
     if (sqlite3_value_type (argv[0]) != SQLITE_TEXT)
 	err = 1;
-    if (argc > 1 && sqlite3_value_type (argv[1]) != SQLITE_INTEGER
-	&& sqlite3_value_type (argv[1]) != SQLITE_NULL)
+    if (argc > 1 && sqlite3_value_type (argv[1]) != SQLITE_INTEGER)
 	err = 1;
     if (argc > 2 && sqlite3_value_type (argv[2]) != SQLITE_INTEGER)
 	err = 1;
-    if (argc > 3 && sqlite3_value_type (argv[3]) != SQLITE_INTEGER)
-	err = 1;
     if (err)
       {
 	  sqlite3_result_int (context, -1);
@@ -3825,17 +4591,9 @@ fnct_Pyramidize (sqlite3_context * context, int argc, sqlite3_value ** argv)
       }
     cvg_name = (const char *) sqlite3_value_text (argv[0]);
     if (argc > 1)
-      {
-	  if (sqlite3_value_type (argv[1]) == SQLITE_INTEGER)
-	    {
-		section_id = sqlite3_value_int64 (argv[1]);
-		null_id = 0;
-	    }
-      }
+	virt_levels = sqlite3_value_int (argv[1]);
     if (argc > 2)
-	forced_rebuild = sqlite3_value_int (argv[2]);
-    if (argc > 3)
-	transaction = sqlite3_value_int (argv[3]);
+	transaction = sqlite3_value_int (argv[2]);
     if (transaction)
       {
 	  /* starting a DBMS Transaction */
@@ -3846,14 +4604,9 @@ fnct_Pyramidize (sqlite3_context * context, int argc, sqlite3_value ** argv)
 		return;
 	    }
       }
-    if (null_id)
-	ret =
-	    rl2_build_all_section_pyramids (sqlite, max_threads, cvg_name,
-					    forced_rebuild, 1);
-    else
-	ret =
-	    rl2_build_section_pyramid (sqlite, max_threads, cvg_name,
-				       section_id, forced_rebuild, 1);
+    ret =
+	rl2_build_monolithic_pyramid_ex (sqlite, max_threads, cvg_name,
+					 virt_levels, 1);
     if (ret != RL2_OK)
       {
 	  sqlite3_result_int (context, 0);
@@ -3878,23 +4631,25 @@ fnct_Pyramidize (sqlite3_context * context, int argc, sqlite3_value ** argv)
 }
 
 static void
-fnct_PyramidizeMonolithic (sqlite3_context * context, int argc,
-			   sqlite3_value ** argv)
+fnct_PyramidizeIncremental (sqlite3_context * context, int argc,
+			    sqlite3_value ** argv)
 {
 /* SQL function:
-/ PyramidizeMonolithic(text coverage)
-/ PyramidizeMonolithic(text coverage, int virt_levels)
-/ PyramidizeMonolithic(text coverage, int virt_levels, int transaction)
+/ PyramidizeIncremental(text coverage)
+/ PyramidizeIncremental(text coverage, int transaction)
 /
+/ will only rebuild the Pyramid tiles affected by the Sections
+/ loaded or deleted since the last Pyramid update
 / will return 1 (TRUE, success) or 0 (FALSE, failure)
 / or -1 (INVALID ARGS)
 /
 */
     int err = 0;
     const char *cvg_name;
-    int virt_levels = 0;
     int transaction = 1;
+    int max_threads = 1;
     sqlite3 *sqlite;
+    const void *data;
     int ret;
     RL2_UNUSED ();		/* LCOV_EXCL_LINE */
 
@@ -3902,20 +4657,26 @@ fnct_PyramidizeMonolithic (sqlite3_context * context, int argc,
 	err = 1;
     if (argc > 1 && sqlite3_value_type (argv[1]) != SQLITE_INTEGER)
 	err = 1;
-    if (argc > 2 && sqlite3_value_type (argv[2]) != SQLITE_INTEGER)
-	err = 1;
     if (err)
       {
 	  sqlite3_result_int (context, -1);
 	  return;
       }
-/* attempting to (re)build Pyramid levels */
+/* attempting to update the Pyramid levels */
     sqlite = sqlite3_context_db_handle (context);
+    data = sqlite3_user_data (context);
+    if (data != NULL)
+      {
+	  struct rl2_private_data *priv_data = (struct rl2_private_data *) data;
+	  max_threads = priv_data->max_threads;
+	  if (max_threads < 1)
+	      max_threads = 1;
+	  if (max_threads > 64)
+	      max_threads = 64;
+      }
     cvg_name = (const char *) sqlite3_value_text (argv[0]);
     if (argc > 1)
-	virt_levels = sqlite3_value_int (argv[1]);
-    if (argc > 2)
-	transaction = sqlite3_value_int (argv[2]);
+	transaction = sqlite3_value_int (argv[1]);
     if (transaction)
       {
 	  /* starting a DBMS Transaction */
@@ -3926,7 +4687,7 @@ fnct_PyramidizeMonolithic (sqlite3_context * context, int argc,
 		return;
 	    }
       }
-    ret = rl2_build_monolithic_pyramid (sqlite, cvg_name, virt_levels, 1);
+    ret = rl2_build_incremental_pyramid (sqlite, max_threads, cvg_name, 1);
     if (ret != RL2_OK)
       {
 	  sqlite3_result_int (context, 0);
@@ -8315,15 +9076,16 @@ fnct_GetPixelFromRasterByPoint (sqlite3_context * context, int argc,
 		    (sqlite, db_prefix, cvg_name, blob, blob_sz, &section_id))
 		    goto error;
 		if (!rl2_find_best_resolution_level
-		    (sqlite, db_prefix, cvg_name, 1, section_id, x_res, y_res,
-		     &pyramid_level, &scale, &xscale, &xx_res, &yy_res))
+		    (sqlite, data, db_prefix, cvg_name, 1, section_id, x_res,
+		     y_res, &pyramid_level, &scale, &xscale, &xx_res,
+		     &yy_res))
 		    goto error;
 	    }
 	  else
 	    {
 		/* ordinary Coverage */
 		if (!rl2_find_best_resolution_level
-		    (sqlite, db_prefix, cvg_name, 0, 0, x_res, y_res,
+		    (sqlite, data, db_prefix, cvg_name, 0, 0, x_res, y_res,
 		     &pyramid_level, &scale, &xscale, &xx_res, &yy_res))
 		    goto error;
 	    }
@@ -8351,6 +9113,315 @@ fnct_GetPixelFromRasterByPoint (sqlite3_context * context, int argc,
     return;
 }
 
+struct pixels_by_points_aggregate
+{
+/* helper struct - GetPixelsFromRasterByPoints() aggregate context */
+    char *db_prefix;
+    char *cvg_name;
+    int pyramid_level;
+    int band;
+    int srid;
+    int error;
+    int count;
+    int max_count;
+    double *x;
+    double *y;
+};
+
+static void
+destroy_pixels_by_points_aggregate (struct pixels_by_points_aggregate *aggr)
+{
+/* memory cleanup - GetPixelsFromRasterByPoints() aggregate context */
+    if (aggr == NULL)
+	return;
+    if (aggr->db_prefix != NULL)
+	free (aggr->db_prefix);
+    if (aggr->cvg_name != NULL)
+	free (aggr->cvg_name);
+    if (aggr->x != NULL)
+	free (aggr->x);
+    if (aggr->y != NULL)
+	free (aggr->y);
+    free (aggr);
+}
+
+static char *
+do_copy_text (const char *str)
+{
+/* allocating a copy of some text string */
+    int len;
+    char *copy;
+    if (str == NULL)
+	return NULL;
+    len = strlen (str);
+    copy = malloc (len + 1);
+    if (copy != NULL)
+	strcpy (copy, str);
+    return copy;
+}
+
+static int
+do_match_text (const char *str1, const char *str2)
+{
+/* testing if two (nullable) text strings are equal (case insensitive) */
+    if (str1 == NULL && str2 == NULL)
+	return 1;
+    if (str1 == NULL || str2 == NULL)
+	return 0;
+    if (strcasecmp (str1, str2) == 0)
+	return 1;
+    return 0;
+}
+
+static void
+fnct_GetPixelsFromRasterByPoints_step (sqlite3_context * context, int argc,
+				       sqlite3_value ** argv)
+{
+/* SQL function:
+/ GetPixelsFromRasterByPoints(text db_prefix, text coverage, 
+/                             BLOB point, int pyramid_level)
+/   or
+/ GetPixelsFromRasterByPoints(text db_prefix, text coverage, 
+/                             BLOB point, int pyramid_level, int band)
+/
+/ aggregate function - STEP
+/
+*/
+    const char *db_prefix = NULL;
+    const char *cvg_name;
+    int pyramid_level;
+    int band = 0;
+    double x;
+    double y;
+    int srid;
+    struct pixels_by_points_aggregate *aggr;
+    struct pixels_by_points_aggregate **p;
+    RL2_UNUSED ();		/* LCOV_EXCL_LINE */
+
+    p = sqlite3_aggregate_context (context,
+				   sizeof (struct pixels_by_points_aggregate
+					   *));
+    if (p == NULL)
+	return;
+    if (*p == NULL)
+      {
+	  /* this is the first row */
+	  aggr = malloc (sizeof (struct pixels_by_points_aggregate));
+	  if (aggr == NULL)
+	      return;
+	  aggr->db_prefix = NULL;
+	  aggr->cvg_name = NULL;
+	  aggr->pyramid_level = 0;
+	  aggr->band = 0;
+	  aggr->srid = 0;
+	  aggr->error = 0;
+	  aggr->count = 0;
+	  aggr->max_count = 0;
+	  aggr->x = NULL;
+	  aggr->y = NULL;
+	  *p = aggr;
+      }
+    else
+	aggr = *p;
+    if (aggr->error)
+	return;
+
+/* testing arguments for validity */
+    if (sqlite3_value_type (argv[0]) == SQLITE_TEXT)
+	db_prefix = (const char *) sqlite3_value_text (argv[0]);
+    else if (sqlite3_value_type (argv[0]) != SQLITE_NULL)
+	goto error;
+    if (sqlite3_value_type (argv[1]) != SQLITE_TEXT)
+	goto error;
+    cvg_name = (const char *) sqlite3_value_text (argv[1]);
+    if (sqlite3_value_type (argv[2]) != SQLITE_BLOB)
+	goto error;
+    if (sqlite3_value_type (argv[3]) != SQLITE_INTEGER)
+	goto error;
+    pyramid_level = sqlite3_value_int (argv[3]);
+    if (argc >= 5)
+      {
+	  if (sqlite3_value_type (argv[4]) != SQLITE_INTEGER)
+	      goto error;
+	  band = sqlite3_value_int (argv[4]);
+      }
+    if (rl2_point_from_blob
+	(sqlite3_value_blob (argv[2]), sqlite3_value_bytes (argv[2]), &x, &y,
+	 &srid) != RL2_OK)
+	goto error;
+
+    if (aggr->count == 0)
+      {
+	  /* first Point: setting the Coverage and Level */
+	  aggr->db_prefix = do_copy_text (db_prefix);
+	  aggr->cvg_name = do_copy_text (cvg_name);
+	  aggr->pyramid_level = pyramid_level;
+	  aggr->band = band;
+	  aggr->srid = srid;
+      }
+    else
+      {
+	  /* all Points must share the same Coverage, Level, Band and SRID */
+	  if (!do_match_text (aggr->db_prefix, db_prefix))
+	      goto error;
+	  if (!do_match_text (aggr->cvg_name, cvg_name))
+	      goto error;
+	  if (aggr->pyramid_level != pyramid_level || aggr->band != band
+	      || aggr->srid != srid)
+	      goto error;
+      }
+
+    if (aggr->count == aggr->max_count)
+      {
+	  /* expanding the Points arrays */
+	  int max_count = (aggr->max_count == 0) ? 1024 : aggr->max_count * 2;
+	  double *xx = realloc (aggr->x, sizeof (double) * max_count);
+	  double *yy;
+	  if (xx == NULL)
+	      goto error;
+	  aggr->x = xx;
+	  yy = realloc (aggr->y, sizeof (double) * max_count);
+	  if (yy == NULL)
+	      goto error;
+	  aggr->y = yy;
+	  aggr->max_count = max_count;
+      }
+    aggr->x[aggr->count] = x;
+    aggr->y[aggr->count] = y;
+    aggr->count += 1;
+    return;
+
+  error:
+    aggr->error = 1;
+}
+
+static int
+do_get_pixel_band_value (rl2PixelPtr pxl, int band, double *value)
+{
+/* retrieving a Pixel's Band value as a double */
+    rl2PrivSamplePtr sample;
+    rl2PrivPixelPtr pixel = (rl2PrivPixelPtr) pxl;
+    if (pixel == NULL)
+	return 0;
+    if (band < 0 || band >= pixel->nBands)
+	return 0;
+    sample = pixel->Samples + band;
+    switch (pixel->sampleType)
+      {
+      case RL2_SAMPLE_INT8:
+	  *value = sample->int8;
+	  break;
+      case RL2_SAMPLE_1_BIT:
+      case RL2_SAMPLE_2_BIT:
+      case RL2_SAMPLE_4_BIT:
+      case RL2_SAMPLE_UINT8:
+	  *value = sample->uint8;
+	  break;
+      case RL2_SAMPLE_INT16:
+	  *value = sample->int16;
+	  break;
+      case RL2_SAMPLE_UINT16:
+	  *value = sample->uint16;
+	  break;
+      case RL2_SAMPLE_INT32:
+	  *value = sample->int32;
+	  break;
+      case RL2_SAMPLE_UINT32:
+	  *value = sample->uint32;
+	  break;
+      case RL2_SAMPLE_FLOAT:
+	  *value = sample->float32;
+	  break;
+      case RL2_SAMPLE_DOUBLE:
+	  *value = sample->float64;
+	  break;
+      default:
+	  return 0;
+      };
+    return 1;
+}
+
+static void
+fnct_GetPixelsFromRasterByPoints_final (sqlite3_context * context)
+{
+/* SQL function:
+/ GetPixelsFromRasterByPoints(text db_prefix, text coverage, 
+/                             BLOB point, int pyramid_level [, int band])
+/
+/ aggregate function - FINAL
+/
+/ will return a MULTIPOINT Z Geometry (same SRID as the input Points)
+/ where each Z is the sampled Band value (NO-DATA outside the Coverage)
+/ or NULL (INVALID ARGS)
+*/
+    int i;
+    sqlite3 *sqlite;
+    const void *data;
+    double *z = NULL;
+    rl2PixelPtr *pixels = NULL;
+    unsigned char *blob;
+    int blob_sz;
+    struct pixels_by_points_aggregate *aggr;
+    struct pixels_by_points_aggregate **p = sqlite3_aggregate_context (context,
+									0);
+    if (p == NULL)
+      {
+	  sqlite3_result_null (context);
+	  return;
+      }
+    aggr = *p;
+    if (aggr == NULL)
+      {
+	  sqlite3_result_null (context);
+	  return;
+      }
+    if (aggr->error || aggr->count == 0)
+	goto error;
+
+    sqlite = sqlite3_context_db_handle (context);
+    data = sqlite3_user_data (context);
+    pixels = malloc (sizeof (rl2PixelPtr) * aggr->count);
+    z = malloc (sizeof (double) * aggr->count);
+    if (pixels == NULL || z == NULL)
+	goto error;
+    if (rl2_pixels_from_raster_by_points
+	(sqlite, data, aggr->db_prefix, aggr->cvg_name, aggr->pyramid_level,
+	 aggr->srid, aggr->count, aggr->x, aggr->y, pixels) != RL2_OK)
+	goto error;
+    for (i = 0; i < aggr->count; i++)
+      {
+	  if (!do_get_pixel_band_value (pixels[i], aggr->band, z + i))
+	    {
+		int j;
+		for (j = 0; j < aggr->count; j++)
+		    rl2_destroy_pixel (pixels[j]);
+		goto error;
+	    }
+      }
+    for (i = 0; i < aggr->count; i++)
+	rl2_destroy_pixel (pixels[i]);
+    free (pixels);
+    pixels = NULL;
+
+    if (!rl2_multipoint_xyz_to_blob
+	(aggr->srid, aggr->count, aggr->x, aggr->y, z, &blob, &blob_sz))
+	goto error;
+    sqlite3_result_blob (context, blob, blob_sz, free);
+    free (z);
+    destroy_pixels_by_points_aggregate (aggr);
+    *p = NULL;
+    return;
+
+  error:
+    sqlite3_result_null (context);
+    if (pixels != NULL)
+	free (pixels);
+    if (z != NULL)
+	free (z);
+    destroy_pixels_by_points_aggregate (aggr);
+    *p = NULL;
+}
+
 static void
 fnct_GetMapImageFromRaster (sqlite3_context * context, int argc,
 			    sqlite3_value ** argv)
@@ -8608,6 +9679,7 @@ fnct_GetTileImage (sqlite3_context * context, int argc, sqlite3_value ** argv)
     unsigned short width;
     unsigned short height;
     sqlite3 *sqlite;
+    const void *data;
     sqlite3_stmt *stmt = NULL;
     int unsupported_tile;
     int has_palette = 0;
@@ -8640,6 +9712,7 @@ fnct_GetTileImage (sqlite3_context * context, int argc, sqlite3_value ** argv)
     unsigned char num_bands;
     rl2PrivPixelPtr no_data = NULL;
     double opacity = 1.0;
+    const char *cache_prefix;
     RL2_UNUSED ();		/* LCOV_EXCL_LINE */
 
     if (sqlite3_value_type (argv[0]) == SQLITE_TEXT
@@ -8677,7 +9750,8 @@ fnct_GetTileImage (sqlite3_context * context, int argc, sqlite3_value ** argv)
 
 /* attempting to load the Coverage definitions from the DBMS */
     sqlite = sqlite3_context_db_handle (context);
-    coverage = rl2_create_coverage_from_dbms (sqlite, db_prefix, cvg_name);
+    data = sqlite3_user_data (context);
+    coverage = rl2_get_cached_coverage (sqlite, data, db_prefix, cvg_name);
     if (coverage == NULL)
 	goto error;
     cvg = (rl2PrivCoveragePtr) coverage;
@@ -8705,13 +9779,14 @@ fnct_GetTileImage (sqlite3_context * context, int argc, sqlite3_value ** argv)
     if (has_palette)
       {
 	  /* loading the Coverage's palette */
-	  palette = rl2_get_dbms_palette (sqlite, db_prefix, cvg_name);
+	  palette = rl2_get_cached_palette (sqlite, data, db_prefix, cvg_name);
 	  if (palette == NULL)
 	      goto error;
       }
     no_data = cvg->noData;
 
 /* querying the tile */
+    cache_prefix = db_prefix;
     if (db_prefix == NULL)
 	db_prefix = "MAIN";
     xdb_prefix = rl2_double_quoted_sql (db_prefix);
@@ -8729,15 +9804,12 @@ fnct_GetTileImage (sqlite3_context * context, int argc, sqlite3_value ** argv)
     free (xtable_tile_data);
     free (xtable_tiles);
     free (xdb_prefix);
-    ret = sqlite3_prepare_v2 (sqlite, sql, strlen (sql), &stmt, NULL);
+    stmt =
+	rl2_acquire_cached_stmt (sqlite, data, cache_prefix, cvg_name,
+				 RL2_STMT_TILE_IMAGE, sql);
     sqlite3_free (sql);
-    if (ret != SQLITE_OK)
-      {
-	  fprintf (stderr, "SQL error: %s\n%s\n", sql, sqlite3_errmsg (sqlite));
-	  goto error;
-      }
-    sqlite3_reset (stmt);
-    sqlite3_clear_bindings (stmt);
+    if (stmt == NULL)
+	goto error;
     sqlite3_bind_int64 (stmt, 1, tile_id);
     while (1)
       {
@@ -9032,7 +10104,7 @@ fnct_GetTileImage (sqlite3_context * context, int argc, sqlite3_value ** argv)
 	  else
 	      goto error;
       }
-    sqlite3_finalize (stmt);
+    rl2_release_cached_stmt (data, stmt);
     stmt = NULL;
 
     rl2_destroy_coverage (coverage);
@@ -9046,7 +10118,7 @@ fnct_GetTileImage (sqlite3_context * context, int argc, sqlite3_value ** argv)
 
   error:
     if (stmt != NULL)
-	sqlite3_finalize (stmt);
+	rl2_release_cached_stmt (data, stmt);
     if (coverage != NULL)
 	rl2_destroy_coverage (coverage);
     if (palette != NULL)
@@ -10053,8 +11125,14 @@ fnct_ImportSectionRawPixels (sqlite3_context * context, int argc,
 }
 
 static void
-register_rl2_sql_functions (void *p_db, const void *p_data)
+register_rl2_sql_functions (void *p_db, const void *p_data,
+			    void (*destroy_data) (void *))
 {
+/*
+/ registering all SQL functions; when "destroy_data" is not NULL the
+/ private data will be released by SQLite itself as soon as the
+/ connection is closed
+*/
     sqlite3 *db = p_db;
     struct rl2_private_data *priv_data = (struct rl2_private_data *) p_data;
     const char *security_level;
@@ -10073,6 +11151,12 @@ register_rl2_sql_functions (void *p_db, const void *p_data)
     sqlite3_create_function (db, "rl2_lzma_version", 0,
 			     SQLITE_UTF8 | SQLITE_DETERMINISTIC, 0,
 			     fnct_rl2_lzma_version, 0, 0);
+    sqlite3_create_function (db, "rl2_zstd_version", 0,
+			     SQLITE_UTF8 | SQLITE_DETERMINISTIC, 0,
+			     fnct_rl2_zstd_version, 0, 0);
+    sqlite3_create_function (db, "rl2_lz4_version", 0,
+			     SQLITE_UTF8 | SQLITE_DETERMINISTIC, 0,
+			     fnct_rl2_lz4_version, 0, 0);
     sqlite3_create_function (db, "rl2_png_version", 0,
 			     SQLITE_UTF8 | SQLITE_DETERMINISTIC, 0,
 			     fnct_rl2_png_version, 0, 0);
@@ -10112,6 +11196,27 @@ register_rl2_sql_functions (void *p_db, const void *p_data)
     sqlite3_create_function (db, "rl2_has_codec_lzma_no", 0,
 			     SQLITE_UTF8 | SQLITE_DETERMINISTIC, 0,
 			     fnct_rl2_has_codec_lzma_no, 0, 0);
+    sqlite3_create_function (db, "rl2_has_codec_zstd", 0,
+			     SQLITE_UTF8 | SQLITE_DETERMINISTIC, 0,
+			     fnct_rl2_has_codec_zstd, 0, 0);
+    sqlite3_create_function (db, "rl2_has_codec_zstd_no", 0,
+			     SQLITE_UTF8 | SQLITE_DETERMINISTIC, 0,
+			     fnct_rl2_has_codec_zstd_no, 0, 0);
+    sqlite3_create_function (db, "rl2_has_codec_lz4", 0,
+			     SQLITE_UTF8 | SQLITE_DETERMINISTIC, 0,
+			     fnct_rl2_has_codec_lz4, 0, 0);
+    sqlite3_create_function (db, "rl2_has_codec_lz4_no", 0,
+			     SQLITE_UTF8 | SQLITE_DETERMINISTIC, 0,
+			     fnct_rl2_has_codec_lz4_no, 0, 0);
+    sqlite3_create_function (db, "rl2_has_codec_deflate_fp", 0,
+			     SQLITE_UTF8 | SQLITE_DETERMINISTIC, 0,
+			     fnct_rl2_has_codec_deflate_fp, 0, 0);
+    sqlite3_create_function (db, "rl2_has_codec_lzma_fp", 0,
+			     SQLITE_UTF8 | SQLITE_DETERMINISTIC, 0,
+			     fnct_rl2_has_codec_lzma_fp, 0, 0);
+    sqlite3_create_function (db, "rl2_has_codec_zstd_fp", 0,
+			     SQLITE_UTF8 | SQLITE_DETERMINISTIC, 0,
+			     fnct_rl2_has_codec_zstd_fp, 0, 0);
     sqlite3_create_function (db, "rl2_has_codec_jpeg", 0,
 			     SQLITE_UTF8 | SQLITE_DETERMINISTIC, 0,
 			     fnct_rl2_has_codec_jpeg, 0, 0);
@@ -10136,12 +11241,42 @@ register_rl2_sql_functions (void *p_db, const void *p_data)
     sqlite3_create_function (db, "rl2_has_codec_ll_jp2", 0,
 			     SQLITE_UTF8 | SQLITE_DETERMINISTIC, 0,
 			     fnct_rl2_has_codec_ll_jp2, 0, 0);
-    sqlite3_create_function (db, "RL2_GetMaxThreads", 0,
-			     SQLITE_UTF8 | SQLITE_DETERMINISTIC, priv_data,
-			     fnct_GetMaxThreads, 0, 0);
+    sqlite3_create_function_v2 (db, "RL2_GetMaxThreads", 0,
+				SQLITE_UTF8 | SQLITE_DETERMINISTIC, priv_data,
+				fnct_GetMaxThreads, 0, 0, destroy_data);
     sqlite3_create_function (db, "RL2_SetMaxThreads", 1,
 			     SQLITE_UTF8 | SQLITE_DETERMINISTIC, priv_data,
 			     fnct_SetMaxThreads, 0, 0);
+    sqlite3_create_function (db, "RL2_SetTileCacheSize", 1, SQLITE_UTF8, 0,
+			     fnct_SetTileCacheSize, 0, 0);
+    sqlite3_create_function (db, "RL2_GetTileCacheSize", 0, SQLITE_UTF8, 0,
+			     fnct_GetTileCacheSize, 0, 0);
+    sqlite3_create_function (db, "RL2_GetTileCacheHits", 0, SQLITE_UTF8, 0,
+			     fnct_GetTileCacheHits, 0, 0);
+    sqlite3_create_function (db, "RL2_GetTileCacheMisses", 0, SQLITE_UTF8, 0,
+			     fnct_GetTileCacheMisses, 0, 0);
+    sqlite3_create_function (db, "RL2_FlushTileCache", 0, SQLITE_UTF8, 0,
+			     fnct_FlushTileCache, 0, 0);
+    sqlite3_create_function (db, "RL2_SetRasterCacheSize", 1, SQLITE_UTF8,
+			     priv_data, fnct_SetRasterCacheSize, 0, 0);
+    sqlite3_create_function (db, "RL2_GetRasterCacheSize", 0, SQLITE_UTF8,
+			     priv_data, fnct_GetRasterCacheSize, 0, 0);
+    sqlite3_create_function (db, "RL2_SetStatementCache", 1, SQLITE_UTF8,
+			     priv_data, fnct_SetStatementCache, 0, 0);
+    sqlite3_create_function (db, "RL2_GetStatementCache", 0, SQLITE_UTF8,
+			     priv_data, fnct_GetStatementCache, 0, 0);
+    sqlite3_create_function (db, "RL2_SetTileGridIndex", 1, SQLITE_UTF8,
+			     priv_data, fnct_SetTileGridIndex, 0, 0);
+    sqlite3_create_function (db, "RL2_GetTileGridIndex", 0, SQLITE_UTF8,
+			     priv_data, fnct_GetTileGridIndex, 0, 0);
+    sqlite3_create_function (db, "RL2_SetTileReaders", 1, SQLITE_UTF8,
+			     priv_data, fnct_SetTileReaders, 0, 0);
+    sqlite3_create_function (db, "RL2_GetTileReaders", 0, SQLITE_UTF8,
+			     priv_data, fnct_GetTileReaders, 0, 0);
+    sqlite3_create_function (db, "RL2_SetTileChecksums", 1, SQLITE_UTF8,
+			     priv_data, fnct_SetTileChecksums, 0, 0);
+    sqlite3_create_function (db, "RL2_GetTileChecksums", 0, SQLITE_UTF8,
+			     priv_data, fnct_GetTileChecksums, 0, 0);
     sqlite3_create_function (db, "IsValidPixel", 3,
 			     SQLITE_UTF8 | SQLITE_DETERMINISTIC, 0,
 			     fnct_IsValidPixel, 0, 0);
@@ -10251,6 +11386,30 @@ register_rl2_sql_functions (void *p_db, const void *p_data)
     sqlite3_create_function (db, "RL2_IsRasterCoverageAutoNdviEnabled", 2,
 			     SQLITE_UTF8, 0,
 			     fnct_IsRasterCoverageAutoNdviEnabled, 0, 0);
+    sqlite3_create_function (db, "EnableRasterCoverageSplitTiles", 2,
+			     SQLITE_UTF8, 0,
+			     fnct_EnableRasterCoverageSplitTiles, 0, 0);
+    sqlite3_create_function (db, "RL2_EnableRasterCoverageSplitTiles", 2,
+			     SQLITE_UTF8, 0,
+			     fnct_EnableRasterCoverageSplitTiles, 0, 0);
+    sqlite3_create_function (db, "IsRasterCoverageSplitTilesEnabled", 2,
+			     SQLITE_UTF8, 0,
+			     fnct_IsRasterCoverageSplitTilesEnabled, 0, 0);
+    sqlite3_create_function (db, "RL2_IsRasterCoverageSplitTilesEnabled", 2,
+			     SQLITE_UTF8, 0,
+			     fnct_IsRasterCoverageSplitTilesEnabled, 0, 0);
+    sqlite3_create_function (db, "SetRasterCoverageResampling", 2,
+			     SQLITE_UTF8, 0,
+			     fnct_SetRasterCoverageResampling, 0, 0);
+    sqlite3_create_function (db, "RL2_SetRasterCoverageResampling", 2,
+			     SQLITE_UTF8, 0,
+			     fnct_SetRasterCoverageResampling, 0, 0);
+    sqlite3_create_function (db, "GetRasterCoverageResampling", 2,
+			     SQLITE_UTF8, 0,
+			     fnct_GetRasterCoverageResampling, 0, 0);
+    sqlite3_create_function (db, "RL2_GetRasterCoverageResampling", 2,
+			     SQLITE_UTF8, 0,
+			     fnct_GetRasterCoverageResampling, 0, 0);
     sqlite3_create_function (db, "GetPaletteNumEntries", 1,
 			     SQLITE_UTF8 | SQLITE_DETERMINISTIC, 0,
 			     fnct_GetPaletteNumEntries, 0, 0);
@@ -10466,18 +11625,26 @@ register_rl2_sql_functions (void *p_db, const void *p_data)
 			     fnct_Pyramidize, 0, 0);
     sqlite3_create_function (db, "RL2_Pyramidize", 4, SQLITE_UTF8, priv_data,
 			     fnct_Pyramidize, 0, 0);
-    sqlite3_create_function (db, "PyramidizeMonolithic", 1, SQLITE_UTF8, 0,
-			     fnct_PyramidizeMonolithic, 0, 0);
-    sqlite3_create_function (db, "RL2_PyramidizeMonolithic", 1, SQLITE_UTF8, 0,
-			     fnct_PyramidizeMonolithic, 0, 0);
-    sqlite3_create_function (db, "PyramidizeMonolithic", 2, SQLITE_UTF8, 0,
-			     fnct_PyramidizeMonolithic, 0, 0);
-    sqlite3_create_function (db, "RL2_PyramidizeMonolithic", 2, SQLITE_UTF8, 0,
-			     fnct_PyramidizeMonolithic, 0, 0);
-    sqlite3_create_function (db, "PyramidizeMonolithic", 3, SQLITE_UTF8, 0,
-			     fnct_PyramidizeMonolithic, 0, 0);
-    sqlite3_create_function (db, "RL2_PyramidizeMonolithic", 3, SQLITE_UTF8, 0,
-			     fnct_PyramidizeMonolithic, 0, 0);
+    sqlite3_create_function (db, "PyramidizeMonolithic", 1, SQLITE_UTF8,
+			     priv_data, fnct_PyramidizeMonolithic, 0, 0);
+    sqlite3_create_function (db, "RL2_PyramidizeMonolithic", 1, SQLITE_UTF8,
+			     priv_data, fnct_PyramidizeMonolithic, 0, 0);
+    sqlite3_create_function (db, "PyramidizeMonolithic", 2, SQLITE_UTF8,
+			     priv_data, fnct_PyramidizeMonolithic, 0, 0);
+    sqlite3_create_function (db, "RL2_PyramidizeMonolithic", 2, SQLITE_UTF8,
+			     priv_data, fnct_PyramidizeMonolithic, 0, 0);
+    sqlite3_create_function (db, "PyramidizeMonolithic", 3, SQLITE_UTF8,
+			     priv_data, fnct_PyramidizeMonolithic, 0, 0);
+    sqlite3_create_function (db, "RL2_PyramidizeMonolithic", 3, SQLITE_UTF8,
+			     priv_data, fnct_PyramidizeMonolithic, 0, 0);
+    sqlite3_create_function (db, "PyramidizeIncremental", 1, SQLITE_UTF8,
+			     priv_data, fnct_PyramidizeIncremental, 0, 0);
+    sqlite3_create_function (db, "RL2_PyramidizeIncremental", 1, SQLITE_UTF8,
+			     priv_data, fnct_PyramidizeIncremental, 0, 0);
+    sqlite3_create_function (db, "PyramidizeIncremental", 2, SQLITE_UTF8,
+			     priv_data, fnct_PyramidizeIncremental, 0, 0);
+    sqlite3_create_function (db, "RL2_PyramidizeIncremental", 2, SQLITE_UTF8,
+			     priv_data, fnct_PyramidizeIncremental, 0, 0);
     sqlite3_create_function (db, "DePyramidize", 1, SQLITE_UTF8, 0,
 			     fnct_DePyramidize, 0, 0);
     sqlite3_create_function (db, "RL2_DePyramidize", 1, SQLITE_UTF8, 0,
@@ -10502,6 +11669,22 @@ register_rl2_sql_functions (void *p_db, const void *p_data)
     sqlite3_create_function (db, "RL2_GetPixelFromRasterByPoint", 5,
 			     SQLITE_UTF8 | SQLITE_DETERMINISTIC, priv_data,
 			     fnct_GetPixelFromRasterByPoint, 0, 0);
+    sqlite3_create_function (db, "GetPixelsFromRasterByPoints", 4, SQLITE_UTF8,
+			     priv_data, 0,
+			     fnct_GetPixelsFromRasterByPoints_step,
+			     fnct_GetPixelsFromRasterByPoints_final);
+    sqlite3_create_function (db, "GetPixelsFromRasterByPoints", 5, SQLITE_UTF8,
+			     priv_data, 0,
+			     fnct_GetPixelsFromRasterByPoints_step,
+			     fnct_GetPixelsFromRasterByPoints_final);
+    sqlite3_create_function (db, "RL2_GetPixelsFromRasterByPoints", 4, SQLITE_UTF8,
+			     priv_data, 0,
+			     fnct_GetPixelsFromRasterByPoints_step,
+			     fnct_GetPixelsFromRasterByPoints_final);
+    sqlite3_create_function (db, "RL2_GetPixelsFromRasterByPoints", 5, SQLITE_UTF8,
+			     priv_data, 0,
+			     fnct_GetPixelsFromRasterByPoints_step,
+			     fnct_GetPixelsFromRasterByPoints_final);
     sqlite3_create_function (db, "GetMapImageFromRaster", 5,
 			     SQLITE_UTF8 | SQLITE_DETERMINISTIC, priv_data,
 			     fnct_GetMapImageFromRaster, 0, 0);
@@ -11375,20 +12558,31 @@ RL2_DECLARE void
 rl2_init (sqlite3 * handle, const void *priv_data, int verbose)
 {
 /* used when SQLite initializes as an ordinary lib */
-    register_rl2_sql_functions (handle, priv_data);
+    register_rl2_sql_functions (handle, priv_data, NULL);
     rl2_splash_screen (verbose);
 }
 
 #else /* built as LOADABLE EXTENSION only */
 
-SQLITE_EXTENSION_INIT1 static int
+SQLITE_EXTENSION_INIT1 static void
+destroy_rl2_extension_data (void *priv_data)
+{
+/* releasing the private data when the connection is closed */
+    rl2_cleanup_private (priv_data);
+}
+
+static int
 init_rl2_extension (sqlite3 * db, char **pzErrMsg,
 		    const sqlite3_api_routines * pApi)
 {
     void *priv_data = rl2_alloc_private ();
     SQLITE_EXTENSION_INIT2 (pApi);
 
-    register_rl2_sql_functions (db, priv_data);
+/* 
+/ the private data (and the shared Worker Threads) will be released 
+/ before the extension itself is unloaded
+*/
+    register_rl2_sql_functions (db, priv_data, destroy_rl2_extension_data);
     return 0;
 }
 
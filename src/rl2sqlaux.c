@@ -44,6 +44,7 @@ the terms of any one of the MPL, the GPL or the LGPL.
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <math.h>
 #include <float.h>
 #include <limits.h>
 #include <stdint.h>
@@ -290,6 +291,20 @@ get_coverage_defs (sqlite3 * sqlite, const char *db_prefix,
 		    xcompression = RL2_COMPRESSION_LZMA;
 		if (strcmp (compr, "LZMA_NO") == 0)
 		    xcompression = RL2_COMPRESSION_LZMA_NO;
+		if (strcmp (compr, "ZSTD") == 0)
+		    xcompression = RL2_COMPRESSION_ZSTD;
+		if (strcmp (compr, "ZSTD_NO") == 0)
+		    xcompression = RL2_COMPRESSION_ZSTD_NO;
+		if (strcmp (compr, "LZ4") == 0)
+		    xcompression = RL2_COMPRESSION_LZ4;
+		if (strcmp (compr, "LZ4_NO") == 0)
+		    xcompression = RL2_COMPRESSION_LZ4_NO;
+		if (strcmp (compr, "DEFLATE_FP") == 0)
+		    xcompression = RL2_COMPRESSION_DEFLATE_FP;
+		if (strcmp (compr, "LZMA_FP") == 0)
+		    xcompression = RL2_COMPRESSION_LZMA_FP;
+		if (strcmp (compr, "ZSTD_FP") == 0)
+		    xcompression = RL2_COMPRESSION_ZSTD_FP;
 		if (strcmp (compr, "PNG") == 0)
 		    xcompression = RL2_COMPRESSION_PNG;
 		if (strcmp (compr, "JPEG") == 0)
@@ -1440,19 +1455,26 @@ add_base_resolution (ResolutionsListPtr list, int level, int scale,
     list->last = res;
 }
 
-RL2_PRIVATE int
-rl2_find_best_resolution_level (sqlite3 * handle, const char *db_prefix,
-				const char *coverage, int by_section,
-				sqlite3_int64 section_id, double x_res,
-				double y_res, int *level_id, int *scale,
-				int *real_scale, double *xx_res, double *yy_res)
+RL2_PRIVATE void
+rl2_destroy_resolutions_table (struct rl2_resolutions_table *table)
 {
-/* attempting to identify the optimal resolution level */
+/* memory cleanup - destroying a Resolutions Table */
+    if (table == NULL)
+	return;
+    if (table->items != NULL)
+	free (table->items);
+    free (table);
+}
+
+RL2_PRIVATE struct rl2_resolutions_table *
+rl2_load_resolutions_table (sqlite3 * handle, const char *db_prefix,
+			    const char *coverage, int by_section,
+			    sqlite3_int64 section_id)
+{
+/* loading the Resolutions Table of some Coverage (or Section) */
     int ret;
-    int found = 0;
-    int z_level;
-    int z_scale;
     int z_real;
+    int count;
     double z_x_res;
     double z_y_res;
     char *xcoverage;
@@ -1461,10 +1483,12 @@ rl2_find_best_resolution_level (sqlite3 * handle, const char *db_prefix,
     sqlite3_stmt *stmt = NULL;
     ResolutionsListPtr list = NULL;
     ResolutionLevelPtr res;
+    struct rl2_resolutions_table *table = NULL;
+    struct rl2_level_resolution *item;
     char *xdb_prefix;
 
     if (coverage == NULL)
-	return 0;
+	return NULL;
 
     if (db_prefix == NULL)
 	db_prefix = "MAIN";
@@ -1509,6 +1533,7 @@ rl2_find_best_resolution_level (sqlite3 * handle, const char *db_prefix,
     if (ret != SQLITE_OK)
       {
 	  fprintf (stderr, "SQL error: %s\n%s\n", sql, sqlite3_errmsg (handle));
+	  sqlite3_free (sql);
 	  goto error;
       }
     sqlite3_free (sql);
@@ -1561,65 +1586,164 @@ rl2_find_best_resolution_level (sqlite3 * handle, const char *db_prefix,
 	    }
 	  else
 	    {
-		fprintf (stderr, "SQL error: %s\n%s\n", sql,
-			 sqlite3_errmsg (handle));
+		fprintf (stderr, "SQL error: %s\n", sqlite3_errmsg (handle));
 		goto error;
 	    }
       }
     sqlite3_finalize (stmt);
+    stmt = NULL;
 
 /* adjusting real scale factors */
+    count = 0;
     z_real = 1;
     res = list->last;
     while (res != NULL)
       {
 	  res->real_scale = z_real;
 	  z_real *= 2;
+	  count++;
 	  res = res->prev;
       }
-/* retrieving the best resolution level */
-    found = 0;
-    res = list->last;
+
+/* building the sorted array */
+    table = malloc (sizeof (struct rl2_resolutions_table));
+    if (table == NULL)
+	goto error;
+    table->section_id = section_id;
+    table->count = count;
+    table->monotonic = 1;
+    table->items = NULL;
+    if (count > 0)
+      {
+	  table->items = malloc (sizeof (struct rl2_level_resolution) * count);
+	  if (table->items == NULL)
+	      goto error;
+      }
+    item = table->items;
+    res = list->first;
     while (res != NULL)
       {
-	  if (res->x_resolution <= x_res && res->y_resolution <= y_res)
+	  item->level = res->level;
+	  item->scale = res->scale;
+	  item->real_scale = res->real_scale;
+	  item->x_resolution = res->x_resolution;
+	  item->y_resolution = res->y_resolution;
+	  if (item != table->items)
 	    {
-		found = 1;
-		z_level = res->level;
-		z_scale = res->scale;
-		z_real = res->real_scale;
-		z_x_res = res->x_resolution;
-		z_y_res = res->y_resolution;
+		/* resolutions are expected to become finer and finer */
+		struct rl2_level_resolution *prev = item - 1;
+		if (item->x_resolution > prev->x_resolution
+		    || item->y_resolution > prev->y_resolution)
+		    table->monotonic = 0;
 	    }
-	  res = res->prev;
-      }
-    if (found)
-      {
-	  *level_id = z_level;
-	  *scale = z_scale;
-	  *real_scale = z_real;
-	  *xx_res = z_x_res;
-	  *yy_res = z_y_res;
-      }
-    else if (list->last != NULL)
-      {
-	  res = list->last;
-	  *level_id = res->level;
-	  *scale = res->scale;
-	  *xx_res = res->x_resolution;
-	  *yy_res = res->y_resolution;
+	  item++;
+	  res = res->next;
       }
-    else
-	goto error;
     destroy_resolutions_list (list);
-    return 1;
+    return table;
 
   error:
     if (stmt != NULL)
 	sqlite3_finalize (stmt);
     if (list != NULL)
 	destroy_resolutions_list (list);
-    return 0;
+    if (table != NULL)
+	rl2_destroy_resolutions_table (table);
+    return NULL;
+}
+
+static struct rl2_level_resolution *
+do_search_resolutions_table (struct rl2_resolutions_table *table,
+			     double x_res, double y_res)
+{
+/* 
+/ searching the lowest resolution still matching the requested one;
+/ falling back to the highest resolution if none matches
+*/
+    int i;
+    int lo;
+    int hi;
+    int mid;
+    struct rl2_level_resolution *item;
+
+    if (table->count <= 0)
+	return NULL;
+    if (table->monotonic)
+      {
+	  /* binary search */
+	  lo = 0;
+	  hi = table->count;
+	  while (lo < hi)
+	    {
+		mid = lo + ((hi - lo) / 2);
+		item = table->items + mid;
+		if (item->x_resolution <= x_res && item->y_resolution <= y_res)
+		    hi = mid;
+		else
+		    lo = mid + 1;
+	    }
+	  if (lo < table->count)
+	      return table->items + lo;
+      }
+    else
+      {
+	  /* unordered resolutions: linear scan */
+	  for (i = 0; i < table->count; i++)
+	    {
+		item = table->items + i;
+		if (item->x_resolution <= x_res && item->y_resolution <= y_res)
+		    return item;
+	    }
+      }
+    return table->items + (table->count - 1);
+}
+
+RL2_PRIVATE int
+rl2_find_best_resolution_level (sqlite3 * handle, const void *data,
+				const char *db_prefix, const char *coverage,
+				int by_section, sqlite3_int64 section_id,
+				double x_res, double y_res, int *level_id,
+				int *scale, int *real_scale, double *xx_res,
+				double *yy_res)
+{
+/* attempting to identify the optimal resolution level */
+    struct rl2_resolutions_table *table = NULL;
+    struct rl2_resolutions_table *owned = NULL;
+    struct rl2_level_resolution *item;
+
+    if (coverage == NULL)
+	return 0;
+
+    if (data != NULL)
+	table =
+	    rl2_get_cached_resolutions (handle, data, db_prefix, coverage,
+					by_section, section_id);
+    if (table == NULL)
+      {
+	  /* not cached: loading a transient Resolutions Table */
+	  owned =
+	      rl2_load_resolutions_table (handle, db_prefix, coverage,
+					  by_section, section_id);
+	  if (owned == NULL)
+	      return 0;
+	  table = owned;
+      }
+
+    item = do_search_resolutions_table (table, x_res, y_res);
+    if (item == NULL)
+      {
+	  if (owned != NULL)
+	      rl2_destroy_resolutions_table (owned);
+	  return 0;
+      }
+    *level_id = item->level;
+    *scale = item->scale;
+    *real_scale = item->real_scale;
+    *xx_res = item->x_resolution;
+    *yy_res = item->y_resolution;
+    if (owned != NULL)
+	rl2_destroy_resolutions_table (owned);
+    return 1;
 }
 
 RL2_PRIVATE unsigned char
@@ -6069,6 +6193,7 @@ do_get_raw_raster_data (struct aux_renderer *aux, int by_section)
     int was_monochrome;
     unsigned char out_pixel = aux->out_pixel;
     sqlite3 *sqlite = aux->sqlite;
+    const void *data = aux->data;
     int max_threads = aux->max_threads;
     int base_width = aux->base_width;
     int base_height = aux->base_height;
@@ -6118,8 +6243,8 @@ do_get_raw_raster_data (struct aux_renderer *aux, int by_section)
 	    }
 	  if (out_pixel == RL2_PIXEL_PALETTE)
 	      out_pixel = RL2_PIXEL_RGB;
-	  if (rl2_get_raw_raster_data_mixed_resolutions
-	      (sqlite, max_threads, coverage, base_width, base_height,
+	  if (rl2_get_raw_raster_data_mixed_common
+	      (sqlite, data, max_threads, coverage, base_width, base_height,
 	       minx, miny, maxx, maxy, xx_res, yy_res,
 	       &outbuf, &outbuf_size, &palette, &out_pixel, bg_red, bg_green,
 	       bg_blue, symbolizer, stats) != RL2_OK)
@@ -6147,8 +6272,8 @@ do_get_raw_raster_data (struct aux_renderer *aux, int by_section)
 		if (level_id != 0 && scale != 1)
 		    out_pixel = RL2_PIXEL_RGB;
 	    }
-	  if (rl2_get_raw_raster_data_bgcolor
-	      (sqlite, max_threads, coverage, base_width, base_height,
+	  if (rl2_get_raw_raster_data_bgcolor_common
+	      (sqlite, data, max_threads, coverage, base_width, base_height,
 	       minx, miny, maxx, maxy, xx_res, yy_res,
 	       &outbuf, &outbuf_size, &palette, &out_pixel, bg_red, bg_green,
 	       bg_blue, symbolizer, stats) != RL2_OK)
@@ -6345,7 +6470,8 @@ do_paint_map_from_raster (struct aux_raster_render *args)
       }
 
 /* attempting to load the Coverage definitions from the DBMS */
-    coverage = rl2_create_coverage_from_dbms (sqlite, db_prefix, cvg_name);
+    coverage =
+	rl2_get_cached_coverage (sqlite, data, db_prefix, cvg_name);
     if (coverage == NULL)
 	goto error;
     if (rl2_get_coverage_srid (coverage, &srid) != RL2_OK)
@@ -6418,8 +6544,8 @@ do_paint_map_from_raster (struct aux_raster_render *args)
       {
 	  /* attempting to get a Coverage Style */
 	  cvg_stl =
-	      rl2_create_coverage_style_from_dbms (sqlite, db_prefix,
-						   cvg_name, style);
+	      rl2_get_cached_coverage_style (sqlite, data, db_prefix,
+					     cvg_name, style);
 	  if (cvg_stl == NULL)
 	      goto error;
 	  symbolizer =
@@ -6434,8 +6560,8 @@ do_paint_map_from_raster (struct aux_raster_render *args)
 		goto done;
 	    }
 	  stats =
-	      rl2_create_raster_statistics_from_dbms (sqlite, db_prefix,
-						      cvg_name);
+	      rl2_get_cached_raster_statistics (sqlite, data, db_prefix,
+						cvg_name);
 	  if (stats == NULL)
 	      goto error;
 	  ok_style = 1;
@@ -6496,9 +6622,9 @@ do_paint_map_from_raster (struct aux_raster_render *args)
 		if (stats == NULL)
 		  {
 		      stats =
-			  rl2_create_raster_statistics_from_dbms (sqlite,
-								  db_prefix,
-								  cvg_name);
+			  rl2_get_cached_raster_statistics (sqlite, data,
+							    db_prefix,
+							    cvg_name);
 		      if (stats == NULL)
 			  goto error;
 		  }
@@ -6527,9 +6653,8 @@ do_paint_map_from_raster (struct aux_raster_render *args)
 	  if (stats == NULL)
 	    {
 		stats =
-		    rl2_create_raster_statistics_from_dbms (sqlite,
-							    db_prefix,
-							    cvg_name);
+		    rl2_get_cached_raster_statistics (sqlite, data,
+						      db_prefix, cvg_name);
 		if (stats == NULL)
 		    goto error;
 	    }
@@ -6604,8 +6729,8 @@ do_paint_map_from_raster (struct aux_raster_render *args)
 	  by_section = 0;
 	  /* retrieving the optimal resolution level */
 	  if (!rl2_find_best_resolution_level
-	      (sqlite, db_prefix, cvg_name, 0, 0, x_res, y_res, &level_id,
-	       &scale, &xscale, &xx_res, &yy_res))
+	      (sqlite, data, db_prefix, cvg_name, 0, 0, x_res, y_res,
+	       &level_id, &scale, &xscale, &xx_res, &yy_res))
 	      goto error;
       }
 
@@ -6641,6 +6766,7 @@ do_paint_map_from_raster (struct aux_raster_render *args)
 
 /* preparing the aux struct for passing rendering arguments */
     aux.sqlite = sqlite;
+    aux.data = data;
     aux.max_threads = max_threads;
     aux.width = width;
     aux.height = height;
@@ -7055,6 +7181,32 @@ do_update_pixel (rl2PrivRasterPtr rst, int x, int y, rl2PrivPixelPtr pxl)
       };
 }
 
+static int
+do_sample_raster_pixel (rl2PrivRasterPtr rst, double x, double y,
+			rl2PrivPixelPtr pxl)
+{
+/* extracting the Pixel at coordinates [X,Y] from a Tile */
+    int dx = (int) ((x - rst->minX) / rst->hResolution);
+    int dy = (int) ((rst->maxY - y) / rst->vResolution);
+    /* 
+    / a Point lying exactly on the right or bottom edge of the Tile
+    / (no adjacent Tile) belongs to the last column or row
+    */
+    if (dx == (int) (rst->width) && x <= rst->maxX)
+	dx--;
+    if (dy == (int) (rst->height) && y >= rst->minY)
+	dy--;
+    if (dx < 0 || dx >= (int) (rst->width))
+	return 0;
+    if (dy < 0 || dy >= (int) (rst->height))
+	return 0;
+    if (rst->sampleType != pxl->sampleType
+	|| rst->pixelType != pxl->pixelType || rst->nBands != pxl->nBands)
+	return 0;
+    do_update_pixel (rst, dx, dy, pxl);
+    return 1;
+}
+
 RL2_DECLARE int
 rl2_pixel_from_raster_by_point (sqlite3 * sqlite, const void *data,
 				const char *db_prefix, const char *cvg_name,
@@ -7078,14 +7230,15 @@ rl2_pixel_from_raster_by_point (sqlite3 * sqlite, const void *data,
 	goto error;
 
 /* attempting to load the Coverage definitions from the DBMS */
-    coverage = rl2_create_coverage_from_dbms (sqlite, db_prefix, cvg_name);
+    coverage =
+	rl2_get_cached_coverage (sqlite, data, db_prefix, cvg_name);
     if (coverage == NULL)
 	goto error;
     if (rl2_get_coverage_srid (coverage, &srid_cvg) != RL2_OK)
 	goto error;
 
 /* retrieving the Coverage's Palette */
-    palette = rl2_get_dbms_palette (sqlite, db_prefix, cvg_name);
+    palette = rl2_get_cached_palette (sqlite, data, db_prefix, cvg_name);
 
 /* retrieving the NO-DATA pixel */
     xpixel = rl2_clone_pixel (rl2_get_coverage_no_data (coverage));
@@ -7111,31 +7264,333 @@ rl2_pixel_from_raster_by_point (sqlite3 * sqlite, const void *data,
     if (raster != NULL)
       {
 	  /* extracting the Pixel at coordinates [X,Y] */
-	  rl2PrivRasterPtr rst = (rl2PrivRasterPtr) raster;
-	  rl2PrivPixelPtr pxl = (rl2PrivPixelPtr) xpixel;
-	  int dx = (int) ((x - rst->minX) / rst->hResolution);
-	  int dy = (int) ((rst->maxY - y) / rst->vResolution);
-	  if (dx < 0 || dx >= (int) (rst->width))
-	      goto error;
-	  if (dy < 0 || dy >= (int) (rst->height))
+	  if (!do_sample_raster_pixel
+	      ((rl2PrivRasterPtr) raster, x, y, (rl2PrivPixelPtr) xpixel))
 	      goto error;
-	  if (rst->sampleType != pxl->sampleType
-	      || rst->pixelType != pxl->pixelType || rst->nBands != pxl->nBands)
-	      goto error;
-	  do_update_pixel (rst, dx, dy, pxl);
       }
+    if (palette != NULL)
+	rl2_destroy_palette (palette);
     *pixel = xpixel;
     return RL2_OK;
 
   error:
     if (coverage != NULL)
 	rl2_destroy_coverage (coverage);
+    if (palette != NULL)
+	rl2_destroy_palette (palette);
     if (xpixel != NULL)
 	rl2_destroy_pixel (xpixel);
     *pixel = NULL;
     return RL2_ERROR;
 }
 
+static int
+do_get_level_tile_extent (sqlite3 * handle, const char *db_prefix,
+			  const char *cvg_name, int pyramid_level,
+			  unsigned int tile_width, unsigned int tile_height,
+			  double *ext_x, double *ext_y)
+{
+/* retrieving the ground extent of a Tile at the given Pyramid Level */
+    int ret;
+    char *sql;
+    char *table;
+    char *xtable;
+    char *xdb_prefix;
+    double xres = 0.0;
+    double yres = 0.0;
+    sqlite3_stmt *stmt = NULL;
+
+    if (rl2_is_mixed_resolutions_coverage (handle, db_prefix, cvg_name) > 0)
+	table = sqlite3_mprintf ("%s_section_levels", cvg_name);
+    else
+	table = sqlite3_mprintf ("%s_levels", cvg_name);
+    xtable = rl2_double_quoted_sql (table);
+    sqlite3_free (table);
+    if (db_prefix == NULL)
+	db_prefix = "MAIN";
+    xdb_prefix = rl2_double_quoted_sql (db_prefix);
+    sql =
+	sqlite3_mprintf
+	("SELECT Min(x_resolution_1_1), Min(y_resolution_1_1) "
+	 "FROM \"%s\".\"%s\" WHERE pyramid_level = ?", xdb_prefix, xtable);
+    free (xtable);
+    free (xdb_prefix);
+    ret = sqlite3_prepare_v2 (handle, sql, strlen (sql), &stmt, NULL);
+    sqlite3_free (sql);
+    if (ret != SQLITE_OK)
+	return 0;
+
+    sqlite3_reset (stmt);
+    sqlite3_clear_bindings (stmt);
+    sqlite3_bind_int (stmt, 1, pyramid_level);
+    while (1)
+      {
+	  ret = sqlite3_step (stmt);
+	  if (ret == SQLITE_DONE)
+	      break;
+	  if (ret == SQLITE_ROW)
+	    {
+		if (sqlite3_column_type (stmt, 0) == SQLITE_FLOAT)
+		    xres = sqlite3_column_double (stmt, 0);
+		if (sqlite3_column_type (stmt, 1) == SQLITE_FLOAT)
+		    yres = sqlite3_column_double (stmt, 1);
+	    }
+	  else
+	      break;
+      }
+    sqlite3_finalize (stmt);
+    if (xres <= 0.0 || yres <= 0.0)
+	return 0;
+    *ext_x = xres * (double) tile_width;
+    *ext_y = yres * (double) tile_height;
+    return 1;
+}
+
+static int
+do_transform_points (sqlite3 * handle, int srid, int srid_cvg,
+		     int num_points, double *x, double *y)
+{
+/* transforming all Points into the Raster Coverage SRID (in place) */
+    int ret;
+    int i;
+    sqlite3_stmt *stmt = NULL;
+    const char *sql;
+
+    sql = "SELECT ST_X(g), ST_Y(g) FROM "
+	"(SELECT ST_Transform(MakePoint(?, ?, ?), ?) AS g)";
+    ret = sqlite3_prepare_v2 (handle, sql, strlen (sql), &stmt, NULL);
+    if (ret != SQLITE_OK)
+      {
+	  printf ("SELECT pixels-reproject SQL error: %s\n",
+		  sqlite3_errmsg (handle));
+	  goto error;
+      }
+
+    for (i = 0; i < num_points; i++)
+      {
+	  int count = 0;
+	  sqlite3_reset (stmt);
+	  sqlite3_clear_bindings (stmt);
+	  sqlite3_bind_double (stmt, 1, x[i]);
+	  sqlite3_bind_double (stmt, 2, y[i]);
+	  sqlite3_bind_int (stmt, 3, srid);
+	  sqlite3_bind_int (stmt, 4, srid_cvg);
+	  while (1)
+	    {
+		ret = sqlite3_step (stmt);
+		if (ret == SQLITE_DONE)
+		    break;
+		if (ret == SQLITE_ROW)
+		  {
+		      if (sqlite3_column_type (stmt, 0) == SQLITE_FLOAT
+			  && sqlite3_column_type (stmt, 1) == SQLITE_FLOAT)
+			{
+			    x[i] = sqlite3_column_double (stmt, 0);
+			    y[i] = sqlite3_column_double (stmt, 1);
+			    count++;
+			}
+		  }
+		else
+		  {
+		      fprintf (stderr,
+			       "SELECT pixels-reproject; sqlite3_step() error: %s\n",
+			       sqlite3_errmsg (handle));
+		      goto error;
+		  }
+	    }
+	  if (count != 1)
+	      goto error;
+      }
+    sqlite3_finalize (stmt);
+    return 1;
+
+  error:
+    if (stmt != NULL)
+	sqlite3_finalize (stmt);
+    return 0;
+}
+
+struct rl2_point_tile_ref
+{
+/* helper struct - sorting Points by Tile */
+    int row;
+    int col;
+    int index;
+};
+
+static int
+cmp_point_tile_refs (const void *p1, const void *p2)
+{
+/* compares two Points by Tile row / col (and then by original position) */
+    const struct rl2_point_tile_ref *r1 = (const struct rl2_point_tile_ref *) p1;
+    const struct rl2_point_tile_ref *r2 = (const struct rl2_point_tile_ref *) p2;
+    if (r1->row != r2->row)
+	return (r1->row < r2->row) ? -1 : 1;
+    if (r1->col != r2->col)
+	return (r1->col < r2->col) ? -1 : 1;
+    if (r1->index != r2->index)
+	return (r1->index < r2->index) ? -1 : 1;
+    return 0;
+}
+
+RL2_DECLARE int
+rl2_pixels_from_raster_by_points (sqlite3 * sqlite, const void *data,
+				  const char *db_prefix, const char *cvg_name,
+				  int pyramid_level, int srid, int num_points,
+				  const double *x, const double *y,
+				  rl2PixelPtr * pixels)
+{
+/* 
+/ retrieving many Pixels at once from a Raster Coverage 
+/ Points are visited grouped by Tile, so that each Tile is decoded once
+*/
+    int i;
+    int srid_cvg;
+    unsigned int tile_width;
+    unsigned int tile_height;
+    double ext_x;
+    double ext_y;
+    int sorted = 0;
+    int empty = 0;
+    int empty_row = 0;
+    int empty_col = 0;
+    double *xx = NULL;
+    double *yy = NULL;
+    struct rl2_point_tile_ref *refs = NULL;
+    rl2CoveragePtr coverage = NULL;
+    rl2PalettePtr palette = NULL;
+    rl2PixelPtr no_data = NULL;
+    rl2PrivRasterPtr rst = NULL;
+
+    if (pixels == NULL || x == NULL || y == NULL || num_points <= 0)
+	return RL2_ERROR;
+    for (i = 0; i < num_points; i++)
+	pixels[i] = NULL;
+
+/* attempting to load the Coverage definitions from the DBMS (just once) */
+    coverage =
+	rl2_get_cached_coverage (sqlite, data, db_prefix, cvg_name);
+    if (coverage == NULL)
+	goto error;
+    if (rl2_get_coverage_srid (coverage, &srid_cvg) != RL2_OK)
+	goto error;
+    if (rl2_get_coverage_tile_size (coverage, &tile_width, &tile_height) !=
+	RL2_OK)
+	goto error;
+    no_data = rl2_clone_pixel (rl2_get_coverage_no_data (coverage));
+    if (no_data == NULL)
+	goto error;
+    rl2_destroy_coverage (coverage);
+    coverage = NULL;
+    palette = rl2_get_cached_palette (sqlite, data, db_prefix, cvg_name);
+
+/* copying (and transforming, if required) all Points */
+    xx = malloc (sizeof (double) * num_points);
+    yy = malloc (sizeof (double) * num_points);
+    refs = malloc (sizeof (struct rl2_point_tile_ref) * num_points);
+    if (xx == NULL || yy == NULL || refs == NULL)
+	goto error;
+    memcpy (xx, x, sizeof (double) * num_points);
+    memcpy (yy, y, sizeof (double) * num_points);
+    if (srid != srid_cvg)
+      {
+	  if (!do_transform_points (sqlite, srid, srid_cvg, num_points, xx, yy))
+	      goto error;
+      }
+
+/* sorting the Points by Tile */
+    if (do_get_level_tile_extent
+	(sqlite, db_prefix, cvg_name, pyramid_level, tile_width, tile_height,
+	 &ext_x, &ext_y))
+	sorted = 1;
+    for (i = 0; i < num_points; i++)
+      {
+	  struct rl2_point_tile_ref *ref = refs + i;
+	  ref->index = i;
+	  if (sorted)
+	    {
+		ref->row = (int) floor (-yy[i] / ext_y);
+		ref->col = (int) floor (xx[i] / ext_x);
+	    }
+	  else
+	    {
+		ref->row = 0;
+		ref->col = 0;
+	    }
+      }
+    if (sorted)
+	qsort (refs, num_points, sizeof (struct rl2_point_tile_ref),
+	       cmp_point_tile_refs);
+
+/* sampling all Points */
+    for (i = 0; i < num_points; i++)
+      {
+	  struct rl2_point_tile_ref *ref = refs + i;
+	  double px = xx[ref->index];
+	  double py = yy[ref->index];
+	  rl2PixelPtr pxl = rl2_clone_pixel (no_data);
+	  if (pxl == NULL)
+	      goto error;
+	  pixels[ref->index] = pxl;
+	  if (rst != NULL && px >= rst->minX && px < rst->maxX
+	      && py > rst->minY && py <= rst->maxY)
+	      ;			/* still within the current Tile (half-open bounds) */
+	  else
+	    {
+		rl2RasterPtr raster = NULL;
+		if (rst == NULL && empty && sorted && ref->row == empty_row
+		    && ref->col == empty_col)
+		    continue;	/* no Tile at all covering this grid cell */
+		if (rl2_find_cached_raster
+		    (data, db_prefix, cvg_name, pyramid_level, px, py,
+		     &raster) == RL2_OK)
+		    ;
+		else if (rl2_load_cached_raster
+			 (sqlite, data, db_prefix, cvg_name, pyramid_level, px,
+			  py, palette, &raster) != RL2_OK)
+		    goto error;
+		rst = (rl2PrivRasterPtr) raster;
+		if (rst == NULL)
+		  {
+		      empty = 1;
+		      empty_row = ref->row;
+		      empty_col = ref->col;
+		      continue;
+		  }
+	    }
+	  do_sample_raster_pixel (rst, px, py, (rl2PrivPixelPtr) pxl);
+      }
+
+    free (xx);
+    free (yy);
+    free (refs);
+    rl2_destroy_pixel (no_data);
+    if (palette != NULL)
+	rl2_destroy_palette (palette);
+    return RL2_OK;
+
+  error:
+    if (coverage != NULL)
+	rl2_destroy_coverage (coverage);
+    if (palette != NULL)
+	rl2_destroy_palette (palette);
+    if (no_data != NULL)
+	rl2_destroy_pixel (no_data);
+    if (xx != NULL)
+	free (xx);
+    if (yy != NULL)
+	free (yy);
+    if (refs != NULL)
+	free (refs);
+    for (i = 0; i < num_points; i++)
+      {
+	  if (pixels[i] != NULL)
+	      rl2_destroy_pixel (pixels[i]);
+	  pixels[i] = NULL;
+      }
+    return RL2_ERROR;
+}
+
 RL2_DECLARE int
 rl2_map_image_paint_from_raster (sqlite3 * sqlite, const void *data,
 				 rl2CanvasPtr canvas, const char *db_prefix,
@@ -2229,3 +2229,157 @@ rl2_clone_text_symbolizer (rl2PrivTextSymbolizerPtr in)
 
     return out;
 }
+
+static char *
+clone_string (const char *in)
+{
+/* cloning a (nullable) text string */
+    int len;
+    char *out;
+    if (in == NULL)
+	return NULL;
+    len = strlen (in);
+    out = malloc (len + 1);
+    strcpy (out, in);
+    return out;
+}
+
+static void *
+clone_rule_args (unsigned char comparison_op, void *args)
+{
+/* cloning the comparison arguments of a Style Rule */
+    if (args == NULL)
+	return NULL;
+    if (comparison_op == RL2_COMPARISON_LIKE)
+      {
+	  rl2PrivRuleLikeArgsPtr in = (rl2PrivRuleLikeArgsPtr) args;
+	  rl2PrivRuleLikeArgsPtr out = malloc (sizeof (rl2PrivRuleLikeArgs));
+	  out->wild_card = clone_string (in->wild_card);
+	  out->single_char = clone_string (in->single_char);
+	  out->escape_char = clone_string (in->escape_char);
+	  out->value = clone_string (in->value);
+	  return out;
+      }
+    if (comparison_op == RL2_COMPARISON_BETWEEN)
+      {
+	  rl2PrivRuleBetweenArgsPtr in = (rl2PrivRuleBetweenArgsPtr) args;
+	  rl2PrivRuleBetweenArgsPtr out =
+	      malloc (sizeof (rl2PrivRuleBetweenArgs));
+	  out->lower = clone_string (in->lower);
+	  out->upper = clone_string (in->upper);
+	  return out;
+      }
+    else
+      {
+	  rl2PrivRuleSingleArgPtr in = (rl2PrivRuleSingleArgPtr) args;
+	  rl2PrivRuleSingleArgPtr out = malloc (sizeof (rl2PrivRuleSingleArg));
+	  out->value = clone_string (in->value);
+	  return out;
+      }
+}
+
+static rl2PrivColorMapPointPtr
+clone_color_map_points (rl2PrivColorMapPointPtr in,
+			rl2PrivColorMapPointPtr * last)
+{
+/* cloning a list of ColorMap Points */
+    rl2PrivColorMapPointPtr first = NULL;
+    *last = NULL;
+    while (in != NULL)
+      {
+	  rl2PrivColorMapPointPtr out = malloc (sizeof (rl2PrivColorMapPoint));
+	  out->value = in->value;
+	  out->red = in->red;
+	  out->green = in->green;
+	  out->blue = in->blue;
+	  out->next = NULL;
+	  if (first == NULL)
+	      first = out;
+	  if (*last != NULL)
+	      (*last)->next = out;
+	  *last = out;
+	  in = in->next;
+      }
+    return first;
+}
+
+static rl2PrivRasterSymbolizerPtr
+clone_raster_symbolizer (rl2PrivRasterSymbolizerPtr in)
+{
+/* cloning a Raster Symbolizer */
+    rl2PrivRasterSymbolizerPtr out;
+    if (in == NULL)
+	return NULL;
+    out = malloc (sizeof (rl2PrivRasterSymbolizer));
+    memcpy (out, in, sizeof (rl2PrivRasterSymbolizer));
+    out->bandSelection = NULL;
+    out->categorize = NULL;
+    out->interpolate = NULL;
+    if (in->bandSelection != NULL)
+      {
+	  out->bandSelection = malloc (sizeof (rl2PrivBandSelection));
+	  memcpy (out->bandSelection, in->bandSelection,
+		  sizeof (rl2PrivBandSelection));
+      }
+    if (in->categorize != NULL)
+      {
+	  out->categorize = malloc (sizeof (rl2PrivColorMapCategorize));
+	  memcpy (out->categorize, in->categorize,
+		  sizeof (rl2PrivColorMapCategorize));
+	  out->categorize->first =
+	      clone_color_map_points (in->categorize->first,
+				      &(out->categorize->last));
+      }
+    if (in->interpolate != NULL)
+      {
+	  out->interpolate = malloc (sizeof (rl2PrivColorMapInterpolate));
+	  memcpy (out->interpolate, in->interpolate,
+		  sizeof (rl2PrivColorMapInterpolate));
+	  out->interpolate->first =
+	      clone_color_map_points (in->interpolate->first,
+				      &(out->interpolate->last));
+      }
+    return out;
+}
+
+RL2_PRIVATE rl2CoverageStylePtr
+rl2_clone_coverage_style (rl2CoverageStylePtr style)
+{
+/* cloning a Coverage Style (Raster Symbolizers only) */
+    rl2PrivStyleRulePtr rule_in;
+    rl2PrivCoverageStylePtr in = (rl2PrivCoverageStylePtr) style;
+    rl2PrivCoverageStylePtr out;
+    if (in == NULL)
+	return NULL;
+
+    out = malloc (sizeof (rl2PrivCoverageStyle));
+    out->name = clone_string (in->name);
+    out->first_rule = NULL;
+    out->last_rule = NULL;
+    rule_in = in->first_rule;
+    while (rule_in != NULL)
+      {
+	  rl2PrivStyleRulePtr rule_out;
+	  if (rule_in->style != NULL && rule_in->style_type != RL2_RASTER_STYLE)
+	    {
+		/* unexpected Symbolizer type */
+		rl2_destroy_coverage_style ((rl2CoverageStylePtr) out);
+		return NULL;
+	    }
+	  rule_out = malloc (sizeof (rl2PrivStyleRule));
+	  memcpy (rule_out, rule_in, sizeof (rl2PrivStyleRule));
+	  rule_out->comparison_args =
+	      clone_rule_args (rule_in->comparison_op,
+			       rule_in->comparison_args);
+	  rule_out->column_name = clone_string (rule_in->column_name);
+	  rule_out->style = clone_raster_symbolizer (rule_in->style);
+	  rule_out->next = NULL;
+	  if (out->first_rule == NULL)
+	      out->first_rule = rule_out;
+	  if (out->last_rule != NULL)
+	      out->last_rule->next = rule_out;
+	  out->last_rule = rule_out;
+	  rule_in = rule_in->next;
+      }
+    return (rl2CoverageStylePtr) out;
+}
@@ -0,0 +1,757 @@
+/*
+
+ rl2tilecache -- process-wide cache of decoded tiles
+
+ version 0.1, 2026 October 17
+
+ -----------------------------------------------------------------------------
+
+ Version: MPL 1.1/GPL 2.0/LGPL 2.1
+
+ The contents of this file are subject to the Mozilla Public License Version
+ 1.1 (the "License"); you may not use this file except in compliance with
+ the License. You may obtain a copy of the License at
+ http://www.mozilla.org/MPL/
+
+Software distributed under the License is distributed on an "AS IS" basis,
+WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+for the specific language governing rights and limitations under the
+License.
+
+The Original Code is the RasterLite2 library
+
+The Initial Developer of the Original Code is Alessandro Furieri
+
+Portions created by the Initial Developer are Copyright (C) 2026
+the Initial Developer. All Rights Reserved.
+
+Alternatively, the contents of this file may be used under the terms of
+either the GNU General Public License Version 2 or later (the "GPL"), or
+the GNU Lesser General Public License Version 2.1 or later (the "LGPL"),
+in which case the provisions of the GPL or the LGPL are applicable instead
+of those above. If you wish to allow use of your version of this file only
+under the terms of either the GPL or the LGPL, and not to allow others to
+use your version of this file under the terms of the MPL, indicate your
+decision by deleting the provisions above and replace them with the notice
+and other provisions required by the GPL or the LGPL. If you do not delete
+the provisions above, a recipient may use your version of this file under
+the terms of any one of the MPL, the GPL or the LGPL.
+
+*/
+
+/*
+/ decoded tiles are shared by all connections of the same process; each
+/ tile is identified by the DB file path, the Coverage name, the
+/ Pyramid level, the tile_id and the requested scale.
+/ Tiles belonging to in-memory or temporary databases are never cached.
+/ The cache is disabled (zero bytes) by default; when enabled, the least
+/ recently used tiles are evicted as soon as the memory budget is exceeded.
+/
+/ DATA_VERSION and TOTAL_CHANGES can't be compared across connections, so
+/ each DB file carries a process-wide generation number: any connection
+/ noticing a change (committed by some other connection or process, or
+/ made by itself) evicts all Tiles of that file and bumps its generation.
+/ A connection using some DB file for the first time does the same, since
+/ the file could have been changed while nobody was watching it.
+/ Tiles decoded under an older generation are never stored.
+*/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <ctype.h>
+
+#if defined(_WIN32) && !defined(__MINGW32__)
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+#include "config.h"
+
+#ifdef LOADABLE_EXTENSION
+#include "rasterlite2/sqlite.h"
+#endif
+
+#include "rasterlite2/rasterlite2.h"
+#include "rasterlite2_private.h"
+
+#define RL2_TILE_CACHE_BUCKETS	4096
+
+#if defined(_WIN32) && !defined(__MINGW32__)
+typedef SRWLOCK rl2TileCacheMutex;
+#define RL2_TILE_CACHE_MUTEX_INIT	SRWLOCK_INIT
+#define tile_cache_lock(m)	AcquireSRWLockExclusive(m)
+#define tile_cache_unlock(m)	ReleaseSRWLockExclusive(m)
+#else
+typedef pthread_mutex_t rl2TileCacheMutex;
+#define RL2_TILE_CACHE_MUTEX_INIT	PTHREAD_MUTEX_INITIALIZER
+#define tile_cache_lock(m)	pthread_mutex_lock(m)
+#define tile_cache_unlock(m)	pthread_mutex_unlock(m)
+#endif
+
+typedef struct rl2_cached_tile
+{
+    char *db_path;
+    char *coverage;
+    int level;
+    sqlite3_int64 tile_id;
+    int scale;
+    rl2RasterPtr raster;
+    sqlite3_int64 size;
+    int refcount;
+    int detached;
+    unsigned int generation;
+    unsigned int hash;
+    struct rl2_cached_tile *hash_next;
+    struct rl2_cached_tile *prev;
+    struct rl2_cached_tile *next;
+} rl2CachedTile;
+typedef rl2CachedTile *rl2CachedTilePtr;
+
+typedef struct rl2_tile_cache_file
+{
+    char *db_path;
+    unsigned int generation;
+    struct rl2_tile_cache_file *next;
+} rl2TileCacheFile;
+typedef rl2TileCacheFile *rl2TileCacheFilePtr;
+
+struct rl2_tile_cache
+{
+    sqlite3_int64 max_size;
+    sqlite3_int64 curr_size;
+    sqlite3_int64 hits;
+    sqlite3_int64 misses;
+    rl2CachedTilePtr first;
+    rl2CachedTilePtr last;
+    rl2CachedTilePtr buckets[RL2_TILE_CACHE_BUCKETS];
+    rl2TileCacheFilePtr first_file;
+};
+
+static rl2TileCacheMutex tile_cache_mutex = RL2_TILE_CACHE_MUTEX_INIT;
+static struct rl2_tile_cache tile_cache;
+
+static unsigned int
+do_hash_tile (const char *db_path, const char *coverage, int level,
+	      sqlite3_int64 tile_id, int scale)
+{
+/* computing the hash key of some Tile (FNV-1a) */
+    unsigned int hash = 2166136261u;
+    const unsigned char *p;
+    sqlite3_int64 id = tile_id;
+    int i;
+    for (p = (const unsigned char *) db_path; *p != '\0'; p++)
+	hash = (hash ^ *p) * 16777619u;
+    for (p = (const unsigned char *) coverage; *p != '\0'; p++)
+	hash = (hash ^ *p) * 16777619u;
+    for (i = 0; i < 8; i++)
+      {
+	  hash = (hash ^ (unsigned char) (id & 0xff)) * 16777619u;
+	  id >>= 8;
+      }
+    hash = (hash ^ (unsigned char) level) * 16777619u;
+    hash = (hash ^ (unsigned char) scale) * 16777619u;
+    return hash;
+}
+
+static sqlite3_int64
+do_compute_tile_size (rl2RasterPtr raster)
+{
+/* estimating the memory footprint of a decoded Tile */
+    rl2PrivRasterPtr rst = (rl2PrivRasterPtr) raster;
+    sqlite3_int64 pixels = (sqlite3_int64) rst->width * rst->height;
+    sqlite3_int64 size = sizeof (rl2CachedTile) + sizeof (rl2PrivRaster);
+    int sample_sz = 1;
+    switch (rst->sampleType)
+      {
+      case RL2_SAMPLE_INT16:
+      case RL2_SAMPLE_UINT16:
+	  sample_sz = 2;
+	  break;
+      case RL2_SAMPLE_INT32:
+      case RL2_SAMPLE_UINT32:
+      case RL2_SAMPLE_FLOAT:
+	  sample_sz = 4;
+	  break;
+      case RL2_SAMPLE_DOUBLE:
+	  sample_sz = 8;
+	  break;
+      };
+    size += pixels * rst->nBands * sample_sz;
+    if (rst->maskBuffer != NULL)
+	size += pixels;
+    return size;
+}
+
+static void
+do_free_cached_tile (rl2CachedTilePtr entry)
+{
+/* memory cleanup - destroying a cached Tile */
+    if (entry->db_path != NULL)
+	free (entry->db_path);
+    if (entry->coverage != NULL)
+	free (entry->coverage);
+    if (entry->raster != NULL)
+	rl2_destroy_raster (entry->raster);
+    free (entry);
+}
+
+static void
+do_detach_cached_tile (rl2CachedTilePtr entry)
+{
+/* removing a Tile from the cache - mutex already held */
+    rl2CachedTilePtr *pp =
+	tile_cache.buckets + (entry->hash % RL2_TILE_CACHE_BUCKETS);
+    while (*pp != NULL)
+      {
+	  if (*pp == entry)
+	    {
+		*pp = entry->hash_next;
+		break;
+	    }
+	  pp = &((*pp)->hash_next);
+      }
+    if (entry->prev != NULL)
+	entry->prev->next = entry->next;
+    else
+	tile_cache.first = entry->next;
+    if (entry->next != NULL)
+	entry->next->prev = entry->prev;
+    else
+	tile_cache.last = entry->prev;
+    tile_cache.curr_size -= entry->size;
+    entry->hash_next = NULL;
+    entry->prev = NULL;
+    entry->next = NULL;
+    if (entry->refcount > 0)
+      {
+	  /* still in use: will be destroyed when finally released */
+	  entry->detached = 1;
+	  return;
+      }
+    do_free_cached_tile (entry);
+}
+
+static void
+do_evict_cached_tiles (void)
+{
+/* evicting the least recently used Tiles - mutex already held */
+    while (tile_cache.curr_size > tile_cache.max_size
+	   && tile_cache.last != NULL)
+	do_detach_cached_tile (tile_cache.last);
+}
+
+static void
+do_touch_cached_tile (rl2CachedTilePtr entry)
+{
+/* moving a Tile on top of the LRU list - mutex already held */
+    if (tile_cache.first == entry)
+	return;
+    entry->prev->next = entry->next;
+    if (entry->next != NULL)
+	entry->next->prev = entry->prev;
+    else
+	tile_cache.last = entry->prev;
+    entry->prev = NULL;
+    entry->next = tile_cache.first;
+    tile_cache.first->prev = entry;
+    tile_cache.first = entry;
+}
+
+static rl2CachedTilePtr
+do_find_cached_tile (unsigned int hash, const char *db_path,
+		     const char *coverage, int level, sqlite3_int64 tile_id,
+		     int scale)
+{
+/* searching a Tile into the hash table - mutex already held */
+    rl2CachedTilePtr entry =
+	*(tile_cache.buckets + (hash % RL2_TILE_CACHE_BUCKETS));
+    while (entry != NULL)
+      {
+	  if (entry->hash == hash && entry->tile_id == tile_id
+	      && entry->level == level && entry->scale == scale
+	      && strcmp (entry->coverage, coverage) == 0
+	      && strcmp (entry->db_path, db_path) == 0)
+	      return entry;
+	  entry = entry->hash_next;
+      }
+    return NULL;
+}
+
+static char *
+do_get_db_path (sqlite3 * handle, const char *db_prefix)
+{
+/* returns the path of some DB file, or NULL if the DB isn't file based */
+    const char *path;
+    char *db_path;
+    int len;
+    if (db_prefix == NULL)
+	db_prefix = "main";
+    path = sqlite3_db_filename (handle, db_prefix);
+    if (path == NULL)
+	return NULL;
+    if (*path == '\0')
+	return NULL;
+    len = strlen (path);
+    db_path = malloc (len + 1);
+    if (db_path == NULL)
+	return NULL;
+    strcpy (db_path, path);
+    return db_path;
+}
+
+static int
+do_query_data_version (sqlite3 * handle, const char *db_prefix,
+		       unsigned int *version)
+{
+/* 
+/ retrieving the current DATA_VERSION of some attached DB
+/ the PRAGMA starts a read transaction, so its value is always current
+*/
+    int ret;
+    char *sql;
+    char *xdb_prefix;
+    int ok = 0;
+    sqlite3_stmt *stmt = NULL;
+
+    if (db_prefix == NULL)
+	db_prefix = "main";
+    xdb_prefix = rl2_double_quoted_sql (db_prefix);
+    sql = sqlite3_mprintf ("PRAGMA \"%s\".data_version", xdb_prefix);
+    free (xdb_prefix);
+    ret = sqlite3_prepare_v2 (handle, sql, strlen (sql), &stmt, NULL);
+    sqlite3_free (sql);
+    if (ret != SQLITE_OK)
+	return 0;
+    while (1)
+      {
+	  ret = sqlite3_step (stmt);
+	  if (ret == SQLITE_DONE)
+	      break;
+	  if (ret == SQLITE_ROW)
+	    {
+		*version = (unsigned int) sqlite3_column_int64 (stmt, 0);
+		ok = 1;
+	    }
+	  else
+	      break;
+      }
+    sqlite3_finalize (stmt);
+    return ok;
+}
+
+static int
+do_check_cache_stamp (sqlite3 * handle, struct rl2_private_data *priv_data,
+		      const char *db_prefix, const char *db_path)
+{
+/* 
+/ checking if the DB file has changed since this connection last used it
+/ returns 1 if the cached Tiles of this file can't be trusted anymore
+*/
+    struct rl2_tile_cache_stamp *stamp;
+    unsigned int version;
+    int changes;
+    int len;
+    int ok_prefix;
+    if (!do_query_data_version (handle, db_prefix, &version))
+	return -1;
+    changes = sqlite3_total_changes (handle);
+    stamp = priv_data->first_cache_stamp;
+    while (stamp != NULL)
+      {
+	  if (stamp->db_prefix == NULL && db_prefix == NULL)
+	      ok_prefix = 1;
+	  else if (stamp->db_prefix != NULL && db_prefix != NULL)
+	      ok_prefix = (strcasecmp (stamp->db_prefix, db_prefix) == 0);
+	  else
+	      ok_prefix = 0;
+	  if (ok_prefix && strcmp (stamp->db_path, db_path) == 0)
+	    {
+		if (stamp->data_version == version
+		    && stamp->total_changes == changes)
+		    return 0;
+		/* changed by some other connection or by this one */
+		stamp->data_version = version;
+		stamp->total_changes = changes;
+		return 1;
+	    }
+	  stamp = stamp->next;
+      }
+
+/* first time this connection uses this DB file */
+    stamp = malloc (sizeof (struct rl2_tile_cache_stamp));
+    if (stamp == NULL)
+	return -1;
+    stamp->db_prefix = NULL;
+    if (db_prefix != NULL)
+      {
+	  len = strlen (db_prefix);
+	  stamp->db_prefix = malloc (len + 1);
+	  if (stamp->db_prefix == NULL)
+	    {
+		free (stamp);
+		return -1;
+	    }
+	  strcpy (stamp->db_prefix, db_prefix);
+      }
+    len = strlen (db_path);
+    stamp->db_path = malloc (len + 1);
+    if (stamp->db_path == NULL)
+      {
+	  if (stamp->db_prefix != NULL)
+	      free (stamp->db_prefix);
+	  free (stamp);
+	  return -1;
+      }
+    strcpy (stamp->db_path, db_path);
+    stamp->data_version = version;
+    stamp->total_changes = changes;
+    stamp->next = priv_data->first_cache_stamp;
+    priv_data->first_cache_stamp = stamp;
+    return 1;
+}
+
+static rl2TileCacheFilePtr
+do_find_cache_file (const char *db_path)
+{
+/* retrieving the generation of some DB file (creating if needed) - mutex already held */
+    int len;
+    rl2TileCacheFilePtr file = tile_cache.first_file;
+    while (file != NULL)
+      {
+	  if (strcmp (file->db_path, db_path) == 0)
+	      return file;
+	  file = file->next;
+      }
+    file = malloc (sizeof (rl2TileCacheFile));
+    if (file == NULL)
+	return NULL;
+    len = strlen (db_path);
+    file->db_path = malloc (len + 1);
+    if (file->db_path == NULL)
+      {
+	  free (file);
+	  return NULL;
+      }
+    strcpy (file->db_path, db_path);
+    file->generation = 0;
+    file->next = tile_cache.first_file;
+    tile_cache.first_file = file;
+    return file;
+}
+
+static void
+do_detach_matching_tiles (const char *db_path, const char *coverage)
+{
+/* 
+/ removing all Tiles of some DB file (or of just one Coverage)
+/ mutex already held
+*/
+    rl2CachedTilePtr entry = tile_cache.first;
+    rl2CachedTilePtr entry_n;
+    while (entry != NULL)
+      {
+	  entry_n = entry->next;
+	  if (strcmp (entry->db_path, db_path) == 0
+	      && (coverage == NULL || strcmp (entry->coverage, coverage) == 0))
+	      do_detach_cached_tile (entry);
+	  entry = entry_n;
+      }
+}
+
+static char *
+do_lower_coverage (const char *coverage)
+{
+/* Coverage names are case insensitive: the cache always uses lowercase */
+    int len = strlen (coverage);
+    char *lower = malloc (len + 1);
+    char *p;
+    if (lower == NULL)
+	return NULL;
+    strcpy (lower, coverage);
+    for (p = lower; *p != '\0'; p++)
+	*p = tolower ((unsigned char) *p);
+    return lower;
+}
+
+RL2_PRIVATE rl2TileCacheKeyPtr
+rl2_get_tile_cache_key (sqlite3 * handle, const void *data,
+			const char *db_prefix, const char *coverage)
+{
+/* 
+/ returns the cache key for the Tiles of some Coverage about to be read,
+/ or NULL if the Tile Cache is disabled or the DB isn't file based
+/ any Tile cached before the DB file was last changed is evicted
+*/
+    struct rl2_private_data *priv_data = (struct rl2_private_data *) data;
+    rl2TileCacheKeyPtr key;
+    rl2TileCacheFilePtr file;
+    sqlite3_int64 max_size;
+    char *db_path;
+    int changed;
+    if (priv_data == NULL || coverage == NULL)
+	return NULL;
+    tile_cache_lock (&tile_cache_mutex);
+    max_size = tile_cache.max_size;
+    tile_cache_unlock (&tile_cache_mutex);
+    if (max_size <= 0)
+	return NULL;
+    db_path = do_get_db_path (handle, db_prefix);
+    if (db_path == NULL)
+	return NULL;
+    changed = do_check_cache_stamp (handle, priv_data, db_prefix, db_path);
+    if (changed < 0)
+      {
+	  free (db_path);
+	  return NULL;
+      }
+
+    key = malloc (sizeof (rl2TileCacheKey));
+    if (key == NULL)
+      {
+	  free (db_path);
+	  return NULL;
+      }
+    key->db_path = db_path;
+    key->coverage = do_lower_coverage (coverage);
+    if (key->coverage == NULL)
+      {
+	  rl2_destroy_tile_cache_key (key);
+	  return NULL;
+      }
+    /* uncommitted data must never be shared with other connections */
+    key->can_store = sqlite3_get_autocommit (handle);
+
+    tile_cache_lock (&tile_cache_mutex);
+    file = do_find_cache_file (db_path);
+    if (file == NULL)
+      {
+	  tile_cache_unlock (&tile_cache_mutex);
+	  rl2_destroy_tile_cache_key (key);
+	  return NULL;
+      }
+    if (changed)
+      {
+	  do_detach_matching_tiles (db_path, NULL);
+	  file->generation += 1;
+      }
+    key->generation = file->generation;
+    tile_cache_unlock (&tile_cache_mutex);
+    return key;
+}
+
+RL2_PRIVATE void
+rl2_destroy_tile_cache_key (rl2TileCacheKeyPtr key)
+{
+/* memory cleanup - destroying a Tile Cache key */
+    if (key == NULL)
+	return;
+    if (key->db_path != NULL)
+	free (key->db_path);
+    if (key->coverage != NULL)
+	free (key->coverage);
+    free (key);
+}
+
+RL2_PRIVATE void *
+rl2_lookup_cached_tile (rl2TileCacheKeyPtr key, int level,
+			sqlite3_int64 tile_id, int scale, rl2RasterPtr * raster)
+{
+/* 
+/ searching a decoded Tile into the cache
+/ on success the Tile is pinned until rl2_release_cached_tile() is called
+*/
+    rl2CachedTilePtr entry;
+    unsigned int hash;
+    *raster = NULL;
+    if (key == NULL)
+	return NULL;
+    hash = do_hash_tile (key->db_path, key->coverage, level, tile_id, scale);
+    tile_cache_lock (&tile_cache_mutex);
+    entry = do_find_cached_tile (hash, key->db_path, key->coverage, level,
+				 tile_id, scale);
+    if (entry == NULL)
+      {
+	  tile_cache.misses += 1;
+	  tile_cache_unlock (&tile_cache_mutex);
+	  return NULL;
+      }
+    tile_cache.hits += 1;
+    entry->refcount += 1;
+    do_touch_cached_tile (entry);
+    *raster = entry->raster;
+    tile_cache_unlock (&tile_cache_mutex);
+    return entry;
+}
+
+RL2_PRIVATE void *
+rl2_store_cached_tile (rl2TileCacheKeyPtr key, int level,
+		       sqlite3_int64 tile_id, int scale, rl2RasterPtr raster)
+{
+/* 
+/ attempting to insert a freshly decoded Tile into the cache
+/ on success the cache takes ownership of the Raster, and the Tile 
+/ is pinned until rl2_release_cached_tile() is called
+/ returns NULL if the Tile can't be cached
+*/
+    rl2CachedTilePtr entry;
+    rl2CachedTilePtr *bucket;
+    rl2TileCacheFilePtr file;
+    unsigned int hash;
+    sqlite3_int64 size;
+    int len;
+    if (key == NULL || raster == NULL)
+	return NULL;
+    if (!key->can_store)
+	return NULL;
+    size = do_compute_tile_size (raster);
+    hash = do_hash_tile (key->db_path, key->coverage, level, tile_id, scale);
+    entry = malloc (sizeof (rl2CachedTile));
+    if (entry == NULL)
+	return NULL;
+    len = strlen (key->db_path);
+    entry->db_path = malloc (len + 1);
+    if (entry->db_path != NULL)
+	strcpy (entry->db_path, key->db_path);
+    len = strlen (key->coverage);
+    entry->coverage = malloc (len + 1);
+    if (entry->coverage != NULL)
+	strcpy (entry->coverage, key->coverage);
+    entry->level = level;
+    entry->tile_id = tile_id;
+    entry->scale = scale;
+    entry->raster = NULL;
+    entry->size = size;
+    entry->refcount = 1;
+    entry->detached = 0;
+    entry->generation = key->generation;
+    entry->hash = hash;
+    entry->hash_next = NULL;
+    entry->prev = NULL;
+    entry->next = NULL;
+    if (entry->db_path == NULL || entry->coverage == NULL)
+	goto error;
+
+    tile_cache_lock (&tile_cache_mutex);
+    if (size > tile_cache.max_size)
+      {
+	  /* too big, or the cache has been disabled in the meanwhile */
+	  tile_cache_unlock (&tile_cache_mutex);
+	  goto error;
+      }
+    file = do_find_cache_file (key->db_path);
+    if (file == NULL || file->generation != key->generation)
+      {
+	  /* the DB file has changed while the Tile was being decoded */
+	  tile_cache_unlock (&tile_cache_mutex);
+	  goto error;
+      }
+    if (do_find_cached_tile
+	(hash, key->db_path, key->coverage, level, tile_id, scale) != NULL)
+      {
+	  /* already cached by some concurrent request */
+	  tile_cache_unlock (&tile_cache_mutex);
+	  goto error;
+      }
+    entry->raster = raster;
+    bucket = tile_cache.buckets + (hash % RL2_TILE_CACHE_BUCKETS);
+    entry->hash_next = *bucket;
+    *bucket = entry;
+    entry->next = tile_cache.first;
+    if (tile_cache.first != NULL)
+	tile_cache.first->prev = entry;
+    tile_cache.first = entry;
+    if (tile_cache.last == NULL)
+	tile_cache.last = entry;
+    tile_cache.curr_size += size;
+    do_evict_cached_tiles ();
+    tile_cache_unlock (&tile_cache_mutex);
+    return entry;
+
+  error:
+    do_free_cached_tile (entry);
+    return NULL;
+}
+
+RL2_PRIVATE void
+rl2_release_cached_tile (void *tile)
+{
+/* unpinning a cached Tile */
+    rl2CachedTilePtr entry = (rl2CachedTilePtr) tile;
+    if (entry == NULL)
+	return;
+    tile_cache_lock (&tile_cache_mutex);
+    entry->refcount -= 1;
+    if (entry->refcount <= 0 && entry->detached)
+	do_free_cached_tile (entry);
+    tile_cache_unlock (&tile_cache_mutex);
+}
+
+RL2_PRIVATE void
+rl2_invalidate_tile_cache (sqlite3 * handle, const char *db_prefix,
+			   const char *coverage)
+{
+/* 
+/ removing from the cache all Tiles belonging to some Coverage
+/ bumping the generation prevents any concurrent decoder from storing
+/ an outdated Tile
+*/
+    rl2TileCacheFilePtr file;
+    char *db_path;
+    char *lower;
+    if (coverage == NULL)
+	return;
+    db_path = do_get_db_path (handle, db_prefix);
+    if (db_path == NULL)
+	return;
+    lower = do_lower_coverage (coverage);
+    tile_cache_lock (&tile_cache_mutex);
+    file = do_find_cache_file (db_path);
+    if (file != NULL)
+	file->generation += 1;
+    if (lower != NULL)
+	do_detach_matching_tiles (db_path, lower);
+    else
+	do_detach_matching_tiles (db_path, NULL);
+    tile_cache_unlock (&tile_cache_mutex);
+    if (lower != NULL)
+	free (lower);
+    free (db_path);
+}
+
+RL2_PRIVATE void
+rl2_flush_tile_cache (void)
+{
+/* removing all Tiles from the cache */
+    tile_cache_lock (&tile_cache_mutex);
+    while (tile_cache.first != NULL)
+	do_detach_cached_tile (tile_cache.first);
+    tile_cache_unlock (&tile_cache_mutex);
+}
+
+RL2_PRIVATE sqlite3_int64
+rl2_set_tile_cache_size (sqlite3_int64 max_size)
+{
+/* setting the memory budget (in bytes) of the Tile Cache - 0 disables */
+    if (max_size < 0)
+	max_size = 0;
+    tile_cache_lock (&tile_cache_mutex);
+    tile_cache.max_size = max_size;
+    do_evict_cached_tiles ();
+    tile_cache_unlock (&tile_cache_mutex);
+    return max_size;
+}
+
+RL2_PRIVATE void
+rl2_get_tile_cache_stats (sqlite3_int64 * max_size, sqlite3_int64 * curr_size,
+			  sqlite3_int64 * hits, sqlite3_int64 * misses)
+{
+/* retrieving the current Tile Cache statistics */
+    tile_cache_lock (&tile_cache_mutex);
+    *max_size = tile_cache.max_size;
+    *curr_size = tile_cache.curr_size;
+    *hits = tile_cache.hits;
+    *misses = tile_cache.misses;
+    tile_cache_unlock (&tile_cache_mutex);
+}
@@ -0,0 +1,492 @@
+/*
+
+ rl2workers -- persistent pool of worker threads
+
+ version 0.1, 2026 October 17
+
+ -----------------------------------------------------------------------------
+
+ Version: MPL 1.1/GPL 2.0/LGPL 2.1
+
+ The contents of this file are subject to the Mozilla Public License Version
+ 1.1 (the "License"); you may not use this file except in compliance with
+ the License. You may obtain a copy of the License at
+ http://www.mozilla.org/MPL/
+
+Software distributed under the License is distributed on an "AS IS" basis,
+WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+for the specific language governing rights and limitations under the
+License.
+
+The Original Code is the RasterLite2 library
+
+The Initial Developer of the Original Code is Alessandro Furieri
+
+Portions created by the Initial Developer are Copyright (C) 2026
+the Initial Developer. All Rights Reserved.
+
+Alternatively, the contents of this file may be used under the terms of
+either the GNU General Public License Version 2 or later (the "GPL"), or
+the GNU Lesser General Public License Version 2.1 or later (the "LGPL"),
+in which case the provisions of the GPL or the LGPL are applicable instead
+of those above. If you wish to allow use of your version of this file only
+under the terms of either the GPL or the LGPL, and not to allow others to
+use your version of this file under the terms of the MPL, indicate your
+decision by deleting the provisions above and replace them with the notice
+and other provisions required by the GPL or the LGPL. If you do not delete
+the provisions above, a recipient may use your version of this file under
+the terms of any one of the MPL, the GPL or the LGPL.
+
+*/
+
+/*
+/ all RasterLite2 concurrent tasks (tile decoders and encoders, shaded
+/ relief and affine transforms) are executed by a single process-wide
+/ pool of persistent worker threads; each caller submits its own jobs
+/ into a Batch and then waits only for the jobs belonging to the same
+/ Batch.
+/ worker threads are lazily started on demand, the pool size is never
+/ allowed to exceed 64 threads, and all threads are stopped as soon as
+/ the last private connection data block is destroyed.
+*/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#if defined(_WIN32) && !defined(__MINGW32__)
+#include <windows.h>
+#include <process.h>
+#else
+#include <unistd.h>
+#include <pthread.h>
+#endif
+
+#ifdef LOADABLE_EXTENSION
+#include "rasterlite2/sqlite.h"
+#endif
+
+#include "rasterlite2/rasterlite2.h"
+#include "rasterlite2_private.h"
+
+#define RL2_MAX_WORKERS		64
+
+#if defined(_WIN32) && !defined(__MINGW32__)
+typedef SRWLOCK rl2WorkersMutex;
+typedef CONDITION_VARIABLE rl2WorkersCond;
+#define RL2_WORKERS_MUTEX_INIT	SRWLOCK_INIT
+#define RL2_WORKERS_COND_INIT	CONDITION_VARIABLE_INIT
+#define workers_lock(m)		AcquireSRWLockExclusive(m)
+#define workers_unlock(m)	ReleaseSRWLockExclusive(m)
+#define workers_wait(c,m)	SleepConditionVariableSRW(c, m, INFINITE, 0)
+#define workers_signal(c)	WakeConditionVariable(c)
+#define workers_broadcast(c)	WakeAllConditionVariable(c)
+#else
+typedef pthread_mutex_t rl2WorkersMutex;
+typedef pthread_cond_t rl2WorkersCond;
+#define RL2_WORKERS_MUTEX_INIT	PTHREAD_MUTEX_INITIALIZER
+#define RL2_WORKERS_COND_INIT	PTHREAD_COND_INITIALIZER
+#define workers_lock(m)		pthread_mutex_lock(m)
+#define workers_unlock(m)	pthread_mutex_unlock(m)
+#define workers_wait(c,m)	pthread_cond_wait(c, m)
+#define workers_signal(c)	pthread_cond_signal(c)
+#define workers_broadcast(c)	pthread_cond_broadcast(c)
+#endif
+
+typedef struct rl2_worker_job
+{
+    void (*run) (void *arg);
+    void *arg;
+    struct rl2_worker_batch *batch;
+    struct rl2_worker_job *next;
+} rl2WorkerJob;
+typedef rl2WorkerJob *rl2WorkerJobPtr;
+
+struct rl2_worker_batch
+{
+    int pending;
+    rl2WorkerJobPtr first_done;
+    rl2WorkerJobPtr last_done;
+};
+
+struct rl2_workers_pool
+{
+    int users;
+    int num_threads;
+    int stopping;
+#if defined(_WIN32) && !defined(__MINGW32__)
+    HANDLE threads[RL2_MAX_WORKERS];
+#else
+    pthread_t threads[RL2_MAX_WORKERS];
+#endif
+    rl2WorkerJobPtr first;
+    rl2WorkerJobPtr last;
+};
+
+static rl2WorkersMutex workers_mutex = RL2_WORKERS_MUTEX_INIT;
+static rl2WorkersCond job_ready = RL2_WORKERS_COND_INIT;
+static rl2WorkersCond job_done = RL2_WORKERS_COND_INIT;
+static struct rl2_workers_pool workers_pool;
+
+static rl2WorkerJobPtr
+do_dequeue_job (void)
+{
+/* extracting the next Job from the queue - mutex already held */
+    rl2WorkerJobPtr job = workers_pool.first;
+    if (job == NULL)
+	return NULL;
+    workers_pool.first = job->next;
+    if (workers_pool.first == NULL)
+	workers_pool.last = NULL;
+    return job;
+}
+
+static rl2WorkerJobPtr
+do_dequeue_batch_job (rl2WorkerBatchPtr batch)
+{
+/* extracting the next queued Job belonging to some Batch - mutex already held */
+    rl2WorkerJobPtr prev = NULL;
+    rl2WorkerJobPtr job = workers_pool.first;
+    while (job != NULL)
+      {
+	  if (job->batch == batch)
+	    {
+		if (prev == NULL)
+		    workers_pool.first = job->next;
+		else
+		    prev->next = job->next;
+		if (workers_pool.last == job)
+		    workers_pool.last = prev;
+		return job;
+	    }
+	  prev = job;
+	  job = job->next;
+      }
+    return NULL;
+}
+
+static void
+do_mark_job_done (rl2WorkerJobPtr job)
+{
+/* appending a completed Job to its Batch - mutex already held */
+    rl2WorkerBatchPtr batch = job->batch;
+    job->next = NULL;
+    if (batch->first_done == NULL)
+	batch->first_done = job;
+    if (batch->last_done != NULL)
+	batch->last_done->next = job;
+    batch->last_done = job;
+}
+
+static void
+do_free_done_jobs (rl2WorkerBatchPtr batch)
+{
+/* freeing all completed Jobs of a Batch - mutex already held */
+    rl2WorkerJobPtr job;
+    rl2WorkerJobPtr job_n;
+    job = batch->first_done;
+    while (job != NULL)
+      {
+	  job_n = job->next;
+	  free (job);
+	  job = job_n;
+      }
+    batch->first_done = NULL;
+    batch->last_done = NULL;
+}
+
+static void
+do_execute_job (rl2WorkerJobPtr job)
+{
+/* executing a Job - called with the mutex held, returns with the mutex held */
+    workers_unlock (&workers_mutex);
+    job->run (job->arg);
+    workers_lock (&workers_mutex);
+    job->batch->pending -= 1;
+    do_mark_job_done (job);
+    workers_broadcast (&job_done);
+}
+
+static void
+do_run_worker_loop (void)
+{
+/* the main loop of each worker thread */
+    rl2WorkerJobPtr job;
+    workers_lock (&workers_mutex);
+    while (1)
+      {
+	  while (workers_pool.first == NULL && !workers_pool.stopping)
+	      workers_wait (&job_ready, &workers_mutex);
+	  job = do_dequeue_job ();
+	  if (job == NULL)
+	      break;		/* the pool is shutting down */
+	  do_execute_job (job);
+      }
+    workers_unlock (&workers_mutex);
+}
+
+#if defined(_WIN32) && !defined(__MINGW32__)
+DWORD WINAPI
+doRunWorkerThread (void *arg)
+#else
+void *
+doRunWorkerThread (void *arg)
+#endif
+{
+/* threaded function: servicing the Jobs queue */
+    do_run_worker_loop ();
+#if defined(_WIN32) && !defined(__MINGW32__)
+    return 0;
+#else
+    pthread_exit (NULL);
+#endif
+}
+
+static int
+start_worker_thread (void)
+{
+/* starting a further worker thread - mutex already held */
+    int idx = workers_pool.num_threads;
+#if defined(_WIN32) && !defined(__MINGW32__)
+    HANDLE thread_handle;
+    DWORD dwThreadId;
+    thread_handle =
+	CreateThread (NULL, 0, doRunWorkerThread, NULL, 0, &dwThreadId);
+    if (thread_handle == NULL)
+	return 0;
+    SetThreadPriority (thread_handle, THREAD_PRIORITY_IDLE);
+    workers_pool.threads[idx] = thread_handle;
+#else
+    pthread_t thread_id;
+    int ok_prior = 0;
+    int ret = -1;
+    int policy;
+    int min_prio;
+    pthread_attr_t attr;
+    struct sched_param sp;
+    pthread_attr_init (&attr);
+    if (pthread_attr_setschedpolicy (&attr, SCHED_RR) == 0)
+      {
+	  /* attempting to set the lowest priority */
+	  if (pthread_attr_getschedpolicy (&attr, &policy) == 0)
+	    {
+		min_prio = sched_get_priority_min (policy);
+		sp.sched_priority = min_prio;
+		if (pthread_attr_setschedparam (&attr, &sp) == 0)
+		  {
+		      /* ok, setting the lowest priority */
+		      ok_prior = 1;
+		      ret =
+			  pthread_create (&thread_id, &attr,
+					  doRunWorkerThread, NULL);
+		  }
+	    }
+      }
+    if (!ok_prior || ret != 0)
+      {
+	  /* failure: using standard priority */
+	  ret = pthread_create (&thread_id, NULL, doRunWorkerThread, NULL);
+      }
+    pthread_attr_destroy (&attr);
+    if (ret != 0)
+	return 0;
+    workers_pool.threads[idx] = thread_id;
+#endif
+    workers_pool.num_threads += 1;
+    return 1;
+}
+
+RL2_PRIVATE int
+rl2_set_worker_threads (int count)
+{
+/* growing the pool up to the required number of worker threads */
+    if (count < 1)
+	count = 1;
+    if (count > RL2_MAX_WORKERS)
+	count = RL2_MAX_WORKERS;
+    workers_lock (&workers_mutex);
+    while (workers_pool.num_threads < count && !workers_pool.stopping)
+      {
+	  if (!start_worker_thread ())
+	      break;
+      }
+    count = workers_pool.num_threads;
+    workers_unlock (&workers_mutex);
+    return count;
+}
+
+RL2_PRIVATE void
+rl2_retain_worker_threads (void)
+{
+/* registering a further user (private connection data) of the pool */
+    workers_lock (&workers_mutex);
+    workers_pool.users += 1;
+    workers_unlock (&workers_mutex);
+}
+
+RL2_PRIVATE void
+rl2_release_worker_threads (void)
+{
+/* unregistering a user of the pool; the last one stops all threads */
+    int i;
+    int count;
+    workers_lock (&workers_mutex);
+    if (workers_pool.users > 0)
+	workers_pool.users -= 1;
+    if (workers_pool.users > 0 || workers_pool.num_threads == 0)
+      {
+	  workers_unlock (&workers_mutex);
+	  return;
+      }
+    workers_pool.stopping = 1;
+    count = workers_pool.num_threads;
+    workers_broadcast (&job_ready);
+    workers_unlock (&workers_mutex);
+
+/* waiting until all worker threads exit */
+#if defined(_WIN32) && !defined(__MINGW32__)
+    WaitForMultipleObjects (count, workers_pool.threads, TRUE, INFINITE);
+    for (i = 0; i < count; i++)
+	CloseHandle (workers_pool.threads[i]);
+#else
+    for (i = 0; i < count; i++)
+	pthread_join (workers_pool.threads[i], NULL);
+#endif
+
+    workers_lock (&workers_mutex);
+    workers_pool.num_threads = 0;
+    workers_pool.stopping = 0;
+    workers_unlock (&workers_mutex);
+}
+
+RL2_PRIVATE rl2WorkerBatchPtr
+rl2_create_worker_batch (int max_threads)
+{
+/* creating a new (empty) Batch of Jobs */
+    rl2WorkerBatchPtr batch;
+    if (max_threads > 1)
+	rl2_set_worker_threads (max_threads);
+    batch = malloc (sizeof (struct rl2_worker_batch));
+    if (batch == NULL)
+	return NULL;
+    batch->pending = 0;
+    batch->first_done = NULL;
+    batch->last_done = NULL;
+    return batch;
+}
+
+RL2_PRIVATE void
+rl2_submit_worker_job (rl2WorkerBatchPtr batch, void (*run) (void *arg),
+		       void *arg)
+{
+/* queuing a Job for asynchronous execution */
+    rl2WorkerJobPtr job;
+    if (batch == NULL)
+	goto inline_run;
+    job = malloc (sizeof (rl2WorkerJob));
+    if (job == NULL)
+	goto inline_run;
+    job->run = run;
+    job->arg = arg;
+    job->batch = batch;
+    job->next = NULL;
+
+    workers_lock (&workers_mutex);
+    if (workers_pool.num_threads == 0 || workers_pool.stopping)
+      {
+	  /* no worker thread is available: executing the Job right now */
+	  workers_unlock (&workers_mutex);
+	  run (arg);
+	  workers_lock (&workers_mutex);
+	  do_mark_job_done (job);
+	  workers_unlock (&workers_mutex);
+	  return;
+      }
+    batch->pending += 1;
+    if (workers_pool.first == NULL)
+	workers_pool.first = job;
+    if (workers_pool.last != NULL)
+	workers_pool.last->next = job;
+    workers_pool.last = job;
+    workers_signal (&job_ready);
+    workers_unlock (&workers_mutex);
+    return;
+
+  inline_run:
+/* fallback: executing the Job in the calling thread */
+    run (arg);
+}
+
+RL2_PRIVATE void
+rl2_wait_worker_batch (rl2WorkerBatchPtr batch)
+{
+/* 
+/ waiting until all Jobs belonging to this Batch have been completed
+/
+/ the waiting thread will help by executing the queued Jobs of this
+/ same Batch in the meanwhile, so that a Job is even allowed to wait for
+/ its own sub-Jobs without any risk of deadlocking the pool; Jobs
+/ belonging to other Batches (i.e. to other callers) are never executed,
+/ so that a short request never gets stuck behind a long one
+*/
+    rl2WorkerJobPtr job;
+    if (batch == NULL)
+	return;
+    workers_lock (&workers_mutex);
+    while (batch->pending > 0)
+      {
+	  job = do_dequeue_batch_job (batch);
+	  if (job != NULL)
+	      do_execute_job (job);
+	  else
+	      workers_wait (&job_done, &workers_mutex);
+      }
+    do_free_done_jobs (batch);
+    workers_unlock (&workers_mutex);
+}
+
+RL2_PRIVATE void *
+rl2_next_completed_worker_job (rl2WorkerBatchPtr batch)
+{
+/* 
+/ waiting until any Job belonging to this Batch has been completed
+/
+/ returns the argument of the completed Job (each Job is reported 
+/ only once), or NULL when no further Job is still pending
+/ just like rl2_wait_worker_batch() only Jobs of this Batch are helped
+*/
+    rl2WorkerJobPtr job;
+    void *arg = NULL;
+    if (batch == NULL)
+	return NULL;
+    workers_lock (&workers_mutex);
+    while (batch->first_done == NULL && batch->pending > 0)
+      {
+	  job = do_dequeue_batch_job (batch);
+	  if (job != NULL)
+	      do_execute_job (job);
+	  else
+	      workers_wait (&job_done, &workers_mutex);
+      }
+    job = batch->first_done;
+    if (job != NULL)
+      {
+	  batch->first_done = job->next;
+	  if (batch->first_done == NULL)
+	      batch->last_done = NULL;
+	  arg = job->arg;
+	  free (job);
+      }
+    workers_unlock (&workers_mutex);
+    return arg;
+}
+
+RL2_PRIVATE void
+rl2_destroy_worker_batch (rl2WorkerBatchPtr batch)
+{
+/* memory cleanup - destroying a Batch (after waiting for its Jobs) */
+    if (batch == NULL)
+	return;
+    rl2_wait_worker_batch (batch);
+    free (batch);
+}
@@ -0,0 +1,290 @@
+/*
+
+ test_checksum.c -- RasterLite-2 Test Case
+
+ Author: Sandro Furieri <a.furieri@lqt.it>
+
+ ------------------------------------------------------------------------------
+ 
+ Version: MPL 1.1/GPL 2.0/LGPL 2.1
+ 
+ The contents of this file are subject to the Mozilla Public License Version
+ 1.1 (the "License"); you may not use this file except in compliance with
+ the License. You may obtain a copy of the License at
+ http://www.mozilla.org/MPL/
+ 
+Software distributed under the License is distributed on an "AS IS" basis,
+WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+for the specific language governing rights and limitations under the
+License.
+
+The Original Code is the RasterLite2 library
+
+The Initial Developer of the Original Code is Alessandro Furieri
+ 
+Portions created by the Initial Developer are Copyright (C) 2013
+the Initial Developer. All Rights Reserved.
+
+Contributor(s):
+
+Alternatively, the contents of this file may be used under the terms of
+either the GNU General Public License Version 2 or later (the "GPL"), or
+the GNU Lesser General Public License Version 2.1 or later (the "LGPL"),
+in which case the provisions of the GPL or the LGPL are applicable instead
+of those above. If you wish to allow use of your version of this file only
+under the terms of either the GPL or the LGPL, and not to allow others to
+use your version of this file under the terms of the MPL, indicate your
+decision by deleting the provisions above and replace them with the notice
+and other provisions required by the GPL or the LGPL. If you do not delete
+the provisions above, a recipient may use your version of this file under
+the terms of any one of the MPL, the GPL or the LGPL.
+ 
+*/
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "rasterlite2/rasterlite2.h"
+
+#define TILE_SIZE	256
+
+static unsigned int
+legacy_crc32 (const unsigned char *p, int size)
+{
+/* the zlib CRC32 used by the legacy tile format */
+    unsigned int crc = 0xffffffff;
+    int j;
+    while (size-- > 0)
+      {
+	  crc ^= *p++;
+	  for (j = 0; j < 8; j++)
+	      crc = (crc & 1) ? (crc >> 1) ^ 0xedb88320 : crc >> 1;
+      }
+    return crc ^ 0xffffffff;
+}
+
+static unsigned int
+get_u32_le (const unsigned char *p)
+{
+/* importing a little-endian 32 bit value */
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((unsigned int) p[3] << 24);
+}
+
+static void
+put_u32_le (unsigned char *p, unsigned int value)
+{
+/* exporting a little-endian 32 bit value */
+    p[0] = value & 0xff;
+    p[1] = (value >> 8) & 0xff;
+    p[2] = (value >> 16) & 0xff;
+    p[3] = (value >> 24) & 0xff;
+}
+
+static void
+to_legacy_format (unsigned char *odd, int odd_sz, unsigned char *even,
+		  int even_sz)
+{
+/* rewriting a pair of (little-endian) tile blocks in the legacy format */
+    unsigned int crc;
+    odd[1] = 0xfa;		/* legacy OddBlock marker */
+    crc = legacy_crc32 (odd, odd_sz - 5);
+    put_u32_le (odd + odd_sz - 5, crc);
+    even[1] = 0xdb;		/* legacy EvenBlock marker */
+    put_u32_le (even + 13, crc);	/* linking the OddBlock */
+    crc = legacy_crc32 (even, even_sz - 5);
+    put_u32_le (even + even_sz - 5, crc);
+}
+
+static rl2RasterPtr
+build_raster (unsigned char **reference, int *reference_sz)
+{
+/* creating a UINT16 DATAGRID raster */
+    rl2RasterPtr raster;
+    unsigned char *bufpix;
+    int bufpix_size = TILE_SIZE * TILE_SIZE * 2;
+    int i;
+
+    bufpix = malloc (bufpix_size);
+    *reference = malloc (bufpix_size);
+    *reference_sz = bufpix_size;
+    for (i = 0; i < bufpix_size; i++)
+	bufpix[i] = (i * 7) & 0xff;
+    memcpy (*reference, bufpix, bufpix_size);
+    raster = rl2_create_raster (TILE_SIZE, TILE_SIZE, RL2_SAMPLE_UINT16,
+				RL2_PIXEL_DATAGRID, 1, bufpix, bufpix_size,
+				NULL, NULL, 0, NULL);
+    if (raster == NULL)
+	free (bufpix);
+    return raster;
+}
+
+static int
+check_decode (const unsigned char *odd, int odd_sz, const unsigned char *even,
+	      int even_sz, const unsigned char *reference, int reference_sz)
+{
+/* decoding a tile and checking its pixels */
+    rl2RasterPtr raster;
+    unsigned short *buffer;
+    int buf_size;
+    int ok = 0;
+
+    raster = rl2_raster_decode (RL2_SCALE_1, odd, odd_sz, even, even_sz, NULL);
+    if (raster == NULL)
+	return 0;
+    if (rl2_raster_data_to_uint16 (raster, &buffer, &buf_size) == RL2_OK)
+      {
+	  if (buf_size == reference_sz
+	      && memcmp (buffer, reference, reference_sz) == 0)
+	      ok = 1;
+	  rl2_free (buffer);
+      }
+    rl2_destroy_raster (raster);
+    return ok;
+}
+
+static int
+query_tile (const unsigned char *blob, int blob_sz)
+{
+/* querying a tile block */
+    unsigned int width;
+    unsigned int height;
+    unsigned char sample_type;
+    unsigned char pixel_type;
+    unsigned char num_bands;
+    unsigned char compression;
+    int is_odd;
+    int has_mask;
+    return rl2_query_dbms_raster_tile (blob, blob_sz, &width, &height,
+				       &sample_type, &pixel_type, &num_bands,
+				       &compression, &is_odd, &has_mask);
+}
+
+static int
+test_compression (unsigned char compression, const char *name)
+{
+/* testing the tile checksums for a given compression */
+    rl2RasterPtr raster;
+    unsigned char *reference;
+    int reference_sz;
+    unsigned char *odd;
+    int odd_sz;
+    unsigned char *even;
+    int even_sz;
+    int simd;
+
+    raster = build_raster (&reference, &reference_sz);
+    if (raster == NULL)
+      {
+	  fprintf (stderr, "%s: unable to create the raster\n", name);
+	  return -1;
+      }
+    if (rl2_raster_encode
+	(raster, compression, &odd, &odd_sz, &even, &even_sz, 100,
+	 1) != RL2_OK)
+      {
+	  fprintf (stderr, "%s: unable to encode\n", name);
+	  return -2;
+      }
+    rl2_destroy_raster (raster);
+
+/* new tiles are always protected by CRC32C */
+    if (odd[1] != 0xfb || even[1] != 0xdc)
+      {
+	  fprintf (stderr, "%s: unexpected block markers %02x %02x\n", name,
+		   odd[1], even[1]);
+	  return -3;
+      }
+    for (simd = 0; simd < 2; simd++)
+      {
+	  /* the hardware and software CRC32C must agree */
+	  rl2_enable_simd (simd);
+	  if (!check_decode
+	      (odd, odd_sz, even, even_sz, reference, reference_sz))
+	    {
+		fprintf (stderr, "%s: unable to decode (simd=%d)\n", name,
+			 simd);
+		return -4;
+	    }
+	  if (query_tile (odd, odd_sz) != RL2_OK
+	      || query_tile (even, even_sz) != RL2_OK)
+	    {
+		fprintf (stderr, "%s: unable to query (simd=%d)\n", name,
+			 simd);
+		return -5;
+	    }
+      }
+    rl2_enable_simd (1);
+
+/* any corruption must be detected */
+    odd[odd_sz / 2] ^= 0x01;
+    if (rl2_raster_decode (RL2_SCALE_1, odd, odd_sz, even, even_sz, NULL) !=
+	NULL)
+      {
+	  fprintf (stderr, "%s: corrupted OddBlock not detected\n", name);
+	  return -6;
+      }
+    if (query_tile (odd, odd_sz) == RL2_OK)
+      {
+	  fprintf (stderr, "%s: corrupted OddBlock not detected (query)\n",
+		   name);
+	  return -7;
+      }
+    odd[odd_sz / 2] ^= 0x01;
+    even[even_sz / 2] ^= 0x01;
+    if (rl2_raster_decode (RL2_SCALE_1, odd, odd_sz, even, even_sz, NULL) !=
+	NULL)
+      {
+	  fprintf (stderr, "%s: corrupted EvenBlock not detected\n", name);
+	  return -8;
+      }
+    even[even_sz / 2] ^= 0x01;
+
+/* the legacy CRC32 format must still be supported */
+    to_legacy_format (odd, odd_sz, even, even_sz);
+    if (!check_decode (odd, odd_sz, even, even_sz, reference, reference_sz))
+      {
+	  fprintf (stderr, "%s: unable to decode the legacy format\n", name);
+	  return -9;
+      }
+    if (query_tile (odd, odd_sz) != RL2_OK
+	|| query_tile (even, even_sz) != RL2_OK)
+      {
+	  fprintf (stderr, "%s: unable to query the legacy format\n", name);
+	  return -10;
+      }
+    odd[odd_sz / 2] ^= 0x01;
+    if (rl2_raster_decode (RL2_SCALE_1, odd, odd_sz, even, even_sz, NULL) !=
+	NULL)
+      {
+	  fprintf (stderr, "%s: corrupted legacy OddBlock not detected\n",
+		   name);
+	  return -11;
+      }
+    if (get_u32_le (even + 13) != get_u32_le (odd + odd_sz - 5))
+      {
+	  fprintf (stderr, "%s: broken Odd/Even link\n", name);
+	  return -12;
+      }
+
+    free (odd);
+    free (even);
+    free (reference);
+    return 0;
+}
+
+int
+main (int argc, char *argv[])
+{
+    int ret;
+
+    if (argc > 1 || argv[0] == NULL)
+	argc = 1;		/* silencing stupid compiler warnings */
+
+    ret = test_compression (RL2_COMPRESSION_NONE, "NONE");
+    if (ret != 0)
+	return ret;
+    ret = test_compression (RL2_COMPRESSION_DEFLATE, "DEFLATE");
+    if (ret != 0)
+	return ret - 20;
+    return 0;
+}
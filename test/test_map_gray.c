@@ -80,6 +80,51 @@ execute_check (sqlite3 * sqlite, const char *sql)
     return SQLITE_ERROR;
 }
 
+static int
+save_pyramid_tiles (sqlite3 * sqlite, const char *coverage,
+		    const char *filter)
+{
+/* saving a copy of the Pyramid tiles (Section #2 or Monolithic) */
+    int ret;
+    char *sql =
+	sqlite3_mprintf ("CREATE TEMPORARY TABLE pyr_ref AS "
+			 "SELECT t.pyramid_level AS lvl, MbrMinX(t.geometry) AS x, "
+			 "MbrMaxY(t.geometry) AS y, d.tile_data_odd AS odd, "
+			 "d.tile_data_even AS even FROM \"%w_tiles\" AS t "
+			 "JOIN \"%w_tile_data\" AS d ON (d.tile_id = t.tile_id) "
+			 "WHERE t.pyramid_level > 0 AND %s", coverage,
+			 coverage, filter);
+    ret = sqlite3_exec (sqlite, sql, NULL, NULL, NULL);
+    sqlite3_free (sql);
+    return (ret == SQLITE_OK) ? 1 : 0;
+}
+
+static int
+compare_pyramid_tiles (sqlite3 * sqlite, const char *coverage,
+		       const char *filter)
+{
+/* checking the Pyramid tiles against the saved copy */
+    int ret;
+    char *sql =
+	sqlite3_mprintf ("SELECT (SELECT Count(*) FROM pyr_ref) > 0 AND "
+			 "(SELECT Count(*) FROM pyr_ref) = (SELECT Count(*) "
+			 "FROM \"%w_tiles\" WHERE pyramid_level > 0 AND "
+			 "%s) AND (SELECT Count(*) FROM pyr_ref AS r "
+			 "LEFT JOIN (SELECT t.pyramid_level AS lvl, "
+			 "MbrMinX(t.geometry) AS x, MbrMaxY(t.geometry) AS y, "
+			 "d.tile_data_odd AS odd, d.tile_data_even AS even "
+			 "FROM \"%w_tiles\" AS t JOIN \"%w_tile_data\" AS d "
+			 "ON (d.tile_id = t.tile_id) WHERE t.pyramid_level > 0 "
+			 "AND %s) AS n ON (n.lvl = r.lvl "
+			 "AND n.x = r.x AND n.y = r.y) WHERE n.odd IS NULL "
+			 "OR n.odd <> r.odd OR n.even IS NOT r.even) = 0",
+			 coverage, filter, coverage, coverage, filter);
+    ret = execute_check (sqlite, sql);
+    sqlite3_free (sql);
+    sqlite3_exec (sqlite, "DROP TABLE pyr_ref", NULL, NULL, NULL);
+    return (ret == SQLITE_OK) ? 1 : 0;
+}
+
 static int
 get_base_resolution (sqlite3 * sqlite, const char *coverage, double *x_res,
 		     double *y_res)
@@ -765,6 +810,14 @@ test_coverage (sqlite3 * sqlite, unsigned char pixel, unsigned char compression,
 		return 0;
 	    }
 
+	  if (!save_pyramid_tiles (sqlite, coverage, "section_id = 2"))
+	    {
+		fprintf (stderr, "Unable to save the Pyramid tiles \"%s\"\n",
+			 coverage);
+		*retcode += -6;
+		return 0;
+	    }
+
 /* destroying the Pyramid Levels */
 	  sql =
 	      sqlite3_mprintf ("SELECT RL2_DePyramidize(%Q, NULL, 1)",
@@ -780,11 +833,13 @@ test_coverage (sqlite3 * sqlite, unsigned char pixel, unsigned char compression,
 		return 0;
 	    }
 
-/* building yet again the Pyramid Levels */
+/* building yet again the Pyramid Levels - multithreaded */
+	  execute_check (sqlite, "SELECT RL2_SetMaxThreads(4)");
 	  sql =
 	      sqlite3_mprintf ("SELECT RL2_Pyramidize(%Q, 2, 1, 1)", coverage);
 	  ret = execute_check (sqlite, sql);
 	  sqlite3_free (sql);
+	  execute_check (sqlite, "SELECT RL2_SetMaxThreads(1)");
 	  if (ret != SQLITE_OK)
 	    {
 		fprintf (stderr, "Pyramidize \"%s\" error: %s\n", coverage,
@@ -793,6 +848,14 @@ test_coverage (sqlite3 * sqlite, unsigned char pixel, unsigned char compression,
 		*retcode += -8;
 		return 0;
 	    }
+	  if (!compare_pyramid_tiles (sqlite, coverage, "section_id = 2"))
+	    {
+		fprintf (stderr,
+			 "Mismatching multithreaded Pyramid tiles \"%s\"\n",
+			 coverage);
+		*retcode += -8;
+		return 0;
+	    }
       }
 
 /* export tests */
@@ -902,6 +965,121 @@ test_coverage (sqlite3 * sqlite, unsigned char pixel, unsigned char compression,
 		*retcode += -26;
 		return 0;
 	    }
+	  if (!save_pyramid_tiles (sqlite, coverage, "section_id IS NULL"))
+	    {
+		fprintf (stderr, "Unable to save the Pyramid tiles \"%s\"\n",
+			 coverage);
+		*retcode += -26;
+		return 0;
+	    }
+
+	  /* building yet again the Monolithic Pyramid - multithreaded */
+	  execute_check (sqlite, "SELECT RL2_SetMaxThreads(4)");
+	  sql =
+	      sqlite3_mprintf ("SELECT RL2_PyramidizeMonolithic(%Q, 2, 1)",
+			       coverage);
+	  ret = execute_check (sqlite, sql);
+	  sqlite3_free (sql);
+	  execute_check (sqlite, "SELECT RL2_SetMaxThreads(1)");
+	  if (ret != SQLITE_OK)
+	    {
+		fprintf (stderr, "PyramidizeMonolithic \"%s\" error: %s\n",
+			 coverage, err_msg);
+		sqlite3_free (err_msg);
+		*retcode += -26;
+		return 0;
+	    }
+	  if (!compare_pyramid_tiles (sqlite, coverage, "section_id IS NULL"))
+	    {
+		fprintf (stderr,
+			 "Mismatching multithreaded Monolithic tiles \"%s\"\n",
+			 coverage);
+		*retcode += -26;
+		return 0;
+	    }
+
+	  /* replacing a Section, then incrementally updating the Pyramid */
+	  if (!save_pyramid_tiles (sqlite, coverage, "section_id IS NULL"))
+	    {
+		fprintf (stderr, "Unable to save the Pyramid tiles \"%s\"\n",
+			 coverage);
+		*retcode += -26;
+		return 0;
+	    }
+	  sql =
+	      sqlite3_mprintf ("SELECT RL2_DeleteSection(%Q, (SELECT section_id "
+			       "FROM \"%w_sections\" WHERE section_name = 'gray1'), 1)",
+			       coverage, coverage);
+	  ret = execute_check (sqlite, sql);
+	  sqlite3_free (sql);
+	  if (ret != SQLITE_OK)
+	    {
+		fprintf (stderr, "DeleteSection \"%s\" error: %s\n", coverage,
+			 err_msg);
+		sqlite3_free (err_msg);
+		*retcode += -26;
+		return 0;
+	    }
+	  sql =
+	      sqlite3_mprintf ("SELECT RL2_LoadRaster(%Q, %Q, 0, 26914, 0, 1)",
+			       coverage, "map_samples/usgs-gray/gray1.tif");
+	  ret = execute_check (sqlite, sql);
+	  sqlite3_free (sql);
+	  if (ret != SQLITE_OK)
+	    {
+		fprintf (stderr, "LoadRaster \"%s\" error: %s\n", coverage,
+			 err_msg);
+		sqlite3_free (err_msg);
+		*retcode += -26;
+		return 0;
+	    }
+	  sql =
+	      sqlite3_mprintf ("SELECT Count(*) = 2 FROM \"%w_dirty_regions\"",
+			       coverage);
+	  ret = execute_check (sqlite, sql);
+	  sqlite3_free (sql);
+	  if (ret != SQLITE_OK)
+	    {
+		fprintf (stderr, "Unexpected dirty regions \"%s\"\n",
+			 coverage);
+		*retcode += -26;
+		return 0;
+	    }
+	  execute_check (sqlite, "SELECT RL2_SetMaxThreads(4)");
+	  sql =
+	      sqlite3_mprintf ("SELECT RL2_PyramidizeIncremental(%Q, 1)",
+			       coverage);
+	  ret = execute_check (sqlite, sql);
+	  sqlite3_free (sql);
+	  execute_check (sqlite, "SELECT RL2_SetMaxThreads(1)");
+	  if (ret != SQLITE_OK)
+	    {
+		fprintf (stderr, "PyramidizeIncremental \"%s\" error: %s\n",
+			 coverage, err_msg);
+		sqlite3_free (err_msg);
+		*retcode += -26;
+		return 0;
+	    }
+	  if (!compare_pyramid_tiles (sqlite, coverage, "section_id IS NULL"))
+	    {
+		fprintf (stderr,
+			 "Mismatching incremental Monolithic tiles \"%s\"\n",
+			 coverage);
+		*retcode += -26;
+		return 0;
+	    }
+	  sql =
+	      sqlite3_mprintf ("SELECT Count(*) = 0 FROM \"%w_dirty_regions\"",
+			       coverage);
+	  ret = execute_check (sqlite, sql);
+	  sqlite3_free (sql);
+	  if (ret != SQLITE_OK)
+	    {
+		fprintf (stderr, "Unexpected dirty regions \"%s\"\n",
+			 coverage);
+		*retcode += -26;
+		return 0;
+	    }
 
 	  /* export tests */
 	  if (geom == NULL)
@@ -77,6 +77,78 @@ execute_check (sqlite3 * sqlite, const char *sql)
     return SQLITE_ERROR;
 }
 
+static int
+save_pyramid_tiles (sqlite3 * sqlite, const char *coverage)
+{
+/* saving a copy of the Section Pyramid tiles */
+    int ret;
+    char *sql =
+	sqlite3_mprintf ("CREATE TEMPORARY TABLE pyr_ref AS "
+			 "SELECT t.section_id AS sect, t.pyramid_level AS lvl, "
+			 "MbrMinX(t.geometry) AS x, MbrMaxY(t.geometry) AS y, "
+			 "d.tile_data_odd AS odd, d.tile_data_even AS even "
+			 "FROM \"%w_tiles\" AS t JOIN \"%w_tile_data\" AS d "
+			 "ON (d.tile_id = t.tile_id) WHERE t.pyramid_level > 0",
+			 coverage, coverage);
+    ret = sqlite3_exec (sqlite, sql, NULL, NULL, NULL);
+    sqlite3_free (sql);
+    return (ret == SQLITE_OK) ? 1 : 0;
+}
+
+static int
+compare_pyramid_tiles (sqlite3 * sqlite, const char *coverage)
+{
+/* checking the Section Pyramid tiles against the saved copy */
+    int ret;
+    char *sql =
+	sqlite3_mprintf ("SELECT (SELECT Count(*) FROM pyr_ref) > 0 AND "
+			 "(SELECT Count(*) FROM pyr_ref) = (SELECT Count(*) "
+			 "FROM \"%w_tiles\" WHERE pyramid_level > 0) AND "
+			 "(SELECT Count(*) FROM pyr_ref AS r LEFT JOIN "
+			 "(SELECT t.section_id AS sect, t.pyramid_level AS lvl, "
+			 "MbrMinX(t.geometry) AS x, MbrMaxY(t.geometry) AS y, "
+			 "d.tile_data_odd AS odd, d.tile_data_even AS even "
+			 "FROM \"%w_tiles\" AS t JOIN \"%w_tile_data\" AS d "
+			 "ON (d.tile_id = t.tile_id) WHERE t.pyramid_level > 0) "
+			 "AS n ON (n.sect = r.sect AND n.lvl = r.lvl AND "
+			 "n.x = r.x AND n.y = r.y) WHERE n.odd IS NULL "
+			 "OR n.odd <> r.odd OR n.even IS NOT r.even) = 0",
+			 coverage, coverage, coverage);
+    ret = execute_check (sqlite, sql);
+    sqlite3_free (sql);
+    sqlite3_exec (sqlite, "DROP TABLE pyr_ref", NULL, NULL, NULL);
+    return ret;
+}
+
+static int
+test_resampling (sqlite3 * sqlite, const char *coverage,
+		 const char *resampling)
+{
+/* re-building the Pyramid by some resampling kernel */
+    int ret;
+    char *sql =
+	sqlite3_mprintf ("SELECT RL2_SetRasterCoverageResampling(%Q, %Q)",
+			 coverage, resampling);
+    ret = execute_check (sqlite, sql);
+    sqlite3_free (sql);
+    if (ret != SQLITE_OK)
+      {
+	  fprintf (stderr, "SetRasterCoverageResampling \"%s\" %s error\n",
+		   coverage, resampling);
+	  return 0;
+      }
+    sql = sqlite3_mprintf ("SELECT RL2_Pyramidize(%Q, NULL, 1)", coverage);
+    ret = execute_check (sqlite, sql);
+    sqlite3_free (sql);
+    if (ret != SQLITE_OK)
+      {
+	  fprintf (stderr, "Pyramidize (%s) \"%s\" error\n", resampling,
+		   coverage);
+	  return 0;
+      }
+    return 1;
+}
+
 static int
 test_coverage (sqlite3 * sqlite, unsigned char sample, int tile_sz,
 	       int *retcode)
@@ -287,6 +359,112 @@ test_coverage (sqlite3 * sqlite, unsigned char sample, int tile_sz,
 	  return 0;
       }
 
+/* re-building the Pyramid by the portable C box filter */
+    rl2_enable_simd (0);
+    sql = sqlite3_mprintf ("SELECT RL2_Pyramidize(%Q, NULL, 1)", coverage);
+    ret = execute_check (sqlite, sql);
+    sqlite3_free (sql);
+    rl2_enable_simd (1);
+    if (ret != SQLITE_OK)
+      {
+	  fprintf (stderr, "Pyramidize (no SIMD) \"%s\" error\n", coverage);
+	  *retcode += -5;
+	  return 0;
+      }
+    if (!save_pyramid_tiles (sqlite, coverage))
+      {
+	  fprintf (stderr, "Unable to save the Pyramid \"%s\"\n", coverage);
+	  *retcode += -6;
+	  return 0;
+      }
+
+/* re-building the Pyramid by the SIMD box filter: must be identical */
+    sql = sqlite3_mprintf ("SELECT RL2_Pyramidize(%Q, NULL, 1)", coverage);
+    ret = execute_check (sqlite, sql);
+    sqlite3_free (sql);
+    if (ret != SQLITE_OK)
+      {
+	  fprintf (stderr, "Pyramidize (SIMD) \"%s\" error\n", coverage);
+	  *retcode += -7;
+	  return 0;
+      }
+    if (compare_pyramid_tiles (sqlite, coverage) != SQLITE_OK)
+      {
+	  fprintf (stderr, "Mismatching SIMD Pyramid \"%s\"\n", coverage);
+	  *retcode += -8;
+	  return 0;
+      }
+
+/* re-building the Pyramid by NEAREST resampling: must differ from AVERAGE */
+    if (!save_pyramid_tiles (sqlite, coverage))
+      {
+	  fprintf (stderr, "Unable to save the Pyramid \"%s\"\n", coverage);
+	  *retcode += -9;
+	  return 0;
+      }
+    sql =
+	sqlite3_mprintf
+	("SELECT RL2_SetRasterCoverageResampling(%Q, 'NEAREST')", coverage);
+    ret = execute_check (sqlite, sql);
+    sqlite3_free (sql);
+    if (ret != SQLITE_OK)
+      {
+	  fprintf (stderr, "SetRasterCoverageResampling \"%s\" error\n",
+		   coverage);
+	  *retcode += -10;
+	  return 0;
+      }
+    sql =
+	sqlite3_mprintf
+	("SELECT RL2_GetRasterCoverageResampling(NULL, %Q) = 'NEAREST'",
+	 coverage);
+    ret = execute_check (sqlite, sql);
+    sqlite3_free (sql);
+    if (ret != SQLITE_OK)
+      {
+	  fprintf (stderr, "GetRasterCoverageResampling \"%s\" error\n",
+		   coverage);
+	  *retcode += -11;
+	  return 0;
+      }
+    sql = sqlite3_mprintf ("SELECT RL2_Pyramidize(%Q, NULL, 1)", coverage);
+    ret = execute_check (sqlite, sql);
+    sqlite3_free (sql);
+    if (ret != SQLITE_OK)
+      {
+	  fprintf (stderr, "Pyramidize (NEAREST) \"%s\" error\n", coverage);
+	  *retcode += -12;
+	  return 0;
+      }
+    if (compare_pyramid_tiles (sqlite, coverage) == SQLITE_OK)
+      {
+	  fprintf (stderr, "Unexpected AVERAGE Pyramid \"%s\"\n", coverage);
+	  *retcode += -13;
+	  return 0;
+      }
+
+/* re-building the Pyramid by any other resampling kernel */
+    if (!test_resampling (sqlite, coverage, "MODE"))
+      {
+	  *retcode += -14;
+	  return 0;
+      }
+    if (!test_resampling (sqlite, coverage, "BILINEAR"))
+      {
+	  *retcode += -15;
+	  return 0;
+      }
+    if (!test_resampling (sqlite, coverage, "CUBIC"))
+      {
+	  *retcode += -16;
+	  return 0;
+      }
+    if (!test_resampling (sqlite, coverage, "DEFAULT"))
+      {
+	  *retcode += -17;
+	  return 0;
+      }
+
     return 1;
 }
 
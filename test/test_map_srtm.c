@@ -614,6 +614,443 @@ test_pixel_double (sqlite3 * sqlite, int *retcode)
     return 1;
 }
 
+static int
+test_pixels_by_points (sqlite3 * sqlite, int *retcode)
+{
+/* testing GetPixelsFromRasterByPoints() */
+    int ret;
+    const char *sql;
+    int count;
+    double value;
+
+    sql =
+	"SELECT ST_NumGeometries(RL2_GetPixelsFromRasterByPoints(NULL, 'grid_16_deflate_1024', p, 0)) "
+	"FROM (SELECT MakePoint(11.75, 42.75, 4326) AS p UNION ALL "
+	"SELECT MakePoint(11.70, 42.70, 4326) UNION ALL "
+	"SELECT MakePoint(-100.0, -80.0, 4326))";
+    ret = execute_check_value (sqlite, sql, &count);
+    if (ret != 1)
+      {
+	  fprintf (stderr, "GetPixelsFromRasterByPoints #0 error\n");
+	  *retcode += -1;
+	  return 0;
+      }
+    if (count != 3)
+      {
+	  fprintf (stderr,
+		   "GetPixelsFromRasterByPoints #0 error: expected 3, found %d\n",
+		   count);
+	  *retcode += -1;
+	  return 0;
+      }
+
+    sql =
+	"SELECT ST_Z(ST_GeometryN(RL2_GetPixelsFromRasterByPoints(NULL, 'grid_16_deflate_1024', p, 0), 1)) "
+	"FROM (SELECT MakePoint(11.75, 42.75, 4326) AS p)";
+    ret = execute_check_float (sqlite, sql, &value);
+    if (ret != 1)
+      {
+	  fprintf (stderr, "GetPixelsFromRasterByPoints #1 error\n");
+	  *retcode += -2;
+	  return 0;
+      }
+    if (value != 304.000000)
+      {
+	  fprintf (stderr,
+		   "GetPixelsFromRasterByPoints #1 error: expected 304.000000, found %f\n",
+		   value);
+	  *retcode += -2;
+	  return 0;
+      }
+
+/*
+/ a Point exactly on the edge shared by two adjacent Tiles must return
+/ the first pixel of the Tile on the right (same as a Point just inside
+/ that pixel), not NO-DATA
+*/
+    sql =
+	"WITH edge AS (SELECT MbrMaxX(a.geometry) AS x, "
+	"(MbrMinY(a.geometry) + MbrMaxY(a.geometry)) / 2.0 AS y, "
+	"(SELECT horz_resolution FROM raster_coverages "
+	"WHERE coverage_name = 'grid_16_deflate_1024') / 4.0 AS r "
+	"FROM \"grid_16_deflate_1024_tiles\" AS a "
+	"JOIN \"grid_16_deflate_1024_tiles\" AS b ON (b.section_id = a.section_id "
+	"AND b.pyramid_level = 0 AND MbrMinX(b.geometry) = MbrMaxX(a.geometry) "
+	"AND MbrMaxY(b.geometry) = MbrMaxY(a.geometry)) "
+	"WHERE a.pyramid_level = 0 ORDER BY a.tile_id LIMIT 1) "
+	"SELECT ST_NumGeometries(m) = 2 AND ST_Z(ST_GeometryN(m, 1)) = "
+	"ST_Z(ST_GeometryN(m, 2)) "
+	"FROM (SELECT RL2_GetPixelsFromRasterByPoints(NULL, 'grid_16_deflate_1024', p, 0) AS m "
+	"FROM (SELECT MakePoint(x, y, 4326) AS p FROM edge UNION ALL "
+	"SELECT MakePoint(x + r, y, 4326) FROM edge))";
+    ret = execute_check_value (sqlite, sql, &count);
+    if (ret != 1 || count != 1)
+      {
+	  fprintf (stderr,
+		   "GetPixelsFromRasterByPoints #2 error: wrong pixel on a Tile edge\n");
+	  *retcode += -3;
+	  return 0;
+      }
+    return 1;
+}
+
+static int
+test_statement_cache (sqlite3 * sqlite, int *retcode)
+{
+/* testing the prepared Statements Cache */
+    int ret;
+    const char *sql;
+    int enabled;
+    int i;
+    int count;
+
+    sql = "SELECT RL2_SetStatementCache(1)";
+    ret = execute_check_value (sqlite, sql, &enabled);
+    if (ret != 1 || enabled != 1)
+      {
+	  fprintf (stderr, "SetStatementCache #1 error\n");
+	  *retcode += -1;
+	  return 0;
+      }
+
+    for (i = 0; i < 2; i++)
+      {
+	  /* the uncovered Point always queries the Tiles table again */
+	  sql =
+	      "SELECT ST_NumGeometries(RL2_GetPixelsFromRasterByPoints(NULL, 'grid_16_deflate_1024', p, 0)) "
+	      "FROM (SELECT MakePoint(11.75, 42.75, 4326) AS p UNION ALL "
+	      "SELECT MakePoint(-100.0, -80.0, 4326))";
+	  ret = execute_check_value (sqlite, sql, &count);
+	  if (ret != 1 || count != 2)
+	    {
+		fprintf (stderr,
+			 "StatementCache #%d error: expected 2, found %d\n",
+			 i, count);
+		*retcode += -2;
+		return 0;
+	    }
+      }
+
+/* cached Statements must be finalized before closing the connection */
+    sql = "SELECT RL2_SetStatementCache(0)";
+    ret = execute_check_value (sqlite, sql, &enabled);
+    if (ret != 1 || enabled != 0)
+      {
+	  fprintf (stderr, "SetStatementCache #0 error\n");
+	  *retcode += -3;
+	  return 0;
+      }
+    return 1;
+}
+
+static unsigned char *
+get_map_image_bbox (sqlite3 * sqlite, double minx, double miny, double maxx,
+		    double maxy, int *size)
+{
+/* fetching some Map Image */
+    int ret;
+    sqlite3_stmt *stmt = NULL;
+    unsigned char *image = NULL;
+    char *sql =
+	sqlite3_mprintf
+	("SELECT RL2_GetMapImageFromRaster(NULL, 'grid_16_deflate_1024', "
+	 "BuildMbr(%1.2f, %1.2f, %1.2f, %1.2f, 4326), 512, 512)", minx, miny,
+	 maxx, maxy);
+    *size = 0;
+    ret = sqlite3_prepare_v2 (sqlite, sql, strlen (sql), &stmt, NULL);
+    sqlite3_free (sql);
+    if (ret != SQLITE_OK)
+	return NULL;
+    ret = sqlite3_step (stmt);
+    if (ret == SQLITE_ROW && sqlite3_column_type (stmt, 0) == SQLITE_BLOB)
+      {
+	  *size = sqlite3_column_bytes (stmt, 0);
+	  image = malloc (*size);
+	  memcpy (image, sqlite3_column_blob (stmt, 0), *size);
+      }
+    sqlite3_finalize (stmt);
+    return image;
+}
+
+static unsigned char *
+get_map_image (sqlite3 * sqlite, int *size)
+{
+/* fetching the reference Map Image */
+    return get_map_image_bbox (sqlite, 11.55, 42.55, 11.95, 42.95, size);
+}
+
+static int
+test_tile_grid_index (sqlite3 * sqlite, int *retcode)
+{
+/* testing the Grid Index: the Map Image must be exactly the same */
+    int ret;
+    const char *sql;
+    int enabled;
+    unsigned char *img_rtree;
+    unsigned char *img_grid;
+    int sz_rtree;
+    int sz_grid;
+    int same;
+
+    img_rtree = get_map_image (sqlite, &sz_rtree);
+    if (img_rtree == NULL)
+      {
+	  fprintf (stderr, "TileGridIndex: unable to get a Map Image\n");
+	  *retcode += -1;
+	  return 0;
+      }
+
+    sql = "SELECT RL2_SetTileGridIndex(1)";
+    ret = execute_check_value (sqlite, sql, &enabled);
+    if (ret != 1 || enabled != 1)
+      {
+	  fprintf (stderr, "SetTileGridIndex #1 error\n");
+	  free (img_rtree);
+	  *retcode += -2;
+	  return 0;
+      }
+    img_grid = get_map_image (sqlite, &sz_grid);
+    same = 0;
+    if (img_grid != NULL && sz_grid == sz_rtree)
+      {
+	  if (memcmp (img_rtree, img_grid, sz_grid) == 0)
+	      same = 1;
+      }
+    free (img_rtree);
+    if (img_grid != NULL)
+	free (img_grid);
+    if (!same)
+      {
+	  fprintf (stderr, "TileGridIndex: mismatching Map Image\n");
+	  *retcode += -3;
+	  return 0;
+      }
+
+    sql = "SELECT RL2_SetTileGridIndex(0)";
+    ret = execute_check_value (sqlite, sql, &enabled);
+    if (ret != 1 || enabled != 0)
+      {
+	  fprintf (stderr, "SetTileGridIndex #0 error\n");
+	  *retcode += -4;
+	  return 0;
+      }
+    return 1;
+}
+
+static int
+check_split_images (sqlite3 * sqlite, unsigned char *img_full, int sz_full,
+		    unsigned char *img_ovr, int sz_ovr)
+{
+/* checking the Map Images against the reference ones */
+    unsigned char *img;
+    int sz;
+    int same = 1;
+    img = get_map_image_bbox (sqlite, 11.55, 42.55, 11.95, 42.95, &sz);
+    if (img == NULL || sz != sz_full || memcmp (img, img_full, sz) != 0)
+	same = 0;
+    if (img != NULL)
+	free (img);
+    img = get_map_image_bbox (sqlite, 11.0, 42.0, 12.6, 43.6, &sz);
+    if (img == NULL || sz != sz_ovr || memcmp (img, img_ovr, sz) != 0)
+	same = 0;
+    if (img != NULL)
+	free (img);
+    return same;
+}
+
+static int
+test_split_tiles (sqlite3 * sqlite, int *retcode)
+{
+/* 
+/ testing the Split Tiles layout: the Map Images (both at full
+/ resolution and at a reduced scale) must be exactly the same
+/ the Coverage is finally left split, so to be dropped as such
+*/
+    int ret;
+    int i;
+    int value;
+    unsigned char *img_full;
+    unsigned char *img_ovr;
+    int sz_full;
+    int sz_ovr;
+    const char *sql[] = {
+	"SELECT RL2_EnableRasterCoverageSplitTiles('grid_16_deflate_1024', 1)",
+	"SELECT RL2_EnableRasterCoverageSplitTiles('grid_16_deflate_1024', 0)",
+	"SELECT RL2_EnableRasterCoverageSplitTiles('grid_16_deflate_1024', 1)"
+    };
+    int expected[] = { 1, 0, 1 };
+
+    img_full = get_map_image_bbox (sqlite, 11.55, 42.55, 11.95, 42.95,
+				   &sz_full);
+    img_ovr = get_map_image_bbox (sqlite, 11.0, 42.0, 12.6, 43.6, &sz_ovr);
+    if (img_full == NULL || img_ovr == NULL)
+      {
+	  fprintf (stderr, "SplitTiles: unable to get a Map Image\n");
+	  *retcode += -1;
+	  goto error;
+      }
+
+    for (i = 0; i < 3; i++)
+      {
+	  ret = execute_check_value (sqlite, sql[i], &value);
+	  if (ret != 1 || value != 1)
+	    {
+		fprintf (stderr, "EnableRasterCoverageSplitTiles #%d error\n",
+			 i);
+		*retcode += -2;
+		goto error;
+	    }
+	  ret =
+	      execute_check_value (sqlite,
+				   "SELECT RL2_IsRasterCoverageSplitTilesEnabled"
+				   "(NULL, 'grid_16_deflate_1024')", &value);
+	  if (ret != 1 || value != expected[i])
+	    {
+		fprintf (stderr,
+			 "IsRasterCoverageSplitTilesEnabled #%d error\n", i);
+		*retcode += -3;
+		goto error;
+	    }
+	  if (!check_split_images (sqlite, img_full, sz_full, img_ovr, sz_ovr))
+	    {
+		fprintf (stderr, "SplitTiles #%d: mismatching Map Image\n",
+			 i);
+		*retcode += -4;
+		goto error;
+	    }
+      }
+    free (img_full);
+    free (img_ovr);
+    return 1;
+
+  error:
+    if (img_full != NULL)
+	free (img_full);
+    if (img_ovr != NULL)
+	free (img_ovr);
+    return 0;
+}
+
+static int
+do_check_read_back (sqlite3 * sqlite, const char *coverage,
+		    const char *reference)
+{
+/* 
+/ reading back the pixels of some Coverage and checking them against
+/ the ones of a reference uncompressed Coverage; each base level Tile
+/ is sampled at its top-left, central and bottom-right pixels, the
+/ latter one falling within the Transparency Mask of any edge Tile
+*/
+    char *sql;
+    char *table;
+    char *xtable;
+    int ret;
+    int mismatches = -1;
+    double res = 0.0008333333333333;
+    double half = res / 2.0;
+
+    table = sqlite3_mprintf ("%s_tiles", coverage);
+    xtable = gaiaDoubleQuotedSql (table);
+    sqlite3_free (table);
+    sql =
+	sqlite3_mprintf
+	("SELECT CASE WHEN Count(a) = 0 THEN -1 "
+	 "ELSE Count(CASE WHEN a IS NOT b THEN 1 END) END FROM ("
+	 "SELECT RL2_GetPixelValue(RL2_GetPixelFromRasterByPoint(NULL, %Q, "
+	 "MakePoint(x, y, 4326), %1.16f, %1.16f), 0) AS a, "
+	 "RL2_GetPixelValue(RL2_GetPixelFromRasterByPoint(NULL, %Q, "
+	 "MakePoint(x, y, 4326), %1.16f, %1.16f), 0) AS b FROM ("
+	 "SELECT MbrMinX(geometry) + %1.16f AS x, "
+	 "MbrMaxY(geometry) - %1.16f AS y "
+	 "FROM \"%s\" WHERE pyramid_level = 0 UNION ALL "
+	 "SELECT (MbrMinX(geometry) + MbrMaxX(geometry)) / 2.0, "
+	 "(MbrMinY(geometry) + MbrMaxY(geometry)) / 2.0 "
+	 "FROM \"%s\" WHERE pyramid_level = 0 UNION ALL "
+	 "SELECT MbrMaxX(geometry) - %1.16f, MbrMinY(geometry) + %1.16f "
+	 "FROM \"%s\" WHERE pyramid_level = 0))", coverage, res, res,
+	 reference, res, res, half, half, xtable, xtable, half, half, xtable);
+    free (xtable);
+    ret = execute_check_value (sqlite, sql, &mismatches);
+    sqlite3_free (sql);
+    if (ret != 1 || mismatches != 0)
+      {
+	  fprintf (stderr,
+		   "ReadBack \"%s\" error: %d mismatching pixels\n",
+		   coverage, mismatches);
+	  return 0;
+      }
+    return 1;
+}
+
+#ifndef OMIT_LZ4		/* only if LZ4 is enabled */
+static int
+test_lz4_read_back (sqlite3 * sqlite, int *retcode)
+{
+/* 
+/ testing the LZ4 Coverages (both ByteShuffle and noShuffle) against
+/ the uncompressed one
+*/
+    if (!do_check_read_back (sqlite, "grid_16_lz4_256", "grid_16_none_256"))
+      {
+	  *retcode += -1;
+	  return 0;
+      }
+    if (!do_check_read_back
+	(sqlite, "grid_16_lz4no_256", "grid_16_none_256"))
+      {
+	  *retcode += -2;
+	  return 0;
+      }
+    return 1;
+}
+#endif /* end LZ4 conditional */
+
+static int
+test_fp_read_back (sqlite3 * sqlite, int *retcode)
+{
+/* testing the FloatPredictor Coverages against the uncompressed ones */
+    const char *float_cvg[] = {
+	"grid_flt_deflatefp_256",
+#ifndef OMIT_LZMA		/* only if LZMA is enabled */
+	"grid_flt_lzmafp_256",
+#endif /* end LZMA conditional */
+#ifndef OMIT_ZSTD		/* only if ZSTD is enabled */
+	"grid_flt_zstdfp_256",
+#endif /* end ZSTD conditional */
+	NULL
+    };
+    const char *double_cvg[] = {
+	"grid_dbl_deflatefp_256",
+#ifndef OMIT_LZMA		/* only if LZMA is enabled */
+	"grid_dbl_lzmafp_256",
+#endif /* end LZMA conditional */
+#ifndef OMIT_ZSTD		/* only if ZSTD is enabled */
+	"grid_dbl_zstdfp_256",
+#endif /* end ZSTD conditional */
+	NULL
+    };
+    int i;
+
+    for (i = 0; float_cvg[i] != NULL; i++)
+      {
+	  if (!do_check_read_back (sqlite, float_cvg[i], "grid_flt_none_256"))
+	    {
+		*retcode += -1 - i;
+		return 0;
+	    }
+      }
+    for (i = 0; double_cvg[i] != NULL; i++)
+      {
+	  if (!do_check_read_back
+	      (sqlite, double_cvg[i], "grid_dbl_none_256"))
+	    {
+		*retcode += -4 - i;
+		return 0;
+	    }
+      }
+    return 1;
+}
+
 static int
 test_coverage (sqlite3 * sqlite, unsigned char sample,
 	       unsigned char compression, int tile_sz, int *retcode)
@@ -750,6 +1187,30 @@ test_coverage (sqlite3 * sqlite, unsigned char sample,
 		      break;
 		  };
 		break;
+	    case RL2_COMPRESSION_ZSTD:
+		switch (tile_sz)
+		  {
+		  case TILE_256:
+		      coverage = "grid_16_zstd_256";
+		      break;
+		  };
+		break;
+	    case RL2_COMPRESSION_LZ4:
+		switch (tile_sz)
+		  {
+		  case TILE_256:
+		      coverage = "grid_16_lz4_256";
+		      break;
+		  };
+		break;
+	    case RL2_COMPRESSION_LZ4_NO:
+		switch (tile_sz)
+		  {
+		  case TILE_256:
+		      coverage = "grid_16_lz4no_256";
+		      break;
+		  };
+		break;
 	    };
 	  break;
       case RL2_SAMPLE_UINT16:
@@ -906,6 +1367,30 @@ test_coverage (sqlite3 * sqlite, unsigned char sample,
 		      break;
 		  };
 		break;
+	    case RL2_COMPRESSION_DEFLATE_FP:
+		switch (tile_sz)
+		  {
+		  case TILE_256:
+		      coverage = "grid_flt_deflatefp_256";
+		      break;
+		  };
+		break;
+	    case RL2_COMPRESSION_LZMA_FP:
+		switch (tile_sz)
+		  {
+		  case TILE_256:
+		      coverage = "grid_flt_lzmafp_256";
+		      break;
+		  };
+		break;
+	    case RL2_COMPRESSION_ZSTD_FP:
+		switch (tile_sz)
+		  {
+		  case TILE_256:
+		      coverage = "grid_flt_zstdfp_256";
+		      break;
+		  };
+		break;
 	    };
 	  break;
       case RL2_SAMPLE_DOUBLE:
@@ -945,6 +1430,30 @@ test_coverage (sqlite3 * sqlite, unsigned char sample,
 		      break;
 		  };
 		break;
+	    case RL2_COMPRESSION_DEFLATE_FP:
+		switch (tile_sz)
+		  {
+		  case TILE_256:
+		      coverage = "grid_dbl_deflatefp_256";
+		      break;
+		  };
+		break;
+	    case RL2_COMPRESSION_LZMA_FP:
+		switch (tile_sz)
+		  {
+		  case TILE_256:
+		      coverage = "grid_dbl_lzmafp_256";
+		      break;
+		  };
+		break;
+	    case RL2_COMPRESSION_ZSTD_FP:
+		switch (tile_sz)
+		  {
+		  case TILE_256:
+		      coverage = "grid_dbl_zstdfp_256";
+		      break;
+		  };
+		break;
 	    };
 	  break;
       };
@@ -993,6 +1502,30 @@ test_coverage (sqlite3 * sqlite, unsigned char sample,
 	  compression_name = "LZMA";
 	  qlty = 100;
 	  break;
+      case RL2_COMPRESSION_ZSTD:
+	  compression_name = "ZSTD";
+	  qlty = 50;
+	  break;
+      case RL2_COMPRESSION_LZ4:
+	  compression_name = "LZ4";
+	  qlty = 100;
+	  break;
+      case RL2_COMPRESSION_LZ4_NO:
+	  compression_name = "LZ4_NO";
+	  qlty = 100;
+	  break;
+      case RL2_COMPRESSION_DEFLATE_FP:
+	  compression_name = "DEFLATE_FP";
+	  qlty = 100;
+	  break;
+      case RL2_COMPRESSION_LZMA_FP:
+	  compression_name = "LZMA_FP";
+	  qlty = 100;
+	  break;
+      case RL2_COMPRESSION_ZSTD_FP:
+	  compression_name = "ZSTD_FP";
+	  qlty = 50;
+	  break;
       };
     switch (tile_sz)
       {
@@ -1781,6 +2314,30 @@ drop_coverage (sqlite3 * sqlite, unsigned char sample,
 		      break;
 		  };
 		break;
+	    case RL2_COMPRESSION_ZSTD:
+		switch (tile_sz)
+		  {
+		  case TILE_256:
+		      coverage = "grid_16_zstd_256";
+		      break;
+		  };
+		break;
+	    case RL2_COMPRESSION_LZ4:
+		switch (tile_sz)
+		  {
+		  case TILE_256:
+		      coverage = "grid_16_lz4_256";
+		      break;
+		  };
+		break;
+	    case RL2_COMPRESSION_LZ4_NO:
+		switch (tile_sz)
+		  {
+		  case TILE_256:
+		      coverage = "grid_16_lz4no_256";
+		      break;
+		  };
+		break;
 	    };
 	  break;
       case RL2_SAMPLE_UINT16:
@@ -1933,6 +2490,30 @@ drop_coverage (sqlite3 * sqlite, unsigned char sample,
 		      break;
 		  };
 		break;
+	    case RL2_COMPRESSION_DEFLATE_FP:
+		switch (tile_sz)
+		  {
+		  case TILE_256:
+		      coverage = "grid_flt_deflatefp_256";
+		      break;
+		  };
+		break;
+	    case RL2_COMPRESSION_LZMA_FP:
+		switch (tile_sz)
+		  {
+		  case TILE_256:
+		      coverage = "grid_flt_lzmafp_256";
+		      break;
+		  };
+		break;
+	    case RL2_COMPRESSION_ZSTD_FP:
+		switch (tile_sz)
+		  {
+		  case TILE_256:
+		      coverage = "grid_flt_zstdfp_256";
+		      break;
+		  };
+		break;
 	    };
 	  break;
       case RL2_SAMPLE_DOUBLE:
@@ -1971,6 +2552,30 @@ drop_coverage (sqlite3 * sqlite, unsigned char sample,
 		      break;
 		  };
 		break;
+	    case RL2_COMPRESSION_DEFLATE_FP:
+		switch (tile_sz)
+		  {
+		  case TILE_256:
+		      coverage = "grid_dbl_deflatefp_256";
+		      break;
+		  };
+		break;
+	    case RL2_COMPRESSION_LZMA_FP:
+		switch (tile_sz)
+		  {
+		  case TILE_256:
+		      coverage = "grid_dbl_lzmafp_256";
+		      break;
+		  };
+		break;
+	    case RL2_COMPRESSION_ZSTD_FP:
+		switch (tile_sz)
+		  {
+		  case TILE_256:
+		      coverage = "grid_dbl_zstdfp_256";
+		      break;
+		  };
+		break;
 	    };
 	  break;
       };
@@ -2102,6 +2707,24 @@ main (int argc, char *argv[])
 	return ret;
 #endif /* end LZMA conditional */
 
+#ifndef OMIT_ZSTD		/* only if ZSTD is enabled */
+    ret = -310;
+    if (!test_coverage
+	(db_handle, RL2_SAMPLE_INT16, RL2_COMPRESSION_ZSTD, TILE_256, &ret))
+	return ret;
+#endif /* end ZSTD conditional */
+
+#ifndef OMIT_LZ4		/* only if LZ4 is enabled */
+    ret = -311;
+    if (!test_coverage
+	(db_handle, RL2_SAMPLE_INT16, RL2_COMPRESSION_LZ4, TILE_256, &ret))
+	return ret;
+    ret = -312;
+    if (!test_coverage
+	(db_handle, RL2_SAMPLE_INT16, RL2_COMPRESSION_LZ4_NO, TILE_256, &ret))
+	return ret;
+#endif /* end LZ4 conditional */
+
 /* UINT16 tests */
     ret = -150;
     if (!test_coverage
@@ -2220,6 +2843,28 @@ main (int argc, char *argv[])
 	return ret;
 #endif /* end LZMA conditional */
 
+    ret = -925;
+    if (!test_coverage
+	(db_handle, RL2_SAMPLE_FLOAT, RL2_COMPRESSION_DEFLATE_FP, TILE_256,
+	 &ret))
+	return ret;
+
+#ifndef OMIT_LZMA		/* only if LZMA is enabled */
+    ret = -926;
+    if (!test_coverage
+	(db_handle, RL2_SAMPLE_FLOAT, RL2_COMPRESSION_LZMA_FP, TILE_256,
+	 &ret))
+	return ret;
+#endif /* end LZMA conditional */
+
+#ifndef OMIT_ZSTD		/* only if ZSTD is enabled */
+    ret = -927;
+    if (!test_coverage
+	(db_handle, RL2_SAMPLE_FLOAT, RL2_COMPRESSION_ZSTD_FP, TILE_256,
+	 &ret))
+	return ret;
+#endif /* end ZSTD conditional */
+
 /* INT8 tests */
     ret = -750;
     if (!test_coverage
@@ -2279,6 +2924,28 @@ main (int argc, char *argv[])
 	return ret;
 #endif /* end LZMA conditional */
 
+    ret = -1225;
+    if (!test_coverage
+	(db_handle, RL2_SAMPLE_DOUBLE, RL2_COMPRESSION_DEFLATE_FP, TILE_256,
+	 &ret))
+	return ret;
+
+#ifndef OMIT_LZMA		/* only if LZMA is enabled */
+    ret = -1226;
+    if (!test_coverage
+	(db_handle, RL2_SAMPLE_DOUBLE, RL2_COMPRESSION_LZMA_FP, TILE_256,
+	 &ret))
+	return ret;
+#endif /* end LZMA conditional */
+
+#ifndef OMIT_ZSTD		/* only if ZSTD is enabled */
+    ret = -1227;
+    if (!test_coverage
+	(db_handle, RL2_SAMPLE_DOUBLE, RL2_COMPRESSION_ZSTD_FP, TILE_256,
+	 &ret))
+	return ret;
+#endif /* end ZSTD conditional */
+
 /* UINT8 tests */
     ret = -1050;
     if (!test_coverage
@@ -2327,6 +2994,27 @@ main (int argc, char *argv[])
     ret = -350;
     if (!test_pixel_double (db_handle, &ret))
 	return ret;
+    ret = -360;
+    if (!test_pixels_by_points (db_handle, &ret))
+	return ret;
+    ret = -365;
+    if (!test_statement_cache (db_handle, &ret))
+	return ret;
+    ret = -366;
+    if (!test_tile_grid_index (db_handle, &ret))
+	return ret;
+    ret = -367;
+    if (!test_split_tiles (db_handle, &ret))
+	return ret;
+
+#ifndef OMIT_LZ4		/* only if LZ4 is enabled */
+    ret = -368;
+    if (!test_lz4_read_back (db_handle, &ret))
+	return ret;
+#endif /* end LZ4 conditional */
+    ret = -369;
+    if (!test_fp_read_back (db_handle, &ret))
+	return ret;
 
 /* dropping all SRTM INT16 Coverages */
     ret = -130;
@@ -2357,6 +3045,24 @@ main (int argc, char *argv[])
 	return ret;
 #endif /* end LZMA conditional */
 
+#ifndef OMIT_ZSTD		/* only if ZSTD is enabled */
+    ret = -315;
+    if (!drop_coverage
+	(db_handle, RL2_SAMPLE_INT16, RL2_COMPRESSION_ZSTD, TILE_256, &ret))
+	return ret;
+#endif /* end ZSTD conditional */
+
+#ifndef OMIT_LZ4		/* only if LZ4 is enabled */
+    ret = -316;
+    if (!drop_coverage
+	(db_handle, RL2_SAMPLE_INT16, RL2_COMPRESSION_LZ4, TILE_256, &ret))
+	return ret;
+    ret = -317;
+    if (!drop_coverage
+	(db_handle, RL2_SAMPLE_INT16, RL2_COMPRESSION_LZ4_NO, TILE_256, &ret))
+	return ret;
+#endif /* end LZ4 conditional */
+
 /* dropping all SRTM UINT16 Coverages */
     ret = -180;
     if (!drop_coverage
@@ -2475,6 +3181,28 @@ main (int argc, char *argv[])
 	return ret;
 #endif /* end LZMA conditional */
 
+    ret = -955;
+    if (!drop_coverage
+	(db_handle, RL2_SAMPLE_FLOAT, RL2_COMPRESSION_DEFLATE_FP, TILE_256,
+	 &ret))
+	return ret;
+
+#ifndef OMIT_LZMA		/* only if LZMA is enabled */
+    ret = -956;
+    if (!drop_coverage
+	(db_handle, RL2_SAMPLE_FLOAT, RL2_COMPRESSION_LZMA_FP, TILE_256,
+	 &ret))
+	return ret;
+#endif /* end LZMA conditional */
+
+#ifndef OMIT_ZSTD		/* only if ZSTD is enabled */
+    ret = -957;
+    if (!drop_coverage
+	(db_handle, RL2_SAMPLE_FLOAT, RL2_COMPRESSION_ZSTD_FP, TILE_256,
+	 &ret))
+	return ret;
+#endif /* end ZSTD conditional */
+
 /* dropping all INT8 Coverages */
     ret = -780;
     if (!drop_coverage
@@ -2534,6 +3262,28 @@ main (int argc, char *argv[])
 	return ret;
 #endif /* end LZMA conditional */
 
+    ret = -1245;
+    if (!drop_coverage
+	(db_handle, RL2_SAMPLE_DOUBLE, RL2_COMPRESSION_DEFLATE_FP, TILE_256,
+	 &ret))
+	return ret;
+
+#ifndef OMIT_LZMA		/* only if LZMA is enabled */
+    ret = -1246;
+    if (!drop_coverage
+	(db_handle, RL2_SAMPLE_DOUBLE, RL2_COMPRESSION_LZMA_FP, TILE_256,
+	 &ret))
+	return ret;
+#endif /* end LZMA conditional */
+
+#ifndef OMIT_ZSTD		/* only if ZSTD is enabled */
+    ret = -1247;
+    if (!drop_coverage
+	(db_handle, RL2_SAMPLE_DOUBLE, RL2_COMPRESSION_ZSTD_FP, TILE_256,
+	 &ret))
+	return ret;
+#endif /* end ZSTD conditional */
+
 /* dropping all UINT8 Coverages */
     ret = -1030;
     if (!drop_coverage
@@ -1448,6 +1448,251 @@ test_grid (sqlite3 * sqlite, unsigned char sample, int *retcode)
     return 0;
 }
 
+static rl2RasterPtr
+load_pyramid_tile (sqlite3 * sqlite, const char *coverage, int level)
+{
+/* decoding the first Pyramid tile of some level */
+    int ret;
+    char *sql;
+    char *xtiles;
+    char *xdata;
+    sqlite3_stmt *stmt = NULL;
+    rl2RasterPtr raster = NULL;
+
+    xtiles = sqlite3_mprintf ("%s_tiles", coverage);
+    xdata = sqlite3_mprintf ("%s_tile_data", coverage);
+    sql =
+	sqlite3_mprintf
+	("SELECT d.tile_data_odd, d.tile_data_even FROM \"%w\" AS t "
+	 "JOIN \"%w\" AS d ON (d.tile_id = t.tile_id) "
+	 "WHERE t.pyramid_level = %d ORDER BY t.tile_id LIMIT 1", xtiles,
+	 xdata, level);
+    sqlite3_free (xtiles);
+    sqlite3_free (xdata);
+    ret = sqlite3_prepare_v2 (sqlite, sql, strlen (sql), &stmt, NULL);
+    sqlite3_free (sql);
+    if (ret != SQLITE_OK)
+	return NULL;
+    ret = sqlite3_step (stmt);
+    if (ret == SQLITE_ROW && sqlite3_column_type (stmt, 0) == SQLITE_BLOB)
+      {
+	  const unsigned char *blob_odd = sqlite3_column_blob (stmt, 0);
+	  int blob_odd_sz = sqlite3_column_bytes (stmt, 0);
+	  const unsigned char *blob_even = NULL;
+	  int blob_even_sz = 0;
+	  if (sqlite3_column_type (stmt, 1) == SQLITE_BLOB)
+	    {
+		blob_even = sqlite3_column_blob (stmt, 1);
+		blob_even_sz = sqlite3_column_bytes (stmt, 1);
+	    }
+	  raster =
+	      rl2_raster_decode (RL2_SCALE_1, blob_odd, blob_odd_sz, blob_even,
+				 blob_even_sz, NULL);
+      }
+    sqlite3_finalize (stmt);
+    return raster;
+}
+
+static int
+check_pyramid_values (rl2RasterPtr raster, unsigned char pixel_type,
+		      unsigned char num_bands, unsigned int width,
+		      unsigned int height)
+{
+/* checking the Pyramid pixels against the expected block averages */
+    unsigned int x;
+    unsigned int y;
+    int ib;
+    int ok = 1;
+    unsigned short value;
+    unsigned short expected;
+    rl2PixelPtr pxl =
+	rl2_create_pixel (RL2_SAMPLE_UINT16, pixel_type, num_bands);
+    if (pxl == NULL)
+	return 0;
+    for (y = 0; y < height && ok; y++)
+      {
+	  for (x = 0; x < width && ok; x++)
+	    {
+		if (rl2_get_raster_pixel (raster, pxl, y, x) != RL2_OK)
+		  {
+		      ok = 0;
+		      break;
+		  }
+		for (ib = 0; ib < num_bands; ib++)
+		  {
+		      if (pixel_type == RL2_PIXEL_DATAGRID)
+			  expected = 3542 + (100 * ((x + y) % 5));
+		      else
+			  expected = 1050 + (500 * ib) + (10 * ((x + y) % 7));
+		      if (rl2_get_pixel_sample_uint16 (pxl, ib, &value) !=
+			  RL2_OK)
+			  ok = 0;
+		      else if (value != expected)
+			{
+			    fprintf (stderr,
+				     "Unexpected Pyramid pixel %u,%u band %d: %u (expected %u)\n",
+				     x, y, ib, value, expected);
+			    ok = 0;
+			}
+		  }
+	    }
+      }
+    rl2_destroy_pixel (pxl);
+    return ok;
+}
+
+static int
+test_pyramid (sqlite3 * sqlite, unsigned char pixel_type, int *retcode)
+{
+/* 
+/ testing the Pyramid averages against known values:
+/ a UINT16 DataGrid (Section Pyramid, 8x8 blocks) and
+/ a UINT16 MultiBand (Monolithic Pyramid, 2x2 blocks)
+*/
+    int ret;
+    char *sql;
+    sqlite3_stmt *stmt = NULL;
+    const char *coverage;
+    const char *pixel_name;
+    unsigned char num_bands;
+    unsigned int width = 512;
+    unsigned int height = 512;
+    unsigned int x;
+    unsigned int y;
+    int ib;
+    unsigned short *buf = NULL;
+    unsigned short *p;
+    int buf_sz;
+    int ok = -1;
+    rl2RasterPtr raster = NULL;
+
+    if (pixel_type == RL2_PIXEL_DATAGRID)
+      {
+	  coverage = "pyr_grid_u16";
+	  pixel_name = "DATAGRID";
+	  num_bands = 1;
+      }
+    else
+      {
+	  coverage = "pyr_mb_u16";
+	  pixel_name = "MULTIBAND";
+	  num_bands = 3;
+      }
+
+/* creating the DBMS Coverage */
+    sql = sqlite3_mprintf ("SELECT RL2_CreateRasterCoverage("
+			   "%Q, %Q, %Q, %d, %Q, %d, %d, %d, %d, %1.8f, %1.8f)",
+			   coverage, "UINT16", pixel_name, num_bands, "NONE",
+			   100, 512, 512, 4326, 0.01, 0.01);
+    ret = execute_check (sqlite, sql);
+    sqlite3_free (sql);
+    if (ret != SQLITE_OK)
+      {
+	  fprintf (stderr, "CreateRasterCoverage \"%s\" error\n", coverage);
+	  *retcode += -1;
+	  return 0;
+      }
+
+/* preparing the RAW pixel buffer: every block average is an integer */
+    buf_sz = width * height * num_bands * sizeof (unsigned short);
+    buf = malloc (buf_sz);
+    p = buf;
+    for (y = 0; y < height; y++)
+      {
+	  for (x = 0; x < width; x++)
+	    {
+		for (ib = 0; ib < num_bands; ib++)
+		  {
+		      if (pixel_type == RL2_PIXEL_DATAGRID)
+			  *p++ =
+			      7 + (1000 * (x % 8)) + (10 * (y % 8)) +
+			      (100 * (((x / 8) + (y / 8)) % 5));
+		      else
+			  *p++ =
+			      400 + (500 * ib) + (1000 * (x % 2)) +
+			      (300 * (y % 2)) +
+			      (10 * (((x / 2) + (y / 2)) % 7));
+		  }
+	    }
+      }
+
+/* Inserting RAW pixels */
+    sql = sqlite3_mprintf ("SELECT RL2_ImportSectionRawPixels("
+			   "%Q, %Q, %d, %d, ?, BuildMbr(0, 0, 5.12, 5.12, %d), %d, 1, %d)",
+			   coverage, "pyramid", width, height, 4326,
+			   (pixel_type == RL2_PIXEL_DATAGRID) ? 1 : 0,
+			   is_big_endian_cpu ());
+    ret = sqlite3_prepare_v2 (sqlite, sql, strlen (sql), &stmt, NULL);
+    sqlite3_free (sql);
+    if (ret != SQLITE_OK)
+      {
+	  fprintf (stderr, "Import RAW \"%s\" error: %s\n", coverage,
+		   sqlite3_errmsg (sqlite));
+	  *retcode += -2;
+	  goto error;
+      }
+    sqlite3_bind_blob (stmt, 1, buf, buf_sz, SQLITE_STATIC);
+    ret = sqlite3_step (stmt);
+    if (ret == SQLITE_ROW)
+	ok = sqlite3_column_int (stmt, 0);
+    sqlite3_finalize (stmt);
+    stmt = NULL;
+    if (ok <= 0)
+      {
+	  fprintf (stderr, "Import RAW \"%s\" failure\n", coverage);
+	  *retcode += -3;
+	  goto error;
+      }
+    free (buf);
+    buf = NULL;
+
+    if (pixel_type != RL2_PIXEL_DATAGRID)
+      {
+	  /* building a Monolithic Pyramid (one physical level each 2x) */
+	  sql =
+	      sqlite3_mprintf ("SELECT RL2_PyramidizeMonolithic(%Q, 1, 1)",
+			       coverage);
+	  ret = execute_check (sqlite, sql);
+	  sqlite3_free (sql);
+	  if (ret != SQLITE_OK)
+	    {
+		fprintf (stderr, "PyramidizeMonolithic \"%s\" error\n",
+			 coverage);
+		*retcode += -4;
+		goto error;
+	    }
+      }
+
+/* checking the first Pyramid level */
+    raster = load_pyramid_tile (sqlite, coverage, 1);
+    if (raster == NULL)
+      {
+	  fprintf (stderr, "Unable to decode the Pyramid tile \"%s\"\n",
+		   coverage);
+	  *retcode += -5;
+	  goto error;
+      }
+    if (pixel_type == RL2_PIXEL_DATAGRID)
+	ok = check_pyramid_values (raster, pixel_type, num_bands, 64, 64);
+    else
+	ok = check_pyramid_values (raster, pixel_type, num_bands, 256, 256);
+    rl2_destroy_raster (raster);
+    if (!ok)
+      {
+	  fprintf (stderr, "Mismatching Pyramid values \"%s\"\n", coverage);
+	  *retcode += -6;
+	  return 0;
+      }
+    return 1;
+
+  error:
+    if (stmt != NULL)
+	sqlite3_finalize (stmt);
+    if (buf != NULL)
+	free (buf);
+    return 0;
+}
+
 int
 main (int argc, char *argv[])
 {
@@ -1517,6 +1762,14 @@ main (int argc, char *argv[])
     if (!test_grid (db_handle, RL2_SAMPLE_DOUBLE, &ret))
 	return ret;
 
+/* Pyramid averages tests */
+    ret = -900;
+    if (!test_pyramid (db_handle, RL2_PIXEL_DATAGRID, &ret))
+	return ret;
+    ret = -1000;
+    if (!test_pyramid (db_handle, RL2_PIXEL_MULTIBAND, &ret))
+	return ret;
+
 /* closing the DB */
     sqlite3_close (db_handle);
     spatialite_cleanup_ex (cache);
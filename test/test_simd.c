@@ -0,0 +1,892 @@
+/*
+
+ test_simd.c -- RasterLite-2 Test Case
+
+ Author: Sandro Furieri <a.furieri@lqt.it>
+
+ ------------------------------------------------------------------------------
+ 
+ Version: MPL 1.1/GPL 2.0/LGPL 2.1
+ 
+ The contents of this file are subject to the Mozilla Public License Version
+ 1.1 (the "License"); you may not use this file except in compliance with
+ the License. You may obtain a copy of the License at
+ http://www.mozilla.org/MPL/
+ 
+Software distributed under the License is distributed on an "AS IS" basis,
+WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+for the specific language governing rights and limitations under the
+License.
+
+The Original Code is the RasterLite2 library
+
+The Initial Developer of the Original Code is Alessandro Furieri
+ 
+Portions created by the Initial Developer are Copyright (C) 2013
+the Initial Developer. All Rights Reserved.
+
+Contributor(s):
+
+Alternatively, the contents of this file may be used under the terms of
+either the GNU General Public License Version 2 or later (the "GPL"), or
+the GNU Lesser General Public License Version 2.1 or later (the "LGPL"),
+in which case the provisions of the GPL or the LGPL are applicable instead
+of those above. If you wish to allow use of your version of this file only
+under the terms of either the GPL or the LGPL, and not to allow others to
+use your version of this file under the terms of the MPL, indicate your
+decision by deleting the provisions above and replace them with the notice
+and other provisions required by the GPL or the LGPL. If you do not delete
+the provisions above, a recipient may use your version of this file under
+the terms of any one of the MPL, the GPL or the LGPL.
+ 
+*/
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+
+#include "config.h"
+
+#include "rasterlite2/rasterlite2.h"
+
+/*
+/ checks the odd/even reassembly and the byte swapping performed by
+/ rl2_raster_encode / rl2_raster_decode on every DATAGRID sample type,
+/ the packing / unpacking of 1, 2 and 4-BIT pixels, as well as the
+/ Tile statistics computed by rl2_build_raster_statistics and the
+/ ByteShuffle used by the LZ4 and FloatPredictor codecs, always
+/ checking the scalar and SIMD code paths against each other.
+/
+/ the timings of both code paths are printed only when the environment
+/ variable "RL2_SIMD_BENCHMARK" is set, its value being the number of
+/ iterations (default: 200); e.g. "RL2_SIMD_BENCHMARK=500 ./test_simd"
+*/
+
+#define TILE_WIDTH	512
+#define TILE_HEIGHT	512
+
+/* global variable enabling the timings (benchmark mode) */
+int benchmark = 0;
+
+struct sample_def
+{
+    unsigned char sample_type;
+    const char *name;
+    int pixel_size;
+};
+
+static const struct sample_def samples[] = {
+    {RL2_SAMPLE_INT8, "INT8", 1},
+    {RL2_SAMPLE_UINT8, "UINT8", 1},
+    {RL2_SAMPLE_INT16, "INT16", 2},
+    {RL2_SAMPLE_UINT16, "UINT16", 2},
+    {RL2_SAMPLE_INT32, "INT32", 4},
+    {RL2_SAMPLE_UINT32, "UINT32", 4},
+    {RL2_SAMPLE_FLOAT, "FLOAT", 4},
+    {RL2_SAMPLE_DOUBLE, "DOUBLE", 8},
+    {0, NULL, 0}
+};
+
+static int
+is_little_endian_cpu ()
+{
+/* checking if the target CPU is little-endian */
+    union cvt
+    {
+	unsigned char byte[4];
+	int int_value;
+    } convert;
+    convert.int_value = 1;
+    if (convert.byte[0] == 0)
+	return 0;
+    return 1;
+}
+
+static int
+scale_step (int scale)
+{
+/* returning the pixel step corresponding to some scale */
+    switch (scale)
+      {
+      case RL2_SCALE_2:
+	  return 2;
+      case RL2_SCALE_4:
+	  return 4;
+      case RL2_SCALE_8:
+	  return 8;
+      };
+    return 1;
+}
+
+static int
+get_raster_data (rl2RasterPtr raster, unsigned char sample_type,
+		 unsigned char **buffer, int *buf_size)
+{
+/* exporting the raster data whatever is the sample type */
+    switch (sample_type)
+      {
+      case RL2_SAMPLE_INT8:
+	  return rl2_raster_data_to_int8 (raster, (char **) buffer, buf_size);
+      case RL2_SAMPLE_UINT8:
+	  return rl2_raster_data_to_uint8 (raster, buffer, buf_size);
+      case RL2_SAMPLE_INT16:
+	  return rl2_raster_data_to_int16 (raster, (short **) buffer,
+					   buf_size);
+      case RL2_SAMPLE_UINT16:
+	  return rl2_raster_data_to_uint16 (raster,
+					    (unsigned short **) buffer,
+					    buf_size);
+      case RL2_SAMPLE_INT32:
+	  return rl2_raster_data_to_int32 (raster, (int **) buffer, buf_size);
+      case RL2_SAMPLE_UINT32:
+	  return rl2_raster_data_to_uint32 (raster, (unsigned int **) buffer,
+					    buf_size);
+      case RL2_SAMPLE_FLOAT:
+	  return rl2_raster_data_to_float (raster, (float **) buffer,
+					   buf_size);
+      case RL2_SAMPLE_DOUBLE:
+	  return rl2_raster_data_to_double (raster, (double **) buffer,
+					    buf_size);
+      };
+    return RL2_ERROR;
+}
+
+static rl2RasterPtr
+build_raster (const struct sample_def *def, unsigned char **reference)
+{
+/* creating a DATAGRID raster filled by a recognizable pattern */
+    rl2RasterPtr raster;
+    unsigned char *bufpix;
+    int bufpix_size = TILE_WIDTH * TILE_HEIGHT * def->pixel_size;
+    int i;
+
+    bufpix = malloc (bufpix_size);
+    *reference = malloc (bufpix_size);
+    if (bufpix == NULL || *reference == NULL)
+	return NULL;
+    srand (def->sample_type);
+    for (i = 0; i < bufpix_size; i++)
+	bufpix[i] = rand () & 0x3f;	/* no NaN or INF for FLOAT/DOUBLE */
+    memcpy (*reference, bufpix, bufpix_size);
+    raster = rl2_create_raster (TILE_WIDTH, TILE_HEIGHT, def->sample_type,
+				RL2_PIXEL_DATAGRID, 1, bufpix, bufpix_size,
+				NULL, NULL, 0, NULL);
+    if (raster == NULL)
+	free (bufpix);
+    return raster;
+}
+
+static int
+check_decoded (const struct sample_def *def, int scale,
+	       const unsigned char *reference, rl2RasterPtr raster)
+{
+/* checking the decoded pixels against the reference ones */
+    unsigned char *buffer;
+    int buf_size;
+    unsigned int width;
+    unsigned int height;
+    unsigned int row;
+    unsigned int col;
+    int step = scale_step (scale);
+    int ps = def->pixel_size;
+    const unsigned char *p_in;
+    const unsigned char *p_out;
+
+    if (rl2_get_raster_size (raster, &width, &height) != RL2_OK)
+	return 0;
+    if (width != (TILE_WIDTH + step - 1) / step
+	|| height != (TILE_HEIGHT + step - 1) / step)
+	return 0;
+    if (get_raster_data (raster, def->sample_type, &buffer, &buf_size) !=
+	RL2_OK)
+	return 0;
+    for (row = 0; row < height; row++)
+      {
+	  for (col = 0; col < width; col++)
+	    {
+		p_in =
+		    reference + ((row * step * TILE_WIDTH) + (col * step)) * ps;
+		p_out = buffer + ((row * width) + col) * ps;
+		if (memcmp (p_in, p_out, ps) != 0)
+		  {
+		      rl2_free (buffer);
+		      return 0;
+		  }
+	    }
+      }
+    rl2_free (buffer);
+    return 1;
+}
+
+static int
+decode_loop (const struct sample_def *def, int scale,
+	     const unsigned char *reference, unsigned char *blob_odd,
+	     int blob_odd_sz, unsigned char *blob_even, int blob_even_sz,
+	     int iterations, double *elapsed)
+{
+/* decoding the same tile many times */
+    rl2RasterPtr raster;
+    clock_t t0;
+    int i;
+
+    t0 = clock ();
+    for (i = 0; i < iterations; i++)
+      {
+	  raster =
+	      rl2_raster_decode (scale, blob_odd, blob_odd_sz, blob_even,
+				 blob_even_sz, NULL);
+	  if (raster == NULL)
+	      return 0;
+	  if (i == 0)
+	    {
+		if (!check_decoded (def, scale, reference, raster))
+		  {
+		      rl2_destroy_raster (raster);
+		      return 0;
+		  }
+	    }
+	  rl2_destroy_raster (raster);
+      }
+    *elapsed = (double) (clock () - t0) * 1000.0 / (double) CLOCKS_PER_SEC;
+    return 1;
+}
+
+static int
+encode_loop (rl2RasterPtr raster, int little_endian, int iterations,
+	     unsigned char **blob_odd, int *blob_odd_sz,
+	     unsigned char **blob_even, int *blob_even_sz, double *elapsed)
+{
+/* encoding the same tile many times */
+    clock_t t0;
+    int i;
+
+    *blob_odd = NULL;
+    *blob_even = NULL;
+    t0 = clock ();
+    for (i = 0; i < iterations; i++)
+      {
+	  if (*blob_odd != NULL)
+	      free (*blob_odd);
+	  if (*blob_even != NULL)
+	      free (*blob_even);
+	  if (rl2_raster_encode
+	      (raster, RL2_COMPRESSION_NONE, blob_odd, blob_odd_sz, blob_even,
+	       blob_even_sz, 100, little_endian) != RL2_OK)
+	      return 0;
+      }
+    *elapsed = (double) (clock () - t0) * 1000.0 / (double) CLOCKS_PER_SEC;
+    return 1;
+}
+
+static double
+reference_value (const struct sample_def *def,
+		 const unsigned char *reference, int i)
+{
+/* returning the Nth reference sample as a double */
+    char int8;
+    short int16;
+    unsigned short uint16;
+    int int32;
+    unsigned int uint32;
+    float flt;
+    double dbl;
+    const unsigned char *p = reference + (i * def->pixel_size);
+    switch (def->sample_type)
+      {
+      case RL2_SAMPLE_INT8:
+	  memcpy (&int8, p, 1);
+	  return int8;
+      case RL2_SAMPLE_INT16:
+	  memcpy (&int16, p, 2);
+	  return int16;
+      case RL2_SAMPLE_UINT16:
+	  memcpy (&uint16, p, 2);
+	  return uint16;
+      case RL2_SAMPLE_INT32:
+	  memcpy (&int32, p, 4);
+	  return int32;
+      case RL2_SAMPLE_UINT32:
+	  memcpy (&uint32, p, 4);
+	  return uint32;
+      case RL2_SAMPLE_FLOAT:
+	  memcpy (&flt, p, 4);
+	  return flt;
+      case RL2_SAMPLE_DOUBLE:
+	  memcpy (&dbl, p, 8);
+	  return dbl;
+      };
+    return *p;
+}
+
+static int
+check_statistics (const struct sample_def *def, rl2RasterPtr raster,
+		  const unsigned char *reference, int iterations)
+{
+/* checking and timing the Tile statistics */
+    rl2RasterStatisticsPtr stats;
+    int count = TILE_WIDTH * TILE_HEIGHT;
+    double ref_min = reference_value (def, reference, 0);
+    double ref_max = ref_min;
+    double ref_mean = 0.0;
+    double ref_variance = 0.0;
+    double min;
+    double max;
+    double mean;
+    double variance;
+    double stddev;
+    double elapsed[2];
+    clock_t t0;
+    int simd;
+    int i;
+
+    for (i = 0; i < count; i++)
+      {
+	  double value = reference_value (def, reference, i);
+	  if (value < ref_min)
+	      ref_min = value;
+	  if (value > ref_max)
+	      ref_max = value;
+	  ref_mean += value;
+      }
+    ref_mean /= (double) count;
+    for (i = 0; i < count; i++)
+      {
+	  double value = reference_value (def, reference, i) - ref_mean;
+	  ref_variance += value * value;
+      }
+    ref_variance /= (double) (count - 1);
+
+    for (simd = 0; simd < 2; simd++)
+      {
+	  rl2_enable_simd (simd);
+	  t0 = clock ();
+	  for (i = 0; i < iterations; i++)
+	    {
+		stats = rl2_build_raster_statistics (raster, NULL);
+		if (stats == NULL)
+		    return 0;
+		if (i < iterations - 1)
+		    rl2_destroy_raster_statistics (stats);
+	    }
+	  elapsed[simd] =
+	      (double) (clock () - t0) * 1000.0 / (double) CLOCKS_PER_SEC;
+	  if (rl2_get_band_statistics
+	      (stats, 0, &min, &max, &mean, &variance, &stddev) != RL2_OK)
+	    {
+		rl2_destroy_raster_statistics (stats);
+		return 0;
+	    }
+	  rl2_destroy_raster_statistics (stats);
+	  if (min != ref_min || max != ref_max)
+	    {
+		fprintf (stderr, "%s stats: unexpected min/max %f/%f [simd=%d]\n",
+			 def->name, min, max, simd);
+		return 0;
+	    }
+	  if (fabs (mean - ref_mean) > fabs (ref_mean) * 1e-9)
+	    {
+		fprintf (stderr, "%s stats: unexpected mean %f (%f) [simd=%d]\n",
+			 def->name, mean, ref_mean, simd);
+		return 0;
+	    }
+	  if (fabs (variance - ref_variance) > ref_variance * 1e-9)
+	    {
+		fprintf (stderr,
+			 "%s stats: unexpected variance %f (%f) [simd=%d]\n",
+			 def->name, variance, ref_variance, simd);
+		return 0;
+	    }
+      }
+    if (benchmark)
+	fprintf (stderr, "%-7s native   stats      %9.2f ms %9.2f ms\n",
+		 def->name, elapsed[0], elapsed[1]);
+    return 1;
+}
+
+static int
+test_sample (const struct sample_def *def, int iterations)
+{
+/* testing and timing a single sample type */
+    rl2RasterPtr raster;
+    unsigned char *reference = NULL;
+    unsigned char *blob_odd;
+    unsigned char *blob_even;
+    int blob_odd_sz;
+    int blob_even_sz;
+    int endian;
+    int little_endian;
+    int simd;
+    int s;
+    double elapsed[2];
+    int scales[] = { RL2_SCALE_1, RL2_SCALE_2, RL2_SCALE_4, RL2_SCALE_8 };
+    int ret = 0;
+
+    raster = build_raster (def, &reference);
+    if (raster == NULL)
+      {
+	  fprintf (stderr, "Unable to create a %s raster\n", def->name);
+	  return -1;
+      }
+
+    if (!check_statistics (def, raster, reference, iterations))
+      {
+	  ret = -4;
+	  goto end;
+      }
+
+    for (endian = 0; endian < 2; endian++)
+      {
+	  /* native byte order first, then the swapped one */
+	  little_endian = is_little_endian_cpu ();
+	  if (endian)
+	      little_endian = !little_endian;
+
+	  for (simd = 0; simd < 2; simd++)
+	    {
+		rl2_enable_simd (simd);
+		if (!encode_loop
+		    (raster, little_endian, iterations, &blob_odd,
+		     &blob_odd_sz, &blob_even, &blob_even_sz, &elapsed[simd]))
+		  {
+		      fprintf (stderr, "Unable to encode %s (%s)\n",
+			       def->name, endian ? "swapped" : "native");
+		      ret = -2;
+		      goto end;
+		  }
+		if (simd == 0)
+		  {
+		      free (blob_odd);
+		      free (blob_even);
+		  }
+	    }
+	  if (benchmark)
+	      fprintf (stderr, "%-7s %-8s encode     %9.2f ms %9.2f ms\n",
+		       def->name, endian ? "swapped" : "native", elapsed[0],
+		       elapsed[1]);
+
+	  for (s = 0; s < 4; s++)
+	    {
+		for (simd = 0; simd < 2; simd++)
+		  {
+		      rl2_enable_simd (simd);
+		      if (!decode_loop
+			  (def, scales[s], reference, blob_odd, blob_odd_sz,
+			   blob_even, blob_even_sz, iterations,
+			   &elapsed[simd]))
+			{
+			    fprintf (stderr,
+				     "Unable to decode %s (%s) 1:%d [simd=%d]\n",
+				     def->name,
+				     endian ? "swapped" : "native",
+				     scale_step (scales[s]), simd);
+			    free (blob_odd);
+			    free (blob_even);
+			    ret = -3;
+			    goto end;
+			}
+		  }
+		if (benchmark)
+		    fprintf (stderr,
+			     "%-7s %-8s decode 1:%d %9.2f ms %9.2f ms\n",
+			     def->name, endian ? "swapped" : "native",
+			     scale_step (scales[s]), elapsed[0], elapsed[1]);
+	    }
+	  free (blob_odd);
+	  free (blob_even);
+      }
+
+  end:
+    rl2_destroy_raster (raster);
+    free (reference);
+    rl2_enable_simd (1);
+    return ret;
+}
+
+struct packed_def
+{
+    unsigned char sample_type;
+    unsigned char pixel_type;
+    const char *name;
+    int bits;
+};
+
+static const struct packed_def packed_samples[] = {
+    {RL2_SAMPLE_1_BIT, RL2_PIXEL_MONOCHROME, "1-BIT", 1},
+    {RL2_SAMPLE_2_BIT, RL2_PIXEL_PALETTE, "2-BIT", 2},
+    {RL2_SAMPLE_4_BIT, RL2_PIXEL_PALETTE, "4-BIT", 4},
+    {0, 0, NULL, 0}
+};
+
+#define PACKED_WIDTH	(TILE_WIDTH - 3)	/* not a multiple of 8 */
+
+static int
+get_packed_data (rl2RasterPtr raster, int bits, unsigned char **buffer,
+		 int *buf_size)
+{
+/* exporting the packed raster data (one byte per pixel) */
+    switch (bits)
+      {
+      case 1:
+	  return rl2_raster_data_to_1bit (raster, buffer, buf_size);
+      case 2:
+	  return rl2_raster_data_to_2bit (raster, buffer, buf_size);
+      case 4:
+	  return rl2_raster_data_to_4bit (raster, buffer, buf_size);
+      };
+    return RL2_ERROR;
+}
+
+static int
+test_packed (const struct packed_def *def, int iterations)
+{
+/* testing and timing a single packed 1, 2 or 4-BIT sample type */
+    rl2RasterPtr raster;
+    rl2RasterPtr decoded;
+    rl2PalettePtr palette = NULL;
+    unsigned char *bufpix;
+    unsigned char *reference = NULL;
+    unsigned char *buffer;
+    int buf_size;
+    int bufpix_size = PACKED_WIDTH * TILE_HEIGHT;
+    unsigned char *blob_odd = NULL;
+    unsigned char *blob_even = NULL;
+    int blob_odd_sz;
+    int blob_even_sz;
+    int max = 1 << def->bits;
+    int simd;
+    int i;
+    clock_t t0;
+    double encoded[2];
+    double elapsed[2];
+    int ret = 0;
+
+    bufpix = malloc (bufpix_size);
+    reference = malloc (bufpix_size);
+    if (bufpix == NULL || reference == NULL)
+	return -1;
+    srand (def->bits);
+    for (i = 0; i < bufpix_size; i++)
+	bufpix[i] = rand () % max;
+    memcpy (reference, bufpix, bufpix_size);
+    if (def->pixel_type == RL2_PIXEL_PALETTE)
+      {
+	  palette = rl2_create_palette (max);
+	  for (i = 0; i < max; i++)
+	      rl2_set_palette_color (palette, i, i * 16, 255 - (i * 16), 128);
+      }
+    raster = rl2_create_raster (PACKED_WIDTH, TILE_HEIGHT, def->sample_type,
+				def->pixel_type, 1, bufpix, bufpix_size,
+				palette, NULL, 0, NULL);
+    if (raster == NULL)
+      {
+	  fprintf (stderr, "Unable to create a %s raster\n", def->name);
+	  free (bufpix);
+	  free (reference);
+	  return -1;
+      }
+
+    for (simd = 0; simd < 2; simd++)
+      {
+	  rl2_enable_simd (simd);
+	  t0 = clock ();
+	  for (i = 0; i < iterations; i++)
+	    {
+		if (blob_odd != NULL)
+		    free (blob_odd);
+		if (blob_even != NULL)
+		    free (blob_even);
+		if (rl2_raster_encode
+		    (raster, RL2_COMPRESSION_NONE, &blob_odd, &blob_odd_sz,
+		     &blob_even, &blob_even_sz, 100, 1) != RL2_OK)
+		  {
+		      fprintf (stderr, "Unable to encode %s\n", def->name);
+		      ret = -2;
+		      goto end;
+		  }
+	    }
+	  encoded[simd] =
+	      (double) (clock () - t0) * 1000.0 / (double) CLOCKS_PER_SEC;
+	  t0 = clock ();
+	  for (i = 0; i < iterations; i++)
+	    {
+		decoded =
+		    rl2_raster_decode (RL2_SCALE_1, blob_odd, blob_odd_sz,
+				       blob_even, blob_even_sz,
+				       rl2_clone_palette (palette));
+		if (decoded == NULL)
+		  {
+		      fprintf (stderr, "Unable to decode %s [simd=%d]\n",
+			       def->name, simd);
+		      ret = -3;
+		      goto end;
+		  }
+		if (i == 0)
+		  {
+		      buffer = NULL;
+		      if (get_packed_data
+			  (decoded, def->bits, &buffer, &buf_size) != RL2_OK
+			  || buf_size != bufpix_size
+			  || memcmp (buffer, reference, bufpix_size) != 0)
+			{
+			    fprintf (stderr,
+				     "Mismatching %s pixels [simd=%d]\n",
+				     def->name, simd);
+			    ret = -4;
+			}
+		      if (buffer != NULL)
+			  rl2_free (buffer);
+		  }
+		rl2_destroy_raster (decoded);
+		if (ret != 0)
+		    goto end;
+	    }
+	  elapsed[simd] =
+	      (double) (clock () - t0) * 1000.0 / (double) CLOCKS_PER_SEC;
+      }
+    if (benchmark)
+      {
+	  fprintf (stderr, "%-7s %-8s encode     %9.2f ms %9.2f ms\n",
+		   def->name, "packed", encoded[0], encoded[1]);
+	  fprintf (stderr, "%-7s %-8s decode 1:1 %9.2f ms %9.2f ms\n",
+		   def->name, "packed", elapsed[0], elapsed[1]);
+      }
+
+  end:
+    if (blob_odd != NULL)
+	free (blob_odd);
+    if (blob_even != NULL)
+	free (blob_even);
+    rl2_destroy_raster (raster);
+    free (reference);
+    rl2_enable_simd (1);
+    return ret;
+}
+
+struct shuffle_def
+{
+    unsigned char sample_type;
+    int pixel_size;
+    unsigned char compression;
+    const char *name;
+};
+
+static const struct shuffle_def shuffle_samples[] = {
+#ifndef OMIT_LZ4		/* only if LZ4 is enabled */
+    {RL2_SAMPLE_INT16, 2, RL2_COMPRESSION_LZ4, "INT16 LZ4"},
+    {RL2_SAMPLE_INT32, 4, RL2_COMPRESSION_LZ4, "INT32 LZ4"},
+    {RL2_SAMPLE_DOUBLE, 8, RL2_COMPRESSION_LZ4, "DOUBLE LZ4"},
+#endif /* end LZ4 conditional */
+    {RL2_SAMPLE_FLOAT, 4, RL2_COMPRESSION_DEFLATE_FP, "FLOAT DEFLATE_FP"},
+    {RL2_SAMPLE_DOUBLE, 8, RL2_COMPRESSION_DEFLATE_FP, "DOUBLE DEFLATE_FP"},
+    {0, 0, 0, NULL}
+};
+
+/* 
+/ an odd number of rows, so that the EVEN block always holds an odd
+/ number of pixels (never a multiple of the 16 items handled at once
+/ by the SSE2 ByteShuffle)
+*/
+#define SHUFFLE_HEIGHT	63
+
+static const unsigned int shuffle_widths[] = { 7, 37, 509, 0 };
+
+static void
+fill_smooth (unsigned char *buf, unsigned char sample_type,
+	     unsigned int width, unsigned int height)
+{
+/* filling a buffer by a smooth (and thus compressible) pattern */
+    unsigned int row;
+    unsigned int col;
+    short int16;
+    int int32;
+    float flt;
+    double dbl;
+    for (row = 0; row < height; row++)
+      {
+	  for (col = 0; col < width; col++)
+	    {
+		switch (sample_type)
+		  {
+		  case RL2_SAMPLE_INT16:
+		      int16 = (short) ((row * 3) + col);
+		      memcpy (buf, &int16, 2);
+		      buf += 2;
+		      break;
+		  case RL2_SAMPLE_INT32:
+		      int32 = (int) ((row * 1000) + (col * 7));
+		      memcpy (buf, &int32, 4);
+		      buf += 4;
+		      break;
+		  case RL2_SAMPLE_FLOAT:
+		      flt = 100.0 + (row * 0.5) + (col * 0.25);
+		      memcpy (buf, &flt, 4);
+		      buf += 4;
+		      break;
+		  case RL2_SAMPLE_DOUBLE:
+		      dbl = 100.0 + (row * 0.5) + (col * 0.125);
+		      memcpy (buf, &dbl, 8);
+		      buf += 8;
+		      break;
+		  };
+	    }
+      }
+}
+
+static int
+test_shuffle_tile (const struct shuffle_def *def, unsigned int width)
+{
+/* 
+/ encoding the same tile both with and without SIMD (the blocks must
+/ be exactly the same), then decoding it both ways
+*/
+    rl2RasterPtr raster;
+    rl2RasterPtr decoded;
+    unsigned char *bufpix;
+    unsigned char *reference = NULL;
+    unsigned char *buffer;
+    int buf_size;
+    int bufpix_size = width * SHUFFLE_HEIGHT * def->pixel_size;
+    unsigned char *blob_odd[2] = { NULL, NULL };
+    unsigned char *blob_even[2] = { NULL, NULL };
+    int blob_odd_sz[2];
+    int blob_even_sz[2];
+    int little_endian = is_little_endian_cpu ();
+    int simd;
+    int ret = 0;
+
+    bufpix = malloc (bufpix_size);
+    reference = malloc (bufpix_size);
+    if (bufpix == NULL || reference == NULL)
+	return -1;
+    fill_smooth (bufpix, def->sample_type, width, SHUFFLE_HEIGHT);
+    memcpy (reference, bufpix, bufpix_size);
+    raster = rl2_create_raster (width, SHUFFLE_HEIGHT, def->sample_type,
+				RL2_PIXEL_DATAGRID, 1, bufpix, bufpix_size,
+				NULL, NULL, 0, NULL);
+    if (raster == NULL)
+      {
+	  fprintf (stderr, "Unable to create a %s raster\n", def->name);
+	  free (bufpix);
+	  free (reference);
+	  return -1;
+      }
+
+    for (simd = 0; simd < 2; simd++)
+      {
+	  rl2_enable_simd (simd);
+	  if (rl2_raster_encode
+	      (raster, def->compression, &blob_odd[simd], &blob_odd_sz[simd],
+	       &blob_even[simd], &blob_even_sz[simd], 100,
+	       little_endian) != RL2_OK)
+	    {
+		fprintf (stderr, "Unable to encode %s %u [simd=%d]\n",
+			 def->name, width, simd);
+		ret = -2;
+		goto end;
+	    }
+      }
+    if (blob_odd_sz[0] != blob_odd_sz[1]
+	|| memcmp (blob_odd[0], blob_odd[1], blob_odd_sz[0]) != 0
+	|| blob_even_sz[0] != blob_even_sz[1]
+	|| memcmp (blob_even[0], blob_even[1], blob_even_sz[0]) != 0)
+      {
+	  fprintf (stderr, "Mismatching %s %u blocks (scalar vs SIMD)\n",
+		   def->name, width);
+	  ret = -3;
+	  goto end;
+      }
+
+    for (simd = 0; simd < 2; simd++)
+      {
+	  rl2_enable_simd (simd);
+	  decoded =
+	      rl2_raster_decode (RL2_SCALE_1, blob_odd[0], blob_odd_sz[0],
+				 blob_even[0], blob_even_sz[0], NULL);
+	  if (decoded == NULL)
+	    {
+		fprintf (stderr, "Unable to decode %s %u [simd=%d]\n",
+			 def->name, width, simd);
+		ret = -4;
+		goto end;
+	    }
+	  buffer = NULL;
+	  if (get_raster_data (decoded, def->sample_type, &buffer, &buf_size)
+	      != RL2_OK || buf_size != bufpix_size
+	      || memcmp (buffer, reference, bufpix_size) != 0)
+	    {
+		fprintf (stderr, "Mismatching %s %u pixels [simd=%d]\n",
+			 def->name, width, simd);
+		ret = -5;
+	    }
+	  if (buffer != NULL)
+	      rl2_free (buffer);
+	  rl2_destroy_raster (decoded);
+	  if (ret != 0)
+	      goto end;
+      }
+
+  end:
+    for (simd = 0; simd < 2; simd++)
+      {
+	  if (blob_odd[simd] != NULL)
+	      free (blob_odd[simd]);
+	  if (blob_even[simd] != NULL)
+	      free (blob_even[simd]);
+      }
+    rl2_destroy_raster (raster);
+    free (reference);
+    rl2_enable_simd (1);
+    return ret;
+}
+
+int
+main (int argc, char *argv[])
+{
+    int iterations = 1;
+    const char *env;
+    int i;
+    int ret;
+
+    if (argc > 1 || argv[0] == NULL)
+	argc = 1;		/* silencing stupid compiler warnings */
+
+    env = getenv ("RL2_SIMD_BENCHMARK");
+    if (env != NULL)
+      {
+	  /* benchmark mode: timing many iterations */
+	  benchmark = 1;
+	  iterations = atoi (env);
+	  if (iterations <= 0)
+	      iterations = 200;
+	  fprintf (stderr,
+		   "SIMD kernels: %s - %d iterations on %dx%d tiles\n",
+		   rl2_simd_kernels (), iterations, TILE_WIDTH, TILE_HEIGHT);
+	  fprintf (stderr,
+		   "                              scalar        SIMD\n");
+      }
+    for (i = 0; samples[i].name != NULL; i++)
+      {
+	  ret = test_sample (&(samples[i]), iterations);
+	  if (ret != 0)
+	      return ret - (i * 10);
+      }
+    for (i = 0; packed_samples[i].name != NULL; i++)
+      {
+	  ret = test_packed (&(packed_samples[i]), iterations);
+	  if (ret != 0)
+	      return ret - 100 - (i * 10);
+      }
+    for (i = 0; shuffle_samples[i].name != NULL; i++)
+      {
+	  int w;
+	  for (w = 0; shuffle_widths[w] != 0; w++)
+	    {
+		ret = test_shuffle_tile (&(shuffle_samples[i]),
+					 shuffle_widths[w]);
+		if (ret != 0)
+		    return ret - 200 - (i * 10);
+	    }
+      }
+    return 0;
+}
@@ -1392,6 +1392,8 @@ do_version ()
     fprintf (stderr, "libcurl ........: %s\n", rl2_curl_version ());
     fprintf (stderr, "DEFLATE ........: %s\n", rl2_zlib_version ());
     fprintf (stderr, "LZMA ...........: %s\n", rl2_lzma_version ());
+    fprintf (stderr, "ZSTD ...........: %s\n", rl2_zstd_version ());
+    fprintf (stderr, "LZ4 ............: %s\n", rl2_lz4_version ());
     fprintf (stderr, "PNG ............: %s\n", rl2_png_version ());
     fprintf (stderr, "JPEG ...........: %s\n", rl2_jpeg_version ());
     fprintf (stderr, "TIFF ...........: %s\n", rl2_tiff_version ());
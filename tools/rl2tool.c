@@ -58,6 +58,7 @@
 #define ARG_MODE_CATALOG	12
 #define ARG_MODE_MAP		13
 #define ARG_MODE_HISTOGRAM	14
+#define ARG_MODE_PYRINCR	15
 
 #define ARG_DB_PATH		10
 #define ARG_SRC_PATH		11
@@ -1111,11 +1112,25 @@ exec_pyramidize (sqlite3 * handle, int max_threads, const char *coverage,
 }
 
 static int
-exec_pyramidize_monolithic (sqlite3 * handle, const char *coverage,
-			    int virt_levels)
+exec_pyramidize_monolithic (sqlite3 * handle, int max_threads,
+			    const char *coverage, int virt_levels)
 {
 /* building Pyramid levels (Monolithic) */
-    int ret = rl2_build_monolithic_pyramid (handle, coverage, virt_levels, 1);
+    int ret =
+	rl2_build_monolithic_pyramid_ex (handle, max_threads, coverage,
+					 virt_levels, 1);
+    if (ret == RL2_OK)
+	return 1;
+    return 0;
+}
+
+static int
+exec_pyramidize_incremental (sqlite3 * handle, int max_threads,
+			     const char *coverage)
+{
+/* updating Pyramid levels (only the tiles affected by Section changes) */
+    int ret =
+	rl2_build_incremental_pyramid (handle, max_threads, coverage, 1);
     if (ret == RL2_OK)
 	return 1;
     return 0;
@@ -1578,6 +1593,26 @@ exec_catalog (sqlite3 * handle)
 		else if (strcmp (compression, "LZMA_NO") == 0)
 		    printf
 			("          Compression: LZMA noDelta (7-zip, lossless)\n");
+		else if (strcmp (compression, "ZSTD") == 0)
+		    printf
+			("          Compression: ZSTD DeltaFilter (Zstandard, lossless)\n");
+		else if (strcmp (compression, "ZSTD_NO") == 0)
+		    printf
+			("          Compression: ZSTD noDelta (Zstandard, lossless)\n");
+		else if (strcmp (compression, "LZ4") == 0)
+		    printf
+			("          Compression: LZ4 ByteShuffle (lossless)\n");
+		else if (strcmp (compression, "LZ4_NO") == 0)
+		    printf ("          Compression: LZ4 noShuffle (lossless)\n");
+		else if (strcmp (compression, "DEFLATE_FP") == 0)
+		    printf
+			("          Compression: DEFLATE FloatPredictor (zip, lossless)\n");
+		else if (strcmp (compression, "LZMA_FP") == 0)
+		    printf
+			("          Compression: LZMA FloatPredictor (7-zip, lossless)\n");
+		else if (strcmp (compression, "ZSTD_FP") == 0)
+		    printf
+			("          Compression: ZSTD FloatPredictor (Zstandard, lossless)\n");
 		else if (strcmp (compression, "PNG") == 0)
 		    printf ("          Compression: PNG, lossless\n");
 		else if (strcmp (compression, "JPEG") == 0)
@@ -1598,6 +1633,9 @@ exec_catalog (sqlite3 * handle)
 		    || strcmp (compression, "WEBP") == 0
 		    || strcmp (compression, "JP2") == 0)
 		    printf ("  Compression Quality: %d\n", quality);
+		if (strcmp (compression, "ZSTD") == 0
+		    || strcmp (compression, "ZSTD_NO") == 0)
+		    printf ("  Compression Quality: %d\n", quality);
 		printf ("   Tile Size (pixels): %d x %d\n", tileW, tileH);
 		hres = formatFloat (x_res);
 		vres = formatFloat (y_res);
@@ -3006,10 +3044,24 @@ check_create_args (const char *db_path, const char *coverage, int sample,
 	    {
 	    case RL2_COMPRESSION_LZMA:
 	    case RL2_COMPRESSION_LZMA_NO:
+	    case RL2_COMPRESSION_LZMA_FP:
 		fprintf (stderr,
 			 "*** ERROR *** librasterlite2 was built by disabling LZMA support\n");
 		err = 1;
 		break;
+	    case RL2_COMPRESSION_ZSTD:
+	    case RL2_COMPRESSION_ZSTD_NO:
+	    case RL2_COMPRESSION_ZSTD_FP:
+		fprintf (stderr,
+			 "*** ERROR *** librasterlite2 was built by disabling Zstandard support\n");
+		err = 1;
+		break;
+	    case RL2_COMPRESSION_LZ4:
+	    case RL2_COMPRESSION_LZ4_NO:
+		fprintf (stderr,
+			 "*** ERROR *** librasterlite2 was built by disabling LZ4 support\n");
+		err = 1;
+		break;
 	    case RL2_COMPRESSION_CHARLS:
 		fprintf (stderr,
 			 "*** ERROR *** librasterlite2 was built by disabling CharLS support\n");
@@ -3059,6 +3111,50 @@ check_create_args (const char *db_path, const char *coverage, int sample,
 	  printf ("          Compression: LZMA noDelta (7-zip, lossless)\n");
 	  *quality = 100;
 	  break;
+      case RL2_COMPRESSION_ZSTD:
+	  printf
+	      ("          Compression: ZSTD DeltaFilter (Zstandard, lossless)\n");
+	  if (*quality < 0)
+	      *quality = 50;
+	  if (*quality > 100)
+	      *quality = 100;
+	  printf ("  Compression Quality: %d\n", *quality);
+	  break;
+      case RL2_COMPRESSION_ZSTD_NO:
+	  printf ("          Compression: ZSTD noDelta (Zstandard, lossless)\n");
+	  if (*quality < 0)
+	      *quality = 50;
+	  if (*quality > 100)
+	      *quality = 100;
+	  printf ("  Compression Quality: %d\n", *quality);
+	  break;
+      case RL2_COMPRESSION_LZ4:
+	  printf ("          Compression: LZ4 ByteShuffle (lossless)\n");
+	  *quality = 100;
+	  break;
+      case RL2_COMPRESSION_LZ4_NO:
+	  printf ("          Compression: LZ4 noShuffle (lossless)\n");
+	  *quality = 100;
+	  break;
+      case RL2_COMPRESSION_DEFLATE_FP:
+	  printf
+	      ("          Compression: DEFLATE FloatPredictor (zip, lossless)\n");
+	  *quality = 100;
+	  break;
+      case RL2_COMPRESSION_LZMA_FP:
+	  printf
+	      ("          Compression: LZMA FloatPredictor (7-zip, lossless)\n");
+	  *quality = 100;
+	  break;
+      case RL2_COMPRESSION_ZSTD_FP:
+	  printf
+	      ("          Compression: ZSTD FloatPredictor (Zstandard, lossless)\n");
+	  if (*quality < 0)
+	      *quality = 50;
+	  if (*quality > 100)
+	      *quality = 100;
+	  printf ("  Compression Quality: %d\n", *quality);
+	  break;
       case RL2_COMPRESSION_GIF:
 	  printf ("          Compression: GIF, lossless\n");
 	  *quality = 100;
@@ -3973,6 +4069,31 @@ check_pyramidize_monolithic_args (const char *db_path, const char *coverage,
     return err;
 }
 
+static int
+check_pyramidize_incremental_args (const char *db_path, const char *coverage)
+{
+/* checking/printing PYRAMIDIZE-INCREMENTAL args */
+    int err = 0;
+    printf ("\n\nrl2tool; request is PYRAMIDIZE-INCREMENTAL\n");
+    printf ("===========================================================\n");
+    if (db_path == NULL)
+      {
+	  fprintf (stderr, "*** ERROR *** no DB path was specified\n");
+	  err = 1;
+      }
+    else
+	printf ("DB path: %s\n", db_path);
+    if (coverage == NULL)
+      {
+	  fprintf (stderr, "*** ERROR *** no Coverage's name was specified\n");
+	  err = 1;
+      }
+    else
+	printf ("Coverage: %s\n", coverage);
+    printf ("===========================================================\n\n");
+    return err;
+}
+
 static int
 check_de_pyramidize_args (const char *db_path, const char *coverage,
 			  const char *section, int ok_section_id,
@@ -4367,6 +4488,8 @@ do_version ()
     fprintf (stderr, "libcurl ........: %s\n", rl2_curl_version ());
     fprintf (stderr, "DEFLATE ........: %s\n", rl2_zlib_version ());
     fprintf (stderr, "LZMA ...........: %s\n", rl2_lzma_version ());
+    fprintf (stderr, "ZSTD ...........: %s\n", rl2_zstd_version ());
+    fprintf (stderr, "LZ4 ............: %s\n", rl2_lz4_version ());
     fprintf (stderr, "PNG ............: %s\n", rl2_png_version ());
     fprintf (stderr, "JPEG ...........: %s\n", rl2_jpeg_version ());
     fprintf (stderr, "TIFF ...........: %s\n", rl2_tiff_version ());
@@ -4433,7 +4556,11 @@ do_help (int mode)
 	  fprintf (stderr, "Compression Keywords:\n");
 	  fprintf (stderr, "----------------------------------\n");
 	  fprintf (stderr,
-		   "NONE DEFLATE DEFLATE_NO LZMA LZMA_NO PNG JPEG WEBP LL_WEBP FAX4 CHARLS JP2 LL_JP2\n\n");
+		   "NONE DEFLATE DEFLATE_NO LZMA LZMA_NO ZSTD ZSTD_NO LZ4 LZ4_NO\n");
+	  fprintf (stderr,
+		   "DEFLATE_FP LZMA_FP ZSTD_FP (FLOAT and DOUBLE only)\n");
+	  fprintf (stderr,
+		   "PNG JPEG WEBP LL_WEBP FAX4 CHARLS JP2 LL_JP2\n\n");
 	  fprintf (stderr, "Extra args supported by MULTIBAND:\n");
 	  fprintf (stderr, "----------------------------------\n");
 	  fprintf (stderr, "-red or --red-band     pixel    RED band index\n");
@@ -4662,6 +4789,19 @@ do_help (int mode)
 	  fprintf (stderr,
 		   "                                could be one of: 1, 2 or 3\n");
       }
+    if (mode == ARG_NONE || mode == ARG_MODE_PYRINCR)
+      {
+	  /* MODE = PYRAMIDIZE INCREMENTAL */
+	  fprintf (stderr, "\nmode: PYRAMIDIZE-INCREMENTAL\n");
+	  fprintf (stderr,
+		   "will only rebuild the Pyramid tiles affected by the Sections\n"
+		   "loaded or deleted since the last Pyramid update\n");
+	  fprintf (stderr,
+		   "==============================================================\n");
+	  fprintf (stderr,
+		   "-db or --db-path      pathname  RasterLite2 DB path\n");
+	  fprintf (stderr, "-cov or --coverage    string    Coverage's name\n");
+      }
     if (mode == ARG_NONE || mode == ARG_MODE_DE_PYRAMIDIZE)
       {
 	  /* MODE = DE-PYRAMIDIZE */
@@ -4865,6 +5005,8 @@ main (int argc, char *argv[])
 	      mode = ARG_MODE_PYRAMIDIZE;
 	  if (strcasecmp (argv[1], "PYRAMIDIZE-MONOLITHIC") == 0)
 	      mode = ARG_MODE_PYRMONO;
+	  if (strcasecmp (argv[1], "PYRAMIDIZE-INCREMENTAL") == 0)
+	      mode = ARG_MODE_PYRINCR;
 	  if (strcasecmp (argv[1], "DE-PYRAMIDIZE") == 0)
 	      mode = ARG_MODE_DE_PYRAMIDIZE;
 	  if (strcasecmp (argv[1], "LIST") == 0)
@@ -4976,6 +5118,20 @@ main (int argc, char *argv[])
 			  compression = RL2_COMPRESSION_LZMA;
 		      if (strcasecmp (argv[i], "LZMA_NO") == 0)
 			  compression = RL2_COMPRESSION_LZMA_NO;
+		      if (strcasecmp (argv[i], "ZSTD") == 0)
+			  compression = RL2_COMPRESSION_ZSTD;
+		      if (strcasecmp (argv[i], "ZSTD_NO") == 0)
+			  compression = RL2_COMPRESSION_ZSTD_NO;
+		      if (strcasecmp (argv[i], "LZ4") == 0)
+			  compression = RL2_COMPRESSION_LZ4;
+		      if (strcasecmp (argv[i], "LZ4_NO") == 0)
+			  compression = RL2_COMPRESSION_LZ4_NO;
+		      if (strcasecmp (argv[i], "DEFLATE_FP") == 0)
+			  compression = RL2_COMPRESSION_DEFLATE_FP;
+		      if (strcasecmp (argv[i], "LZMA_FP") == 0)
+			  compression = RL2_COMPRESSION_LZMA_FP;
+		      if (strcasecmp (argv[i], "ZSTD_FP") == 0)
+			  compression = RL2_COMPRESSION_ZSTD_FP;
 		      if (strcasecmp (argv[i], "LZW") == 0)
 			  compression = RL2_COMPRESSION_LZW;
 		      if (strcasecmp (argv[i], "GIF") == 0)
@@ -5475,6 +5631,9 @@ main (int argc, char *argv[])
 	  error =
 	      check_pyramidize_monolithic_args (db_path, coverage, virt_levels);
 	  break;
+      case ARG_MODE_PYRINCR:
+	  error = check_pyramidize_incremental_args (db_path, coverage);
+	  break;
       case ARG_MODE_DE_PYRAMIDIZE:
 	  error =
 	      check_de_pyramidize_args (db_path, coverage, section,
@@ -5644,7 +5803,12 @@ main (int argc, char *argv[])
 			       ok_section_id, section_id, force_pyramid);
 	  break;
       case ARG_MODE_PYRMONO:
-	  ret = exec_pyramidize_monolithic (handle, coverage, virt_levels);
+	  ret =
+	      exec_pyramidize_monolithic (handle, max_threads, coverage,
+					  virt_levels);
+	  break;
+      case ARG_MODE_PYRINCR:
+	  ret = exec_pyramidize_incremental (handle, max_threads, coverage);
 	  break;
       case ARG_MODE_DE_PYRAMIDIZE:
 	  ret =
@@ -5704,6 +5868,9 @@ main (int argc, char *argv[])
 	    case ARG_MODE_PYRMONO:
 		op_name = "PYRAMIDIZE-MONOLITHIC";
 		break;
+	    case ARG_MODE_PYRINCR:
+		op_name = "PYRAMIDIZE-INCREMENTAL";
+		break;
 	    case ARG_MODE_DE_PYRAMIDIZE:
 		op_name = "DE-PYRAMIDIZE";
 		break;